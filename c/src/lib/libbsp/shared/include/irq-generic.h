@@ -33,6 +33,10 @@
   #include <rtems/score/atomic.h>
 #endif
 
+#ifdef RTEMS_PROFILING
+  #include <rtems/score/profiling.h>
+#endif
+
 #include <bsp/irq.h>
 
 #ifdef __cplusplus
@@ -252,6 +256,10 @@ rtems_status_code bsp_interrupt_vector_disable(rtems_vector_number vector);
  */
 static inline void bsp_interrupt_handler_dispatch(rtems_vector_number vector)
 {
+  #ifdef RTEMS_PROFILING
+    CPU_Counter_ticks entry_instant = _Profiling_Interrupt_entry();
+  #endif
+
   if (bsp_interrupt_is_valid_vector(vector)) {
     const bsp_interrupt_handler_entry *e =
       &bsp_interrupt_handler_table [bsp_interrupt_handler_index(vector)];
@@ -270,6 +278,10 @@ static inline void bsp_interrupt_handler_dispatch(rtems_vector_number vector)
   } else {
     bsp_interrupt_handler_default(vector);
   }
+
+  #ifdef RTEMS_PROFILING
+    _Profiling_Interrupt_exit(_Per_CPU_Get(), entry_instant);
+  #endif
 }
 
 /** @} */
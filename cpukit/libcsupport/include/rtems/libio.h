@@ -1862,6 +1862,8 @@ typedef struct rtems_termios_callbacks {
   int    (*stopRemoteTx)(int minor);
   int    (*startRemoteTx)(int minor);
   int    outputUsesInterrupts;
+  size_t rawInputBufferSize;   /* 0 selects the rtems_termios_bufsize() value */
+  size_t rawOutputBufferSize;  /* 0 selects the rtems_termios_bufsize() value */
 } rtems_termios_callbacks;
 
 void rtems_termios_initialize (void);
@@ -1911,6 +1913,24 @@ int rtems_termios_dequeue_characters(
   int   len
 );
 
+/*
+ * Bulk receive interface for DMA capable drivers.  The driver obtains the
+ * contiguous free area of the raw input buffer, lets the hardware fill it and
+ * hands the received characters over with rtems_termios_commit_raw_characters.
+ * A NULL return value indicates that the input needs per-character handling
+ * (line discipline or XON/XOFF recognition), in this case the driver has to
+ * use rtems_termios_enqueue_raw_characters.
+ */
+char *rtems_termios_raw_input_space(
+  void   *ttyp,
+  size_t *size
+);
+
+void rtems_termios_commit_raw_characters(
+  void   *ttyp,
+  size_t  len
+);
+
 /** @} */
 
 /**
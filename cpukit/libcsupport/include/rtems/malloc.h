@@ -156,6 +156,229 @@ void malloc_report_statistics_with_plugin(
   rtems_printk_plugin_t  print
 );
 
+/**
+ *  @defgroup MallocProfiling Malloc Profiling
+ *
+ *  @ingroup MallocSupport
+ *
+ *  @brief Allocation site heap profiler.
+ *
+ *  The malloc profiling support records for each live allocation of the
+ *  malloc family the caller address, the requested size and the size class in
+ *  a compact hash table.  The allocations are accounted to allocation sites
+ *  identified by the caller address.  Each site counts its live allocations,
+ *  live bytes and calls.  Snapshots of the site table taken at different times
+ *  may be compared to find leaks on long-running systems.
+ *
+ *  The support is enabled with the CONFIGURE_MALLOC_PROFILING configuration
+ *  option.  The table sizes are defined by
+ *  CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS and
+ *  CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES.  Allocations which do not fit
+ *  into the allocation table are counted as untracked.  Allocations of new
+ *  sites which do not fit into the site table are accounted to a site with
+ *  a @c NULL caller address.
+ *
+ *  @{
+ */
+
+/**
+ *  @brief Live allocation of the malloc profiling support.
+ */
+typedef struct {
+  /**
+   *  @brief The allocated memory area or @c NULL for an empty entry.
+   */
+  void     *pointer;
+
+  /**
+   *  @brief The requested size in bytes.
+   */
+  uint32_t  size;
+
+  /**
+   *  @brief Index of the allocation site in the site table.
+   */
+  uint16_t  site;
+
+  /**
+   *  @brief Size class of the allocation.
+   *
+   *  The size class i contains the sizes in the range [2^i, 2^(i+1)) bytes.
+   *  The last size class 31 contains all sizes of at least 2^31 bytes.
+   */
+  uint8_t   size_class;
+} rtems_malloc_profiling_allocation;
+
+/**
+ *  @brief Allocation site of the malloc profiling support.
+ */
+typedef struct {
+  /**
+   *  @brief The caller address of the allocation site.
+   */
+  void      *caller;
+
+  /**
+   *  @brief Count of live allocations.
+   */
+  uint32_t   live_count;
+
+  /**
+   *  @brief Count of calls since system initialization.
+   */
+  uint32_t   calls;
+
+  /**
+   *  @brief Live bytes.
+   */
+  uintptr_t  live_bytes;
+
+  /**
+   *  @brief Maximum of the live bytes.
+   */
+  uintptr_t  peak_bytes;
+
+  /**
+   *  @brief Set of size classes allocated by this site.
+   *
+   *  Bit i is set if an allocation of size class i was made.
+   */
+  uint32_t   size_classes;
+} rtems_malloc_profiling_site;
+
+/**
+ *  @brief Malloc profiling configuration.
+ */
+typedef struct {
+  rtems_malloc_profiling_allocation *allocations;
+  uint32_t                           maximum_allocations;
+  rtems_malloc_profiling_site       *sites;
+  uint32_t                           maximum_sites;
+} rtems_malloc_profiling_configuration_t;
+
+extern const rtems_malloc_profiling_configuration_t
+  *rtems_malloc_profiling_configuration;
+
+/*
+ *  Malloc profiling plugin
+ */
+typedef struct {
+  void (*initialize)(void);
+  void (*at_malloc)(void *pointer, size_t size, void *caller);
+  void (*at_free)(void *pointer);
+} rtems_malloc_profiling_functions_t;
+
+extern rtems_malloc_profiling_functions_t
+  rtems_malloc_profiling_helpers_table;
+extern rtems_malloc_profiling_functions_t *rtems_malloc_profiling_helpers;
+
+/**
+ *  @brief Snapshot of the malloc profiling allocation sites.
+ */
+typedef struct {
+  /**
+   *  @brief Clock ticks since boot at the time of the snapshot.
+   */
+  rtems_interval               ticks;
+
+  /**
+   *  @brief Count of allocations which were not tracked since the
+   *  allocation table was full.
+   */
+  uint32_t                     untracked;
+
+  /**
+   *  @brief Count of allocation sites.
+   */
+  uint32_t                     site_count;
+
+  /**
+   *  @brief The allocation sites.
+   */
+  rtems_malloc_profiling_site *sites;
+} rtems_malloc_profiling_snapshot;
+
+/**
+ *  @brief Takes a snapshot of the malloc profiling allocation sites.
+ *
+ *  The snapshot is allocated from the heap and must be released with
+ *  rtems_malloc_profiling_free_snapshot().
+ *
+ *  @param[out] snapshot points to the snapshot pointer
+ *
+ *  @retval RTEMS_SUCCESSFUL Successful operation.
+ *  @retval RTEMS_NOT_CONFIGURED The malloc profiling is not configured.
+ *  @retval RTEMS_INVALID_ADDRESS The snapshot pointer is NULL.
+ *  @retval RTEMS_NO_MEMORY Not enough memory for the snapshot.
+ */
+rtems_status_code rtems_malloc_profiling_take_snapshot(
+  rtems_malloc_profiling_snapshot **snapshot
+);
+
+/**
+ *  @brief Frees a snapshot of the malloc profiling allocation sites.
+ *
+ *  @param[in] snapshot is the snapshot
+ */
+void rtems_malloc_profiling_free_snapshot(
+  rtems_malloc_profiling_snapshot *snapshot
+);
+
+/**
+ *  @brief Reports the top allocation sites by live bytes and by call rate.
+ *
+ *  @param[in] context is the context to pass to the print handler
+ *  @param[in] print is the print handler
+ *  @param[in] max_sites is the maximum count of sites reported per table,
+ *             zero reports all sites
+ */
+void rtems_malloc_profiling_report_with_plugin(
+  void                  *context,
+  rtems_printk_plugin_t  print,
+  uint32_t               max_sites
+);
+
+/**
+ *  @brief Reports all allocation sites via printk().
+ *
+ *  @see rtems_malloc_profiling_report_with_plugin().
+ */
+void rtems_malloc_profiling_report(void);
+
+/**
+ *  @brief Reports the changes of the allocation sites between two snapshots.
+ *
+ *  The sites are sorted by the change of their live bytes in descending
+ *  order, so the sites which likely leak memory are reported first.  Sites
+ *  without changes are omitted.
+ *
+ *  @param[in] context is the context to pass to the print handler
+ *  @param[in] print is the print handler
+ *  @param[in] before is the earlier snapshot
+ *  @param[in] after is the later snapshot
+ *  @param[in] max_sites is the maximum count of sites reported, zero reports
+ *             all sites
+ */
+void rtems_malloc_profiling_report_diff_with_plugin(
+  void                                  *context,
+  rtems_printk_plugin_t                  print,
+  const rtems_malloc_profiling_snapshot *before,
+  const rtems_malloc_profiling_snapshot *after,
+  uint32_t                               max_sites
+);
+
+/**
+ *  @brief Reports the changes between two snapshots via printk().
+ *
+ *  @see rtems_malloc_profiling_report_diff_with_plugin().
+ */
+void rtems_malloc_profiling_report_diff(
+  const rtems_malloc_profiling_snapshot *before,
+  const rtems_malloc_profiling_snapshot *after
+);
+
+/** @} */
+
 /**
  *  @brief RTEMS Variation on Aligned Memory Allocation
  *
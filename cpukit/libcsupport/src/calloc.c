@@ -34,7 +34,7 @@ void *calloc(
   MSBUMP(calloc_calls, 1);
 
   length = nelem * elsize;
-  cptr = malloc( length );
+  cptr = malloc_with_caller( length, MALLOC_CALLER() );
   if ( cptr )
     memset( cptr, '\0', length );
 
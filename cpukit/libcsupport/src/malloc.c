@@ -26,8 +26,9 @@
 
 #include <rtems/score/sysstate.h>
 
-void *malloc(
-  size_t  size
+void *malloc_with_caller(
+  size_t  size,
+  void   *caller
 )
 {
   void        *return_this;
@@ -80,7 +81,20 @@ void *malloc(
   if ( rtems_malloc_statistics_helpers )
     (*rtems_malloc_statistics_helpers->at_malloc)(return_this);
 
+  /*
+   *  If configured, account the allocation to its caller
+   */
+  if ( rtems_malloc_profiling_helpers )
+    (*rtems_malloc_profiling_helpers->at_malloc)(return_this, size, caller);
+
   return return_this;
 }
 
+void *malloc(
+  size_t  size
+)
+{
+  return malloc_with_caller( size, MALLOC_CALLER() );
+}
+
 #endif
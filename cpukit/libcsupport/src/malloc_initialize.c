@@ -67,6 +67,13 @@ void RTEMS_Malloc_Initialize(
     (*rtems_malloc_statistics_helpers->initialize)();
   }
 
+  /*
+   *  If configured, initialize the profiling support
+   */
+  if ( rtems_malloc_profiling_helpers != NULL ) {
+    (*rtems_malloc_profiling_helpers->initialize)();
+  }
+
   MSBUMP( space_available, _Protected_heap_Get_size( heap ) );
 }
 #else
@@ -34,3 +34,17 @@ extern rtems_malloc_statistics_t rtems_malloc_statistics;
 bool malloc_is_system_state_OK(void);
 void malloc_deferred_frees_process(void);
 void malloc_deferred_free(void *);
+
+/*
+ *  Allocation variants which account the memory to the caller address in
+ *  the malloc profiling support
+ */
+#define MALLOC_CALLER() __builtin_return_address( 0 )
+
+void *malloc_with_caller(size_t size, void *caller);
+int rtems_memalign_with_caller(
+  void   **pointer,
+  size_t   alignment,
+  size_t   size,
+  void    *caller
+);
@@ -0,0 +1,319 @@
+/**
+ *  @file
+ *
+ *  @brief Malloc Profiling Support
+ *  @ingroup MallocProfiling
+ */
+
+/*
+ *  The license and distribution terms for this file may be
+ *  found in the file LICENSE in this distribution or at
+ *  http://www.rtems.com/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef RTEMS_NEWLIB
+#include "malloc_p.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <rtems/score/apimutex.h>
+
+/*
+ *  Count of allocations which did not fit into the allocation table.
+ */
+static uint32_t malloc_profiling_untracked;
+
+/*
+ *  The site table entry zero collects the allocations of sites which did not
+ *  fit into the site table.  The other entries form an open addressing hash
+ *  table with linear probing.  Sites are never removed.
+ */
+#define MALLOC_PROFILING_OTHER_SITE 0
+
+/*
+ *  The size classes are recorded in a 32-bit set, so the last size class
+ *  collects all larger sizes.
+ */
+#define MALLOC_PROFILING_SIZE_CLASS_MAX 31
+
+static uint32_t malloc_profiling_size_class( size_t size )
+{
+  uint32_t size_class = 0;
+
+  while ( size > 1 && size_class < MALLOC_PROFILING_SIZE_CLASS_MAX ) {
+    size >>= 1;
+    ++size_class;
+  }
+
+  return size_class;
+}
+
+static uint32_t malloc_profiling_allocation_hash(
+  const rtems_malloc_profiling_configuration_t *config,
+  const void                                   *pointer
+)
+{
+  return (uint32_t) ( ( (uintptr_t) pointer >> 3 )
+    % config->maximum_allocations );
+}
+
+static uint32_t malloc_profiling_find_site(
+  const rtems_malloc_profiling_configuration_t *config,
+  void                                         *caller
+)
+{
+  uint32_t slots = config->maximum_sites - 1;
+  uint32_t index;
+  uint32_t i;
+
+  if ( slots == 0 ) {
+    return MALLOC_PROFILING_OTHER_SITE;
+  }
+
+  index = (uint32_t) ( ( (uintptr_t) caller >> 2 ) % slots );
+
+  for ( i = 0; i < slots; ++i ) {
+    rtems_malloc_profiling_site *site = &config->sites[ index + 1 ];
+
+    if ( site->caller == caller ) {
+      return index + 1;
+    }
+
+    if ( site->caller == NULL ) {
+      site->caller = caller;
+      return index + 1;
+    }
+
+    index = ( index + 1 ) % slots;
+  }
+
+  return MALLOC_PROFILING_OTHER_SITE;
+}
+
+static void rtems_malloc_profiling_initialize( void )
+{
+  const rtems_malloc_profiling_configuration_t *config =
+    rtems_malloc_profiling_configuration;
+
+  memset(
+    config->allocations,
+    0,
+    config->maximum_allocations * sizeof( *config->allocations )
+  );
+  memset(
+    config->sites,
+    0,
+    config->maximum_sites * sizeof( *config->sites )
+  );
+  malloc_profiling_untracked = 0;
+}
+
+static void rtems_malloc_profiling_at_malloc(
+  void   *pointer,
+  size_t  size,
+  void   *caller
+)
+{
+  const rtems_malloc_profiling_configuration_t *config =
+    rtems_malloc_profiling_configuration;
+  rtems_malloc_profiling_site *site;
+  uint32_t size_class;
+  uint32_t site_index;
+  uint32_t index;
+  uint32_t i;
+
+  if ( !pointer )
+    return;
+
+  size_class = malloc_profiling_size_class( size );
+
+  _RTEMS_Lock_allocator();
+
+  site_index = malloc_profiling_find_site( config, caller );
+  site = &config->sites[ site_index ];
+
+  ++site->calls;
+  site->size_classes |= UINT32_C(1) << size_class;
+
+  index = malloc_profiling_allocation_hash( config, pointer );
+
+  for ( i = 0; i < config->maximum_allocations; ++i ) {
+    rtems_malloc_profiling_allocation *allocation =
+      &config->allocations[ index ];
+
+    if ( allocation->pointer == NULL ) {
+      allocation->pointer = pointer;
+      allocation->size = (uint32_t) size;
+      allocation->site = (uint16_t) site_index;
+      allocation->size_class = (uint8_t) size_class;
+
+      ++site->live_count;
+      site->live_bytes += size;
+      if ( site->live_bytes > site->peak_bytes )
+        site->peak_bytes = site->live_bytes;
+
+      _RTEMS_Unlock_allocator();
+      return;
+    }
+
+    index = ( index + 1 ) % config->maximum_allocations;
+  }
+
+  ++malloc_profiling_untracked;
+
+  _RTEMS_Unlock_allocator();
+}
+
+/*
+ *  Removes the allocation entry at the index and moves the following entries
+ *  of the probe sequence backwards, so that lookups need no tombstones.
+ */
+static void malloc_profiling_remove_allocation(
+  const rtems_malloc_profiling_configuration_t *config,
+  uint32_t                                      hole
+)
+{
+  rtems_malloc_profiling_allocation *allocations = config->allocations;
+  uint32_t n = config->maximum_allocations;
+  uint32_t index = hole;
+
+  while ( true ) {
+    uint32_t home;
+    bool stays;
+
+    index = ( index + 1 ) % n;
+
+    if ( allocations[ index ].pointer == NULL )
+      break;
+
+    home = malloc_profiling_allocation_hash(
+      config,
+      allocations[ index ].pointer
+    );
+
+    /*
+     *  The entry stays if its home slot is cyclically in (hole, index].
+     */
+    if ( hole <= index ) {
+      stays = hole < home && home <= index;
+    } else {
+      stays = hole < home || home <= index;
+    }
+
+    if ( !stays ) {
+      allocations[ hole ] = allocations[ index ];
+      hole = index;
+    }
+  }
+
+  allocations[ hole ].pointer = NULL;
+}
+
+/*
+ *  If the pointer is not in the allocation table, then it was allocated
+ *  before the profiling support was initialized or it was not tracked.
+ */
+static void rtems_malloc_profiling_at_free(
+  void *pointer
+)
+{
+  const rtems_malloc_profiling_configuration_t *config =
+    rtems_malloc_profiling_configuration;
+  uint32_t index;
+  uint32_t i;
+
+  _RTEMS_Lock_allocator();
+
+  index = malloc_profiling_allocation_hash( config, pointer );
+
+  for ( i = 0; i < config->maximum_allocations; ++i ) {
+    rtems_malloc_profiling_allocation *allocation =
+      &config->allocations[ index ];
+
+    if ( allocation->pointer == NULL )
+      break;
+
+    if ( allocation->pointer == pointer ) {
+      rtems_malloc_profiling_site *site = &config->sites[ allocation->site ];
+
+      --site->live_count;
+      site->live_bytes -= allocation->size;
+      malloc_profiling_remove_allocation( config, index );
+
+      _RTEMS_Unlock_allocator();
+      return;
+    }
+
+    index = ( index + 1 ) % config->maximum_allocations;
+  }
+
+  _RTEMS_Unlock_allocator();
+}
+
+rtems_malloc_profiling_functions_t rtems_malloc_profiling_helpers_table = {
+  rtems_malloc_profiling_initialize,
+  rtems_malloc_profiling_at_malloc,
+  rtems_malloc_profiling_at_free,
+};
+
+rtems_status_code rtems_malloc_profiling_take_snapshot(
+  rtems_malloc_profiling_snapshot **snapshot
+)
+{
+  const rtems_malloc_profiling_configuration_t *config =
+    rtems_malloc_profiling_configuration;
+  rtems_malloc_profiling_snapshot *s;
+  uint32_t i;
+
+  if ( !snapshot )
+    return RTEMS_INVALID_ADDRESS;
+
+  *snapshot = NULL;
+
+  if ( !rtems_malloc_profiling_helpers || !config )
+    return RTEMS_NOT_CONFIGURED;
+
+  /*
+   *  Allocate for the worst case before the allocator lock is obtained, since
+   *  this allocation is profiled as well.
+   */
+  s = malloc( sizeof( *s ) + config->maximum_sites * sizeof( *s->sites ) );
+  if ( !s )
+    return RTEMS_NO_MEMORY;
+
+  s->sites = (rtems_malloc_profiling_site *) ( s + 1 );
+  s->site_count = 0;
+
+  _RTEMS_Lock_allocator();
+
+  s->ticks = rtems_clock_get_ticks_since_boot();
+  s->untracked = malloc_profiling_untracked;
+
+  for ( i = 0; i < config->maximum_sites; ++i ) {
+    const rtems_malloc_profiling_site *site = &config->sites[ i ];
+
+    if ( site->calls != 0 ) {
+      s->sites[ s->site_count ] = *site;
+      ++s->site_count;
+    }
+  }
+
+  _RTEMS_Unlock_allocator();
+
+  *snapshot = s;
+  return RTEMS_SUCCESSFUL;
+}
+
+void rtems_malloc_profiling_free_snapshot(
+  rtems_malloc_profiling_snapshot *snapshot
+)
+{
+  free( snapshot );
+}
+
+#endif
@@ -0,0 +1,346 @@
+/**
+ *  @file
+ *
+ *  @brief Malloc Profiling Report
+ *  @ingroup MallocProfiling
+ */
+
+/*
+ *  The license and distribution terms for this file may be
+ *  found in the file LICENSE in this distribution or at
+ *  http://www.rtems.com/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef RTEMS_NEWLIB
+#include "malloc_p.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+typedef struct {
+  void     *caller;
+  intmax_t  delta_bytes;
+  int32_t   delta_count;
+  uint32_t  calls;
+} malloc_profiling_delta;
+
+/*
+ *  Calls per second scaled by 1000.
+ */
+static uint64_t malloc_profiling_call_rate(
+  uint32_t       calls,
+  rtems_interval ticks
+)
+{
+  if ( ticks == 0 )
+    return 0;
+
+  return ( (uint64_t) calls * 1000 * rtems_clock_get_ticks_per_second() )
+    / ticks;
+}
+
+static int malloc_profiling_compare_live_bytes( const void *a, const void *b )
+{
+  const rtems_malloc_profiling_site *sa = a;
+  const rtems_malloc_profiling_site *sb = b;
+
+  if ( sa->live_bytes != sb->live_bytes )
+    return sa->live_bytes < sb->live_bytes ? 1 : -1;
+
+  return 0;
+}
+
+static int malloc_profiling_compare_calls( const void *a, const void *b )
+{
+  const rtems_malloc_profiling_site *sa = a;
+  const rtems_malloc_profiling_site *sb = b;
+
+  if ( sa->calls != sb->calls )
+    return sa->calls < sb->calls ? 1 : -1;
+
+  return 0;
+}
+
+static int malloc_profiling_compare_delta( const void *a, const void *b )
+{
+  const malloc_profiling_delta *da = a;
+  const malloc_profiling_delta *db = b;
+
+  if ( da->delta_bytes != db->delta_bytes )
+    return da->delta_bytes < db->delta_bytes ? 1 : -1;
+
+  if ( da->calls != db->calls )
+    return da->calls < db->calls ? 1 : -1;
+
+  return 0;
+}
+
+static uint32_t malloc_profiling_limit( uint32_t count, uint32_t max_sites )
+{
+  if ( max_sites != 0 && max_sites < count )
+    return max_sites;
+
+  return count;
+}
+
+static void malloc_profiling_print_sizes(
+  void                  *context,
+  rtems_printk_plugin_t  print,
+  uint32_t               size_classes
+)
+{
+  uint32_t low = 0;
+  uint32_t high = 31;
+
+  if ( size_classes == 0 ) {
+    (*print)( context, "-\n" );
+    return;
+  }
+
+  while ( ( size_classes & ( UINT32_C(1) << low ) ) == 0 )
+    ++low;
+
+  while ( ( size_classes & ( UINT32_C(1) << high ) ) == 0 )
+    --high;
+
+  (*print)( context, "2^%" PRIu32 "..2^%" PRIu32 "\n", low, high + 1 );
+}
+
+static void malloc_profiling_print_sites(
+  void                                  *context,
+  rtems_printk_plugin_t                  print,
+  const rtems_malloc_profiling_snapshot *snapshot,
+  uint32_t                               count
+)
+{
+  uint32_t i;
+
+  (*print)(
+    context,
+    "CALLER       LIVE BYTES LIVE COUNT PEAK BYTES      CALLS   CALLS/S SIZES\n"
+  );
+
+  for ( i = 0; i < count; ++i ) {
+    const rtems_malloc_profiling_site *site = &snapshot->sites[ i ];
+    uint64_t rate = malloc_profiling_call_rate( site->calls, snapshot->ticks );
+
+    (*print)(
+      context,
+      "0x%08" PRIxPTR " %12" PRIuPTR " %10" PRIu32 " %10" PRIuPTR
+        " %10" PRIu32 " %5" PRIu64 ".%03" PRIu64 " ",
+      (uintptr_t) site->caller,
+      site->live_bytes,
+      site->live_count,
+      site->peak_bytes,
+      site->calls,
+      rate / 1000,
+      rate % 1000
+    );
+    malloc_profiling_print_sizes( context, print, site->size_classes );
+  }
+}
+
+void rtems_malloc_profiling_report_with_plugin(
+  void                  *context,
+  rtems_printk_plugin_t  print,
+  uint32_t               max_sites
+)
+{
+  rtems_malloc_profiling_snapshot *snapshot;
+  rtems_status_code sc;
+  uint32_t count;
+
+  sc = rtems_malloc_profiling_take_snapshot( &snapshot );
+  if ( sc == RTEMS_NOT_CONFIGURED ) {
+    (*print)( context, "malloc profiling is not configured\n" );
+    return;
+  } else if ( sc != RTEMS_SUCCESSFUL ) {
+    (*print)( context, "not enough memory for the malloc profiling report\n" );
+    return;
+  }
+
+  count = malloc_profiling_limit( snapshot->site_count, max_sites );
+
+  (*print)(
+    context,
+    "MALLOC PROFILING: %" PRIu32 " sites, %" PRIu32 " untracked allocations\n",
+    snapshot->site_count,
+    snapshot->untracked
+  );
+
+  qsort(
+    snapshot->sites,
+    snapshot->site_count,
+    sizeof( *snapshot->sites ),
+    malloc_profiling_compare_live_bytes
+  );
+  (*print)( context, "TOP SITES BY LIVE BYTES\n" );
+  malloc_profiling_print_sites( context, print, snapshot, count );
+
+  qsort(
+    snapshot->sites,
+    snapshot->site_count,
+    sizeof( *snapshot->sites ),
+    malloc_profiling_compare_calls
+  );
+  (*print)( context, "TOP SITES BY CALL RATE\n" );
+  malloc_profiling_print_sites( context, print, snapshot, count );
+
+  rtems_malloc_profiling_free_snapshot( snapshot );
+}
+
+void rtems_malloc_profiling_report(void)
+{
+  rtems_malloc_profiling_report_with_plugin( NULL, printk_plugin, 0 );
+}
+
+static const rtems_malloc_profiling_site *malloc_profiling_find_caller(
+  const rtems_malloc_profiling_snapshot *snapshot,
+  void                                  *caller
+)
+{
+  uint32_t i;
+
+  for ( i = 0; i < snapshot->site_count; ++i ) {
+    if ( snapshot->sites[ i ].caller == caller )
+      return &snapshot->sites[ i ];
+  }
+
+  return NULL;
+}
+
+static void malloc_profiling_add_delta(
+  malloc_profiling_delta            *delta,
+  const rtems_malloc_profiling_site *before,
+  const rtems_malloc_profiling_site *after
+)
+{
+  delta->caller = after->caller;
+  delta->delta_bytes = (intmax_t) after->live_bytes;
+  delta->delta_count = (int32_t) after->live_count;
+  delta->calls = after->calls;
+
+  if ( before ) {
+    delta->delta_bytes -= (intmax_t) before->live_bytes;
+    delta->delta_count -= (int32_t) before->live_count;
+    delta->calls -= before->calls;
+  }
+}
+
+void rtems_malloc_profiling_report_diff_with_plugin(
+  void                                  *context,
+  rtems_printk_plugin_t                  print,
+  const rtems_malloc_profiling_snapshot *before,
+  const rtems_malloc_profiling_snapshot *after,
+  uint32_t                               max_sites
+)
+{
+  malloc_profiling_delta *deltas;
+  rtems_interval ticks;
+  uint32_t count = 0;
+  uint32_t i;
+
+  if ( !before || !after ) {
+    (*print)( context, "invalid malloc profiling snapshot\n" );
+    return;
+  }
+
+  deltas = malloc(
+    ( before->site_count + after->site_count ) * sizeof( *deltas )
+  );
+  if ( !deltas && before->site_count + after->site_count > 0 ) {
+    (*print)( context, "not enough memory for the malloc profiling report\n" );
+    return;
+  }
+
+  for ( i = 0; i < after->site_count; ++i ) {
+    const rtems_malloc_profiling_site *site = &after->sites[ i ];
+
+    malloc_profiling_add_delta(
+      &deltas[ count ],
+      malloc_profiling_find_caller( before, site->caller ),
+      site
+    );
+    ++count;
+  }
+
+  /*
+   *  Sites are never removed, so a site of the earlier snapshot is missing
+   *  in the later snapshot only if the snapshots are passed in the wrong
+   *  order.  Report it anyway as a site which released all its memory.
+   */
+  for ( i = 0; i < before->site_count; ++i ) {
+    const rtems_malloc_profiling_site *site = &before->sites[ i ];
+
+    if ( !malloc_profiling_find_caller( after, site->caller ) ) {
+      deltas[ count ].caller = site->caller;
+      deltas[ count ].delta_bytes = -(intmax_t) site->live_bytes;
+      deltas[ count ].delta_count = -(int32_t) site->live_count;
+      deltas[ count ].calls = 0;
+      ++count;
+    }
+  }
+
+  qsort( deltas, count, sizeof( *deltas ), malloc_profiling_compare_delta );
+
+  ticks = after->ticks - before->ticks;
+
+  (*print)(
+    context,
+    "MALLOC PROFILING DIFF OVER %" PRIu32 " TICKS: %" PRIi32
+      " untracked allocations\n"
+    "CALLER      DELTA BYTES DELTA COUNT      CALLS   CALLS/S\n",
+    (uint32_t) ticks,
+    (int32_t) ( after->untracked - before->untracked )
+  );
+
+  max_sites = malloc_profiling_limit( count, max_sites );
+
+  for ( i = 0; i < count && max_sites > 0; ++i ) {
+    const malloc_profiling_delta *delta = &deltas[ i ];
+    uint64_t rate;
+
+    if (
+      delta->delta_bytes == 0 && delta->delta_count == 0 && delta->calls == 0
+    ) {
+      continue;
+    }
+
+    rate = malloc_profiling_call_rate( delta->calls, ticks );
+
+    (*print)(
+      context,
+      "0x%08" PRIxPTR " %12" PRIdMAX " %11" PRIi32 " %10" PRIu32 " %5" PRIu64
+        ".%03" PRIu64 "\n",
+      (uintptr_t) delta->caller,
+      delta->delta_bytes,
+      delta->delta_count,
+      delta->calls,
+      rate / 1000,
+      rate % 1000
+    );
+    --max_sites;
+  }
+
+  free( deltas );
+}
+
+void rtems_malloc_profiling_report_diff(
+  const rtems_malloc_profiling_snapshot *before,
+  const rtems_malloc_profiling_snapshot *after
+)
+{
+  rtems_malloc_profiling_report_diff_with_plugin(
+    NULL,
+    printk_plugin,
+    before,
+    after,
+    0
+  );
+}
+
+#endif
@@ -42,6 +42,11 @@ int posix_memalign(
    *  rtems_memalign does all of the error checking work EXCEPT
    *  for adding restrictionso on the alignment.
    */
-  return rtems_memalign( pointer, alignment, size );
+  return rtems_memalign_with_caller(
+    pointer,
+    alignment,
+    size,
+    MALLOC_CALLER()
+  );
 }
 #endif
@@ -50,7 +50,7 @@ void *realloc(
    * Continue with realloc().
    */
   if ( !ptr )
-    return malloc( size );
+    return malloc_with_caller( size, MALLOC_CALLER() );
 
   if ( !size ) {
     free( ptr );
@@ -66,6 +66,16 @@ void *realloc(
    *  Now resize it.
    */
   if ( _Protected_heap_Resize_block( RTEMS_Malloc_Heap, ptr, size ) ) {
+    /*
+     *  If configured, account the resized block to the caller
+     */
+    if ( rtems_malloc_profiling_helpers ) {
+      void *caller = MALLOC_CALLER();
+
+      (*rtems_malloc_profiling_helpers->at_free)(ptr);
+      (*rtems_malloc_profiling_helpers->at_malloc)(ptr, size, caller);
+    }
+
     return ptr;
   }
 
@@ -75,7 +85,7 @@ void *realloc(
    *  and the C Standard.
    */
 
-  new_area = malloc( size );
+  new_area = malloc_with_caller( size, MALLOC_CALLER() );
 
   MSBUMP(malloc_calls, (uint32_t) -1);   /* subtract off the malloc */
 
@@ -26,10 +26,11 @@
 
 #include <rtems/score/sysstate.h>
 
-int rtems_memalign(
+int rtems_memalign_with_caller(
   void   **pointer,
   size_t   alignment,
-  size_t   size
+  size_t   size,
+  void    *caller
 )
 {
   void *return_this;
@@ -69,9 +70,29 @@ int rtems_memalign(
    *  If configured, update the more involved statistics
    */
   if ( rtems_malloc_statistics_helpers )
-    (*rtems_malloc_statistics_helpers->at_malloc)(pointer);
+    (*rtems_malloc_statistics_helpers->at_malloc)(return_this);
+
+  /*
+   *  If configured, account the allocation to its caller
+   */
+  if ( rtems_malloc_profiling_helpers )
+    (*rtems_malloc_profiling_helpers->at_malloc)(return_this, size, caller);
 
   *pointer = return_this;
   return 0;
 }
+
+int rtems_memalign(
+  void   **pointer,
+  size_t   alignment,
+  size_t   size
+)
+{
+  return rtems_memalign_with_caller(
+    pointer,
+    alignment,
+    size,
+    MALLOC_CALLER()
+  );
+}
 #endif
@@ -23,6 +23,7 @@
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <termios.h>
 #include <unistd.h>
 #include <sys/ttycom.h>
@@ -144,7 +145,8 @@ rtems_termios_open (
     /*
      * allocate raw input buffer
      */
-    tty->rawInBuf.Size = RAW_INPUT_BUFFER_SIZE;
+    tty->rawInBuf.Size = callbacks->rawInputBufferSize != 0 ?
+      callbacks->rawInputBufferSize : RAW_INPUT_BUFFER_SIZE;
     tty->rawInBuf.theBuf = malloc (tty->rawInBuf.Size);
     if (tty->rawInBuf.theBuf == NULL) {
             free(tty);
@@ -154,7 +156,8 @@ rtems_termios_open (
     /*
      * allocate raw output buffer
      */
-    tty->rawOutBuf.Size = RAW_OUTPUT_BUFFER_SIZE;
+    tty->rawOutBuf.Size = callbacks->rawOutputBufferSize != 0 ?
+      callbacks->rawOutputBufferSize : RAW_OUTPUT_BUFFER_SIZE;
     tty->rawOutBuf.theBuf = malloc (tty->rawOutBuf.Size);
     if (tty->rawOutBuf.theBuf == NULL) {
             free((void *)(tty->rawInBuf.theBuf));
@@ -679,23 +682,19 @@ rtems_termios_puts (
     (*tty->device.write)(tty->minor, buf, len);
     return;
   }
-  newHead = tty->rawOutBuf.Head;
   while (len) {
+    unsigned int head;
+    unsigned int tail;
+    size_t nToCopy;
+
     /*
-     * Performance improvement could be made here.
-     * Copy multiple bytes to raw buffer:
-     * if (len > 1) && (space to buffer end, or tail > 1)
-     *  ncopy = MIN (len, space to buffer end or tail)
-     *  memcpy (raw buffer, buf, ncopy)
-     *  buf += ncopy
-     *  len -= ncopy
-     *
-     * To minimize latency, the memcpy should be done
-     * with interrupts enabled.
+     * Wait for space in the raw buffer and determine the contiguous free
+     * area behind the head.  One slot stays unused to distinguish a full
+     * from an empty buffer.
      */
-    newHead = (newHead + 1) % tty->rawOutBuf.Size;
     rtems_termios_interrupt_lock_acquire (tty, &lock_context);
-    while (newHead == tty->rawOutBuf.Tail) {
+    head = tty->rawOutBuf.Head;
+    while ((head + 1) % tty->rawOutBuf.Size == tty->rawOutBuf.Tail) {
       tty->rawOutBufState = rob_wait;
       rtems_termios_interrupt_lock_release (tty, &lock_context);
       sc = rtems_semaphore_obtain(
@@ -704,13 +703,38 @@ rtems_termios_puts (
         rtems_fatal_error_occurred (sc);
       rtems_termios_interrupt_lock_acquire (tty, &lock_context);
     }
-    tty->rawOutBuf.theBuf[tty->rawOutBuf.Head] = *buf++;
+    tail = tty->rawOutBuf.Tail;
+    rtems_termios_interrupt_lock_release (tty, &lock_context);
+
+    if (tail > head)
+      nToCopy = tail - head - 1;
+    else
+      nToCopy = tty->rawOutBuf.Size - head - (tail == 0 ? 1 : 0);
+    if (nToCopy > len)
+      nToCopy = len;
+
+    /*
+     * The transmitter only consumes characters up to the head, so the copy
+     * can be done with interrupts enabled.
+     */
+    memcpy (&tty->rawOutBuf.theBuf[head], buf, nToCopy);
+    newHead = (head + nToCopy) % tty->rawOutBuf.Size;
+
+    rtems_termios_interrupt_lock_acquire (tty, &lock_context);
     tty->rawOutBuf.Head = newHead;
     if (tty->rawOutBufState == rob_idle) {
       /* check, whether XOFF has been received */
       if (!(tty->flow_ctrl & FL_ORCVXOF)) {
+        unsigned int nToSend;
+
+        /* hand over the contiguous range up to the new head at once */
+        tail = tty->rawOutBuf.Tail;
+        if (newHead > tail)
+          nToSend = newHead - tail;
+        else
+          nToSend = tty->rawOutBuf.Size - tail;
         (*tty->device.write)(
-          tty->minor, &tty->rawOutBuf.theBuf[tty->rawOutBuf.Tail],1);
+          tty->minor, &tty->rawOutBuf.theBuf[tail], nToSend);
       } else {
         /* remember that output has been stopped due to flow ctrl*/
         tty->flow_ctrl |= FL_OSTOP;
@@ -718,7 +742,8 @@ rtems_termios_puts (
       tty->rawOutBufState = rob_busy;
     }
     rtems_termios_interrupt_lock_release (tty, &lock_context);
-    len--;
+    buf += nToCopy;
+    len -= nToCopy;
   }
 }
 
@@ -1039,6 +1064,31 @@ fillBufferPoll (struct rtems_termios_tty *tty)
   return RTEMS_SUCCESSFUL;
 }
 
+/*
+ * Restart the remote transmitter once the raw input buffer drained below the
+ * low water mark
+ */
+static void
+termios_start_remote_tx (struct rtems_termios_tty *tty)
+{
+  tty->flow_ctrl &= ~FL_IREQXOF;
+  /* if tx stopped and XON should be sent... */
+  if (((tty->flow_ctrl & (FL_MDXON | FL_ISNTXOF))
+       ==                (FL_MDXON | FL_ISNTXOF))
+      && ((tty->rawOutBufState == rob_idle)
+    || (tty->flow_ctrl & FL_OSTOP))) {
+    /* XON should be sent now... */
+    (*tty->device.write)(
+      tty->minor, (void *)&(tty->termios.c_cc[VSTART]), 1);
+  } else if (tty->flow_ctrl & FL_MDRTS) {
+    tty->flow_ctrl &= ~FL_IRTSOFF;
+    /* activate RTS line */
+    if (tty->device.startRemoteTx != NULL) {
+      tty->device.startRemoteTx(tty->minor);
+    }
+  }
+}
+
 /*
  * Fill the input buffer from the raw input queue
  */
@@ -1064,22 +1114,7 @@ fillBufferQueue (struct rtems_termios_tty *tty)
       if(((tty->rawInBuf.Tail-newHead+tty->rawInBuf.Size)
           % tty->rawInBuf.Size)
          < tty->lowwater) {
-        tty->flow_ctrl &= ~FL_IREQXOF;
-        /* if tx stopped and XON should be sent... */
-        if (((tty->flow_ctrl & (FL_MDXON | FL_ISNTXOF))
-             ==                (FL_MDXON | FL_ISNTXOF))
-            && ((tty->rawOutBufState == rob_idle)
-          || (tty->flow_ctrl & FL_OSTOP))) {
-          /* XON should be sent now... */
-          (*tty->device.write)(
-            tty->minor, (void *)&(tty->termios.c_cc[VSTART]), 1);
-        } else if (tty->flow_ctrl & FL_MDRTS) {
-          tty->flow_ctrl &= ~FL_IRTSOFF;
-          /* activate RTS line */
-          if (tty->device.startRemoteTx != NULL) {
-            tty->device.startRemoteTx(tty->minor);
-          }
-        }
+        termios_start_remote_tx (tty);
       }
 
       /* continue processing new character */
@@ -1107,6 +1142,72 @@ fillBufferQueue (struct rtems_termios_tty *tty)
   return RTEMS_SUCCESSFUL;
 }
 
+/*
+ * Check whether input processing passes the raw characters unchanged, so
+ * that they can be copied directly from the raw input queue to the reader
+ */
+static bool
+termios_is_raw_input (const struct rtems_termios_tty *tty)
+{
+  return (tty->termios.c_iflag & (ISTRIP | IUCLC | IGNCR | ICRNL | INLCR)) == 0
+    && (tty->termios.c_lflag & (ICANON | ECHO | ECHONL)) == 0;
+}
+
+/*
+ * Copy characters from the raw input queue directly to the reader buffer,
+ * one contiguous range at a time.  VMIN and VTIME are handled like in
+ * fillBufferQueue().  Returns the number of characters copied.
+ */
+static uint32_t
+fillUserBufferQueue (struct rtems_termios_tty *tty, char *buffer,
+  uint32_t count)
+{
+  rtems_interval timeout = tty->rawInBufSemaphoreFirstTimeout;
+  uint32_t vmin = tty->termios.c_cc[VMIN];
+  uint32_t n = 0;
+  rtems_status_code sc;
+
+  if (vmin > count)
+    vmin = count;
+
+  for (;;) {
+    while ((n < count) && (tty->rawInBuf.Head != tty->rawInBuf.Tail)) {
+      unsigned int tail = tty->rawInBuf.Tail;
+      unsigned int first = (tty->rawInBuf.Head + 1) % tty->rawInBuf.Size;
+      uint32_t nToCopy;
+
+      if (tail >= first)
+        nToCopy = tail - first + 1;
+      else
+        nToCopy = tty->rawInBuf.Size - first;
+      if (nToCopy > count - n)
+        nToCopy = count - n;
+
+      memcpy (&buffer[n], &tty->rawInBuf.theBuf[first], nToCopy);
+      n += nToCopy;
+      tty->rawInBuf.Head = (first + nToCopy - 1) % tty->rawInBuf.Size;
+      if(((tty->rawInBuf.Tail-tty->rawInBuf.Head+tty->rawInBuf.Size)
+          % tty->rawInBuf.Size)
+         < tty->lowwater) {
+        termios_start_remote_tx (tty);
+      }
+      timeout = tty->rawInBufSemaphoreTimeout;
+    }
+
+    if ((n == count) || ((n > 0) && (n >= vmin)))
+      break;
+
+    /*
+     * Wait for characters
+     */
+    sc = rtems_semaphore_obtain(
+      tty->rawInBuf.Semaphore, tty->rawInBufSemaphoreOptions, timeout);
+    if (sc != RTEMS_SUCCESSFUL)
+      break;
+  }
+  return n;
+}
+
 rtems_status_code
 rtems_termios_read (void *arg)
 {
@@ -1133,7 +1234,12 @@ rtems_termios_read (void *arg)
     if (tty->device.pollRead != NULL &&
         tty->device.outputUsesInterrupts == TERMIOS_POLLED)
       sc = fillBufferPoll (tty);
-    else
+    else if (termios_is_raw_input (tty)) {
+      uint32_t moved = fillUserBufferQueue (tty, buffer, count);
+
+      buffer += moved;
+      count -= moved;
+    } else
       sc = fillBufferQueue (tty);
 
     if (sc != RTEMS_SUCCESSFUL)
@@ -1162,6 +1268,34 @@ void rtems_termios_rxirq_occured(struct rtems_termios_tty *tty)
   rtems_event_send(tty->rxTaskId,TERMIOS_RX_PROC_EVENT);
 }
 
+/*
+ * Stop the remote transmitter since the raw input buffer filled above the
+ * high water mark.  Must be called with interrupts disabled.
+ */
+static void
+termios_stop_remote_tx (struct rtems_termios_tty *tty)
+{
+  /* incoming data stream should be stopped */
+  tty->flow_ctrl |= FL_IREQXOF;
+  if ((tty->flow_ctrl & (FL_MDXOF | FL_ISNTXOF))
+      ==                (FL_MDXOF             ) ) {
+    if ((tty->flow_ctrl & FL_OSTOP) ||
+        (tty->rawOutBufState == rob_idle)) {
+      /* if tx is stopped due to XOFF or out of data */
+      /*    call write function here                 */
+      tty->flow_ctrl |= FL_ISNTXOF;
+      (*tty->device.write)(tty->minor,
+          (void *)&(tty->termios.c_cc[VSTOP]), 1);
+    }
+  } else if ((tty->flow_ctrl & (FL_MDRTS | FL_IRTSOFF)) == (FL_MDRTS) ) {
+    tty->flow_ctrl |= FL_IRTSOFF;
+    /* deactivate RTS line */
+    if (tty->device.stopRemoteTx != NULL) {
+      tty->device.stopRemoteTx(tty->minor);
+    }
+  }
+}
+
 /*
  * Place characters on raw queue.
  * NOTE: This routine runs in the context of the
@@ -1242,25 +1376,7 @@ rtems_termios_enqueue_raw_characters (void *ttyp, const char *buf, int len)
       if ((((newTail - tty->rawInBuf.Head + tty->rawInBuf.Size)
             % tty->rawInBuf.Size) > tty->highwater) &&
           !(tty->flow_ctrl & FL_IREQXOF)) {
-        /* incoming data stream should be stopped */
-        tty->flow_ctrl |= FL_IREQXOF;
-        if ((tty->flow_ctrl & (FL_MDXOF | FL_ISNTXOF))
-            ==                (FL_MDXOF             ) ) {
-          if ((tty->flow_ctrl & FL_OSTOP) ||
-              (tty->rawOutBufState == rob_idle)) {
-            /* if tx is stopped due to XOFF or out of data */
-            /*    call write function here                 */
-            tty->flow_ctrl |= FL_ISNTXOF;
-            (*tty->device.write)(tty->minor,
-                (void *)&(tty->termios.c_cc[VSTOP]), 1);
-          }
-        } else if ((tty->flow_ctrl & (FL_MDRTS | FL_IRTSOFF)) == (FL_MDRTS) ) {
-          tty->flow_ctrl |= FL_IRTSOFF;
-          /* deactivate RTS line */
-          if (tty->device.stopRemoteTx != NULL) {
-            tty->device.stopRemoteTx(tty->minor);
-          }
-        }
+        termios_stop_remote_tx (tty);
       }
 
       /* reenable interrupts */
@@ -1288,6 +1404,71 @@ rtems_termios_enqueue_raw_characters (void *ttyp, const char *buf, int len)
   return dropped;
 }
 
+/*
+ * Return the contiguous free area of the raw queue behind the tail.
+ * NOTE: This routine runs in the context of the
+ *       device receive interrupt handler.
+ */
+char *
+rtems_termios_raw_input_space (void *ttyp, size_t *size)
+{
+  struct rtems_termios_tty *tty = ttyp;
+  unsigned int head;
+  unsigned int first;
+
+  if ((rtems_termios_linesw[tty->t_line].l_rint != NULL) ||
+      (tty->flow_ctrl & FL_MDXON)) {
+    *size = 0;
+    return NULL;
+  }
+
+  head = tty->rawInBuf.Head;
+  first = (tty->rawInBuf.Tail + 1) % tty->rawInBuf.Size;
+  if (head >= first)
+    *size = head - first;
+  else
+    *size = tty->rawInBuf.Size - first;
+  return &tty->rawInBuf.theBuf[first];
+}
+
+/*
+ * Append characters placed into the area returned by
+ * rtems_termios_raw_input_space() to the raw queue.
+ * NOTE: This routine runs in the context of the
+ *       device receive interrupt handler.
+ */
+void
+rtems_termios_commit_raw_characters (void *ttyp, size_t len)
+{
+  struct rtems_termios_tty *tty = ttyp;
+  unsigned int newTail;
+  rtems_interrupt_lock_context lock_context;
+
+  if (len == 0)
+    return;
+
+  newTail = (tty->rawInBuf.Tail + len) % tty->rawInBuf.Size;
+  rtems_termios_interrupt_lock_acquire (tty, &lock_context);
+  if ((((newTail - tty->rawInBuf.Head + tty->rawInBuf.Size)
+        % tty->rawInBuf.Size) > tty->highwater) &&
+      !(tty->flow_ctrl & FL_IREQXOF)) {
+    termios_stop_remote_tx (tty);
+  }
+  rtems_termios_interrupt_lock_release (tty, &lock_context);
+
+  tty->rawInBuf.Tail = newTail;
+
+  /*
+   * check to see if rcv wakeup callback was set
+   */
+  if (( !tty->tty_rcvwakeup ) && ( tty->tty_rcv.sw_pfn != NULL )) {
+    (*tty->tty_rcv.sw_pfn)(&tty->termios, tty->tty_rcv.sw_arg);
+    tty->tty_rcvwakeup = 1;
+  }
+
+  rtems_semaphore_release (tty->rawInBuf.Semaphore);
+}
+
 /*
  * in task-driven mode, this function is called in Tx task context
  * in interrupt-driven mode, this function is called in TxIRQ context
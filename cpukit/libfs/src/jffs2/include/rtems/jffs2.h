@@ -15,7 +15,9 @@
 #ifndef RTEMS_JFFS2_H
 #define RTEMS_JFFS2_H
 
+#include <rtems.h>
 #include <rtems/fs.h>
+#include <sys/ioctl.h>
 #include <sys/param.h>
 #include <zlib.h>
 
@@ -43,6 +45,11 @@ typedef struct rtems_jffs2_flash_control rtems_jffs2_flash_control;
  * The application must enable JFFS2 support with rtems_filesystem_register()
  * or CONFIGURE_FILESYSTEM_JFFS2 via <rtems/confdefs.h>.
  *
+ * A summary node is written at the end of each erase block once it is full.
+ * The mount reads only the summary of such erase blocks and scans the nodes
+ * of erase blocks without a valid summary, so the mount time is proportional
+ * to the number of erase blocks rather than to the amount of data.
+ *
  * An example mount with a simple memory based flash device simulation follows.
  * The zlib is used for as the compressor.
  *
@@ -426,8 +433,93 @@ typedef struct {
    * The compressor is optional and this pointer may be @c NULL.
    */
   rtems_jffs2_compressor_control *compressor_control;
+
+  /**
+   * @brief Priority of the background garbage collection task.
+   *
+   * In case this value is zero, then no background garbage collection task
+   * is created for this file system instance and the garbage collection
+   * takes place only in the context of writers which run out of free space.
+   *
+   * The background garbage collection task should have a priority lower than
+   * the writers, so that it uses the idle time of the system.  It performs
+   * one garbage collection pass or erases one block at a time with the file
+   * system instance lock held, so a writer waits at most for one such step.
+   */
+  rtems_task_priority gc_task_priority;
+
+  /**
+   * @brief Stack size of the background garbage collection task.
+   *
+   * Values less than RTEMS_MINIMUM_STACK_SIZE select the minimum stack size.
+   */
+  size_t gc_task_stack_size;
+
+  /**
+   * @brief Free blocks threshold of the background garbage collection.
+   *
+   * The background garbage collection task reclaims dirty erase blocks while
+   * the count of free and erasing blocks is less than this threshold.  In
+   * case this value is less than the garbage collection trigger of JFFS2
+   * (the reserved blocks for writes plus one), then the trigger is used.
+   */
+  uint32_t gc_free_blocks_threshold;
 } rtems_jffs2_mount_data;
 
+/**
+ * @brief JFFS2 garbage collection statistics.
+ *
+ * @see RTEMS_JFFS2_GET_GC_INFO.
+ */
+typedef struct {
+  /**
+   * @brief Count of garbage collection passes and block erasures performed
+   * by the background garbage collection task.
+   */
+  uint32_t background_passes;
+
+  /**
+   * @brief Accumulated time in nanoseconds of the background garbage
+   * collection passes.
+   */
+  uint64_t background_time;
+
+  /**
+   * @brief Count of garbage collection passes performed in the context of
+   * writers which ran out of free space.
+   */
+  uint32_t foreground_stalls;
+
+  /**
+   * @brief Accumulated time in nanoseconds of the foreground garbage
+   * collection passes.
+   */
+  uint64_t foreground_stall_time;
+
+  /**
+   * @brief Maximum time in nanoseconds of a foreground garbage collection
+   * pass.
+   */
+  uint64_t foreground_stall_max;
+} rtems_jffs2_gc_info;
+
+/**
+ * @brief IO control to get the garbage collection statistics of a JFFS2 file
+ * system instance.
+ *
+ * The IO control can be issued on every file descriptor of a file or
+ * directory of the file system instance.  The buffer must point to a
+ * @ref rtems_jffs2_gc_info structure, otherwise the IO control fails with
+ * errno set to EFAULT.  Other IO controls fail with errno set to ENOTTY.
+ *
+ * @code
+ * rtems_jffs2_gc_info info;
+ * int fd = open("/mnt", O_RDONLY);
+ * int rv = ioctl(fd, RTEMS_JFFS2_GET_GC_INFO, &info);
+ * @endcode
+ */
+#define RTEMS_JFFS2_GET_GC_INFO _IOR('F', 1, rtems_jffs2_gc_info)
+
 /**
  * @brief Initialization handler of the JFFS2 file system.
  *
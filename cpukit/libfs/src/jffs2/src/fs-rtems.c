@@ -25,6 +25,7 @@
 #include <errno.h>
 #include <string.h>
 #include <assert.h>
+#include <rtems/counter.h>
 #include <rtems/libio_.h>
 
 /* Ensure that the JFFS2 values are identical to the POSIX defines */
@@ -326,6 +327,110 @@ static void rtems_jffs2_do_unlock(const struct super_block *sb)
 	assert(sc == RTEMS_SUCCESSFUL);
 }
 
+#define RTEMS_JFFS2_GC_EVENT_TRIGGER RTEMS_EVENT_0
+
+#define RTEMS_JFFS2_GC_EVENT_STOP RTEMS_EVENT_1
+
+static uint64_t rtems_jffs2_elapsed_nanoseconds(rtems_counter_ticks begin)
+{
+	rtems_counter_ticks end = rtems_counter_read();
+
+	return rtems_counter_ticks_to_nanoseconds(rtems_counter_difference(end, begin));
+}
+
+static bool rtems_jffs2_gc_should_run(const struct super_block *sb, struct jffs2_sb_info *c)
+{
+	uint32_t dirty;
+
+	if (jffs2_thread_should_wake(c)) {
+		return true;
+	}
+
+	/* See jffs2_thread_should_wake() */
+	dirty = c->dirty_size + c->erasing_size - c->nr_erasing_blocks * c->sector_size;
+
+	return c->nr_free_blocks + c->nr_erasing_blocks < sb->s_gc_free_blocks_threshold
+		&& dirty > c->nospc_dirty_size;
+}
+
+/*
+ * The background garbage collection task performs one garbage collection pass
+ * at a time with the file system instance lock held.  A pass either checks
+ * one inode, erases one block or moves one node out of the block selected for
+ * garbage collection.  So, writers wait at most for one pass.
+ */
+static void rtems_jffs2_gc_task(rtems_task_argument arg)
+{
+	struct super_block *sb = (struct super_block *) arg;
+	struct jffs2_sb_info *c = JFFS2_SB_INFO(sb);
+	rtems_event_set events;
+	rtems_status_code sc;
+
+	do {
+		sc = rtems_event_receive(
+			RTEMS_JFFS2_GC_EVENT_TRIGGER | RTEMS_JFFS2_GC_EVENT_STOP,
+			RTEMS_EVENT_ANY | RTEMS_WAIT,
+			RTEMS_NO_TIMEOUT,
+			&events
+		);
+		assert(sc == RTEMS_SUCCESSFUL);
+
+		while ((events & RTEMS_JFFS2_GC_EVENT_STOP) == 0) {
+			bool run;
+			int ret = 0;
+
+			rtems_jffs2_do_lock(sb);
+
+			run = rtems_jffs2_gc_should_run(sb, c);
+			if (run) {
+				rtems_counter_ticks begin = rtems_counter_read();
+
+				ret = jffs2_garbage_collect_pass(c);
+
+				sb->s_gc_info.background_time +=
+					rtems_jffs2_elapsed_nanoseconds(begin);
+				++sb->s_gc_info.background_passes;
+			}
+
+			rtems_jffs2_do_unlock(sb);
+
+			if (!run || ret != 0) {
+				break;
+			}
+
+			sc = rtems_event_receive(
+				RTEMS_JFFS2_GC_EVENT_STOP,
+				RTEMS_EVENT_ANY | RTEMS_NO_WAIT,
+				0,
+				&events
+			);
+			if (sc != RTEMS_SUCCESSFUL) {
+				events = 0;
+			}
+		}
+	} while ((events & RTEMS_JFFS2_GC_EVENT_STOP) == 0);
+
+	sc = rtems_event_transient_send(sb->s_gc_stop_requester);
+	assert(sc == RTEMS_SUCCESSFUL);
+
+	rtems_task_delete(RTEMS_SELF);
+}
+
+static void rtems_jffs2_stop_gc_task(struct super_block *sb)
+{
+	rtems_status_code sc;
+
+	sb->s_gc_stop_requester = rtems_task_self();
+
+	sc = rtems_event_send(sb->s_gc_task, RTEMS_JFFS2_GC_EVENT_STOP);
+	assert(sc == RTEMS_SUCCESSFUL);
+
+	sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+	assert(sc == RTEMS_SUCCESSFUL);
+
+	sb->s_gc_task = 0;
+}
+
 static void rtems_jffs2_free_directory_entries(struct _inode *inode)
 {
         struct jffs2_full_dirent *current = inode->jffs2_i.dents;
@@ -360,9 +465,15 @@ static void rtems_jffs2_free_fs_info(rtems_jffs2_fs_info *fs_info, bool do_mount
 	if (do_mount_fs_was_successful) {
 		jffs2_free_ino_caches(c);
 		jffs2_free_raw_node_refs(c);
+		jffs2_sum_exit(c);
 		free(c->blocks);
 	}
 
+	if (sb->s_gc_task != 0) {
+		rtems_status_code sc = rtems_task_delete(sb->s_gc_task);
+		assert(sc == RTEMS_SUCCESSFUL);
+	}
+
 	if (sb->s_mutex != 0) {
 		rtems_status_code sc = rtems_semaphore_delete(sb->s_mutex);
 		assert(sc == RTEMS_SUCCESSFUL);
@@ -505,12 +616,42 @@ static ssize_t rtems_jffs2_dir_read(rtems_libio_t *iop, void *buf, size_t len)
 	}
 }
 
+static int rtems_jffs2_ioctl(
+	rtems_libio_t   *iop,
+	ioctl_command_t  request,
+	void            *buffer
+)
+{
+	struct _inode *inode = rtems_jffs2_get_inode_by_iop(iop);
+	struct super_block *sb = inode->i_sb;
+	int eno;
+
+	switch (request) {
+		case RTEMS_JFFS2_GET_GC_INFO:
+			if (buffer == NULL) {
+				eno = EFAULT;
+				break;
+			}
+
+			rtems_jffs2_do_lock(sb);
+			*(rtems_jffs2_gc_info *) buffer = sb->s_gc_info;
+			rtems_jffs2_do_unlock(sb);
+			eno = 0;
+			break;
+		default:
+			eno = ENOTTY;
+			break;
+	}
+
+	return rtems_jffs2_eno_to_rv_and_errno(eno);
+}
+
 static const rtems_filesystem_file_handlers_r rtems_jffs2_directory_handlers = {
 	.open_h = rtems_filesystem_default_open,
 	.close_h = rtems_filesystem_default_close,
 	.read_h = rtems_jffs2_dir_read,
 	.write_h = rtems_filesystem_default_write,
-	.ioctl_h = rtems_filesystem_default_ioctl,
+	.ioctl_h = rtems_jffs2_ioctl,
 	.lseek_h = rtems_filesystem_default_lseek_directory,
 	.fstat_h = rtems_jffs2_fstat,
 	.ftruncate_h = rtems_filesystem_default_ftruncate_directory,
@@ -652,7 +793,7 @@ static const rtems_filesystem_file_handlers_r rtems_jffs2_file_handlers = {
 	.close_h = rtems_filesystem_default_close,
 	.read_h = rtems_jffs2_file_read,
 	.write_h = rtems_jffs2_file_write,
-	.ioctl_h = rtems_filesystem_default_ioctl,
+	.ioctl_h = rtems_jffs2_ioctl,
 	.lseek_h = rtems_filesystem_default_lseek_file,
 	.fstat_h = rtems_jffs2_fstat,
 	.ftruncate_h = rtems_jffs2_file_ftruncate,
@@ -993,6 +1134,10 @@ static void rtems_jffs2_fsunmount(rtems_filesystem_mount_table_entry_t *mt_entry
 	rtems_jffs2_fs_info *fs_info = mt_entry->fs_info;
 	struct _inode *root_i = mt_entry->mt_fs_root->location.node_access;
 
+	if (fs_info->sb.s_gc_task != 0) {
+		rtems_jffs2_stop_gc_task(&fs_info->sb);
+	}
+
 	icache_evict(root_i, NULL);
 	assert(root_i->i_cache_next == NULL);
 	assert(root_i->i_count == 1);
@@ -1208,6 +1353,19 @@ int rtems_jffs2_initialize(
 		err = sc == RTEMS_SUCCESSFUL ? 0 : -ENOMEM;
 	}
 
+	if (err == 0 && jffs2_mount_data->gc_task_priority != 0 && mt_entry->writeable) {
+		rtems_status_code sc = rtems_task_create(
+			rtems_build_name('J', 'F', 'G', 'C'),
+			jffs2_mount_data->gc_task_priority,
+			jffs2_mount_data->gc_task_stack_size,
+			RTEMS_DEFAULT_MODES,
+			RTEMS_DEFAULT_ATTRIBUTES,
+			&sb->s_gc_task
+		);
+
+		err = sc == RTEMS_SUCCESSFUL ? 0 : -ENOMEM;
+	}
+
 	if (err == 0) {
 		sb->s_is_readonly = !mt_entry->writeable;
 		sb->s_flash_control = fc;
@@ -1238,6 +1396,20 @@ int rtems_jffs2_initialize(
 			jffs2_erase_pending_blocks(c, 0);
 		}
 
+		sb->s_gc_free_blocks_threshold = jffs2_mount_data->gc_free_blocks_threshold;
+		if (sb->s_gc_free_blocks_threshold < c->resv_blocks_gctrigger) {
+			sb->s_gc_free_blocks_threshold = c->resv_blocks_gctrigger;
+		}
+
+		if (sb->s_gc_task != 0) {
+			rtems_status_code sc = rtems_task_start(
+				sb->s_gc_task,
+				rtems_jffs2_gc_task,
+				(rtems_task_argument) sb
+			);
+			assert(sc == RTEMS_SUCCESSFUL);
+		}
+
 		mt_entry->fs_info = fs_info;
 		mt_entry->ops = &rtems_jffs2_ops;
 		mt_entry->mt_fs_root->location.node_access = sb->s_root;
@@ -1266,6 +1438,38 @@ int rtems_jffs2_initialize(
 //
 //==========================================================================
 
+void jffs2_garbage_collect_trigger(struct jffs2_sb_info *c)
+{
+	struct super_block *sb = OFNI_BS_2SFFJ(c);
+
+	if (sb->s_gc_task != 0 && rtems_jffs2_gc_should_run(sb, c)) {
+		rtems_status_code sc = rtems_event_send(
+			sb->s_gc_task,
+			RTEMS_JFFS2_GC_EVENT_TRIGGER
+		);
+		assert(sc == RTEMS_SUCCESSFUL);
+	}
+}
+
+int jffs2_foreground_garbage_collect_pass(struct jffs2_sb_info *c)
+{
+	struct super_block *sb = OFNI_BS_2SFFJ(c);
+	rtems_counter_ticks begin = rtems_counter_read();
+	uint64_t d;
+	int ret;
+
+	ret = jffs2_garbage_collect_pass(c);
+
+	d = rtems_jffs2_elapsed_nanoseconds(begin);
+	sb->s_gc_info.foreground_stall_time += d;
+	if (d > sb->s_gc_info.foreground_stall_max) {
+		sb->s_gc_info.foreground_stall_max = d;
+	}
+	++sb->s_gc_info.foreground_stalls;
+
+	return ret;
+}
+
 unsigned char *jffs2_gc_fetch_page(struct jffs2_sb_info *c, 
 				   struct jffs2_inode_info *f, 
 				   unsigned long offset,
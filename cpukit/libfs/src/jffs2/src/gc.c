@@ -573,6 +573,7 @@ static int jffs2_garbage_collect_pristine(struct jffs2_sb_info *c,
 					  struct jffs2_raw_node_ref *raw)
 {
 	union jffs2_node_union *node;
+	struct kvec vecs[1];
 	size_t retlen;
 	int ret;
 	uint32_t phys_ofs, alloclen;
@@ -677,7 +678,10 @@ static int jffs2_garbage_collect_pristine(struct jffs2_sb_info *c,
  retry:
 	phys_ofs = write_ofs(c);
 
-	ret = jffs2_flash_write(c, phys_ofs, rawlen, &retlen, (char *)node);
+	/* Write through the vector interface so the copy is summarised */
+	vecs[0].iov_base = (unsigned char *)node;
+	vecs[0].iov_len = rawlen;
+	ret = jffs2_flash_writev(c, vecs, 1, phys_ofs, &retlen, 0);
 
 	if (ret || (retlen != rawlen)) {
 		pr_notice("Write of %d bytes at 0x%08x failed. returned %d, retlen %zd\n",
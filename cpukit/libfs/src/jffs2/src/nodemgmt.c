@@ -164,7 +164,7 @@ int jffs2_reserve_space(struct jffs2_sb_info *c, uint32_t minsize,
 				  c->flash_size);
 			spin_unlock(&c->erase_completion_lock);
 
-			ret = jffs2_garbage_collect_pass(c);
+			ret = jffs2_foreground_garbage_collect_pass(c);
 
 			if (ret == -EAGAIN) {
 				spin_lock(&c->erase_completion_lock);
@@ -105,6 +105,10 @@ struct super_block {
 	bool			s_is_readonly;
 	unsigned char		s_gc_buffer[PAGE_CACHE_SIZE]; // Avoids malloc when user may be under memory pressure
 	rtems_id		s_mutex;
+	rtems_id		s_gc_task;
+	rtems_id		s_gc_stop_requester;
+	uint32_t		s_gc_free_blocks_threshold;
+	rtems_jffs2_gc_info	s_gc_info;
 	char			s_name_buf[JFFS2_MAX_NAME_LEN];
 };
 
@@ -118,12 +122,9 @@ static inline bool jffs2_is_readonly(struct jffs2_sb_info *c)
 	return sb->s_is_readonly;
 }
 
-static inline void jffs2_garbage_collect_trigger(struct jffs2_sb_info *c)
-{
-       /* We don't have a GC thread in RTEMS (yet) */
-}
-
 /* fs-rtems.c */
+void jffs2_garbage_collect_trigger(struct jffs2_sb_info *c);
+int jffs2_foreground_garbage_collect_pass(struct jffs2_sb_info *c);
 struct _inode *jffs2_new_inode (struct _inode *dir_i, int mode, struct jffs2_raw_inode *ri);
 struct _inode *jffs2_iget(struct super_block *sb, cyg_uint32 ino);
 void jffs2_iput(struct _inode * i);
@@ -168,6 +168,60 @@ nfsInit(int smallPoolDepth, int bigPoolDepth);
 int
 nfsCleanup(void);
 
+/**
+ * @brief Number of READ requests kept in flight for a file which
+ * is read sequentially (read-ahead).
+ *
+ * Zero disables read-ahead; values are clipped to 8.
+ */
+extern int nfsReadAhead;
+
+/**
+ * @brief Number of outstanding WRITE requests per open file
+ * (write-behind).
+ *
+ * Errors of outstanding requests are reported by a subsequent write(),
+ * fsync() or close().  Zero makes write() synchronous; values are
+ * clipped to 8.
+ */
+extern int nfsWriteBehind;
+
+/**
+ * @brief Size in bytes of the data cache shared by all mounted NFS.
+ *
+ * Files which are opened read-only and are not bigger than
+ * @ref nfsCacheMaxFile are read into the cache on first use.  Cached
+ * data are validated against the modification time and size reported
+ * by the server whenever a file is opened (close-to-open consistency).
+ * Zero disables the cache.
+ */
+extern int nfsCacheSize;
+
+/**
+ * @brief Size in bytes of the biggest file kept in the data cache.
+ */
+extern int nfsCacheMaxFile;
+
+/**
+ * @brief Statistics of the data cache.
+ */
+typedef struct {
+	/** @brief Opens which found valid cached data. */
+	unsigned long hits;
+
+	/** @brief Files read into the cache. */
+	unsigned long loads;
+
+	/** @brief Entries dropped since the file was written or changed. */
+	unsigned long invalidations;
+} nfsCacheStats;
+
+/**
+ * @brief Get the statistics of the data cache.
+ */
+void
+nfsCacheGetStats(nfsCacheStats *stats);
+
 /**
  * @brief Dump a list of the currently mounted NFS to a file.
  *
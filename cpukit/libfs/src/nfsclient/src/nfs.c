@@ -119,6 +119,39 @@
  */
 #define DEFAULT_NFS_ST_BLKSIZE			NFS_MAXDATA
 
+/* Number of READ requests an open file which is read sequentially
+ * keeps in flight, i.e. how far we read ahead (in units of NFS_MAXDATA).
+ * Every request needs a NFS_MAXDATA buffer while it is in flight.
+ * Zero disables read-ahead.
+ * This value can be overridden at run-time by setting the global
+ * variable 'nfsReadAhead'.
+ */
+#define CONFIG_NFS_READ_AHEAD			4
+
+/* Number of WRITE requests an open file may have outstanding
+ * before write() blocks. The data are copied so the caller's buffer
+ * may be reused immediately; errors are reported by a subsequent
+ * write(), fsync() or close(). Zero makes write() synchronous.
+ * This value can be overridden at run-time by setting the global
+ * variable 'nfsWriteBehind'.
+ */
+#define CONFIG_NFS_WRITE_BEHIND			4
+
+/* upper limit for the two values above */
+#define CONFIG_NFS_MAX_PIPELINE			8
+
+/* Size (in bytes) of the data cache shared by all mounted NFS.
+ * The contents of files no bigger than CONFIG_NFS_CACHE_MAX_FILE
+ * which are opened read-only are kept in memory. An entry is
+ * validated against the mtime and size the server reports
+ * whenever the file is opened (close-to-open consistency).
+ * Zero disables the cache.
+ * These values can be overridden at run-time by setting the global
+ * variables 'nfsCacheSize' and 'nfsCacheMaxFile'.
+ */
+#define CONFIG_NFS_CACHE_SIZE			0
+#define CONFIG_NFS_CACHE_MAX_FILE		(64*1024)
+
 /* dont change this without changing the maximal write size */
 #define CONFIG_NFS_BIG_XACT_SIZE		UDPMSGSIZE	/* dont change this */
 
@@ -575,6 +608,70 @@ typedef struct NfsNodeRec_ {
 	TimeStamp		age;
 } NfsNodeRec, *NfsNode;
 
+/* State of an open file used for keeping several
+ * READ or WRITE requests in flight. It is attached
+ * to the iop->pathinfo.node_access_2 on first use.
+ *
+ * The outstanding requests form a ring; either all
+ * of them are READs or all of them are WRITEs.
+ */
+typedef struct NfsPipeSlotRec_ {
+	RpcUdpXact		xact;
+		/* NFS_MAXDATA bytes; allocated on first use
+		 */
+	char			*buf;
+		/* READ: reply received, data consumed so far
+		 */
+	bool_t			rcvd;
+	uint32_t		pos;
+	union {
+		struct {
+			readargs	args;
+			readres		res;
+		}				rd;
+		struct {
+			writeargs	args;
+			attrstat	res;
+		}				wr;
+	}				u;
+} NfsPipeSlotRec, *NfsPipeSlot;
+
+/* A cached file; the contents are appended to the
+ * entry and never change. The list of entries holds
+ * a reference, every open file using it another one.
+ */
+typedef struct NfsCacheEntryRec_ {
+	struct NfsCacheEntryRec_	*next, *prev;
+	Nfs							nfs;
+	u_int						fileid;
+	nfstime						mtime;
+	u_int						size;
+	int							refs;
+	char						*data;
+} NfsCacheEntryRec, *NfsCacheEntry;
+
+typedef struct FileInfoRec_ {
+		/* data cache; 'cacheable' is set by open() if the
+		 * file may be read from the cache
+		 */
+	NfsCacheEntry	cache;
+	bool_t			cacheable;
+	NfsPipeSlotRec	slot[CONFIG_NFS_MAX_PIPELINE];
+	int				head, num;
+	bool_t			writing;
+		/* offset of the next READ to issue and the offset
+		 * where a sequential read() continues
+		 */
+	uint32_t		issue;
+	uint32_t		next;
+		/* a short READ stops further read-ahead
+		 */
+	bool_t			eof;
+		/* deferred WRITE error (errno)
+		 */
+	int				error;
+} FileInfoRec, *FileInfo;
+
 /*****************************************
 	Forward Declarations
  *****************************************/
@@ -587,6 +684,15 @@ static ssize_t nfs_readlink_with_node(
 
 static int updateAttr(NfsNode node, int force);
 
+static ssize_t nfs_file_read_chunk(
+	NfsNode node,
+	uint32_t offset,
+	void *buffer,
+	size_t count
+);
+
+static void nfsCachePurge(Nfs nfs);
+
 /* Mask bits when setting attributes.
  * Only the 'arg' fields with their
  * corresponding bit set in the mask
@@ -703,6 +809,32 @@ static struct nfsstats {
 #endif
 int nfsStBlksize = DEFAULT_NFS_ST_BLKSIZE;
 
+/*
+ * Global variables to tune the number of READ/WRITE requests
+ * an open file keeps in flight (see CONFIG_NFS_READ_AHEAD and
+ * CONFIG_NFS_WRITE_BEHIND above). Values larger than
+ * CONFIG_NFS_MAX_PIPELINE are clipped.
+ */
+int nfsReadAhead   = CONFIG_NFS_READ_AHEAD;
+int nfsWriteBehind = CONFIG_NFS_WRITE_BEHIND;
+
+/*
+ * Global variables to tune the data cache (see CONFIG_NFS_CACHE_SIZE
+ * above).
+ */
+int nfsCacheSize    = CONFIG_NFS_CACHE_SIZE;
+int nfsCacheMaxFile = CONFIG_NFS_CACHE_MAX_FILE;
+
+/* The data cache; entries are kept in LRU order
+ * (most recently used first) and protected by
+ * nfsGlob.lock
+ */
+static struct {
+	NfsCacheEntry	head, tail;
+	u_long			bytes;
+	nfsCacheStats	stats;
+} nfsCache = { NULL, NULL, 0 };
+
 
 /*****************************************
 	Implementation
@@ -852,6 +984,7 @@ register Nfs prev;
 	UNLOCK(nfsGlob.llock);
 
 	nfs->next = 0; /* paranoia */
+	nfsCachePurge(nfs);
 	rpcUdpServerDestroy(nfs->server);
 	free(nfs);
 }
@@ -1145,38 +1278,58 @@ int			refuse;
 	return 0;
 }
 
-/* NFS RPC wrapper.
- *
- * ARGS:	srvr	the NFS server we want to call
- * 			proc	the NFSPROC_xx we want to invoke
- * 			xargs   xdr routine to wrap the arguments
- * 			pargs   pointer to the argument object
- * 			xres	xdr routine to unwrap the results
- * 			pres	pointer to the result object
+/* Map a failed RPC to errno and complain.
  *
- * RETURNS:	0 on success, -1 on error with errno set.
+ * RETURNS:	-1
+ */
+static int
+nfsRpcError(int proc, enum clnt_stat stat)
+{
+	fprintf(stderr,
+			"NFS (proc %i) - %s\n",
+			proc,
+			clnt_sperrno(stat));
+
+	switch (stat) {
+		/* TODO: this is probably not complete and/or fully accurate */
+		case RPC_CANTENCODEARGS : errno = EINVAL;	break;
+		case RPC_AUTHERROR  	: errno = EPERM;	break;
+
+		case RPC_CANTSEND		:
+		case RPC_CANTRECV		: /* hope they have errno set */
+		case RPC_SYSTEMERROR	: break;
+
+		default             	: errno = EIO;		break;
+	}
+
+	if (!errno)
+		errno = EIO;
+
+	return -1;
+}
+
+/* Start a NFS RPC but don't wait for the reply.
  *
- * NOTE:	the caller assumes that errno is set to
- *			a nonzero value if this routine returns
- *			an error (nonzero return value).
+ * ARGS:	see nfscall(); the argument and result
+ * 			objects must remain valid until the
+ * 			transaction is completed by nfsrcv().
+ * 			The transaction is returned in *pxact.
  *
- *			This routine prints RPC error messages to
- *			stderr.
+ * RETURNS:	0 on success, -1 on error with errno set.
  */
-STATIC int
-nfscall(
+static int
+nfssend(
 	RpcUdpServer	srvr,
 	int				proc,
 	xdrproc_t		xargs,
 	void *			pargs,
 	xdrproc_t		xres,
-	void *			pres)
+	void *			pres,
+	RpcUdpXact		*pxact)
 {
 RpcUdpXact		xact;
 enum clnt_stat	stat;
 RpcUdpXactPool	pool;
-int				rval = -1;
-
 
 	switch (proc) {
 		case NFSPROC_SYMLINK:
@@ -1201,36 +1354,67 @@ int				rval = -1;
 								pres,
 								xargs,
 								pargs,
-								0)) ||
-	     RPC_SUCCESS != (stat=rpcUdpRcv(xact)) ) {
+								0)) ) {
+		rpcUdpXactPoolPut(xact);
+		return nfsRpcError(proc, stat);
+	}
 
-		fprintf(stderr,
-				"NFS (proc %i) - %s\n",
-				proc,
-				clnt_sperrno(stat));
+	*pxact = xact;
 
-		switch (stat) {
-			/* TODO: this is probably not complete and/or fully accurate */
-			case RPC_CANTENCODEARGS : errno = EINVAL;	break;
-			case RPC_AUTHERROR  	: errno = EPERM;	break;
+	return 0;
+}
 
-			case RPC_CANTSEND		:
-			case RPC_CANTRECV		: /* hope they have errno set */
-			case RPC_SYSTEMERROR	: break;
+/* Wait for the reply to a NFS RPC started by
+ * nfssend() and release the transaction.
+ *
+ * RETURNS:	0 on success, -1 on error with errno set.
+ */
+static int
+nfsrcv(RpcUdpXact xact, int proc)
+{
+enum clnt_stat	stat;
 
-			default             	: errno = EIO;		break;
-		}
-	} else {
-		rval = 0;
-	}
+	stat = rpcUdpRcv(xact);
 
 	/* release the transaction back into the pool */
 	rpcUdpXactPoolPut(xact);
 
-	if (rval && !errno)
-		errno = EIO;
+	return RPC_SUCCESS == stat ? 0 : nfsRpcError(proc, stat);
+}
 
-	return rval;
+/* NFS RPC wrapper.
+ *
+ * ARGS:	srvr	the NFS server we want to call
+ * 			proc	the NFSPROC_xx we want to invoke
+ * 			xargs   xdr routine to wrap the arguments
+ * 			pargs   pointer to the argument object
+ * 			xres	xdr routine to unwrap the results
+ * 			pres	pointer to the result object
+ *
+ * RETURNS:	0 on success, -1 on error with errno set.
+ *
+ * NOTE:	the caller assumes that errno is set to
+ *			a nonzero value if this routine returns
+ *			an error (nonzero return value).
+ *
+ *			This routine prints RPC error messages to
+ *			stderr.
+ */
+STATIC int
+nfscall(
+	RpcUdpServer	srvr,
+	int				proc,
+	xdrproc_t		xargs,
+	void *			pargs,
+	xdrproc_t		xres,
+	void *			pres)
+{
+RpcUdpXact		xact;
+
+	if ( nfssend(srvr, proc, xargs, pargs, xres, pres, &xact) )
+		return -1;
+
+	return nfsrcv(xact, proc);
 }
 
 /* Check the 'age' of a node's stats
@@ -2357,7 +2541,395 @@ const struct _rtems_filesystem_operations_table nfs_fs_ops = {
 		  'nfs_xxx'.
  *****************************************/
 
-/* stateless NFS protocol makes this trivial */
+/* The data cache. Entries are looked up by the
+ * file id and invalidated when the attributes don't
+ * match the ones which were current when the entry
+ * was loaded.
+ */
+
+/* Drop a reference to an entry */
+static void
+nfsCachePut(NfsCacheEntry e)
+{
+	LOCK(nfsGlob.lock);
+	if ( 0 == --e->refs )
+		free(e);
+	UNLOCK(nfsGlob.lock);
+}
+
+/* Remove an entry from the list; called with nfsGlob.lock held */
+static void
+nfsCacheUnlink(NfsCacheEntry e)
+{
+	if ( e->prev )
+		e->prev->next  = e->next;
+	else
+		nfsCache.head  = e->next;
+	if ( e->next )
+		e->next->prev  = e->prev;
+	else
+		nfsCache.tail  = e->prev;
+
+	nfsCache.bytes -= e->size;
+
+	if ( 0 == --e->refs )
+		free(e);
+}
+
+/* Find an entry; called with nfsGlob.lock held */
+static NfsCacheEntry
+nfsCacheFind(NfsNode node)
+{
+NfsCacheEntry	e;
+
+	for ( e = nfsCache.head; e; e = e->next ) {
+		if ( e->nfs == node->nfs && e->fileid == SERP_ATTR(node).fileid )
+			break;
+	}
+
+	return e;
+}
+
+/* Look up a valid entry for a node with up to
+ * date attributes and acquire a reference.
+ */
+static NfsCacheEntry
+nfsCacheGet(NfsNode node)
+{
+NfsCacheEntry	e;
+
+	LOCK(nfsGlob.lock);
+	e = nfsCacheFind(node);
+	if ( e ) {
+		if ( e->size				== SERP_ATTR(node).size
+		  && e->mtime.seconds		== SERP_ATTR(node).mtime.seconds
+		  && e->mtime.useconds	== SERP_ATTR(node).mtime.useconds ) {
+			/* move to the front */
+			if ( e->prev ) {
+				e->prev->next = e->next;
+				if ( e->next )
+					e->next->prev = e->prev;
+				else
+					nfsCache.tail = e->prev;
+				e->prev            = NULL;
+				e->next            = nfsCache.head;
+				nfsCache.head->prev = e;
+				nfsCache.head      = e;
+			}
+			e->refs++;
+			nfsCache.stats.hits++;
+		} else {
+			nfsCacheUnlink(e);
+			nfsCache.stats.invalidations++;
+			e = NULL;
+		}
+	}
+	UNLOCK(nfsGlob.lock);
+
+	return e;
+}
+
+static void
+nfsCacheInvalidate(NfsNode node)
+{
+NfsCacheEntry	e;
+
+	LOCK(nfsGlob.lock);
+	if ( (e = nfsCacheFind(node)) ) {
+		nfsCacheUnlink(e);
+		nfsCache.stats.invalidations++;
+	}
+	UNLOCK(nfsGlob.lock);
+}
+
+/* Does a file of this size fit into the cache? */
+static int
+nfsCacheFits(u_int size)
+{
+	return nfsCacheMaxFile > 0
+	    && nfsCacheSize    > 0
+	    && size <= (u_int)nfsCacheMaxFile
+	    && size <= (u_int)nfsCacheSize;
+}
+
+void
+nfsCacheGetStats(nfsCacheStats *stats)
+{
+	LOCK(nfsGlob.lock);
+	*stats = nfsCache.stats;
+	UNLOCK(nfsGlob.lock);
+}
+
+/* Remove all entries of a NFS which is unmounted */
+static void
+nfsCachePurge(Nfs nfs)
+{
+NfsCacheEntry	e, n;
+
+	LOCK(nfsGlob.lock);
+	for ( e = nfsCache.head; e; e = n ) {
+		n = e->next;
+		if ( e->nfs == nfs )
+			nfsCacheUnlink(e);
+	}
+	UNLOCK(nfsGlob.lock);
+}
+
+/* Read a file into a new entry and acquire a reference.
+ *
+ * RETURNS:	the entry or NULL if the file can't
+ * 			be cached (this is not an error).
+ */
+static NfsCacheEntry
+nfsCacheLoad(NfsNode node)
+{
+NfsCacheEntry	e, old;
+u_int			size = SERP_ATTR(node).size;
+u_int			off;
+ssize_t			got;
+
+	if ( !nfsCacheFits(size) )
+		return NULL;
+
+	if ( !(e = malloc(sizeof(*e) + size)) )
+		return NULL;
+
+	e->nfs		= node->nfs;
+	e->fileid	= SERP_ATTR(node).fileid;
+	e->mtime	= SERP_ATTR(node).mtime;
+	e->size		= size;
+	e->refs		= 2;		/* the list and the caller */
+	e->data		= (char*)(e + 1);
+
+	for ( off = 0; off < size; off += got ) {
+		u_int chunk = size - off < NFS_MAXDATA ? size - off : NFS_MAXDATA;
+
+		got = nfs_file_read_chunk(node, off, e->data + off, chunk);
+		if ( got <= 0 ) {
+			/* the file changed; don't bother */
+			free(e);
+			return NULL;
+		}
+	}
+
+	LOCK(nfsGlob.lock);
+	if ( (old = nfsCacheFind(node)) )
+		nfsCacheUnlink(old);
+	while ( nfsCache.tail && nfsCache.bytes + size > nfsCacheSize )
+		nfsCacheUnlink(nfsCache.tail);
+
+	e->prev = NULL;
+	e->next = nfsCache.head;
+	if ( nfsCache.head )
+		nfsCache.head->prev = e;
+	else
+		nfsCache.tail       = e;
+	nfsCache.head   = e;
+	nfsCache.bytes += size;
+	nfsCache.stats.loads++;
+	UNLOCK(nfsGlob.lock);
+
+	return e;
+}
+
+static ssize_t
+nfsCacheRead(rtems_libio_t *iop, NfsCacheEntry e, void *buffer, size_t count)
+{
+	if ( iop->offset >= e->size )
+		return 0;
+
+	if ( count > e->size - iop->offset )
+		count = e->size - iop->offset;
+
+	memcpy(buffer, e->data + iop->offset, count);
+	iop->offset += count;
+
+	return count;
+}
+
+/* Pipelined READ and WRITE requests of an open file.
+ * The FileInfo is created on first use and attached
+ * to the iop->pathinfo.node_access_2.
+ */
+static FileInfo
+nfsFileInfo(rtems_libio_t *iop)
+{
+FileInfo	fi = iop->pathinfo.node_access_2;
+
+	if ( !fi ) {
+		fi = (FileInfo) malloc(sizeof(*fi));
+		if ( !fi ) {
+			errno = ENOMEM;
+			return NULL;
+		}
+		memset(fi, 0, sizeof(*fi));
+		fi->next = UINT32_C(0xffffffff);
+		iop->pathinfo.node_access_2 = fi;
+	}
+
+	return fi;
+}
+
+static int
+nfsPipeDepth(int depth)
+{
+	if ( depth < 0 )
+		return 0;
+	if ( depth > CONFIG_NFS_MAX_PIPELINE )
+		return CONFIG_NFS_MAX_PIPELINE;
+	return depth;
+}
+
+static NfsPipeSlot
+nfsPipeTail(FileInfo fi)
+{
+NfsPipeSlot	s = &fi->slot[(fi->head + fi->num) % CONFIG_NFS_MAX_PIPELINE];
+
+	if ( !s->buf && !(s->buf = malloc(NFS_MAXDATA)) ) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	s->rcvd = FALSE;
+	s->pos  = 0;
+
+	return s;
+}
+
+static void
+nfsPipePop(FileInfo fi)
+{
+	fi->head = (fi->head + 1) % CONFIG_NFS_MAX_PIPELINE;
+	fi->num--;
+}
+
+/* Complete the oldest outstanding WRITE; an error
+ * is recorded and reported later by nfsPipeError().
+ */
+static void
+nfsPipeWaitWrite(FileInfo fi, NfsNode node)
+{
+NfsPipeSlot	s = &fi->slot[fi->head];
+int			rv;
+
+	rv = nfsrcv(s->xact, NFSPROC_WRITE);
+	if ( 0 == rv )
+		rv = nfsEvaluateStatus(s->u.wr.res.status);
+
+	nfsPipePop(fi);
+
+	if ( 0 == rv ) {
+		SERP_ATTR(node) = s->u.wr.res.attrstat_u.attributes;
+		node->age       = nowSeconds();
+	} else {
+		if ( !fi->error )
+			fi->error = errno;
+		/* try at least to recover the current attributes */
+		updateAttr(node, 1 /* force */);
+	}
+}
+
+/* Complete all outstanding requests. Data
+ * read ahead are discarded.
+ */
+static void
+nfsPipeFlush(FileInfo fi, NfsNode node)
+{
+int	err = errno;
+
+	while ( fi->num > 0 ) {
+		if ( fi->writing ) {
+			nfsPipeWaitWrite(fi, node);
+		} else {
+			if ( !fi->slot[fi->head].rcvd )
+				nfsrcv(fi->slot[fi->head].xact, NFSPROC_READ);
+			nfsPipePop(fi);
+		}
+	}
+
+	errno = err;
+}
+
+/* Report (and clear) a deferred WRITE error.
+ *
+ * RETURNS:	0 or -1 with errno set
+ */
+static int
+nfsPipeError(FileInfo fi)
+{
+	if ( fi && fi->error ) {
+		errno     = fi->error;
+		fi->error = 0;
+		return -1;
+	}
+	return 0;
+}
+
+static int
+nfsPipeIssueRead(FileInfo fi, NfsNode node)
+{
+NfsPipeSlot	s = nfsPipeTail(fi);
+
+	if ( !s )
+		return -1;
+
+	memcpy( &s->u.rd.args.file, &SERP_FILE(node), sizeof(s->u.rd.args.file) );
+	s->u.rd.args.offset					= fi->issue;
+	s->u.rd.args.count					= NFS_MAXDATA;
+	s->u.rd.args.totalcount				= UINT32_C(0xdeadbeef);
+	s->u.rd.res.readres_u.reply.data.data_val	= s->buf;
+
+	if ( nfssend(
+			node->nfs->server,
+			NFSPROC_READ,
+			(xdrproc_t)xdr_readargs, &s->u.rd.args,
+			(xdrproc_t)xdr_readres, &s->u.rd.res,
+			&s->xact) )
+		return -1;
+
+	fi->issue += NFS_MAXDATA;
+	fi->num++;
+
+	return 0;
+}
+
+static int
+nfsPipeIssueWrite(FileInfo fi, NfsNode node, uint32_t offset, const void *buffer, size_t count)
+{
+NfsPipeSlot	s = nfsPipeTail(fi);
+
+	if ( !s )
+		return -1;
+
+	/* the caller may reuse the buffer once we return */
+	memcpy( s->buf, buffer, count );
+
+	memcpy( &s->u.wr.args.file, &SERP_FILE(node), sizeof(s->u.wr.args.file) );
+	s->u.wr.args.beginoffset			= UINT32_C(0xdeadbeef);
+	s->u.wr.args.offset					= offset;
+	s->u.wr.args.totalcount				= UINT32_C(0xdeadbeef);
+	s->u.wr.args.data.data_len			= count;
+	s->u.wr.args.data.data_val			= s->buf;
+
+	if ( nfssend(
+			node->nfs->server,
+			NFSPROC_WRITE,
+			(xdrproc_t)xdr_writeargs, &s->u.wr.args,
+			(xdrproc_t)xdr_attrstat, &s->u.wr.res,
+			&s->xact) )
+		return -1;
+
+	fi->num++;
+
+	return 0;
+}
+
+/* stateless NFS protocol makes this trivial; the
+ * state for pipelining requests is created on demand.
+ * If the data cache is enabled we must get the current
+ * attributes in order to validate the cached data
+ * (close-to-open consistency).
+ */
 static int nfs_file_open(
 	rtems_libio_t *iop,
 	const char    *pathname,
@@ -2365,6 +2937,24 @@ static int nfs_file_open(
 	mode_t        mode
 )
 {
+NfsNode		node = iop->pathinfo.node_access;
+FileInfo	fi;
+
+	iop->pathinfo.node_access_2 = 0;
+
+	if ( nfsCacheSize <= 0 || updateAttr(node, 1 /* force */) )
+		return 0;
+
+	if ( LIBIO_FLAGS_WRITE & iop->flags ) {
+		nfsCacheInvalidate(node);
+		return 0;
+	}
+
+	if ( nfsCacheFits(SERP_ATTR(node).size) && (fi = nfsFileInfo(iop)) ) {
+		fi->cache     = nfsCacheGet(node);
+		fi->cacheable = TRUE;
+	}
+
 	return 0;
 }
 
@@ -2409,11 +2999,53 @@ DirInfo		di;
 	return 0;
 }
 
+/* NFSv2 servers commit WRITEs before replying; all
+ * we have to do is waiting for the outstanding ones
+ */
+static int nfs_file_fsync(
+	rtems_libio_t *iop
+)
+{
+FileInfo	fi = iop->pathinfo.node_access_2;
+
+	if ( !fi )
+		return 0;
+
+	nfsPipeFlush(fi, iop->pathinfo.node_access);
+
+	return nfsPipeError(fi);
+}
+
 static int nfs_file_close(
 	rtems_libio_t *iop
 )
 {
-	return 0;
+FileInfo	fi = iop->pathinfo.node_access_2;
+int			rv, i;
+
+	/* don't let anybody else use stale data; a file written
+	 * without write-behind has no FileInfo
+	 */
+	if ( !fi ) {
+		if ( LIBIO_FLAGS_WRITE & iop->flags )
+			nfsCacheInvalidate(iop->pathinfo.node_access);
+		return 0;
+	}
+
+	rv = nfs_file_fsync(iop);
+
+	if ( fi->cache )
+		nfsCachePut(fi->cache);
+
+	if ( LIBIO_FLAGS_WRITE & iop->flags )
+		nfsCacheInvalidate(iop->pathinfo.node_access);
+
+	for ( i = 0; i < CONFIG_NFS_MAX_PIPELINE; i++ )
+		free(fi->slot[i].buf);
+	free(fi);
+	iop->pathinfo.node_access_2 = 0;
+
+	return rv;
 }
 
 static int nfs_dir_close(
@@ -2453,6 +3085,10 @@ Nfs		nfs  = node->nfs;
 		rv = nfsEvaluateStatus(rr.status);
 
 		if (rv == 0) {
+			/* the reply carries the current attributes */
+			SERP_ATTR(node) = rr.readres_u.reply.attributes;
+			node->age       = nowSeconds();
+
 			rv = rr.readres_u.reply.data.data_len;
 
 #if DEBUG & DEBUG_SYSCALLS
@@ -2479,23 +3115,145 @@ static ssize_t nfs_file_read(
 	NfsNode node = iop->pathinfo.node_access;
 	uint32_t offset = iop->offset;
 	char *in = buffer;
+	int depth = nfsPipeDepth(nfsReadAhead);
+	FileInfo fi = iop->pathinfo.node_access_2;
+	bool_t seq;
+
+	if (fi != NULL && fi->cacheable) {
+		if (fi->cache == NULL) {
+			fi->cache = nfsCacheLoad(node);
+			fi->cacheable = fi->cache != NULL;
+		}
+		if (fi->cache != NULL) {
+			return nfsCacheRead(iop, fi->cache, buffer, count);
+		}
+	}
 
-	do {
-		size_t chunk = count <= NFS_MAXDATA ? count : NFS_MAXDATA;
-		ssize_t done = nfs_file_read_chunk(node, offset, in, chunk);
+	if (fi != NULL && (fi->writing || depth == 0 || offset != fi->next)) {
+		nfsPipeFlush(fi, node);
+	}
 
-		if (done > 0) {
-			offset += (uint32_t) done;
-			in += done;
-			count -= (size_t) done;
-			rv += done;
-		} else {
-			count = 0;
-			if (done < 0) {
+	if (depth == 0) {
+		do {
+			size_t chunk = count <= NFS_MAXDATA ? count : NFS_MAXDATA;
+			ssize_t done = nfs_file_read_chunk(node, offset, in, chunk);
+
+			if (done > 0) {
+				offset += (uint32_t) done;
+				in += done;
+				count -= (size_t) done;
+				rv += done;
+			} else {
+				count = 0;
+				if (done < 0) {
+					rv = -1;
+				}
+			}
+		} while (count > 0);
+
+		if (rv > 0) {
+			iop->offset = offset;
+		}
+
+		return rv;
+	}
+
+	if (fi == NULL && (fi = nfsFileInfo(iop)) == NULL) {
+		return -1;
+	}
+
+	/* Read ahead of the requested data only if the file is
+	 * read sequentially; the ring then holds the data at 'offset'.
+	 */
+	seq = offset == fi->next;
+	fi->writing = FALSE;
+	if (fi->num == 0) {
+		fi->issue = offset;
+	}
+
+	while (count > 0) {
+		NfsPipeSlot s;
+		uint32_t len;
+		size_t n;
+
+		while (fi->num < depth
+			&& (fi->num == 0
+				|| (!fi->eof && (seq || fi->issue - offset < count)))) {
+			if (nfsPipeIssueRead(fi, node) != 0) {
+				break;
+			}
+		}
+
+		if (fi->num == 0) {
+			if (rv == 0) {
 				rv = -1;
 			}
+			break;
+		}
+
+		s = &fi->slot[fi->head];
+
+		if (!s->rcvd) {
+			int err = nfsrcv(s->xact, NFSPROC_READ);
+
+			s->rcvd = TRUE;
+			if (err == 0) {
+				err = nfsEvaluateStatus(s->u.rd.res.status);
+			}
+			if (err == 0) {
+				/* as for a synchronous READ; the size or
+				 * mtime may have changed on the server
+				 */
+				SERP_ATTR(node) = s->u.rd.res.readres_u.reply.attributes;
+				node->age       = nowSeconds();
+			} else {
+				nfsPipePop(fi);
+				nfsPipeFlush(fi, node);
+				if (rv == 0) {
+					rv = -1;
+				}
+				break;
+			}
 		}
-	} while (count > 0);
+
+		len = s->u.rd.res.readres_u.reply.data.data_len;
+		n = len - s->pos;
+		if (n > count) {
+			n = count;
+		}
+
+		memcpy(in, s->buf + s->pos, n);
+		s->pos += n;
+		offset += (uint32_t) n;
+		in += n;
+		count -= n;
+		rv += n;
+
+#if DEBUG & DEBUG_SYSCALLS
+		fprintf(stderr,
+			"Read %i bytes from offset %i\n",
+			n,
+			offset - n);
+#endif
+
+		if (s->pos == len) {
+			nfsPipePop(fi);
+
+			fi->eof = len < s->u.rd.args.count;
+			if (fi->eof) {
+				/* Most likely the end of the file; discard the
+				 * data read ahead and ask again at 'offset'.
+				 */
+				nfsPipeFlush(fi, node);
+				fi->issue = offset;
+				if (len == 0) {
+					break;
+				}
+			}
+		}
+	}
+
+	fi->next = offset;
 
 	if (rv > 0) {
 		iop->offset = offset;
@@ -2565,6 +3323,50 @@ RpcUdpServer	server = ((Nfs)iop->pathinfo.mt_entry->fs_info)->server;
 	return rv;
 }
 
+/* Enqueue a WRITE without waiting for the reply.
+ * Since the requests may be reordered in the network
+ * we don't let overlapping ones race.
+ */
+static ssize_t nfs_file_write_behind(
+	rtems_libio_t *iop,
+	const void    *buffer,
+	size_t        count,
+	int           depth
+)
+{
+NfsNode 	node   = iop->pathinfo.node_access;
+uint32_t	offset = iop->offset;
+FileInfo	fi;
+int			i;
+
+	if ( !(fi = nfsFileInfo(iop)) )
+		return -1;
+
+	fi->writing = TRUE;
+	fi->next    = UINT32_C(0xffffffff);
+
+	for ( i = 0; i < fi->num; i++ ) {
+		writeargs *a = &fi->slot[(fi->head + i) % CONFIG_NFS_MAX_PIPELINE].u.wr.args;
+
+		if ( offset < a->offset + a->data.data_len && a->offset < offset + count ) {
+			nfsPipeFlush(fi, node);
+			break;
+		}
+	}
+
+	while ( fi->num > 0 &&
+			( fi->num >= depth || rpcUdpPoll(fi->slot[fi->head].xact) ) ) {
+		nfsPipeWaitWrite(fi, node);
+	}
+
+	if ( nfsPipeError(fi) || nfsPipeIssueWrite(fi, node, offset, buffer, count) )
+		return -1;
+
+	iop->offset += count;
+
+	return count;
+}
+
 static ssize_t nfs_file_write(
 	rtems_libio_t *iop,
 	const void    *buffer,
@@ -2572,12 +3374,33 @@ static ssize_t nfs_file_write(
 )
 {
 ssize_t rv;
-NfsNode 	node = iop->pathinfo.node_access;
-Nfs			nfs  = node->nfs;
+NfsNode 	node  = iop->pathinfo.node_access;
+Nfs			nfs   = node->nfs;
+FileInfo	fi    = iop->pathinfo.node_access_2;
+int			depth = nfsPipeDepth(nfsWriteBehind);
 
 	if (count > NFS_MAXDATA)
 		count = NFS_MAXDATA;
 
+	if ( fi ) {
+		if ( !fi->writing )
+			nfsPipeFlush(fi, node);
+		fi->writing = TRUE;
+		if ( nfsPipeError(fi) )
+			return -1;
+	}
+
+	/* appending needs the current size from the server */
+	if ( depth > 0 && !(LIBIO_FLAGS_APPEND & iop->flags) )
+		return nfs_file_write_behind(iop, buffer, count, depth);
+
+	if ( fi ) {
+		nfsPipeFlush(fi, node);
+		fi->next = UINT32_C(0xffffffff);
+		if ( nfsPipeError(fi) )
+			return -1;
+	}
+
 
 	SERP_ARGS(node).writearg.beginoffset   = UINT32_C(0xdeadbeef);
 	if ( LIBIO_FLAGS_APPEND & iop->flags ) {
@@ -2846,6 +3669,9 @@ static int nfs_file_ftruncate(
 {
 sattr					arg;
 
+	if ( nfs_file_fsync(iop) )
+		return -1;
+
 	arg.size = length;
 	/* must not modify any other attribute; if we are not the owner
 	 * of the file or directory but only have write access changing
@@ -2867,8 +3693,8 @@ struct _rtems_filesystem_file_handlers_r nfs_file_file_handlers = {
 	.lseek_h     = rtems_filesystem_default_lseek_file,
 	.fstat_h     = nfs_fstat,
 	.ftruncate_h = nfs_file_ftruncate,
-	.fsync_h     = rtems_filesystem_default_fsync_or_fdatasync,
-	.fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync,
+	.fsync_h     = nfs_file_fsync,
+	.fdatasync_h = nfs_file_fsync,
 	.fcntl_h     = rtems_filesystem_default_fcntl,
 	.kqfilter_h  = rtems_filesystem_default_kqfilter,
 	.poll_h      = rtems_filesystem_default_poll,
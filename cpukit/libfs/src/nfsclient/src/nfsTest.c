@@ -48,6 +48,27 @@
  *    pipeline 'reader' and 'cruncher' threads.
  *  - read is not completely asynchronous; synchronization is still
  *    performed at 'big block' boundaries (num_readers * chunk_size).
+ *  - the NFS client itself keeps up to 'nfsReadAhead' requests in
+ *    flight for a file which is read sequentially; set 'nfsReadAhead'
+ *    to zero to measure purely synchronous reads.
+ *
+ * rtems_interval
+ * nfsTestWrite(char *file_name, int chunk_size, int nbytes);
+ *
+ * writes 'nbytes' to 'file_name' in chunks of 'chunk_size' and
+ * returns the time elapsed in ms, including the final fsync()/close().
+ * The number of outstanding WRITE requests is controlled by
+ * 'nfsWriteBehind'.
+ *
+ * int
+ * nfsTestCache(char *file_name);
+ *
+ * checks the data cache: a file written to 'file_name' is read into
+ * the cache by the first read-only open, served from the cache by
+ * the second one and invalidated when it is written again, both
+ * with and without write-behind.
+ *
+ * RETURNS: 0 on success, -1 on failure.
  */
 
 
@@ -106,9 +127,13 @@
 #include <rtems.h>
 #include <rtems/error.h>
 
+#include "librtemsNfs.h"
+
 #include <fcntl.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <unistd.h>
 
 unsigned nfsTestReaderPri = 80;
 
@@ -384,3 +409,220 @@ cleanup:
 	free(buf);
 	return now;
 }
+
+/* Write test
+ *
+ * Write 'nbytes' to file 'fnam' in chunks of 'sz' bytes.
+ *
+ * RETURNS: time elapsed in milliseconds (measured with
+ *          the system clock) or -1 on error.
+ */
+rtems_interval
+nfsTestWrite(char *fnam, int sz, int nbytes)
+{
+rtems_interval    now=-1, then;
+int		          fd=-1;
+char	          *buf=0;
+int               n;
+
+	if ( sz <= 0 || sz > 8192 ) {
+		fprintf(stderr,"invalid chunk size\n");
+		return -1;
+	}
+
+	if ( ! (buf=malloc(sz)) ) {
+		perror("allocating buffer");
+		goto cleanup;
+	}
+	memset(buf, 0xa5, sz);
+
+	if ( (fd=open(fnam,O_WRONLY|O_CREAT|O_TRUNC,0644)) < 0 ) {
+		perror("opening file");
+		goto cleanup;
+	}
+
+	then = rtems_clock_get_ticks_since_boot();
+
+	for ( ; nbytes > 0; nbytes -= n ) {
+		n = nbytes < sz ? nbytes : sz;
+		if ( write(fd, buf, n) != n ) {
+			perror("writing");
+			goto cleanup;
+		}
+	}
+
+	/* outstanding WRITEs count, too */
+	if ( fsync(fd) ) {
+		perror("syncing");
+		goto cleanup;
+	}
+
+	now = rtems_clock_get_ticks_since_boot();
+	now = (now-then)*1000;
+	now /= rtems_clock_get_ticks_per_second(); /* time in ms */
+
+cleanup:
+	if ( fd >= 0 )
+		close(fd);
+	free(buf);
+	return now;
+}
+
+/* Cache test helpers */
+static int
+nfsTestCacheWrite(char *fnam, const char *data)
+{
+int		fd;
+size_t	len = strlen(data);
+int		rval = 0;
+
+	if ( (fd=open(fnam,O_WRONLY|O_CREAT|O_TRUNC,0644)) < 0 ) {
+		perror("opening file for writing");
+		return -1;
+	}
+	if ( write(fd, data, len) != (ssize_t)len ) {
+		perror("writing");
+		rval = -1;
+	}
+	if ( close(fd) ) {
+		perror("closing after writing");
+		rval = -1;
+	}
+	return rval;
+}
+
+static int
+nfsTestCacheRead(char *fnam, const char *data)
+{
+int		fd;
+size_t	len = strlen(data);
+char	buf[100];
+ssize_t	n;
+int		rval = 0;
+
+	if ( (fd=open(fnam,O_RDONLY)) < 0 ) {
+		perror("opening file for reading");
+		return -1;
+	}
+	n = read(fd, buf, sizeof(buf));
+	if ( n != (ssize_t)len || memcmp(buf, data, len) ) {
+		fprintf(stderr,"read unexpected data\n");
+		rval = -1;
+	}
+	if ( close(fd) ) {
+		perror("closing after reading");
+		rval = -1;
+	}
+	return rval;
+}
+
+static int
+nfsTestCacheExpect(const char *what, const nfsCacheStats *then,
+	unsigned long hits, unsigned long loads, unsigned long invalidations)
+{
+nfsCacheStats	now;
+
+	nfsCacheGetStats(&now);
+	if (   now.hits          - then->hits          != hits
+		|| now.loads         - then->loads         != loads
+		|| now.invalidations - then->invalidations < invalidations ) {
+		fprintf(stderr,
+			"%s: %lu hits, %lu loads, %lu invalidations; "
+			"expected %lu, %lu, %lu\n",
+			what,
+			now.hits          - then->hits,
+			now.loads         - then->loads,
+			now.invalidations - then->invalidations,
+			hits, loads, invalidations);
+		return -1;
+	}
+	return 0;
+}
+
+/* Data cache test
+ *
+ * Exercise loading, hits and invalidation of the data
+ * cache with file 'fnam' (which is overwritten).
+ *
+ * RETURNS: 0 on success, -1 on failure.
+ */
+int
+nfsTestCache(char *fnam)
+{
+static const char	one[] = "first version of the cached file";
+static const char	two[] = "second version, a bit longer than the first";
+int					cacheSize      = nfsCacheSize;
+int					cacheMaxFile   = nfsCacheMaxFile;
+int					writeBehind    = nfsWriteBehind;
+int					rval           = -1;
+int					fd;
+nfsCacheStats		then;
+
+	if ( nfsCacheSize < 4096 )
+		nfsCacheSize    = 4096;
+	if ( nfsCacheMaxFile < 100 )
+		nfsCacheMaxFile = 100;
+
+	if ( nfsTestCacheWrite(fnam, one) )
+		goto cleanup;
+
+	/* miss, then hit */
+	nfsCacheGetStats(&then);
+	if ( nfsTestCacheRead(fnam, one) || nfsTestCacheRead(fnam, one) )
+		goto cleanup;
+	if ( nfsTestCacheExpect("reading twice", &then, 1, 1, 0) )
+		goto cleanup;
+
+	/* opening for writing invalidates and so does
+	 * closing, since somebody may have read the file
+	 * in between; without write-behind the file has
+	 * no pipeline state at close
+	 */
+	nfsWriteBehind = 0;
+	nfsCacheGetStats(&then);
+	if ( (fd=open(fnam,O_WRONLY|O_TRUNC)) < 0 ) {
+		perror("opening file for writing");
+		goto cleanup;
+	}
+	if ( write(fd, two, strlen(two)) != (ssize_t)strlen(two) ) {
+		perror("writing");
+		close(fd);
+		goto cleanup;
+	}
+	if ( nfsTestCacheRead(fnam, two) ) {
+		close(fd);
+		goto cleanup;
+	}
+	if ( close(fd) ) {
+		perror("closing after writing");
+		goto cleanup;
+	}
+	if ( nfsTestCacheExpect("writing", &then, 0, 1, 2) )
+		goto cleanup;
+	nfsCacheGetStats(&then);
+	if ( nfsTestCacheRead(fnam, two) )
+		goto cleanup;
+	if ( nfsTestCacheExpect("reading after write", &then, 0, 1, 0) )
+		goto cleanup;
+
+	/* and with write-behind */
+	nfsWriteBehind = writeBehind > 0 ? writeBehind : 1;
+	nfsCacheGetStats(&then);
+	if ( nfsTestCacheWrite(fnam, one) )
+		goto cleanup;
+	if ( nfsTestCacheExpect("writing behind", &then, 0, 0, 1) )
+		goto cleanup;
+	nfsCacheGetStats(&then);
+	if ( nfsTestCacheRead(fnam, one) )
+		goto cleanup;
+	if ( nfsTestCacheExpect("reading after write-behind", &then, 0, 1, 0) )
+		goto cleanup;
+
+	rval = 0;
+
+cleanup:
+	nfsCacheSize    = cacheSize;
+	nfsCacheMaxFile = cacheMaxFile;
+	nfsWriteBehind  = writeBehind;
+	return rval;
+}
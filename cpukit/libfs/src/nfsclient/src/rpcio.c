@@ -328,6 +328,7 @@ typedef struct RpcUdpXactRec_ {
 		long				age;		/* age info; needed to manage retransmission    */
 		long				trip;		/* record round trip time in ticks              */
 		rtems_id			requestor;	/* the task waiting for this XACT to complete   */
+		volatile int		done;		/* set by the daemon before waking requestor    */
 		RpcUdpXactPool		pool;		/* if this XACT belong to a pool, this is it    */
 		XDR					xdrs;		/* argument encoder stream                      */
 		int					xdrpos;     /* stream position after the (permanent) header */
@@ -370,6 +371,27 @@ sockRcv(void);
 static void
 rpcio_daemon(rtems_task_argument);
 
+/* Mark a transaction complete and wake up the requestor.
+ * Since events don't count, a task with several transactions
+ * in flight must be able to tell which one is done; hence
+ * the flag is set before the event is sent.
+ * A read-ahead transaction may outlive the task which sent
+ * it.  Nobody waits for it then; whoever drains the ring of
+ * the file later finds 'done' set, so a stale requestor id
+ * is not an error.
+ */
+static inline rtems_status_code
+xactWakeup(RpcUdpXact xact)
+{
+rtems_status_code status;
+
+	xact->done = 1;
+	status = rtems_event_send(xact->requestor, RTEMS_RPC_EVENT);
+	if ( RTEMS_INVALID_ID == status )
+		status = RTEMS_SUCCESSFUL;
+	return status;
+}
+
 #ifdef MBUF_TX
 ssize_t
 sendto_nocpy (
@@ -819,6 +841,7 @@ va_list			ap;
 	va_end(ap);
 
 	rtems_task_ident(RTEMS_SELF, RTEMS_WHO_AM_I, &xact->requestor);
+	xact->done = 0;
 	if ( rtems_message_queue_send( msgQ, &xact, sizeof(xact)) ) {
 		return RPC_CANTSEND;
 	}
@@ -846,13 +869,27 @@ rtems_event_set		gotEvents;
 
 	do {
 
-	/* block for the reply */
-	status = rtems_event_receive(
-		RTEMS_RPC_EVENT,
-		RTEMS_WAIT | RTEMS_EVENT_ANY,
-		RTEMS_NO_TIMEOUT,
-		&gotEvents);
-	ASSERT( status == RTEMS_SUCCESSFUL );
+	/* block for the reply; the event may be a leftover of
+	 * or belong to another transaction of ours still in
+	 * flight.
+	 * The transaction may have been sent by a different
+	 * task; redirect the wakeup to us. If the daemon
+	 * already sent it elsewhere 'done' is set.
+	 */
+	if ( !xact->done ) {
+		rtems_id self;
+
+		rtems_task_ident(RTEMS_SELF, RTEMS_WHO_AM_I, &self);
+		*(volatile rtems_id *)&xact->requestor = self;
+	}
+	while ( !xact->done ) {
+		status = rtems_event_receive(
+			RTEMS_RPC_EVENT,
+			RTEMS_WAIT | RTEMS_EVENT_ANY,
+			RTEMS_NO_TIMEOUT,
+			&gotEvents);
+		ASSERT( status == RTEMS_SUCCESSFUL );
+	}
 
 	if (xact->status.re_status) {
 #ifdef MBUF_RX
@@ -908,6 +945,7 @@ rtems_event_set		gotEvents;
 
 	if (refresh && locked_refresh(xact->server)) {
 		rtems_task_ident(RTEMS_SELF, RTEMS_WHO_AM_I, &xact->requestor);
+		xact->done = 0;
 		if ( rtems_message_queue_send(msgQ, &xact, sizeof(xact)) ) {
 			return RPC_CANTSEND;
 		}
@@ -921,6 +959,16 @@ rtems_event_set		gotEvents;
 	return xact->status.re_status;
 }
 
+/* Check whether an outstanding transaction has
+ * completed, i.e. whether rpcUdpRcv() would return
+ * without blocking.
+ */
+int
+rpcUdpPoll(RpcUdpXact xact)
+{
+	return xact->done;
+}
+
 
 /* On RTEMS, I'm told to avoid select(); this seems to
  * be more efficient
@@ -1278,7 +1326,7 @@ rtems_status_code	status;
 				}
 
 				/* wakeup requestor */
-				rtems_event_send(xact->requestor, RTEMS_RPC_EVENT);
+				xactWakeup(xact);
 			}
 		}
 
@@ -1333,7 +1381,7 @@ rtems_status_code	status;
 #if (DEBUG) & DEBUG_TIMEOUT
 					fprintf(stderr,"RPCIO XACT timed out; waking up requestor\n");
 #endif
-					if ( rtems_event_send(xact->requestor, RTEMS_RPC_EVENT) ) {
+					if ( xactWakeup(xact) ) {
 						rtems_panic("RPCIO PANIC file %s line: %i, requestor id was 0x%08x",
 									__FILE__,
 									__LINE__,
@@ -1367,7 +1415,7 @@ rtems_status_code	status;
 
 						/* wakeup requestor */
 						fprintf(stderr,"RPCIO: SEND failure\n");
-						status = rtems_event_send(xact->requestor, RTEMS_RPC_EVENT);
+						status = xactWakeup(xact);
 						assert( status == RTEMS_SUCCESSFUL );
 
 					} else {
@@ -1504,7 +1552,7 @@ rtems_status_code	status;
 
 	for (xact=((RpcUdpXact)listHead.next); xact; xact=((RpcUdpXact)xact->node.next)) {
 			xact->status.re_status = RPC_TIMEDOUT;
-			rtems_event_send(xact->requestor, RTEMS_RPC_EVENT);
+			xactWakeup(xact);
 	}
 #endif
 
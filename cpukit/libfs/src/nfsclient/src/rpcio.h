@@ -163,6 +163,16 @@ rpcUdpSend(
 enum clnt_stat
 rpcUdpRcv(RpcUdpXact xact);
 
+/**
+ * @brief Check whether a transaction has completed.
+ *
+ * A task may have several transactions in flight and
+ * wait for them with rpcUdpRcv() in any order; this
+ * routine returns non-zero if rpcUdpRcv() would not block.
+ */
+int
+rpcUdpPoll(RpcUdpXact xact);
+
 /* a yet simpler interface */
 enum clnt_stat
 rpcUdpCallRp(
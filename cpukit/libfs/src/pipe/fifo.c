@@ -26,9 +26,48 @@
 #include <rtems/libio_.h>
 #include <rtems/rtems/barrierimpl.h>
 #include <rtems/score/statesimpl.h>
+#include <rtems/score/atomic.h>
 
 #include "pipe.h"
 
+/*
+ * The pipe buffer is a ring indexed by free running byte counters.  Head is
+ * only advanced by the active writer and Tail only by the active reader, so
+ * data moves through the pipe without the pipe semaphore.  The readBusy and
+ * writeBusy flags select the active reader and writer.  The pipe semaphore
+ * and the barriers are only used to block on an empty or full pipe, on a busy
+ * flag and for open and close.
+ *
+ * The writer publishes the buffer contents with a release store of Head and
+ * the reader acquires them with a load of Head.  Likewise the reader hands
+ * free space back with a release store of Tail.  A task which has to wait
+ * increments its waiting counter and checks the pipe again under the pipe
+ * semaphore.  The other side reads the waiting counter after its Head or Tail
+ * store and a full fence, and releases the barrier only in case somebody
+ * waits.
+ */
+struct pipe_control {
+  char *Buffer;
+  unsigned int Size;      /* a power of two */
+  Atomic_Uint Head;       /* count of bytes written */
+  Atomic_Uint Tail;       /* count of bytes read */
+  Atomic_Flag readBusy;
+  Atomic_Flag writeBusy;
+  unsigned int Readers;
+  unsigned int Writers;
+  Atomic_Uint waitingReaders;
+  Atomic_Uint waitingWriters;
+  unsigned int readerCounter;     /* incremental counters */
+  unsigned int writerCounter;     /* for differentiation of successive opens */
+  rtems_id Semaphore;
+  rtems_id readBarrier;   /* wait queues */
+  rtems_id writeBarrier;
+#if 0
+  boolean Anonymous;      /* anonymous pipe or FIFO */
+#endif
+};
+
+RTEMS_STATIC_ASSERT((PIPE_BUF & (PIPE_BUF - 1)) == 0, PIPE_BUF);
 
 #define MIN(a, b) ((a) < (b)? (a): (b))
 
@@ -38,10 +77,18 @@
 static rtems_id pipe_semaphore = RTEMS_ID_NONE;
 
 
-#define PIPE_EMPTY(_pipe) (_pipe->Length == 0)
-#define PIPE_FULL(_pipe)  (_pipe->Length == _pipe->Size)
-#define PIPE_SPACE(_pipe) (_pipe->Size - _pipe->Length)
-#define PIPE_WSTART(_pipe) ((_pipe->Start + _pipe->Length) % _pipe->Size)
+/* Number of bytes in the pipe as seen by the reader */
+static unsigned int pipe_length(pipe_control_t *pipe, unsigned int tail)
+{
+  return _Atomic_Load_uint(&pipe->Head, ATOMIC_ORDER_ACQUIRE) - tail;
+}
+
+/* Free space in the pipe as seen by the writer */
+static unsigned int pipe_space(pipe_control_t *pipe, unsigned int head)
+{
+  return pipe->Size
+    - (head - _Atomic_Load_uint(&pipe->Tail, ATOMIC_ORDER_ACQUIRE));
+}
 
 #define PIPE_LOCK(_pipe)  \
   ( rtems_semaphore_obtain(_pipe->Semaphore, RTEMS_WAIT, RTEMS_NO_TIMEOUT)  \
@@ -63,6 +110,22 @@ static rtems_id pipe_semaphore = RTEMS_ID_NONE;
 #define PIPE_WAKEUPWRITERS(_pipe) \
   do {uint32_t n; rtems_barrier_release(_pipe->writeBarrier, &n); } while(0)
 
+/*
+ * Wake up waiting tasks after a change of the pipe state.  The fence orders
+ * the preceding store with the load of the waiting counter, see
+ * pipe_wait_begin().
+ */
+#define PIPE_WAKEUP(_pipe, _waiting, _barrier) \
+  do { \
+    _Atomic_Fence(ATOMIC_ORDER_SEQ_CST); \
+    if (_Atomic_Load_uint(_waiting, ATOMIC_ORDER_RELAXED) > 0 \
+        && PIPE_LOCK(_pipe)) { \
+      uint32_t n; \
+      rtems_barrier_release(_barrier, &n); \
+      PIPE_UNLOCK(_pipe); \
+    } \
+  } while (0)
+
 
 #ifdef RTEMS_POSIX_API
 #include <rtems/rtems/barrier.h>
@@ -100,6 +163,12 @@ static int pipe_alloc(
   if (pipe == NULL)
     return err;
   memset(pipe, 0, sizeof(pipe_control_t));
+  _Atomic_Init_uint(&pipe->Head, 0);
+  _Atomic_Init_uint(&pipe->Tail, 0);
+  _Atomic_Flag_clear(&pipe->readBusy, ATOMIC_ORDER_RELAXED);
+  _Atomic_Flag_clear(&pipe->writeBusy, ATOMIC_ORDER_RELAXED);
+  _Atomic_Init_uint(&pipe->waitingReaders, 0);
+  _Atomic_Init_uint(&pipe->waitingWriters, 0);
 
   pipe->Size = PIPE_BUF;
   pipe->Buffer = malloc(pipe->Size);
@@ -378,68 +447,202 @@ out_error:
   return err;
 }
 
-ssize_t pipe_read(
+/*
+ * Announce a waiting task.  Called with the pipe semaphore held before the
+ * pipe state is checked again.  The fence orders the increment with the
+ * following loads, see PIPE_WAKEUP().
+ */
+static void pipe_wait_begin(Atomic_Uint *waiting)
+{
+  _Atomic_Fetch_add_uint(waiting, 1, ATOMIC_ORDER_RELAXED);
+  _Atomic_Fence(ATOMIC_ORDER_SEQ_CST);
+}
+
+static void pipe_wait_end(Atomic_Uint *waiting)
+{
+  _Atomic_Fetch_sub_uint(waiting, 1, ATOMIC_ORDER_RELAXED);
+}
+
+/*
+ * Make the calling task the active reader or writer.  This does not use the
+ * pipe semaphore unless another task is active on the same side.
+ */
+static int pipe_side_lock(
   pipe_control_t *pipe,
-  void           *buffer,
-  size_t          count,
-  rtems_libio_t  *iop
+  Atomic_Flag    *busy,
+  Atomic_Uint    *waiting,
+  rtems_id        barrier
 )
 {
-  int chunk, chunk1, read = 0, ret = 0;
+  while (_Atomic_Flag_test_and_set(busy, ATOMIC_ORDER_ACQUIRE)) {
+    int ret = 0;
+
+    if (! PIPE_LOCK(pipe))
+      return -EINTR;
+
+    pipe_wait_begin(waiting);
+    if (! _Atomic_Flag_test_and_set(busy, ATOMIC_ORDER_ACQUIRE)) {
+      pipe_wait_end(waiting);
+      PIPE_UNLOCK(pipe);
+      return 0;
+    }
+
+    PIPE_UNLOCK(pipe);
+    if (rtems_barrier_wait(barrier, RTEMS_NO_TIMEOUT) != RTEMS_SUCCESSFUL)
+      ret = -EINTR;
+    pipe_wait_end(waiting);
+    if (ret != 0)
+      return ret;
+  }
+
+  return 0;
+}
+
+static void pipe_side_unlock(
+  pipe_control_t *pipe,
+  Atomic_Flag    *busy,
+  Atomic_Uint    *waiting,
+  rtems_id        barrier
+)
+{
+  _Atomic_Flag_clear(busy, ATOMIC_ORDER_RELEASE);
+  PIPE_WAKEUP(pipe, waiting, barrier);
+}
+
+#define PIPE_READ_LOCK(_pipe) \
+  pipe_side_lock(_pipe, &_pipe->readBusy, &_pipe->waitingReaders, \
+    _pipe->readBarrier)
+
+#define PIPE_READ_UNLOCK(_pipe) \
+  pipe_side_unlock(_pipe, &_pipe->readBusy, &_pipe->waitingReaders, \
+    _pipe->readBarrier)
+
+#define PIPE_WRITE_LOCK(_pipe) \
+  pipe_side_lock(_pipe, &_pipe->writeBusy, &_pipe->waitingWriters, \
+    _pipe->writeBarrier)
+
+#define PIPE_WRITE_UNLOCK(_pipe) \
+  pipe_side_unlock(_pipe, &_pipe->writeBusy, &_pipe->waitingWriters, \
+    _pipe->writeBarrier)
+
+/*
+ * Wait until the pipe is no more empty or no writer exists.  Called by the
+ * active reader.  Returns 0 if the pipe is no more empty, 1 if no writer
+ * exists, or an error.
+ */
+static int pipe_read_wait(
+  pipe_control_t *pipe,
+  rtems_libio_t  *iop,
+  unsigned int    tail
+)
+{
+  int ret = 0;
+
+  if (! PIPE_LOCK(pipe))
+    return -EINTR;
+
+  pipe_wait_begin(&pipe->waitingReaders);
+
+  if (pipe_length(pipe, tail) == 0) {
+    if (pipe->Writers == 0) {
+      /* Not an error */
+      ret = 1;
+    } else if (LIBIO_NODELAY(iop)) {
+      ret = -EAGAIN;
+    } else {
+      PIPE_UNLOCK(pipe);
+      if (! PIPE_READWAIT(pipe))
+        ret = -EINTR;
+      pipe_wait_end(&pipe->waitingReaders);
+      return ret;
+    }
+  }
+
+  pipe_wait_end(&pipe->waitingReaders);
+  PIPE_UNLOCK(pipe);
+  return ret;
+}
+
+/*
+ * Wait until there is chunk bytes space or no reader exists.  Called by the
+ * active writer.  Returns 0 if the space may be available now, or an error.
+ */
+static int pipe_write_wait(
+  pipe_control_t *pipe,
+  rtems_libio_t  *iop,
+  unsigned int    head,
+  unsigned int    chunk
+)
+{
+  int ret = 0;
 
   if (! PIPE_LOCK(pipe))
     return -EINTR;
 
-  while (PIPE_EMPTY(pipe)) {
-    /* Not an error */
-    if (pipe->Writers == 0)
-      goto out_locked;
+  pipe_wait_begin(&pipe->waitingWriters);
 
+  if (pipe->Readers == 0) {
+    ret = -EPIPE;
+  } else if (pipe_space(pipe, head) < chunk) {
     if (LIBIO_NODELAY(iop)) {
       ret = -EAGAIN;
-      goto out_locked;
+    } else {
+      PIPE_UNLOCK(pipe);
+      if (! PIPE_WRITEWAIT(pipe))
+        ret = -EINTR;
+      pipe_wait_end(&pipe->waitingWriters);
+      return ret;
     }
+  }
 
-    /* Wait until pipe is no more empty or no writer exists */
-    pipe->waitingReaders ++;
-    PIPE_UNLOCK(pipe);
-    if (! PIPE_READWAIT(pipe))
-      ret = -EINTR;
-    if (! PIPE_LOCK(pipe)) {
-      /* WARN waitingReaders not restored! */
-      ret = -EINTR;
-      goto out_nolock;
+  pipe_wait_end(&pipe->waitingWriters);
+  PIPE_UNLOCK(pipe);
+  return ret;
+}
+
+ssize_t pipe_read(
+  pipe_control_t *pipe,
+  void           *buffer,
+  size_t          count,
+  rtems_libio_t  *iop
+)
+{
+  unsigned int tail, start, length;
+  int chunk, chunk1, read = 0, ret = 0;
+
+  ret = PIPE_READ_LOCK(pipe);
+  if (ret != 0)
+    return ret;
+
+  /* Only the active reader changes the tail */
+  tail = _Atomic_Load_uint(&pipe->Tail, ATOMIC_ORDER_RELAXED);
+  while ((length = pipe_length(pipe, tail)) == 0) {
+    ret = pipe_read_wait(pipe, iop, tail);
+    if (ret != 0) {
+      if (ret > 0)
+        ret = 0;
+      goto out;
     }
-    pipe->waitingReaders --;
-    if (ret != 0)
-      goto out_locked;
   }
 
   /* Read chunk bytes */
-  chunk = MIN(count - read,  pipe->Length);
-  chunk1 = pipe->Size - pipe->Start;
+  chunk = MIN(count - read, length);
+  start = tail & (pipe->Size - 1);
+  chunk1 = pipe->Size - start;
   if (chunk > chunk1) {
-    memcpy(buffer + read, pipe->Buffer + pipe->Start, chunk1);
+    memcpy(buffer + read, pipe->Buffer + start, chunk1);
     memcpy(buffer + read + chunk1, pipe->Buffer, chunk - chunk1);
   }
   else
-    memcpy(buffer + read, pipe->Buffer + pipe->Start, chunk);
+    memcpy(buffer + read, pipe->Buffer + start, chunk);
 
-  pipe->Start += chunk;
-  pipe->Start %= pipe->Size;
-  pipe->Length -= chunk;
-  /* For buffering optimization */
-  if (PIPE_EMPTY(pipe))
-    pipe->Start = 0;
-
-  if (pipe->waitingWriters > 0)
-    PIPE_WAKEUPWRITERS(pipe);
+  _Atomic_Store_uint(&pipe->Tail, tail + chunk, ATOMIC_ORDER_RELEASE);
+  PIPE_WAKEUP(pipe, &pipe->waitingWriters, pipe->writeBarrier);
   read += chunk;
 
-out_locked:
-  PIPE_UNLOCK(pipe);
+out:
+  PIPE_READ_UNLOCK(pipe);
 
-out_nolock:
   if (read > 0)
     return read;
   return ret;
@@ -452,71 +655,58 @@ ssize_t pipe_write(
   rtems_libio_t  *iop
 )
 {
+  unsigned int head, start;
   int chunk, chunk1, written = 0, ret = 0;
 
   /* Write nothing */
   if (count == 0)
     return 0;
 
-  if (! PIPE_LOCK(pipe))
-    return -EINTR;
+  ret = PIPE_WRITE_LOCK(pipe);
+  if (ret != 0)
+    return ret;
 
   if (pipe->Readers == 0) {
     ret = -EPIPE;
-    goto out_locked;
+    goto out;
   }
 
   /* Write of PIPE_BUF bytes or less shall not be interleaved */
   chunk = count <= pipe->Size ? count : 1;
 
+  /* Only the active writer changes the head */
+  head = _Atomic_Load_uint(&pipe->Head, ATOMIC_ORDER_RELAXED);
+
   while (written < count) {
-    while (PIPE_SPACE(pipe) < chunk) {
-      if (LIBIO_NODELAY(iop)) {
-        ret = -EAGAIN;
-        goto out_locked;
-      }
+    unsigned int space;
 
-      /* Wait until there is chunk bytes space or no reader exists */
-      pipe->waitingWriters ++;
-      PIPE_UNLOCK(pipe);
-      if (! PIPE_WRITEWAIT(pipe))
-        ret = -EINTR;
-      if (! PIPE_LOCK(pipe)) {
-        /* WARN waitingWriters not restored! */
-        ret = -EINTR;
-        goto out_nolock;
-      }
-      pipe->waitingWriters --;
+    while ((space = pipe_space(pipe, head)) < chunk) {
+      ret = pipe_write_wait(pipe, iop, head, chunk);
       if (ret != 0)
-        goto out_locked;
-
-      if (pipe->Readers == 0) {
-        ret = -EPIPE;
-        goto out_locked;
-      }
+        goto out;
     }
 
-    chunk = MIN(count - written, PIPE_SPACE(pipe));
-    chunk1 = pipe->Size - PIPE_WSTART(pipe);
+    chunk = MIN(count - written, space);
+    start = head & (pipe->Size - 1);
+    chunk1 = pipe->Size - start;
     if (chunk > chunk1) {
-      memcpy(pipe->Buffer + PIPE_WSTART(pipe), buffer + written, chunk1);
+      memcpy(pipe->Buffer + start, buffer + written, chunk1);
       memcpy(pipe->Buffer, buffer + written + chunk1, chunk - chunk1);
     }
     else
-      memcpy(pipe->Buffer + PIPE_WSTART(pipe), buffer + written, chunk);
+      memcpy(pipe->Buffer + start, buffer + written, chunk);
 
-    pipe->Length += chunk;
-    if (pipe->waitingReaders > 0)
-      PIPE_WAKEUPREADERS(pipe);
+    head += chunk;
+    _Atomic_Store_uint(&pipe->Head, head, ATOMIC_ORDER_RELEASE);
+    PIPE_WAKEUP(pipe, &pipe->waitingReaders, pipe->readBarrier);
     written += chunk;
     /* Write of more than PIPE_BUF bytes can be interleaved */
     chunk = 1;
   }
 
-out_locked:
-  PIPE_UNLOCK(pipe);
+out:
+  PIPE_WRITE_UNLOCK(pipe);
 
-out_nolock:
 #ifdef RTEMS_POSIX_API
   /* Signal SIGPIPE */
   if (ret == -EPIPE)
@@ -528,6 +718,45 @@ out_nolock:
   return ret;
 }
 
+/* Change the buffer size of an empty pipe */
+static int pipe_resize(
+  pipe_control_t *pipe,
+  unsigned int    size
+)
+{
+  char *buffer;
+  int err;
+
+  if (size < PIPE_BUF || (size & (size - 1)) != 0)
+    return -EINVAL;
+
+  buffer = malloc(size);
+  if (buffer == NULL)
+    return -ENOMEM;
+
+  /* The active writer is the only one which may fill the pipe */
+  err = PIPE_WRITE_LOCK(pipe);
+  if (err != 0) {
+    free(buffer);
+    return err;
+  }
+
+  if (pipe_length(pipe, _Atomic_Load_uint(&pipe->Tail, ATOMIC_ORDER_ACQUIRE))
+      == 0) {
+    char *old = pipe->Buffer;
+
+    pipe->Buffer = buffer;
+    pipe->Size = size;
+    buffer = old;
+  } else {
+    err = -EBUSY;
+  }
+
+  PIPE_WRITE_UNLOCK(pipe);
+  free(buffer);
+  return err;
+}
+
 int pipe_ioctl(
   pipe_control_t  *pipe,
   ioctl_command_t  cmd,
@@ -535,17 +764,26 @@ int pipe_ioctl(
   rtems_libio_t   *iop
 )
 {
-  if (cmd == FIONREAD) {
-    if (buffer == NULL)
-      return -EFAULT;
-
-    if (! PIPE_LOCK(pipe))
-      return -EINTR;
-
-    /* Return length of pipe */
-    *(unsigned int *)buffer = pipe->Length;
-    PIPE_UNLOCK(pipe);
-    return 0;
+  switch (cmd) {
+    case FIONREAD:
+      if (buffer == NULL)
+        return -EFAULT;
+
+      /* Return length of pipe */
+      *(unsigned int *)buffer =
+        pipe_length(pipe, _Atomic_Load_uint(&pipe->Tail, ATOMIC_ORDER_RELAXED));
+      return 0;
+    case RTEMS_PIPE_GET_BUFFER_SIZE:
+      if (buffer == NULL)
+        return -EFAULT;
+
+      *(unsigned int *)buffer = pipe->Size;
+      return 0;
+    case RTEMS_PIPE_SET_BUFFER_SIZE:
+      if (buffer == NULL)
+        return -EFAULT;
+
+      return pipe_resize(pipe, *(unsigned int *)buffer);
   }
 
   return -EINVAL;
@@ -33,25 +33,24 @@
 extern "C" {
 #endif
 
-/* Control block to manage each pipe */
-typedef struct pipe_control {
-  char *Buffer;
-  unsigned int Size;
-  unsigned int Start;
-  unsigned int Length;
-  unsigned int Readers;
-  unsigned int Writers;
-  unsigned int waitingReaders;
-  unsigned int waitingWriters;
-  unsigned int readerCounter;     /* incremental counters */
-  unsigned int writerCounter;     /* for differentiation of successive opens */
-  rtems_id Semaphore;
-  rtems_id readBarrier;   /* wait queues */
-  rtems_id writeBarrier;
-#if 0
-  boolean Anonymous;      /* anonymous pipe or FIFO */
-#endif
-} pipe_control_t;
+/* Control block to manage each pipe, see fifo.c */
+typedef struct pipe_control pipe_control_t;
+
+/**
+ * @brief IO control to get the buffer size of a pipe in bytes.
+ *
+ * The buffer argument must point to an unsigned int.
+ */
+#define RTEMS_PIPE_GET_BUFFER_SIZE _IOR('P', 1, unsigned int)
+
+/**
+ * @brief IO control to set the buffer size of a pipe in bytes.
+ *
+ * The buffer argument must point to an unsigned int.  The size must be a
+ * power of two and at least PIPE_BUF.  The size can only be changed while the
+ * pipe is empty, otherwise EBUSY is returned.
+ */
+#define RTEMS_PIPE_SET_BUFFER_SIZE _IOW('P', 2, unsigned int)
 
 /**
  * @brief Create an anonymous pipe.
@@ -196,6 +196,8 @@ rtems_rfs_bitmap_map_set (rtems_rfs_bitmap_control* control,
   search_map = control->search_bits;
   index      = rtems_rfs_bitmap_map_index (bit);
   offset     = rtems_rfs_bitmap_map_offset (bit);
+  if (!rtems_rfs_bitmap_test (map[index], offset))
+    control->free--;
   map[index] = rtems_rfs_bitmap_set (map[index], 1 << offset);
   if (rtems_rfs_bitmap_match(map[index], RTEMS_RFS_BITMAP_ELEMENT_SET))
   {
@@ -203,9 +205,8 @@ rtems_rfs_bitmap_map_set (rtems_rfs_bitmap_control* control,
     index  = rtems_rfs_bitmap_map_index (bit);
     offset = rtems_rfs_bitmap_map_offset (bit);
     search_map[index] = rtems_rfs_bitmap_set (search_map[index], 1 << offset);
-    control->free--;
-    rtems_rfs_buffer_mark_dirty (control->buffer);
   }
+  rtems_rfs_buffer_mark_dirty (control->buffer);
   return 0;
 }
 
@@ -243,14 +244,16 @@ rtems_rfs_bitmap_map_test (rtems_rfs_bitmap_control* control,
 {
   rtems_rfs_bitmap_map map;
   int                  index;
+  int                  offset;
   int                  rc;
   rc = rtems_rfs_bitmap_load_map (control, &map);
   if (rc > 0)
     return rc;
   if (bit >= control->size)
     return EINVAL;
-  index = rtems_rfs_bitmap_map_index (bit);
-  *state = rtems_rfs_bitmap_test (map[index], bit);
+  index  = rtems_rfs_bitmap_map_index (bit);
+  offset = rtems_rfs_bitmap_map_offset (bit);
+  *state = rtems_rfs_bitmap_test (map[index], offset);
   return 0;
 }
 
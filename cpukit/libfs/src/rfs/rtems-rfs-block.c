@@ -37,6 +37,7 @@
 #endif
 
 #include <inttypes.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <rtems/rfs/rtems-rfs-block.h>
@@ -44,6 +45,19 @@
 #include <rtems/rfs/rtems-rfs-group.h>
 #include <rtems/rfs/rtems-rfs-inode.h>
 
+/*
+ * The extent map format. The last slot of the inode holds the number of
+ * extents. The other slots hold the extents while they fit and the blocks of
+ * the extent tables when they do not.
+ */
+#define RTEMS_RFS_BLOCK_EXTENT_SLOTS  (RTEMS_RFS_INODE_BLOCKS - 1)
+#define RTEMS_RFS_BLOCK_INODE_EXTENTS (RTEMS_RFS_BLOCK_EXTENT_SLOTS / 2)
+
+#define rtems_rfs_block_map_extent_count(_m) \
+  ((_m)->blocks[RTEMS_RFS_BLOCK_EXTENT_SLOTS])
+
+#define rtems_rfs_block_extents_per_block(_fs) ((_fs)->blocks_per_block / 2)
+
 void
 rtems_rfs_block_get_bpos (rtems_rfs_file_system* fs,
                           rtems_rfs_pos          pos,
@@ -108,6 +122,12 @@ rtems_rfs_block_map_open (rtems_rfs_file_system*  fs,
   map->inode = NULL;
   rtems_rfs_block_set_size_zero (&map->size);
   rtems_rfs_block_set_bpos_zero (&map->bpos);
+  map->extents = false;
+  map->extent_index = 0;
+  map->extent_first = 0;
+  map->delayed_size = 0;
+  map->delayed_count = 0;
+  map->delayed_data = NULL;
 
   rc = rtems_rfs_buffer_handle_open (fs, &map->singly_buffer);
   if (rc > 0)
@@ -135,6 +155,8 @@ rtems_rfs_block_map_open (rtems_rfs_file_system*  fs,
   map->size.offset = rtems_rfs_inode_get_block_offset (inode);
   map->last_map_block = rtems_rfs_inode_get_last_map_block (inode);
   map->last_data_block = rtems_rfs_inode_get_last_data_block (inode);
+  map->extents =
+    (rtems_rfs_inode_get_flags (inode) & RTEMS_RFS_INODE_FLAG_EXTENTS) != 0;
 
   rc = rtems_rfs_inode_unload (fs, inode, false);
 
@@ -148,30 +170,14 @@ rtems_rfs_block_map_close (rtems_rfs_file_system* fs,
   int rc = 0;
   int brc;
 
-  if (map->dirty && map->inode)
-  {
-    brc = rtems_rfs_inode_load (fs, map->inode);
-    if (brc > 0)
-      rc = brc;
+  rc = rtems_rfs_block_map_flush (fs, map);
 
-    if (rc == 0)
-    {
-      int b;
-
-      for (b = 0; b < RTEMS_RFS_INODE_BLOCKS; b++)
-        rtems_rfs_inode_set_block (map->inode, b, map->blocks[b]);
-      rtems_rfs_inode_set_block_count (map->inode, map->size.count);
-      rtems_rfs_inode_set_block_offset (map->inode, map->size.offset);
-      rtems_rfs_inode_set_last_map_block (map->inode, map->last_map_block);
-      rtems_rfs_inode_set_last_data_block (map->inode, map->last_data_block);
-
-      brc = rtems_rfs_inode_unload (fs, map->inode, true);
-      if (brc > 0)
-        rc = brc;
-
-      map->dirty = false;
-    }
-  }
+  /*
+   * The data of delayed blocks that could not be flushed is lost.
+   */
+  free (map->delayed_data);
+  map->delayed_data = NULL;
+  map->delayed_count = 0;
 
   map->inode = NULL;
 
@@ -184,6 +190,151 @@ rtems_rfs_block_map_close (rtems_rfs_file_system* fs,
   return rc;
 }
 
+/**
+ * Get an extent of the map.
+ *
+ * @param fs The file system.
+ * @param map The map.
+ * @param index The index of the extent.
+ * @param start The first block of the extent.
+ * @param count The number of blocks in the extent.
+ * @return int The error number (errno). No error if 0.
+ */
+static int
+rtems_rfs_block_map_extent_get (rtems_rfs_file_system* fs,
+                                rtems_rfs_block_map*   map,
+                                uint32_t               index,
+                                rtems_rfs_block_no*    start,
+                                rtems_rfs_block_no*    count)
+{
+  if (rtems_rfs_block_map_extent_count (map) <= RTEMS_RFS_BLOCK_INODE_EXTENTS)
+  {
+    *start = map->blocks[index * 2];
+    *count = map->blocks[(index * 2) + 1];
+  }
+  else
+  {
+    uint32_t epb = rtems_rfs_block_extents_per_block (fs);
+    int      rc;
+
+    rc = rtems_rfs_buffer_handle_request (fs, &map->singly_buffer,
+                                          map->blocks[index / epb], true);
+    if (rc > 0)
+      return rc;
+
+    index %= epb;
+    *start = rtems_rfs_block_get_number (&map->singly_buffer, index * 2);
+    *count = rtems_rfs_block_get_number (&map->singly_buffer, (index * 2) + 1);
+  }
+
+  if ((*start == 0) || (*count == 0) ||
+      (*start >= rtems_rfs_fs_blocks (fs)) ||
+      (*count > (rtems_rfs_fs_blocks (fs) - *start)))
+  {
+    if (rtems_rfs_trace (RTEMS_RFS_TRACE_BLOCK_FIND))
+      printf ("rtems-rfs: block-map-extent: invalid extent: index=%" PRIu32
+              " start=%" PRIu32 " count=%" PRIu32 "\n", index, *start, *count);
+    return EIO;
+  }
+
+  return 0;
+}
+
+/**
+ * Set an extent of the map.
+ *
+ * @param fs The file system.
+ * @param map The map.
+ * @param index The index of the extent.
+ * @param start The first block of the extent.
+ * @param count The number of blocks in the extent.
+ * @return int The error number (errno). No error if 0.
+ */
+static int
+rtems_rfs_block_map_extent_set (rtems_rfs_file_system* fs,
+                                rtems_rfs_block_map*   map,
+                                uint32_t               index,
+                                rtems_rfs_block_no     start,
+                                rtems_rfs_block_no     count)
+{
+  if (rtems_rfs_block_map_extent_count (map) <= RTEMS_RFS_BLOCK_INODE_EXTENTS)
+  {
+    map->blocks[index * 2] = start;
+    map->blocks[(index * 2) + 1] = count;
+  }
+  else
+  {
+    uint32_t epb = rtems_rfs_block_extents_per_block (fs);
+    int      rc;
+
+    rc = rtems_rfs_buffer_handle_request (fs, &map->singly_buffer,
+                                          map->blocks[index / epb], true);
+    if (rc > 0)
+      return rc;
+
+    index %= epb;
+    rtems_rfs_block_set_number (&map->singly_buffer, index * 2, start);
+    rtems_rfs_block_set_number (&map->singly_buffer, (index * 2) + 1, count);
+  }
+
+  map->dirty = true;
+  return 0;
+}
+
+/**
+ * Find a block in an extent map.
+ *
+ * @param fs The file system.
+ * @param map The map.
+ * @param bno The block number in the map.
+ * @param block The block.
+ * @return int The error number (errno). No error if 0.
+ */
+static int
+rtems_rfs_block_map_extent_find (rtems_rfs_file_system* fs,
+                                 rtems_rfs_block_map*   map,
+                                 rtems_rfs_block_no     bno,
+                                 rtems_rfs_block_no*    block)
+{
+  uint32_t           extents = rtems_rfs_block_map_extent_count (map);
+  uint32_t           index = 0;
+  rtems_rfs_block_no first = 0;
+
+  /*
+   * Files are mostly accessed in order so start at the extent of the last
+   * find if the block is not in front of it.
+   */
+  if ((map->extent_index < extents) && (map->extent_first <= bno))
+  {
+    index = map->extent_index;
+    first = map->extent_first;
+  }
+
+  while (index < extents)
+  {
+    rtems_rfs_block_no start;
+    rtems_rfs_block_no count;
+    int                rc;
+
+    rc = rtems_rfs_block_map_extent_get (fs, map, index, &start, &count);
+    if (rc > 0)
+      return rc;
+
+    if (bno < (first + count))
+    {
+      map->extent_index = index;
+      map->extent_first = first;
+      *block = start + (bno - first);
+      return 0;
+    }
+
+    first += count;
+    index++;
+  }
+
+  return EIO;
+}
+
 /**
  * Find a block indirectly held in a table of block numbers.
  *
@@ -244,6 +395,17 @@ rtems_rfs_block_map_find (rtems_rfs_file_system* fs,
   if (rtems_rfs_block_pos_block_past_end (bpos, &map->size))
     return ENXIO;
 
+  /*
+   * A delayed block does not have a block number until the map is flushed.
+   */
+  if ((map->delayed_count > 0) &&
+      (bpos->bno >= (map->size.count - map->delayed_count)))
+  {
+    rc = rtems_rfs_block_map_flush (fs, map);
+    if (rc > 0)
+      return rc;
+  }
+
   /*
    * If the block position is the same and we have found the block just return it.
    */
@@ -251,14 +413,20 @@ rtems_rfs_block_map_find (rtems_rfs_file_system* fs,
   {
     *block = map->bpos.block;
   }
+  else if (map->extents)
+  {
+    rc = rtems_rfs_block_map_extent_find (fs, map, bpos->bno, block);
+  }
   else
   {
     /*
      * Determine the type of access we need to perform. If the number of blocks
      * is less than or equal to the number of slots in the inode the blocks are
-     * directly accessed.
+     * directly accessed. Delayed blocks are not part of the layout.
      */
-    if (map->size.count <= RTEMS_RFS_INODE_BLOCKS)
+    rtems_rfs_block_no count = map->size.count - map->delayed_count;
+
+    if (count <= RTEMS_RFS_INODE_BLOCKS)
     {
       *block = map->blocks[bpos->bno];
     }
@@ -273,7 +441,7 @@ rtems_rfs_block_map_find (rtems_rfs_file_system* fs,
       direct = bpos->bno % fs->blocks_per_block;
       singly = bpos->bno / fs->blocks_per_block;
 
-      if (map->size.count <= fs->block_map_singly_blocks)
+      if (count <= fs->block_map_singly_blocks)
       {
         /*
          * This is a single indirect table of blocks anchored off a slot in the
@@ -294,7 +462,7 @@ rtems_rfs_block_map_find (rtems_rfs_file_system* fs,
         doubly  = singly / fs->blocks_per_block;
         singly %= fs->blocks_per_block;
 
-        if (map->size.count < fs->block_map_doubly_blocks)
+        if (count < fs->block_map_doubly_blocks)
         {
           rc = rtems_rfs_block_find_indirect (fs,
                                               &map->doubly_buffer,
@@ -401,191 +569,510 @@ rtems_rfs_block_map_indirect_alloc (rtems_rfs_file_system*   fs,
   return 0;
 }
 
-int
-rtems_rfs_block_map_grow (rtems_rfs_file_system* fs,
-                          rtems_rfs_block_map*   map,
-                          size_t                 blocks,
-                          rtems_rfs_block_no*    new_block)
+/**
+ * Add a block to the end of a block map. The blocks of the indirect tables the
+ * block needs are allocated. The size of the map is not changed.
+ *
+ * @param fs The file system data.
+ * @param map The map the block is added to.
+ * @param block The block to add.
+ * @return int The error number (errno). No error if 0.
+ */
+static int
+rtems_rfs_block_map_add_block (rtems_rfs_file_system* fs,
+                               rtems_rfs_block_map*   map,
+                               rtems_rfs_block_no     block)
 {
-  int b;
-
-  if (rtems_rfs_trace (RTEMS_RFS_TRACE_BLOCK_MAP_GROW))
-    printf ("rtems-rfs: block-map-grow: entry: blocks=%zd count=%" PRIu32 "\n",
-            blocks, map->size.count);
-
-  if ((map->size.count + blocks) >= rtems_rfs_fs_max_block_map_blocks (fs))
-    return EFBIG;
+  int rc;
 
-  /*
-   * Allocate a block at a time. The buffer handles hold the blocks so adding
-   * this way does not thrash the cache with lots of requests.
-   */
-  for (b = 0; b < blocks; b++)
+  if (map->size.count < RTEMS_RFS_INODE_BLOCKS)
+    map->blocks[map->size.count] = block;
+  else
   {
-    rtems_rfs_bitmap_bit block;
-    int                  rc;
-
     /*
-     * Allocate the block. If an indirect block is needed and cannot be
-     * allocated free this block.
+     * Single indirect access is occuring. It could still be doubly indirect.
      */
+    rtems_rfs_block_no direct;
+    rtems_rfs_block_no singly;
 
-    rc = rtems_rfs_group_bitmap_alloc (fs, map->last_data_block,
-                                       false, &block);
-    if (rc > 0)
-      return rc;
+    direct = map->size.count % fs->blocks_per_block;
+    singly = map->size.count / fs->blocks_per_block;
 
-    if (map->size.count < RTEMS_RFS_INODE_BLOCKS)
-      map->blocks[map->size.count] = block;
-    else
+    if (map->size.count < fs->block_map_singly_blocks)
     {
       /*
-       * Single indirect access is occuring. It could still be doubly indirect.
+       * Singly indirect tables are being used. Allocate a new block for a
+       * mapping table if direct is 0 or we are moving up (upping). If upping
+       * move the direct blocks into the table and if not this is the first
+       * entry of a new block.
        */
-      rtems_rfs_block_no direct;
-      rtems_rfs_block_no singly;
-
-      direct = map->size.count % fs->blocks_per_block;
-      singly = map->size.count / fs->blocks_per_block;
-
-      if (map->size.count < fs->block_map_singly_blocks)
+      if ((direct == 0) ||
+          ((singly == 0) && (direct == RTEMS_RFS_INODE_BLOCKS)))
       {
         /*
-         * Singly indirect tables are being used. Allocate a new block for a
-         * mapping table if direct is 0 or we are moving up (upping). If upping
-         * move the direct blocks into the table and if not this is the first
-         * entry of a new block.
+         * Upping is when we move from direct to singly indirect.
          */
-        if ((direct == 0) ||
-            ((singly == 0) && (direct == RTEMS_RFS_INODE_BLOCKS)))
-        {
-          /*
-           * Upping is when we move from direct to singly indirect.
-           */
-          bool upping;
-          upping = map->size.count == RTEMS_RFS_INODE_BLOCKS;
-          rc = rtems_rfs_block_map_indirect_alloc (fs, map,
-                                                   &map->singly_buffer,
-                                                   &map->blocks[singly],
-                                                   upping);
-        }
-        else
-        {
-          rc = rtems_rfs_buffer_handle_request (fs,  &map->singly_buffer,
-                                                map->blocks[singly], true);
-        }
-
-        if (rc > 0)
-        {
-          rtems_rfs_group_bitmap_free (fs, false, block);
-          return rc;
-        }
+        bool upping;
+        upping = map->size.count == RTEMS_RFS_INODE_BLOCKS;
+        rc = rtems_rfs_block_map_indirect_alloc (fs, map,
+                                                 &map->singly_buffer,
+                                                 &map->blocks[singly],
+                                                 upping);
       }
       else
       {
-        /*
-         * Doubly indirect tables are being used.
-         */
-        rtems_rfs_block_no doubly;
-        rtems_rfs_block_no singly_block;
+        rc = rtems_rfs_buffer_handle_request (fs,  &map->singly_buffer,
+                                              map->blocks[singly], true);
+      }
 
-        doubly  = singly / fs->blocks_per_block;
-        singly %= fs->blocks_per_block;
+      if (rc > 0)
+        return rc;
+    }
+    else
+    {
+      /*
+       * Doubly indirect tables are being used.
+       */
+      rtems_rfs_block_no doubly;
+      rtems_rfs_block_no singly_block;
+
+      doubly  = singly / fs->blocks_per_block;
+      singly %= fs->blocks_per_block;
+
+      /*
+       * Allocate a new block for a singly indirect table if direct is 0 as
+       * it is the first entry of a new block. We may also need to allocate a
+       * doubly indirect block as well. Both always occur when direct is 0
+       * and the doubly indirect block when singly is 0.
+       */
+      if (direct == 0)
+      {
+        rc = rtems_rfs_block_map_indirect_alloc (fs, map,
+                                                 &map->singly_buffer,
+                                                 &singly_block,
+                                                 false);
+        if (rc > 0)
+          return rc;
 
         /*
-         * Allocate a new block for a singly indirect table if direct is 0 as
-         * it is the first entry of a new block. We may also need to allocate a
-         * doubly indirect block as well. Both always occur when direct is 0
-         * and the doubly indirect block when singly is 0.
+         * Allocate a new block for a doubly indirect table if singly is 0 as
+         * it is the first entry of a new singly indirect block.
          */
-        if (direct == 0)
+        if ((singly == 0) ||
+            ((doubly == 0) && (singly == RTEMS_RFS_INODE_BLOCKS)))
         {
+          bool upping;
+          upping = map->size.count == fs->block_map_singly_blocks;
           rc = rtems_rfs_block_map_indirect_alloc (fs, map,
-                                                   &map->singly_buffer,
-                                                   &singly_block,
-                                                   false);
+                                                   &map->doubly_buffer,
+                                                   &map->blocks[doubly],
+                                                   upping);
           if (rc > 0)
           {
-            rtems_rfs_group_bitmap_free (fs, false, block);
+            rtems_rfs_group_bitmap_free (fs, false, singly_block);
             return rc;
           }
-
-          /*
-           * Allocate a new block for a doubly indirect table if singly is 0 as
-           * it is the first entry of a new singly indirect block.
-           */
-          if ((singly == 0) ||
-              ((doubly == 0) && (singly == RTEMS_RFS_INODE_BLOCKS)))
-          {
-            bool upping;
-            upping = map->size.count == fs->block_map_singly_blocks;
-            rc = rtems_rfs_block_map_indirect_alloc (fs, map,
-                                                     &map->doubly_buffer,
-                                                     &map->blocks[doubly],
-                                                     upping);
-            if (rc > 0)
-            {
-              rtems_rfs_group_bitmap_free (fs, false, singly_block);
-              rtems_rfs_group_bitmap_free (fs, false, block);
-              return rc;
-            }
-          }
-          else
-          {
-            rc = rtems_rfs_buffer_handle_request (fs, &map->doubly_buffer,
-                                                  map->blocks[doubly], true);
-            if (rc > 0)
-            {
-              rtems_rfs_group_bitmap_free (fs, false, singly_block);
-              rtems_rfs_group_bitmap_free (fs, false, block);
-              return rc;
-            }
-          }
-
-          rtems_rfs_block_set_number (&map->doubly_buffer,
-                                      singly,
-                                      singly_block);
         }
         else
         {
-          rc = rtems_rfs_buffer_handle_request (fs,
-                                                &map->doubly_buffer,
-                                                map->blocks[doubly],
-                                                true);
+          rc = rtems_rfs_buffer_handle_request (fs, &map->doubly_buffer,
+                                                map->blocks[doubly], true);
           if (rc > 0)
           {
-            rtems_rfs_group_bitmap_free (fs, false, block);
+            rtems_rfs_group_bitmap_free (fs, false, singly_block);
             return rc;
           }
+        }
 
-          singly_block = rtems_rfs_block_get_number (&map->doubly_buffer,
-                                                     singly);
+        rtems_rfs_block_set_number (&map->doubly_buffer,
+                                    singly,
+                                    singly_block);
+      }
+      else
+      {
+        rc = rtems_rfs_buffer_handle_request (fs,
+                                              &map->doubly_buffer,
+                                              map->blocks[doubly],
+                                              true);
+        if (rc > 0)
+          return rc;
 
-          rc = rtems_rfs_buffer_handle_request (fs, &map->singly_buffer,
-                                                singly_block, true);
-          if (rc > 0)
-          {
-            rtems_rfs_group_bitmap_free (fs, false, block);
-            return rc;
-          }
-        }
+        singly_block = rtems_rfs_block_get_number (&map->doubly_buffer,
+                                                   singly);
+
+        rc = rtems_rfs_buffer_handle_request (fs, &map->singly_buffer,
+                                              singly_block, true);
+        if (rc > 0)
+          return rc;
       }
+    }
+
+    rtems_rfs_block_set_number (&map->singly_buffer, direct, block);
+  }
 
-      rtems_rfs_block_set_number (&map->singly_buffer, direct, block);
+
+
+  return 0;
+}
+
+/**
+ * Append an extent to an extent map. The extent is merged with the last
+ * extent if it follows it. The size of the map is not changed.
+ *
+ * @param fs The file system data.
+ * @param map The map the extent is added to.
+ * @param start The first block of the extent.
+ * @param count The number of blocks in the extent.
+ * @return int The error number (errno). No error if 0.
+ */
+static int
+rtems_rfs_block_map_extent_append (rtems_rfs_file_system* fs,
+                                   rtems_rfs_block_map*   map,
+                                   rtems_rfs_block_no     start,
+                                   rtems_rfs_block_no     count)
+{
+  uint32_t extents = rtems_rfs_block_map_extent_count (map);
+  uint32_t epb = rtems_rfs_block_extents_per_block (fs);
+  int      rc;
+
+  if (extents > 0)
+  {
+    rtems_rfs_block_no last_start;
+    rtems_rfs_block_no last_count;
+
+    rc = rtems_rfs_block_map_extent_get (fs, map, extents - 1,
+                                         &last_start, &last_count);
+    if (rc > 0)
+      return rc;
+
+    if ((last_start + last_count) == start)
+      return rtems_rfs_block_map_extent_set (fs, map, extents - 1,
+                                             last_start, last_count + count);
+  }
+
+  if (extents >= (RTEMS_RFS_BLOCK_EXTENT_SLOTS * epb))
+    return EFBIG;
+
+  /*
+   * Allocate a table when the extents no longer fit into the inode or the
+   * last table is full. Upping moves the extents in the inode into the first
+   * table.
+   */
+  if ((extents == RTEMS_RFS_BLOCK_INODE_EXTENTS) ||
+      ((extents > RTEMS_RFS_BLOCK_INODE_EXTENTS) && ((extents % epb) == 0)))
+  {
+    rc = rtems_rfs_block_map_indirect_alloc (fs, map,
+                                             &map->singly_buffer,
+                                             &map->blocks[extents / epb],
+                                             extents ==
+                                             RTEMS_RFS_BLOCK_INODE_EXTENTS);
+    if (rc > 0)
+      return rc;
+  }
+
+  rtems_rfs_block_map_extent_count (map) = extents + 1;
+
+  rc = rtems_rfs_block_map_extent_set (fs, map, extents, start, count);
+  if (rc > 0)
+  {
+    rtems_rfs_block_map_extent_count (map) = extents;
+    return rc;
+  }
+
+  return 0;
+}
+
+/**
+ * Add a run of contiguous blocks to the end of the map. The blocks that cannot
+ * be added are freed.
+ *
+ * @param fs The file system data.
+ * @param map The map the blocks are added to.
+ * @param start The first block of the run.
+ * @param count The number of blocks in the run.
+ * @param added The number of blocks added to the map.
+ * @return int The error number (errno). No error if 0.
+ */
+static int
+rtems_rfs_block_map_add_run (rtems_rfs_file_system* fs,
+                             rtems_rfs_block_map*   map,
+                             rtems_rfs_block_no     start,
+                             size_t                 count,
+                             size_t*                added)
+{
+  size_t b;
+  int    rc = 0;
+
+  *added = 0;
+
+  if (map->extents)
+  {
+    rc = rtems_rfs_block_map_extent_append (fs, map, start, count);
+    if (rc == 0)
+    {
+      map->size.count += count;
+      *added = count;
+    }
+  }
+  else
+  {
+    while ((rc == 0) && (*added < count))
+    {
+      rc = rtems_rfs_block_map_add_block (fs, map, start + *added);
+      if (rc == 0)
+      {
+        map->size.count++;
+        (*added)++;
+      }
     }
+  }
+
+  for (b = *added; b < count; b++)
+    rtems_rfs_group_bitmap_free (fs, false, start + b);
 
-    map->size.count++;
+  if (*added > 0)
+  {
     map->size.offset = 0;
+    map->last_data_block = start + *added - 1;
+    map->dirty = true;
+  }
+
+  return rc;
+}
+
+int
+rtems_rfs_block_map_grow (rtems_rfs_file_system* fs,
+                          rtems_rfs_block_map*   map,
+                          size_t                 blocks,
+                          rtems_rfs_block_no*    new_block)
+{
+  bool first = true;
+  int  rc;
+
+  if (rtems_rfs_trace (RTEMS_RFS_TRACE_BLOCK_MAP_GROW))
+    printf ("rtems-rfs: block-map-grow: entry: blocks=%zd count=%" PRIu32 "\n",
+            blocks, map->size.count);
+
+  if ((map->size.count + blocks) >= rtems_rfs_fs_max_block_map_blocks (fs))
+    return EFBIG;
+
+  /*
+   * The delayed blocks are in front of the blocks being added.
+   */
+  if (map->delayed_count > 0)
+  {
+    rc = rtems_rfs_block_map_flush (fs, map);
+    if (rc > 0)
+      return rc;
+  }
 
-    if (b == 0)
+  /*
+   * Allocate contiguous runs of blocks. The buffer handles hold the indirect
+   * tables so adding a run to a block map does not thrash the cache with lots
+   * of requests and an extent map records a run with a single update.
+   */
+  while (blocks > 0)
+  {
+    rtems_rfs_bitmap_bit block;
+    size_t               count;
+    size_t               added;
+
+    rc = rtems_rfs_group_bitmap_alloc_run (fs, map->last_data_block, blocks,
+                                           &block, &count);
+    if (rc > 0)
+      return rc;
+
+    rc = rtems_rfs_block_map_add_run (fs, map, block, count, &added);
+    if (rc > 0)
+      return rc;
+
+    if (first)
       *new_block = block;
-    map->last_data_block = block;
-    map->dirty = true;
+    first = false;
+    blocks -= count;
   }
 
   return 0;
 }
 
+int
+rtems_rfs_block_map_grow_delayed (rtems_rfs_file_system* fs,
+                                  rtems_rfs_block_map*   map,
+                                  uint8_t**              data)
+{
+  size_t block_size = rtems_rfs_fs_block_size (fs);
+  int    rc;
+
+  if (map->delayed_size == 0)
+    return ENOTSUP;
+
+  if ((map->size.count + 1) >= rtems_rfs_fs_max_block_map_blocks (fs))
+    return EFBIG;
+
+  if (map->delayed_count >= map->delayed_size)
+  {
+    rc = rtems_rfs_block_map_flush (fs, map);
+    if (rc > 0)
+      return rc;
+  }
+
+  if (map->delayed_data == NULL)
+  {
+    map->delayed_data = malloc (map->delayed_size * block_size);
+    if (map->delayed_data == NULL)
+      return ENOMEM;
+  }
+
+  *data = map->delayed_data + (map->delayed_count * block_size);
+  memset (*data, 0, block_size);
+
+  map->delayed_count++;
+  map->size.count++;
+  map->size.offset = 0;
+  map->dirty = true;
+
+  return 0;
+}
+
+uint8_t*
+rtems_rfs_block_map_delayed_data (rtems_rfs_file_system* fs,
+                                  rtems_rfs_block_map*   map,
+                                  rtems_rfs_block_pos*   bpos)
+{
+  rtems_rfs_block_no first = map->size.count - map->delayed_count;
+
+  if ((map->delayed_count == 0) ||
+      (bpos->bno < first) || (bpos->bno >= map->size.count))
+    return NULL;
+
+  return map->delayed_data +
+    ((bpos->bno - first) * rtems_rfs_fs_block_size (fs));
+}
+
+/**
+ * Allocate the delayed blocks of the map and write their data to the buffers.
+ *
+ * @param fs The file system data.
+ * @param map The map to allocate the delayed blocks of.
+ * @return int The error number (errno). No error if 0.
+ */
+static int
+rtems_rfs_block_map_allocate_delayed (rtems_rfs_file_system* fs,
+                                      rtems_rfs_block_map*   map)
+{
+  rtems_rfs_buffer_handle buffer;
+  size_t                  block_size = rtems_rfs_fs_block_size (fs);
+  rtems_rfs_block_off     offset = map->size.offset;
+  int                     rc;
+  int                     brc;
+
+  if (rtems_rfs_trace (RTEMS_RFS_TRACE_BLOCK_MAP_GROW))
+    printf ("rtems-rfs: block-map-flush: delayed=%zd count=%" PRIu32 "\n",
+            map->delayed_count, map->size.count);
+
+  rc = rtems_rfs_buffer_handle_open (fs, &buffer);
+  if (rc > 0)
+    return rc;
+
+  /*
+   * The delayed blocks follow the blocks in the map. Take them out of the size
+   * while the runs are added so the map layout is right.
+   */
+  map->size.count -= map->delayed_count;
+
+  while (map->delayed_count > 0)
+  {
+    rtems_rfs_bitmap_bit block;
+    size_t               count;
+    size_t               added;
+    size_t               b;
+
+    rc = rtems_rfs_group_bitmap_alloc_run (fs, map->last_data_block,
+                                           map->delayed_count,
+                                           &block, &count);
+    if (rc > 0)
+      break;
+
+    rc = rtems_rfs_block_map_add_run (fs, map, block, count, &added);
+
+    for (b = 0; b < added; b++)
+    {
+      brc = rtems_rfs_buffer_handle_request (fs, &buffer, block + b, false);
+      if (brc > 0)
+      {
+        if (rc == 0)
+          rc = brc;
+        continue;
+      }
+      memcpy (rtems_rfs_buffer_data (&buffer),
+              map->delayed_data + (b * block_size), block_size);
+      rtems_rfs_buffer_mark_dirty (&buffer);
+    }
+
+    map->delayed_count -= added;
+    memmove (map->delayed_data, map->delayed_data + (added * block_size),
+             map->delayed_count * block_size);
+
+    if (rc > 0)
+      break;
+  }
+
+  map->size.count += map->delayed_count;
+  map->size.offset = offset;
+
+  brc = rtems_rfs_buffer_handle_close (fs, &buffer);
+  if ((brc > 0) && (rc == 0))
+    rc = brc;
+
+  return rc;
+}
+
+int
+rtems_rfs_block_map_flush (rtems_rfs_file_system* fs,
+                           rtems_rfs_block_map*   map)
+{
+  int rc = 0;
+  int brc;
+
+  if (map->delayed_count > 0)
+    rc = rtems_rfs_block_map_allocate_delayed (fs, map);
+
+  /*
+   * Write the map to the inode. The delayed blocks that are left are not part
+   * of the map in the inode.
+   */
+  if (map->dirty && map->inode)
+  {
+    int b;
+
+    brc = rtems_rfs_inode_load (fs, map->inode);
+    if (brc > 0)
+    {
+      if (rc == 0)
+        rc = brc;
+      return rc;
+    }
+
+    for (b = 0; b < RTEMS_RFS_INODE_BLOCKS; b++)
+      rtems_rfs_inode_set_block (map->inode, b, map->blocks[b]);
+    rtems_rfs_inode_set_block_count (map->inode,
+                                     map->size.count - map->delayed_count);
+    rtems_rfs_inode_set_block_offset (map->inode,
+                                      map->delayed_count > 0 ?
+                                      0 : map->size.offset);
+    rtems_rfs_inode_set_last_map_block (map->inode, map->last_map_block);
+    rtems_rfs_inode_set_last_data_block (map->inode, map->last_data_block);
+
+    brc = rtems_rfs_inode_unload (fs, map->inode, true);
+    if ((brc > 0) && (rc == 0))
+      rc = brc;
+
+    map->dirty = map->delayed_count > 0;
+  }
+
+  return rc;
+}
+
 /**
  * Shrink an indirect block.
  *
@@ -644,21 +1131,151 @@ rtems_rfs_block_map_indirect_shrink (rtems_rfs_file_system*   fs,
   return rc;
 }
 
+/**
+ * Shrink an extent map. Tables that are no longer needed are freed and the
+ * extents are moved back into the inode when they fit.
+ *
+ * @param fs The file system data.
+ * @param map The map to shrink.
+ * @param blocks The number of blocks to remove. Must not be more than the
+ *               number of blocks in the map.
+ * @return int The error number (errno). No error if 0.
+ */
+static int
+rtems_rfs_block_map_extent_shrink (rtems_rfs_file_system* fs,
+                                   rtems_rfs_block_map*   map,
+                                   size_t                 blocks)
+{
+  uint32_t epb = rtems_rfs_block_extents_per_block (fs);
+
+  map->extent_index = 0;
+  map->extent_first = 0;
+
+  while (blocks)
+  {
+    uint32_t           extents = rtems_rfs_block_map_extent_count (map);
+    rtems_rfs_block_no start;
+    rtems_rfs_block_no count;
+    rtems_rfs_block_no remove;
+    rtems_rfs_block_no b;
+    int                rc;
+
+    rc = rtems_rfs_block_map_extent_get (fs, map, extents - 1, &start, &count);
+    if (rc > 0)
+      return rc;
+
+    remove = count;
+    if (remove > blocks)
+      remove = blocks;
+
+    for (b = count - remove; b < count; b++)
+    {
+      rc = rtems_rfs_group_bitmap_free (fs, false, start + b);
+      if (rc > 0)
+        return rc;
+    }
+
+    if (remove < count)
+    {
+      rc = rtems_rfs_block_map_extent_set (fs, map, extents - 1,
+                                           start, count - remove);
+      if (rc > 0)
+        return rc;
+    }
+    else
+    {
+      rtems_rfs_block_no table = 0;
+
+      extents--;
+
+      if (extents == RTEMS_RFS_BLOCK_INODE_EXTENTS)
+      {
+        /*
+         * Move the extents in the first table back into the inode.
+         */
+        table = map->blocks[0];
+        rc = rtems_rfs_buffer_handle_request (fs, &map->singly_buffer,
+                                              table, true);
+        if (rc > 0)
+          return rc;
+        for (b = 0; b < RTEMS_RFS_BLOCK_EXTENT_SLOTS; b++)
+          map->blocks[b] = rtems_rfs_block_get_number (&map->singly_buffer, b);
+      }
+      else if (extents > RTEMS_RFS_BLOCK_INODE_EXTENTS)
+      {
+        if ((extents % epb) == 0)
+        {
+          table = map->blocks[extents / epb];
+          map->blocks[extents / epb] = 0;
+        }
+      }
+      else
+      {
+        map->blocks[extents * 2] = 0;
+        map->blocks[(extents * 2) + 1] = 0;
+      }
+
+      rtems_rfs_block_map_extent_count (map) = extents;
+
+      if (table != 0)
+      {
+        rc = rtems_rfs_group_bitmap_free (fs, false, table);
+        if (rc > 0)
+          return rc;
+        map->last_map_block = table;
+      }
+    }
+
+    map->size.count -= remove;
+    map->size.offset = 0;
+    map->last_data_block = start + count - remove;
+    map->dirty = true;
+    blocks -= remove;
+  }
+
+  return 0;
+}
+
 int
 rtems_rfs_block_map_shrink (rtems_rfs_file_system* fs,
                             rtems_rfs_block_map*   map,
                             size_t                 blocks)
 {
+  int rc;
+
   if (rtems_rfs_trace (RTEMS_RFS_TRACE_BLOCK_MAP_SHRINK))
     printf ("rtems-rfs: block-map-shrink: entry: blocks=%zd count=%" PRIu32 "\n",
             blocks, map->size.count);
 
+  /*
+   * The delayed blocks are at the end of the map and have no blocks to free.
+   */
+  if (map->delayed_count > 0)
+  {
+    size_t delayed = map->delayed_count;
+    if (delayed > blocks)
+      delayed = blocks;
+    map->delayed_count -= delayed;
+    map->size.count -= delayed;
+    map->size.offset = 0;
+    map->dirty = true;
+    blocks -= delayed;
+  }
+
   if (map->size.count == 0)
     return 0;
 
   if (blocks > map->size.count)
     blocks = map->size.count;
 
+  if (map->extents)
+  {
+    rc = rtems_rfs_block_map_extent_shrink (fs, map, blocks);
+    if (rc > 0)
+      return rc;
+    blocks = 0;
+  }
+
   while (blocks)
   {
     rtems_rfs_block_no block;
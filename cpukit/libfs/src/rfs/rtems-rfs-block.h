@@ -88,6 +88,17 @@
  *  @li 335,544,320 bytes for a 1024 byte block size,
  *  @li 2,684,354,560 bytes for a 2048 byte block size, and
  *  @li 21,474,836,480 bytes for a 4096 byte block size.
+ *
+ * An inode with the extents flag set holds a list of extents in the slots
+ * instead. An extent is a start block and a block count. The last slot holds
+ * the number of extents. The first slots hold the extents directly while
+ * they fit and pointers to tables of extents when they do not. Appending a
+ * block that follows the last extent only updates the count of that extent.
+ *
+ * The map can delay the allocation of the blocks a regular file grows by. The
+ * data of the delayed blocks is held in memory and the blocks are allocated
+ * as contiguous runs when the map is flushed. The delayed blocks are part of
+ * the size of the map.
  */
 typedef struct rtems_rfs_block_map_s
 {
@@ -128,6 +139,34 @@ typedef struct rtems_rfs_block_map_s
    */
   rtems_rfs_block_no last_data_block;
 
+  /**
+   * The map is a list of extents.
+   */
+  bool extents;
+
+  /**
+   * The index of the extent of the last find and the first block of that
+   * extent. A find walks the extents from here if it can.
+   */
+  uint32_t extent_index;
+  rtems_rfs_block_no extent_first;
+
+  /**
+   * The maximum number of blocks with a delayed allocation. Set to 0 to
+   * allocate the blocks when the map grows.
+   */
+  size_t delayed_size;
+
+  /**
+   * The number of blocks at the end of the map with a delayed allocation.
+   */
+  size_t delayed_count;
+
+  /**
+   * The data of the blocks with a delayed allocation.
+   */
+  uint8_t* delayed_data;
+
   /**
    * The block map.
    */
@@ -220,6 +259,26 @@ rtems_rfs_block_map_set_size (rtems_rfs_block_map*  map,
   rtems_rfs_block_copy_size (&map->size, size);
   map->dirty = true;
 }
+
+/**
+ * Return the number of blocks in the map with a delayed allocation.
+ */
+#define rtems_rfs_block_map_delayed_count(_m) ((_m)->delayed_count)
+
+/**
+ * Set the maximum number of blocks the map delays the allocation of.
+ *
+ * @param[in] map is a pointer to the open map to set the delayed size in.
+ * @param[in] blocks is the number of blocks. Use 0 to allocate the blocks
+ *                   when the map grows.
+ */
+static inline void
+rtems_rfs_block_map_set_delayed (rtems_rfs_block_map* map,
+                                 size_t               blocks)
+{
+  map->delayed_size = blocks;
+}
+
 /**
  * Open a block map. The block map data in the inode is copied into the
  * map. The buffer handles are opened. The block position is set to the start
@@ -314,6 +373,50 @@ int rtems_rfs_block_map_grow (rtems_rfs_file_system* fs,
                               size_t                 blocks,
                               rtems_rfs_block_no*    new_block);
 
+/**
+ * Grow the block map by a block with a delayed allocation. The data of the
+ * block is held by the map and is set to 0. The delayed blocks are flushed
+ * first if the map cannot delay another block.
+ *
+ * @param[in] fs is the file system data.
+ * @param[in] map is a pointer to the open map to grow.
+ * @param[out] data will point to the data of the block.
+ *
+ * @retval 0 Successful operation.
+ * @retval ENOTSUP The map does not delay allocations.
+ * @retval error_code An error occurred.
+ */
+int rtems_rfs_block_map_grow_delayed (rtems_rfs_file_system* fs,
+                                      rtems_rfs_block_map*   map,
+                                      uint8_t**              data);
+
+/**
+ * Return the data of a block with a delayed allocation.
+ *
+ * @param[in] fs is the file system data.
+ * @param[in] map is a pointer to the open map.
+ * @param[in] bpos is a pointer to the block position.
+ *
+ * @retval data The data of the block.
+ * @retval NULL The block is not delayed.
+ */
+uint8_t* rtems_rfs_block_map_delayed_data (rtems_rfs_file_system* fs,
+                                           rtems_rfs_block_map*   map,
+                                           rtems_rfs_block_pos*   bpos);
+
+/**
+ * Flush the map. The delayed blocks are allocated as contiguous runs, their
+ * data is written to the buffers and the map is written to the inode.
+ *
+ * @param[in] fs is the file system data.
+ * @param[in] map is a pointer to the open map to flush.
+ *
+ * @retval 0 Successful operation.
+ * @retval error_code An error occurred.
+ */
+int rtems_rfs_block_map_flush (rtems_rfs_file_system* fs,
+                               rtems_rfs_block_map*   map);
+
 /**
  * Grow the block map by the specified number of blocks.
  *
@@ -74,40 +74,19 @@ rtems_rfs_scan_chain (rtems_chain_control*   chain,
   return NULL;
 }
 
-int
-rtems_rfs_buffer_handle_request (rtems_rfs_file_system*   fs,
-                                 rtems_rfs_buffer_handle* handle,
-                                 rtems_rfs_buffer_block   block,
-                                 bool                     read)
-{
-  int rc;
-
-  /*
-   * If the handle has a buffer release it. This allows a handle to be reused
-   * without needing to close then open it again.
-   */
-  if (rtems_rfs_buffer_handle_has_block (handle))
-  {
-    /*
-     * Treat block 0 as special to handle the loading of the super block.
-     */
-    if (block && (rtems_rfs_buffer_bnum (handle) == block))
-      return 0;
-
-    if (rtems_rfs_trace (RTEMS_RFS_TRACE_BUFFER_HANDLE_REQUEST))
-      printf ("rtems-rfs: buffer-request: handle has buffer: %" PRIu32 "\n",
-              rtems_rfs_buffer_bnum (handle));
-
-    rc = rtems_rfs_buffer_handle_release (fs, handle);
-    if (rc > 0)
-      return rc;
-    handle->dirty = false;
-    handle->bnum = 0;
-  }
-
-  if (rtems_rfs_trace (RTEMS_RFS_TRACE_BUFFER_HANDLE_REQUEST))
-    printf ("rtems-rfs: buffer-request: block=%" PRIu32 "\n", block);
+static int
+rtems_rfs_buffer_handle_release_locked (rtems_rfs_file_system*   fs,
+                                        rtems_rfs_buffer_handle* handle);
 
+/**
+ * Look for a block in the buffers held by this file system. The buffer lock
+ * must be held.
+ */
+static void
+rtems_rfs_buffer_handle_find (rtems_rfs_file_system*   fs,
+                              rtems_rfs_buffer_handle* handle,
+                              rtems_rfs_buffer_block   block)
+{
   /*
    * First check to see if the buffer has already been requested and is
    * currently attached to a handle. If it is share the access. A buffer could
@@ -158,23 +137,83 @@ rtems_rfs_buffer_handle_request (rtems_rfs_file_system*   fs,
         rtems_rfs_buffer_mark_dirty (handle);
     }
   }
+}
+
+static int
+rtems_rfs_buffer_handle_request_locked (rtems_rfs_file_system*   fs,
+                                        rtems_rfs_buffer_handle* handle,
+                                        rtems_rfs_buffer_block   block,
+                                        bool                     read)
+{
+  bool io_locked = false;
+  int  rc;
+
+  /*
+   * If the handle has a buffer release it. This allows a handle to be reused
+   * without needing to close then open it again.
+   */
+  if (rtems_rfs_buffer_handle_has_block (handle))
+  {
+    /*
+     * Treat block 0 as special to handle the loading of the super block.
+     */
+    if (block && (rtems_rfs_buffer_bnum (handle) == block))
+      return 0;
+
+    if (rtems_rfs_trace (RTEMS_RFS_TRACE_BUFFER_HANDLE_REQUEST))
+      printf ("rtems-rfs: buffer-request: handle has buffer: %" PRIu32 "\n",
+              rtems_rfs_buffer_bnum (handle));
+
+    rc = rtems_rfs_buffer_handle_release_locked (fs, handle);
+    if (rc > 0)
+      return rc;
+    handle->dirty = false;
+    handle->bnum = 0;
+  }
+
+  if (rtems_rfs_trace (RTEMS_RFS_TRACE_BUFFER_HANDLE_REQUEST))
+    printf ("rtems-rfs: buffer-request: block=%" PRIu32 "\n", block);
+
+  rtems_rfs_buffer_handle_find (fs, handle, block);
 
   /*
    * If not located we request the buffer from the I/O layer.
    */
   if (!rtems_rfs_buffer_handle_has_block (handle))
   {
-    rc = rtems_rfs_buffer_io_request (fs, block, read, &handle->buffer);
+    /*
+     * Do not hold the buffer lock across the device I/O so requests for
+     * buffers already held and releases are not blocked by a slow read. The
+     * buffer I/O lock makes a second request for the same block wait until
+     * this one has added the buffer to the active list and the buffers are
+     * searched again once it is held.
+     */
+    rtems_rfs_fs_buffer_unlock (fs);
+    rtems_rfs_fs_buffer_io_lock (fs);
+    rtems_rfs_fs_buffer_lock (fs);
+    io_locked = true;
+
+    rtems_rfs_buffer_handle_find (fs, handle, block);
+
+    if (rtems_rfs_buffer_handle_has_block (handle))
+      rc = 0;
+    else
+    {
+      rtems_rfs_fs_buffer_unlock (fs);
+      rc = rtems_rfs_buffer_io_request (fs, block, read, &handle->buffer);
+      rtems_rfs_fs_buffer_lock (fs);
+      if (rc == 0)
+        rtems_chain_set_off_chain (rtems_rfs_buffer_link(handle));
+    }
 
     if (rc > 0)
     {
+      rtems_rfs_fs_buffer_io_unlock (fs);
       if (rtems_rfs_trace (RTEMS_RFS_TRACE_BUFFER_HANDLE_REQUEST))
         printf ("rtems-rfs: buffer-request: block=%" PRIu32 ": bdbuf-%s: %d: %s\n",
                 block, read ? "read" : "get", rc, strerror (rc));
       return rc;
     }
-
-    rtems_chain_set_off_chain (rtems_rfs_buffer_link(handle));
   }
 
   /*
@@ -188,6 +227,9 @@ rtems_rfs_buffer_handle_request (rtems_rfs_file_system*   fs,
   handle->buffer->user = (void*) ((intptr_t) block);
   handle->bnum = block;
 
+  if (io_locked)
+    rtems_rfs_fs_buffer_io_unlock (fs);
+
   if (rtems_rfs_trace (RTEMS_RFS_TRACE_BUFFER_HANDLE_REQUEST))
     printf ("rtems-rfs: buffer-request: block=%" PRIu32 " bdbuf-%s=%" PRIu32 " refs=%d\n",
             block, read ? "read" : "get", handle->buffer->block,
@@ -197,8 +239,21 @@ rtems_rfs_buffer_handle_request (rtems_rfs_file_system*   fs,
 }
 
 int
-rtems_rfs_buffer_handle_release (rtems_rfs_file_system*   fs,
-                                 rtems_rfs_buffer_handle* handle)
+rtems_rfs_buffer_handle_request (rtems_rfs_file_system*   fs,
+                                 rtems_rfs_buffer_handle* handle,
+                                 rtems_rfs_buffer_block   block,
+                                 bool                     read)
+{
+  int rc;
+  rtems_rfs_fs_buffer_lock (fs);
+  rc = rtems_rfs_buffer_handle_request_locked (fs, handle, block, read);
+  rtems_rfs_fs_buffer_unlock (fs);
+  return rc;
+}
+
+static int
+rtems_rfs_buffer_handle_release_locked (rtems_rfs_file_system*   fs,
+                                        rtems_rfs_buffer_handle* handle)
 {
   int rc = 0;
 
@@ -284,10 +339,22 @@ rtems_rfs_buffer_handle_release (rtems_rfs_file_system*   fs,
   return rc;
 }
 
+int
+rtems_rfs_buffer_handle_release (rtems_rfs_file_system*   fs,
+                                 rtems_rfs_buffer_handle* handle)
+{
+  int rc;
+  rtems_rfs_fs_buffer_lock (fs);
+  rc = rtems_rfs_buffer_handle_release_locked (fs, handle);
+  rtems_rfs_fs_buffer_unlock (fs);
+  return rc;
+}
+
 int
 rtems_rfs_buffer_open (const char* name, rtems_rfs_file_system* fs)
 {
   struct stat st;
+  int         rc;
 #if RTEMS_RFS_USE_LIBBLOCK
   int rv;
 #endif
@@ -337,6 +404,27 @@ rtems_rfs_buffer_open (const char* name, rtems_rfs_file_system* fs)
   strcat (fs->name, name);
 #endif
 
+  rc = rtems_rfs_mutex_create (&fs->buffer_lock);
+  if (rc > 0)
+  {
+    if (rtems_rfs_trace (RTEMS_RFS_TRACE_BUFFER_OPEN))
+      printf ("rtems-rfs: buffer-open: cannot create lock: %d: %s\n",
+              rc, strerror (rc));
+    close (fs->device);
+    return rc;
+  }
+
+  rc = rtems_rfs_mutex_create (&fs->buffer_io_lock);
+  if (rc > 0)
+  {
+    if (rtems_rfs_trace (RTEMS_RFS_TRACE_BUFFER_OPEN))
+      printf ("rtems-rfs: buffer-open: cannot create I/O lock: %d: %s\n",
+              rc, strerror (rc));
+    rtems_rfs_mutex_destroy (&fs->buffer_lock);
+    close (fs->device);
+    return rc;
+  }
+
   if (rtems_rfs_trace (RTEMS_RFS_TRACE_BUFFER_SYNC))
     printf ("rtems-rfs: buffer-open: blks=%" PRId32 ", blk-size=%" PRId32 "\n",
             rtems_rfs_fs_media_blocks (fs),
@@ -371,6 +459,9 @@ rtems_rfs_buffer_close (rtems_rfs_file_system* fs)
               rc, strerror (rc));
   }
 
+  rtems_rfs_mutex_destroy (&fs->buffer_io_lock);
+  rtems_rfs_mutex_destroy (&fs->buffer_lock);
+
   return rc;
 }
 
@@ -473,6 +564,7 @@ rtems_rfs_buffers_release (rtems_rfs_file_system* fs)
             "release:%" PRIu32 " release-modified:%" PRIu32 "\n",
             fs->buffers_count, fs->release_count, fs->release_modified_count);
 
+  rtems_rfs_fs_buffer_lock (fs);
   rc = rtems_rfs_release_chain (&fs->release,
                                 &fs->release_count,
                                 false);
@@ -483,6 +575,7 @@ rtems_rfs_buffers_release (rtems_rfs_file_system* fs)
                                 true);
   if ((rc > 0) && (rrc == 0))
     rrc = rc;
+  rtems_rfs_fs_buffer_unlock (fs);
 
   return rrc;
 }
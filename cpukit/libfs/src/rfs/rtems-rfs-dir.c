@@ -13,6 +13,14 @@
  *
  * The maximum length can be 1 or 2 bytes depending on the value in the
  * superblock.
+ *
+ * An indexed directory uses its blocks as the buckets of a linear hash table
+ * so a lookup or an insert only accesses the block selected by the hash of
+ * the name. The number of blocks determines the table size. When the block
+ * of a new entry is full the next bucket in the split order is split by
+ * moving the entries with the next hash bit set to a block appended to the
+ * directory. The blocks of an indexed directory are not released when
+ * entries are deleted.
  */
 
 /*
@@ -52,6 +60,35 @@
   (((_l) <= RTEMS_RFS_DIR_ENTRY_SIZE) || ((_l) >= rtems_rfs_fs_max_name (_f)) \
    || (_i < RTEMS_RFS_ROOT_INO) || (_i > rtems_rfs_fs_inodes (_f)))
 
+/**
+ * Is the directory indexed ?
+ */
+#define rtems_rfs_dir_indexed(_d) \
+  ((rtems_rfs_inode_get_flags (_d) & RTEMS_RFS_INODE_FLAG_DIR_INDEX) != 0)
+
+/**
+ * Return the bucket of the hash in an indexed directory with the number of
+ * blocks. The buckets below the split point use one more bit of the hash.
+ */
+static rtems_rfs_block_no
+rtems_rfs_dir_index_bucket (uint32_t hash, size_t blocks)
+{
+  size_t             low = 1;
+  rtems_rfs_block_no bucket;
+
+  if (blocks <= 1)
+    return 0;
+
+  while ((low << 1) <= blocks)
+    low <<= 1;
+
+  bucket = hash & (low - 1);
+  if (bucket < (blocks - low))
+    bucket = hash & ((low << 1) - 1);
+
+  return bucket;
+}
+
 int
 rtems_rfs_dir_lookup_ino (rtems_rfs_file_system*  fs,
                           rtems_rfs_inode_handle* inode,
@@ -107,9 +144,17 @@ rtems_rfs_dir_lookup_ino (rtems_rfs_file_system*  fs,
 
     /*
      * Locate the first block. The map points to the start after open so just
-     * seek 0. If an error the block will be 0.
+     * seek 0. If an error the block will be 0. An indexed directory only has
+     * to search the block of the hash.
      */
-    rc = rtems_rfs_block_map_seek (fs, &map, 0, &block);
+    if (rtems_rfs_dir_indexed (inode))
+      rc = rtems_rfs_block_map_seek (fs, &map,
+                                     rtems_rfs_dir_index_bucket (hash,
+                                       rtems_rfs_block_map_count (&map)) *
+                                     rtems_rfs_fs_block_size (fs),
+                                     &block);
+    else
+      rc = rtems_rfs_block_map_seek (fs, &map, 0, &block);
     if (rc > 0)
     {
       if (rtems_rfs_trace (RTEMS_RFS_TRACE_DIR_LOOKUP_INO))
@@ -198,6 +243,9 @@ rtems_rfs_dir_lookup_ino (rtems_rfs_file_system*  fs,
         entry += elength;
       }
 
+      if ((rc == 0) && rtems_rfs_dir_indexed (inode))
+        rc = ENOENT;
+
       if (rc == 0)
       {
         rc = rtems_rfs_block_map_next_block (fs, &map, &block);
@@ -227,6 +275,264 @@ rtems_rfs_dir_lookup_ino (rtems_rfs_file_system*  fs,
   return rc;
 }
 
+/**
+ * Split the next bucket of an indexed directory. The entries of the bucket
+ * which belong to the new bucket are moved to a block appended to the map.
+ */
+static int
+rtems_rfs_dir_index_split (rtems_rfs_file_system*  fs,
+                           rtems_rfs_inode_handle* dir,
+                           rtems_rfs_block_map*    map)
+{
+  rtems_rfs_buffer_handle bucket;
+  rtems_rfs_buffer_handle split;
+  rtems_rfs_block_pos     bpos;
+  rtems_rfs_block_no      block;
+  size_t                  blocks;
+  size_t                  low;
+  uint32_t                mask;
+  uint8_t*                data;
+  uint8_t*                moved;
+  int                     offset;
+  int                     kept;
+  int                     moved_offset;
+  int                     rc;
+
+  blocks = rtems_rfs_block_map_count (map);
+  low = 1;
+  while ((low << 1) <= blocks)
+    low <<= 1;
+  mask = (low << 1) - 1;
+
+  rtems_rfs_block_set_bpos_zero (&bpos);
+  bpos.bno = blocks - low;
+
+  if (rtems_rfs_trace (RTEMS_RFS_TRACE_DIR_ADD_ENTRY))
+    printf ("rtems-rfs: dir-index-split: dir=%" PRIu32 " bucket=%" PRIu32
+            " new=%zu\n", rtems_rfs_inode_ino (dir), bpos.bno, blocks);
+
+  rc = rtems_rfs_buffer_handle_open (fs, &bucket);
+  if (rc > 0)
+    return rc;
+
+  rc = rtems_rfs_buffer_handle_open (fs, &split);
+  if (rc > 0)
+  {
+    rtems_rfs_buffer_handle_close (fs, &bucket);
+    return rc;
+  }
+
+  rc = rtems_rfs_block_map_grow (fs, map, 1, &block);
+  if (rc == 0)
+    rc = rtems_rfs_buffer_handle_request (fs, &split, block, false);
+  if (rc == 0)
+    rc = rtems_rfs_block_map_find (fs, map, &bpos, &block);
+  if (rc == 0)
+    rc = rtems_rfs_buffer_handle_request (fs, &bucket, block, true);
+  if (rc > 0)
+  {
+    rtems_rfs_buffer_handle_close (fs, &split);
+    rtems_rfs_buffer_handle_close (fs, &bucket);
+    return rc;
+  }
+
+  data = rtems_rfs_buffer_data (&bucket);
+  moved = rtems_rfs_buffer_data (&split);
+  memset (moved, 0xff, rtems_rfs_fs_block_size (fs));
+
+  offset = 0;
+  kept = 0;
+  moved_offset = 0;
+
+  while (offset < (rtems_rfs_fs_block_size (fs) - RTEMS_RFS_DIR_ENTRY_SIZE))
+  {
+    uint8_t*      entry = data + offset;
+    rtems_rfs_ino eino;
+    int           elength;
+
+    elength = rtems_rfs_dir_entry_length (entry);
+    eino    = rtems_rfs_dir_entry_ino (entry);
+
+    if (elength == RTEMS_RFS_DIR_ENTRY_EMPTY)
+      break;
+
+    if (rtems_rfs_dir_entry_valid (fs, elength, eino))
+    {
+      if (rtems_rfs_trace (RTEMS_RFS_TRACE_DIR_ADD_ENTRY))
+        printf ("rtems-rfs: dir-index-split: "
+                "bad length or ino for ino %" PRIu32 ": %u/%" PRId32 " @ %04x\n",
+                rtems_rfs_inode_ino (dir), elength, eino, offset);
+      rc = EIO;
+      break;
+    }
+
+    if ((rtems_rfs_dir_entry_hash (entry) & mask) != bpos.bno)
+    {
+      memcpy (moved + moved_offset, entry, elength);
+      moved_offset += elength;
+    }
+    else
+    {
+      if (kept != offset)
+        memmove (data + kept, entry, elength);
+      kept += elength;
+    }
+
+    offset += elength;
+  }
+
+  memset (data + kept, 0xff, rtems_rfs_fs_block_size (fs) - kept);
+
+  rtems_rfs_buffer_mark_dirty (&bucket);
+  rtems_rfs_buffer_mark_dirty (&split);
+  rtems_rfs_buffer_handle_close (fs, &split);
+  rtems_rfs_buffer_handle_close (fs, &bucket);
+  return rc;
+}
+
+/**
+ * Add an entry to an indexed directory. The bucket of the entry is split
+ * until it has space. A bucket which does not get space after the directory
+ * has doubled holds names with the same hash and the add fails.
+ */
+static int
+rtems_rfs_dir_index_add_entry (rtems_rfs_file_system*  fs,
+                               rtems_rfs_inode_handle* dir,
+                               const char*             name,
+                               size_t                  length,
+                               rtems_rfs_ino           ino)
+{
+  rtems_rfs_block_map     map;
+  rtems_rfs_buffer_handle buffer;
+  uint32_t                hash;
+  size_t                  splits;
+  int                     rc;
+
+  rc = rtems_rfs_block_map_open (fs, dir, &map);
+  if (rc > 0)
+    return rc;
+
+  rc = rtems_rfs_buffer_handle_open (fs, &buffer);
+  if (rc > 0)
+  {
+    rtems_rfs_block_map_close (fs, &map);
+    return rc;
+  }
+
+  hash = rtems_rfs_dir_hash (name, length);
+  splits = rtems_rfs_block_map_count (&map) + 1;
+
+  while (true)
+  {
+    rtems_rfs_block_no block;
+    uint8_t*           entry;
+    int                offset;
+    bool               read = true;
+
+    if (rtems_rfs_block_map_count (&map) == 0)
+    {
+      rc = rtems_rfs_block_map_grow (fs, &map, 1, &block);
+      read = false;
+    }
+    else
+    {
+      rtems_rfs_block_pos bpos;
+      rtems_rfs_block_set_bpos_zero (&bpos);
+      bpos.bno = rtems_rfs_dir_index_bucket (hash,
+                                             rtems_rfs_block_map_count (&map));
+      rc = rtems_rfs_block_map_find (fs, &map, &bpos, &block);
+    }
+    if (rc > 0)
+      break;
+
+    rc = rtems_rfs_buffer_handle_request (fs, &buffer, block, read);
+    if (rc > 0)
+    {
+      if (rtems_rfs_trace (RTEMS_RFS_TRACE_DIR_ADD_ENTRY))
+        printf ("rtems-rfs: dir-add-entry: "
+                "block buffer req failed for ino %" PRIu32 ": %d: %s\n",
+                rtems_rfs_inode_ino (dir), rc, strerror (rc));
+      break;
+    }
+
+    entry = rtems_rfs_buffer_data (&buffer);
+
+    if (!read)
+      memset (entry, 0xff, rtems_rfs_fs_block_size (fs));
+
+    offset = 0;
+
+    while (offset < (rtems_rfs_fs_block_size (fs) - RTEMS_RFS_DIR_ENTRY_SIZE))
+    {
+      rtems_rfs_ino eino;
+      int           elength;
+
+      elength = rtems_rfs_dir_entry_length (entry);
+      eino    = rtems_rfs_dir_entry_ino (entry);
+
+      if (elength == RTEMS_RFS_DIR_ENTRY_EMPTY)
+        break;
+
+      if (rtems_rfs_dir_entry_valid (fs, elength, eino))
+      {
+        if (rtems_rfs_trace (RTEMS_RFS_TRACE_DIR_ADD_ENTRY))
+          printf ("rtems-rfs: dir-add-entry: "
+                  "bad length or ino for ino %" PRIu32 ": %u/%" PRId32 " @ %04x\n",
+                  rtems_rfs_inode_ino (dir), elength, eino, offset);
+        rtems_rfs_buffer_handle_close (fs, &buffer);
+        rtems_rfs_block_map_close (fs, &map);
+        return EIO;
+      }
+
+      entry  += elength;
+      offset += elength;
+    }
+
+    if ((length + RTEMS_RFS_DIR_ENTRY_SIZE) <
+        (rtems_rfs_fs_block_size (fs) - offset))
+    {
+      rtems_rfs_dir_set_entry_hash (entry, hash);
+      rtems_rfs_dir_set_entry_ino (entry, ino);
+      rtems_rfs_dir_set_entry_length (entry,
+                                      RTEMS_RFS_DIR_ENTRY_SIZE + length);
+      memcpy (entry + RTEMS_RFS_DIR_ENTRY_SIZE, name, length);
+      rtems_rfs_buffer_mark_dirty (&buffer);
+      rtems_rfs_buffer_handle_close (fs, &buffer);
+      rtems_rfs_block_map_close (fs, &map);
+      return 0;
+    }
+
+    if (splits == 0)
+    {
+      rc = ENOSPC;
+      break;
+    }
+
+    /*
+     * Release the bucket before the split accesses it.
+     */
+    rc = rtems_rfs_buffer_handle_release (fs, &buffer);
+    if (rc > 0)
+      break;
+
+    rc = rtems_rfs_dir_index_split (fs, dir, &map);
+    if (rc > 0)
+    {
+      if (rtems_rfs_trace (RTEMS_RFS_TRACE_DIR_ADD_ENTRY))
+        printf ("rtems-rfs: dir-add-entry: "
+                "index split failed for ino %" PRIu32 ": %d: %s\n",
+                rtems_rfs_inode_ino (dir), rc, strerror (rc));
+      break;
+    }
+
+    splits--;
+  }
+
+  rtems_rfs_buffer_handle_close (fs, &buffer);
+  rtems_rfs_block_map_close (fs, &map);
+  return rc;
+}
+
 int
 rtems_rfs_dir_add_entry (rtems_rfs_file_system*  fs,
                          rtems_rfs_inode_handle* dir,
@@ -249,6 +555,9 @@ rtems_rfs_dir_add_entry (rtems_rfs_file_system*  fs,
     printf (", len=%zd\n", length);
   }
 
+  if (rtems_rfs_dir_indexed (dir))
+    return rtems_rfs_dir_index_add_entry (fs, dir, name, length, ino);
+
   rc = rtems_rfs_block_map_open (fs, dir, &map);
   if (rc > 0)
     return rc;
@@ -476,6 +785,9 @@ rtems_rfs_dir_del_entry (rtems_rfs_file_system*  fs,
          *
          * @note We could check again to see if the new end block in the map is
          *       also empty. This way we could clean up an empty directory.
+         *
+         * The blocks of an indexed directory are the buckets of the hash
+         * table and stay.
          */
         elength = rtems_rfs_dir_entry_length (entry);
 
@@ -487,7 +799,8 @@ rtems_rfs_dir_del_entry (rtems_rfs_file_system*  fs,
                   rtems_rfs_block_map_last (&map) ? "yes" : "no");
 
         if ((elength == RTEMS_RFS_DIR_ENTRY_EMPTY) &&
-            (eoffset == 0) && rtems_rfs_block_map_last (&map))
+            (eoffset == 0) && rtems_rfs_block_map_last (&map) &&
+            !rtems_rfs_dir_indexed (dir))
         {
           rc = rtems_rfs_block_map_shrink (fs, &map, 1);
           if (rc > 0)
@@ -110,6 +110,20 @@ rtems_rfs_fs_read_superblock (rtems_rfs_file_system* fs)
     return EIO;
   }
 
+  if (read_sb (RTEMS_RFS_SB_OFFSET_VERSION) >= RTEMS_RFS_VERSION_FEATURES)
+    fs->features = read_sb (RTEMS_RFS_SB_OFFSET_FEATURES);
+  else
+    fs->features = 0;
+
+  if ((fs->features & ~RTEMS_RFS_FEATURES) != 0)
+  {
+    if (rtems_rfs_trace (RTEMS_RFS_TRACE_OPEN))
+      printf ("rtems-rfs: read-superblock: unsupported features: %08" PRIx32 "\n",
+              fs->features);
+    rtems_rfs_buffer_handle_close (fs, &handle);
+    return EIO;
+  }
+
   fs->bad_blocks      = read_sb (RTEMS_RFS_SB_OFFSET_BAD_BLOCKS);
   fs->max_name_length = read_sb (RTEMS_RFS_SB_OFFSET_MAX_NAME_LENGTH);
   fs->group_count     = read_sb (RTEMS_RFS_SB_OFFSET_GROUPS);
@@ -226,6 +240,7 @@ rtems_rfs_fs_open (const char*             name,
   rtems_chain_initialize_empty (&(*fs)->file_shares);
 
   (*fs)->max_held_buffers = max_held_buffers;
+  (*fs)->delayed_blocks = RTEMS_RFS_FS_DELAYED_BLOCKS;
   (*fs)->buffers_count = 0;
   (*fs)->release_count = 0;
   (*fs)->release_modified_count = 0;
@@ -262,9 +277,24 @@ rtems_rfs_fs_open (const char*             name,
     return -1;
   }
 
+  rc = rtems_rfs_inode_cache_open (*fs,
+                                   (flags & RTEMS_RFS_FS_NO_INODE_CACHE) ?
+                                   0 : RTEMS_RFS_FS_INODE_CACHE_SIZE);
+  if (rc > 0)
+  {
+    rtems_rfs_buffer_close (*fs);
+    free (*fs);
+    if (rtems_rfs_trace (RTEMS_RFS_TRACE_OPEN))
+      printf ("rtems-rfs: open: inode cache open failed: %d: %s\n",
+              rc, strerror (rc));
+    errno = rc;
+    return -1;
+  }
+
   rc = rtems_rfs_inode_open (*fs, RTEMS_RFS_ROOT_INO, &inode, true);
   if (rc > 0)
   {
+    rtems_rfs_inode_cache_close (*fs);
     rtems_rfs_buffer_close (*fs);
     free (*fs);
     if (rtems_rfs_trace (RTEMS_RFS_TRACE_OPEN))
@@ -281,6 +311,7 @@ rtems_rfs_fs_open (const char*             name,
     if ((mode == 0xffff) || !RTEMS_RFS_S_ISDIR (mode))
     {
       rtems_rfs_inode_close (*fs, &inode);
+      rtems_rfs_inode_cache_close (*fs);
       rtems_rfs_buffer_close (*fs);
       free (*fs);
       if (rtems_rfs_trace (RTEMS_RFS_TRACE_OPEN))
@@ -293,6 +324,7 @@ rtems_rfs_fs_open (const char*             name,
   rc = rtems_rfs_inode_close (*fs, &inode);
   if (rc > 0)
   {
+    rtems_rfs_inode_cache_close (*fs);
     rtems_rfs_buffer_close (*fs);
     free (*fs);
     if (rtems_rfs_trace (RTEMS_RFS_TRACE_OPEN))
@@ -316,6 +348,7 @@ rtems_rfs_fs_close (rtems_rfs_file_system* fs)
   for (group = 0; group < fs->group_count; group++)
     rtems_rfs_group_close (fs, &fs->groups[group]);
 
+  rtems_rfs_inode_cache_close (fs);
   rtems_rfs_buffer_close (fs);
 
   free (fs);
@@ -22,6 +22,7 @@
 #define _RTEMS_RFS_FILE_SYSTEM_H_
 
 #include <rtems/rfs/rtems-rfs-group.h>
+#include <rtems/rfs/rtems-rfs-mutex.h>
 
 /**
  * Superblock offsets and values.
@@ -37,11 +38,18 @@
 #define RTEMS_RFS_SB_OFFSET_GROUP_BLOCKS    (RTEMS_RFS_SB_OFFSET_GROUPS          + 4)
 #define RTEMS_RFS_SB_OFFSET_GROUP_INODES    (RTEMS_RFS_SB_OFFSET_GROUP_BLOCKS    + 4)
 #define RTEMS_RFS_SB_OFFSET_INODE_SIZE      (RTEMS_RFS_SB_OFFSET_GROUP_INODES    + 4)
+#define RTEMS_RFS_SB_OFFSET_FEATURES        (RTEMS_RFS_SB_OFFSET_INODE_SIZE      + 4)
 
 /**
  * RFS Version Number.
  */
-#define RTEMS_RFS_VERSION (0x00000000)
+#define RTEMS_RFS_VERSION (0x00000001)
+
+/**
+ * The first version with the features field in the superblock. Older images
+ * have no features.
+ */
+#define RTEMS_RFS_VERSION_FEATURES (0x00000001)
 
 /**
  * RFS Version Number Mask. The mask determines which bits of the version
@@ -49,6 +57,18 @@
  */
 #define RTEMS_RFS_VERSION_MASK INT32_C(0x00000000)
 
+/**
+ * Superblock features. A file system with a feature this code does not know
+ * is not mounted.
+ */
+#define RTEMS_RFS_FEATURE_DIR_INDEX (1 << 0) /**< New directories place their
+                                              * entries in blocks by the hash
+                                              * of the name. */
+#define RTEMS_RFS_FEATURE_EXTENTS   (1 << 1) /**< New regular files map their
+                                              * blocks with extents. */
+#define RTEMS_RFS_FEATURES (RTEMS_RFS_FEATURE_DIR_INDEX | \
+                            RTEMS_RFS_FEATURE_EXTENTS)
+
 /**
  * The root inode number. Do not use 0 as this has special meaning in some
  * Unix operating systems.
@@ -84,6 +104,23 @@
  */
 #define RTEMS_RFS_FS_MAX_HELD_BUFFERS (5)
 
+/**
+ * The number of unreferenced inodes held in the inode cache.
+ */
+#define RTEMS_RFS_FS_INODE_CACHE_SIZE (32)
+
+/**
+ * The number of hash buckets of the inode cache. Must be a power of 2.
+ */
+#define RTEMS_RFS_FS_INODE_CACHE_BUCKETS (16)
+
+/**
+ * The number of blocks of a regular file with a delayed allocation. The
+ * blocks are allocated when the file is flushed or when this number is
+ * reached.
+ */
+#define RTEMS_RFS_FS_DELAYED_BLOCKS (16)
+
 /**
  * Absolute position. Make a 64bit value.
  */
@@ -109,6 +146,10 @@ typedef int64_t rtems_rfs_pos_rel;
 #define RTEMS_RFS_FS_READ_ONLY         (1 << 3) /**< Make the mount
                                                  * read-only. Currently not
                                                  * supported. */
+#define RTEMS_RFS_FS_NO_INODE_CACHE    (1 << 4) /**< Do not cache inodes and
+                                                 * access them in the inode
+                                                 * blocks. The default is to
+                                                 * cache inodes. */
 /**
  * RFS File System data.
  */
@@ -151,6 +192,11 @@ struct _rtems_rfs_file_system
   size_t size;
 #endif
 
+  /**
+   * The features of the file system from the superblock.
+   */
+  uint32_t features;
+
   /**
    * Inode count.
    */
@@ -215,6 +261,12 @@ struct _rtems_rfs_file_system
    */
   uint32_t max_held_buffers;
 
+  /**
+   * Number of blocks of a regular file with a delayed allocation. A value of
+   * 0 allocates the blocks when the file grows.
+   */
+  uint32_t delayed_blocks;
+
   /**
    * List of buffers attached to buffer handles. Allows sharing.
    */
@@ -247,6 +299,53 @@ struct _rtems_rfs_file_system
    */
   uint32_t release_modified_count;
 
+  /**
+   * Lock protecting the buffer lists and counts above. File data and block
+   * maps are protected by the lock of the open file and the allocation
+   * bitmaps by the lock of each group so the buffer lists can be accessed
+   * by more than one request at a time. It is the innermost lock and is not
+   * held across device I/O.
+   *
+   * The locks are always taken in the order file system, open file, group,
+   * buffer I/O then buffer. A task holding an open file lock never takes the
+   * file system lock.
+   */
+  rtems_rfs_mutex buffer_lock;
+
+  /**
+   * Lock serialising the requests that miss the buffer lists and go to the
+   * device. It is taken before the buffer lock so a block is only requested
+   * from the device once.
+   */
+  rtems_rfs_mutex buffer_io_lock;
+
+  /**
+   * Number of unreferenced inodes held in the inode cache. Zero if the inode
+   * cache is not used.
+   */
+  uint32_t inode_cache_size;
+
+  /**
+   * Number of inodes in the inode cache.
+   */
+  uint32_t inode_cache_count;
+
+  /**
+   * Unreferenced cached inodes with the least recently used at the head.
+   */
+  rtems_chain_control inode_cache_lru;
+
+  /**
+   * Cached inodes hashed by the ino.
+   */
+  rtems_chain_control inode_cache_hash[RTEMS_RFS_FS_INODE_CACHE_BUCKETS];
+
+  /**
+   * Lock protecting the inode cache lists and counts. It is taken after the
+   * group locks and before the buffer lock.
+   */
+  rtems_rfs_mutex inode_cache_lock;
+
   /**
    * List of open shared file node data. The shared node data such as the inode
    * and block map allows a single file to be open more than once.
@@ -279,6 +378,27 @@ struct _rtems_rfs_file_system
  */
 #define rtems_rfs_fs_no_local_cache(_f) ((_f)->flags & RTEMS_RFS_FS_NO_LOCAL_CACHE)
 
+/**
+ * Are new directories indexed by the hash of the names ?
+ *
+ * @param[in] _fs is a pointer to the file system.
+ */
+#define rtems_rfs_fs_dir_index(_f) ((_f)->features & RTEMS_RFS_FEATURE_DIR_INDEX)
+
+/**
+ * Do new regular files map their blocks with extents ?
+ *
+ * @param[in] _fs is a pointer to the file system.
+ */
+#define rtems_rfs_fs_extents(_f) ((_f)->features & RTEMS_RFS_FEATURE_EXTENTS)
+
+/**
+ * Are inodes held in the inode cache ?
+ *
+ * @param[in] _fs is a pointer to the file system.
+ */
+#define rtems_rfs_fs_inode_cache(_f) ((_f)->inode_cache_size > 0)
+
 /**
  * The disk device number.
  *
@@ -363,6 +483,26 @@ struct _rtems_rfs_file_system
  */
 #define rtems_rfs_fs_user(_fs) ((_fs)->user)
 
+/**
+ * Lock the buffer lists.
+ */
+#define rtems_rfs_fs_buffer_lock(_fs) rtems_rfs_mutex_lock (&(_fs)->buffer_lock)
+
+/**
+ * Unlock the buffer lists.
+ */
+#define rtems_rfs_fs_buffer_unlock(_fs) rtems_rfs_mutex_unlock (&(_fs)->buffer_lock)
+
+/**
+ * Lock the buffer device requests.
+ */
+#define rtems_rfs_fs_buffer_io_lock(_fs) rtems_rfs_mutex_lock (&(_fs)->buffer_io_lock)
+
+/**
+ * Unlock the buffer device requests.
+ */
+#define rtems_rfs_fs_buffer_io_unlock(_fs) rtems_rfs_mutex_unlock (&(_fs)->buffer_io_lock)
+
 /**
  * Return the size of the disk in bytes.
  *
@@ -115,6 +115,27 @@ rtems_rfs_file_open (rtems_rfs_file_system*  fs,
       return rc;
     }
 
+    /*
+     * Only regular files delay the allocation of blocks. Directories are also
+     * opened as maps by the directory code and allocate a block at a time.
+     */
+    if (RTEMS_RFS_S_ISREG (rtems_rfs_inode_get_mode (&shared->inode)))
+      rtems_rfs_block_map_set_delayed (&shared->map, fs->delayed_blocks);
+
+    rc = rtems_rfs_mutex_create (&shared->lock);
+    if (rc > 0)
+    {
+      if (rtems_rfs_trace (RTEMS_RFS_TRACE_FILE_OPEN))
+        printf ("rtems-rfs: file-open: lock create failed: %d: %s\n",
+                rc, strerror (rc));
+      rtems_rfs_block_map_close (fs, &shared->map);
+      rtems_rfs_inode_close (fs, &shared->inode);
+      free (shared);
+      rtems_rfs_buffer_handle_close (fs, &handle->buffer);
+      free (handle);
+      return rc;
+    }
+
     shared->references = 1;
     shared->size.count = rtems_rfs_inode_get_block_count (&shared->inode);
     shared->size.offset = rtems_rfs_inode_get_block_offset (&shared->inode);
@@ -157,7 +178,12 @@ rtems_rfs_file_close (rtems_rfs_file_system* fs,
 
   if (handle->shared->references == 0)
   {
-    if (!rtems_rfs_inode_is_loaded (&handle->shared->inode))
+    /*
+     * Allocate the delayed blocks before the size of the map is set.
+     */
+    rrc = rtems_rfs_block_map_flush (fs, &handle->shared->map);
+
+    if ((rrc == 0) && !rtems_rfs_inode_is_loaded (&handle->shared->inode))
       rrc = rtems_rfs_inode_load (fs, &handle->shared->inode);
 
     if (rrc == 0)
@@ -198,6 +224,7 @@ rtems_rfs_file_close (rtems_rfs_file_system* fs,
     }
 
     rtems_chain_extract_unprotected (&handle->shared->link);
+    rtems_rfs_mutex_destroy (&handle->shared->lock);
     free (handle->shared);
   }
 
@@ -235,10 +262,20 @@ rtems_rfs_file_io_start (rtems_rfs_file_handle* handle,
 
     request_read = read;
 
-    rc = rtems_rfs_block_map_find (rtems_rfs_file_fs (handle),
-                                   rtems_rfs_file_map (handle),
-                                   rtems_rfs_file_bpos (handle),
-                                   &block);
+    /*
+     * The data of a block with a delayed allocation is held by the map.
+     */
+    handle->delayed =
+      rtems_rfs_block_map_delayed_data (rtems_rfs_file_fs (handle),
+                                        rtems_rfs_file_map (handle),
+                                        rtems_rfs_file_bpos (handle));
+    if (handle->delayed)
+      rc = 0;
+    else
+      rc = rtems_rfs_block_map_find (rtems_rfs_file_fs (handle),
+                                     rtems_rfs_file_map (handle),
+                                     rtems_rfs_file_bpos (handle),
+                                     &block);
     if (rc > 0)
     {
       /*
@@ -256,9 +293,13 @@ rtems_rfs_file_io_start (rtems_rfs_file_handle* handle,
       if (rtems_rfs_trace (RTEMS_RFS_TRACE_FILE_IO))
         printf ("rtems-rfs: file-io: start: grow\n");
 
-      rc = rtems_rfs_block_map_grow (rtems_rfs_file_fs (handle),
-                                     rtems_rfs_file_map (handle),
-                                     1, &block);
+      rc = rtems_rfs_block_map_grow_delayed (rtems_rfs_file_fs (handle),
+                                             rtems_rfs_file_map (handle),
+                                             &handle->delayed);
+      if ((rc == ENOTSUP) || (rc == ENOMEM))
+        rc = rtems_rfs_block_map_grow (rtems_rfs_file_fs (handle),
+                                       rtems_rfs_file_map (handle),
+                                       1, &block);
       if (rc > 0)
         return rc;
 
@@ -277,15 +318,18 @@ rtems_rfs_file_io_start (rtems_rfs_file_handle* handle,
         request_read = true;
     }
 
-    if (rtems_rfs_trace (RTEMS_RFS_TRACE_FILE_IO))
-      printf ("rtems-rfs: file-io: start: block=%" PRIu32 " request-read=%s\n",
-              block, request_read ? "yes" : "no");
+    if (!handle->delayed)
+    {
+      if (rtems_rfs_trace (RTEMS_RFS_TRACE_FILE_IO))
+        printf ("rtems-rfs: file-io: start: block=%" PRIu32 " request-read=%s\n",
+                block, request_read ? "yes" : "no");
 
-    rc = rtems_rfs_buffer_handle_request (rtems_rfs_file_fs (handle),
-                                          rtems_rfs_file_buffer (handle),
-                                          block, request_read);
-    if (rc > 0)
-      return rc;
+      rc = rtems_rfs_buffer_handle_request (rtems_rfs_file_fs (handle),
+                                            rtems_rfs_file_buffer (handle),
+                                            block, request_read);
+      if (rc > 0)
+        return rc;
+    }
   }
 
   if (read
@@ -334,6 +378,11 @@ rtems_rfs_file_io_end (rtems_rfs_file_handle* handle,
     }
   }
 
+  /*
+   * The data of a delayed block stays with the map.
+   */
+  handle->delayed = NULL;
+
   /*
    * Update the handle's position. Only a block size can be handled at a time
    * so no special maths is needed. If the offset is bigger than the block size
@@ -396,6 +445,7 @@ int
 rtems_rfs_file_io_release (rtems_rfs_file_handle* handle)
 {
   int rc = 0;
+  handle->delayed = NULL;
   if (rtems_rfs_buffer_handle_has_block (&handle->buffer))
     rc = rtems_rfs_buffer_handle_release (rtems_rfs_file_fs (handle),
                                           rtems_rfs_file_buffer (handle));
@@ -84,6 +84,15 @@ typedef struct _rtems_rfs_file_shared
    */
   rtems_rfs_file_system* fs;
 
+  /**
+   * The lock protecting the file data, the block map and the values above
+   * held in memory. It is taken after the file system lock and allows I/O on
+   * different files to proceed in parallel. The list link and the reference
+   * count are protected by the file system lock. The file system lock must
+   * not be taken while this lock is held.
+   */
+  rtems_rfs_mutex lock;
+
 } rtems_rfs_file_shared;
 
 /**
@@ -194,6 +203,12 @@ typedef struct _rtems_rfs_file_handle
    */
   rtems_rfs_buffer_handle buffer;
 
+  /**
+   * The data at the file's position if the block has a delayed allocation.
+   * The data is held by the block map.
+   */
+  uint8_t* delayed;
+
   /**
    * The block position of this file handle.
    */
@@ -207,16 +222,27 @@ typedef struct _rtems_rfs_file_handle
 } rtems_rfs_file_handle;
 
 /**
- * Access the data in the buffer.
+ * Access the data in the buffer or in the delayed block.
  */
 #define rtems_rfs_file_data(_f) \
-  (rtems_rfs_buffer_data (&(_f)->buffer) + (_f)->bpos.boff)
+  (((_f)->delayed ? (_f)->delayed : rtems_rfs_buffer_data (&(_f)->buffer)) + \
+   (_f)->bpos.boff)
 
 /**
  * Return the file system data pointer given a file handle.
  */
 #define rtems_rfs_file_fs(_f) ((_f)->shared->fs)
 
+/**
+ * Lock the shared file data given a file handle.
+ */
+#define rtems_rfs_file_lock(_f) rtems_rfs_mutex_lock (&(_f)->shared->lock)
+
+/**
+ * Unlock the shared file data given a file handle.
+ */
+#define rtems_rfs_file_unlock(_f) rtems_rfs_mutex_unlock (&(_f)->shared->lock)
+
 /**
  * Return the file's inode handle pointer given a file handle.
  */
@@ -180,6 +180,12 @@ rtems_rfs_check_config (rtems_rfs_file_system*         fs,
     fs->max_name_length = 512;
   }
 
+  if (config->dir_index)
+    fs->features |= RTEMS_RFS_FEATURE_DIR_INDEX;
+
+  if (config->extents)
+    fs->features |= RTEMS_RFS_FEATURE_EXTENTS;
+
   return true;
 }
 
@@ -430,6 +436,7 @@ rtems_rfs_write_superblock (rtems_rfs_file_system* fs)
   write_sb (RTEMS_RFS_SB_OFFSET_GROUP_BLOCKS, fs->group_blocks);
   write_sb (RTEMS_RFS_SB_OFFSET_GROUP_INODES, fs->group_inodes);
   write_sb (RTEMS_RFS_SB_OFFSET_INODE_SIZE, RTEMS_RFS_INODE_SIZE);
+  write_sb (RTEMS_RFS_SB_OFFSET_FEATURES, fs->features);
 
   rtems_rfs_buffer_mark_dirty (&handle);
 
@@ -508,6 +515,9 @@ rtems_rfs_write_root_dir (const char* name)
     printf ("rtems-rfs: format: inode initialise failed: %d: %s\n",
             rc, strerror (rc));
 
+  if (rtems_rfs_fs_dir_index (fs))
+    rtems_rfs_inode_set_flags (&inode, RTEMS_RFS_INODE_FLAG_DIR_INDEX);
+
   rc = rtems_rfs_dir_add_entry (fs, &inode, ".", 1, ino);
   if (rc > 0)
     printf ("rtems-rfs: format: directory add failed: %d: %s\n",
@@ -601,6 +611,10 @@ rtems_rfs_format (const char* name, const rtems_rfs_format_config* config)
     printf ("rtems-rfs: format: groups = %u\n", fs.group_count);
     printf ("rtems-rfs: format: group blocks = %zu\n", fs.group_blocks);
     printf ("rtems-rfs: format: group inodes = %zu\n", fs.group_inodes);
+    printf ("rtems-rfs: format: directory index = %s\n",
+            rtems_rfs_fs_dir_index (&fs) ? "yes" : "no");
+    printf ("rtems-rfs: format: extents = %s\n",
+            rtems_rfs_fs_extents (&fs) ? "yes" : "no");
   }
 
   rc = rtems_rfs_buffer_setblksize (&fs, rtems_rfs_fs_block_size (&fs));
@@ -65,6 +65,18 @@ typedef struct _rtems_rfs_format_config
    */
   bool initialise_inodes;
 
+  /**
+   * Place directory entries in blocks by the hash of the name so lookups
+   * and inserts only access one block. The default is a linear directory.
+   */
+  bool dir_index;
+
+  /**
+   * Map the blocks of regular files with extents so a contiguous run of
+   * blocks is a single entry. The default is the block map.
+   */
+  bool extents;
+
   /**
    * Is the format verbose.
    */
@@ -115,6 +115,19 @@ rtems_rfs_group_open (rtems_rfs_file_system* fs,
     rtems_rfs_bitmap_release_buffer (fs, &group->inode_bitmap);
   }
 
+  rc = rtems_rfs_mutex_create (&group->lock);
+  if (rc > 0)
+  {
+    rtems_rfs_bitmap_close (&group->inode_bitmap);
+    rtems_rfs_buffer_handle_close (fs, &group->inode_bitmap_buffer);
+    rtems_rfs_bitmap_close (&group->block_bitmap);
+    rtems_rfs_buffer_handle_close (fs, &group->block_bitmap_buffer);
+    if (rtems_rfs_trace (RTEMS_RFS_TRACE_GROUP_OPEN))
+      printf ("rtems-rfs: group-open: could not create lock: %d: %s\n",
+              rc, strerror (rc));
+    return rc;
+  }
+
   return 0;
 }
 
@@ -142,6 +155,9 @@ rtems_rfs_group_close (rtems_rfs_file_system* fs, rtems_rfs_group* group)
   if (rc > 0)
     result = rc;
   rc = rtems_rfs_buffer_handle_close (fs, &group->block_bitmap_buffer);
+  if (rc > 0)
+    result = rc;
+  rc = rtems_rfs_mutex_destroy (&group->lock);
   if (rc > 0)
     result = rc;
 
@@ -213,13 +229,20 @@ rtems_rfs_group_bitmap_alloc (rtems_rfs_file_system* fs,
     else
       bitmap = &fs->groups[group].block_bitmap;
 
+    rtems_rfs_mutex_lock (&fs->groups[group].lock);
+
     rc = rtems_rfs_bitmap_map_alloc (bitmap, bit, &allocated, &bit);
     if (rc > 0)
+    {
+      rtems_rfs_mutex_unlock (&fs->groups[group].lock);
       return rc;
+    }
 
     if (rtems_rfs_fs_release_bitmaps (fs))
       rtems_rfs_bitmap_release_buffer (fs, bitmap);
 
+    rtems_rfs_mutex_unlock (&fs->groups[group].lock);
+
     if (allocated)
     {
       if (inode)
@@ -258,6 +281,68 @@ rtems_rfs_group_bitmap_alloc (rtems_rfs_file_system* fs,
   return ENOSPC;
 }
 
+int
+rtems_rfs_group_bitmap_alloc_run (rtems_rfs_file_system* fs,
+                                  rtems_rfs_bitmap_bit   goal,
+                                  size_t                 count,
+                                  rtems_rfs_bitmap_bit*  result,
+                                  size_t*                allocated)
+{
+  rtems_rfs_bitmap_control* bitmap;
+  unsigned int              group;
+  rtems_rfs_bitmap_bit      bit;
+  int                       rc;
+
+  *allocated = 0;
+
+  /*
+   * The first block uses the search map to find a clear bit near the goal.
+   */
+  rc = rtems_rfs_group_bitmap_alloc (fs, goal, false, result);
+  if (rc > 0)
+    return rc;
+
+  *allocated = 1;
+
+  group = (*result - RTEMS_RFS_SUPERBLOCK_SIZE) / fs->group_blocks;
+  bit = (rtems_rfs_bitmap_bit) ((*result - RTEMS_RFS_SUPERBLOCK_SIZE) %
+                                fs->group_blocks);
+  bitmap = &fs->groups[group].block_bitmap;
+
+  rtems_rfs_mutex_lock (&fs->groups[group].lock);
+
+  /*
+   * Extend the run while the following bits are clear. Another task may have
+   * taken a bit since the first block was allocated so test each one holding
+   * the group lock.
+   */
+  while ((*allocated < count) && ((bit + *allocated) < bitmap->size))
+  {
+    bool state;
+
+    rc = rtems_rfs_bitmap_map_test (bitmap, bit + *allocated, &state);
+    if ((rc > 0) || state)
+      break;
+
+    rc = rtems_rfs_bitmap_map_set (bitmap, bit + *allocated);
+    if (rc > 0)
+      break;
+
+    (*allocated)++;
+  }
+
+  if (rtems_rfs_fs_release_bitmaps (fs))
+    rtems_rfs_bitmap_release_buffer (fs, bitmap);
+
+  rtems_rfs_mutex_unlock (&fs->groups[group].lock);
+
+  if (rtems_rfs_trace (RTEMS_RFS_TRACE_GROUP_BITMAPS))
+    printf ("rtems-rfs: group-bitmap-alloc-run: block %" PRId32 " run %zd\n",
+            *result, *allocated);
+
+  return 0;
+}
+
 int
 rtems_rfs_group_bitmap_free (rtems_rfs_file_system* fs,
                              bool                   inode,
@@ -292,10 +377,14 @@ rtems_rfs_group_bitmap_free (rtems_rfs_file_system* fs,
   else
     bitmap = &fs->groups[group].block_bitmap;
 
+  rtems_rfs_mutex_lock (&fs->groups[group].lock);
+
   rc = rtems_rfs_bitmap_map_clear (bitmap, bit);
 
   rtems_rfs_bitmap_release_buffer (fs, bitmap);
 
+  rtems_rfs_mutex_unlock (&fs->groups[group].lock);
+
   return rc;
 }
 
@@ -337,10 +426,14 @@ rtems_rfs_group_bitmap_test (rtems_rfs_file_system* fs,
   else
     bitmap = &fs->groups[group].block_bitmap;
 
+  rtems_rfs_mutex_lock (&fs->groups[group].lock);
+
   rc = rtems_rfs_bitmap_map_test (bitmap, bit, state);
 
   rtems_rfs_bitmap_release_buffer (fs, bitmap);
 
+  rtems_rfs_mutex_unlock (&fs->groups[group].lock);
+
   return rc;
 }
 
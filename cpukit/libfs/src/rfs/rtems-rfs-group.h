@@ -32,6 +32,7 @@
 #include <rtems/rfs/rtems-rfs-trace.h>
 #include <rtems/rfs/rtems-rfs-bitmaps.h>
 #include <rtems/rfs/rtems-rfs-buffer.h>
+#include <rtems/rfs/rtems-rfs-mutex.h>
 
 /**
  * Block allocations for a group on disk.
@@ -80,6 +81,12 @@ typedef struct _rtems_rfs_group
    */
   rtems_rfs_buffer_handle inode_bitmap_buffer;
 
+  /**
+   * The lock protecting the bitmaps of the group. Allocations in different
+   * groups can proceed in parallel.
+   */
+  rtems_rfs_mutex lock;
+
 } rtems_rfs_group;
 
 /**
@@ -139,6 +146,26 @@ int rtems_rfs_group_bitmap_alloc (rtems_rfs_file_system* fs,
                                   bool                   inode,
                                   rtems_rfs_bitmap_bit*  result);
 
+/**
+ * @brief Allocate a run of contiguous blocks.
+ *
+ * The first block is allocated as rtems_rfs_group_bitmap_alloc does. The run
+ * is then extended while the blocks following it in the same group are
+ * free. The run can be shorter than requested but holds at least one block.
+ *
+ * @param fs The file system data.
+ * @param goal The goal to seed the bitmap search.
+ * @param count The number of blocks wanted.
+ * @param result The first block of the run.
+ * @param allocated The number of blocks in the run.
+ * @retval int The error number (errno). No error if 0.
+ */
+int rtems_rfs_group_bitmap_alloc_run (rtems_rfs_file_system* fs,
+                                      rtems_rfs_bitmap_bit   goal,
+                                      size_t                 count,
+                                      rtems_rfs_bitmap_bit*  result,
+                                      size_t*                allocated);
+
 /**
  * @brief Free the group allocated bit.
  *
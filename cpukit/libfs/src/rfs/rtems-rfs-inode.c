@@ -20,6 +20,8 @@
 #endif
 
 #include <inttypes.h>
+#include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <rtems/rfs/rtems-rfs-block.h>
@@ -48,6 +50,203 @@ rtems_rfs_inode_free (rtems_rfs_file_system* fs,
   return rtems_rfs_group_bitmap_free (fs, true, bit);
 }
 
+int
+rtems_rfs_inode_cache_open (rtems_rfs_file_system* fs,
+                            uint32_t               size)
+{
+  int b;
+  int rc;
+
+  fs->inode_cache_size = 0;
+  fs->inode_cache_count = 0;
+  rtems_chain_initialize_empty (&fs->inode_cache_lru);
+  for (b = 0; b < RTEMS_RFS_FS_INODE_CACHE_BUCKETS; b++)
+    rtems_chain_initialize_empty (&fs->inode_cache_hash[b]);
+
+  if (size == 0)
+    return 0;
+
+  rc = rtems_rfs_mutex_create (&fs->inode_cache_lock);
+  if (rc > 0)
+    return rc;
+
+  fs->inode_cache_size = size;
+  return 0;
+}
+
+void
+rtems_rfs_inode_cache_close (rtems_rfs_file_system* fs)
+{
+  int b;
+
+  if (!rtems_rfs_fs_inode_cache (fs))
+    return;
+
+  for (b = 0; b < RTEMS_RFS_FS_INODE_CACHE_BUCKETS; b++)
+  {
+    rtems_chain_control* bucket = &fs->inode_cache_hash[b];
+    while (!rtems_chain_is_empty (bucket))
+    {
+      rtems_chain_node* node = rtems_chain_get_unprotected (bucket);
+      free (node);
+    }
+  }
+
+  rtems_chain_initialize_empty (&fs->inode_cache_lru);
+  fs->inode_cache_count = 0;
+  fs->inode_cache_size = 0;
+  rtems_rfs_mutex_destroy (&fs->inode_cache_lock);
+}
+
+static rtems_chain_control*
+rtems_rfs_inode_cache_bucket (rtems_rfs_file_system* fs, rtems_rfs_ino ino)
+{
+  return &fs->inode_cache_hash[ino & (RTEMS_RFS_FS_INODE_CACHE_BUCKETS - 1)];
+}
+
+/**
+ * Reference the cache entry of the handle's inode. The inode is read from the
+ * inode block if it is not cached. An unreferenced entry is reused once the
+ * cache is full. If all entries are referenced the cache grows and shrinks
+ * back as the entries are released so all handles of an inode always share
+ * the same copy.
+ */
+static int
+rtems_rfs_inode_cache_get (rtems_rfs_file_system*  fs,
+                           rtems_rfs_inode_handle* handle)
+{
+  rtems_rfs_inode_cache_entry* entry = NULL;
+  rtems_chain_control*         bucket;
+  rtems_chain_node*            node;
+  int                          rc;
+
+  bucket = rtems_rfs_inode_cache_bucket (fs, handle->ino);
+
+  rtems_rfs_mutex_lock (&fs->inode_cache_lock);
+
+  node = rtems_chain_first (bucket);
+  while (!rtems_chain_is_tail (bucket, node))
+  {
+    rtems_rfs_inode_cache_entry* e;
+    e = (rtems_rfs_inode_cache_entry*) node;
+    if (e->ino == handle->ino)
+    {
+      entry = e;
+      break;
+    }
+    node = rtems_chain_next (node);
+  }
+
+  if (entry)
+  {
+    if (entry->refs == 0)
+      rtems_chain_extract_unprotected (&entry->lru_link);
+  }
+  else
+  {
+    if ((fs->inode_cache_count >= fs->inode_cache_size) &&
+        !rtems_chain_is_empty (&fs->inode_cache_lru))
+    {
+      node = rtems_chain_get_unprotected (&fs->inode_cache_lru);
+      entry = (rtems_rfs_inode_cache_entry*)
+        ((char*) node - offsetof (rtems_rfs_inode_cache_entry, lru_link));
+      rtems_chain_extract_unprotected (&entry->hash_link);
+    }
+    else
+    {
+      entry = malloc (sizeof (rtems_rfs_inode_cache_entry));
+      if (!entry)
+      {
+        rtems_rfs_mutex_unlock (&fs->inode_cache_lock);
+        return ENOMEM;
+      }
+      fs->inode_cache_count++;
+    }
+
+    rc = rtems_rfs_buffer_handle_request (fs, &handle->buffer,
+                                          handle->block, true);
+    if (rc == 0)
+    {
+      rtems_rfs_inode* inode = rtems_rfs_buffer_data (&handle->buffer);
+      memcpy (&entry->node, inode + handle->offset, RTEMS_RFS_INODE_SIZE);
+      rc = rtems_rfs_buffer_handle_release (fs, &handle->buffer);
+      handle->buffer.dirty = false;
+    }
+    if (rc > 0)
+    {
+      fs->inode_cache_count--;
+      rtems_rfs_mutex_unlock (&fs->inode_cache_lock);
+      free (entry);
+      return rc;
+    }
+
+    entry->ino = handle->ino;
+    entry->refs = 0;
+    rtems_chain_append_unprotected (bucket, &entry->hash_link);
+  }
+
+  entry->refs++;
+
+  rtems_rfs_mutex_unlock (&fs->inode_cache_lock);
+
+  handle->cache = entry;
+  handle->node = &entry->node;
+
+  return 0;
+}
+
+/**
+ * Release the reference of the handle to the cache entry.
+ */
+static void
+rtems_rfs_inode_cache_put (rtems_rfs_file_system*  fs,
+                           rtems_rfs_inode_handle* handle)
+{
+  rtems_rfs_inode_cache_entry* entry = handle->cache;
+
+  rtems_rfs_mutex_lock (&fs->inode_cache_lock);
+
+  entry->refs--;
+  if (entry->refs == 0)
+  {
+    if (fs->inode_cache_count > fs->inode_cache_size)
+    {
+      rtems_chain_extract_unprotected (&entry->hash_link);
+      fs->inode_cache_count--;
+      free (entry);
+    }
+    else
+      rtems_chain_append_unprotected (&fs->inode_cache_lru, &entry->lru_link);
+  }
+
+  rtems_rfs_mutex_unlock (&fs->inode_cache_lock);
+
+  handle->cache = NULL;
+}
+
+/**
+ * Write the cached copy of the inode to the inode block.
+ */
+static int
+rtems_rfs_inode_cache_write (rtems_rfs_file_system*  fs,
+                             rtems_rfs_inode_handle* handle)
+{
+  rtems_rfs_inode* inode;
+  int              rc;
+
+  rc = rtems_rfs_buffer_handle_request (fs, &handle->buffer,
+                                        handle->block, true);
+  if (rc > 0)
+    return rc;
+
+  inode = rtems_rfs_buffer_data (&handle->buffer);
+  memcpy (inode + handle->offset, handle->node, RTEMS_RFS_INODE_SIZE);
+  rtems_rfs_buffer_mark_dirty (&handle->buffer);
+  rc = rtems_rfs_buffer_handle_release (fs, &handle->buffer);
+  handle->buffer.dirty = false;
+  return rc;
+}
+
 int
 rtems_rfs_inode_open (rtems_rfs_file_system*  fs,
                       rtems_rfs_ino           ino,
@@ -70,6 +269,7 @@ rtems_rfs_inode_open (rtems_rfs_file_system*  fs,
 
   handle->ino = ino;
   handle->node = NULL;
+  handle->cache = NULL;
   handle->loads = 0;
 
   gino  = ino - RTEMS_RFS_ROOT_INO;
@@ -126,13 +326,22 @@ rtems_rfs_inode_load (rtems_rfs_file_system*  fs,
   {
     int rc;
 
-    rc = rtems_rfs_buffer_handle_request (fs,&handle->buffer,
-                                          handle->block, true);
-    if (rc > 0)
-      return rc;
+    if (rtems_rfs_fs_inode_cache (fs))
+    {
+      rc = rtems_rfs_inode_cache_get (fs, handle);
+      if (rc > 0)
+        return rc;
+    }
+    else
+    {
+      rc = rtems_rfs_buffer_handle_request (fs,&handle->buffer,
+                                            handle->block, true);
+      if (rc > 0)
+        return rc;
 
-    handle->node = rtems_rfs_buffer_data (&handle->buffer);
-    handle->node += handle->offset;
+      handle->node = rtems_rfs_buffer_data (&handle->buffer);
+      handle->node += handle->offset;
+    }
   }
 
   handle->loads++;
@@ -166,7 +375,14 @@ rtems_rfs_inode_unload (rtems_rfs_file_system*  fs,
        */
       if (rtems_rfs_buffer_dirty (&handle->buffer) && update_ctime)
         rtems_rfs_inode_set_ctime (handle, time (NULL));
-      rc = rtems_rfs_buffer_handle_release (fs, &handle->buffer);
+      if (handle->cache)
+      {
+        if (rtems_rfs_buffer_dirty (&handle->buffer))
+          rc = rtems_rfs_inode_cache_write (fs, handle);
+        rtems_rfs_inode_cache_put (fs, handle);
+      }
+      else
+        rc = rtems_rfs_buffer_handle_release (fs, &handle->buffer);
       handle->node = NULL;
     }
   }
@@ -243,6 +459,11 @@ rtems_rfs_inode_create (rtems_rfs_file_system*  fs,
     return rc;
   }
 
+  if (RTEMS_RFS_S_ISDIR (mode) && rtems_rfs_fs_dir_index (fs))
+    rtems_rfs_inode_set_flags (&inode, RTEMS_RFS_INODE_FLAG_DIR_INDEX);
+  if (RTEMS_RFS_S_ISREG (mode) && rtems_rfs_fs_extents (fs))
+    rtems_rfs_inode_set_flags (&inode, RTEMS_RFS_INODE_FLAG_EXTENTS);
+
   /*
    * Only handle the specifics of a directory. Let caller handle the others.
    *
@@ -344,7 +565,13 @@ rtems_rfs_inode_delete (rtems_rfs_file_system*  fs,
        * close. Also if there loads is greater then one then other loads
        * active. Forcing the loads count to 0.
        */
-      rc = rtems_rfs_buffer_handle_release (fs, &handle->buffer);
+      if (handle->cache)
+      {
+        rc = rtems_rfs_inode_cache_write (fs, handle);
+        rtems_rfs_inode_cache_put (fs, handle);
+      }
+      else
+        rc = rtems_rfs_buffer_handle_release (fs, &handle->buffer);
       handle->loads = 0;
       handle->node = NULL;
     }
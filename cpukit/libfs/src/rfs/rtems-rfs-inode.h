@@ -94,6 +94,15 @@ typedef uint32_t rtems_rfs_inode_block;
 #define RTEMS_RFS_INODE_DATA_NAME_SIZE \
   (RTEMS_RFS_INODE_BLOCKS * sizeof (rtems_rfs_inode_block))
 
+/**
+ * Inode flags.
+ */
+#define RTEMS_RFS_INODE_FLAG_DIR_INDEX (1 << 0) /**< The directory entries
+                                                 * are placed in blocks by
+                                                 * the hash of the name. */
+#define RTEMS_RFS_INODE_FLAG_EXTENTS   (1 << 1) /**< The block map is a list
+                                                 * of extents. */
+
 /**
  * The inode.
  */
@@ -115,7 +124,7 @@ typedef struct _rtems_rfs_inode
   uint32_t owner;
 
   /**
-   * Reserved.
+   * The inode flags.
    */
   uint16_t flags;
 
@@ -175,6 +184,42 @@ typedef struct _rtems_rfs_inode
  */
 #define RTEMS_RFS_INODE_SIZE (sizeof (rtems_rfs_inode))
 
+/**
+ * RFS Inode Cache Entry. A copy of an inode held in memory so loading the
+ * inode does not need the inode block. Entries are shared by all handles of
+ * an inode and written back to the inode block when a handle that modified
+ * the inode is unloaded.
+ */
+typedef struct _rtems_rfs_inode_cache_entry
+{
+  /**
+   * The node on the hash bucket chain. Must be first so a chain node can be
+   * cast to the entry.
+   */
+  rtems_chain_node hash_link;
+
+  /**
+   * The node on the least recently used chain when not referenced.
+   */
+  rtems_chain_node lru_link;
+
+  /**
+   * The ino of the cached inode.
+   */
+  rtems_rfs_ino ino;
+
+  /**
+   * Number of loaded handles referencing the entry.
+   */
+  int refs;
+
+  /**
+   * The copy of the inode in media byte order.
+   */
+  rtems_rfs_inode node;
+
+} rtems_rfs_inode_cache_entry;
+
 /**
  * RFS Inode Handle.
  */
@@ -196,7 +241,13 @@ typedef struct _rtems_rfs_inode_handle
   rtems_rfs_inode* node;
 
   /**
-   * The buffer that contains this inode.
+   * The inode cache entry the node points to if the inode is cached.
+   */
+  rtems_rfs_inode_cache_entry* cache;
+
+  /**
+   * The buffer that contains this inode. If the inode is cached only the
+   * dirty state is used between the load and the unload.
    */
   rtems_rfs_buffer_handle buffer;
 
@@ -590,6 +641,27 @@ int rtems_rfs_inode_alloc (rtems_rfs_file_system* fs,
 int rtems_rfs_inode_free (rtems_rfs_file_system* fs,
                           rtems_rfs_ino          ino);
 
+/**
+ * Open the inode cache of the file system. The cache is not used if the size
+ * is 0.
+ *
+ * @param[in] fs is the file system data.
+ * @param[in] size is the number of unreferenced inodes to hold.
+ *
+ * @retval 0 Successful operation.
+ * @retval error_code An error occurred.
+ */
+int rtems_rfs_inode_cache_open (rtems_rfs_file_system* fs,
+                                uint32_t               size);
+
+/**
+ * Close the inode cache of the file system freeing the cached inodes. All
+ * inode handles must be closed.
+ *
+ * @param[in] fs is the file system data.
+ */
+void rtems_rfs_inode_cache_close (rtems_rfs_file_system* fs);
+
 /**
  * Open the inode handle. This reads the inode into the buffer and sets the
  * data pointer. All data is in media byte order and needs to be accessed via
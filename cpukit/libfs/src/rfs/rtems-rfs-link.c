@@ -29,6 +29,7 @@
 #include <rtems/rfs/rtems-rfs-trace.h>
 #include <rtems/rfs/rtems-rfs-dir.h>
 #include <rtems/rfs/rtems-rfs-dir-hash.h>
+#include <rtems/rfs/rtems-rfs-file.h>
 #include <rtems/rfs/rtems-rfs-link.h>
 
 int
@@ -189,10 +190,29 @@ rtems_rfs_unlink (rtems_rfs_file_system* fs,
   }
   else
   {
+    rtems_rfs_file_shared* shared;
+
     /*
-     * Erasing the inode releases all blocks attached to it.
+     * Erasing the inode releases all blocks attached to it. Wait for I/O in
+     * progress if the file is open and allocate its delayed blocks so they
+     * are released as well.
      */
+    shared = rtems_rfs_file_get_shared (fs, target);
+    if (shared)
+    {
+      rtems_rfs_mutex_lock (&shared->lock);
+      rc = rtems_rfs_block_map_flush (fs, &shared->map);
+      if (rc > 0)
+      {
+        rtems_rfs_mutex_unlock (&shared->lock);
+        rtems_rfs_inode_close (fs, &parent_inode);
+        rtems_rfs_inode_close (fs, &target_inode);
+        return rc;
+      }
+    }
     rc = rtems_rfs_inode_delete (fs, &target_inode);
+    if (shared)
+      rtems_rfs_mutex_unlock (&shared->lock);
     if (rc > 0)
     {
       if (rtems_rfs_trace (RTEMS_RFS_TRACE_UNLINK))
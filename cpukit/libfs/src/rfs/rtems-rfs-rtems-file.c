@@ -34,6 +34,26 @@
 #include <rtems/rfs/rtems-rfs-file.h>
 #include "rtems-rfs-rtems.h"
 
+/**
+ * Lock an open file. Only the file's data and block map are locked so path
+ * evaluation, stat and I/O to other files do not wait for the request.
+ */
+static inline void
+rtems_rfs_rtems_file_lock (rtems_rfs_file_handle* file)
+{
+  rtems_rfs_file_lock (file);
+}
+
+/**
+ * Unlock an open file.
+ */
+static inline void
+rtems_rfs_rtems_file_unlock (rtems_rfs_file_handle* file)
+{
+  rtems_rfs_buffers_release (rtems_rfs_file_fs (file));
+  rtems_rfs_file_unlock (file);
+}
+
 /**
  * This routine processes the open() system call.  Note that there is nothing
  * special to be done at open() time.
@@ -126,7 +146,7 @@ rtems_rfs_rtems_file_read (rtems_libio_t* iop,
   if (rtems_rfs_rtems_trace (RTEMS_RFS_RTEMS_DEBUG_FILE_READ))
     printf("rtems-rfs: file-read: handle:%p count:%zd\n", file, count);
 
-  rtems_rfs_rtems_lock (rtems_rfs_file_fs (file));
+  rtems_rfs_rtems_file_lock (file);
 
   pos = iop->offset;
 
@@ -167,7 +187,7 @@ rtems_rfs_rtems_file_read (rtems_libio_t* iop,
   if (read >= 0)
     iop->offset = pos + read;
 
-  rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
+  rtems_rfs_rtems_file_unlock (file);
 
   return read;
 }
@@ -195,7 +215,7 @@ rtems_rfs_rtems_file_write (rtems_libio_t* iop,
   if (rtems_rfs_rtems_trace (RTEMS_RFS_RTEMS_DEBUG_FILE_WRITE))
     printf("rtems-rfs: file-write: handle:%p count:%zd\n", file, count);
 
-  rtems_rfs_rtems_lock (rtems_rfs_file_fs (file));
+  rtems_rfs_rtems_file_lock (file);
 
   pos = iop->offset;
   file_size = rtems_rfs_file_size (file);
@@ -209,7 +229,7 @@ rtems_rfs_rtems_file_write (rtems_libio_t* iop,
     rc = rtems_rfs_file_set_size (file, pos);
     if (rc)
     {
-      rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
+      rtems_rfs_rtems_file_unlock (file);
       return rtems_rfs_rtems_error ("file-write: write extend", rc);
     }
 
@@ -221,7 +241,7 @@ rtems_rfs_rtems_file_write (rtems_libio_t* iop,
     rc = rtems_rfs_file_seek (file, pos, &pos);
     if (rc)
     {
-      rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
+      rtems_rfs_rtems_file_unlock (file);
       return rtems_rfs_rtems_error ("file-write: write append seek", rc);
     }
   }
@@ -263,7 +283,7 @@ rtems_rfs_rtems_file_write (rtems_libio_t* iop,
   if (write >= 0)
     iop->offset = pos + write;
 
-  rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
+  rtems_rfs_rtems_file_unlock (file);
 
   return write;
 }
@@ -288,7 +308,7 @@ rtems_rfs_rtems_file_lseek (rtems_libio_t* iop,
   if (rtems_rfs_rtems_trace (RTEMS_RFS_RTEMS_DEBUG_FILE_LSEEK))
     printf("rtems-rfs: file-lseek: handle:%p offset:%" PRIdoff_t "\n", file, offset);
 
-  rtems_rfs_rtems_lock (rtems_rfs_file_fs (file));
+  rtems_rfs_rtems_file_lock (file);
 
   old_offset = iop->offset;
   new_offset = rtems_filesystem_default_lseek_file (iop, offset, whence);
@@ -305,7 +325,7 @@ rtems_rfs_rtems_file_lseek (rtems_libio_t* iop,
     }
   }
 
-  rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
+  rtems_rfs_rtems_file_unlock (file);
 
   return new_offset;
 }
@@ -327,17 +347,44 @@ rtems_rfs_rtems_file_ftruncate (rtems_libio_t* iop,
   if (rtems_rfs_rtems_trace (RTEMS_RFS_RTEMS_DEBUG_FILE_FTRUNC))
     printf("rtems-rfs: file-ftrunc: handle:%p length:%" PRIdoff_t "\n", file, length);
 
-  rtems_rfs_rtems_lock (rtems_rfs_file_fs (file));
+  rtems_rfs_rtems_file_lock (file);
 
   rc = rtems_rfs_file_set_size (file, length);
   if (rc)
     rc = rtems_rfs_rtems_error ("file_ftruncate: set size", rc);
 
-  rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
+  rtems_rfs_rtems_file_unlock (file);
 
   return rc;
 }
 
+/**
+ * This routine processes the fsync() and fdatasync() system calls. The
+ * blocks of the file with a delayed allocation are allocated before the
+ * buffers are synced.
+ *
+ * @param iop
+ * @return int
+ */
+static int
+rtems_rfs_rtems_file_fsync (rtems_libio_t* iop)
+{
+  rtems_rfs_file_handle* file = rtems_rfs_rtems_get_iop_file_handle (iop);
+  int                    rc;
+
+  rtems_rfs_rtems_file_lock (file);
+
+  rc = rtems_rfs_block_map_flush (rtems_rfs_file_fs (file),
+                                  rtems_rfs_file_map (file));
+
+  rtems_rfs_rtems_file_unlock (file);
+
+  if (rc)
+    return rtems_rfs_rtems_error ("file-fsync: flush", rc);
+
+  return rtems_rfs_rtems_fdatasync (iop);
+}
+
 /*
  *  Set of operations handlers for operations on RFS files.
  */
@@ -351,8 +398,8 @@ const rtems_filesystem_file_handlers_r rtems_rfs_rtems_file_handlers = {
   .lseek_h     = rtems_rfs_rtems_file_lseek,
   .fstat_h     = rtems_rfs_rtems_fstat,
   .ftruncate_h = rtems_rfs_rtems_file_ftruncate,
-  .fsync_h     = rtems_rfs_rtems_fdatasync,
-  .fdatasync_h = rtems_rfs_rtems_fdatasync,
+  .fsync_h     = rtems_rfs_rtems_file_fsync,
+  .fdatasync_h = rtems_rfs_rtems_file_fsync,
   .fcntl_h     = rtems_filesystem_default_fcntl,
   .kqfilter_h  = rtems_filesystem_default_kqfilter,
   .poll_h      = rtems_filesystem_default_poll,
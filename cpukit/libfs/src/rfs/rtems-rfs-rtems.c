@@ -332,6 +332,7 @@ rtems_rfs_rtems_chown (const rtems_filesystem_location_info_t *pathloc,
   rtems_rfs_file_system* fs = rtems_rfs_rtems_pathloc_dev (pathloc);
   rtems_rfs_ino          ino = rtems_rfs_rtems_get_pathloc_ino (pathloc);
   rtems_rfs_inode_handle inode;
+  rtems_rfs_file_shared* shared;
 #if defined (RTEMS_POSIX_API)
   uid_t                  uid;
 #endif
@@ -361,9 +362,19 @@ rtems_rfs_rtems_chown (const rtems_filesystem_location_info_t *pathloc,
   }
 #endif
 
+  /*
+   * Wait for I/O in progress if the file is open, the I/O updates the inode
+   * with the file lock held.
+   */
+  shared = rtems_rfs_file_get_shared (fs, ino);
+  if (shared)
+    rtems_rfs_mutex_lock (&shared->lock);
+
   rtems_rfs_inode_set_uid_gid (&inode, owner, group);
 
   rc = rtems_rfs_inode_close (fs, &inode);
+  if (shared)
+    rtems_rfs_mutex_unlock (&shared->lock);
   if (rc)
   {
     return rtems_rfs_rtems_error ("chown: closing inode", rc);
@@ -390,6 +401,7 @@ rtems_rfs_rtems_utime(const rtems_filesystem_location_info_t* pathloc,
   rtems_rfs_file_system* fs = rtems_rfs_rtems_pathloc_dev (pathloc);
   rtems_rfs_ino          ino = rtems_rfs_rtems_get_pathloc_ino (pathloc);
   rtems_rfs_inode_handle inode;
+  rtems_rfs_file_shared* shared;
   int                    rc;
 
   rc = rtems_rfs_inode_open (fs, ino, &inode, true);
@@ -398,10 +410,24 @@ rtems_rfs_rtems_utime(const rtems_filesystem_location_info_t* pathloc,
     return rtems_rfs_rtems_error ("utime: read inode", rc);
   }
 
+  /*
+   * An open file holds the times in memory and writes them back to the inode
+   * on the last close, so set them there too.
+   */
+  shared = rtems_rfs_file_get_shared (fs, ino);
+  if (shared)
+  {
+    rtems_rfs_mutex_lock (&shared->lock);
+    shared->atime = atime;
+    shared->mtime = mtime;
+  }
+
   rtems_rfs_inode_set_atime (&inode, atime);
   rtems_rfs_inode_set_mtime (&inode, mtime);
 
   rc = rtems_rfs_inode_close (fs, &inode);
+  if (shared)
+    rtems_rfs_mutex_unlock (&shared->lock);
   if (rc)
   {
     return rtems_rfs_rtems_error ("utime: closing inode", rc);
@@ -469,6 +495,7 @@ rtems_rfs_rtems_fchmod (const rtems_filesystem_location_info_t* pathloc,
   rtems_rfs_file_system*  fs = rtems_rfs_rtems_pathloc_dev (pathloc);
   rtems_rfs_ino           ino = rtems_rfs_rtems_get_pathloc_ino (pathloc);
   rtems_rfs_inode_handle  inode;
+  rtems_rfs_file_shared*  shared;
   int                     rc;
 
   if (rtems_rfs_rtems_trace (RTEMS_RFS_RTEMS_DEBUG_FCHMOD))
@@ -481,9 +508,19 @@ rtems_rfs_rtems_fchmod (const rtems_filesystem_location_info_t* pathloc,
     return rtems_rfs_rtems_error ("fchmod: opening inode", rc);
   }
 
+  /*
+   * Wait for I/O in progress if the file is open, the I/O updates the inode
+   * with the file lock held.
+   */
+  shared = rtems_rfs_file_get_shared (fs, ino);
+  if (shared)
+    rtems_rfs_mutex_lock (&shared->lock);
+
   rtems_rfs_inode_set_mode (&inode, mode);
 
   rc = rtems_rfs_inode_close (fs, &inode);
+  if (shared)
+    rtems_rfs_mutex_unlock (&shared->lock);
   if (rc > 0)
   {
     return rtems_rfs_rtems_error ("fchmod: closing inode", rc);
@@ -536,6 +573,12 @@ rtems_rfs_rtems_fstat (const rtems_filesystem_location_info_t* pathloc,
 
   if (shared)
   {
+    /*
+     * The file system lock is held. Waiting for the file lock is safe because
+     * the file lock is only held by I/O on the open file and it never takes
+     * the file system lock.
+     */
+    rtems_rfs_mutex_lock (&shared->lock);
     buf->st_atime   = rtems_rfs_file_shared_get_atime (shared);
     buf->st_mtime   = rtems_rfs_file_shared_get_mtime (shared);
     buf->st_ctime   = rtems_rfs_file_shared_get_ctime (shared);
@@ -545,6 +588,7 @@ rtems_rfs_rtems_fstat (const rtems_filesystem_location_info_t* pathloc,
       buf->st_size = rtems_rfs_file_shared_get_block_offset (shared);
     else
       buf->st_size = rtems_rfs_file_shared_get_size (fs, shared);
+    rtems_rfs_mutex_unlock (&shared->lock);
   }
   else
   {
@@ -835,6 +879,7 @@ rtems_rfs_rtems_initialise (rtems_filesystem_mount_table_entry_t* mt_entry,
   rtems_rfs_file_system*   fs;
   uint32_t                 flags = 0;
   uint32_t                 max_held_buffers = RTEMS_RFS_FS_MAX_HELD_BUFFERS;
+  uint32_t                 delayed_blocks = RTEMS_RFS_FS_DELAYED_BLOCKS;
   const char*              options = data;
   int                      rc;
 
@@ -850,11 +895,19 @@ rtems_rfs_rtems_initialise (rtems_filesystem_mount_table_entry_t* mt_entry,
     else if (strncmp (options, "no-local-cache",
                       sizeof ("no-local-cache") - 1) == 0)
       flags |= RTEMS_RFS_FS_NO_LOCAL_CACHE;
+    else if (strncmp (options, "no-inode-cache",
+                      sizeof ("no-inode-cache") - 1) == 0)
+      flags |= RTEMS_RFS_FS_NO_INODE_CACHE;
     else if (strncmp (options, "max-held-bufs",
                       sizeof ("max-held-bufs") - 1) == 0)
     {
       max_held_buffers = strtoul (options + sizeof ("max-held-bufs"), 0, 0);
     }
+    else if (strncmp (options, "delayed-blocks",
+                      sizeof ("delayed-blocks") - 1) == 0)
+    {
+      delayed_blocks = strtoul (options + sizeof ("delayed-blocks"), 0, 0);
+    }
     else
       return rtems_rfs_rtems_error ("initialise: invalid option", EINVAL);
 
@@ -895,6 +948,8 @@ rtems_rfs_rtems_initialise (rtems_filesystem_mount_table_entry_t* mt_entry,
     return rtems_rfs_rtems_error ("initialise: open", errno);
   }
 
+  fs->delayed_blocks = delayed_blocks;
+
   mt_entry->fs_info                          = fs;
   mt_entry->ops                              = &rtems_rfs_ops;
   mt_entry->mt_fs_root->location.node_access = (void*) RTEMS_RFS_ROOT_INO;
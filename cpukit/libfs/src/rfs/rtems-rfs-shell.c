@@ -132,6 +132,7 @@ rtems_rfs_shell_data (rtems_rfs_file_system* fs, int argc, char *argv[])
   printf ("  media block size: %" PRIu32 "\n",   rtems_rfs_fs_media_block_size (fs));
   printf ("        media size: %" PRIu64 "\n",   rtems_rfs_fs_media_size (fs));
   printf ("            inodes: %" PRIu32 "\n",   rtems_rfs_fs_inodes (fs));
+  printf ("          features: %08" PRIx32 "\n",  fs->features);
   printf ("        bad blocks: %" PRIu32 "\n",   fs->bad_blocks);
   printf ("  max. name length: %" PRIu32 "\n",   rtems_rfs_fs_max_name (fs));
   printf ("            groups: %d\n",            fs->group_count);
@@ -142,6 +143,9 @@ rtems_rfs_shell_data (rtems_rfs_file_system* fs, int argc, char *argv[])
   printf ("     singly blocks: %zd\n",           fs->block_map_singly_blocks);
   printf ("    doublly blocks: %zd\n",           fs->block_map_doubly_blocks);
   printf (" max. held buffers: %" PRId32 "\n",   fs->max_held_buffers);
+  printf ("    delayed blocks: %" PRIu32 "\n",   fs->delayed_blocks);
+  printf ("       inode cache: %" PRIu32 "/%" PRIu32 "\n",
+          fs->inode_cache_count, fs->inode_cache_size);
 
   rtems_rfs_shell_lock_rfs (fs);
 
@@ -370,7 +374,7 @@ rtems_rfs_shell_inode (rtems_rfs_file_system* fs, int argc, char *argv[])
       if (!error_check_only || error)
       {
         printf (" %5" PRIu32 ": pos=%06" PRIu32 ":%04zx %c ",
-                ino, rtems_rfs_buffer_bnum (&inode.buffer),
+                ino, inode.block,
                 inode.offset * RTEMS_RFS_INODE_SIZE,
                 allocated ? 'A' : 'F');
 
@@ -711,6 +715,14 @@ rtems_shell_rfs_format (int argc, char* argv[])
           config.initialise_inodes = true;
           break;
 
+        case 'd':
+          config.dir_index = true;
+          break;
+
+        case 'e':
+          config.extents = true;
+          break;
+
         case 'o':
           arg++;
           if (arg >= argc)
@@ -31,9 +31,12 @@
 #include <stdio.h>
 #include <string.h>
 #include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <rtems.h>
 #include <rtems/capture-cli.h>
+#include <rtems/capture-trace.h>
 #include <rtems/monitor.h>
 
 #define RC_UNUSED __attribute__((unused))
@@ -50,6 +53,11 @@ static rtems_capture_timestamp capture_timestamp;
  */
 static volatile int cli_load_thread_active;
 
+/*
+ * The file the trace records are streamed to.
+ */
+static int cli_stream_fd = -1;
+
 /*
  * rtems_capture_cli_open
  *
@@ -1350,8 +1358,6 @@ rtems_capture_cli_trace_records (int                                argc,
   bool                    csv = false;
   static int              dump_total = 22;
   int                     total;
-  int                     count;
-  uint32_t                read;
   rtems_capture_record_t* rec;
   int                     arg;
   rtems_capture_time_t    last_t = 0;
@@ -1387,7 +1393,7 @@ rtems_capture_cli_trace_records (int                                argc,
 
   while (total)
   {
-    sc = rtems_capture_read (0, 0, &read, &rec);
+    sc = rtems_capture_read (0, 0, &rec);
 
     if (sc != RTEMS_SUCCESSFUL)
     {
@@ -1401,66 +1407,69 @@ rtems_capture_cli_trace_records (int                                argc,
      * the reader lock.
      */
 
-    if (read == 0)
+    if (rec == NULL)
     {
-      rtems_capture_release (read);
+      rtems_capture_release (rec);
       break;
     }
 
-    count = total < read ? total : read;
-
-    while (count--)
+    if (csv)
+      fprintf (stdout, "%08" PRIxPTR ",%03" PRIu32
+                 ",%03" PRIu32 ",%04" PRIx32 ",%" PRId64 "\n",
+               (uintptr_t) rec->task,
+               (rec->events >> RTEMS_CAPTURE_REAL_PRIORITY_EVENT) & 0xff,
+               (rec->events >> RTEMS_CAPTURE_CURR_PRIORITY_EVENT) & 0xff,
+               (rec->events >> RTEMS_CAPTURE_EVENT_START),
+               (uint64_t) rec->time);
+    else
     {
-      if (csv)
-        fprintf (stdout, "%08" PRIxPTR ",%03" PRIu32
-                   ",%03" PRIu32 ",%04" PRIx32 ",%" PRId64 "\n",
-                 (uintptr_t) rec->task,
-                 (rec->events >> RTEMS_CAPTURE_REAL_PRIORITY_EVENT) & 0xff,
-                 (rec->events >> RTEMS_CAPTURE_CURR_PRIORITY_EVENT) & 0xff,
-                 (rec->events >> RTEMS_CAPTURE_EVENT_START),
-                 (uint64_t) rec->time);
-      else
-      {
-        uint64_t diff = 0;
-        uint32_t event;
-        int      e;
+      uint64_t diff = 0;
+      uint32_t event;
+      int      e;
 
-        event = rec->events >> RTEMS_CAPTURE_EVENT_START;
+      event = rec->events >> RTEMS_CAPTURE_EVENT_START;
 
-        for (e = RTEMS_CAPTURE_EVENT_START; e < RTEMS_CAPTURE_EVENT_END; e++)
+      for (e = RTEMS_CAPTURE_EVENT_START; e <= RTEMS_CAPTURE_EVENT_END; e++)
+      {
+        if (event & 1)
         {
-          if (event & 1)
+          rtems_capture_cli_print_timestamp (rec->time);
+          if (last_t)
+            diff = rec->time - last_t;
+          last_t = rec->time;
+          fprintf (stdout, " %9" PRId64 " ", diff);
+          if (rec->task)
           {
-            rtems_capture_cli_print_timestamp (rec->time);
-            if (last_t)
-              diff = rec->time - last_t;
-            last_t = rec->time;
-            fprintf (stdout, " %9" PRId64 " ", diff);
             rtems_monitor_dump_id (rtems_capture_task_id (rec->task));
             fprintf (stdout, " %c%c%c%c",
                      (char) (rec->task->name >> 24) & 0xff,
                      (char) (rec->task->name >> 16) & 0xff,
                      (char) (rec->task->name >> 8) & 0xff,
                      (char) (rec->task->name >> 0) & 0xff);
-            fprintf (stdout, " %3" PRId32 " %3" PRId32 " %s\n",
-                    (rec->events >> RTEMS_CAPTURE_REAL_PRIORITY_EVENT) & 0xff,
-                    (rec->events >> RTEMS_CAPTURE_CURR_PRIORITY_EVENT) & 0xff,
-                    rtems_capture_event_text (e));
           }
-          event >>= 1;
+          else
+            fprintf (stdout, "%*s", 13, "");
+          fprintf (stdout, " %3" PRId32 " %3" PRId32 " %s",
+                  (rec->events >> RTEMS_CAPTURE_REAL_PRIORITY_EVENT) & 0xff,
+                  (rec->events >> RTEMS_CAPTURE_CURR_PRIORITY_EVENT) & 0xff,
+                  rtems_capture_event_text (e));
+          if ((1U << e) == RTEMS_CAPTURE_USER_EVENT)
+          {
+            const rtems_capture_user_record_t* user;
+
+            user = rtems_capture_record_payload (rec);
+            fprintf (stdout, " %08" PRIx32 " +%zu",
+                     user->id,
+                     rtems_capture_record_payload_size (rec) - sizeof (*user));
+          }
+          fprintf (stdout, "\n");
         }
+        event >>= 1;
       }
-      rec++;
     }
 
-    count = total < read ? total : read;
-
-    if (count < total)
-      total -= count;
-    else
-      total = 0;
-
-    rtems_capture_release (count);
+    rtems_capture_release (rec);
+    total--;
   }
 }
 
@@ -1507,6 +1516,107 @@ rtems_capture_cli_flush (int                                argc,
            prime ? "primed" : "not primed");
 }
 
+/*
+ * rtems_capture_cli_stream
+ *
+ *  DESCRIPTION:
+ *
+ * This function starts or stops streaming the trace records to a file
+ * in the binary trace format.
+ *
+ */
+
+static const char* stream_usage =
+  "usage: cstream [-p priority] [-t period-usec] file | -s\n";
+
+static void
+rtems_capture_cli_stream (int                                argc,
+                          char**                             argv,
+                          const rtems_monitor_command_arg_t* command_arg RC_UNUSED,
+                          bool                               verbose RC_UNUSED)
+{
+  rtems_task_priority priority = 250;
+  uint32_t            period = 100000;
+  const char*         file = NULL;
+  bool                stop = false;
+  rtems_status_code   sc;
+  int                 arg;
+
+  for (arg = 1; arg < argc; arg++)
+  {
+    if (argv[arg][0] == '-')
+    {
+      if (argv[arg][1] == 's')
+        stop = true;
+      else if ((argv[arg][1] == 'p') && ((arg + 1) < argc))
+        priority = strtoul (argv[++arg], 0, 0);
+      else if ((argv[arg][1] == 't') && ((arg + 1) < argc))
+        period = strtoul (argv[++arg], 0, 0);
+      else
+        fprintf (stdout, "warning: option -%c ignored\n", argv[arg][1]);
+    }
+    else
+      file = argv[arg];
+  }
+
+  if (stop)
+  {
+    uint32_t records = 0;
+
+    sc = rtems_capture_trace_stop (&records);
+
+    if (cli_stream_fd >= 0)
+    {
+      close (cli_stream_fd);
+      cli_stream_fd = -1;
+    }
+
+    if (sc != RTEMS_SUCCESSFUL)
+    {
+      fprintf (stdout, "error: stream stop failed: %s\n",
+               rtems_status_text (sc));
+      return;
+    }
+
+    fprintf (stdout, "trace stream stopped, %" PRIu32 " records written.\n",
+             records);
+    return;
+  }
+
+  if (file == NULL)
+  {
+    fprintf (stdout, stream_usage);
+    return;
+  }
+
+  if (cli_stream_fd >= 0)
+  {
+    fprintf (stdout, "error: trace stream already active\n");
+    return;
+  }
+
+  cli_stream_fd = open (file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+  if (cli_stream_fd < 0)
+  {
+    fprintf (stdout, "error: cannot open %s\n", file);
+    return;
+  }
+
+  sc = rtems_capture_trace_start (cli_stream_fd, priority, period);
+
+  if (sc != RTEMS_SUCCESSFUL)
+  {
+    close (cli_stream_fd);
+    cli_stream_fd = -1;
+    fprintf (stdout, "error: stream start failed: %s\n",
+             rtems_status_text (sc));
+    return;
+  }
+
+  fprintf (stdout, "trace stream to %s started.\n", file);
+}
+
 static rtems_monitor_command_entry_t rtems_capture_cli_cmds[] =
 {
   {
@@ -1644,6 +1754,14 @@ static rtems_monitor_command_entry_t rtems_capture_cli_cmds[] =
     rtems_capture_cli_flush,
     { 0 },
     0
+  },
+  {
+    "cstream",
+    "usage: cstream [-p priority] [-t period-usec] file | -s\n",
+    0,
+    rtems_capture_cli_stream,
+    { 0 },
+    0
   }
 };
 
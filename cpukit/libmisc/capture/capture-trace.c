@@ -0,0 +1,313 @@
+/*
+  ------------------------------------------------------------------------
+
+  The license and distribution terms for this file may be
+  found in the file LICENSE in this distribution or at
+  http://www.rtems.com/license/LICENSE.
+
+  ------------------------------------------------------------------------
+
+  RTEMS Performance Monitoring and Measurement Framework.
+
+  This is the binary trace output stage of the capture engine.
+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/capture-trace.h>
+
+/*
+ * The size of the buffer used to batch the writes of records.
+ */
+#define RTEMS_CAPTURE_TRACE_BUFFER_SIZE (4 * 1024)
+
+/*
+ * The stack size of the drain task. The task writes to a file system
+ * or a socket so the minimum stack size is not enough.
+ */
+#define RTEMS_CAPTURE_TRACE_STACK_SIZE (RTEMS_MINIMUM_STACK_SIZE * 4)
+
+/*
+ * The state of the drain task.
+ */
+static rtems_id          trace_task_id;
+static rtems_id          trace_stopper;
+static volatile bool     trace_stop;
+static bool              trace_error;
+static int               trace_fd;
+static rtems_interval    trace_period;
+static uint32_t          trace_records;
+static uint8_t*          trace_buffer;
+static size_t            trace_level;
+
+/*
+ * rtems_capture_trace_write
+ *
+ *  DESCRIPTION:
+ *
+ * This function writes the data to the file descriptor. Sockets may
+ * accept less than requested so loop until all data is written.
+ */
+static bool
+rtems_capture_trace_write (const void* data, size_t size)
+{
+  const uint8_t* p = data;
+
+  while (size)
+  {
+    ssize_t n = write (trace_fd, p, size);
+
+    if (n < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+
+    p += n;
+    size -= n;
+  }
+
+  return true;
+}
+
+/*
+ * rtems_capture_trace_flush
+ *
+ *  DESCRIPTION:
+ *
+ * This function writes the batched records.
+ */
+static bool
+rtems_capture_trace_flush (void)
+{
+  size_t level = trace_level;
+
+  trace_level = 0;
+
+  return rtems_capture_trace_write (trace_buffer, level);
+}
+
+/*
+ * rtems_capture_trace_append
+ *
+ *  DESCRIPTION:
+ *
+ * This function appends the data to the batch buffer. Data which does
+ * not fit into an empty buffer is written directly.
+ */
+static bool
+rtems_capture_trace_append (const void* data, size_t size)
+{
+  if ((trace_level + size) > RTEMS_CAPTURE_TRACE_BUFFER_SIZE)
+  {
+    if (!rtems_capture_trace_flush ())
+      return false;
+
+    if (size > RTEMS_CAPTURE_TRACE_BUFFER_SIZE)
+      return rtems_capture_trace_write (data, size);
+  }
+
+  memcpy (trace_buffer + trace_level, data, size);
+  trace_level += size;
+
+  return true;
+}
+
+/*
+ * rtems_capture_trace_drain
+ *
+ *  DESCRIPTION:
+ *
+ * This function converts the records of the capture engine to
+ * trace records until the capture engine has no more records. The
+ * capture record is released once it has been copied.
+ */
+static bool
+rtems_capture_trace_drain (void)
+{
+  while (true)
+  {
+    rtems_capture_trace_record_t trec;
+    rtems_capture_record_t*      rec;
+    rtems_status_code            sc;
+    bool                         ok;
+
+    sc = rtems_capture_read (0, 0, &rec);
+
+    /*
+     * Another reader such as the CLI is active. Try again later.
+     */
+    if (sc != RTEMS_SUCCESSFUL)
+      return true;
+
+    if (rec == NULL)
+    {
+      rtems_capture_release (rec);
+      return true;
+    }
+
+    trec.size = sizeof (trec) + rtems_capture_record_payload_size (rec);
+    trec.events = rec->events;
+    trec.id = rec->task ? rtems_capture_task_id (rec->task) : 0;
+    trec.name = rec->task ? rtems_capture_task_name (rec->task) : 0;
+    trec.time = rec->time;
+
+    ok = rtems_capture_trace_append (&trec, sizeof (trec)) &&
+      rtems_capture_trace_append (rtems_capture_record_payload (rec),
+                                  rtems_capture_record_payload_size (rec));
+
+    rtems_capture_release (rec);
+
+    if (!ok)
+      return false;
+
+    trace_records++;
+  }
+}
+
+/*
+ * rtems_capture_trace_task
+ *
+ *  DESCRIPTION:
+ *
+ * This function is the drain task. After a write error the task only
+ * waits to be stopped.
+ */
+static rtems_task
+rtems_capture_trace_task (rtems_task_argument arg)
+{
+  bool ok = true;
+
+  while (!trace_stop)
+  {
+    if (ok)
+      ok = rtems_capture_trace_drain () && rtems_capture_trace_flush ();
+
+    rtems_task_wake_after (trace_period);
+  }
+
+  if (ok)
+    ok = rtems_capture_trace_drain () && rtems_capture_trace_flush ();
+
+  trace_error = !ok;
+
+  rtems_event_transient_send (trace_stopper);
+
+  rtems_task_delete (RTEMS_SELF);
+}
+
+/*
+ * rtems_capture_trace_start
+ *
+ *  DESCRIPTION:
+ *
+ * This function starts the drain task. The header is written in the
+ * context of the caller so a bad file descriptor is reported here.
+ */
+rtems_status_code
+rtems_capture_trace_start (int                 fd,
+                           rtems_task_priority priority,
+                           uint32_t            period)
+{
+  rtems_capture_trace_header_t header;
+  rtems_status_code            sc;
+
+  if (trace_task_id)
+    return RTEMS_RESOURCE_IN_USE;
+
+  trace_buffer = malloc (RTEMS_CAPTURE_TRACE_BUFFER_SIZE);
+
+  if (trace_buffer == NULL)
+    return RTEMS_NO_MEMORY;
+
+  trace_fd = fd;
+  trace_level = 0;
+  trace_records = 0;
+  trace_error = false;
+  trace_stop = false;
+
+  trace_period = RTEMS_MICROSECONDS_TO_TICKS (period);
+  if (trace_period == 0)
+    trace_period = 1;
+
+  header.magic = RTEMS_CAPTURE_TRACE_MAGIC;
+  header.version = RTEMS_CAPTURE_TRACE_VERSION;
+  header.header_size = sizeof (header);
+  header.record_size = sizeof (rtems_capture_trace_record_t);
+
+  if (!rtems_capture_trace_write (&header, sizeof (header)))
+  {
+    sc = RTEMS_IO_ERROR;
+    goto error;
+  }
+
+  sc = rtems_task_create (rtems_build_name ('C', 'T', 'r', 'c'),
+                          priority,
+                          RTEMS_CAPTURE_TRACE_STACK_SIZE,
+                          RTEMS_PREEMPT | RTEMS_NO_TIMESLICE | RTEMS_NO_ASR,
+                          RTEMS_NO_FLOATING_POINT | RTEMS_LOCAL,
+                          &trace_task_id);
+
+  if (sc != RTEMS_SUCCESSFUL)
+    goto error;
+
+  sc = rtems_task_start (trace_task_id, rtems_capture_trace_task, 0);
+
+  if (sc != RTEMS_SUCCESSFUL)
+  {
+    rtems_task_delete (trace_task_id);
+    goto error;
+  }
+
+  return RTEMS_SUCCESSFUL;
+
+error:
+  trace_task_id = 0;
+  free (trace_buffer);
+  trace_buffer = NULL;
+  return sc;
+}
+
+/*
+ * rtems_capture_trace_stop
+ *
+ *  DESCRIPTION:
+ *
+ * This function stops the drain task and waits until it has written
+ * the records left.
+ */
+rtems_status_code
+rtems_capture_trace_stop (uint32_t* records)
+{
+  rtems_status_code sc;
+
+  if (!trace_task_id)
+    return RTEMS_NOT_DEFINED;
+
+  trace_stopper = rtems_task_self ();
+  trace_stop = true;
+
+  sc = rtems_event_transient_receive (RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+
+  if (sc != RTEMS_SUCCESSFUL)
+    return sc;
+
+  trace_task_id = 0;
+  free (trace_buffer);
+  trace_buffer = NULL;
+
+  if (records)
+    *records = trace_records;
+
+  return trace_error ? RTEMS_IO_ERROR : RTEMS_SUCCESSFUL;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file rtems/capture-trace.h
+ *
+ * This is the binary trace output stage of the capture engine.
+ */
+
+/*
+  ------------------------------------------------------------------------
+
+  The license and distribution terms for this file may be
+  found in the file LICENSE in this distribution or at
+  http://www.rtems.com/license/LICENSE.
+
+  ------------------------------------------------------------------------
+
+  RTEMS Performance Monitoring and Measurement Framework.
+
+  A low priority drain task reads the capture records and streams
+  them in a compact binary format to a file descriptor. This may
+  be a file on any file system or a connected socket. The host tool
+  rtems-capture2json converts the stream into the trace event format
+  of the Chrome and Perfetto trace viewers.
+
+  The stream starts with a rtems_capture_trace_header_t. Records
+  follow back to back, each one a rtems_capture_trace_record_t
+  followed by the payload of the capture record. All fields are in
+  the byte order of the target. The host detects the byte order with
+  the magic number of the header. The time is in nano-seconds.
+
+*/
+
+#ifndef __CAPTURE_TRACE_H_
+#define __CAPTURE_TRACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <rtems/capture.h>
+
+/**
+ * The magic number and version of the trace stream.
+ */
+#define RTEMS_CAPTURE_TRACE_MAGIC   UINT32_C (0x52544354)
+#define RTEMS_CAPTURE_TRACE_VERSION UINT32_C (1)
+
+/**
+ * rtems_capture_trace_header_t
+ *
+ *  DESCRIPTION:
+ *
+ * The header at the start of a trace stream. The sizes allow a decoder
+ * to skip fields added by later versions.
+ */
+typedef struct rtems_capture_trace_header_s
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t header_size;
+  uint32_t record_size;
+} rtems_capture_trace_header_t;
+
+/**
+ * rtems_capture_trace_record_t
+ *
+ *  DESCRIPTION:
+ *
+ * A record of the trace stream. The size is the size of the record
+ * including the payload which directly follows it. The events are the
+ * events of the capture record. The task identifier and name are zero
+ * if the record has no task.
+ */
+typedef struct rtems_capture_trace_record_s
+{
+  uint32_t size;
+  uint32_t events;
+  uint32_t id;
+  uint32_t name;
+  uint64_t time;
+} rtems_capture_trace_record_t;
+
+/**
+ * rtems_capture_trace_start
+ *
+ *  DESCRIPTION:
+ *
+ * This function starts the drain task which streams the capture records
+ * to the file descriptor. The capture engine must be open. The drain
+ * task runs at the priority and polls the capture engine each period
+ * in micro-seconds when there are no records. The file descriptor is
+ * not closed by the trace output stage.
+ */
+rtems_status_code
+rtems_capture_trace_start (int                 fd,
+                           rtems_task_priority priority,
+                           uint32_t            period);
+
+/**
+ * rtems_capture_trace_stop
+ *
+ *  DESCRIPTION:
+ *
+ * This function writes the records left in the capture engine and
+ * stops the drain task. Stop the trace output before the capture
+ * engine is closed. The number of records written is returned if
+ * records is not NULL. A write error is reported as RTEMS_IO_ERROR.
+ */
+rtems_status_code
+rtems_capture_trace_stop (uint32_t* records);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
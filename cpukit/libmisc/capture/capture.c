@@ -31,6 +31,7 @@
 
 #include "capture.h"
 
+#include <rtems/score/atomic.h>
 #include <rtems/score/statesimpl.h>
 #include <rtems/score/todimpl.h>
 
@@ -61,22 +62,92 @@
  */
 #define RTEMS_CAPTURE_ON             (1U << 0)
 #define RTEMS_CAPTURE_NO_MEMORY      (1U << 1)
-#define RTEMS_CAPTURE_OVERFLOW       (1U << 2)
 #define RTEMS_CAPTURE_TRIGGERED      (1U << 3)
 #define RTEMS_CAPTURE_READER_ACTIVE  (1U << 4)
 #define RTEMS_CAPTURE_READER_WAITING (1U << 5)
 #define RTEMS_CAPTURE_GLOBAL_WATCH   (1U << 6)
 #define RTEMS_CAPTURE_ONLY_MONITOR   (1U << 7)
 
+/*
+ * Records are aligned so that the time stamp in the record header is
+ * naturally aligned.
+ */
+#define RTEMS_CAPTURE_RECORD_ALIGNMENT sizeof (rtems_capture_time_t)
+#define RTEMS_CAPTURE_RECORD_ALIGN(_s) \
+  (((_s) + RTEMS_CAPTURE_RECORD_ALIGNMENT - 1) & \
+   ~(RTEMS_CAPTURE_RECORD_ALIGNMENT - 1))
+
+/*
+ * The capture buffers are per processor, so it is sufficient to disable
+ * interrupts on the current processor to append a record. This may be
+ * done without the giant lock.
+ */
+#if defined (RTEMS_SMP)
+#define rtems_capture_isr_disable(_level) _ISR_Disable_without_giant (_level)
+#define rtems_capture_isr_enable(_level)  _ISR_Enable_without_giant (_level)
+#else
+#define rtems_capture_isr_disable(_level) _ISR_Disable (_level)
+#define rtems_capture_isr_enable(_level)  _ISR_Enable (_level)
+#endif
+
+/*
+ * The capture reader polls the capture buffers with this period in
+ * ticks while it waits for records. Context switches do not wake the
+ * reader, so the poll picks up the records of the switch events.
+ */
+#define RTEMS_CAPTURE_READER_POLL_TICKS (1)
+
+/*
+ * The capture buffer of a processor. Only the owning processor appends
+ * records and only the reader removes them. The lock protects the in and
+ * out positions, the count and the overflows, it is only contended by
+ * the reader. The
+ * in and out positions are free running byte counters, the buffer size is
+ * a power of two. A record never wraps the end of the buffer, the space
+ * left at the end is skipped by the reader.
+ */
+typedef struct rtems_capture_per_cpu_s
+{
+  rtems_interrupt_lock lock;
+  uint8_t*             buffer;
+  uint32_t             size;
+  uint32_t             in;
+  uint32_t             out;
+  uint32_t             count;
+  uint32_t             released;
+  uint32_t             overflows;
+} rtems_capture_per_cpu_t;
+
+/*
+ * The state of a record being appended to a capture buffer.
+ */
+typedef struct rtems_capture_record_context_s
+{
+  rtems_capture_per_cpu_t*     cpu;
+  uint32_t                     in;
+  ISR_Level                    level;
+  rtems_interrupt_lock_context lock_context;
+} rtems_capture_record_context_t;
+
+/*
+ * The capture task with the count of the records referencing it. Records
+ * are written on all processors so the count is atomic.
+ */
+typedef struct rtems_capture_task_private_s
+{
+  rtems_capture_task_t task;
+  Atomic_Uint          refcount;
+} rtems_capture_task_private_t;
+
 /*
  * RTEMS Capture Data.
  */
-static rtems_capture_record_t*  capture_records;
-static uint32_t                 capture_size;
-static uint32_t                 capture_count;
-static rtems_capture_record_t*  capture_in;
-static uint32_t                 capture_out;
-static uint32_t                 capture_flags;
+static rtems_capture_per_cpu_t* capture_per_cpu;
+static uint32_t                 capture_cpu_count;
+static uint32_t                 capture_reader_cpu;
+static Atomic_Uint              capture_flags;
+static uint32_t                 capture_reader_threshold;
+static rtems_id                 capture_reader;
 static rtems_capture_task_t*    capture_tasks;
 static rtems_capture_control_t* capture_controls;
 static int                      capture_extension_index;
@@ -84,7 +155,6 @@ static rtems_id                 capture_id;
 static rtems_capture_timestamp  capture_timestamp;
 static rtems_task_priority      capture_ceiling;
 static rtems_task_priority      capture_floor;
-static rtems_id                 capture_reader;
 
 /*
  * RTEMS Event text.
@@ -103,7 +173,8 @@ static const char* capture_event_text[] =
   "EXITTED",
   "SWITCHED_OUT",
   "SWITCHED_IN",
-  "TIMESTAMP"
+  "TIMESTAMP",
+  "USER"
 };
 
 /*
@@ -261,7 +332,9 @@ rtems_capture_by_in_to (uint32_t                 events,
 static inline void
 rtems_capture_refcount_up (rtems_capture_task_t* task)
 {
-  task->refcount++;
+  rtems_capture_task_private_t* tp = (rtems_capture_task_private_t*) task;
+
+  _Atomic_Fetch_add_uint (&tp->refcount, 1, ATOMIC_ORDER_RELAXED);
 }
 
 /*
@@ -276,8 +349,75 @@ rtems_capture_refcount_up (rtems_capture_task_t* task)
 static inline void
 rtems_capture_refcount_down (rtems_capture_task_t* task)
 {
-  if (task->refcount)
-    task->refcount--;
+  rtems_capture_task_private_t* tp = (rtems_capture_task_private_t*) task;
+  unsigned int                  refcount;
+
+  refcount = _Atomic_Load_uint (&tp->refcount, ATOMIC_ORDER_RELAXED);
+
+  while (refcount &&
+         !_Atomic_Compare_exchange_uint (&tp->refcount, &refcount,
+                                         refcount - 1,
+                                         ATOMIC_ORDER_RELEASE,
+                                         ATOMIC_ORDER_RELAXED))
+    ;
+}
+
+/*
+ * rtems_capture_refcount
+ *
+ *  DESCRIPTION:
+ *
+ * This function returns the reference count.
+ *
+ */
+static inline uint32_t
+rtems_capture_refcount (rtems_capture_task_t* task)
+{
+  rtems_capture_task_private_t* tp = (rtems_capture_task_private_t*) task;
+
+  return _Atomic_Load_uint (&tp->refcount, ATOMIC_ORDER_ACQUIRE);
+}
+
+/*
+ * rtems_capture_get_flags
+ *
+ *  DESCRIPTION:
+ *
+ * This function returns the capture flags.
+ *
+ */
+static inline uint32_t
+rtems_capture_get_flags (void)
+{
+  return _Atomic_Load_uint (&capture_flags, ATOMIC_ORDER_RELAXED);
+}
+
+/*
+ * rtems_capture_set_flags
+ *
+ *  DESCRIPTION:
+ *
+ * This function sets capture flags and returns the previous flags.
+ *
+ */
+static uint32_t
+rtems_capture_set_flags (uint32_t flags)
+{
+  return _Atomic_Fetch_or_uint (&capture_flags, flags, ATOMIC_ORDER_ACQUIRE);
+}
+
+/*
+ * rtems_capture_clear_flags
+ *
+ *  DESCRIPTION:
+ *
+ * This function clears capture flags and returns the previous flags.
+ *
+ */
+static uint32_t
+rtems_capture_clear_flags (uint32_t flags)
+{
+  return _Atomic_Fetch_and_uint (&capture_flags, ~flags, ATOMIC_ORDER_RELEASE);
 }
 
 /*
@@ -350,7 +490,7 @@ rtems_capture_create_control (rtems_name name, rtems_id id)
 
     if (!ok)
     {
-      capture_flags |= RTEMS_CAPTURE_NO_MEMORY;
+      rtems_capture_set_flags (RTEMS_CAPTURE_NO_MEMORY);
       return NULL;
     }
 
@@ -393,21 +533,25 @@ rtems_capture_create_control (rtems_name name, rtems_id id)
 static inline rtems_capture_task_t*
 rtems_capture_create_capture_task (rtems_tcb* new_task)
 {
-  rtems_interrupt_level    level;
-  rtems_capture_task_t*    task;
-  rtems_capture_control_t* control;
-  rtems_name               name;
-  rtems_capture_time_t     time;
-  bool                     ok;
+  rtems_interrupt_level         level;
+  rtems_capture_task_private_t* tp;
+  rtems_capture_task_t*         task;
+  rtems_capture_control_t*      control;
+  rtems_name                    name;
+  rtems_capture_time_t          time;
+  bool                          ok;
 
-  ok = rtems_workspace_allocate (sizeof (*task), (void **) &task);
+  ok = rtems_workspace_allocate (sizeof (*tp), (void **) &tp);
 
   if (!ok)
   {
-    capture_flags |= RTEMS_CAPTURE_NO_MEMORY;
+    rtems_capture_set_flags (RTEMS_CAPTURE_NO_MEMORY);
     return NULL;
   }
 
+  task = &tp->task;
+  _Atomic_Init_uint (&tp->refcount, 0);
+
   /*
    * Get the current time.
    */
@@ -424,7 +568,6 @@ rtems_capture_create_capture_task (rtems_tcb* new_task)
   task->id               = new_task->Object.id;
   task->flags            = 0;
   task->in               = 0;
-  task->refcount         = 0;
   task->out              = 0;
   task->tcb              = new_task;
   task->time             = 0;
@@ -482,7 +625,7 @@ rtems_capture_destroy_capture_task (rtems_capture_task_t* task)
 
     rtems_interrupt_disable (level);
 
-    if (task->tcb || task->refcount)
+    if (task->tcb || rtems_capture_refcount (task))
       task = 0;
 
     if (task)
@@ -501,6 +644,223 @@ rtems_capture_destroy_capture_task (rtems_capture_task_t* task)
   }
 }
 
+/*
+ * rtems_capture_record_open
+ *
+ *  DESCRIPTION:
+ *
+ * This function opens a record of the specified size in the capture
+ * buffer of the current processor. Interrupts are disabled on this
+ * processor until the record is closed. The payload of the record
+ * must be filled in before the record is closed. A NULL pointer is
+ * returned if the buffer has no space left for the record.
+ *
+ */
+static rtems_capture_record_t*
+rtems_capture_record_open (rtems_capture_task_t*           task,
+                           uint32_t                        events,
+                           size_t                          size,
+                           rtems_capture_record_context_t* context)
+{
+  rtems_capture_per_cpu_t* cpu;
+  rtems_capture_record_t*  rec;
+  uint32_t                 in;
+  uint32_t                 out;
+  uint32_t                 offset;
+  uint32_t                 left;
+  uint32_t                 length;
+
+  rtems_capture_isr_disable (context->level);
+
+  cpu = &capture_per_cpu[_SMP_Get_current_processor ()];
+  rtems_interrupt_lock_acquire_isr (&cpu->lock, &context->lock_context);
+  in = cpu->in;
+  out = cpu->out;
+  offset = in & (cpu->size - 1);
+  left = cpu->size - offset;
+  length = RTEMS_CAPTURE_RECORD_ALIGN (size);
+
+  /*
+   * A record must be contiguous, so skip the space left at the end of
+   * the buffer if the record does not fit into it.
+   */
+  if (left >= length)
+    left = 0;
+
+  if ((in + left + length - out) > cpu->size)
+  {
+    cpu->overflows++;
+    rtems_interrupt_lock_release_isr (&cpu->lock, &context->lock_context);
+    rtems_capture_isr_enable (context->level);
+    return NULL;
+  }
+
+  if (left >= sizeof (*rec))
+  {
+    rec = (rtems_capture_record_t*) &cpu->buffer[offset];
+    rec->size   = left;
+    rec->events = 0;
+  }
+
+  in += left;
+  rec = (rtems_capture_record_t*) &cpu->buffer[in & (cpu->size - 1)];
+  rec->size   = size;
+  rec->events = events;
+  rec->task   = task;
+  rtems_capture_get_time (&rec->time);
+
+  if (task)
+    rtems_capture_refcount_up (task);
+
+  context->cpu = cpu;
+  context->in  = in + length;
+
+  return rec;
+}
+
+/*
+ * rtems_capture_record_close
+ *
+ *  DESCRIPTION:
+ *
+ * This function makes the record visible to the reader and enables
+ * interrupts again.
+ *
+ */
+static void
+rtems_capture_record_close (rtems_capture_record_context_t* context)
+{
+  rtems_capture_per_cpu_t* cpu = context->cpu;
+
+  cpu->count++;
+  cpu->in = context->in;
+
+  rtems_interrupt_lock_release_isr (&cpu->lock, &context->lock_context);
+  rtems_capture_isr_enable (context->level);
+}
+
+/*
+ * rtems_capture_per_cpu_next
+ *
+ *  DESCRIPTION:
+ *
+ * This function returns the oldest record of a processor capture buffer
+ * or NULL if the buffer is empty. The space skipped at the end of the
+ * buffer is released.
+ *
+ */
+static rtems_capture_record_t*
+rtems_capture_per_cpu_next (rtems_capture_per_cpu_t* cpu)
+{
+  rtems_capture_record_t*      rec = NULL;
+  rtems_interrupt_lock_context lock_context;
+  uint32_t                     in;
+  uint32_t                     out;
+
+  rtems_interrupt_lock_acquire (&cpu->lock, &lock_context);
+  in = cpu->in;
+  out = cpu->out;
+  rtems_interrupt_lock_release (&cpu->lock, &lock_context);
+
+  while (out != in)
+  {
+    uint32_t offset = out & (cpu->size - 1);
+    uint32_t left = cpu->size - offset;
+
+    if (left >= sizeof (*rec))
+    {
+      rec = (rtems_capture_record_t*) &cpu->buffer[offset];
+
+      if (rec->events != 0)
+        break;
+
+      rec = NULL;
+    }
+
+    out += left;
+  }
+
+  rtems_interrupt_lock_acquire (&cpu->lock, &lock_context);
+  cpu->out = out;
+  rtems_interrupt_lock_release (&cpu->lock, &lock_context);
+
+  return rec;
+}
+
+/*
+ * rtems_capture_per_cpu_consume
+ *
+ *  DESCRIPTION:
+ *
+ * This function removes the oldest record from a processor capture
+ * buffer. The record space may be reused immediately.
+ *
+ */
+static void
+rtems_capture_per_cpu_consume (rtems_capture_per_cpu_t* cpu,
+                               rtems_capture_record_t*  rec)
+{
+  rtems_interrupt_lock_context lock_context;
+  uint32_t                     size = RTEMS_CAPTURE_RECORD_ALIGN (rec->size);
+
+  rtems_interrupt_lock_acquire (&cpu->lock, &lock_context);
+  cpu->out += size;
+  cpu->released++;
+  rtems_interrupt_lock_release (&cpu->lock, &lock_context);
+}
+
+/*
+ * rtems_capture_count
+ *
+ *  DESCRIPTION:
+ *
+ * This function returns the number of records in the capture buffers.
+ *
+ */
+static uint32_t
+rtems_capture_count (void)
+{
+  uint32_t count = 0;
+  uint32_t cpu;
+
+  for (cpu = 0; cpu < capture_cpu_count; cpu++)
+  {
+    rtems_capture_per_cpu_t*     per_cpu = &capture_per_cpu[cpu];
+    rtems_interrupt_lock_context lock_context;
+
+    rtems_interrupt_lock_acquire (&per_cpu->lock, &lock_context);
+    count += per_cpu->count - per_cpu->released;
+    rtems_interrupt_lock_release (&per_cpu->lock, &lock_context);
+  }
+
+  return count;
+}
+
+/*
+ * rtems_capture_wake_reader
+ *
+ *  DESCRIPTION:
+ *
+ * This function wakes up a reader blocked in rtems_capture_read once the
+ * buffers hold the number of records it waits for. It must be called
+ * with no capture buffer lock held. It must not be called from the
+ * thread switch extension, the reader polls for the switch records.
+ *
+ */
+static void
+rtems_capture_wake_reader (void)
+{
+  if ((rtems_capture_get_flags () & RTEMS_CAPTURE_READER_WAITING) == 0)
+    return;
+
+  if (rtems_capture_count () < capture_reader_threshold)
+    return;
+
+  if (rtems_capture_clear_flags (RTEMS_CAPTURE_READER_WAITING) &
+      RTEMS_CAPTURE_READER_WAITING)
+    rtems_event_send (capture_reader, RTEMS_EVENT_0);
+}
+
 /*
  * rtems_capture_record
  *
@@ -518,7 +878,7 @@ rtems_capture_record (rtems_capture_task_t* task,
    * the task's real priority is lower or equal to the ceiling.
    */
   if (task &&
-      ((capture_flags &
+      ((rtems_capture_get_flags () &
         (RTEMS_CAPTURE_TRIGGERED | RTEMS_CAPTURE_ONLY_MONITOR)) ==
        RTEMS_CAPTURE_TRIGGERED))
   {
@@ -535,36 +895,26 @@ rtems_capture_record (rtems_capture_task_t* task,
     if ((events & RTEMS_CAPTURE_RECORD_EVENTS) ||
         ((task->tcb->real_priority >= capture_ceiling) &&
          (task->tcb->real_priority <= capture_floor) &&
-         ((capture_flags & RTEMS_CAPTURE_GLOBAL_WATCH) ||
+         ((rtems_capture_get_flags () & RTEMS_CAPTURE_GLOBAL_WATCH) ||
           (control && (control->flags & RTEMS_CAPTURE_WATCH)))))
     {
-      rtems_interrupt_level level;
+      rtems_capture_record_context_t context;
+      rtems_capture_record_t*        rec;
 
-      rtems_interrupt_disable (level);
+      rec = rtems_capture_record_open (task,
+                                       (events |
+                                        (task->tcb->real_priority) |
+                                        (task->tcb->current_priority << 8)),
+                                       sizeof (*rec),
+                                       &context);
 
-      if (capture_count < capture_size)
+      if (rec)
       {
-        capture_count++;
-        capture_in->task   = task;
-        capture_in->events = (events |
-                              (task->tcb->real_priority) |
-                              (task->tcb->current_priority << 8));
-
         if ((events & RTEMS_CAPTURE_RECORD_EVENTS) == 0)
           task->flags |= RTEMS_CAPTURE_TRACED;
 
-        rtems_capture_get_time (&capture_in->time);
-
-        if (capture_in == &capture_records[capture_size - 1])
-          capture_in = capture_records;
-        else
-          capture_in++;
-
-        rtems_capture_refcount_up (task);
+        rtems_capture_record_close (&context);
       }
-      else
-        capture_flags |= RTEMS_CAPTURE_OVERFLOW;
-      rtems_interrupt_enable (level);
     }
   }
 }
@@ -585,7 +935,7 @@ rtems_capture_trigger (rtems_capture_task_t* ft,
   /*
    * If we have not triggered then see if this is a trigger condition.
    */
-  if (!(capture_flags & RTEMS_CAPTURE_TRIGGERED))
+  if (!(rtems_capture_get_flags () & RTEMS_CAPTURE_TRIGGERED))
   {
     rtems_capture_control_t* fc = NULL;
     rtems_capture_control_t* tc = NULL;
@@ -620,7 +970,7 @@ rtems_capture_trigger (rtems_capture_task_t* ft,
      */
     if (from_events || to_events)
     {
-      capture_flags |= RTEMS_CAPTURE_TRIGGERED;
+      rtems_capture_set_flags (RTEMS_CAPTURE_TRIGGERED);
       return 1;
     }
 
@@ -631,7 +981,7 @@ rtems_capture_trigger (rtems_capture_task_t* ft,
     {
       if (rtems_capture_by_in_to (events, ft, tc))
       {
-        capture_flags |= RTEMS_CAPTURE_TRIGGERED;
+        rtems_capture_set_flags (RTEMS_CAPTURE_TRIGGERED);
         return 1;
       }
     }
@@ -676,6 +1026,7 @@ rtems_capture_create_task (rtems_tcb* current_task,
   {
     rtems_capture_record (ct, RTEMS_CAPTURE_CREATED_BY_EVENT);
     rtems_capture_record (nt, RTEMS_CAPTURE_CREATED_EVENT);
+    rtems_capture_wake_reader ();
   }
 
   return 1 == 1;
@@ -718,6 +1069,7 @@ rtems_capture_start_task (rtems_tcb* current_task,
   {
     rtems_capture_record (ct, RTEMS_CAPTURE_STARTED_BY_EVENT);
     rtems_capture_record (st, RTEMS_CAPTURE_STARTED_EVENT);
+    rtems_capture_wake_reader ();
   }
 
   rtems_capture_init_stack_usage (st);
@@ -760,6 +1112,7 @@ rtems_capture_restart_task (rtems_tcb* current_task,
   {
     rtems_capture_record (ct, RTEMS_CAPTURE_RESTARTED_BY_EVENT);
     rtems_capture_record (rt, RTEMS_CAPTURE_RESTARTED_EVENT);
+    rtems_capture_wake_reader ();
   }
 
   rtems_capture_task_stack_usage (rt);
@@ -803,6 +1156,7 @@ rtems_capture_delete_task (rtems_tcb* current_task,
   {
     rtems_capture_record (ct, RTEMS_CAPTURE_DELETED_BY_EVENT);
     rtems_capture_record (dt, RTEMS_CAPTURE_DELETED_EVENT);
+    rtems_capture_wake_reader ();
   }
 
   rtems_capture_task_stack_usage (dt);
@@ -844,7 +1198,10 @@ rtems_capture_begin_task (rtems_tcb* begin_task)
     bt = rtems_capture_create_capture_task (begin_task);
 
   if (rtems_capture_trigger (NULL, bt, RTEMS_CAPTURE_BEGIN))
+  {
     rtems_capture_record (bt, RTEMS_CAPTURE_BEGIN_EVENT);
+    rtems_capture_wake_reader ();
+  }
 }
 
 /*
@@ -876,7 +1233,10 @@ rtems_capture_exitted_task (rtems_tcb* exitted_task)
     et = rtems_capture_create_capture_task (exitted_task);
 
   if (rtems_capture_trigger (NULL, et, RTEMS_CAPTURE_EXITTED))
+  {
     rtems_capture_record (et, RTEMS_CAPTURE_EXITTED_EVENT);
+    rtems_capture_wake_reader ();
+  }
 
   rtems_capture_task_stack_usage (et);
 }
@@ -897,7 +1257,7 @@ rtems_capture_switch_task (rtems_tcb* current_task,
    * Only perform context switch trace processing if tracing is
    * enabled.
    */
-  if (capture_flags & RTEMS_CAPTURE_ON)
+  if (rtems_capture_get_flags () & RTEMS_CAPTURE_ON)
   {
     rtems_capture_time_t time;
 
@@ -965,39 +1325,94 @@ rtems_capture_switch_task (rtems_tcb* current_task,
   }
 }
 
+/*
+ * rtems_capture_free_buffers
+ *
+ *  DESCRIPTION:
+ *
+ * This function releases the capture buffers of the processors.
+ *
+ */
+static void
+rtems_capture_free_buffers (rtems_capture_per_cpu_t* per_cpu,
+                            uint32_t                 cpu_count)
+{
+  uint32_t cpu;
+
+  for (cpu = 0; cpu < cpu_count; cpu++)
+  {
+    rtems_interrupt_lock_destroy (&per_cpu[cpu].lock);
+    free (per_cpu[cpu].buffer);
+  }
+
+  free (per_cpu);
+}
+
 /*
  * rtems_capture_open
  *
  *  DESCRIPTION:
  *
  * This function initialises the realtime capture engine allocating the trace
- * buffer. It is assumed we have a working heap at stage of initialisation.
+ * buffers. Each processor has a buffer large enough for size records
+ * without payload. It is assumed we have a working heap at stage of
+ * initialisation.
  *
  */
 rtems_status_code
 rtems_capture_open (uint32_t   size, rtems_capture_timestamp timestamp __attribute__((unused)))
 {
-  rtems_extensions_table capture_extensions;
-  rtems_name             name;
-  rtems_status_code      sc;
+  rtems_extensions_table   capture_extensions;
+  rtems_name               name;
+  rtems_status_code        sc;
+  rtems_capture_per_cpu_t* per_cpu;
+  uint32_t                 cpu_count;
+  uint32_t                 bytes;
+  uint32_t                 cpu;
 
   /*
    * See if the capture engine is already open.
    */
 
-  if (capture_records)
+  if (capture_per_cpu)
     return RTEMS_RESOURCE_IN_USE;
 
-  capture_records = malloc (size * sizeof (rtems_capture_record_t));
+  /*
+   * The buffer size is a power of two so that the free running
+   * positions can be masked.
+   */
+  bytes = RTEMS_CAPTURE_RECORD_ALIGNMENT;
+  while (bytes < (size * RTEMS_CAPTURE_RECORD_ALIGN (sizeof (rtems_capture_record_t))))
+    bytes <<= 1;
+
+  cpu_count = rtems_smp_get_processor_count ();
+  per_cpu = calloc (cpu_count, sizeof (*per_cpu));
 
-  if (capture_records == NULL)
+  if (per_cpu == NULL)
     return RTEMS_NO_MEMORY;
 
-  capture_size    = size;
-  capture_count   = 0;
-  capture_in      = capture_records;
-  capture_out     = 0;
-  capture_flags   = 0;
+  for (cpu = 0; cpu < cpu_count; cpu++)
+  {
+    rtems_interrupt_lock_initialize (&per_cpu[cpu].lock);
+    per_cpu[cpu].buffer = malloc (bytes);
+
+    if (per_cpu[cpu].buffer == NULL)
+    {
+      rtems_capture_free_buffers (per_cpu, cpu_count);
+      return RTEMS_NO_MEMORY;
+    }
+
+    per_cpu[cpu].size = bytes;
+    per_cpu[cpu].in = 0;
+    per_cpu[cpu].out = 0;
+    per_cpu[cpu].count = 0;
+    per_cpu[cpu].released = 0;
+    per_cpu[cpu].overflows = 0;
+  }
+
+  capture_per_cpu   = per_cpu;
+  capture_cpu_count = cpu_count;
+  _Atomic_Store_uint (&capture_flags, 0, ATOMIC_ORDER_RELAXED);
   capture_tasks   = NULL;
   capture_ceiling = 0;
   capture_floor   = 255;
@@ -1024,8 +1439,8 @@ rtems_capture_open (uint32_t   size, rtems_capture_timestamp timestamp __attribu
   if (sc != RTEMS_SUCCESSFUL)
   {
     capture_id = 0;
-    free (capture_records);
-    capture_records = NULL;
+    capture_per_cpu = NULL;
+    rtems_capture_free_buffers (per_cpu, cpu_count);
   }
   else
   {
@@ -1053,19 +1468,21 @@ rtems_capture_close (void)
   rtems_interrupt_level    level;
   rtems_capture_task_t*    task;
   rtems_capture_control_t* control;
+  rtems_capture_per_cpu_t* per_cpu;
   rtems_status_code        sc;
 
   rtems_interrupt_disable (level);
 
-  if (!capture_records)
+  if (!capture_per_cpu)
   {
     rtems_interrupt_enable (level);
     return RTEMS_SUCCESSFUL;
   }
 
-  capture_flags &= ~(RTEMS_CAPTURE_ON | RTEMS_CAPTURE_ONLY_MONITOR);
+  rtems_capture_clear_flags (RTEMS_CAPTURE_ON | RTEMS_CAPTURE_ONLY_MONITOR);
 
-  capture_records = NULL;
+  per_cpu = capture_per_cpu;
+  capture_per_cpu = NULL;
 
   rtems_interrupt_enable (level);
 
@@ -1101,11 +1518,8 @@ rtems_capture_close (void)
 
   capture_controls = NULL;
 
-  if (capture_records)
-  {
-    free (capture_records);
-    capture_records = NULL;
-  }
+  rtems_capture_free_buffers (per_cpu, capture_cpu_count);
+  capture_cpu_count = 0;
 
   return RTEMS_SUCCESSFUL;
 }
@@ -1130,16 +1544,16 @@ rtems_capture_control (bool enable)
 
   rtems_interrupt_disable (level);
 
-  if (!capture_records)
+  if (!capture_per_cpu)
   {
     rtems_interrupt_enable (level);
     return RTEMS_UNSATISFIED;
   }
 
   if (enable)
-    capture_flags |= RTEMS_CAPTURE_ON;
+    rtems_capture_set_flags (RTEMS_CAPTURE_ON);
   else
-    capture_flags &= ~RTEMS_CAPTURE_ON;
+    rtems_capture_clear_flags (RTEMS_CAPTURE_ON);
 
   rtems_iterate_over_all_threads (rtems_capture_task_setup);
 
@@ -1164,16 +1578,16 @@ rtems_capture_monitor (bool enable)
 
   rtems_interrupt_disable (level);
 
-  if (!capture_records)
+  if (!capture_per_cpu)
   {
     rtems_interrupt_enable (level);
     return RTEMS_UNSATISFIED;
   }
 
   if (enable)
-    capture_flags |= RTEMS_CAPTURE_ONLY_MONITOR;
+    rtems_capture_set_flags (RTEMS_CAPTURE_ONLY_MONITOR);
   else
-    capture_flags &= ~RTEMS_CAPTURE_ONLY_MONITOR;
+    rtems_capture_clear_flags (RTEMS_CAPTURE_ONLY_MONITOR);
 
   rtems_interrupt_enable (level);
 
@@ -1191,28 +1605,45 @@ rtems_capture_monitor (bool enable)
 rtems_status_code
 rtems_capture_flush (bool prime)
 {
-  rtems_interrupt_level level;
-  rtems_capture_task_t* task;
+  rtems_interrupt_level   level;
+  rtems_capture_task_t*   task;
+  rtems_capture_record_t* rec;
+  uint32_t                cpu;
 
   rtems_interrupt_disable (level);
 
   for (task = capture_tasks; task != NULL; task = task->forw)
-  {
     task->flags &= ~RTEMS_CAPTURE_TRACED;
-    task->refcount = 0;
-  }
 
   if (prime)
-    capture_flags &= ~(RTEMS_CAPTURE_TRIGGERED | RTEMS_CAPTURE_OVERFLOW);
-  else
-    capture_flags &= ~RTEMS_CAPTURE_OVERFLOW;
-
-  capture_count = 0;
-  capture_in    = capture_records;
-  capture_out   = 0;
+    rtems_capture_clear_flags (RTEMS_CAPTURE_TRIGGERED);
 
   rtems_interrupt_enable (level);
 
+  /*
+   * The buffers are drained like the reader does since the processors
+   * may append records concurrently.
+   */
+  for (cpu = 0; cpu < capture_cpu_count; cpu++)
+  {
+    rtems_capture_per_cpu_t*     per_cpu = &capture_per_cpu[cpu];
+    rtems_interrupt_lock_context lock_context;
+
+    rtems_interrupt_lock_acquire (&per_cpu->lock, &lock_context);
+    per_cpu->overflows = 0;
+    rtems_interrupt_lock_release (&per_cpu->lock, &lock_context);
+
+    while ((rec = rtems_capture_per_cpu_next (per_cpu)) != NULL)
+    {
+      rtems_capture_task_t* rec_task = rec->task;
+
+      rtems_capture_per_cpu_consume (per_cpu, rec);
+
+      if (rec_task)
+        rtems_capture_refcount_down (rec_task);
+    }
+  }
+
   task = capture_tasks;
 
   while (task)
@@ -1376,9 +1807,9 @@ rtems_capture_watch_global (bool enable)
    * a global enable/disable does not lose a specific watch.
    */
   if (enable)
-    capture_flags |= RTEMS_CAPTURE_GLOBAL_WATCH;
+    rtems_capture_set_flags (RTEMS_CAPTURE_GLOBAL_WATCH);
   else
-    capture_flags &= ~RTEMS_CAPTURE_GLOBAL_WATCH;
+    rtems_capture_clear_flags (RTEMS_CAPTURE_GLOBAL_WATCH);
 
   rtems_interrupt_enable (level);
 
@@ -1395,7 +1826,7 @@ rtems_capture_watch_global (bool enable)
 bool
 rtems_capture_watch_global_on (void)
 {
-  return capture_flags & RTEMS_CAPTURE_GLOBAL_WATCH ? 1 : 0;
+  return rtems_capture_get_flags () & RTEMS_CAPTURE_GLOBAL_WATCH ? 1 : 0;
 }
 
 /*
@@ -1659,25 +2090,84 @@ rtems_capture_clear_trigger (rtems_name                   from_name,
 }
 
 /*
- * rtems_capture_read
+ * rtems_capture_user_event
  *
  *  DESCRIPTION:
  *
- * This function reads a number of records from the capture buffer.
- * The user can optionally block and wait until the buffer as a
- * specific number of records available or a specific time has
- * elasped.
+ * This function records a user event with arguments for the executing
+ * task.
+ */
+rtems_status_code
+rtems_capture_user_event (uint32_t id, const void* args, size_t size)
+{
+  rtems_capture_record_context_t context;
+  rtems_capture_record_t*        rec;
+  rtems_capture_user_record_t*   user;
+  rtems_capture_task_t*          task;
+  Thread_Control*                executing;
+  uint32_t                       events;
+  size_t                         rec_size;
+  ISR_Level                      level;
+
+  if ((rtems_capture_get_flags () &
+       (RTEMS_CAPTURE_ON | RTEMS_CAPTURE_TRIGGERED | RTEMS_CAPTURE_ONLY_MONITOR))
+      != (RTEMS_CAPTURE_ON | RTEMS_CAPTURE_TRIGGERED))
+    return RTEMS_UNSATISFIED;
+
+  rec_size = sizeof (*rec) + sizeof (*user) + size;
+
+  if (RTEMS_CAPTURE_RECORD_ALIGN (rec_size) > capture_per_cpu[0].size)
+    return RTEMS_INVALID_SIZE;
+
+  /*
+   * The executing thread must not change until the record is closed. The
+   * task control is only used if it already exists since the workspace
+   * may not be used here.
+   */
+  rtems_capture_isr_disable (level);
+
+  executing = _Thread_Get_executing ();
+  task = executing->extensions[capture_extension_index];
+  events = RTEMS_CAPTURE_USER_EVENT;
+
+  if (task)
+    events |= (executing->real_priority) |
+      (executing->current_priority << 8);
+
+  rec = rtems_capture_record_open (task, events, rec_size, &context);
+
+  if (rec == NULL)
+  {
+    rtems_capture_isr_enable (level);
+    return RTEMS_TOO_MANY;
+  }
+
+  user = (rtems_capture_user_record_t*) (rec + 1);
+  user->id = id;
+  memcpy (user + 1, args, size);
+
+  rtems_capture_record_close (&context);
+
+  rtems_capture_isr_enable (level);
+
+  rtems_capture_wake_reader ();
+
+  return RTEMS_SUCCESSFUL;
+}
+
+/*
+ * rtems_capture_read
+ *
+ *  DESCRIPTION:
  *
- * The function returns the number of record that is has that are
- * in a continous block of memory. If the number of available records
- * wrap then only those records are provided. This removes the need for
- * caller to be concerned about buffer wrappings. If the number of
- * requested records cannot be met due to the wrapping of the records
- * less than the specified number will be returned.
+ * This function reads the next record from the capture buffers. The
+ * buffers of the processors are merged so that the records are
+ * returned in time order. The user can optionally block and wait until
+ * the buffers have a specific number of records available or a specific
+ * time has elasped.
  *
- * The user must release the records. This is achieved with a call to
- * rtems_capture_release. Calls this function without a release will
- * result in at least the same number of records being released.
+ * The record is returned in place. The user must release the record.
+ * This is achieved with a call to rtems_capture_release.
  *
  * The 'threshold' parameter is the number of records that must be
  * captured before returning. If a timeout period is specified (non-0)
@@ -1692,91 +2182,101 @@ rtems_capture_clear_trigger (rtems_name                   from_name,
 rtems_status_code
 rtems_capture_read (uint32_t                 threshold,
                     uint32_t                 timeout,
-                    uint32_t*                read,
-                    rtems_capture_record_t** recs)
+                    rtems_capture_record_t** rec)
 {
-  rtems_interrupt_level level;
-  rtems_status_code     sc = RTEMS_SUCCESSFUL;
-  uint32_t              count;
-
-  *read = 0;
-  *recs = NULL;
+  rtems_status_code sc = RTEMS_SUCCESSFUL;
+  uint32_t          cpu;
 
-  rtems_interrupt_disable (level);
+  *rec = NULL;
 
   /*
    * Only one reader is allowed.
    */
 
-  if (capture_flags & RTEMS_CAPTURE_READER_ACTIVE)
-  {
-    rtems_interrupt_enable (level);
+  if (rtems_capture_set_flags (RTEMS_CAPTURE_READER_ACTIVE) &
+      RTEMS_CAPTURE_READER_ACTIVE)
     return RTEMS_RESOURCE_IN_USE;
-  }
-
-  capture_flags |= RTEMS_CAPTURE_READER_ACTIVE;
-  *read = count = capture_count;
-
-  rtems_interrupt_enable (level);
-
-  *recs = &capture_records[capture_out];
 
-  for (;;)
+  /*
+   * Do we have a threshold and not enough records ? Wait for the
+   * writers to signal that the threshold is reached. The switch
+   * records do not signal, so the buffers are polled as well. A
+   * timeout is at least one clock tick. The records available when it
+   * expires are returned.
+   */
+  if (threshold && (rtems_capture_count () < threshold))
   {
-    /*
-     * See if the count wraps the end of the record buffer.
-     */
-    if (count && ((capture_out + count) >= capture_size))
-      *read = capture_size - capture_out;
+    rtems_interval ticks = 0;
+    rtems_interval start = rtems_clock_get_ticks_since_boot ();
 
-    /*
-     * Do we have a threshold and the current count has not wrapped
-     * around the end of the capture record buffer ?
-     */
-    if ((*read == count) && threshold)
+    if (timeout)
     {
-      /*
-       * Do we have enough records ?
-       */
-      if (*read < threshold)
-      {
-        rtems_event_set event_out;
+      ticks = RTEMS_MICROSECONDS_TO_TICKS (timeout);
+      if (ticks == 0)
+        ticks = 1;
+    }
 
-        rtems_task_ident (RTEMS_SELF, RTEMS_LOCAL, &capture_reader);
+    capture_reader = rtems_task_self ();
+    capture_reader_threshold = threshold;
 
-        rtems_interrupt_disable (level);
+    while (sc == RTEMS_SUCCESSFUL)
+    {
+      rtems_event_set event_out;
+      rtems_interval  wait = RTEMS_CAPTURE_READER_POLL_TICKS;
 
-        capture_flags |= RTEMS_CAPTURE_READER_WAITING;
+      rtems_capture_set_flags (RTEMS_CAPTURE_READER_WAITING);
 
-        rtems_interrupt_enable (level);
+      if (rtems_capture_count () >= threshold)
+        break;
 
-        sc = rtems_event_receive (RTEMS_EVENT_0,
-                                  RTEMS_WAIT | RTEMS_EVENT_ANY,
-                                  RTEMS_MICROSECONDS_TO_TICKS (timeout),
-                                  &event_out);
+      if (timeout)
+      {
+        rtems_interval elapsed = rtems_clock_get_ticks_since_boot () - start;
 
-        /*
-         * Let the user handle all other sorts of errors. This may
-         * not be the best solution, but oh well, it will do for
-         * now.
-         */
-        if ((sc != RTEMS_SUCCESSFUL) && (sc != RTEMS_TIMEOUT))
+        if (elapsed >= ticks)
           break;
 
-        rtems_interrupt_disable (level);
-
-        *read = count = capture_count;
+        if (wait > (ticks - elapsed))
+          wait = ticks - elapsed;
+      }
 
-        rtems_interrupt_enable (level);
+      sc = rtems_event_receive (RTEMS_EVENT_0,
+                                RTEMS_WAIT | RTEMS_EVENT_ANY,
+                                wait,
+                                &event_out);
 
-        continue;
-      }
+      if (sc == RTEMS_TIMEOUT)
+        sc = RTEMS_SUCCESSFUL;
     }
 
-    /*
-     * Always out if we reach here. To loop use continue.
-     */
-    break;
+    rtems_capture_clear_flags (RTEMS_CAPTURE_READER_WAITING);
+  }
+
+  /*
+   * The reader is not active if the wait failed, the record is not
+   * released in this case.
+   */
+  if (sc != RTEMS_SUCCESSFUL)
+  {
+    rtems_capture_clear_flags (RTEMS_CAPTURE_READER_ACTIVE);
+    return sc;
+  }
+
+  /*
+   * Merge the buffers. Each buffer is in time order so the oldest record
+   * is the oldest of the records at the front of the buffers.
+   */
+  for (cpu = 0; cpu < capture_cpu_count; cpu++)
+  {
+    rtems_capture_record_t* next;
+
+    next = rtems_capture_per_cpu_next (&capture_per_cpu[cpu]);
+
+    if (next && ((*rec == NULL) || (next->time < (*rec)->time)))
+    {
+      *rec = next;
+      capture_reader_cpu = cpu;
+    }
   }
 
   return sc;
@@ -1787,44 +2287,26 @@ rtems_capture_read (uint32_t                 threshold,
  *
  *  DESCRIPTION:
  *
- * This function releases the requested number of record slots back
- * to the capture engine. The count must match the number read.
+ * This function releases the record returned by rtems_capture_read
+ * back to the capture engine.
  */
 rtems_status_code
-rtems_capture_release (uint32_t count)
+rtems_capture_release (rtems_capture_record_t* rec)
 {
-  rtems_capture_record_t* rec;
-  uint32_t                counted;
-
-  rtems_interrupt_level level;
-
-  rtems_interrupt_disable (level);
-
-  if (count > capture_count)
-    count = capture_count;
-
-  rtems_interrupt_enable (level);
-
-  counted = count;
-
-  rec = &capture_records[capture_out];
-
-  while (counted--)
+  if (rec)
   {
-    rtems_capture_refcount_down (rec->task);
-    rtems_capture_destroy_capture_task (rec->task);
-    rec++;
-  }
-
-  rtems_interrupt_disable (level);
+    rtems_capture_task_t* task = rec->task;
 
-  capture_count -= count;
+    rtems_capture_per_cpu_consume (&capture_per_cpu[capture_reader_cpu], rec);
 
-  capture_out = (capture_out + count) % capture_size;
-
-  capture_flags &= ~RTEMS_CAPTURE_READER_ACTIVE;
+    if (task)
+    {
+      rtems_capture_refcount_down (task);
+      rtems_capture_destroy_capture_task (task);
+    }
+  }
 
-  rtems_interrupt_enable (level);
+  rtems_capture_clear_flags (RTEMS_CAPTURE_READER_ACTIVE);
 
   return RTEMS_SUCCESSFUL;
 }
@@ -158,7 +158,6 @@ typedef struct rtems_capture_task_s
   rtems_name                   name;
   rtems_id                     id;
   uint32_t                     flags;
-  uint32_t                     refcount;
   rtems_tcb*                   tcb;
   uint32_t                     in;
   uint32_t                     out;
@@ -186,11 +185,16 @@ typedef struct rtems_capture_task_s
  * RTEMS capture record. This is a record that is written into
  * the buffer. The events includes the priority of the task
  * at the time of the context switch.
+ *
+ * Records have a variable length. The size is the size of the
+ * record header plus the size of the payload which directly follows
+ * the header. Only user events carry a payload at the moment.
  */
 typedef struct rtems_capture_record_s
 {
-  rtems_capture_task_t* task;
+  uint32_t              size;
   uint32_t              events;
+  rtems_capture_task_t* task;
   rtems_capture_time_t  time;
 } rtems_capture_record_t;
 
@@ -215,7 +219,21 @@ typedef struct rtems_capture_record_s
 #define RTEMS_CAPTURE_SWITCHED_OUT_EVENT  UINT32_C (0x04000000)
 #define RTEMS_CAPTURE_SWITCHED_IN_EVENT   UINT32_C (0x08000000)
 #define RTEMS_CAPTURE_TIMESTAMP           UINT32_C (0x10000000)
-#define RTEMS_CAPTURE_EVENT_END           (28)
+#define RTEMS_CAPTURE_USER_EVENT          UINT32_C (0x20000000)
+#define RTEMS_CAPTURE_EVENT_END           (29)
+
+/**
+ * rtems_capture_user_record_t
+ *
+ *  DESCRIPTION:
+ *
+ * The payload of a user event record. The arguments passed to
+ * rtems_capture_user_event follow the identifier.
+ */
+typedef struct rtems_capture_user_record_s
+{
+  uint32_t id;
+} rtems_capture_user_record_t;
 
 /**
  * rtems_capture_trigger_mode_t
@@ -465,26 +483,40 @@ rtems_capture_clear_trigger (rtems_name                   from_name,
                              rtems_capture_trigger_mode_t mode,
                              rtems_capture_trigger_t      trigger);
 
+/**
+ * rtems_capture_user_event
+ *
+ *  DESCRIPTION:
+ *
+ * This function records a user event for the executing task. The
+ * identifier and the arguments are copied into the payload of the
+ * record, see rtems_capture_user_record_t. User events are not
+ * subject to the watch filters, they are recorded if the capture
+ * engine is enabled and triggered. This function may be called from
+ * interrupt context.
+ */
+rtems_status_code
+rtems_capture_user_event (uint32_t    id,
+                          const void* args,
+                          size_t      size);
+
 /**
  * rtems_capture_read
  *
  *  DESCRIPTION:
  *
- * This function reads a number of records from the capture buffer.
- * The user can optionally block and wait until the buffer as a
+ * This function reads the next record from the capture buffers.
+ * Each processor has its own capture buffer. The records of all
+ * buffers are merged so that the records are returned in time order.
+ * The user can optionally block and wait until the buffers have a
  * specific number of records available or a specific time has
  * elasped.
  *
- * The function returns the number of record that is has that are
- * in a continous block of memory. If the number of available records
- * wrap then only those records are provided. This removes the need for
- * caller to be concerned about buffer wrappings. If the number of
- * requested records cannot be met due to the wrapping of the records
- * less than the specified number will be returned.
+ * The record is returned in place. If no record is available the
+ * record pointer is set to NULL.
  *
- * The user must release the records. This is achieved with a call to
- * rtems_capture_release. Calls this function without a release will
- * result in at least the same number of records being released.
+ * The user must release the record. This is achieved with a call to
+ * rtems_capture_release. Only one reader is allowed.
  *
  * The 'threshold' parameter is the number of records that must be
  * captured before returning. If a timeout period is specified (non-0)
@@ -493,25 +525,51 @@ rtems_capture_clear_trigger (rtems_name                   from_name,
  * a user configured latiency to be applied for single events.
  *
  * The 'timeout' parameter is in micro-seconds. A value of 0 will
- * disable the timeout.
- *
+ * disable the timeout. A timeout shorter than a clock tick waits one
+ * clock tick. The read returns as soon as the threshold is reached.
  */
 rtems_status_code
 rtems_capture_read (uint32_t                 threshold,
                     uint32_t                 timeout,
-                    uint32_t*                read,
-                    rtems_capture_record_t** recs);
+                    rtems_capture_record_t** rec);
 
 /**
  * rtems_capture_release
  *
  *  DESCRIPTION:
  *
- * This function releases the requested number of record slots back
- * to the capture engine. The count must match the number read.
+ * This function releases the record returned by rtems_capture_read
+ * back to the capture engine. The record may be NULL to end a read
+ * which returned no record.
  */
 rtems_status_code
-rtems_capture_release (uint32_t count);
+rtems_capture_release (rtems_capture_record_t* rec);
+
+/**
+ * rtems_capture_record_payload
+ *
+ *  DESCRIPTION:
+ *
+ * This function returns the payload of a record.
+ */
+static inline const void*
+rtems_capture_record_payload (const rtems_capture_record_t* rec)
+{
+  return rec + 1;
+}
+
+/**
+ * rtems_capture_record_payload_size
+ *
+ *  DESCRIPTION:
+ *
+ * This function returns the size of the payload of a record.
+ */
+static inline size_t
+rtems_capture_record_payload_size (const rtems_capture_record_t* rec)
+{
+  return rec->size - sizeof (*rec);
+}
 
 /*
  * rtems_capture_time
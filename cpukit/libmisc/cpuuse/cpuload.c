@@ -0,0 +1,634 @@
+/**
+ * @file
+ *
+ * @brief CPU Load Monitor
+ * @ingroup libmisc_cpuuse CPU Usage
+ */
+
+/*
+ *  The license and distribution terms for this file may be
+ *  found in the file LICENSE in this distribution or at
+ *  http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <rtems/cpuuse.h>
+#include <rtems/score/objectimpl.h>
+#include <rtems/score/threaddispatch.h>
+#include <rtems/score/todimpl.h>
+#include <rtems/score/watchdogimpl.h>
+
+/*
+ *  The samples are taken once per second.  The longest window needs one
+ *  sample more than its length in seconds.
+ */
+#define CPU_LOAD_SAMPLES 61
+
+#define CPU_LOAD_STOP_EVENT RTEMS_EVENT_0
+
+/*
+ *  The sample values are the CPU time used in microseconds, or in clock ticks
+ *  if the statistics use ticks.  They wrap around, which is harmless since
+ *  only differences within the longest window are used.
+ */
+typedef struct {
+  rtems_id id;
+  uint32_t sample_count;
+  uint32_t used[ CPU_LOAD_SAMPLES ];
+} CPU_load_Thread;
+
+typedef struct {
+  rtems_id         task_id;
+  bool             starting;
+  rtems_id         stop_requester;
+  uint32_t         head;
+  uint32_t         sample_count;
+  uint32_t         uptime[ CPU_LOAD_SAMPLES ];
+  CPU_load_Thread *threads[ OBJECTS_APIS_LAST + 1 ];
+  uint32_t         capacity[ OBJECTS_APIS_LAST + 1 ];
+} CPU_load_Control;
+
+static CPU_load_Control CPU_load;
+
+static const uint32_t CPU_load_Window_seconds[ RTEMS_CPU_LOAD_WINDOW_COUNT ] = {
+  1,
+  10,
+  60
+};
+
+static Objects_Information *CPU_load_Get_thread_information(
+  uint32_t api_index
+)
+{
+  if ( !_Objects_Information_table[ api_index ] )
+    return NULL;
+
+  return _Objects_Information_table[ api_index ][ 1 ];
+}
+
+#ifndef __RTEMS_USE_TICKS_FOR_STATISTICS__
+  static uint32_t CPU_load_To_microseconds( const Timestamp_Control *time )
+  {
+    return _Timestamp_Get_seconds( time ) * TOD_MICROSECONDS_PER_SECOND
+      + _Timestamp_Get_nanoseconds( time ) / TOD_NANOSECONDS_PER_MICROSECOND;
+  }
+
+  static uint32_t CPU_load_Get_used(
+    Thread_Control          *the_thread,
+    const Timestamp_Control *uptime
+  )
+  {
+    Timestamp_Control used = the_thread->cpu_time_used;
+
+    /*
+     *  Account for the time since the last context switch of executing
+     *  threads.
+     */
+    #ifndef RTEMS_SMP
+      if ( the_thread == _Thread_Executing ) {
+        Timestamp_Control ran;
+
+        _Timestamp_Subtract(
+          &_Thread_Time_of_last_context_switch, uptime, &ran
+        );
+        _Timestamp_Add_to( &used, &ran );
+      }
+    #else
+      if ( the_thread->is_executing ) {
+        Timestamp_Control ran;
+
+        _Timestamp_Subtract(
+          &the_thread->cpu->time_of_last_context_switch, uptime, &ran
+        );
+        _Timestamp_Add_to( &used, &ran );
+      }
+    #endif
+
+    return CPU_load_To_microseconds( &used );
+  }
+#endif
+
+/*
+ *  Make room for threads created since the last sample in case the thread
+ *  objects are unlimited.  The sample tables are only replaced with thread
+ *  dispatching disabled, since the readers access them in this state.
+ */
+static void CPU_load_Grow_tables( void )
+{
+  uint32_t api_index;
+
+  for ( api_index = 1 ; api_index <= OBJECTS_APIS_LAST ; api_index++ ) {
+    Objects_Information *information =
+      CPU_load_Get_thread_information( api_index );
+    CPU_load_Thread     *old_threads;
+    CPU_load_Thread     *new_threads;
+    uint32_t             capacity;
+
+    if ( !information || information->maximum <= CPU_load.capacity[ api_index ] )
+      continue;
+
+    capacity = information->maximum;
+    new_threads = calloc( capacity, sizeof( *new_threads ) );
+    if ( !new_threads )
+      continue;
+
+    _Thread_Disable_dispatch();
+      old_threads = CPU_load.threads[ api_index ];
+      if ( old_threads ) {
+        memcpy(
+          new_threads,
+          old_threads,
+          CPU_load.capacity[ api_index ] * sizeof( *new_threads )
+        );
+      }
+      CPU_load.threads[ api_index ] = new_threads;
+      CPU_load.capacity[ api_index ] = capacity;
+    _Thread_Enable_dispatch();
+
+    free( old_threads );
+  }
+}
+
+static void CPU_load_Sample( void )
+{
+  uint32_t  api_index;
+  uint32_t  head;
+  #ifndef __RTEMS_USE_TICKS_FOR_STATISTICS__
+    Timestamp_Control uptime;
+  #endif
+
+  CPU_load_Grow_tables();
+
+  _Thread_Disable_dispatch();
+
+  head = CPU_load.sample_count > 0 ?
+    ( CPU_load.head + 1 ) % CPU_LOAD_SAMPLES : 0;
+  CPU_load.head = head;
+
+  #ifndef __RTEMS_USE_TICKS_FOR_STATISTICS__
+    _TOD_Get_uptime( &uptime );
+    CPU_load.uptime[ head ] = CPU_load_To_microseconds( &uptime );
+  #else
+    CPU_load.uptime[ head ] = _Watchdog_Ticks_since_boot;
+  #endif
+
+  for ( api_index = 1 ; api_index <= OBJECTS_APIS_LAST ; api_index++ ) {
+    Objects_Information *information =
+      CPU_load_Get_thread_information( api_index );
+    CPU_load_Thread     *threads = CPU_load.threads[ api_index ];
+    uint32_t             count;
+    uint32_t             i;
+
+    if ( !information || !threads )
+      continue;
+
+    count = information->maximum;
+    if ( count > CPU_load.capacity[ api_index ] )
+      count = CPU_load.capacity[ api_index ];
+
+    for ( i = 0 ; i < count ; i++ ) {
+      Thread_Control  *the_thread =
+        (Thread_Control *) information->local_table[ i + 1 ];
+      CPU_load_Thread *entry = &threads[ i ];
+
+      if ( !the_thread ) {
+        entry->id = 0;
+        continue;
+      }
+
+      if ( entry->id != the_thread->Object.id ) {
+        entry->id = the_thread->Object.id;
+        entry->sample_count = 0;
+      }
+
+      #ifndef __RTEMS_USE_TICKS_FOR_STATISTICS__
+        entry->used[ head ] = CPU_load_Get_used( the_thread, &uptime );
+      #else
+        entry->used[ head ] = the_thread->cpu_time_used;
+      #endif
+
+      if ( entry->sample_count < CPU_LOAD_SAMPLES )
+        entry->sample_count++;
+    }
+  }
+
+  if ( CPU_load.sample_count < CPU_LOAD_SAMPLES )
+    CPU_load.sample_count++;
+
+  _Thread_Enable_dispatch();
+}
+
+/*
+ *  Thread dispatching must be disabled.
+ */
+static void CPU_load_Compute(
+  const CPU_load_Thread *entry,
+  rtems_cpu_load        *load
+)
+{
+  uint32_t head = CPU_load.head;
+  uint32_t window;
+
+  for ( window = 0 ; window < RTEMS_CPU_LOAD_WINDOW_COUNT ; window++ ) {
+    uint32_t samples = CPU_load_Window_seconds[ window ];
+    uint32_t previous;
+    uint32_t uptime;
+    uint64_t used;
+
+    if ( samples >= entry->sample_count )
+      samples = entry->sample_count > 0 ? entry->sample_count - 1 : 0;
+
+    if ( samples == 0 ) {
+      load->load[ window ] = 0;
+      continue;
+    }
+
+    previous = ( head + CPU_LOAD_SAMPLES - samples ) % CPU_LOAD_SAMPLES;
+    uptime = CPU_load.uptime[ head ] - CPU_load.uptime[ previous ];
+    used = entry->used[ head ] - entry->used[ previous ];
+
+    if ( uptime == 0 ) {
+      load->load[ window ] = 0;
+    } else {
+      used = ( used * 1000 ) / uptime;
+      load->load[ window ] = used > 1000 ? 1000 : (uint32_t) used;
+    }
+  }
+}
+
+/*
+ *  Thread dispatching must be disabled.
+ */
+static const CPU_load_Thread *CPU_load_Find( rtems_id id )
+{
+  uint32_t api_index = _Objects_Get_API( id );
+  uint32_t index = _Objects_Get_index( id );
+
+  if (
+    api_index < 1
+      || api_index > OBJECTS_APIS_LAST
+      || !CPU_load.threads[ api_index ]
+      || index < 1
+      || index > CPU_load.capacity[ api_index ]
+  ) {
+    return NULL;
+  }
+
+  return &CPU_load.threads[ api_index ][ index - 1 ];
+}
+
+static rtems_task CPU_load_Task( rtems_task_argument arg )
+{
+  rtems_interval  ticks_per_second = rtems_clock_get_ticks_per_second();
+  uint32_t        api_index;
+  CPU_load_Thread *threads[ OBJECTS_APIS_LAST + 1 ];
+
+  (void) arg;
+
+  while ( true ) {
+    rtems_event_set   events;
+    rtems_status_code sc;
+
+    CPU_load_Sample();
+
+    sc = rtems_event_receive(
+      CPU_LOAD_STOP_EVENT,
+      RTEMS_EVENT_ANY | RTEMS_WAIT,
+      ticks_per_second,
+      &events
+    );
+    if ( sc == RTEMS_SUCCESSFUL )
+      break;
+  }
+
+  _Thread_Disable_dispatch();
+    for ( api_index = 1 ; api_index <= OBJECTS_APIS_LAST ; api_index++ ) {
+      threads[ api_index ] = CPU_load.threads[ api_index ];
+      CPU_load.threads[ api_index ] = NULL;
+      CPU_load.capacity[ api_index ] = 0;
+    }
+    CPU_load.sample_count = 0;
+    CPU_load.task_id = 0;
+  _Thread_Enable_dispatch();
+
+  for ( api_index = 1 ; api_index <= OBJECTS_APIS_LAST ; api_index++ )
+    free( threads[ api_index ] );
+
+  rtems_event_transient_send( CPU_load.stop_requester );
+  rtems_task_delete( RTEMS_SELF );
+}
+
+rtems_status_code rtems_cpu_load_monitor_start(
+  rtems_task_priority priority
+)
+{
+  rtems_status_code sc;
+  rtems_id          id;
+  bool              busy;
+
+  /*
+   *  Concurrent start requests must not both pass this check, so reserve
+   *  the monitor with thread dispatching disabled.
+   */
+  _Thread_Disable_dispatch();
+    busy = CPU_load.task_id != 0 || CPU_load.starting;
+    if ( !busy )
+      CPU_load.starting = true;
+  _Thread_Enable_dispatch();
+
+  if ( busy )
+    return RTEMS_INCORRECT_STATE;
+
+  sc = rtems_task_create(
+    rtems_build_name( 'C', 'P', 'U', 'L' ),
+    priority,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  if ( sc != RTEMS_SUCCESSFUL ) {
+    CPU_load.starting = false;
+    return sc;
+  }
+
+  CPU_load_Grow_tables();
+  if ( !CPU_load.threads[ OBJECTS_INTERNAL_API ] ) {
+    rtems_task_delete( id );
+    CPU_load.starting = false;
+    return RTEMS_NO_MEMORY;
+  }
+
+  CPU_load.task_id = id;
+
+  sc = rtems_task_start( id, CPU_load_Task, 0 );
+  if ( sc != RTEMS_SUCCESSFUL ) {
+    uint32_t api_index;
+
+    CPU_load.task_id = 0;
+    rtems_task_delete( id );
+
+    for ( api_index = 1 ; api_index <= OBJECTS_APIS_LAST ; api_index++ ) {
+      free( CPU_load.threads[ api_index ] );
+      CPU_load.threads[ api_index ] = NULL;
+      CPU_load.capacity[ api_index ] = 0;
+    }
+  }
+
+  CPU_load.starting = false;
+
+  return sc;
+}
+
+rtems_status_code rtems_cpu_load_monitor_stop( void )
+{
+  rtems_id task_id = CPU_load.task_id;
+
+  if ( task_id == 0 )
+    return RTEMS_INCORRECT_STATE;
+
+  CPU_load.stop_requester = rtems_task_self();
+  rtems_event_send( task_id, CPU_LOAD_STOP_EVENT );
+  rtems_event_transient_receive( RTEMS_WAIT, RTEMS_NO_TIMEOUT );
+
+  return RTEMS_SUCCESSFUL;
+}
+
+rtems_status_code rtems_cpu_load_get_thread(
+  rtems_id        id,
+  rtems_cpu_load *load
+)
+{
+  const CPU_load_Thread *entry;
+  rtems_status_code      sc;
+
+  if ( !load )
+    return RTEMS_INVALID_ADDRESS;
+
+  if ( id == RTEMS_SELF )
+    id = rtems_task_self();
+
+  _Thread_Disable_dispatch();
+
+  if ( CPU_load.sample_count == 0 ) {
+    sc = RTEMS_INCORRECT_STATE;
+  } else {
+    entry = CPU_load_Find( id );
+    if ( entry && entry->id == id ) {
+      CPU_load_Compute( entry, load );
+      sc = RTEMS_SUCCESSFUL;
+    } else {
+      sc = RTEMS_INVALID_ID;
+    }
+  }
+
+  _Thread_Enable_dispatch();
+
+  return sc;
+}
+
+rtems_status_code rtems_cpu_load_get_processor(
+  uint32_t        cpu_index,
+  rtems_cpu_load *load
+)
+{
+  const CPU_load_Thread *entry;
+  rtems_status_code      sc;
+  uint32_t               window;
+
+  if ( !load )
+    return RTEMS_INVALID_ADDRESS;
+
+  if ( cpu_index >= rtems_smp_get_processor_count() )
+    return RTEMS_INVALID_NUMBER;
+
+  _Thread_Disable_dispatch();
+
+  if ( CPU_load.sample_count == 0 ) {
+    sc = RTEMS_INCORRECT_STATE;
+  } else {
+    /*
+     *  The idle threads are the first internal threads and are created in
+     *  processor index order.
+     */
+    entry = &CPU_load.threads[ OBJECTS_INTERNAL_API ][ cpu_index ];
+    CPU_load_Compute( entry, load );
+
+    for ( window = 0 ; window < RTEMS_CPU_LOAD_WINDOW_COUNT ; window++ ) {
+      if ( entry->sample_count > 1 )
+        load->load[ window ] = 1000 - load->load[ window ];
+    }
+
+    sc = RTEMS_SUCCESSFUL;
+  }
+
+  _Thread_Enable_dispatch();
+
+  return sc;
+}
+
+typedef struct {
+  rtems_id       id;
+  uint32_t       sort_key;
+  rtems_cpu_load load;
+} CPU_load_Top_entry;
+
+static int CPU_load_Top_compare( const void *a, const void *b )
+{
+  uint32_t load_a = ( (const CPU_load_Top_entry *) a )->sort_key;
+  uint32_t load_b = ( (const CPU_load_Top_entry *) b )->sort_key;
+
+  if ( load_a != load_b )
+    return load_a < load_b ? 1 : -1;
+
+  return 0;
+}
+
+static void CPU_load_Print_load(
+  void                  *context,
+  rtems_printk_plugin_t  print,
+  const rtems_cpu_load  *load
+)
+{
+  uint32_t window;
+
+  for ( window = 0 ; window < RTEMS_CPU_LOAD_WINDOW_COUNT ; window++ ) {
+    (*print)( context,
+      "|%5" PRIu32 ".%01" PRIu32 " ",
+      load->load[ window ] / 10,
+      load->load[ window ] % 10
+    );
+  }
+
+  (*print)( context, "\n" );
+}
+
+void rtems_cpu_load_top_with_plugin(
+  void                  *context,
+  rtems_printk_plugin_t  print,
+  rtems_cpu_load_window  window,
+  uint32_t               max_threads
+)
+{
+  CPU_load_Top_entry *entries;
+  uint32_t            capacity;
+  uint32_t            count;
+  uint32_t            api_index;
+  uint32_t            cpu_count;
+  uint32_t            cpu_index;
+  uint32_t            i;
+  char                name[13];
+
+  if ( !print )
+    return;
+
+  if ( (uint32_t) window >= RTEMS_CPU_LOAD_WINDOW_COUNT )
+    window = RTEMS_CPU_LOAD_WINDOW_1_SECOND;
+
+  capacity = 0;
+  for ( api_index = 1 ; api_index <= OBJECTS_APIS_LAST ; api_index++ ) {
+    Objects_Information *information =
+      CPU_load_Get_thread_information( api_index );
+
+    if ( information )
+      capacity += information->maximum;
+  }
+
+  entries = malloc( capacity * sizeof( *entries ) );
+  if ( !entries && capacity > 0 ) {
+    (*print)( context, "not enough memory for the CPU load report\n" );
+    return;
+  }
+
+  /*
+   *  Only take a snapshot with thread dispatching disabled and do the
+   *  expensive work afterwards.
+   */
+  count = 0;
+  _Thread_Disable_dispatch();
+
+  if ( CPU_load.sample_count == 0 ) {
+    _Thread_Enable_dispatch();
+    free( entries );
+    (*print)( context, "CPU load monitor is not started\n" );
+    return;
+  }
+
+  for ( api_index = 1 ; api_index <= OBJECTS_APIS_LAST ; api_index++ ) {
+    const CPU_load_Thread *threads = CPU_load.threads[ api_index ];
+
+    for ( i = 0 ; i < CPU_load.capacity[ api_index ] ; i++ ) {
+      if ( threads[ i ].id != 0 && count < capacity ) {
+        entries[ count ].id = threads[ i ].id;
+        CPU_load_Compute( &threads[ i ], &entries[ count ].load );
+        entries[ count ].sort_key = entries[ count ].load.load[ window ];
+        count++;
+      }
+    }
+  }
+
+  _Thread_Enable_dispatch();
+
+  qsort( entries, count, sizeof( *entries ), CPU_load_Top_compare );
+
+  (*print)(
+     context,
+     "-------------------------------------------------------------------------------\n"
+     "                         CPU LOAD IN PER CENT (1s/10s/60s)\n"
+     "------------+----------------------------------------+--------+--------+-------\n"
+     " ID         | NAME                                   |    1 s |   10 s |   60 s\n"
+     "------------+----------------------------------------+--------+--------+-------\n"
+  );
+
+  cpu_count = rtems_smp_get_processor_count();
+  for ( cpu_index = 0 ; cpu_index < cpu_count ; cpu_index++ ) {
+    rtems_cpu_load load;
+
+    if ( rtems_cpu_load_get_processor( cpu_index, &load ) != RTEMS_SUCCESSFUL )
+      continue;
+
+    (*print)( context,
+      "            | PROCESSOR %-28" PRIu32 " ",
+      cpu_index
+    );
+    CPU_load_Print_load( context, print, &load );
+  }
+
+  if ( max_threads == 0 || max_threads > count )
+    max_threads = count;
+
+  for ( i = 0 ; i < max_threads ; i++ ) {
+    rtems_object_get_name( entries[ i ].id, sizeof(name), name );
+
+    (*print)( context,
+      " 0x%08" PRIx32 " | %-38s ",
+      entries[ i ].id,
+      name
+    );
+    CPU_load_Print_load( context, print, &entries[ i ].load );
+  }
+
+  (*print)(
+     context,
+     "-------------------------------------------------------------------------------\n"
+  );
+
+  free( entries );
+}
+
+void rtems_cpu_load_top( void )
+{
+  rtems_cpu_load_top_with_plugin(
+    NULL,
+    printk_plugin,
+    RTEMS_CPU_LOAD_WINDOW_1_SECOND,
+    0
+  );
+}
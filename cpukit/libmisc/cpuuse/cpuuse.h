@@ -70,6 +70,117 @@ void rtems_cpu_usage_report( void );
 
 void rtems_cpu_usage_reset( void );
 
+/**
+ *  @brief Count of CPU load windows.
+ */
+#define RTEMS_CPU_LOAD_WINDOW_COUNT 3
+
+/**
+ *  @brief CPU load windows.
+ */
+typedef enum {
+  RTEMS_CPU_LOAD_WINDOW_1_SECOND,
+  RTEMS_CPU_LOAD_WINDOW_10_SECONDS,
+  RTEMS_CPU_LOAD_WINDOW_60_SECONDS
+} rtems_cpu_load_window;
+
+/**
+ *  @brief CPU load of a thread or processor.
+ *
+ *  The load values are in per mille of the window.  Windows longer than the
+ *  time since the start of the load monitor or the thread creation are
+ *  truncated.
+ */
+typedef struct {
+  uint32_t load[ RTEMS_CPU_LOAD_WINDOW_COUNT ];
+} rtems_cpu_load;
+
+/**
+ *  @brief Start the CPU load monitor.
+ *
+ *  The load monitor is a task which samples the CPU time used of all threads
+ *  once per second.  It does not reset the CPU usage information.  The
+ *  priority should be high to keep the sample instants close to the period.
+ *
+ *  @param[in] priority The priority of the load monitor task.
+ *
+ *  @retval RTEMS_SUCCESSFUL Successful operation.
+ *  @retval RTEMS_INCORRECT_STATE The load monitor is already started.
+ *  @retval RTEMS_NO_MEMORY Not enough memory for the sample tables.
+ *  @retval other The load monitor task creation failed.
+ */
+rtems_status_code rtems_cpu_load_monitor_start(
+  rtems_task_priority priority
+);
+
+/**
+ *  @brief Stop the CPU load monitor.
+ *
+ *  @retval RTEMS_SUCCESSFUL Successful operation.
+ *  @retval RTEMS_INCORRECT_STATE The load monitor is not started.
+ */
+rtems_status_code rtems_cpu_load_monitor_stop( void );
+
+/**
+ *  @brief Get the CPU load of a thread.
+ *
+ *  @param[in] id The thread identifier or RTEMS_SELF.
+ *  @param[out] load The CPU load of the thread.
+ *
+ *  @retval RTEMS_SUCCESSFUL Successful operation.
+ *  @retval RTEMS_INCORRECT_STATE The load monitor is not started.
+ *  @retval RTEMS_INVALID_ADDRESS The load pointer is NULL.
+ *  @retval RTEMS_INVALID_ID The thread has not been sampled yet.
+ */
+rtems_status_code rtems_cpu_load_get_thread(
+  rtems_id        id,
+  rtems_cpu_load *load
+);
+
+/**
+ *  @brief Get the CPU load of a processor.
+ *
+ *  The processor load is the complement of the load of its idle thread.
+ *
+ *  @param[in] cpu_index The processor index.
+ *  @param[out] load The CPU load of the processor.
+ *
+ *  @retval RTEMS_SUCCESSFUL Successful operation.
+ *  @retval RTEMS_INCORRECT_STATE The load monitor is not started.
+ *  @retval RTEMS_INVALID_ADDRESS The load pointer is NULL.
+ *  @retval RTEMS_INVALID_NUMBER Invalid processor index.
+ */
+rtems_status_code rtems_cpu_load_get_processor(
+  uint32_t        cpu_index,
+  rtems_cpu_load *load
+);
+
+/**
+ *  @brief Report the CPU load of all processors and threads.
+ *
+ *  The threads are sorted by their load in the specified window in
+ *  descending order.
+ *
+ *  @param[in] context The context passed to the print handler.
+ *  @param[in] print The print handler.
+ *  @param[in] window The window used to sort the threads.
+ *  @param[in] max_threads The maximum count of reported threads.  Zero
+ *  reports all threads.
+ */
+void rtems_cpu_load_top_with_plugin(
+  void                  *context,
+  rtems_printk_plugin_t  print,
+  rtems_cpu_load_window  window,
+  uint32_t               max_threads
+);
+
+/**
+ *  @brief Report the CPU load of all processors and threads via printk().
+ *
+ *  The threads are sorted by their load in the one second window.
+ */
+void rtems_cpu_load_top( void );
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,6 +31,8 @@
 #include <stdlib.h>
 
 #include <rtems/monitor.h>
+#include <rtems/profiling.h>
+#include <inttypes.h>
 
 /* set by trap handler */
 extern rtems_tcb       *debugger_interrupted_task;
@@ -210,6 +212,16 @@ static const rtems_monitor_command_entry_t rtems_monitor_commands[] = {
       { 0 },
       &rtems_monitor_commands[18],
     },
+    { "lockstat",
+      "Display the lock statistics of the specified semaphores and mutexes. "
+      "Default is to display all locks sorted by contention. "
+      "Requires the profiling support.\n"
+      "  lockstat [id [id ...] ]",
+      0,
+      rtems_monitor_lockstat_cmd,
+      { 0 },
+      &rtems_monitor_commands[19],
+    },
 #if defined(RTEMS_MULTIPROCESSING)
     { "node",
       "Specify default node number for commands that take id's.\n"
@@ -217,11 +229,11 @@ static const rtems_monitor_command_entry_t rtems_monitor_commands[] = {
       0,
       rtems_monitor_node_cmd,
       { 0 },
-      &rtems_monitor_commands[19],
+      &rtems_monitor_commands[20],
     },
-  #define RTEMS_MONITOR_POSIX_NEXT 20
+  #define RTEMS_MONITOR_POSIX_NEXT 21
 #else
-  #define RTEMS_MONITOR_POSIX_NEXT 19
+  #define RTEMS_MONITOR_POSIX_NEXT 20
 #endif
 #ifdef RTEMS_POSIX_API
     { "pthread",
@@ -334,6 +346,48 @@ void rtems_monitor_fatal_cmd(
         rtems_fatal_error_occurred(strtoul(argv[1], 0, 0));
 }
 
+void rtems_monitor_lockstat_cmd(
+  int                                argc,
+  char                             **argv,
+  const rtems_monitor_command_arg_t *command_arg __attribute__((unused)),
+  bool                               verbose __attribute__((unused))
+)
+{
+    rtems_profiling_lock_stats stats;
+    rtems_status_code          sc;
+    rtems_id                   id;
+    int                        arg;
+
+    if (argc == 1) {
+        rtems_profiling_lock_report_with_plugin(
+            stdout,
+            (rtems_printk_plugin_t) fprintf
+        );
+        return;
+    }
+
+    for (arg = 1; arg < argc; arg++) {
+        id = (rtems_id) strtoul(argv[arg], 0, 16);
+        sc = rtems_profiling_get_lock_stats(id, &stats);
+        if (sc != RTEMS_SUCCESSFUL) {
+            fprintf(stdout, "0x%08" PRIx32 ": %s\n", id, rtems_status_text(sc));
+            continue;
+        }
+
+        fprintf(stdout,
+            "0x%08" PRIx32 ": acquired %" PRIu32 ", contended %" PRIu32
+            ", wait total %" PRIu64 " ns, wait max %" PRIu64
+            " ns, hold total %" PRIu64 " ns, hold max %" PRIu64 " ns\n",
+            id,
+            stats.usage_count,
+            stats.contention_count,
+            stats.total_wait_time,
+            stats.max_wait_time,
+            stats.total_hold_time,
+            stats.max_hold_time);
+    }
+}
+
 void rtems_monitor_continue_cmd(
   int                                argc __attribute__((unused)),
   char                             **argv __attribute__((unused)),
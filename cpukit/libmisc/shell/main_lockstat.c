@@ -0,0 +1,94 @@
+/*
+ *  LOCKSTAT Command Implementation
+ *
+ *  The license and distribution terms for this file may be
+ *  found in the file LICENSE in this distribution or at
+ *  http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include <rtems.h>
+#include <rtems/profiling.h>
+#include <rtems/shell.h>
+#include "internal.h"
+
+static int rtems_shell_main_lockstat(
+  int   argc,
+  char *argv[]
+)
+{
+  int i;
+  int rv = 0;
+
+  /*
+   *  When invoked with no arguments, print the report of all locks.
+   */
+  if ( argc == 1 ) {
+    rtems_profiling_lock_report_with_plugin(
+      stdout,
+      (rtems_printk_plugin_t) fprintf
+    );
+    return 0;
+  }
+
+  /*
+   *  Otherwise print the statistics of the specified objects.
+   */
+  for ( i = 1; i < argc; ++i ) {
+    rtems_profiling_lock_stats stats;
+    rtems_status_code          sc;
+    rtems_id                   id;
+    char                      *end;
+
+    id = (rtems_id) strtoul( argv[i], &end, 16 );
+    if ( *end != '\0' ) {
+      fprintf( stderr, "%s: invalid id: %s\n", argv[0], argv[i] );
+      rv = -1;
+      continue;
+    }
+
+    sc = rtems_profiling_get_lock_stats( id, &stats );
+    if ( sc != RTEMS_SUCCESSFUL ) {
+      fprintf(
+        stderr,
+        "%s: 0x%08" PRIx32 ": %s\n",
+        argv[0],
+        id,
+        rtems_status_text( sc )
+      );
+      rv = -1;
+      continue;
+    }
+
+    printf(
+      "0x%08" PRIx32 ": acquired %" PRIu32 ", contended %" PRIu32
+        ", wait total %" PRIu64 " ns, wait max %" PRIu64
+        " ns, hold total %" PRIu64 " ns, hold max %" PRIu64 " ns\n",
+      id,
+      stats.usage_count,
+      stats.contention_count,
+      stats.total_wait_time,
+      stats.max_wait_time,
+      stats.total_hold_time,
+      stats.max_hold_time
+    );
+  }
+
+  return rv;
+}
+
+rtems_shell_cmd_t rtems_shell_LOCKSTAT_Command = {
+  "lockstat",                                 /* name */
+  "[id ...] print lock statistics",           /* usage */
+  "rtems",                                    /* topic */
+  rtems_shell_main_lockstat,                  /* command */
+  NULL,                                       /* alias */
+  NULL                                        /* next */
+};
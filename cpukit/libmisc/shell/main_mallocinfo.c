@@ -23,6 +23,54 @@
 
 #include "internal.h"
 
+static rtems_malloc_profiling_snapshot *rtems_shell_malloc_mark;
+
+static int rtems_shell_malloc_profiling(
+  const char *command,
+  const char *subcommand
+)
+{
+  rtems_malloc_profiling_snapshot *snapshot;
+  rtems_status_code sc;
+
+  if ( !strcmp( subcommand, "profile" ) ) {
+    rtems_malloc_profiling_report_with_plugin(
+      stdout,
+      (rtems_printk_plugin_t) fprintf,
+      0
+    );
+    return 0;
+  }
+
+  sc = rtems_malloc_profiling_take_snapshot( &snapshot );
+  if ( sc != RTEMS_SUCCESSFUL ) {
+    fprintf( stderr, "%s: %s\n", command, rtems_status_text( sc ) );
+    return -1;
+  }
+
+  if ( !strcmp( subcommand, "diff" ) ) {
+    if ( rtems_shell_malloc_mark == NULL ) {
+      rtems_malloc_profiling_free_snapshot( snapshot );
+      fprintf( stderr, "%s: no mark\n", command );
+      return -1;
+    }
+
+    rtems_malloc_profiling_report_diff_with_plugin(
+      stdout,
+      (rtems_printk_plugin_t) fprintf,
+      rtems_shell_malloc_mark,
+      snapshot,
+      0
+    );
+    rtems_malloc_profiling_free_snapshot( snapshot );
+  } else {
+    rtems_malloc_profiling_free_snapshot( rtems_shell_malloc_mark );
+    rtems_shell_malloc_mark = snapshot;
+  }
+
+  return 0;
+}
+
 static int rtems_shell_main_malloc_info(
   int   argc,
   char *argv[]
@@ -44,15 +92,21 @@ static int rtems_shell_main_malloc_info(
         (rtems_printk_plugin_t) fprintf
       );
       return 0;
+    } else if (
+      !strcmp( argv[1], "profile" )
+        || !strcmp( argv[1], "mark" )
+        || !strcmp( argv[1], "diff" )
+    ) {
+      return rtems_shell_malloc_profiling( argv[0], argv[1] );
     }
   }
-  fprintf( stderr, "%s: [info|stats]\n", argv[0] );
+  fprintf( stderr, "%s: [info|stats|profile|mark|diff]\n", argv[0] );
   return -1;
 }
 
 rtems_shell_cmd_t rtems_shell_MALLOC_INFO_Command = {
   "malloc",                                   /* name */
-  "[info|stats]",                             /* usage */
+  "[info|stats|profile|mark|diff]",           /* usage */
   "mem",                                      /* topic */
   rtems_shell_main_malloc_info,               /* command */
   NULL,                                       /* alias */
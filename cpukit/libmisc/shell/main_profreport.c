@@ -0,0 +1,60 @@
+/*
+ *  PROFREPORT Command Implementation
+ *
+ *  The license and distribution terms for this file may be
+ *  found in the file LICENSE in this distribution or at
+ *  http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rtems.h>
+#include <rtems/profiling.h>
+#include <rtems/shell.h>
+#include "internal.h"
+
+static int rtems_shell_main_profreport(
+  int   argc,
+  char *argv[]
+)
+{
+  /*
+   *  When invoked with no arguments, print the report.
+   */
+  if ( argc == 1 ) {
+    rtems_profiling_report_with_plugin(
+      stdout,
+      (rtems_printk_plugin_t) fprintf
+    );
+    return 0;
+  }
+
+  /*
+   *  When invoked with the single argument -r, reset the histograms.
+   */
+  if ( argc == 2 && !strcmp( argv[1], "-r" ) ) {
+    printf( "Resetting profiling histograms\n" );
+    rtems_profiling_reset();
+    return 0;
+  }
+
+  /*
+   *  OK.  The user did something wrong.
+   */
+  fprintf( stderr, "%s: [-r]\n", argv[0] );
+  return -1;
+}
+
+rtems_shell_cmd_t rtems_shell_PROFREPORT_Command = {
+  "profreport",                               /* name */
+  "[-r] print or reset profiling histograms", /* usage */
+  "rtems",                                    /* topic */
+  rtems_shell_main_profreport,                /* command */
+  NULL,                                       /* alias */
+  NULL                                        /* next */
+};
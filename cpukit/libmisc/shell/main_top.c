@@ -0,0 +1,182 @@
+/*
+ *  TOP Command Implementation
+ *
+ *  The license and distribution terms for this file may be
+ *  found in the file LICENSE in this distribution or at
+ *  http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define __need_getopt_newlib
+#include <getopt.h>
+
+#include <rtems.h>
+#include <rtems/cpuuse.h>
+#include <rtems/shell.h>
+#include <rtems/stringto.h>
+#include "internal.h"
+
+#define TOP_DEFAULT_PRIORITY 1
+
+static void rtems_shell_top_notification(
+  int   fd,
+  int   seconds_remaining,
+  void *arg
+)
+{
+  (void) fd;
+  (void) seconds_remaining;
+  (void) arg;
+}
+
+static int rtems_shell_main_top(
+  int   argc,
+  char *argv[]
+)
+{
+  struct getopt_data     getopt_reent;
+  rtems_cpu_load_window  window = RTEMS_CPU_LOAD_WINDOW_1_SECOND;
+  rtems_interval         window_seconds = 1;
+  unsigned long          max_threads = 0;
+  unsigned long          delay = 1;
+  unsigned long          priority = TOP_DEFAULT_PRIORITY;
+  bool                   batch = false;
+  rtems_status_code      sc;
+  unsigned long          value;
+  int                    ch;
+
+  memset( &getopt_reent, 0, sizeof( getopt_data ) );
+  while ( ( ch = getopt_r( argc, argv, "bd:n:p:w:", &getopt_reent ) ) != -1 ) {
+    if ( ch != 'b' && ch != '?' ) {
+      sc = rtems_string_to_unsigned_long(
+        getopt_reent.optarg,
+        &value,
+        NULL,
+        0
+      );
+      if ( sc != RTEMS_SUCCESSFUL ) {
+        ch = '?';
+      }
+    }
+
+    switch ( ch ) {
+      case 'b':
+        batch = true;
+        break;
+      case 'd':
+        delay = value > 0 ? value : 1;
+        break;
+      case 'n':
+        max_threads = value;
+        break;
+      case 'p':
+        priority = value;
+        break;
+      case 'w':
+        if ( value == 1 ) {
+          window = RTEMS_CPU_LOAD_WINDOW_1_SECOND;
+          window_seconds = 1;
+          break;
+        } else if ( value == 10 ) {
+          window = RTEMS_CPU_LOAD_WINDOW_10_SECONDS;
+          window_seconds = 10;
+          break;
+        } else if ( value == 60 ) {
+          window = RTEMS_CPU_LOAD_WINDOW_60_SECONDS;
+          window_seconds = 60;
+          break;
+        }
+        /* Fall through */
+      default:
+        fprintf(
+          stderr,
+          "%s: [-b] [-d seconds] [-n threads] [-p priority] [-w 1|10|60]\n",
+          argv[0]
+        );
+        return -1;
+    }
+  }
+
+  /*
+   *  Start the load monitor on demand.  It keeps running afterwards, so that
+   *  the next invocation has the full windows available.
+   */
+  sc = rtems_cpu_load_monitor_start( (rtems_task_priority) priority );
+  if ( sc == RTEMS_SUCCESSFUL ) {
+    /*
+     *  The monitor takes the first sample once it starts and then one sample
+     *  per second.  Wait one tick more than the window, so that the sample
+     *  which completes the window is available.
+     */
+    printf(
+      "Started CPU load monitor, waiting %" PRIu32 " seconds for the "
+        "first window\n",
+      window_seconds
+    );
+    fflush( stdout );
+    rtems_task_wake_after(
+      window_seconds * rtems_clock_get_ticks_per_second() + 1
+    );
+  } else if ( sc != RTEMS_INCORRECT_STATE ) {
+    fprintf(
+      stderr,
+      "%s: cannot start CPU load monitor: %s\n",
+      argv[0],
+      rtems_status_text( sc )
+    );
+    return -1;
+  }
+
+  while ( true ) {
+    if ( !batch ) {
+      /* Clear the screen and move the cursor home */
+      printf( "\033[2J\033[H" );
+    }
+
+    rtems_cpu_load_top_with_plugin(
+      stdout,
+      (rtems_printk_plugin_t) fprintf,
+      window,
+      (uint32_t) max_threads
+    );
+
+    if ( batch ) {
+      break;
+    }
+
+    printf( "Press any key to quit\n" );
+    fflush( stdout );
+
+    /*
+     *  Any input or a terminal without termios support ends the loop.
+     */
+    sc = rtems_shell_wait_for_input(
+      STDIN_FILENO,
+      (int) delay,
+      rtems_shell_top_notification,
+      NULL
+    );
+    if ( sc != RTEMS_TIMEOUT ) {
+      break;
+    }
+  }
+
+  return 0;
+}
+
+rtems_shell_cmd_t rtems_shell_TOP_Command = {
+  "top",                                        /* name */
+  "[-b] [-d s] [-n n] [-p prio] [-w 1|10|60] show cpu load", /* usage */
+  "rtems",                                      /* topic */
+  rtems_shell_main_top,                         /* command */
+  NULL,                                         /* alias */
+  NULL                                          /* next */
+};
@@ -76,8 +76,11 @@ extern rtems_shell_cmd_t rtems_shell_RTC_Command;
 
 extern rtems_shell_cmd_t rtems_shell_HALT_Command;
 extern rtems_shell_cmd_t rtems_shell_CPUUSE_Command;
+extern rtems_shell_cmd_t rtems_shell_TOP_Command;
 extern rtems_shell_cmd_t rtems_shell_STACKUSE_Command;
 extern rtems_shell_cmd_t rtems_shell_PERIODUSE_Command;
+extern rtems_shell_cmd_t rtems_shell_PROFREPORT_Command;
+extern rtems_shell_cmd_t rtems_shell_LOCKSTAT_Command;
 extern rtems_shell_cmd_t rtems_shell_WKSPACE_INFO_Command;
 extern rtems_shell_cmd_t rtems_shell_MALLOC_INFO_Command;
 #if RTEMS_NETWORKING
@@ -395,6 +398,11 @@ extern rtems_shell_alias_t *rtems_shell_Initial_aliases[];
         defined(CONFIGURE_SHELL_COMMAND_CPUUSE)
       &rtems_shell_CPUUSE_Command,
     #endif
+    #if (defined(CONFIGURE_SHELL_COMMANDS_ALL) && \
+         !defined(CONFIGURE_SHELL_NO_COMMAND_TOP)) || \
+        defined(CONFIGURE_SHELL_COMMAND_TOP)
+      &rtems_shell_TOP_Command,
+    #endif
     #if (defined(CONFIGURE_SHELL_COMMANDS_ALL) && \
          !defined(CONFIGURE_SHELL_NO_COMMAND_STACKUSE)) || \
         defined(CONFIGURE_SHELL_COMMAND_STACKUSE)
@@ -405,6 +413,16 @@ extern rtems_shell_alias_t *rtems_shell_Initial_aliases[];
         defined(CONFIGURE_SHELL_COMMAND_PERIODUSE)
       &rtems_shell_PERIODUSE_Command,
     #endif
+    #if (defined(CONFIGURE_SHELL_COMMANDS_ALL) && \
+         !defined(CONFIGURE_SHELL_NO_COMMAND_PROFREPORT)) || \
+        defined(CONFIGURE_SHELL_COMMAND_PROFREPORT)
+      &rtems_shell_PROFREPORT_Command,
+    #endif
+    #if (defined(CONFIGURE_SHELL_COMMANDS_ALL) && \
+         !defined(CONFIGURE_SHELL_NO_COMMAND_LOCKSTAT)) || \
+        defined(CONFIGURE_SHELL_COMMAND_LOCKSTAT)
+      &rtems_shell_LOCKSTAT_Command,
+    #endif
     #if (defined(CONFIGURE_SHELL_COMMANDS_ALL) && \
          !defined(CONFIGURE_SHELL_NO_COMMAND_WKSPACE_INFO)) || \
         defined(CONFIGURE_SHELL_COMMAND_WKSPACE_INFO)
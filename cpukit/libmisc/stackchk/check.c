@@ -46,7 +46,15 @@
 /*
  *  Variable to indicate when the stack checker has been initialized.
  */
-static int   Stack_check_Initialized = 0;
+int   _Stack_check_Initialized = 0;
+
+/*
+ *  Provides the high water marks of the stack usage monitor while it runs.
+ */
+bool (*_Stack_check_Get_monitor_used)(
+  const Thread_Control *the_thread,
+  uint32_t             *used
+);
 
 /*
  *  The "magic pattern" used to mark the end of the stack.
@@ -77,52 +85,6 @@ static inline bool Stack_check_Frame_pointer_in_range(
   return true;
 }
 
-/*
- *  Where the pattern goes in the stack area is dependent upon
- *  whether the stack grow to the high or low area of the memory.
- */
-#if (CPU_STACK_GROWS_UP == TRUE)
-  #define Stack_check_Get_pattern( _the_stack ) \
-    ((char *)(_the_stack)->area + \
-         (_the_stack)->size - sizeof( Stack_check_Control ) )
-
-  #define Stack_check_Calculate_used( _low, _size, _high_water ) \
-      ((char *)(_high_water) - (char *)(_low))
-
-  #define Stack_check_usable_stack_start(_the_stack) \
-    ((_the_stack)->area)
-
-#else
-  /*
-   * We need this magic offset because during a task delete the task stack will
-   * be freed before we enter the task switch extension which checks the stack.
-   * The task stack free operation will write the next and previous pointers
-   * for the free list into this area.
-   */
-  #define Stack_check_Get_pattern( _the_stack ) \
-    ((char *)(_the_stack)->area + sizeof(Heap_Block) - HEAP_BLOCK_HEADER_SIZE)
-
-  #define Stack_check_Calculate_used( _low, _size, _high_water) \
-      ( ((char *)(_low) + (_size)) - (char *)(_high_water) )
-
-  #define Stack_check_usable_stack_start(_the_stack) \
-      ((char *)(_the_stack)->area + sizeof(Stack_check_Control))
-
-#endif
-
-/*
- *  Obtain a properly typed pointer to the area to check.
- */
-#define Stack_check_Get_pattern_area( _the_stack ) \
-  (Stack_check_Control *) Stack_check_Get_pattern( _the_stack )
-
-/*
- *  The assumption is that if the pattern gets overwritten, the task
- *  is too close.  This defines the usable stack memory.
- */
-#define Stack_check_usable_stack_size(_the_stack) \
-    ((_the_stack)->size - sizeof(Stack_check_Control))
-
 #if (CPU_ALLOCATE_INTERRUPT_STACK == TRUE)
   /*
    *  Did RTEMS allocate the interrupt stack? If so, put it in
@@ -150,7 +112,7 @@ static void Stack_check_Initialize( void )
     0xDEADF00D, 0x600D0D06   /* DEAD FOOD but GOOD DOG */
   };
 
-  if ( Stack_check_Initialized )
+  if ( _Stack_check_Initialized )
     return;
 
   /*
@@ -174,7 +136,7 @@ static void Stack_check_Initialize( void )
    }
   #endif
 
-  Stack_check_Initialized = 1;
+  _Stack_check_Initialized = 1;
 }
 
 /*
@@ -319,7 +281,7 @@ bool rtems_stack_checker_is_blown( void )
    * The stack checker must be initialized before the pattern is there
    * to check.
    */
-  if ( Stack_check_Initialized ) {
+  if ( _Stack_check_Initialized ) {
     pattern_ok = (!memcmp(
       Stack_check_Get_pattern(the_stack),
       (void *) Stack_check_Pattern.pattern,
@@ -425,12 +387,21 @@ static void Stack_check_Dump_threads_usage(
   low  = Stack_check_usable_stack_start(stack);
   size = Stack_check_usable_stack_size(stack);
 
-  high_water_mark = Stack_check_find_high_water_mark(low, size);
-
-  if ( high_water_mark )
-    used = Stack_check_Calculate_used( low, size, high_water_mark );
-  else
-    used = 0;
+  /*
+   *  Avoid the scan of the stack if the monitor knows the high water mark.
+   */
+  if (
+    the_thread == NULL
+      || _Stack_check_Get_monitor_used == NULL
+      || !(*_Stack_check_Get_monitor_used)( the_thread, &used )
+  ) {
+    high_water_mark = Stack_check_find_high_water_mark(low, size);
+
+    if ( high_water_mark )
+      used = Stack_check_Calculate_used( low, size, high_water_mark );
+    else
+      used = 0;
+  }
 
 
   #if (CPU_ALLOCATE_INTERRUPT_STACK == TRUE)
@@ -459,7 +430,7 @@ static void Stack_check_Dump_threads_usage(
     size
   );
 
-  if (Stack_check_Initialized == 0) {
+  if (_Stack_check_Initialized == 0) {
     (*print_handler)( print_context, "Unavailable\n" );
   } else {
     (*print_handler)( print_context, "%8" PRId32 "\n", used );
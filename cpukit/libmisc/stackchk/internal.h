@@ -51,6 +51,66 @@ typedef struct {
 #define BYTE_PATTERN 0xA5
 #define U32_PATTERN 0xA5A5A5A5
 
+/*
+ *  Variable to indicate when the stack checker has been initialized.
+ */
+extern int _Stack_check_Initialized;
+
+/*
+ *  The stack usage monitor sets this handler while it runs.  It returns true
+ *  and the high water mark in bytes if the monitor sampled the thread.
+ */
+extern bool (*_Stack_check_Get_monitor_used)(
+  const Thread_Control *the_thread,
+  uint32_t             *used
+);
+
+/*
+ *  Where the pattern goes in the stack area is dependent upon
+ *  whether the stack grow to the high or low area of the memory.
+ */
+#if (CPU_STACK_GROWS_UP == TRUE)
+  #define Stack_check_Get_pattern( _the_stack ) \
+    ((char *)(_the_stack)->area + \
+         (_the_stack)->size - sizeof( Stack_check_Control ) )
+
+  #define Stack_check_Calculate_used( _low, _size, _high_water ) \
+      ((char *)(_high_water) - (char *)(_low))
+
+  #define Stack_check_usable_stack_start(_the_stack) \
+    ((_the_stack)->area)
+
+#else
+  /*
+   * We need this magic offset because during a task delete the task stack will
+   * be freed before we enter the task switch extension which checks the stack.
+   * The task stack free operation will write the next and previous pointers
+   * for the free list into this area.
+   */
+  #define Stack_check_Get_pattern( _the_stack ) \
+    ((char *)(_the_stack)->area + sizeof(Heap_Block) - HEAP_BLOCK_HEADER_SIZE)
+
+  #define Stack_check_Calculate_used( _low, _size, _high_water) \
+      ( ((char *)(_low) + (_size)) - (char *)(_high_water) )
+
+  #define Stack_check_usable_stack_start(_the_stack) \
+      ((char *)(_the_stack)->area + sizeof(Stack_check_Control))
+
+#endif
+
+/*
+ *  Obtain a properly typed pointer to the area to check.
+ */
+#define Stack_check_Get_pattern_area( _the_stack ) \
+  (Stack_check_Control *) Stack_check_Get_pattern( _the_stack )
+
+/*
+ *  The assumption is that if the pattern gets overwritten, the task
+ *  is too close.  This defines the usable stack memory.
+ */
+#define Stack_check_usable_stack_size(_the_stack) \
+    ((_the_stack)->size - sizeof(Stack_check_Control))
+
 /*
  *  rtems_stack_checker_create_extension
  */
@@ -26,6 +26,9 @@
 
 #include <rtems/score/percpu.h> /* Thread_Control */
 #include <rtems/bspIo.h>
+#include <rtems/rtems/status.h>
+#include <rtems/rtems/tasks.h>
+#include <rtems/rtems/types.h>
 
 /**
  *  @defgroup libmisc_stackchk Stack Checker Mechanism
@@ -75,6 +78,166 @@ void rtems_stack_checker_report_usage_with_plugin(
   rtems_printk_plugin_t  print
 );
 
+/**
+ * @brief Count of thresholds of the stack usage monitor.
+ */
+#define RTEMS_STACK_CHECKER_THRESHOLDS 3
+
+/**
+ * @brief Count of high water mark increases kept per thread by the stack
+ * usage monitor.
+ */
+#define RTEMS_STACK_CHECKER_HISTORY 8
+
+/**
+ * @brief Increase of the high water mark of a thread stack.
+ */
+typedef struct {
+  /**
+   * @brief Clock ticks since boot at the detection of the increase.
+   */
+  rtems_interval ticks;
+
+  /**
+   * @brief The new high water mark in bytes.
+   */
+  uint32_t used;
+} rtems_stack_checker_peak;
+
+/**
+ * @brief Stack usage of a thread sampled by the stack usage monitor.
+ */
+typedef struct {
+  /**
+   * @brief The thread identifier.
+   */
+  rtems_id id;
+
+  /**
+   * @brief The usable stack size in bytes.
+   */
+  uint32_t size;
+
+  /**
+   * @brief The high water mark in bytes found so far.
+   */
+  uint32_t used;
+
+  /**
+   * @brief Count of completed scans of the unused stack area.
+   */
+  uint32_t scan_cycles;
+
+  /**
+   * @brief Count of valid entries in the peak history.
+   */
+  uint32_t peak_count;
+
+  /**
+   * @brief The last increases of the high water mark, oldest first.
+   */
+  rtems_stack_checker_peak peaks[ RTEMS_STACK_CHECKER_HISTORY ];
+} rtems_stack_checker_usage;
+
+/**
+ * @brief Stack usage warning handler.
+ *
+ * @param[in] usage is the stack usage of the thread
+ * @param[in] threshold is the exceeded threshold in percent of the usable
+ * stack size
+ */
+typedef void (*rtems_stack_checker_warning_handler)(
+  const rtems_stack_checker_usage *usage,
+  uint32_t                         threshold
+);
+
+/**
+ * @brief Stack usage monitor configuration.
+ */
+typedef struct {
+  /**
+   * @brief The priority of the monitor task.
+   */
+  rtems_task_priority priority;
+
+  /**
+   * @brief The clock ticks between two runs of the monitor.
+   */
+  rtems_interval period;
+
+  /**
+   * @brief The maximum count of stack bytes scanned in one run.
+   */
+  uint32_t budget;
+
+  /**
+   * @brief The warning thresholds in percent of the usable stack size.
+   *
+   * A threshold of zero is disabled.
+   */
+  uint32_t thresholds[ RTEMS_STACK_CHECKER_THRESHOLDS ];
+
+  /**
+   * @brief The warning handler.
+   *
+   * In case it is NULL, the warnings are printed via printk().
+   */
+  rtems_stack_checker_warning_handler warning;
+} rtems_stack_checker_monitor_config;
+
+/**
+ * @brief Starts the stack usage monitor.
+ *
+ * The monitor task samples the stack high water marks of all threads in the
+ * background.  Each run scans at most the configured budget of stack bytes.
+ * The unused area of a stack is scanned from its far end towards the known
+ * high water mark, so a scan cycle of a thread may span several runs.  Each
+ * threshold exceeded by a thread is reported once to the warning handler.
+ * While the monitor runs, the stack usage report uses the sampled high water
+ * marks instead of scanning the stacks.
+ *
+ * The stack checker must be enabled with CONFIGURE_STACK_CHECKER_ENABLED.
+ *
+ * @param[in] config is the monitor configuration
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ADDRESS The configuration is NULL.
+ * @retval RTEMS_INVALID_NUMBER The period or the budget is zero.
+ * @retval RTEMS_NOT_CONFIGURED The stack checker is not enabled.
+ * @retval RTEMS_INCORRECT_STATE The monitor is already started.
+ * @retval RTEMS_NO_MEMORY Not enough memory for the thread tables.
+ *
+ * @see rtems_task_create() for other status codes.
+ */
+rtems_status_code rtems_stack_checker_monitor_start(
+  const rtems_stack_checker_monitor_config *config
+);
+
+/**
+ * @brief Stops the stack usage monitor.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INCORRECT_STATE The monitor is not started.
+ */
+rtems_status_code rtems_stack_checker_monitor_stop( void );
+
+/**
+ * @brief Gets the stack usage of a thread sampled by the stack usage monitor.
+ *
+ * @param[in] id is the thread identifier, RTEMS_SELF selects the executing
+ * thread
+ * @param[out] usage is the stack usage
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_INVALID_ADDRESS The usage is NULL.
+ * @retval RTEMS_INCORRECT_STATE The monitor is not started.
+ * @retval RTEMS_INVALID_ID No such thread or the thread was not sampled yet.
+ */
+rtems_status_code rtems_stack_checker_get_usage(
+  rtems_id                   id,
+  rtems_stack_checker_usage *usage
+);
+
 /*************************************************************
  *************************************************************
  **  Prototyped only so the user extension can be installed **
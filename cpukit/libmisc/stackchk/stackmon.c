@@ -0,0 +1,618 @@
+/**
+ * @file
+ *
+ * @brief Stack Usage Monitor
+ * @ingroup libmisc_stackchk Stack Checker Mechanism
+ */
+
+/*
+ *  The license and distribution terms for this file may be
+ *  found in the file LICENSE in this distribution or at
+ *  http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rtems/bspIo.h>
+#include <rtems/stackchk.h>
+#include <rtems/score/objectimpl.h>
+#include <rtems/score/threaddispatch.h>
+#include "internal.h"
+
+#define STACK_CHECK_MONITOR_STOP_EVENT RTEMS_EVENT_0
+
+/*
+ *  The threads are the first object class of each API.
+ */
+#define STACK_CHECK_MONITOR_THREAD_CLASS 1
+
+/*
+ *  Thread dispatching is disabled while a stack is scanned, so the scan is
+ *  split into chunks of this count of words to bound the dispatch latency.
+ */
+#define STACK_CHECK_MONITOR_CHUNK_WORDS 64
+
+/*
+ *  The stack words are indexed from the far end of the stack, i.e. the end
+ *  which is reached last by the stack pointer.  The words from the mark up to
+ *  the near end are known to be used.  A scan cycle checks the words from the
+ *  far end up to the mark for changes of the fill pattern.
+ */
+typedef struct {
+  rtems_id                 id;
+  uint32_t                 size;
+  uint32_t                 used;
+  uint32_t                 mark;
+  uint32_t                 scanned;
+  uint32_t                 scan_cycles;
+  uint32_t                 peak_count;
+  uint32_t                 warned;
+  bool                     sampled;
+  rtems_stack_checker_peak peaks[ RTEMS_STACK_CHECKER_HISTORY ];
+} Stack_check_Monitor_Thread;
+
+/*
+ *  The entries of all threads are kept in one table of slots.  The entries of
+ *  an API start at its first slot and are in object index order.  The last
+ *  element of the first slots is the slot count.
+ */
+typedef struct {
+  rtems_id                            task_id;
+  bool                                starting;
+  rtems_id                            stop_requester;
+  rtems_stack_checker_monitor_config  config;
+  uint32_t                            cursor;
+  uint32_t                            first_slot[ OBJECTS_APIS_LAST + 2 ];
+  Stack_check_Monitor_Thread         *slots;
+} Stack_check_Monitor_Control;
+
+static Stack_check_Monitor_Control Stack_check_Monitor;
+
+static uint32_t Stack_check_Monitor_Get_slot_count( void )
+{
+  return Stack_check_Monitor.first_slot[ OBJECTS_APIS_LAST + 1 ];
+}
+
+static Objects_Information *Stack_check_Monitor_Get_threads(
+  uint32_t api_index
+)
+{
+  return _Objects_Get_information(
+    (Objects_APIs) api_index,
+    STACK_CHECK_MONITOR_THREAD_CLASS
+  );
+}
+
+/*
+ *  The thread maximum of an API changes in case its thread objects are
+ *  unlimited.  The slots are then laid out anew in a fresh table, which only
+ *  this function installs and only with thread dispatching disabled.  The
+ *  entries of each API move to its new first slot.  The old table is kept if
+ *  no memory is available.
+ */
+static void Stack_check_Monitor_Update_layout( void )
+{
+  uint32_t                    first_slot[ OBJECTS_APIS_LAST + 2 ];
+  Stack_check_Monitor_Thread *slots;
+  Stack_check_Monitor_Thread *old_slots;
+  uint32_t                    api_index;
+
+  first_slot[ 1 ] = 0;
+  for ( api_index = 1 ; api_index <= OBJECTS_APIS_LAST ; api_index++ ) {
+    Objects_Information *information =
+      Stack_check_Monitor_Get_threads( api_index );
+
+    first_slot[ api_index + 1 ] = first_slot[ api_index ]
+      + ( information ? information->maximum : 0 );
+  }
+
+  if (
+    Stack_check_Monitor.slots
+      && memcmp(
+        &first_slot[ 1 ],
+        &Stack_check_Monitor.first_slot[ 1 ],
+        OBJECTS_APIS_LAST * sizeof( first_slot[ 0 ] )
+      ) == 0
+  ) {
+    return;
+  }
+
+  slots = calloc( first_slot[ OBJECTS_APIS_LAST + 1 ], sizeof( *slots ) );
+  if ( !slots )
+    return;
+
+  _Thread_Disable_dispatch();
+    old_slots = Stack_check_Monitor.slots;
+
+    for ( api_index = 1 ; api_index <= OBJECTS_APIS_LAST ; api_index++ ) {
+      uint32_t old_first = Stack_check_Monitor.first_slot[ api_index ];
+      uint32_t old_count =
+        Stack_check_Monitor.first_slot[ api_index + 1 ] - old_first;
+      uint32_t count = first_slot[ api_index + 1 ] - first_slot[ api_index ];
+
+      if ( old_slots && old_count > 0 ) {
+        memcpy(
+          &slots[ first_slot[ api_index ] ],
+          &old_slots[ old_first ],
+          ( count < old_count ? count : old_count ) * sizeof( *slots )
+        );
+      }
+    }
+
+    memcpy(
+      Stack_check_Monitor.first_slot,
+      first_slot,
+      sizeof( Stack_check_Monitor.first_slot )
+    );
+    Stack_check_Monitor.slots = slots;
+
+    if ( Stack_check_Monitor.cursor >= Stack_check_Monitor_Get_slot_count() )
+      Stack_check_Monitor.cursor = 0;
+  _Thread_Enable_dispatch();
+
+  free( old_slots );
+}
+
+/*
+ *  Thread dispatching must be disabled.
+ */
+static Stack_check_Monitor_Thread *Stack_check_Monitor_Find( rtems_id id )
+{
+  uint32_t api_index = _Objects_Get_API( id );
+  uint32_t index = _Objects_Get_index( id );
+  uint32_t slot;
+
+  if (
+    !Stack_check_Monitor.slots
+      || api_index < 1
+      || api_index > OBJECTS_APIS_LAST
+      || index < 1
+  ) {
+    return NULL;
+  }
+
+  slot = Stack_check_Monitor.first_slot[ api_index ] + index - 1;
+  if ( slot >= Stack_check_Monitor.first_slot[ api_index + 1 ] )
+    return NULL;
+
+  return &Stack_check_Monitor.slots[ slot ];
+}
+
+/*
+ *  Returns the thread which owns the slot or NULL if the slot is free.  Thread
+ *  dispatching must be disabled.
+ */
+static Thread_Control *Stack_check_Monitor_Get_thread( uint32_t slot )
+{
+  Objects_Information *information;
+  uint32_t             api_index = 1;
+  uint32_t             index;
+
+  while ( slot >= Stack_check_Monitor.first_slot[ api_index + 1 ] )
+    api_index++;
+
+  information = Stack_check_Monitor_Get_threads( api_index );
+  index = slot - Stack_check_Monitor.first_slot[ api_index ] + 1;
+
+  if ( !information || index > information->maximum )
+    return NULL;
+
+  return (Thread_Control *) information->local_table[ index ];
+}
+
+/*
+ *  Thread dispatching must be disabled.
+ */
+static void Stack_check_Monitor_Get_usage(
+  const Stack_check_Monitor_Thread *entry,
+  rtems_stack_checker_usage        *usage
+)
+{
+  uint32_t count = entry->peak_count;
+  uint32_t first = 0;
+  uint32_t i;
+
+  if ( count > RTEMS_STACK_CHECKER_HISTORY ) {
+    first = count % RTEMS_STACK_CHECKER_HISTORY;
+    count = RTEMS_STACK_CHECKER_HISTORY;
+  }
+
+  usage->id = entry->id;
+  usage->size = entry->size;
+  usage->used = entry->used;
+  usage->scan_cycles = entry->scan_cycles;
+  usage->peak_count = count;
+
+  for ( i = 0 ; i < count ; i++ ) {
+    uint32_t slot = ( first + i ) % RTEMS_STACK_CHECKER_HISTORY;
+
+    usage->peaks[ i ] = entry->peaks[ slot ];
+  }
+}
+
+static void Stack_check_Monitor_Start_entry(
+  Stack_check_Monitor_Thread *entry,
+  Thread_Control             *the_thread
+)
+{
+  Stack_Control *stack = &the_thread->Start.Initial_stack;
+
+  memset( entry, 0, sizeof( *entry ) );
+  entry->id = the_thread->Object.id;
+  entry->size = Stack_check_usable_stack_size( stack );
+  entry->mark = entry->size / sizeof( uint32_t );
+}
+
+/*
+ *  Returns a bit for each threshold exceeded for the first time.  Thread
+ *  dispatching must be disabled.
+ */
+static uint32_t Stack_check_Monitor_Check_thresholds(
+  Stack_check_Monitor_Thread *entry
+)
+{
+  const uint32_t *thresholds = Stack_check_Monitor.config.thresholds;
+  uint64_t        percent;
+  uint32_t        exceeded = 0;
+  uint32_t        i;
+
+  if ( entry->size == 0 )
+    return 0;
+
+  percent = ( (uint64_t) entry->used * 100 ) / entry->size;
+
+  for ( i = 0 ; i < RTEMS_STACK_CHECKER_THRESHOLDS ; i++ ) {
+    uint32_t bit = UINT32_C(1) << i;
+
+    if (
+      thresholds[ i ] != 0
+        && percent >= thresholds[ i ]
+        && ( entry->warned & bit ) == 0
+    ) {
+      exceeded |= bit;
+    }
+  }
+
+  entry->warned |= exceeded;
+
+  return exceeded;
+}
+
+/*
+ *  Scans at most one chunk of the unused stack area of the thread and returns
+ *  the count of scanned words.  Thread dispatching must be disabled.
+ */
+static uint32_t Stack_check_Monitor_Scan(
+  Stack_check_Monitor_Thread *entry,
+  Thread_Control             *the_thread,
+  uint32_t                    budget,
+  bool                       *cycle_done
+)
+{
+  Stack_Control  *stack = &the_thread->Start.Initial_stack;
+  const uint32_t *low =
+    (const uint32_t *) Stack_check_usable_stack_start( stack );
+  uint32_t        begin = entry->scanned;
+  uint32_t        end = entry->mark;
+  uint32_t        i;
+
+  if ( end - begin > budget )
+    end = begin + budget;
+
+  if ( end - begin > STACK_CHECK_MONITOR_CHUNK_WORDS )
+    end = begin + STACK_CHECK_MONITOR_CHUNK_WORDS;
+
+  for ( i = begin ; i < end ; i++ ) {
+    #if (CPU_STACK_GROWS_UP == TRUE)
+      const uint32_t *word = low + entry->size / sizeof( uint32_t ) - 1 - i;
+    #else
+      const uint32_t *word = low + i;
+    #endif
+
+    if ( *word != U32_PATTERN ) {
+      uint32_t slot = entry->peak_count % RTEMS_STACK_CHECKER_HISTORY;
+
+      entry->mark = i;
+      entry->used = Stack_check_Calculate_used( low, entry->size, word );
+      entry->peaks[ slot ].ticks = rtems_clock_get_ticks_since_boot();
+      entry->peaks[ slot ].used = entry->used;
+      entry->peak_count++;
+
+      *cycle_done = true;
+      return i - begin + 1;
+    }
+  }
+
+  entry->scanned = end;
+  *cycle_done = end == entry->mark;
+
+  return end - begin;
+}
+
+static void Stack_check_Monitor_Warn(
+  const rtems_stack_checker_usage *usage,
+  uint32_t                         exceeded
+)
+{
+  rtems_stack_checker_warning_handler warning =
+    Stack_check_Monitor.config.warning;
+  uint32_t i;
+
+  for ( i = 0 ; i < RTEMS_STACK_CHECKER_THRESHOLDS ; i++ ) {
+    uint32_t threshold = Stack_check_Monitor.config.thresholds[ i ];
+
+    if ( ( exceeded & ( UINT32_C(1) << i ) ) == 0 )
+      continue;
+
+    if ( warning ) {
+      (*warning)( usage, threshold );
+    } else {
+      printk(
+        "STACK WARNING: task 0x%08" PRIx32 " uses %" PRIu32 " of %" PRIu32
+          " bytes (threshold %" PRIu32 "%%)\n",
+        usage->id,
+        usage->used,
+        usage->size,
+        threshold
+      );
+    }
+  }
+}
+
+/*
+ *  Visits the threads in a round-robin order starting at the cursor until the
+ *  budget is exhausted or each thread was visited once.
+ */
+static void Stack_check_Monitor_Run( void )
+{
+  uint32_t budget = Stack_check_Monitor.config.budget / sizeof( uint32_t );
+  uint32_t slot_count;
+  uint32_t visited = 0;
+
+  /*
+   *  Only this task changes the layout, so the slot count is stable until the
+   *  next run.
+   */
+  Stack_check_Monitor_Update_layout();
+  slot_count = Stack_check_Monitor_Get_slot_count();
+
+  if ( budget == 0 )
+    budget = 1;
+
+  while ( budget > 0 && visited < slot_count ) {
+    Stack_check_Monitor_Thread *entry;
+    Thread_Control             *the_thread;
+    rtems_stack_checker_usage   usage;
+    uint32_t                    exceeded = 0;
+    bool                        cycle_done = true;
+
+    _Thread_Disable_dispatch();
+
+    entry = &Stack_check_Monitor.slots[ Stack_check_Monitor.cursor ];
+    the_thread = Stack_check_Monitor_Get_thread( Stack_check_Monitor.cursor );
+
+    if ( !the_thread ) {
+      entry->id = 0;
+    } else {
+      if ( entry->id != the_thread->Object.id )
+        Stack_check_Monitor_Start_entry( entry, the_thread );
+
+      budget -= Stack_check_Monitor_Scan(
+        entry,
+        the_thread,
+        budget,
+        &cycle_done
+      );
+
+      if ( cycle_done ) {
+        entry->scanned = 0;
+        entry->scan_cycles++;
+        entry->sampled = true;
+
+        exceeded = Stack_check_Monitor_Check_thresholds( entry );
+        if ( exceeded )
+          Stack_check_Monitor_Get_usage( entry, &usage );
+      }
+    }
+
+    if ( cycle_done ) {
+      Stack_check_Monitor.cursor =
+        ( Stack_check_Monitor.cursor + 1 ) % slot_count;
+      visited++;
+    }
+
+    _Thread_Enable_dispatch();
+
+    if ( exceeded )
+      Stack_check_Monitor_Warn( &usage, exceeded );
+  }
+}
+
+static bool Stack_check_Monitor_Get_used(
+  const Thread_Control *the_thread,
+  uint32_t             *used
+)
+{
+  const Stack_check_Monitor_Thread *entry;
+  bool                              sampled = false;
+
+  _Thread_Disable_dispatch();
+
+  entry = Stack_check_Monitor_Find( the_thread->Object.id );
+  if ( entry && entry->id == the_thread->Object.id && entry->sampled ) {
+    *used = entry->used;
+    sampled = true;
+  }
+
+  _Thread_Enable_dispatch();
+
+  return sampled;
+}
+
+/*
+ *  The stop request deletes this task once it acknowledged the request.  The
+ *  task only waits for the request, so it owns no resources at this point.
+ */
+static rtems_task Stack_check_Monitor_Task( rtems_task_argument arg )
+{
+  rtems_event_set   events;
+  rtems_status_code sc;
+
+  (void) arg;
+
+  do {
+    Stack_check_Monitor_Run();
+
+    sc = rtems_event_receive(
+      STACK_CHECK_MONITOR_STOP_EVENT,
+      RTEMS_EVENT_ANY | RTEMS_WAIT,
+      Stack_check_Monitor.config.period,
+      &events
+    );
+  } while ( sc == RTEMS_TIMEOUT );
+
+  rtems_event_transient_send( Stack_check_Monitor.stop_requester );
+  rtems_task_suspend( RTEMS_SELF );
+}
+
+static void Stack_check_Monitor_Release( rtems_id task_id )
+{
+  Stack_check_Monitor_Thread *slots;
+
+  rtems_task_delete( task_id );
+
+  _Thread_Disable_dispatch();
+    _Stack_check_Get_monitor_used = NULL;
+    slots = Stack_check_Monitor.slots;
+    Stack_check_Monitor.slots = NULL;
+    memset(
+      Stack_check_Monitor.first_slot,
+      0,
+      sizeof( Stack_check_Monitor.first_slot )
+    );
+    Stack_check_Monitor.task_id = 0;
+  _Thread_Enable_dispatch();
+
+  free( slots );
+}
+
+rtems_status_code rtems_stack_checker_monitor_start(
+  const rtems_stack_checker_monitor_config *config
+)
+{
+  rtems_status_code sc;
+  rtems_id          id;
+  bool              in_use;
+
+  if ( !config )
+    return RTEMS_INVALID_ADDRESS;
+
+  if ( config->period == 0 || config->budget == 0 )
+    return RTEMS_INVALID_NUMBER;
+
+  if ( _Stack_check_Initialized == 0 )
+    return RTEMS_NOT_CONFIGURED;
+
+  /*
+   *  The task identifier is only set after the task creation, so claim the
+   *  monitor first to turn away a concurrent start request.
+   */
+  _Thread_Disable_dispatch();
+    in_use = Stack_check_Monitor.task_id != 0 || Stack_check_Monitor.starting;
+    if ( !in_use )
+      Stack_check_Monitor.starting = true;
+  _Thread_Enable_dispatch();
+
+  if ( in_use )
+    return RTEMS_INCORRECT_STATE;
+
+  sc = rtems_task_create(
+    rtems_build_name( 'S', 'T', 'K', 'M' ),
+    config->priority,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  if ( sc != RTEMS_SUCCESSFUL ) {
+    Stack_check_Monitor.starting = false;
+    return sc;
+  }
+
+  Stack_check_Monitor.config = *config;
+  Stack_check_Monitor.cursor = 0;
+  Stack_check_Monitor.task_id = id;
+
+  Stack_check_Monitor_Update_layout();
+  if ( !Stack_check_Monitor.slots ) {
+    Stack_check_Monitor_Release( id );
+    Stack_check_Monitor.starting = false;
+    return RTEMS_NO_MEMORY;
+  }
+
+  _Stack_check_Get_monitor_used = Stack_check_Monitor_Get_used;
+
+  sc = rtems_task_start( id, Stack_check_Monitor_Task, 0 );
+  if ( sc != RTEMS_SUCCESSFUL )
+    Stack_check_Monitor_Release( id );
+
+  Stack_check_Monitor.starting = false;
+
+  return sc;
+}
+
+rtems_status_code rtems_stack_checker_monitor_stop( void )
+{
+  rtems_id task_id = Stack_check_Monitor.task_id;
+
+  if ( task_id == 0 || Stack_check_Monitor.starting )
+    return RTEMS_INCORRECT_STATE;
+
+  Stack_check_Monitor.stop_requester = rtems_task_self();
+  rtems_event_send( task_id, STACK_CHECK_MONITOR_STOP_EVENT );
+  rtems_event_transient_receive( RTEMS_WAIT, RTEMS_NO_TIMEOUT );
+
+  Stack_check_Monitor_Release( task_id );
+
+  return RTEMS_SUCCESSFUL;
+}
+
+rtems_status_code rtems_stack_checker_get_usage(
+  rtems_id                   id,
+  rtems_stack_checker_usage *usage
+)
+{
+  const Stack_check_Monitor_Thread *entry;
+  rtems_status_code                 sc;
+
+  if ( !usage )
+    return RTEMS_INVALID_ADDRESS;
+
+  if ( id == RTEMS_SELF )
+    id = rtems_task_self();
+
+  _Thread_Disable_dispatch();
+
+  if ( Stack_check_Monitor.task_id == 0 ) {
+    sc = RTEMS_INCORRECT_STATE;
+  } else {
+    entry = Stack_check_Monitor_Find( id );
+    if ( entry && entry->id == id && entry->sampled ) {
+      Stack_check_Monitor_Get_usage( entry, usage );
+      sc = RTEMS_SUCCESSFUL;
+    } else {
+      sc = RTEMS_INVALID_ID;
+    }
+  }
+
+  _Thread_Enable_dispatch();
+
+  return sc;
+}
@@ -304,9 +304,12 @@ bad:
  * Process a received Ethernet packet;
  * the packet is in the mbuf chain m without
  * the ether header, which is provided separately.
+ * The software interrupts to schedule for IP and
+ * ARP are returned in isrs.
  */
-void
-ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
+static void
+ether_input_one(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m,
+    int *isrs)
 {
 	register struct ifqueue *inq;
 	u_short ether_type;
@@ -342,12 +345,12 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 	switch (ether_type) {
 #ifdef INET
 	case ETHERTYPE_IP:
-		schednetisr(NETISR_IP);
+		*isrs |= 1 << NETISR_IP;
 		inq = &ipintrq;
 		break;
 
 	case ETHERTYPE_ARP:
-		schednetisr(NETISR_ARP);
+		*isrs |= 1 << NETISR_ARP;
 		inq = &arpintrq;
 		break;
 #endif
@@ -509,6 +512,48 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 	splx(s);
 }
 
+static void
+ether_schednetisrs(int isrs)
+{
+	if (isrs & (1 << NETISR_IP))
+		schednetisr(NETISR_IP);
+	if (isrs & (1 << NETISR_ARP))
+		schednetisr(NETISR_ARP);
+}
+
+void
+ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
+{
+	int isrs = 0;
+
+	ether_input_one(ifp, eh, m, &isrs);
+	ether_schednetisrs(isrs);
+}
+
+/*
+ * Process a batch of received Ethernet packets linked by m_nextpkt.
+ * Each packet starts with its ether header and m_pkthdr.rcvif must
+ * be set.  The network daemon is woken up once for the whole batch.
+ */
+void
+ether_input_batch(struct mbuf *m)
+{
+	struct mbuf *next;
+	struct ether_header *eh;
+	int isrs = 0;
+
+	for (; m != NULL; m = next) {
+		next = m->m_nextpkt;
+		m->m_nextpkt = NULL;
+		eh = mtod(m, struct ether_header *);
+		m->m_data += sizeof(*eh);
+		m->m_len -= sizeof(*eh);
+		m->m_pkthdr.len -= sizeof(*eh);
+		ether_input_one(m->m_pkthdr.rcvif, eh, m, &isrs);
+	}
+	ether_schednetisrs(isrs);
+}
+
 /*
  * Convert Ethernet address to printable (loggable) representation.
  * The static buffer isn't a really huge problem since this code
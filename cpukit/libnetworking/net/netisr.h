@@ -50,6 +50,7 @@
  * on the lowest level routine of each protocol.
  */
 #define	NETISR_RAW	0		/* same as AF_UNSPEC */
+#define	NETISR_DEFER	1		/* RTEMS: deferred driver input */
 #define	NETISR_IP	2		/* same as AF_INET */
 #define	NETISR_IMP	3		/* same as AF_IMPLINK */
 #define	NETISR_ISO	7		/* same as AF_ISO */
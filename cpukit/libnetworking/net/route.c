@@ -58,9 +58,26 @@
 #define	SA(p) ((struct sockaddr *)(p))
 
 struct route_cb route_cb;
-static struct rtstat rtstat;
+struct rtstat rtstat;
 struct radix_node_head *rt_tables[AF_MAX+1];
 
+/*
+ * Direct mapped cache of the IPv4 route lookups done on behalf of
+ * packets, so that forwarding between several destinations does not
+ * search the radix tree for every packet.  Each entry holds a reference
+ * to its route.  The cache is flushed whenever a route is added,
+ * deleted or changed.
+ */
+#define	RTCACHE_SIZE	32		/* must be a power of two */
+#define	RTCACHE_HASH(a) \
+	(((a) ^ ((a) >> 8) ^ ((a) >> 16) ^ ((a) >> 24)) & (RTCACHE_SIZE - 1))
+
+static struct rtcache {
+	u_int32_t	rc_dst;		/* destination, network order */
+	u_long		rc_ignflags;	/* ignflags of the lookup */
+	struct rtentry	*rc_rt;		/* referenced route */
+} rtcache[RTCACHE_SIZE];
+
 static int	rttrash;		/* routes not in table but not freed */
 
 static void rt_maskedcopy(struct sockaddr *,
@@ -121,8 +138,27 @@ rtalloc1(struct sockaddr *dst, int report, u_long ignflags)
 	u_long nflags;
 	int  s = splnet();
 	int err = 0, msgtype = RTM_MISS;
+	struct rtcache *rc = NULL;
+	u_int32_t a = 0;
 
 	newrt = NULL;
+	/*
+	 * Try the route cache first.  Only lookups which report
+	 * failures are done on behalf of packets.
+	 */
+	if (report && dst->sa_family == AF_INET) {
+		a = ((struct sockaddr_in *)dst)->sin_addr.s_addr;
+		rc = &rtcache[RTCACHE_HASH(a)];
+		rt = rc->rc_rt;
+		if (rt && rc->rc_dst == a && rc->rc_ignflags == ignflags &&
+		    (rt->rt_flags & RTF_UP)) {
+			rtstat.rts_cachehit++;
+			rt->rt_refcnt++;
+			splx(s);
+			return (rt);
+		}
+		rtstat.rts_cachemiss++;
+	}
 	/*
 	 * Look up the address in the table for that Address Family
 	 */
@@ -168,7 +204,8 @@ rtalloc1(struct sockaddr *dst, int report, u_long ignflags)
 		 * "caint get there frm here"
 		 */
 		rtstat.rts_unreach++;
-	miss:	if (report) {
+	miss:	rc = NULL;
+		if (report) {
 			/*
 			 * If required, report the failure to the supervising
 			 * Authorities.
@@ -179,10 +216,35 @@ rtalloc1(struct sockaddr *dst, int report, u_long ignflags)
 			rt_missmsg(msgtype, &info, 0, err);
 		}
 	}
+	if (rc && newrt) {
+		newrt->rt_refcnt++;
+		if ((rt = rc->rc_rt) != NULL)
+			RTFREE(rt);
+		rc->rc_dst = a;
+		rc->rc_ignflags = ignflags;
+		rc->rc_rt = newrt;
+	}
 	splx(s);
 	return (newrt);
 }
 
+/*
+ * Drop all routes from the route cache.
+ */
+void
+rtcache_flush(void)
+{
+	struct rtentry *rt;
+	int i;
+
+	for (i = 0; i < RTCACHE_SIZE; i++) {
+		if ((rt = rtcache[i].rc_rt) != NULL) {
+			rtcache[i].rc_rt = NULL;
+			RTFREE(rt);
+		}
+	}
+}
+
 /*
  * Remove a reference count from an rtentry.
  * If the count gets low enough, take it out of the routing table
@@ -592,6 +654,13 @@ rtrequest(int req, struct sockaddr *dst, struct sockaddr *gateway,
 		}
 		break;
 	}
+	/*
+	 * A new network route may be more specific than cached
+	 * routes.  A cloned host route only affects its own
+	 * destination, which is not in the cache yet.
+	 */
+	if (req != RTM_RESOLVE)
+		rtcache_flush();
 bad:
 	splx(s);
 	return (error);
@@ -167,6 +167,8 @@ struct	rtstat {
 	short	rts_newgateway;		/* routes modified by redirects */
 	short	rts_unreach;		/* lookups which failed */
 	short	rts_wildcard;		/* lookups satisfied by a wildcard */
+	u_long	rts_cachehit;		/* lookups satisfied by the route cache */
+	u_long	rts_cachemiss;		/* lookups which missed the route cache */
 };
 /*
  * Structures for routing messages.
@@ -270,6 +272,7 @@ struct route_cb {
 	} while (0)
 
 extern struct route_cb route_cb;
+extern struct rtstat rtstat;
 extern struct radix_node_head *rt_tables[AF_MAX+1];
 
 void	 route_init(void);
@@ -277,6 +280,7 @@ void	 rt_ifmsg(struct ifnet *);
 void	 rt_missmsg(int, struct rt_addrinfo *, int, int);
 void	 rt_newaddrmsg(int, struct ifaddr *, int, struct rtentry *);
 int	 rt_setgate(struct rtentry *, struct sockaddr *, struct sockaddr *);
+void	 rtcache_flush(void);
 void	 rtalloc_ign(struct route *, unsigned long);
 void	 rtalloc(struct route *ro); /* XXX deprecated, use rtalloc_ign(ro, 0) */
 struct rtentry *
@@ -299,6 +299,11 @@ route_output(struct mbuf *m, struct socket *so)
 			       rt->rt_ifa->ifa_rtrequest(RTM_ADD, rt, info.rti_info[RTAX_GATEWAY]);
 			if (info.rti_info[RTAX_GENMASK])
 				rt->rt_genmask = info.rti_info[RTAX_GENMASK];
+			/*
+			 * Cloned routes in the route cache may still
+			 * refer to the old gateway.
+			 */
+			rtcache_flush();
 			/* FALLTHROUGH */
 		case RTM_LOCK:
 			rt->rt_rmx.rmx_locks &= ~(rtm->rtm_inits);
@@ -435,6 +435,9 @@ struct ifnet; struct mbuf;	/* forward declarations for Standard C */
 int	 in_broadcast(struct in_addr, struct ifnet *);
 int	 in_canforward(struct in_addr);
 int	 in_cksum(struct mbuf *, int);
+int	 in_cksum_generic(struct mbuf *, int);
+u_int	 in_cksum_copy(const void *, void *, int, u_int);
+u_int	 in_cksum_copydata(const struct mbuf *, int, int, void *);
 int	 in_localaddr(struct in_addr);
 char 	*inet_ntoa(struct in_addr); /* in libkern */
 
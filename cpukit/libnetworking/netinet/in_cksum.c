@@ -35,6 +35,287 @@
 
 #include <sys/param.h>
 #include <sys/mbuf.h>
+#include <netinet/in.h>
+#include <stdio.h> /* for puts */
+#include <string.h>
+
+/*
+ * Portable checksum routines for Internet Protocol family headers.
+ *
+ * The data is read in naturally aligned 32-bit words which are accumulated
+ * in a 64-bit sum.  Since 2^32 is congruent to 1 modulo 0xffff the 32-bit
+ * words may be added like pairs of 16-bit words and the carries have to be
+ * folded only once at the end.  All sums are in the byte order of the
+ * memory, so the result needs no swapping on little-endian machines.
+ *
+ * The generic version is always available, so that it can be compared with
+ * the CPU specific versions.
+ */
+
+static u_int
+in_cksum_fold(uint64_t sum)
+{
+	uint32_t s;
+
+	sum = (sum >> 32) + (sum & 0xffffffff);
+	s = (uint32_t) (sum >> 32) + (uint32_t) sum;
+	if (s < (uint32_t) sum)
+		s++;
+	s = (s >> 16) + (s & 0xffff);
+	s = (s >> 16) + (s & 0xffff);
+	return (s);
+}
+
+static u_int
+in_cksum_swap(u_int sum)
+{
+	return (((sum & 0xff) << 8) | (sum >> 8));
+}
+
+/*
+ * Returns the 16-bit one's complement sum of the len bytes at buf, as if
+ * buf started at an even offset of the packet.
+ */
+static u_int
+in_cksum_partial(const u_char *buf, int len)
+{
+	const uint32_t *w;
+	uint64_t sum = 0;
+	int odd = 0;
+	union {
+		u_char	c[2];
+		u_short	s;
+	} s_util;
+
+	if (len <= 0)
+		return (0);
+
+	/*
+	 * Force to even boundary.  The sum of the remaining data is then
+	 * computed with the wrong byte pairing and must be swapped.
+	 */
+	if (1 & (uintptr_t) buf) {
+		s_util.c[0] = 0;
+		s_util.c[1] = *buf++;
+		sum = s_util.s;
+		len--;
+		odd = 1;
+	}
+
+	if ((2 & (uintptr_t) buf) && len >= 2) {
+		sum += *(const u_short *) buf;
+		buf += 2;
+		len -= 2;
+	}
+
+	/*
+	 * Unroll the loop to make overhead from branches &c small.
+	 */
+	w = (const uint32_t *) buf;
+	while ((len -= 64) >= 0) {
+		sum += w[0]; sum += w[1]; sum += w[2]; sum += w[3];
+		sum += w[4]; sum += w[5]; sum += w[6]; sum += w[7];
+		sum += w[8]; sum += w[9]; sum += w[10]; sum += w[11];
+		sum += w[12]; sum += w[13]; sum += w[14]; sum += w[15];
+		w += 16;
+	}
+	len += 64;
+	while ((len -= 16) >= 0) {
+		sum += w[0]; sum += w[1]; sum += w[2]; sum += w[3];
+		w += 4;
+	}
+	len += 16;
+	while ((len -= 4) >= 0) {
+		sum += *w++;
+	}
+	len += 4;
+
+	buf = (const u_char *) w;
+	if (len >= 2) {
+		sum += *(const u_short *) buf;
+		buf += 2;
+		len -= 2;
+	}
+	if (len > 0) {
+		s_util.c[0] = *buf;
+		s_util.c[1] = 0;
+		sum += s_util.s;
+	}
+
+	return (odd ? in_cksum_swap(in_cksum_fold(sum)) : in_cksum_fold(sum));
+}
+
+int
+in_cksum_generic(
+	struct mbuf *m,
+	int len )
+{
+	u_int sum = 0;
+	int mlen;
+	int odd = 0;
+
+	for (;m && len; m = m->m_next) {
+		u_int s;
+
+		mlen = m->m_len;
+		if (mlen <= 0)
+			continue;
+		if (len < mlen)
+			mlen = len;
+		len -= mlen;
+
+		/*
+		 * A sum of data which starts at an odd offset of the packet
+		 * has its bytes paired the other way round.
+		 */
+		s = in_cksum_partial(mtod(m, u_char *), mlen);
+		if (odd)
+			s = in_cksum_swap(s);
+		sum += s;
+		odd ^= mlen & 1;
+	}
+	if (len)
+		puts("cksum: out of data");
+	sum = in_cksum_fold(sum);
+	return (~sum & 0xffff);
+}
+
+/*
+ * Copy len bytes from src to dst and add their 16-bit one's complement sum
+ * to sum, as if src started at an even offset of the packet.  The returned
+ * sum is not complemented, so that the checksum of data gathered from
+ * several buffers can be accumulated.  The data is read only once if src
+ * and dst have the same alignment.
+ */
+u_int
+in_cksum_copy(
+	const void *src,
+	void *dst,
+	int len,
+	u_int sum )
+{
+	const u_char *s = src;
+	u_char *d = dst;
+	const uint32_t *sw;
+	uint32_t *dw;
+	uint64_t acc = 0;
+	int odd = 0;
+	union {
+		u_char	c[2];
+		u_short	s;
+	} s_util;
+
+	if (len <= 0)
+		return (in_cksum_fold(sum));
+
+	if (3 & ((uintptr_t) s ^ (uintptr_t) d)) {
+		memcpy(d, s, (size_t) len);
+		return (in_cksum_fold((uint64_t) sum + in_cksum_partial(s, len)));
+	}
+
+	if (1 & (uintptr_t) s) {
+		s_util.c[0] = 0;
+		s_util.c[1] = *d++ = *s++;
+		acc = s_util.s;
+		len--;
+		odd = 1;
+	}
+
+	if ((2 & (uintptr_t) s) && len >= 2) {
+		u_short v = *(const u_short *) s;
+
+		*(u_short *) d = v;
+		acc += v;
+		s += 2;
+		d += 2;
+		len -= 2;
+	}
+
+	sw = (const uint32_t *) s;
+	dw = (uint32_t *) d;
+	while ((len -= 16) >= 0) {
+		uint32_t w0 = sw[0];
+		uint32_t w1 = sw[1];
+		uint32_t w2 = sw[2];
+		uint32_t w3 = sw[3];
+
+		dw[0] = w0; dw[1] = w1; dw[2] = w2; dw[3] = w3;
+		acc += w0; acc += w1; acc += w2; acc += w3;
+		sw += 4;
+		dw += 4;
+	}
+	len += 16;
+	while ((len -= 4) >= 0) {
+		uint32_t w0 = *sw++;
+
+		*dw++ = w0;
+		acc += w0;
+	}
+	len += 4;
+
+	s = (const u_char *) sw;
+	d = (u_char *) dw;
+	if (len >= 2) {
+		u_short v = *(const u_short *) s;
+
+		*(u_short *) d = v;
+		acc += v;
+		s += 2;
+		d += 2;
+		len -= 2;
+	}
+	if (len > 0) {
+		s_util.c[0] = *d = *s;
+		s_util.c[1] = 0;
+		acc += s_util.s;
+	}
+
+	if (odd)
+		return (in_cksum_fold((uint64_t) sum +
+		    in_cksum_swap(in_cksum_fold(acc))));
+	return (in_cksum_fold((uint64_t) sum + acc));
+}
+
+/*
+ * Copy len bytes at offset off of the mbuf chain m to cp and return their
+ * 16-bit one's complement sum, as if cp started at an even offset of the
+ * packet.  The sum is not complemented.  This replaces a m_copydata()
+ * followed by a checksum of the copied data.
+ */
+u_int
+in_cksum_copydata(
+	const struct mbuf *m,
+	int off,
+	int len,
+	void *cp )
+{
+	u_char *d = cp;
+	u_int sum = 0;
+	int odd = 0;
+
+	while (m != NULL && off >= m->m_len) {
+		off -= m->m_len;
+		m = m->m_next;
+	}
+	for (; m != NULL && len > 0; m = m->m_next) {
+		int count = m->m_len - off;
+		u_int s;
+
+		if (count > len)
+			count = len;
+		s = in_cksum_copy(mtod(m, u_char *) + off, d, count, 0);
+		if (odd)
+			s = in_cksum_swap(s);
+		sum = in_cksum_fold((uint64_t) sum + s);
+		odd ^= count & 1;
+		len -= count;
+		d += count;
+		off = 0;
+	}
+	if (len)
+		puts("cksum: out of data");
+	return (sum);
+}
 
 /*
  *  Try to use a CPU specific version, then punt to the portable C one.
@@ -67,118 +348,11 @@
 
 #else
 
-#include <stdio.h> /* for puts */
-
-/*
- * Checksum routine for Internet Protocol family headers (Portable Version).
- *
- * This routine is very heavily used in the network
- * code and should be modified for each CPU to be as fast as possible.
- */
-
-#define ADDCARRY(x)  (x > 65535L ? x -= 65535L : x)
-#define REDUCE \
-  {l_util.l = sum; sum = l_util.s[0] + l_util.s[1];  ADDCARRY(sum);}
-
 int
 in_cksum(
 	struct mbuf *m,
-	uint32_t len )
+	int len )
 {
-	register u_short *w;
-	register int32_t sum = 0;
-	register int32_t mlen = 0;
-	int byte_swapped = 0;
-
-	union {
-		char	c[2];
-		u_short	s;
-	} s_util;
-	union {
-		u_short s[2];
-		long	l;
-	} l_util;
-
-	for (;m && len; m = m->m_next) {
-		if (m->m_len == 0)
-			continue;
-		w = mtod(m, u_short *);
-		if (mlen == -1) {
-			/*
-			 * The first byte of this mbuf is the continuation
-			 * of a word spanning between this mbuf and the
-			 * last mbuf.
-			 *
-			 * s_util.c[0] is already saved when scanning previous
-			 * mbuf.
-			 */
-			s_util.c[1] = *(char *)w;
-			sum += s_util.s;
-			w = (u_short *)((char *)w + 1);
-			mlen = m->m_len - 1;
-			len--;
-		} else
-			mlen = m->m_len;
-		if (len < mlen)
-			mlen = len;
-		len -= mlen;
-		/*
-		 * Force to even boundary.
-		 */
-		if ((1 & (intptr_t) w) && (mlen > 0)) {
-			REDUCE;
-			sum <<= 8;
-			s_util.c[0] = *(u_char *)w;
-			w = (u_short *)((char *)w + 1);
-			mlen--;
-			byte_swapped = 1;
-		}
-		/*
-		 * Unroll the loop to make overhead from
-		 * branches &c small.
-		 */
-		while ((mlen -= 32) >= 0) {
-			sum += w[0]; sum += w[1]; sum += w[2]; sum += w[3];
-			sum += w[4]; sum += w[5]; sum += w[6]; sum += w[7];
-			sum += w[8]; sum += w[9]; sum += w[10]; sum += w[11];
-			sum += w[12]; sum += w[13]; sum += w[14]; sum += w[15];
-			w += 16;
-		}
-		mlen += 32;
-		while ((mlen -= 8) >= 0) {
-			sum += w[0]; sum += w[1]; sum += w[2]; sum += w[3];
-			w += 4;
-		}
-		mlen += 8;
-		if (mlen == 0 && byte_swapped == 0)
-			continue;
-		REDUCE;
-		while ((mlen -= 2) >= 0) {
-			sum += *w++;
-		}
-		if (byte_swapped) {
-			REDUCE;
-			sum <<= 8;
-			byte_swapped = 0;
-			if (mlen == -1) {
-				s_util.c[1] = *(char *)w;
-				sum += s_util.s;
-				mlen = 0;
-			} else
-				mlen = -1;
-		} else if (mlen == -1)
-			s_util.c[0] = *(char *)w;
-	}
-	if (len)
-		puts("cksum: out of data");
-	if (mlen == -1) {
-		/* The last mbuf has odd # of bytes. Follow the
-		   standard (the odd byte may be shifted left by 8 bits
-		   or not as determined by endian-ness of the machine) */
-		s_util.c[1] = 0;
-		sum += s_util.s;
-	}
-	REDUCE;
-	return (~sum & 0xffff);
+	return (in_cksum_generic(m, len));
 }
 #endif
@@ -596,20 +596,31 @@ bad:
 
 /*
  * IP software interrupt routine - to go away sometime soon
+ *
+ * At most rtems_bsdnet_input_budget packets are processed per call,
+ * the network daemon is woken up again for the remaining packets.
  */
 void
 ipintr(void)
 {
 	int s;
 	struct mbuf *m;
+	int n = 0;
 
 	while(1) {
+		if (rtems_bsdnet_input_budget > 0 &&
+		    n == rtems_bsdnet_input_budget) {
+			if (ipintrq.ifq_head != NULL)
+				schednetisr(NETISR_IP);
+			return;
+		}
 		s = splimp();
 		IF_DEQUEUE(&ipintrq, m);
 		splx(s);
 		if (m == 0)
 			return;
 		ip_input(m);
+		n++;
 	}
 }
 
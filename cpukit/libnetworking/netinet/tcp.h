@@ -85,9 +85,11 @@ struct tcphdr {
 #define    TCPOLEN_MAXSEG		4L
 #define TCPOPT_WINDOW		3L
 #define    TCPOLEN_WINDOW		3L
-#define TCPOPT_SACK_PERMITTED	4L		/* Experimental */
+#define TCPOPT_SACK_PERMITTED	4L		/* RFC 2018 */
 #define    TCPOLEN_SACK_PERMITTED	2L
-#define TCPOPT_SACK		5L		/* Experimental */
+#define TCPOPT_SACK		5L		/* RFC 2018 */
+#define    TCPOLEN_SACKHDR		2L
+#define    TCPOLEN_SACK			8L	/* 2*sizeof(tcp_seq) */
 #define TCPOPT_TIMESTAMP	8L
 #define    TCPOLEN_TIMESTAMP		10L
 #define    TCPOLEN_TSTAMP_APPA		(uint32_t)(TCPOLEN_TIMESTAMP+2) /* appendix A */
@@ -118,6 +120,8 @@ struct tcphdr {
 
 #define TCP_MAX_WINSHIFT	14	/* maximum window shift */
 
+#define TCP_MAX_SACK	4	/* MAX # SACKs sent in any segment */
+
 #define TCP_MAXHLEN	(0xf<<2)	/* max length of header in bytes */
 #define TCP_MAXOLEN	(TCP_MAXHLEN - sizeof(struct tcphdr))
 					/* max space left for options */
@@ -115,6 +115,7 @@ static void	 tcp_xmit_timer(struct tcpcb *, int);
 		else \
 			tp->t_flags |= TF_DELACK; \
 		(tp)->rcv_nxt += (ti)->ti_len; \
+		(tp)->rcv_numsacks = 0; \
 		flags = (ti)->ti_flags & TH_FIN; \
 		tcpstat.tcps_rcvpack++;\
 		tcpstat.tcps_rcvbyte += (ti)->ti_len;\
@@ -132,6 +133,7 @@ static void	 tcp_xmit_timer(struct tcpcb *, int);
 	    (tp)->t_state == TCPS_ESTABLISHED) { \
 		tp->t_flags |= TF_DELACK; \
 		(tp)->rcv_nxt += (ti)->ti_len; \
+		(tp)->rcv_numsacks = 0; \
 		flags = (ti)->ti_flags & TH_FIN; \
 		tcpstat.tcps_rcvpack++;\
 		tcpstat.tcps_rcvbyte += (ti)->ti_len;\
@@ -150,7 +152,8 @@ tcp_reass(struct tcpcb *tp, struct tcpiphdr *ti, struct mbuf *m)
 {
 	register struct tcpiphdr *q;
 	struct socket *so = tp->t_inpcb->inp_socket;
-	int flags;
+	int flags = 0;
+	tcp_seq laststart = ti ? ti->ti_seq : tp->rcv_nxt;
 	/*
 	 * Call with ti==0 after become established to
 	 * force pre-ESTABLISHED data up to user socket.
@@ -242,10 +245,10 @@ present:
 	 * completed sequence space.
 	 */
 	if (!TCPS_HAVEESTABLISHED(tp->t_state))
-		return (0);
+		goto done;
 	ti = tp->seg_next;
 	if (ti == (struct tcpiphdr *)tp || ti->ti_seq != tp->rcv_nxt)
-		return (0);
+		goto done;
 	do {
 		tp->rcv_nxt += ti->ti_len;
 		flags = ti->ti_flags & TH_FIN;
@@ -262,6 +265,12 @@ present:
 			sbappend(&so->so_rcv, m);
 	} while (ti != (struct tcpiphdr *)tp && ti->ti_seq == tp->rcv_nxt);
 	sorwakeup(so);
+done:
+	/*
+	 * Tell the peer which out-of-order data we hold.
+	 */
+	if (TCP_SACK_ENABLED(tp))
+		tcp_sack_rcv_update(tp, laststart);
 	return (flags);
 }
 
@@ -509,6 +518,7 @@ findpcb:
 	     */
 	    ((tp->t_flags & (TF_REQ_CC|TF_RCVD_CC)) != (TF_REQ_CC|TF_RCVD_CC) ||
 	     ((to.to_flags & TOF_CC) != 0 && to.to_cc == tp->cc_recv)) &&
+	    (to.to_flags & TOF_SACK) == 0 &&
 	    ti->ti_seq == tp->rcv_nxt &&
 	    tiwin && tiwin == tp->snd_wnd &&
 	    tp->snd_nxt == tp->snd_max) {
@@ -1258,6 +1268,8 @@ trimthenstep6:
 	case TCPS_LAST_ACK:
 	case TCPS_TIME_WAIT:
 
+		if (TCP_SACK_ENABLED(tp))
+			tcp_sack_doack(tp, &to, ti->ti_ack);
 		if (SEQ_LEQ(ti->ti_ack, tp->snd_una)) {
 			if (ti->ti_len == 0 && tiwin == tp->snd_wnd) {
 				tcpstat.tcps_rcvdupack++;
@@ -1288,7 +1300,16 @@ trimthenstep6:
 				if (tp->t_timer[TCPT_REXMT] == 0 ||
 				    ti->ti_ack != tp->snd_una)
 					tp->t_dupacks = 0;
-				else if (++tp->t_dupacks == tcprexmtthresh) {
+				else if (tp->t_flags & TF_FASTRECOVERY) {
+					/*
+					 * In SACK based loss recovery the
+					 * scoreboard, not the number of
+					 * duplicate ACKs, drives output.
+					 */
+					tp->t_dupacks++;
+					(void) tcp_output(tp);
+					goto drop;
+				} else if (++tp->t_dupacks == tcprexmtthresh) {
 					tcp_seq onxt = tp->snd_nxt;
 					u_int win =
 					    min(tp->snd_wnd, tp->snd_cwnd) / 2 /
@@ -1299,6 +1320,29 @@ trimthenstep6:
 					tp->snd_ssthresh = win * tp->t_maxseg;
 					tp->t_timer[TCPT_REXMT] = 0;
 					tp->t_rtt = 0;
+					if (TCP_SACK_ENABLED(tp) &&
+					    tp->snd_numsacked > 0) {
+						/*
+						 * SACK based loss recovery,
+						 * tcp_output() retransmits
+						 * the holes of the scoreboard
+						 * as long as the estimated
+						 * data in flight is below
+						 * the congestion window.
+						 * Kludge the congestion
+						 * window so that the first
+						 * hole is sent right now.
+						 */
+						tcpstat.tcps_sack_recovery_episode++;
+						tp->t_flags |= TF_FASTRECOVERY;
+						tp->snd_recover = tp->snd_max;
+						tp->sack_rxtnxt = tp->snd_una;
+						tp->snd_cwnd = tcp_sack_pipe(tp) +
+						    tp->t_maxseg;
+						(void) tcp_output(tp);
+						tp->snd_cwnd = tp->snd_ssthresh;
+						goto drop;
+					}
 					tp->snd_nxt = ti->ti_ack;
 					tp->snd_cwnd = tp->t_maxseg;
 					(void) tcp_output(tp);
@@ -1316,14 +1360,32 @@ trimthenstep6:
 				tp->t_dupacks = 0;
 			break;
 		}
-		/*
-		 * If the congestion window was inflated to account
-		 * for the other side's cached packets, retract it.
-		 */
-		if (tp->t_dupacks >= tcprexmtthresh &&
-		    tp->snd_cwnd > tp->snd_ssthresh)
-			tp->snd_cwnd = tp->snd_ssthresh;
-		tp->t_dupacks = 0;
+		if (tp->t_flags & TF_FASTRECOVERY) {
+			/*
+			 * A partial ACK during SACK based loss recovery
+			 * keeps us in recovery and lets tcp_output()
+			 * retransmit the next hole.  An ACK at or beyond
+			 * the recovery point ends the recovery.
+			 */
+			if (SEQ_LT(ti->ti_ack, tp->snd_recover)) {
+				if (SEQ_LT(tp->sack_rxtnxt, ti->ti_ack))
+					tp->sack_rxtnxt = ti->ti_ack;
+				needoutput = 1;
+			} else {
+				tp->t_flags &= ~TF_FASTRECOVERY;
+				tp->snd_cwnd = tp->snd_ssthresh;
+				tp->t_dupacks = 0;
+			}
+		} else {
+			/*
+			 * If the congestion window was inflated to account
+			 * for the other side's cached packets, retract it.
+			 */
+			if (tp->t_dupacks >= tcprexmtthresh &&
+			    tp->snd_cwnd > tp->snd_ssthresh)
+				tp->snd_cwnd = tp->snd_ssthresh;
+			tp->t_dupacks = 0;
+		}
 		if (SEQ_GT(ti->ti_ack, tp->snd_max)) {
 			tcpstat.tcps_rcvacktoomuch++;
 			goto dropafterack;
@@ -1395,7 +1457,7 @@ process_ACK:
 		 * Otherwise open linearly: maxseg per window
 		 * (maxseg^2 / cwnd per packet).
 		 */
-		{
+		if ((tp->t_flags & TF_FASTRECOVERY) == 0) {
 		register u_int cw = tp->snd_cwnd;
 		register u_int incr = tp->t_maxseg;
 
@@ -1770,6 +1832,25 @@ tcp_dooptions(struct tcpcb *tp, u_char *cp, int cnt, struct tcpiphdr *ti,
 			tp->requested_s_scale = min(cp[2], TCP_MAX_WINSHIFT);
 			break;
 
+		case TCPOPT_SACK_PERMITTED:
+			if (optlen != TCPOLEN_SACK_PERMITTED)
+				continue;
+			if (!(ti->ti_flags & TH_SYN))
+				continue;
+			tp->t_flags |= TF_SACK_PERMIT;
+			break;
+
+		case TCPOPT_SACK:
+			if (optlen <= TCPOLEN_SACKHDR ||
+			    ((optlen - TCPOLEN_SACKHDR) % TCPOLEN_SACK) != 0)
+				continue;
+			if (ti->ti_flags & TH_SYN)
+				continue;
+			to->to_flags |= TOF_SACK;
+			to->to_nsacks = (optlen - TCPOLEN_SACKHDR) / TCPOLEN_SACK;
+			to->to_sacks = cp + 2;
+			break;
+
 		case TCPOPT_TIMESTAMP:
 			if (optlen != TCPOLEN_TIMESTAMP)
 				continue;
@@ -83,6 +83,10 @@ tcp_output(
 	u_char opt[TCP_MAXOLEN];
 	unsigned optlen, hdrlen;
 	int idle, sendalot;
+	int sack_rxmit;
+	tcp_seq sack_seq = 0;
+	u_int datasum = 0;
+	int datasum_valid;
 	struct rmxp_tao *taop;
 	struct rmxp_tao tao_noncached;
 
@@ -102,6 +106,7 @@ tcp_output(
 		tp->snd_cwnd = tp->t_maxseg;
 again:
 	sendalot = 0;
+	datasum_valid = 0;
 	off = tp->snd_nxt - tp->snd_una;
 	win = min(tp->snd_wnd, tp->snd_cwnd);
 
@@ -148,7 +153,37 @@ again:
 		}
 	}
 
-	len = min(so->so_snd.sb_cc, win) - off;
+	/*
+	 * In SACK based loss recovery, send only as much as the estimated
+	 * amount of data in flight permits.  Retransmit the next hole of the
+	 * scoreboard first, then new data.
+	 */
+	sack_rxmit = 0;
+	if ((tp->t_flags & TF_FASTRECOVERY) && TCP_SACK_ENABLED(tp) &&
+	    (flags & TH_SYN) == 0) {
+		long cwin = (long)tp->snd_cwnd - tcp_sack_pipe(tp);
+		long sack_len;
+		int sack_off;
+
+		if (cwin < (long)tp->t_maxseg)
+			cwin = 0;
+		if (cwin > 0 &&
+		    (sack_off = tcp_sack_output(tp, &sack_len)) >= 0 &&
+		    sack_off < so->so_snd.sb_cc) {
+			sack_rxmit = 1;
+			sack_seq = tp->snd_una + sack_off;
+			off = sack_off;
+			len = min(sack_len, so->so_snd.sb_cc - off);
+			if (len > tp->t_maxseg)
+				len = tp->t_maxseg;
+			flags &= ~TH_FIN;
+			sendalot = 1;
+		} else
+			win = min(win, off + cwin);
+	}
+
+	if (!sack_rxmit)
+		len = min(so->so_snd.sb_cc, win) - off;
 
 	if ((taop = tcp_gettaocache(tp->t_inpcb)) == NULL) {
 		taop = &tao_noncached;
@@ -210,6 +245,9 @@ again:
 
 	win = sbspace(&so->so_rcv);
 
+	if (sack_rxmit)
+		goto send;
+
 	/*
 	 * Sender silly window avoidance.  If connection is idle
 	 * and can send all data, a maximum segment,
@@ -341,6 +379,15 @@ send:
 					tp->request_r_scale);
 				optlen += 4;
 			}
+
+			if ((tp->t_flags & TF_REQ_SACK) &&
+			    ((flags & TH_ACK) == 0 ||
+			    (tp->t_flags & TF_SACK_PERMIT))) {
+				opt[optlen++] = TCPOPT_NOP;
+				opt[optlen++] = TCPOPT_NOP;
+				opt[optlen++] = TCPOPT_SACK_PERMITTED;
+				opt[optlen++] = TCPOLEN_SACK_PERMITTED;
+			}
 		}
  	}
 
@@ -433,6 +480,16 @@ send:
 		}
  	}
 
+	/*
+	 * Send SACK blocks for the out-of-order data which we hold if the
+	 * peer permitted it.  They go last since they use up the remaining
+	 * option space.
+	 */
+	if (TCP_SACK_ENABLED(tp) && tp->rcv_numsacks > 0 &&
+	    (tp->t_flags & TF_NOOPT) == 0 &&
+	    (flags & (TH_SYN|TH_RST)) == 0)
+		optlen = tcp_sack_addoption(tp, opt, optlen);
+
  	hdrlen += optlen;
 
 	/*
@@ -463,7 +520,12 @@ send:
 	if (len) {
 		if (tp->t_force && len == 1)
 			tcpstat.tcps_sndprobe++;
-		else if (SEQ_LT(tp->snd_nxt, tp->snd_max)) {
+		else if (sack_rxmit) {
+			tcpstat.tcps_sndrexmitpack++;
+			tcpstat.tcps_sndrexmitbyte += len;
+			tcpstat.tcps_sack_rexmits++;
+			tcpstat.tcps_sack_rexmit_bytes += len;
+		} else if (SEQ_LT(tp->snd_nxt, tp->snd_max)) {
 			tcpstat.tcps_sndrexmitpack++;
 			tcpstat.tcps_sndrexmitbyte += len;
 		} else {
@@ -490,8 +552,13 @@ send:
 		m->m_data += max_linkhdr;
 		m->m_len = hdrlen;
 		if (len <= MHLEN - hdrlen - max_linkhdr) {
-			m_copydata(so->so_snd.sb_mb, off, (int) len,
-			    mtod(m, caddr_t) + hdrlen);
+			/*
+			 * Sum up the data while it is copied, so that only
+			 * the header has to be summed up later.
+			 */
+			datasum = in_cksum_copydata(so->so_snd.sb_mb, off,
+			    (int) len, mtod(m, caddr_t) + hdrlen);
+			datasum_valid = 1;
 			m->m_len += len;
 		} else {
 			m->m_next = m_copy(so->so_snd.sb_mb, off, (int) len);
@@ -555,7 +622,9 @@ send:
 	 * case, since we know we aren't doing a retransmission.
 	 * (retransmit and persist are mutually exclusive...)
 	 */
-	if (len || (flags & (TH_SYN|TH_FIN)) || tp->t_timer[TCPT_PERSIST])
+	if (sack_rxmit)
+		ti->ti_seq = htonl(sack_seq);
+	else if (len || (flags & (TH_SYN|TH_FIN)) || tp->t_timer[TCPT_PERSIST])
 		ti->ti_seq = htonl(tp->snd_nxt);
 	else
 		ti->ti_seq = htonl(tp->snd_max);
@@ -595,13 +664,25 @@ send:
 	if (len + optlen)
 		ti->ti_len = htons((u_short)(sizeof (struct tcphdr) +
 		    optlen + len));
-	ti->ti_sum = in_cksum(m, (int)(hdrlen + len));
+	if (datasum_valid) {
+		/* The header length is even, so the data sum needs no swap */
+		u_int sum = (~in_cksum(m, (int) hdrlen) & 0xffff) + datasum;
+
+		sum = (sum >> 16) + (sum & 0xffff);
+		ti->ti_sum = ~sum & 0xffff;
+	} else
+		ti->ti_sum = in_cksum(m, (int)(hdrlen + len));
 
 	/*
 	 * In transmit state, time the transmission and arrange for
 	 * the retransmit.  In persist state, just set snd_max.
+	 * A SACK retransmission only advances the retransmit pointer.
 	 */
-	if (tp->t_force == 0 || tp->t_timer[TCPT_PERSIST] == 0) {
+	if (sack_rxmit) {
+		tp->sack_rxtnxt = sack_seq + len;
+		if (tp->t_timer[TCPT_REXMT] == 0)
+			tp->t_timer[TCPT_REXMT] = tp->t_rxtcur;
+	} else if (tp->t_force == 0 || tp->t_timer[TCPT_PERSIST] == 0) {
 		tcp_seq startseq = tp->snd_nxt;
 
 		/*
@@ -0,0 +1,291 @@
+/*
+ * TCP selective acknowledgement options, see RFC 2018.
+ *
+ * The receiver reports the out-of-order data held in the reassembly queue
+ * in SACK blocks.  The sender keeps a scoreboard of the ranges acknowledged
+ * by SACK blocks and uses it during loss recovery to retransmit only the
+ * holes, with the amount of data in flight estimated as in RFC 3517.
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <sys/param.h>
+#include <sys/queue.h>
+#include <sys/systm.h>
+#include <sys/kernel.h>
+#include <sys/sysctl.h>
+#include <sys/malloc.h>
+#include <sys/mbuf.h>
+#include <sys/protosw.h>
+#include <sys/socket.h>
+#include <sys/socketvar.h>
+#include <errno.h>
+
+#include <net/route.h>
+
+#include <netinet/in.h>
+#include <netinet/in_systm.h>
+#include <netinet/ip.h>
+#include <netinet/in_pcb.h>
+#include <netinet/ip_var.h>
+#include <netinet/tcp.h>
+#include <netinet/tcp_fsm.h>
+#include <netinet/tcp_seq.h>
+#include <netinet/tcp_timer.h>
+#include <netinet/tcp_var.h>
+#include <netinet/tcpip.h>
+
+int	tcp_do_sack = 1;
+SYSCTL_INT(_net_inet_tcp, TCPCTL_DO_SACK, sack, CTLFLAG_RW,
+    &tcp_do_sack, 0, "Enable RFC 2018 selective acknowledgements");
+
+/*
+ * Rebuild the SACK blocks to send from the reassembly queue.  Contiguous
+ * segments of the queue form one block.  The block which contains the
+ * sequence number laststart of the most recently received segment is
+ * reported first, as required by RFC 2018.
+ */
+void
+tcp_sack_rcv_update(struct tcpcb *tp, tcp_seq laststart)
+{
+	struct tcpiphdr *q;
+	struct sackblk first;
+	struct sackblk others[TCP_MAX_SACK];
+	int nothers = 0;
+	int havefirst = 0;
+	int n = 0;
+	int i;
+
+	q = tp->seg_next;
+	while (q != (struct tcpiphdr *)tp) {
+		tcp_seq start = q->ti_seq;
+		tcp_seq end = start + q->ti_len;
+
+		q = (struct tcpiphdr *)q->ti_next;
+		while (q != (struct tcpiphdr *)tp && SEQ_LEQ(q->ti_seq, end)) {
+			if (SEQ_GT(q->ti_seq + q->ti_len, end))
+				end = q->ti_seq + q->ti_len;
+			q = (struct tcpiphdr *)q->ti_next;
+		}
+		if (start == end)
+			continue;
+		if (!havefirst && SEQ_GEQ(laststart, start) &&
+		    SEQ_LT(laststart, end)) {
+			first.start = start;
+			first.end = end;
+			havefirst = 1;
+		} else if (nothers < TCP_MAX_SACK) {
+			others[nothers].start = start;
+			others[nothers].end = end;
+			nothers++;
+		}
+	}
+
+	if (havefirst)
+		tp->sackblks[n++] = first;
+	for (i = 0; i < nothers && n < TCP_MAX_SACK; i++)
+		tp->sackblks[n++] = others[i];
+	tp->rcv_numsacks = n;
+}
+
+/*
+ * Append a SACK option with as many blocks as fit into the remaining
+ * option space.  Returns the new option length.  Blocks which the left
+ * window edge has overtaken since they were built are dropped, so that
+ * a path which advanced rcv_nxt without a reassembly never reports
+ * stale blocks.
+ */
+int
+tcp_sack_addoption(struct tcpcb *tp, u_char *opt, int optlen)
+{
+	int nsack;
+	int i;
+	int j;
+
+	for (i = 0, j = 0; i < tp->rcv_numsacks; i++) {
+		if (SEQ_LEQ(tp->sackblks[i].end, tp->rcv_nxt))
+			continue;
+		if (SEQ_LT(tp->sackblks[i].start, tp->rcv_nxt))
+			tp->sackblks[i].start = tp->rcv_nxt;
+		tp->sackblks[j++] = tp->sackblks[i];
+	}
+	tp->rcv_numsacks = j;
+
+	nsack = ((int)TCP_MAXOLEN - optlen - 2 - TCPOLEN_SACKHDR) /
+	    TCPOLEN_SACK;
+	if (nsack > tp->rcv_numsacks)
+		nsack = tp->rcv_numsacks;
+	if (nsack <= 0)
+		return (optlen);
+
+	opt[optlen++] = TCPOPT_NOP;
+	opt[optlen++] = TCPOPT_NOP;
+	opt[optlen++] = TCPOPT_SACK;
+	opt[optlen++] = TCPOLEN_SACKHDR + nsack * TCPOLEN_SACK;
+	for (i = 0; i < nsack; i++) {
+		u_int32_t seq;
+
+		seq = htonl(tp->sackblks[i].start);
+		bcopy((char *)&seq, (char *)opt + optlen, sizeof(seq));
+		optlen += sizeof(seq);
+		seq = htonl(tp->sackblks[i].end);
+		bcopy((char *)&seq, (char *)opt + optlen, sizeof(seq));
+		optlen += sizeof(seq);
+	}
+	tcpstat.tcps_sack_send_blocks++;
+	return (optlen);
+}
+
+/*
+ * Add the range [start, end) to the scoreboard.  Overlapping and adjacent
+ * ranges are merged.  If the scoreboard is full, the range with the highest
+ * sequence numbers is discarded.
+ */
+static void
+tcp_sack_insert(struct tcpcb *tp, tcp_seq start, tcp_seq end)
+{
+	struct sackblk *sb = tp->snd_sacked;
+	int n = tp->snd_numsacked;
+	int i;
+	int j;
+
+	for (i = 0; i < n && SEQ_LT(sb[i].end, start); i++)
+		;
+	for (j = i; j < n && SEQ_LEQ(sb[j].start, end); j++) {
+		if (SEQ_LT(sb[j].start, start))
+			start = sb[j].start;
+		if (SEQ_GT(sb[j].end, end))
+			end = sb[j].end;
+	}
+	if (j == i) {
+		if (n == TCP_SACK_SCOREBOARD) {
+			if (i == n)
+				return;
+			n--;
+		}
+		memmove(&sb[i + 1], &sb[i], (n - i) * sizeof(*sb));
+		n++;
+	} else {
+		memmove(&sb[i + 1], &sb[j], (n - j) * sizeof(*sb));
+		n -= j - i - 1;
+	}
+	sb[i].start = start;
+	sb[i].end = end;
+	tp->snd_numsacked = n;
+}
+
+/*
+ * Process the SACK blocks of an incoming segment which acknowledges th_ack.
+ * Ranges at or below th_ack are removed from the scoreboard, the valid
+ * blocks of the segment are added.
+ */
+void
+tcp_sack_doack(struct tcpcb *tp, struct tcpopt *to, tcp_seq th_ack)
+{
+	struct sackblk *sb = tp->snd_sacked;
+	int i;
+	int j;
+
+	for (i = 0, j = 0; i < tp->snd_numsacked; i++) {
+		if (SEQ_LEQ(sb[i].end, th_ack))
+			continue;
+		sb[j] = sb[i];
+		if (SEQ_LT(sb[j].start, th_ack))
+			sb[j].start = th_ack;
+		j++;
+	}
+	tp->snd_numsacked = j;
+
+	if ((to->to_flags & TOF_SACK) == 0)
+		return;
+	tcpstat.tcps_sack_rcv_blocks++;
+	for (i = 0; i < to->to_nsacks; i++) {
+		struct sackblk blk;
+
+		bcopy((char *)to->to_sacks + i * TCPOLEN_SACK,
+		    (char *)&blk.start, sizeof(blk.start));
+		NTOHL(blk.start);
+		bcopy((char *)to->to_sacks + i * TCPOLEN_SACK + 4,
+		    (char *)&blk.end, sizeof(blk.end));
+		NTOHL(blk.end);
+		if (SEQ_GEQ(blk.start, blk.end) ||
+		    SEQ_LEQ(blk.end, th_ack) ||
+		    SEQ_GT(blk.end, tp->snd_max))
+			continue;
+		if (SEQ_LT(blk.start, th_ack))
+			blk.start = th_ack;
+		tcp_sack_insert(tp, blk.start, blk.end);
+	}
+}
+
+/*
+ * Forget all SACK information, e.g. after a retransmit timeout since the
+ * receiver is allowed to discard data it reported in SACK blocks.
+ */
+void
+tcp_sack_flush(struct tcpcb *tp)
+{
+	tp->snd_numsacked = 0;
+	tp->t_flags &= ~TF_FASTRECOVERY;
+}
+
+/*
+ * Estimate the amount of data in flight during loss recovery (RFC 3517).
+ * Data above the highest SACKed sequence number is in flight.  Holes below
+ * it are considered lost unless they were already retransmitted.
+ */
+long
+tcp_sack_pipe(struct tcpcb *tp)
+{
+	struct sackblk *sb = tp->snd_sacked;
+	tcp_seq fack = tp->snd_una;
+	tcp_seq rxt = tp->sack_rxtnxt;
+	long pipe;
+	int i;
+
+	if (tp->snd_numsacked > 0)
+		fack = sb[tp->snd_numsacked - 1].end;
+	if (SEQ_LT(rxt, tp->snd_una))
+		rxt = tp->snd_una;
+	if (SEQ_GT(rxt, fack))
+		rxt = fack;
+	pipe = (long)(tp->snd_max - fack) + (long)(rxt - tp->snd_una);
+	for (i = 0; i < tp->snd_numsacked && SEQ_LT(sb[i].start, rxt); i++) {
+		if (SEQ_LT(sb[i].end, rxt))
+			pipe -= sb[i].end - sb[i].start;
+		else
+			pipe -= rxt - sb[i].start;
+	}
+	return (pipe);
+}
+
+/*
+ * Find the next hole to retransmit at or after sack_rxtnxt.  Returns the
+ * offset of the hole relative to snd_una and its length in *lenp, or -1 if
+ * there is no hole left below the highest SACKed sequence number.
+ */
+int
+tcp_sack_output(struct tcpcb *tp, long *lenp)
+{
+	struct sackblk *sb = tp->snd_sacked;
+	tcp_seq seq = tp->sack_rxtnxt;
+	int i;
+
+	if (SEQ_LT(seq, tp->snd_una))
+		seq = tp->snd_una;
+	for (i = 0; i < tp->snd_numsacked; i++) {
+		if (SEQ_LT(seq, sb[i].start)) {
+			*lenp = sb[i].start - seq;
+			return (seq - tp->snd_una);
+		}
+		if (SEQ_LT(seq, sb[i].end))
+			seq = sb[i].end;
+	}
+	return (-1);
+}
@@ -257,6 +257,8 @@ tcp_newtcpcb(struct inpcb *inp)
 
 	if (tcp_do_rfc1323)
 		tp->t_flags = (TF_REQ_SCALE|TF_REQ_TSTMP);
+	if (tcp_do_sack)
+		tp->t_flags |= TF_REQ_SACK;
 	tp->t_inpcb = inp;
 	/*
 	 * Init srtt to TCPTV_SRTTBASE (0), so we can tell that we have no
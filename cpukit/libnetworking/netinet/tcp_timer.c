@@ -298,6 +298,12 @@ tcp_timers(struct tcpcb *tp, int timer)
 		tp->snd_ssthresh = win * tp->t_maxseg;
 		tp->t_dupacks = 0;
 		}
+		/*
+		 * The receiver may have discarded data which it reported
+		 * in SACK blocks (RFC 2018), so forget the scoreboard and
+		 * leave SACK based recovery.
+		 */
+		tcp_sack_flush(tp);
 		(void) tcp_output(tp);
 		break;
 
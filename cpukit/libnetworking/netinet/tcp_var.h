@@ -42,6 +42,21 @@
 #ifdef __BSD_VISIBLE
 #include <netinet/tcp_timer.h> /* TCPT_NTIMERS */
 
+/*
+ * A range of sequence space which was selectively acknowledged, see RFC 2018.
+ */
+struct sackblk {
+	tcp_seq	start;			/* start seq no. of sack block */
+	tcp_seq	end;			/* end seq no. */
+};
+
+/*
+ * Number of selectively acknowledged ranges which are remembered by the
+ * sender.  If the scoreboard is full, the ranges with the highest sequence
+ * numbers are discarded.
+ */
+#define	TCP_SACK_SCOREBOARD	8
+
 /*
  * Tcp control block, one per tcp; fields:
  */
@@ -73,6 +88,7 @@ struct tcpcb {
 #define	TF_FASTRECOVERY	0x100000	/* in NewReno Fast Recovery */
 #define	TF_WASFRECOVERY	0x200000	/* was in NewReno Fast Recovery */
 #define	TF_SIGNATURE	0x400000	/* require MD5 digests (RFC2385) */
+#define	TF_REQ_SACK	0x800000	/* have/will request SACK */
 	int	t_force;		/* 1 if forcing out a byte */
 	int	t_timer[TCPT_NTIMERS];	/* tcp timers */
 	int	t_rxtshift;		/* log(2) of rexmt exp. backoff */
@@ -150,8 +166,21 @@ struct tcpcb {
 	caddr_t	t_tuba_pcb;		/* next level down pcb for TCP over z */
 /* More RTT stuff */
 	u_long	t_rttupdated;		/* number of times rtt sampled */
+/* RFC 2018 variables */
+	tcp_seq	snd_recover;		/* snd_max when loss was detected */
+	tcp_seq	sack_rxtnxt;		/* next seq no. to retransmit */
+	int	snd_numsacked;		/* valid entries in snd_sacked */
+	struct	sackblk snd_sacked[TCP_SACK_SCOREBOARD];
+					/* SACKed ranges, sorted, disjoint */
+	int	rcv_numsacks;		/* valid entries in sackblks */
+	struct	sackblk sackblks[TCP_MAX_SACK];
+					/* SACK blocks to send */
 };
 
+#define	TCP_SACK_ENABLED(tp) \
+	(((tp)->t_flags & (TF_REQ_SACK|TF_SACK_PERMIT)) == \
+	    (TF_REQ_SACK|TF_SACK_PERMIT))
+
 /*
  * Structure to hold TCP options that are only used during segment
  * processing (in tcp_input), but not held in the tcpcb.
@@ -173,6 +202,8 @@ struct tcpopt {
 	u_int32_t	to_tsecr;
 	tcp_cc	to_cc;		/* holds CC or CCnew */
 	tcp_cc	to_ccecho;
+	u_char	*to_sacks;	/* pointer to the first SACK block */
+	int	to_nsacks;	/* number of SACK blocks */
 };
 
 /*
@@ -313,6 +344,12 @@ struct	tcpstat {
 	u_long	tcps_badsyn;		/* bogus SYN, e.g. premature ACK */
 	u_long	tcps_mturesent;		/* resends due to MTU discovery */
 	u_long	tcps_listendrop;	/* listen queue overflows */
+
+	u_long	tcps_sack_recovery_episode; /* SACK recovery episodes */
+	u_long	tcps_sack_rexmits;	/* SACK rexmit segments */
+	u_long	tcps_sack_rexmit_bytes;	/* SACK rexmit bytes */
+	u_long	tcps_sack_rcv_blocks;	/* SACK blocks (options) received */
+	u_long	tcps_sack_send_blocks;	/* SACK blocks (options) sent */
 };
 
 /*
@@ -346,7 +383,8 @@ struct	xtcpcb {
 #define	TCPCTL_RECVSPACE	9	/* receive buffer space */
 #define	TCPCTL_KEEPINIT		10	/* timeout for establishing syn */
 #define	TCPCTL_PCBLIST		11	/* list of all outstanding PCBs */
-#define TCPCTL_MAXID		12
+#define	TCPCTL_DO_SACK		12	/* use RFC-2018 SACK */
+#define TCPCTL_MAXID		13
 
 #define TCPCTL_NAMES { \
 	{ 0, 0 }, \
@@ -360,6 +398,8 @@ struct	xtcpcb {
 	{ "sendspace", CTLTYPE_INT }, \
 	{ "recvspace", CTLTYPE_INT }, \
 	{ "keepinit", CTLTYPE_INT }, \
+	{ "pcblist", CTLTYPE_STRUCT }, \
+	{ "sack", CTLTYPE_INT }, \
 }
 
 #ifdef _KERNEL
@@ -372,6 +412,7 @@ extern	struct inpcbinfo tcbinfo;
 extern	struct tcpstat tcpstat;	/* tcp statistics */
 extern	int tcp_mssdflt;	/* XXX */
 extern	u_long tcp_now;		/* for RFC 1323 timestamps */
+extern	int tcp_do_sack;	/* SACK enabled/disabled */
 
 void	 tcp_canceltimers(struct tcpcb *);
 struct tcpcb *
@@ -393,6 +434,12 @@ struct tcpcb *
 	 tcp_newtcpcb(struct inpcb *);
 int	 tcp_output(struct tcpcb *);
 void	 tcp_quench(struct inpcb *, int);
+int	 tcp_sack_addoption(struct tcpcb *, u_char *, int);
+void	 tcp_sack_doack(struct tcpcb *, struct tcpopt *, tcp_seq);
+void	 tcp_sack_flush(struct tcpcb *);
+int	 tcp_sack_output(struct tcpcb *, long *);
+long	 tcp_sack_pipe(struct tcpcb *);
+void	 tcp_sack_rcv_update(struct tcpcb *, tcp_seq);
 void	 tcp_respond(struct tcpcb *,
 	    struct tcpiphdr *, struct mbuf *, tcp_seq, tcp_seq, int);
 struct rtentry *
@@ -181,6 +181,16 @@ struct rtems_bsdnet_config {
 	 */
 	unsigned long		tcp_tx_buf_size;
 	unsigned long		tcp_rx_buf_size;
+	/*
+	 * Maximum number of received IP packets processed
+	 * by the network daemon per wake-up.  Remaining
+	 * packets are processed after the expired timeouts
+	 * and after other tasks waiting for the network
+	 * semaphore had a chance to run.
+	 *
+	 * The default value 0 means no limit.
+	 */
+	unsigned long		network_input_budget;
 };
 
 /*
@@ -212,6 +222,16 @@ void rtems_bsdnet_detach (struct rtems_bsdnet_ifconfig *ifconfig);
  */
 int rtems_bsdnet_ifconfig (const char *ifname, uint32_t   cmd, void *param);
 
+/*
+ * Hand over a batch of received Ethernet packets linked by
+ * m_nextpkt to the network daemon.  Each packet starts with its
+ * ether header and m_pkthdr.rcvif must be set.  This may be
+ * called without the network semaphore and from interrupt
+ * context.  The packets are queued on the current processor.
+ */
+struct mbuf;
+void rtems_bsdnet_defer_input (struct mbuf *m);
+
 void rtems_bsdnet_do_bootp (void);
 void rtems_bsdnet_do_bootp_and_rootfs (void);
 
@@ -190,6 +190,7 @@ int sethostname (char *name, size_t namelen);
 void domaininit (void *);
 void ifinit (void *);
 void ipintr (void);
+extern int rtems_bsdnet_input_budget;
 void arpintr (void);
 int socket (int, int, int);
 int ioctl (int, ioctl_command_t, ...);
@@ -204,7 +205,8 @@ int ioctl (int, ioctl_command_t, ...);
 #define SOSLEEP_EVENT  RTEMS_EVENT_SYSTEM_NETWORK_SOSLEEP
 #define NETISR_IP_EVENT        (1L << NETISR_IP)
 #define NETISR_ARP_EVENT       (1L << NETISR_ARP)
-#define NETISR_EVENTS  (NETISR_IP_EVENT|NETISR_ARP_EVENT)
+#define NETISR_DEFER_EVENT     (1L << NETISR_DEFER)
+#define NETISR_EVENTS  (NETISR_IP_EVENT|NETISR_ARP_EVENT|NETISR_DEFER_EVENT)
 #if (SBWAIT_EVENT & SOSLEEP_EVENT & NETISR_EVENTS)
 # error "Network event conflict"
 #endif
@@ -27,6 +27,7 @@
 #include <sys/ioctl.h>
 #include <net/if.h>
 #include <net/route.h>
+#include <net/ethernet.h>
 #include <netinet/in.h>
 #include <vm/vm.h>
 #include <arpa/inet.h>
@@ -58,6 +59,20 @@ static rtems_id networkDaemonTid;
 static uint32_t   networkDaemonPriority;
 static void networkDaemon (void *task_argument);
 
+/*
+ * Received packets handed over by drivers without the network
+ * semaphore.  There is one queue per processor, so that drivers
+ * running on different processors do not contend for a lock.
+ */
+struct inputQueue {
+	rtems_interrupt_lock lock;
+	struct mbuf *head;
+	struct mbuf *tail;
+};
+static struct inputQueue *inputQueues;
+static uint32_t inputQueueCount;
+int rtems_bsdnet_input_budget;
+
 /*
  * Network timing
  */
@@ -300,6 +315,20 @@ rtems_bsdnet_initialize (void)
 
         rtems_set_sb_efficiency( rtems_bsdnet_config.sb_efficiency );
 
+	rtems_bsdnet_input_budget = rtems_bsdnet_config.network_input_budget;
+	inputQueueCount = rtems_smp_get_processor_count ();
+	inputQueues = malloc (inputQueueCount * sizeof *inputQueues);
+	if (inputQueues == NULL) {
+		printf ("Can't allocate network input queues\n");
+		return -1;
+	}
+	memset (inputQueues, 0, inputQueueCount * sizeof *inputQueues);
+	{
+	uint32_t i;
+	for (i = 0 ; i < inputQueueCount ; i++)
+		rtems_interrupt_lock_initialize (&inputQueues[i].lock);
+	}
+
 	/*
 	 * Create the task-synchronization semaphore
 	 */
@@ -568,6 +597,57 @@ rtems_bsdnet_schednetisr (int n)
 	rtems_event_system_send (networkDaemonTid, 1 << n);
 }
 
+/*
+ * Queue received packets for the network daemon.
+ * The daemon is only woken up if the queue was empty, otherwise
+ * it has not yet fetched the queue since the last wake-up.
+ */
+void
+rtems_bsdnet_defer_input (struct mbuf *m)
+{
+	struct inputQueue *q;
+	struct mbuf *tail;
+	rtems_interrupt_lock_context lock_context;
+	int wake;
+
+	if (m == NULL)
+		return;
+	for (tail = m ; tail->m_nextpkt != NULL ; tail = tail->m_nextpkt)
+		continue;
+	q = &inputQueues[rtems_smp_get_current_processor ()];
+	rtems_interrupt_lock_acquire (&q->lock, &lock_context);
+	wake = (q->head == NULL);
+	if (wake)
+		q->head = m;
+	else
+		q->tail->m_nextpkt = m;
+	q->tail = tail;
+	rtems_interrupt_lock_release (&q->lock, &lock_context);
+	if (wake)
+		rtems_bsdnet_schednetisr (NETISR_DEFER);
+}
+
+/*
+ * Pass the packets of all input queues to the protocols
+ */
+static void
+deferredInput (void)
+{
+	uint32_t i;
+
+	for (i = 0 ; i < inputQueueCount ; i++) {
+		struct inputQueue *q = &inputQueues[i];
+		rtems_interrupt_lock_context lock_context;
+		struct mbuf *m;
+
+		rtems_interrupt_lock_acquire (&q->lock, &lock_context);
+		m = q->head;
+		q->head = NULL;
+		rtems_interrupt_lock_release (&q->lock, &lock_context);
+		ether_input_batch (m);
+	}
+}
+
 /*
  * The network daemon
  * This provides a context to run BSD software interrupts
@@ -594,6 +674,8 @@ networkDaemon (void *task_argument)
 						timeout,
 						&events);
 		if ( sc == RTEMS_SUCCESSFUL ) {
+			if (events & NETISR_DEFER_EVENT)
+				deferredInput ();
 			if (events & NETISR_IP_EVENT)
 				ipintr ();
 			if (events & NETISR_ARP_EVENT)
@@ -188,6 +188,8 @@ rtems_bsdnet_show_inet_routes (void)
 		printf ("Can't get route info: %s\n", strerror (error));
 		return;
 	}
+	printf ("Route cache: %lu hits, %lu misses\n",
+		rtstat.rts_cachehit, rtstat.rts_cachemiss);
 	if (d.count == 0) {
 		printf ("No routes!\n");
 		return;
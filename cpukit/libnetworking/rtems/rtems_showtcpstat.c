@@ -98,5 +98,10 @@ rtems_bsdnet_show_tcp_stats (void)
 	showtcpstat ("bogus SYN, e.g. premature ACK", tcpstat.tcps_badsyn);
 	showtcpstat ("resends due to MTU discovery", tcpstat.tcps_mturesent);
 	showtcpstat ("listen queue overflows", tcpstat.tcps_listendrop);
+	showtcpstat ("SACK recovery episodes", tcpstat.tcps_sack_recovery_episode);
+	showtcpstat ("SACK retransmitted segments", tcpstat.tcps_sack_rexmits);
+	showtcpstat ("SACK retransmitted bytes", tcpstat.tcps_sack_rexmit_bytes);
+	showtcpstat ("SACK options received", tcpstat.tcps_sack_rcv_blocks);
+	showtcpstat ("SACK options sent", tcpstat.tcps_sack_send_blocks);
 	printf ("\n");
 }
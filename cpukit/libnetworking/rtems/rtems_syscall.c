@@ -11,6 +11,7 @@
 #include <rtems.h>
 #include <rtems/libio_.h>
 #include <rtems/error.h>
+#include <rtems/timespec.h>
 #include <rtems/rtems_bsdnet.h>
 
 #include <errno.h>
@@ -333,26 +334,21 @@ shutdown (int s, int how)
 }
 
 /*
- * All `transmit' operations end up calling this routine.
+ * Transmit one message on a socket.  The caller must hold the network
+ * semaphore.  Returns 0 or an error number, the number of bytes sent is
+ * stored in *retsize.
  */
-ssize_t
-sendmsg (int s, const struct msghdr *mp, int flags)
+static int
+sendit (struct socket *so, const struct msghdr *mp, int flags, ssize_t *retsize)
 {
-	int ret = -1;
 	int error;
 	struct uio auio;
 	struct iovec *iov;
-	struct socket *so;
 	struct mbuf *to;
 	struct mbuf *control = NULL;
 	int i;
 	int len;
 
-	rtems_bsdnet_semaphore_obtain ();
-	if ((so = rtems_bsdnet_fdToSocket (s)) == NULL) {
-		rtems_bsdnet_semaphore_release ();
-		return -1;
-	}
 	auio.uio_iov = mp->msg_iov;
 	auio.uio_iovcnt = mp->msg_iovlen;
 	auio.uio_segflg = UIO_USERSPACE;
@@ -361,30 +357,22 @@ sendmsg (int s, const struct msghdr *mp, int flags)
 	auio.uio_resid = 0;
 	iov = mp->msg_iov;
 	for (i = 0; i < mp->msg_iovlen; i++, iov++) {
-		if ((auio.uio_resid += iov->iov_len) < 0) {
-			errno = EINVAL;
-			rtems_bsdnet_semaphore_release ();
-			return -1;
-		}
+		if ((auio.uio_resid += iov->iov_len) < 0)
+			return (EINVAL);
 	}
 	if (mp->msg_name) {
 		error = sockargstombuf (&to, mp->msg_name, mp->msg_namelen, MT_SONAME);
-		if (error) {
-			errno = error;
-			rtems_bsdnet_semaphore_release ();
-			return -1;
-		}
+		if (error)
+			return (error);
 	}
 	else {
 		to = NULL;
 	}
 	if (mp->msg_control) {
 		if (mp->msg_controllen < sizeof (struct cmsghdr)) {
-			errno = EINVAL;
 			if (to)
 				m_freem(to);
-			rtems_bsdnet_semaphore_release ();
-			return -1;
+			return (EINVAL);
 		}
 		sockargstombuf (&control, mp->msg_control, mp->msg_controllen, MT_CONTROL);
 	}
@@ -397,16 +385,65 @@ sendmsg (int s, const struct msghdr *mp, int flags)
 		if (auio.uio_resid != len && (error == EINTR || error == EWOULDBLOCK))
 			error = 0;
 	}
-	if (error)
-		errno = error;
-	else
-		ret = len - auio.uio_resid;
+	if (!error)
+		*retsize = len - auio.uio_resid;
 	if (to)
 		m_freem(to);
+	return (error);
+}
+
+/*
+ * All `transmit' operations end up calling this routine.
+ */
+ssize_t
+sendmsg (int s, const struct msghdr *mp, int flags)
+{
+	ssize_t ret = -1;
+	int error;
+	struct socket *so;
+
+	rtems_bsdnet_semaphore_obtain ();
+	if ((so = rtems_bsdnet_fdToSocket (s)) == NULL) {
+		rtems_bsdnet_semaphore_release ();
+		return -1;
+	}
+	error = sendit (so, mp, flags, &ret);
+	if (error)
+		errno = error;
 	rtems_bsdnet_semaphore_release ();
 	return (ret);
 }
 
+/*
+ * Transmit a vector of messages.  The network semaphore is obtained and
+ * the socket is looked up only once for the whole vector.  Returns the
+ * number of messages sent, or -1 if the first message failed.
+ */
+ssize_t
+sendmmsg (int s, struct mmsghdr *msgvec, size_t vlen, int flags)
+{
+	int error = 0;
+	struct socket *so;
+	size_t i;
+
+	rtems_bsdnet_semaphore_obtain ();
+	if ((so = rtems_bsdnet_fdToSocket (s)) == NULL) {
+		rtems_bsdnet_semaphore_release ();
+		return -1;
+	}
+	for (i = 0; i < vlen; i++) {
+		error = sendit (so, &msgvec[i].msg_hdr, flags, &msgvec[i].msg_len);
+		if (error)
+			break;
+	}
+	rtems_bsdnet_semaphore_release ();
+	if (i == 0 && error) {
+		errno = error;
+		return -1;
+	}
+	return (ssize_t) i;
+}
+
 /*
  * Send a message to a host
  */
@@ -428,25 +465,20 @@ sendto (int s, const void *buf, size_t buflen, int flags, const struct sockaddr
 }
 
 /*
- * All `receive' operations end up calling this routine.
+ * Receive one message from a socket.  The caller must hold the network
+ * semaphore.  Returns 0 or an error number, the number of bytes received
+ * is stored in *retsize.
  */
-ssize_t
-recvmsg (int s, struct msghdr *mp, int flags)
+static int
+recvit (struct socket *so, struct msghdr *mp, int flags, ssize_t *retsize)
 {
-	int ret = -1;
 	int error;
 	struct uio auio;
 	struct iovec *iov;
-	struct socket *so;
 	struct mbuf *from = NULL, *control = NULL;
 	int i;
 	int len;
 
-	rtems_bsdnet_semaphore_obtain ();
-	if ((so = rtems_bsdnet_fdToSocket (s)) == NULL) {
-		rtems_bsdnet_semaphore_release ();
-		return -1;
-	}
 	auio.uio_iov = mp->msg_iov;
 	auio.uio_iovcnt = mp->msg_iovlen;
 	auio.uio_segflg = UIO_USERSPACE;
@@ -455,11 +487,8 @@ recvmsg (int s, struct msghdr *mp, int flags)
 	auio.uio_resid = 0;
 	iov = mp->msg_iov;
 	for (i = 0; i < mp->msg_iovlen; i++, iov++) {
-		if ((auio.uio_resid += iov->iov_len) < 0) {
-			errno = EINVAL;
-			rtems_bsdnet_semaphore_release ();
-			return -1;
-		}
+		if ((auio.uio_resid += iov->iov_len) < 0)
+			return (EINVAL);
 	}
 	len = auio.uio_resid;
 	mp->msg_flags = flags;
@@ -470,11 +499,8 @@ recvmsg (int s, struct msghdr *mp, int flags)
 		if (auio.uio_resid != len && (error == EINTR || error == EWOULDBLOCK))
 			error = 0;
 	}
-	if (error) {
-		errno = error;
-	}
-	else {
-		ret = len - auio.uio_resid;
+	if (!error) {
+		*retsize = len - auio.uio_resid;
 		if (mp->msg_name) {
 			len = mp->msg_namelen;
 			if ((len <= 0) || (from == NULL)) {
@@ -517,10 +543,82 @@ recvmsg (int s, struct msghdr *mp, int flags)
 		m_freem (from);
 	if (control)
 		m_freem (control);
+	return (error);
+}
+
+/*
+ * All `receive' operations end up calling this routine.
+ */
+ssize_t
+recvmsg (int s, struct msghdr *mp, int flags)
+{
+	ssize_t ret = -1;
+	int error;
+	struct socket *so;
+
+	rtems_bsdnet_semaphore_obtain ();
+	if ((so = rtems_bsdnet_fdToSocket (s)) == NULL) {
+		rtems_bsdnet_semaphore_release ();
+		return -1;
+	}
+	error = recvit (so, mp, flags, &ret);
+	if (error)
+		errno = error;
 	rtems_bsdnet_semaphore_release ();
 	return (ret);
 }
 
+/*
+ * Receive a vector of messages.  The network semaphore is obtained and
+ * the socket is looked up only once for the whole vector.  With
+ * MSG_WAITFORONE only the first message may block.  The timeout is
+ * checked after each received message, as on other systems.  Returns the
+ * number of messages received, or -1 if the first message failed.
+ */
+ssize_t
+recvmmsg (int s, struct mmsghdr *msgvec, size_t vlen, int flags,
+    const struct timespec *timeout)
+{
+	int error = 0;
+	struct socket *so;
+	rtems_interval start = 0;
+	rtems_interval ticks = 0;
+	size_t i;
+
+	if (timeout != NULL) {
+		if (!rtems_timespec_is_valid (timeout)) {
+			errno = EINVAL;
+			return -1;
+		}
+		ticks = rtems_timespec_to_ticks (timeout);
+		start = rtems_clock_get_ticks_since_boot ();
+	}
+	rtems_bsdnet_semaphore_obtain ();
+	if ((so = rtems_bsdnet_fdToSocket (s)) == NULL) {
+		rtems_bsdnet_semaphore_release ();
+		return -1;
+	}
+	for (i = 0; i < vlen; i++) {
+		error = recvit (so, &msgvec[i].msg_hdr, flags & ~MSG_WAITFORONE,
+		    &msgvec[i].msg_len);
+		if (error)
+			break;
+		if (flags & MSG_WAITFORONE)
+			flags |= MSG_DONTWAIT;
+		if (timeout != NULL &&
+		    rtems_clock_get_ticks_since_boot () - start >= ticks) {
+			i++;
+			break;
+		}
+	}
+	rtems_bsdnet_semaphore_release ();
+	if (i == 0 && error) {
+		errno = error;
+		return -1;
+	}
+	return (ssize_t) i;
+}
+
 /*
  * Receive a message from a host
  */
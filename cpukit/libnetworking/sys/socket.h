@@ -318,6 +318,18 @@ struct msghdr {
 #define	MSG_DONTWAIT	0x80		/* this message should be nonblocking */
 #define	MSG_EOF		0x100		/* data completes connection */
 #define MSG_COMPAT      0x8000		/* used in sendit() */
+#define	MSG_WAITFORONE	0x80000		/* recvmmsg(): block until 1+ msgs */
+#endif
+
+#if __BSD_VISIBLE
+/*
+ * Message vector element for recvmmsg and sendmmsg calls.  The msg_len
+ * member holds the number of bytes transferred for this message.
+ */
+struct mmsghdr {
+	struct	msghdr msg_hdr;		/* message header */
+	ssize_t	msg_len;		/* message length */
+};
 #endif
 
 /*
@@ -393,6 +405,12 @@ ssize_t	send(int, const void *, size_t, int);
 ssize_t	sendto(int, const void *,
 	    size_t, int, const struct sockaddr *, socklen_t);
 ssize_t	sendmsg(int, const struct msghdr *, int);
+#if __BSD_VISIBLE
+struct timespec;
+ssize_t	recvmmsg(int, struct mmsghdr * __restrict, size_t, int,
+	    const struct timespec * __restrict);
+ssize_t	sendmmsg(int, struct mmsghdr * __restrict, size_t, int);
+#endif
 int	setsockopt(int, int, int, const void *, socklen_t);
 int	shutdown(int, int);
 int	socket(int, int, int);
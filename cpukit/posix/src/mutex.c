@@ -25,11 +25,27 @@
 #include <rtems/system.h>
 #include <rtems/config.h>
 #include <rtems/score/coremuteximpl.h>
+#include <rtems/score/lockstatsimpl.h>
 #include <rtems/score/watchdog.h>
 #include <rtems/posix/muteximpl.h>
 #include <rtems/posix/priorityimpl.h>
 #include <rtems/posix/time.h>
 
+#if defined(RTEMS_PROFILING)
+static const Lock_Stats *_POSIX_Mutex_Get_lock_stats(
+  Objects_Control *object
+)
+{
+  return &( (POSIX_Mutex_Control *) object )->Mutex.Stats;
+}
+
+static Lock_Stats_Objects _POSIX_Mutex_Lock_stats_objects = {
+  { NULL, NULL },
+  &_POSIX_Mutex_Information,
+  _POSIX_Mutex_Get_lock_stats
+};
+#endif
+
 /*
  *  _POSIX_Mutex_Manager_initialization
  *
@@ -77,4 +93,8 @@ void _POSIX_Mutex_Manager_initialization(void)
     NULL                        /* Proxy extraction support callout */
 #endif
   );
+
+#if defined(RTEMS_PROFILING)
+  _Lock_Stats_Register_objects( &_POSIX_Mutex_Lock_stats_objects );
+#endif
 }
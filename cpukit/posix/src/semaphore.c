@@ -29,9 +29,25 @@
 #include <rtems/system.h>
 #include <rtems/config.h>
 #include <rtems/posix/semaphoreimpl.h>
+#include <rtems/score/lockstatsimpl.h>
 #include <rtems/posix/time.h>
 #include <rtems/seterr.h>
 
+#if defined(RTEMS_PROFILING)
+static const Lock_Stats *_POSIX_Semaphore_Get_lock_stats(
+  Objects_Control *object
+)
+{
+  return &( (POSIX_Semaphore_Control *) object )->Semaphore.Stats;
+}
+
+static Lock_Stats_Objects _POSIX_Semaphore_Lock_stats_objects = {
+  { NULL, NULL },
+  &_POSIX_Semaphore_Information,
+  _POSIX_Semaphore_Get_lock_stats
+};
+#endif
+
 /*
  *  _POSIX_Semaphore_Manager_initialization
  *
@@ -60,4 +76,8 @@ void _POSIX_Semaphore_Manager_initialization(void)
     NULL                        /* Proxy extraction support callout */
 #endif
   );
+
+#if defined(RTEMS_PROFILING)
+  _Lock_Stats_Register_objects( &_POSIX_Semaphore_Lock_stats_objects );
+#endif
 }
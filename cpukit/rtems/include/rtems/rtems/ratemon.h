@@ -33,6 +33,7 @@
 
 #include <rtems/rtems/types.h>
 #include <rtems/rtems/status.h>
+#include <rtems/profiling.h>
 #include <rtems/score/thread.h>
 #include <rtems/score/watchdog.h>
 #include <rtems/bspIo.h>
@@ -54,6 +55,10 @@ extern "C" {
  *  for both cpu usage and wall time.  The statistics indicate the execution time
  *  used by the owning thread between successive calls to rtems_rate_monotonic_period.
  *
+ *  If the profiling support is enabled, then each period records in addition
+ *  histograms of the response time and the release jitter of its jobs and the
+ *  uptime of its most recent deadline misses.
+ *
  *  Rate Monotonic Manager -- Reset Statistics for All Periods
  */
 /**@{*/
@@ -179,6 +184,68 @@ typedef struct {
   Rate_monotonic_Period_time_t         total_wall_time;
 }  Rate_monotonic_Statistics;
 
+/**
+ *  The following constant defines the count of most recent deadline misses
+ *  recorded for each period.
+ */
+#define RTEMS_RATE_MONOTONIC_DEADLINE_MISSES 8
+
+/**
+ *  The following defines the PUBLIC data structure that has the
+ *  histograms kept on each period instance.
+ */
+typedef struct {
+  /**
+   * This field contains the distribution of the time from the release of a
+   * job until the owner concludes it with rtems_rate_monotonic_period.
+   */
+  rtems_profiling_histogram            response_time;
+
+  /**
+   * This field contains the distribution of the time from the release of a
+   * job until the owner blocked on the period executes again.
+   */
+  rtems_profiling_histogram            release_jitter;
+
+  /** This field contains the number of deadline misses. */
+  uint32_t                             deadline_miss_count;
+
+  /**
+   * This field contains the uptime of the most recent deadline misses in
+   * chronological order.  Only the first entries up to the minimum of
+   * deadline_miss_count and RTEMS_RATE_MONOTONIC_DEADLINE_MISSES are valid.
+   */
+  rtems_rate_monotonic_period_time_t
+    deadline_misses[ RTEMS_RATE_MONOTONIC_DEADLINE_MISSES ];
+}  rtems_rate_monotonic_period_histograms;
+
+#if defined(RTEMS_PROFILING)
+/**
+ *  The following defines the INTERNAL data structure that has the
+ *  histograms kept on each period instance.
+ */
+typedef struct {
+  /** This field contains the CPU counter value of the last job release. */
+  CPU_Counter_ticks                    release_instant;
+
+  /** This field contains the response times in CPU counter ticks. */
+  Profiling_Histogram                  response_time;
+
+  /** This field contains the release jitter in CPU counter ticks. */
+  Profiling_Histogram                  release_jitter;
+
+  /** This field contains the number of deadline misses. */
+  uint32_t                             deadline_miss_count;
+
+  /**
+   * This field contains the ring of the most recent deadline misses.  The
+   * next miss is stored at deadline_miss_count modulo the ring size.
+   */
+  Rate_monotonic_Period_time_t
+    deadline_misses[ RTEMS_RATE_MONOTONIC_DEADLINE_MISSES ];
+}  Rate_monotonic_Histograms;
+#endif
+
 /**
  *  The following defines the period status structure.
  */
@@ -247,6 +314,13 @@ typedef struct {
    * This field contains the statistics maintained for the period.
    */
   Rate_monotonic_Statistics               Statistics;
+
+#if defined(RTEMS_PROFILING)
+  /**
+   * This field contains the histograms maintained for the period.
+   */
+  Rate_monotonic_Histograms               Histograms;
+#endif
 }   Rate_monotonic_Control;
 
 /**
@@ -393,6 +467,45 @@ void rtems_rate_monotonic_report_statistics_with_plugin(
  */
 void rtems_rate_monotonic_report_statistics( void );
 
+/**
+ * @brief RTEMS Rate Monotonic Get Histograms
+ *
+ * This routine implements the rtems_rate_monotonic_get_histograms directive.
+ * The response time and release jitter histograms and the most recent
+ * deadline misses of this period are returned.
+ *
+ * @param[in] id is the rate monotonic id
+ * @param[out] histograms is the pointer to histograms control block
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_NOT_CONFIGURED The profiling support is not configured.
+ * @retval RTEMS_INVALID_ADDRESS The histograms pointer is NULL.
+ * @retval RTEMS_INVALID_ID Invalid period identifier.
+ */
+rtems_status_code rtems_rate_monotonic_get_histograms(
+  rtems_id                                id,
+  rtems_rate_monotonic_period_histograms *histograms
+);
+
+/**
+ *  @brief RTEMS Report Rate Monotonic Histograms
+ *
+ *  This routine prints the response time and release jitter histograms and
+ *  the most recent deadline misses of ALL period instances which have
+ *  non-zero counts.
+ */
+void rtems_rate_monotonic_report_histograms_with_plugin(
+  void                  *context,
+  rtems_printk_plugin_t  print
+);
+
+/**
+ *  @brief RTEMS Report Rate Monotonic Histograms
+ *
+ *  This routine prints the histograms of ALL period instances using printk.
+ */
+void rtems_rate_monotonic_report_histograms( void );
+
 /**
  * @brief RTEMS Rate Monotonic Period
  *
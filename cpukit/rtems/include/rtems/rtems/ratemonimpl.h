@@ -19,6 +19,8 @@
 
 #include <rtems/rtems/ratemon.h>
 #include <rtems/score/objectimpl.h>
+#include <rtems/score/profiling.h>
+#include <rtems/score/threaddispatch.h>
 
 #include <string.h>
 
@@ -254,6 +256,31 @@ void _Rate_monotonic_Initiate_statistics(
      } while (0)
 #endif
 
+/**
+ *  @brief Rate_monotonic_Reset_histograms
+ *
+ *  This helper method resets the period histograms.
+ */
+#if defined(RTEMS_PROFILING)
+  #define _Rate_monotonic_Reset_histograms( _the_period ) \
+     do { \
+        (_the_period)->Histograms.deadline_miss_count = 0; \
+        memset( \
+          &(_the_period)->Histograms.response_time, \
+          0, \
+          sizeof( (_the_period)->Histograms.response_time ) \
+        ); \
+        memset( \
+          &(_the_period)->Histograms.release_jitter, \
+          0, \
+          sizeof( (_the_period)->Histograms.release_jitter ) \
+        ); \
+     } while (0)
+#else
+  #define _Rate_monotonic_Reset_histograms( _the_period ) \
+     do { } while (0)
+#endif
+
 /**
  *  @brief Rate_monotonic_Reset_statistics
  *
@@ -268,8 +295,76 @@ void _Rate_monotonic_Initiate_statistics(
     ); \
     _Rate_monotonic_Reset_cpu_use_statistics( _the_period ); \
     _Rate_monotonic_Reset_wall_time_statistics( _the_period ); \
+    _Rate_monotonic_Reset_histograms( _the_period ); \
   } while (0)
 
+/**
+ *  @brief Records the release of a job for the period histograms.
+ *
+ *  @param[in] the_period points to the period being operated upon.
+ */
+RTEMS_INLINE_ROUTINE void _Rate_monotonic_Histograms_release(
+  Rate_monotonic_Control *the_period
+)
+{
+#if defined(RTEMS_PROFILING)
+  the_period->Histograms.release_instant = _CPU_Counter_read();
+#else
+  (void) the_period;
+#endif
+}
+
+/**
+ *  @brief Records the response time of the concluding job.
+ *
+ *  Thread dispatching must be disabled.  The caller must also prevent that
+ *  the period timeout releases the next job concurrently, for example with
+ *  interrupts disabled.
+ *
+ *  @param[in] the_period points to the period being operated upon.
+ */
+RTEMS_INLINE_ROUTINE void _Rate_monotonic_Histograms_response(
+  Rate_monotonic_Control *the_period
+)
+{
+#if defined(RTEMS_PROFILING)
+  _Profiling_Histogram_update(
+    &the_period->Histograms.response_time,
+    _CPU_Counter_difference(
+      _CPU_Counter_read(),
+      the_period->Histograms.release_instant
+    )
+  );
+#else
+  (void) the_period;
+#endif
+}
+
+/**
+ *  @brief Records the release jitter of the current job.
+ *
+ *  This routine must be called by the owner once it executes again after
+ *  it blocked on the period.  Thread dispatching must be disabled.
+ *
+ *  @param[in] the_period points to the period being operated upon.
+ */
+RTEMS_INLINE_ROUTINE void _Rate_monotonic_Histograms_jitter(
+  Rate_monotonic_Control *the_period
+)
+{
+#if defined(RTEMS_PROFILING)
+  _Profiling_Histogram_update(
+    &the_period->Histograms.release_jitter,
+    _CPU_Counter_difference(
+      _CPU_Counter_read(),
+      the_period->Histograms.release_instant
+    )
+  );
+#else
+  (void) the_period;
+#endif
+}
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,125 @@
+/**
+ *  @file
+ *
+ *  @brief RTEMS Rate Monotonic Get Histograms
+ *  @ingroup ClassicRateMon
+ */
+
+/*
+ *  The license and distribution terms for this file may be
+ *  found in the file LICENSE in this distribution or at
+ *  http://www.rtems.com/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/rtems/ratemonimpl.h>
+#include <rtems/counter.h>
+
+#if defined(RTEMS_PROFILING)
+static void _Rate_monotonic_Convert_histogram(
+  rtems_profiling_histogram *dst,
+  const Profiling_Histogram *src
+)
+{
+  uint32_t bin;
+
+  dst->count = src->count;
+
+  if ( src->count > 0 ) {
+    dst->min  = rtems_counter_ticks_to_nanoseconds( src->min );
+    dst->max  = rtems_counter_ticks_to_nanoseconds( src->max );
+    dst->mean = rtems_counter_ticks_to_nanoseconds(
+      (rtems_counter_ticks) ( src->total / src->count )
+    );
+  } else {
+    dst->min  = 0;
+    dst->max  = 0;
+    dst->mean = 0;
+  }
+
+  for ( bin = 0; bin < RTEMS_PROFILING_HISTOGRAM_BINS; ++bin )
+    dst->bins[ bin ] = src->bins[ bin ];
+}
+#endif
+
+rtems_status_code rtems_rate_monotonic_get_histograms(
+  rtems_id                                id,
+  rtems_rate_monotonic_period_histograms *histograms
+)
+{
+#if defined(RTEMS_PROFILING)
+  Objects_Locations          location;
+  Rate_monotonic_Control    *the_period;
+  Rate_monotonic_Histograms  src;
+  ISR_Level                  level;
+  uint32_t                   first;
+  uint32_t                   count;
+  uint32_t                   i;
+
+  if ( !histograms )
+    return RTEMS_INVALID_ADDRESS;
+
+  the_period = _Rate_monotonic_Get( id, &location );
+  switch ( location ) {
+
+    case OBJECTS_LOCAL:
+      /*
+       *  The period timeout may record a deadline miss at any time.
+       */
+      _ISR_Disable( level );
+        src = the_period->Histograms;
+      _ISR_Enable( level );
+
+      _Objects_Put( &the_period->Object );
+
+      _Rate_monotonic_Convert_histogram(
+        &histograms->response_time,
+        &src.response_time
+      );
+      _Rate_monotonic_Convert_histogram(
+        &histograms->release_jitter,
+        &src.release_jitter
+      );
+
+      histograms->deadline_miss_count = src.deadline_miss_count;
+
+      if ( src.deadline_miss_count > RTEMS_RATE_MONOTONIC_DEADLINE_MISSES ) {
+        first = src.deadline_miss_count % RTEMS_RATE_MONOTONIC_DEADLINE_MISSES;
+        count = RTEMS_RATE_MONOTONIC_DEADLINE_MISSES;
+      } else {
+        first = 0;
+        count = src.deadline_miss_count;
+      }
+
+      for ( i = 0; i < count; ++i ) {
+        Rate_monotonic_Period_time_t *miss = &src.deadline_misses[
+          ( first + i ) % RTEMS_RATE_MONOTONIC_DEADLINE_MISSES
+        ];
+
+        #ifndef __RTEMS_USE_TICKS_FOR_STATISTICS__
+          _Timestamp_To_timespec( miss, &histograms->deadline_misses[ i ] );
+        #else
+          histograms->deadline_misses[ i ] = *miss;
+        #endif
+      }
+
+      return RTEMS_SUCCESSFUL;
+
+#if defined(RTEMS_MULTIPROCESSING)
+    case OBJECTS_REMOTE:            /* should never return this */
+#endif
+    case OBJECTS_ERROR:
+      break;
+  }
+
+  return RTEMS_INVALID_ID;
+#else
+  (void) id;
+  (void) histograms;
+
+  return RTEMS_NOT_CONFIGURED;
+#endif
+}
@@ -144,6 +144,7 @@ void _Rate_monotonic_Initiate_statistics(
     }
   #endif
 
+  _Rate_monotonic_Histograms_release( the_period );
   _Scheduler_Release_job(the_period->owner, the_period->next_length);
 }
 
@@ -171,6 +172,8 @@ static void _Rate_monotonic_Update_statistics(
   if ( the_period->state == RATE_MONOTONIC_EXPIRED )
     stats->missed_count++;
 
+  _Rate_monotonic_Histograms_response( the_period );
+
   /*
    *  Grab status for time statistics.
    */
@@ -325,6 +328,18 @@ rtems_status_code rtems_rate_monotonic_period(
           _Thread_Clear_state( _Thread_Executing, STATES_WAITING_FOR_PERIOD );
 
         _Objects_Put( &the_period->Object );
+
+        #if defined(RTEMS_PROFILING)
+          /*
+           *  We execute again after the release of the next job.  The period
+           *  may be deleted in the meantime, so get it again.
+           */
+          the_period = _Rate_monotonic_Get( id, &location );
+          if ( location == OBJECTS_LOCAL ) {
+            _Rate_monotonic_Histograms_jitter( the_period );
+            _Objects_Put( &the_period->Object );
+          }
+        #endif
         return RTEMS_SUCCESSFUL;
       }
 
@@ -340,6 +355,7 @@ rtems_status_code rtems_rate_monotonic_period(
         the_period->next_length = length;
 
         _Watchdog_Insert_ticks( &the_period->Timer, length );
+        _Rate_monotonic_Histograms_release( the_period );
         _Scheduler_Release_job(the_period->owner, the_period->next_length);
         _Objects_Put( &the_period->Object );
         return RTEMS_TIMEOUT;
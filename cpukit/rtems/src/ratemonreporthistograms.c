@@ -0,0 +1,136 @@
+/**
+ *  @file
+ *
+ *  @brief RTEMS Report Rate Monotonic Histograms
+ *  @ingroup ClassicRateMon
+ */
+
+/*
+ *  The license and distribution terms for this file may be
+ *  found in the file LICENSE in this distribution or at
+ *  http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rtems/rtems/ratemonimpl.h>
+#include <rtems/rtems/object.h>
+
+#include <inttypes.h>
+
+static void _Rate_monotonic_Report_histogram(
+  void                            *context,
+  rtems_printk_plugin_t            print,
+  const char                      *title,
+  const rtems_profiling_histogram *histogram
+)
+{
+  uint32_t bin;
+
+  (*print)( context,
+    "  %s: count %" PRIu32 ", min %" PRIu64 " ns, mean %" PRIu64
+      " ns, max %" PRIu64 " ns\n",
+    title,
+    histogram->count,
+    histogram->min,
+    histogram->mean,
+    histogram->max
+  );
+
+  for ( bin = 0; bin < RTEMS_PROFILING_HISTOGRAM_BINS; ++bin ) {
+    if ( histogram->bins[ bin ] != 0 ) {
+      (*print)( context,
+        "    < %" PRIu64 " ns: %" PRIu32 "\n",
+        rtems_profiling_bin_limit( bin ),
+        histogram->bins[ bin ]
+      );
+    }
+  }
+}
+
+void rtems_rate_monotonic_report_histograms_with_plugin(
+  void                  *context,
+  rtems_printk_plugin_t  print
+)
+{
+  rtems_status_code                      status;
+  rtems_id                               id;
+  rtems_rate_monotonic_period_histograms the_histograms;
+  rtems_rate_monotonic_period_status     the_status;
+  char                                   name[5];
+  uint32_t                               count;
+  uint32_t                               i;
+
+  if ( !print )
+    return;
+
+  if ( !rtems_profiling_is_configured() ) {
+    (*print)( context, "profiling is not configured\n" );
+    return;
+  }
+
+  (*print)( context, "Period histograms by period\n" );
+
+  /*
+   * Cycle through all possible ids and try to report on each one.  If it
+   * is a period that is inactive, we just get an error back.  No big deal.
+   */
+  for ( id=_Rate_monotonic_Information.minimum_id ;
+        id <= _Rate_monotonic_Information.maximum_id ;
+        id++ ) {
+    status = rtems_rate_monotonic_get_histograms( id, &the_histograms );
+    if ( status != RTEMS_SUCCESSFUL )
+      continue;
+
+    if ( the_histograms.response_time.count == 0 &&
+         the_histograms.deadline_miss_count == 0 )
+      continue;
+
+    (void) rtems_rate_monotonic_get_status( id, &the_status );
+    rtems_object_get_name( the_status.owner, sizeof(name), name );
+
+    (*print)( context,
+      "0x%08" PRIx32 " %4s missed %" PRIu32 "\n",
+      id, name, the_histograms.deadline_miss_count
+    );
+
+    _Rate_monotonic_Report_histogram(
+      context,
+      print,
+      "response time",
+      &the_histograms.response_time
+    );
+    _Rate_monotonic_Report_histogram(
+      context,
+      print,
+      "release jitter",
+      &the_histograms.release_jitter
+    );
+
+    count = the_histograms.deadline_miss_count;
+    if ( count > RTEMS_RATE_MONOTONIC_DEADLINE_MISSES )
+      count = RTEMS_RATE_MONOTONIC_DEADLINE_MISSES;
+
+    for ( i = 0 ; i < count ; ++i ) {
+      #ifndef __RTEMS_USE_TICKS_FOR_STATISTICS__
+        (*print)( context,
+          "  deadline miss at %" PRIdMAX ".%09ld s uptime\n",
+          (intmax_t) the_histograms.deadline_misses[ i ].tv_sec,
+          the_histograms.deadline_misses[ i ].tv_nsec
+        );
+      #else
+        (*print)( context,
+          "  deadline miss at %" PRIu32 " ticks uptime\n",
+          the_histograms.deadline_misses[ i ]
+        );
+      #endif
+    }
+  }
+}
+
+void rtems_rate_monotonic_report_histograms( void )
+{
+  rtems_rate_monotonic_report_histograms_with_plugin( NULL, printk_plugin );
+}
@@ -20,8 +20,29 @@
 
 #include <rtems/rtems/ratemonimpl.h>
 #include <rtems/score/threadimpl.h>
+#include <rtems/score/todimpl.h>
 #include <rtems/score/watchdogimpl.h>
 
+#if defined(RTEMS_PROFILING)
+static void _Rate_monotonic_Record_deadline_miss(
+  Rate_monotonic_Control *the_period
+)
+{
+  Rate_monotonic_Histograms *histograms = &the_period->Histograms;
+  Rate_monotonic_Period_time_t *miss = &histograms->deadline_misses[
+    histograms->deadline_miss_count % RTEMS_RATE_MONOTONIC_DEADLINE_MISSES
+  ];
+
+  #ifndef __RTEMS_USE_TICKS_FOR_STATISTICS__
+    _TOD_Get_uptime( miss );
+  #else
+    *miss = _Watchdog_Ticks_since_boot;
+  #endif
+
+  ++histograms->deadline_miss_count;
+}
+#endif
+
 void _Rate_monotonic_Timeout(
   Objects_Id  id,
   void       *ignored
@@ -53,8 +74,13 @@ void _Rate_monotonic_Timeout(
         _Rate_monotonic_Initiate_statistics( the_period );
 
         _Watchdog_Insert_ticks( &the_period->Timer, the_period->next_length );
-      } else
+      } else {
         the_period->state = RATE_MONOTONIC_EXPIRED;
+
+        #if defined(RTEMS_PROFILING)
+          _Rate_monotonic_Record_deadline_miss( the_period );
+        #endif
+      }
       _Objects_Put_without_thread_dispatch( &the_period->Object );
       break;
 
@@ -28,10 +28,32 @@
 #include <rtems/rtems/semimpl.h>
 #include <rtems/score/coremuteximpl.h>
 #include <rtems/score/coresemimpl.h>
+#include <rtems/score/lockstatsimpl.h>
 #include <rtems/score/thread.h>
 
 #include <rtems/score/interr.h>
 
+#if defined(RTEMS_PROFILING)
+static const Lock_Stats *_Semaphore_Get_lock_stats(
+  Objects_Control *object
+)
+{
+  Semaphore_Control *the_semaphore = (Semaphore_Control *) object;
+
+  if ( _Attributes_Is_counting_semaphore( the_semaphore->attribute_set ) ) {
+    return &the_semaphore->Core_control.semaphore.Stats;
+  } else {
+    return &the_semaphore->Core_control.mutex.Stats;
+  }
+}
+
+static Lock_Stats_Objects _Semaphore_Lock_stats_objects = {
+  { NULL, NULL },
+  &_Semaphore_Information,
+  _Semaphore_Get_lock_stats
+};
+#endif
+
 void _Semaphore_Manager_initialization(void)
 {
   _Objects_Initialize_information(
@@ -61,4 +83,7 @@ void _Semaphore_Manager_initialization(void)
   );
 #endif
 
+#if defined(RTEMS_PROFILING)
+  _Lock_Stats_Register_objects( &_Semaphore_Lock_stats_objects );
+#endif
 }
@@ -941,6 +941,67 @@ const rtems_libio_helper rtems_fs_init_helper =
     #endif
 #endif
 
+#ifdef CONFIGURE_INIT
+  /**
+   * This configures the malloc family profiling to be available.  It
+   * accounts the live allocations to the caller addresses of the
+   * allocation sites.
+   */
+  #ifdef CONFIGURE_MALLOC_PROFILING
+    /**
+     * This configures the maximum number of live allocations tracked by
+     * the malloc profiling.
+     */
+    #ifndef CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS
+      #define CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS 1024
+    #endif
+
+    /**
+     * This configures the maximum number of allocation sites of the malloc
+     * profiling.
+     */
+    #ifndef CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES
+      #define CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES 64
+    #endif
+
+    #if CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS < 1
+      #error "CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS must be positive"
+    #endif
+
+    #if CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES < 1 || \
+      CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES > 65536
+      #error "CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES must be in 1..65536"
+    #endif
+
+    static rtems_malloc_profiling_allocation _Malloc_profiling_Allocations[
+      CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS
+    ];
+
+    static rtems_malloc_profiling_site _Malloc_profiling_Sites[
+      CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES
+    ];
+
+    static const rtems_malloc_profiling_configuration_t
+      _Malloc_profiling_Configuration = {
+        _Malloc_profiling_Allocations,
+        CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS,
+        _Malloc_profiling_Sites,
+        CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES
+      };
+
+    const rtems_malloc_profiling_configuration_t
+      *rtems_malloc_profiling_configuration = &_Malloc_profiling_Configuration;
+
+    rtems_malloc_profiling_functions_t *rtems_malloc_profiling_helpers =
+      &rtems_malloc_profiling_helpers_table;
+  #else
+    const rtems_malloc_profiling_configuration_t
+      *rtems_malloc_profiling_configuration = NULL;
+
+    rtems_malloc_profiling_functions_t *rtems_malloc_profiling_helpers = NULL;
+  #endif
+#endif
+
 #ifdef CONFIGURE_INIT
   /**
    * This configures the sbrk() support for the malloc family.
@@ -0,0 +1,252 @@
+/**
+ * @file
+ *
+ * @ingroup ClassicProfiling
+ *
+ * @brief Profiling API
+ */
+
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifndef _RTEMS_SAPI_PROFILING_H
+#define _RTEMS_SAPI_PROFILING_H
+
+#include <rtems/rtems/status.h>
+#include <rtems/rtems/types.h>
+#include <rtems/bspIo.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @defgroup ClassicProfiling Profiling
+ *
+ * @ingroup ClassicRTEMS
+ *
+ * @brief Thread dispatch and interrupt latency profiling.
+ *
+ * The profiling support records per processor the distribution of
+ *
+ * - the time thread dispatching is disabled,
+ * - the time from the begin of a thread dispatch until the heir thread
+ *   executes,
+ * - the time spent in outer-most interrupts, and
+ * - the time from an interrupt request until the interrupt entry if the BSP
+ *   provides it.
+ *
+ * In addition, each Classic API semaphore, POSIX mutex, POSIX semaphore and
+ * registered SMP lock records its acquisitions, contended acquisitions, wait
+ * time and hold time.
+ *
+ * The time intervals are measured with the RTEMS counter, see
+ * @ref ClassicCounter.  The profiling support must be enabled with the
+ * --enable-profiling configure option.  Without this option the operating
+ * system has no profiling overhead and the functions of this API report that
+ * profiling is not configured.
+ *
+ * @{
+ */
+
+/**
+ * @brief Profiling histogram types.
+ */
+typedef enum {
+  RTEMS_PROFILING_THREAD_DISPATCH_DISABLED,
+  RTEMS_PROFILING_THREAD_DISPATCH,
+  RTEMS_PROFILING_INTERRUPT,
+  RTEMS_PROFILING_INTERRUPT_LATENCY
+} rtems_profiling_type;
+
+/**
+ * @brief Count of profiling histogram types.
+ */
+#define RTEMS_PROFILING_TYPE_COUNT 4
+
+/**
+ * @brief Count of bins of a profiling histogram.
+ *
+ * Bin zero counts the samples of zero counter ticks.  Bin i greater than
+ * zero counts the samples in the range [2^(i-1), 2^i) counter ticks.
+ */
+#define RTEMS_PROFILING_HISTOGRAM_BINS 33
+
+/**
+ * @brief Profiling histogram.
+ */
+typedef struct {
+  /**
+   * @brief Count of samples.
+   */
+  uint32_t count;
+
+  /**
+   * @brief Minimum sample in nanoseconds.
+   */
+  uint64_t min;
+
+  /**
+   * @brief Maximum sample in nanoseconds.
+   */
+  uint64_t max;
+
+  /**
+   * @brief Arithmetic mean of the samples in nanoseconds.
+   */
+  uint64_t mean;
+
+  /**
+   * @brief Log-scale sample counts.
+   *
+   * @see rtems_profiling_bin_limit().
+   */
+  uint32_t bins[ RTEMS_PROFILING_HISTOGRAM_BINS ];
+} rtems_profiling_histogram;
+
+/**
+ * @brief Indicates if the profiling support is configured.
+ *
+ * @retval true The profiling support is configured.
+ * @retval false Otherwise.
+ */
+bool rtems_profiling_is_configured( void );
+
+/**
+ * @brief Gets a profiling histogram of a processor.
+ *
+ * @param[in] cpu_index The processor index.
+ * @param[in] type The histogram type.
+ * @param[out] histogram The histogram.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_NOT_CONFIGURED The profiling support is not configured.
+ * @retval RTEMS_INVALID_ADDRESS The histogram is NULL.
+ * @retval RTEMS_INVALID_NUMBER Invalid processor index or histogram type.
+ */
+rtems_status_code rtems_profiling_get_histogram(
+  uint32_t                   cpu_index,
+  rtems_profiling_type       type,
+  rtems_profiling_histogram *histogram
+);
+
+/**
+ * @brief Returns the exclusive upper limit of a histogram bin in
+ * nanoseconds.
+ *
+ * @param[in] bin The histogram bin.
+ *
+ * @return The upper limit of the bin in nanoseconds.
+ */
+uint64_t rtems_profiling_bin_limit( uint32_t bin );
+
+/**
+ * @brief Resets the profiling histograms of all processors.
+ */
+void rtems_profiling_reset( void );
+
+/**
+ * @brief Reports the profiling histograms of all processors.
+ *
+ * @param[in] context The context passed to the print handler.
+ * @param[in] print The print handler.
+ */
+void rtems_profiling_report_with_plugin(
+  void                  *context,
+  rtems_printk_plugin_t  print
+);
+
+/**
+ * @brief Reports the profiling histograms of all processors via printk().
+ */
+void rtems_profiling_report( void );
+
+/**
+ * @brief Lock statistics.
+ *
+ * All time values are in nanoseconds.
+ */
+typedef struct {
+  /**
+   * @brief Count of acquisitions.
+   */
+  uint32_t usage_count;
+
+  /**
+   * @brief Count of acquisitions which had to wait for the lock.
+   */
+  uint32_t contention_count;
+
+  /**
+   * @brief Total wait time of contended acquisitions.
+   */
+  uint64_t total_wait_time;
+
+  /**
+   * @brief Maximum wait time of a contended acquisition.
+   */
+  uint64_t max_wait_time;
+
+  /**
+   * @brief Total hold time.
+   *
+   * Semaphores have no owner, so the hold time is zero for them.
+   */
+  uint64_t total_hold_time;
+
+  /**
+   * @brief Maximum hold time.
+   */
+  uint64_t max_hold_time;
+} rtems_profiling_lock_stats;
+
+/**
+ * @brief Gets the lock statistics of a semaphore or mutex.
+ *
+ * @param[in] id The identifier of a Classic API semaphore, a POSIX mutex or a
+ * POSIX semaphore.
+ * @param[out] stats The lock statistics.
+ *
+ * @retval RTEMS_SUCCESSFUL Successful operation.
+ * @retval RTEMS_NOT_CONFIGURED The profiling support is not configured.
+ * @retval RTEMS_INVALID_ADDRESS The lock statistics pointer is NULL.
+ * @retval RTEMS_INVALID_ID Invalid identifier.
+ * @retval RTEMS_ILLEGAL_ON_REMOTE_OBJECT The object is a remote object.
+ */
+rtems_status_code rtems_profiling_get_lock_stats(
+  rtems_id                    id,
+  rtems_profiling_lock_stats *stats
+);
+
+/**
+ * @brief Reports the lock statistics of all semaphores, mutexes and
+ * registered SMP locks.
+ *
+ * The locks are sorted by the count of contended acquisitions in descending
+ * order.
+ *
+ * @param[in] context The context passed to the print handler.
+ * @param[in] print The print handler.
+ */
+void rtems_profiling_lock_report_with_plugin(
+  void                  *context,
+  rtems_printk_plugin_t  print
+);
+
+/**
+ * @brief Reports the lock statistics via printk().
+ *
+ * @see rtems_profiling_lock_report_with_plugin().
+ */
+void rtems_profiling_lock_report( void );
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* _RTEMS_SAPI_PROFILING_H */
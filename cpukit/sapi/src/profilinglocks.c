@@ -0,0 +1,282 @@
+/**
+ * @file
+ *
+ * @ingroup ClassicProfiling
+ *
+ * @brief Lock Statistics Report
+ */
+
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/profiling.h>
+#include <rtems/counter.h>
+#include <rtems/rtems/object.h>
+#include <rtems/score/lockstatsimpl.h>
+#include <rtems/score/smplock.h>
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#if defined( RTEMS_PROFILING )
+
+/*
+ * The counter converter handles 32-bit values only, so convert the upper and
+ * lower bits separately.
+ */
+static uint64_t profiling_ticks_to_ns( uint64_t ticks )
+{
+  return ( ticks >> 16 ) * rtems_counter_ticks_to_nanoseconds( 1U << 16 )
+    + rtems_counter_ticks_to_nanoseconds(
+      (rtems_counter_ticks) ( ticks & 0xffff )
+    );
+}
+
+static void profiling_convert_lock_stats(
+  rtems_profiling_lock_stats *stats,
+  const Lock_Stats           *lock_stats
+)
+{
+  stats->usage_count = lock_stats->usage_count;
+  stats->contention_count = lock_stats->contention_count;
+  stats->total_wait_time = profiling_ticks_to_ns( lock_stats->total_wait_time );
+  stats->max_wait_time = profiling_ticks_to_ns( lock_stats->max_wait_time );
+  stats->total_hold_time = profiling_ticks_to_ns( lock_stats->total_hold_time );
+  stats->max_hold_time = profiling_ticks_to_ns( lock_stats->max_hold_time );
+}
+
+#endif /* defined( RTEMS_PROFILING ) */
+
+rtems_status_code rtems_profiling_get_lock_stats(
+  rtems_id                    id,
+  rtems_profiling_lock_stats *stats
+)
+{
+#if defined( RTEMS_PROFILING )
+  Lock_Stats copy;
+
+  if ( stats == NULL ) {
+    return RTEMS_INVALID_ADDRESS;
+  }
+
+  switch ( _Lock_Stats_Get_object_stats( id, &copy ) ) {
+
+    case OBJECTS_LOCAL:
+      profiling_convert_lock_stats( stats, &copy );
+      return RTEMS_SUCCESSFUL;
+
+#if defined( RTEMS_MULTIPROCESSING )
+    case OBJECTS_REMOTE:
+      return RTEMS_ILLEGAL_ON_REMOTE_OBJECT;
+#endif
+
+    case OBJECTS_ERROR:
+      break;
+  }
+
+  return RTEMS_INVALID_ID;
+#else
+  (void) id;
+  (void) stats;
+
+  return RTEMS_NOT_CONFIGURED;
+#endif
+}
+
+#if defined( RTEMS_PROFILING )
+
+typedef struct {
+  rtems_id    id;
+  const char *name;
+  Lock_Stats  stats;
+} profiling_lock_entry;
+
+typedef struct {
+  profiling_lock_entry *entries;
+  size_t                capacity;
+  size_t                count;
+} profiling_lock_context;
+
+static void profiling_visit_object_lock(
+  void             *arg,
+  Objects_Id        id,
+  const Lock_Stats *stats
+)
+{
+  profiling_lock_context *ctx = arg;
+  profiling_lock_entry   *entry;
+
+  if ( ctx->count < ctx->capacity ) {
+    entry = &ctx->entries[ ctx->count ];
+    entry->id = id;
+    entry->name = NULL;
+    entry->stats = *stats;
+    ++ctx->count;
+  }
+}
+
+#if defined( RTEMS_SMP )
+static void profiling_count_smp_lock(
+  void             *arg,
+  const char       *name,
+  const Lock_Stats *stats
+)
+{
+  size_t *count = arg;
+
+  (void) name;
+  (void) stats;
+
+  ++( *count );
+}
+
+static void profiling_visit_smp_lock(
+  void             *arg,
+  const char       *name,
+  const Lock_Stats *stats
+)
+{
+  profiling_lock_context *ctx = arg;
+  profiling_lock_entry   *entry;
+
+  /*
+   * Interrupts are already disabled by the iteration.
+   */
+  if ( ctx->count < ctx->capacity ) {
+    entry = &ctx->entries[ ctx->count ];
+    entry->id = 0;
+    entry->name = name;
+    entry->stats = *stats;
+    ++ctx->count;
+  }
+}
+#endif
+
+static void profiling_collect_locks( profiling_lock_context *ctx )
+{
+  _Lock_Stats_Iterate_objects( profiling_visit_object_lock, ctx );
+
+#if defined( RTEMS_SMP )
+  _SMP_lock_Stats_iterate( profiling_visit_smp_lock, ctx );
+#endif
+}
+
+static size_t profiling_count_locks( void )
+{
+  size_t count = _Lock_Stats_Get_objects_maximum();
+
+#if defined( RTEMS_SMP )
+  _SMP_lock_Stats_iterate( profiling_count_smp_lock, &count );
+#endif
+
+  return count;
+}
+
+static int profiling_compare_locks( const void *a, const void *b )
+{
+  const Lock_Stats *sa = &( (const profiling_lock_entry *) a )->stats;
+  const Lock_Stats *sb = &( (const profiling_lock_entry *) b )->stats;
+
+  if ( sa->contention_count != sb->contention_count ) {
+    return sa->contention_count < sb->contention_count ? 1 : -1;
+  }
+
+  if ( sa->total_wait_time != sb->total_wait_time ) {
+    return sa->total_wait_time < sb->total_wait_time ? 1 : -1;
+  }
+
+  if ( sa->usage_count != sb->usage_count ) {
+    return sa->usage_count < sb->usage_count ? 1 : -1;
+  }
+
+  return 0;
+}
+
+static void profiling_print_lock(
+  void                       *context,
+  rtems_printk_plugin_t       print,
+  const profiling_lock_entry *entry
+)
+{
+  rtems_profiling_lock_stats stats;
+  char                       name[ 16 ];
+
+  profiling_convert_lock_stats( &stats, &entry->stats );
+
+  if ( entry->name != NULL ) {
+    (*print)( context, "%-10s %-12s", "SMP", entry->name );
+  } else {
+    rtems_object_get_name( entry->id, sizeof( name ), name );
+    (*print)( context, "0x%08" PRIx32 " %-12s", entry->id, name );
+  }
+
+  (*print)(
+    context,
+    " %10" PRIu32 " %10" PRIu32 " %12" PRIu64 " %10" PRIu64
+      " %12" PRIu64 " %10" PRIu64 "\n",
+    stats.usage_count,
+    stats.contention_count,
+    stats.total_wait_time,
+    stats.max_wait_time,
+    stats.total_hold_time,
+    stats.max_hold_time
+  );
+}
+
+#endif /* defined( RTEMS_PROFILING ) */
+
+void rtems_profiling_lock_report_with_plugin(
+  void                  *context,
+  rtems_printk_plugin_t  print
+)
+{
+#if defined( RTEMS_PROFILING )
+  profiling_lock_context ctx;
+  size_t                 i;
+
+  ctx.capacity = profiling_count_locks();
+  ctx.count = 0;
+  ctx.entries = malloc( ctx.capacity * sizeof( *ctx.entries ) );
+
+  if ( ctx.entries == NULL && ctx.capacity > 0 ) {
+    (*print)( context, "not enough memory for the lock report\n" );
+    return;
+  }
+
+  profiling_collect_locks( &ctx );
+
+  qsort(
+    ctx.entries,
+    ctx.count,
+    sizeof( *ctx.entries ),
+    profiling_compare_locks
+  );
+
+  (*print)(
+    context,
+    "LOCK STATISTICS (sorted by contention, times in ns)\n"
+    "ID         NAME           ACQUIRED  CONTENDED   WAIT TOTAL   WAIT MAX"
+      "   HOLD TOTAL   HOLD MAX\n"
+  );
+
+  for ( i = 0; i < ctx.count; ++i ) {
+    profiling_print_lock( context, print, &ctx.entries[ i ] );
+  }
+
+  free( ctx.entries );
+#else
+  (*print)( context, "profiling is not configured\n" );
+#endif
+}
+
+void rtems_profiling_lock_report( void )
+{
+  rtems_profiling_lock_report_with_plugin( NULL, printk_plugin );
+}
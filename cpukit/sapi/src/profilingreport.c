@@ -0,0 +1,217 @@
+/**
+ * @file
+ *
+ * @ingroup ClassicProfiling
+ *
+ * @brief Profiling Report
+ */
+
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/profiling.h>
+#include <rtems/counter.h>
+#include <rtems/score/percpu.h>
+#include <rtems/rtems/smp.h>
+
+#include <inttypes.h>
+#include <string.h>
+
+static const char * const profiling_type_names[ RTEMS_PROFILING_TYPE_COUNT ] = {
+  "thread dispatch disabled",
+  "thread dispatch",
+  "interrupt",
+  "interrupt latency"
+};
+
+bool rtems_profiling_is_configured( void )
+{
+#if defined( RTEMS_PROFILING )
+  return true;
+#else
+  return false;
+#endif
+}
+
+#if defined( RTEMS_PROFILING )
+static Profiling_Histogram *get_histogram(
+  Per_CPU_Control      *cpu,
+  rtems_profiling_type  type
+)
+{
+  Per_CPU_Stats *stats = &cpu->Stats;
+
+  switch ( type ) {
+    case RTEMS_PROFILING_THREAD_DISPATCH_DISABLED:
+      return &stats->thread_dispatch_disabled;
+    case RTEMS_PROFILING_THREAD_DISPATCH:
+      return &stats->thread_dispatch;
+    case RTEMS_PROFILING_INTERRUPT:
+      return &stats->interrupt;
+    default:
+      return &stats->interrupt_latency;
+  }
+}
+#endif
+
+rtems_status_code rtems_profiling_get_histogram(
+  uint32_t                   cpu_index,
+  rtems_profiling_type       type,
+  rtems_profiling_histogram *histogram
+)
+{
+#if defined( RTEMS_PROFILING )
+  Profiling_Histogram  snapshot;
+  Profiling_Histogram *source;
+  ISR_Level            level;
+  uint32_t             bin;
+
+  if ( histogram == NULL ) {
+    return RTEMS_INVALID_ADDRESS;
+  }
+
+  if (
+    cpu_index >= rtems_smp_get_processor_count()
+      || (uint32_t) type >= RTEMS_PROFILING_TYPE_COUNT
+  ) {
+    return RTEMS_INVALID_NUMBER;
+  }
+
+  source = get_histogram( _Per_CPU_Get_by_index( cpu_index ), type );
+
+  /*
+   * The histograms of other processors may change during the copy on SMP
+   * configurations.  This is acceptable for statistics.
+   */
+  _CPU_ISR_Disable( level );
+  snapshot = *source;
+  _CPU_ISR_Enable( level );
+
+  histogram->count = snapshot.count;
+
+  if ( snapshot.count > 0 ) {
+    histogram->min = rtems_counter_ticks_to_nanoseconds( snapshot.min );
+    histogram->max = rtems_counter_ticks_to_nanoseconds( snapshot.max );
+    histogram->mean = rtems_counter_ticks_to_nanoseconds(
+      (rtems_counter_ticks) ( snapshot.total / snapshot.count )
+    );
+  } else {
+    histogram->min = 0;
+    histogram->max = 0;
+    histogram->mean = 0;
+  }
+
+  for ( bin = 0; bin < RTEMS_PROFILING_HISTOGRAM_BINS; ++bin ) {
+    histogram->bins[ bin ] = snapshot.bins[ bin ];
+  }
+
+  return RTEMS_SUCCESSFUL;
+#else
+  (void) cpu_index;
+  (void) type;
+  (void) histogram;
+
+  return RTEMS_NOT_CONFIGURED;
+#endif
+}
+
+uint64_t rtems_profiling_bin_limit( uint32_t bin )
+{
+  /*
+   * Avoid an overflow of the counter ticks type for the upper bins.
+   */
+  if ( bin < 16 ) {
+    return rtems_counter_ticks_to_nanoseconds( UINT32_C(1) << bin );
+  } else {
+    return rtems_counter_ticks_to_nanoseconds( UINT32_C(1) << 16 )
+      << ( bin - 16 );
+  }
+}
+
+void rtems_profiling_reset( void )
+{
+#if defined( RTEMS_PROFILING )
+  uint32_t cpu_count = rtems_smp_get_processor_count();
+  uint32_t cpu_index;
+
+  for ( cpu_index = 0; cpu_index < cpu_count; ++cpu_index ) {
+    Per_CPU_Stats *stats = &_Per_CPU_Get_by_index( cpu_index )->Stats;
+    ISR_Level      level;
+
+    _CPU_ISR_Disable( level );
+    memset(
+      &stats->thread_dispatch_disabled,
+      0,
+      sizeof( stats->thread_dispatch_disabled )
+    );
+    memset( &stats->thread_dispatch, 0, sizeof( stats->thread_dispatch ) );
+    memset( &stats->interrupt, 0, sizeof( stats->interrupt ) );
+    memset( &stats->interrupt_latency, 0, sizeof( stats->interrupt_latency ) );
+    _CPU_ISR_Enable( level );
+  }
+#endif
+}
+
+void rtems_profiling_report_with_plugin(
+  void                  *context,
+  rtems_printk_plugin_t  print
+)
+{
+  uint32_t cpu_count = rtems_smp_get_processor_count();
+  uint32_t cpu_index;
+
+  if ( !rtems_profiling_is_configured() ) {
+    (*print)( context, "profiling is not configured\n" );
+    return;
+  }
+
+  for ( cpu_index = 0; cpu_index < cpu_count; ++cpu_index ) {
+    uint32_t type;
+
+    for ( type = 0; type < RTEMS_PROFILING_TYPE_COUNT; ++type ) {
+      rtems_profiling_histogram histogram;
+      uint32_t                  bin;
+
+      rtems_profiling_get_histogram(
+        cpu_index,
+        (rtems_profiling_type) type,
+        &histogram
+      );
+
+      (*print)(
+        context,
+        "CPU %" PRIu32 " %s: count %" PRIu32 ", min %" PRIu64
+          " ns, mean %" PRIu64 " ns, max %" PRIu64 " ns\n",
+        cpu_index,
+        profiling_type_names[ type ],
+        histogram.count,
+        histogram.min,
+        histogram.mean,
+        histogram.max
+      );
+
+      for ( bin = 0; bin < RTEMS_PROFILING_HISTOGRAM_BINS; ++bin ) {
+        if ( histogram.bins[ bin ] != 0 ) {
+          (*print)(
+            context,
+            "  < %" PRIu64 " ns: %" PRIu32 "\n",
+            rtems_profiling_bin_limit( bin ),
+            histogram.bins[ bin ]
+          );
+        }
+      }
+    }
+  }
+}
+
+void rtems_profiling_report( void )
+{
+  rtems_profiling_report_with_plugin( NULL, printk_plugin );
+}
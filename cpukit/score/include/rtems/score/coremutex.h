@@ -26,6 +26,7 @@
 #include <rtems/score/priority.h>
 #include <rtems/score/watchdog.h>
 #include <rtems/score/interr.h>
+#include <rtems/score/lockstats.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -175,6 +176,10 @@ typedef struct {
   /** This field is used to manipulate the priority inheritance mutex queue*/
   CORE_mutex_order_list   queue;
 #endif
+#if defined(RTEMS_PROFILING)
+  /** This field contains the lock statistics of this mutex. */
+  Lock_Stats              Stats;
+#endif
 
 }   CORE_mutex_Control;
 
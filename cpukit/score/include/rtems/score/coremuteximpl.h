@@ -433,6 +433,96 @@ RTEMS_INLINE_ROUTINE bool _CORE_mutex_Is_priority_ceiling(
   return the_attribute->discipline == CORE_MUTEX_DISCIPLINES_PRIORITY_CEILING;
 }
 
+/**
+ * @brief Initializes the lock statistics of a mutex.
+ *
+ * @param[in] the_mutex The mutex.
+ */
+RTEMS_INLINE_ROUTINE void _CORE_mutex_Stats_initialize(
+  CORE_mutex_Control *the_mutex
+)
+{
+#if defined(RTEMS_PROFILING)
+  _Lock_Stats_Initialize( &the_mutex->Stats );
+#else
+  (void) the_mutex;
+#endif
+}
+
+/**
+ * @brief Accounts an uncontended acquisition of a mutex.
+ *
+ * @param[in] the_mutex The mutex.
+ */
+RTEMS_INLINE_ROUTINE void _CORE_mutex_Stats_acquired(
+  CORE_mutex_Control *the_mutex
+)
+{
+#if defined(RTEMS_PROFILING)
+  _Lock_Stats_Acquired( &the_mutex->Stats, _CPU_Counter_read() );
+#else
+  (void) the_mutex;
+#endif
+}
+
+/**
+ * @brief Records the begin of the wait of a thread for a mutex.
+ *
+ * @param[in] executing The thread about to block on the mutex.
+ */
+RTEMS_INLINE_ROUTINE void _CORE_mutex_Stats_wait(
+  Thread_Control *executing
+)
+{
+#if defined(RTEMS_PROFILING)
+  executing->Wait.lock_wait_instant = _CPU_Counter_read();
+#else
+  (void) executing;
+#endif
+}
+
+/**
+ * @brief Accounts the transfer of a mutex to a waiting thread.
+ *
+ * @param[in] the_mutex The mutex.
+ * @param[in] the_thread The new holder of the mutex.
+ */
+RTEMS_INLINE_ROUTINE void _CORE_mutex_Stats_handover(
+  CORE_mutex_Control *the_mutex,
+  Thread_Control     *the_thread
+)
+{
+#if defined(RTEMS_PROFILING)
+  CPU_Counter_ticks now = _CPU_Counter_read();
+
+  _Lock_Stats_Contended(
+    &the_mutex->Stats,
+    the_thread->Wait.lock_wait_instant,
+    now
+  );
+  _Lock_Stats_Acquired( &the_mutex->Stats, now );
+#else
+  (void) the_mutex;
+  (void) the_thread;
+#endif
+}
+
+/**
+ * @brief Accounts the release of a mutex.
+ *
+ * @param[in] the_mutex The mutex.
+ */
+RTEMS_INLINE_ROUTINE void _CORE_mutex_Stats_released(
+  CORE_mutex_Control *the_mutex
+)
+{
+#if defined(RTEMS_PROFILING)
+  _Lock_Stats_Released( &the_mutex->Stats );
+#else
+  (void) the_mutex;
+#endif
+}
+
 /*
  *  Seize Mutex with Quick Success Path
  *
@@ -456,6 +546,7 @@ RTEMS_INLINE_ROUTINE int _CORE_mutex_Seize_interrupt_trylock_body(
     the_mutex->holder     = executing;
     the_mutex->holder_id  = executing->Object.id;
     the_mutex->nest_count = 1;
+    _CORE_mutex_Stats_acquired( the_mutex );
     if ( _CORE_mutex_Is_inherit_priority( &the_mutex->Attributes ) ||
          _CORE_mutex_Is_priority_ceiling( &the_mutex->Attributes ) ){
 
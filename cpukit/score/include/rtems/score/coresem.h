@@ -22,6 +22,7 @@
 #define _RTEMS_SCORE_CORESEM_H
 
 #include <rtems/score/threadq.h>
+#include <rtems/score/lockstats.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -77,6 +78,12 @@ typedef struct {
   CORE_semaphore_Attributes   Attributes;
   /** This element contains the current count of this semaphore. */
   uint32_t                    count;
+#if defined(RTEMS_PROFILING)
+  /** This field contains the lock statistics of this semaphore.  The hold
+   *  time is not recorded since a semaphore has no owner.
+   */
+  Lock_Stats                  Stats;
+#endif
 }   CORE_semaphore_Control;
 
 /**@}*/
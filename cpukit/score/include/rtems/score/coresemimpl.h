@@ -195,6 +195,89 @@ RTEMS_INLINE_ROUTINE uint32_t  _CORE_semaphore_Get_count(
   return the_semaphore->count;
 }
 
+/**
+ * @brief Initializes the lock statistics of a semaphore.
+ *
+ * @param[in] the_semaphore The semaphore.
+ */
+RTEMS_INLINE_ROUTINE void _CORE_semaphore_Stats_initialize(
+  CORE_semaphore_Control *the_semaphore
+)
+{
+#if defined(RTEMS_PROFILING)
+  _Lock_Stats_Initialize( &the_semaphore->Stats );
+#else
+  (void) the_semaphore;
+#endif
+}
+
+/**
+ * @brief Accounts an uncontended acquisition of a semaphore unit.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param[in] the_semaphore The semaphore.
+ */
+RTEMS_INLINE_ROUTINE void _CORE_semaphore_Stats_acquired(
+  CORE_semaphore_Control *the_semaphore
+)
+{
+#if defined(RTEMS_PROFILING)
+  _Lock_Stats_Acquired( &the_semaphore->Stats, _CPU_Counter_read() );
+#else
+  (void) the_semaphore;
+#endif
+}
+
+/**
+ * @brief Records the begin of the wait of a thread for a semaphore.
+ *
+ * @param[in] executing The thread about to block on the semaphore.
+ */
+RTEMS_INLINE_ROUTINE void _CORE_semaphore_Stats_wait(
+  Thread_Control *executing
+)
+{
+#if defined(RTEMS_PROFILING)
+  executing->Wait.lock_wait_instant = _CPU_Counter_read();
+#else
+  (void) executing;
+#endif
+}
+
+/**
+ * @brief Accounts the transfer of a semaphore unit to a waiting thread.
+ *
+ * Interrupts are disabled during the update since a semaphore may be
+ * obtained and released in interrupt context.
+ *
+ * @param[in] the_semaphore The semaphore.
+ * @param[in] the_thread The thread which receives the unit.
+ */
+RTEMS_INLINE_ROUTINE void _CORE_semaphore_Stats_handover(
+  CORE_semaphore_Control *the_semaphore,
+  Thread_Control         *the_thread
+)
+{
+#if defined(RTEMS_PROFILING)
+  ISR_Level         level;
+  CPU_Counter_ticks now;
+
+  _ISR_Disable( level );
+  now = _CPU_Counter_read();
+  _Lock_Stats_Contended(
+    &the_semaphore->Stats,
+    the_thread->Wait.lock_wait_instant,
+    now
+  );
+  _Lock_Stats_Acquired( &the_semaphore->Stats, now );
+  _ISR_Enable( level );
+#else
+  (void) the_semaphore;
+  (void) the_thread;
+#endif
+}
+
 /**
  * This routine attempts to receive a unit from the_semaphore.
  * If a unit is available or if the wait flag is false, then the routine
@@ -225,6 +308,7 @@ RTEMS_INLINE_ROUTINE void _CORE_semaphore_Seize_isr_disable(
   executing->Wait.return_code = CORE_SEMAPHORE_STATUS_SUCCESSFUL;
   if ( the_semaphore->count != 0 ) {
     the_semaphore->count -= 1;
+    _CORE_semaphore_Stats_acquired( the_semaphore );
     _ISR_Enable( level );
     return;
   }
@@ -239,6 +323,7 @@ RTEMS_INLINE_ROUTINE void _CORE_semaphore_Seize_isr_disable(
   _Thread_queue_Enter_critical_section( &the_semaphore->Wait_queue );
   executing->Wait.queue          = &the_semaphore->Wait_queue;
   executing->Wait.id             = id;
+  _CORE_semaphore_Stats_wait( executing );
   _ISR_Enable( level );
 
   _Thread_queue_Enqueue( &the_semaphore->Wait_queue, executing, timeout );
@@ -69,7 +69,12 @@ typedef enum {
   * location. This flag guarantee that all effects of all previous data
   * accesses are completed before the store operation takes place.
   */
-  ATOMIC_ORDER_RELEASE = memory_order_release
+  ATOMIC_ORDER_RELEASE = memory_order_release,
+  /** a load operation performs an acquire operation, a store operation
+  * performs a release operation and read-modify-write operations perform
+  * both.  In addition, all such operations are in a single total order.
+  */
+  ATOMIC_ORDER_SEQ_CST = memory_order_seq_cst
 } Atomic_Order;
 
 
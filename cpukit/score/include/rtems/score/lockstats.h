@@ -0,0 +1,167 @@
+/**
+ * @file
+ *
+ * @ingroup ScoreLockStats
+ *
+ * @brief Lock Statistics API
+ */
+
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifndef _RTEMS_SCORE_LOCKSTATS_H
+#define _RTEMS_SCORE_LOCKSTATS_H
+
+#include <rtems/score/cpu.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @defgroup ScoreLockStats Lock Statistics
+ *
+ * @ingroup Score
+ *
+ * @brief Lock contention statistics.
+ *
+ * The lock statistics record the acquisitions, the contended acquisitions,
+ * the wait time of contended acquisitions and the hold time of a lock.  The
+ * time intervals are measured in CPU counter ticks.  Mutexes, semaphores and
+ * SMP locks contain lock statistics only if the profiling support is enabled
+ * with the --enable-profiling configure option.
+ *
+ * The lock statistics are not protected by a lock of their own.  They must be
+ * updated by the owner of the lock, or in the critical section which protects
+ * the lock state.
+ *
+ * @{
+ */
+
+/**
+ * @brief Lock statistics.
+ */
+typedef struct {
+  /**
+   * @brief Count of acquisitions.
+   */
+  uint32_t usage_count;
+
+  /**
+   * @brief Count of acquisitions which had to wait for the lock.
+   */
+  uint32_t contention_count;
+
+  /**
+   * @brief Total wait time of contended acquisitions.
+   */
+  uint64_t total_wait_time;
+
+  /**
+   * @brief Maximum wait time of a contended acquisition.
+   */
+  CPU_Counter_ticks max_wait_time;
+
+  /**
+   * @brief Total hold time.
+   */
+  uint64_t total_hold_time;
+
+  /**
+   * @brief Maximum hold time.
+   */
+  CPU_Counter_ticks max_hold_time;
+
+  /**
+   * @brief The CPU counter value of the last acquisition.
+   */
+  CPU_Counter_ticks acquire_instant;
+} Lock_Stats;
+
+/**
+ * @brief Lock statistics initializer for static initialization.
+ */
+#define LOCK_STATS_INITIALIZER { 0, 0, 0, 0, 0, 0, 0 }
+
+/**
+ * @brief Initializes lock statistics.
+ *
+ * @param[out] stats The lock statistics.
+ */
+RTEMS_INLINE_ROUTINE void _Lock_Stats_Initialize( Lock_Stats *stats )
+{
+  stats->usage_count = 0;
+  stats->contention_count = 0;
+  stats->total_wait_time = 0;
+  stats->max_wait_time = 0;
+  stats->total_hold_time = 0;
+  stats->max_hold_time = 0;
+  stats->acquire_instant = 0;
+}
+
+/**
+ * @brief Accounts a contended acquisition.
+ *
+ * @param[in,out] stats The lock statistics.
+ * @param[in] wait_instant The CPU counter value at the begin of the wait.
+ * @param[in] acquire_instant The CPU counter value at the acquisition.
+ */
+RTEMS_INLINE_ROUTINE void _Lock_Stats_Contended(
+  Lock_Stats        *stats,
+  CPU_Counter_ticks  wait_instant,
+  CPU_Counter_ticks  acquire_instant
+)
+{
+  CPU_Counter_ticks wait_time =
+    _CPU_Counter_difference( acquire_instant, wait_instant );
+
+  ++stats->contention_count;
+  stats->total_wait_time += wait_time;
+
+  if ( wait_time > stats->max_wait_time ) {
+    stats->max_wait_time = wait_time;
+  }
+}
+
+/**
+ * @brief Accounts an acquisition.
+ *
+ * @param[in,out] stats The lock statistics.
+ * @param[in] acquire_instant The CPU counter value at the acquisition.
+ */
+RTEMS_INLINE_ROUTINE void _Lock_Stats_Acquired(
+  Lock_Stats        *stats,
+  CPU_Counter_ticks  acquire_instant
+)
+{
+  ++stats->usage_count;
+  stats->acquire_instant = acquire_instant;
+}
+
+/**
+ * @brief Accounts a release.
+ *
+ * @param[in,out] stats The lock statistics.
+ */
+RTEMS_INLINE_ROUTINE void _Lock_Stats_Released( Lock_Stats *stats )
+{
+  CPU_Counter_ticks hold_time =
+    _CPU_Counter_difference( _CPU_Counter_read(), stats->acquire_instant );
+
+  stats->total_hold_time += hold_time;
+
+  if ( hold_time > stats->max_hold_time ) {
+    stats->max_hold_time = hold_time;
+  }
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* _RTEMS_SCORE_LOCKSTATS_H */
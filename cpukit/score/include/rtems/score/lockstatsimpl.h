@@ -0,0 +1,131 @@
+/**
+ * @file
+ *
+ * @ingroup ScoreLockStats
+ *
+ * @brief Lock Statistics Implementation
+ */
+
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifndef _RTEMS_SCORE_LOCKSTATSIMPL_H
+#define _RTEMS_SCORE_LOCKSTATSIMPL_H
+
+#include <rtems/score/lockstats.h>
+#include <rtems/score/chain.h>
+#include <rtems/score/objectimpl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @addtogroup ScoreLockStats
+ *
+ * @{
+ */
+
+#if defined( RTEMS_PROFILING )
+/**
+ * @brief Returns the lock statistics of an object or NULL if the object has
+ * no lock statistics.
+ *
+ * Thread dispatching is disabled.
+ */
+typedef const Lock_Stats *( *Lock_Stats_Object_handler )(
+  Objects_Control *object
+);
+
+/**
+ * @brief An object class with lock statistics.
+ *
+ * The APIs register their object classes which contain lock statistics with
+ * _Lock_Stats_Register_objects() during the manager initialization.
+ */
+typedef struct {
+  /**
+   * @brief Node for the registry.
+   */
+  Chain_Node Node;
+
+  /**
+   * @brief The object information of the class.
+   */
+  Objects_Information *information;
+
+  /**
+   * @brief Returns the lock statistics of an object of the class.
+   */
+  Lock_Stats_Object_handler get;
+} Lock_Stats_Objects;
+
+/**
+ * @brief Visitor for _Lock_Stats_Iterate_objects().
+ *
+ * @param[in] arg The visitor argument.
+ * @param[in] id The object identifier.
+ * @param[in] stats A copy of the lock statistics of the object.
+ */
+typedef void ( *Lock_Stats_Object_visitor )(
+  void             *arg,
+  Objects_Id        id,
+  const Lock_Stats *stats
+);
+
+/**
+ * @brief Registers an object class with lock statistics.
+ *
+ * This function must be called during system initialization.
+ *
+ * @param[in] objects The object class.  It must be valid as long as the
+ * system runs.
+ */
+void _Lock_Stats_Register_objects( Lock_Stats_Objects *objects );
+
+/**
+ * @brief Gets a copy of the lock statistics of an object.
+ *
+ * @param[in] id The object identifier.
+ * @param[out] stats The copy of the lock statistics.
+ *
+ * @retval OBJECTS_LOCAL Successful operation.
+ * @retval OBJECTS_REMOTE The object is a remote object.
+ * @retval OBJECTS_ERROR Invalid identifier or the object has no lock
+ * statistics.
+ */
+Objects_Locations _Lock_Stats_Get_object_stats(
+  Objects_Id  id,
+  Lock_Stats *stats
+);
+
+/**
+ * @brief Returns the maximum count of objects with lock statistics.
+ */
+size_t _Lock_Stats_Get_objects_maximum( void );
+
+/**
+ * @brief Visits the lock statistics of all objects of the registered object
+ * classes.
+ *
+ * The visitor is called with thread dispatching disabled.
+ *
+ * @param[in] visitor The visitor.
+ * @param[in] arg The visitor argument.
+ */
+void _Lock_Stats_Iterate_objects(
+  Lock_Stats_Object_visitor  visitor,
+  void                      *arg
+);
+#endif
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* _RTEMS_SCORE_LOCKSTATSIMPL_H */
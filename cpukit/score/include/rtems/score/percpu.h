@@ -40,7 +40,14 @@ extern "C" {
    * used in assembler code to easily get the per-CPU control for a particular
    * processor.
    */
-  #define PER_CPU_CONTROL_SIZE_LOG2 7
+  #if defined( RTEMS_PROFILING )
+    /*
+     * The profiling statistics do not fit into the default size.
+     */
+    #define PER_CPU_CONTROL_SIZE_LOG2 10
+  #else
+    #define PER_CPU_CONTROL_SIZE_LOG2 7
+  #endif
 
   #define PER_CPU_CONTROL_SIZE ( 1 << PER_CPU_CONTROL_SIZE_LOG2 )
 #endif
@@ -154,6 +161,91 @@ typedef enum {
 
 #endif /* defined( RTEMS_SMP ) */
 
+#if defined( RTEMS_PROFILING )
+/**
+ * @brief Count of bins of a profiling histogram.
+ *
+ * Bin zero counts the samples of zero counter ticks.  Bin i greater than
+ * zero counts the samples in the range [2^(i-1), 2^i) counter ticks.
+ */
+#define PROFILING_HISTOGRAM_BINS 33
+
+/**
+ * @brief Profiling histogram of time intervals measured in CPU counter
+ * ticks.
+ */
+typedef struct {
+  /**
+   * @brief Count of samples.
+   */
+  uint32_t count;
+
+  /**
+   * @brief Minimum sample.
+   */
+  CPU_Counter_ticks min;
+
+  /**
+   * @brief Maximum sample.
+   */
+  CPU_Counter_ticks max;
+
+  /**
+   * @brief Sum of all samples.
+   */
+  uint64_t total;
+
+  /**
+   * @brief Log-scale sample counts.
+   */
+  uint32_t bins[ PROFILING_HISTOGRAM_BINS ];
+} Profiling_Histogram;
+
+/**
+ * @brief Per-CPU profiling statistics.
+ *
+ * @see _Profiling_Thread_dispatch_disable(),
+ * _Profiling_Thread_dispatch_enable() and
+ * _Profiling_Interrupt_exit().
+ */
+typedef struct {
+  /**
+   * @brief The CPU counter value when the thread dispatch disable level
+   * changed from zero to one.
+   */
+  CPU_Counter_ticks thread_dispatch_disabled_instant;
+
+  /**
+   * @brief The CPU counter value at the begin of the last thread dispatch.
+   */
+  CPU_Counter_ticks thread_dispatch_instant;
+
+  /**
+   * @brief The time thread dispatching was disabled.
+   */
+  Profiling_Histogram thread_dispatch_disabled;
+
+  /**
+   * @brief The time from the begin of a thread dispatch until the heir
+   * thread executes.
+   */
+  Profiling_Histogram thread_dispatch;
+
+  /**
+   * @brief The time spent in outer-most interrupts.
+   */
+  Profiling_Histogram interrupt;
+
+  /**
+   * @brief The time from the interrupt request until the interrupt entry.
+   *
+   * Only BSPs which know the instant of the interrupt request provide these
+   * samples.
+   */
+  Profiling_Histogram interrupt_latency;
+} Per_CPU_Stats;
+#endif
+
 /**
  *  @brief Per CPU Core Structure
  *
@@ -236,6 +328,13 @@ typedef struct {
      */
     Per_CPU_State state;
   #endif
+
+  #if defined( RTEMS_PROFILING )
+    /**
+     * @brief The profiling statistics of this CPU.
+     */
+    Per_CPU_Stats Stats;
+  #endif
 } Per_CPU_Control;
 
 #if defined( RTEMS_SMP )
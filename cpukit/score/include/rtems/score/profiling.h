@@ -0,0 +1,304 @@
+/**
+ * @file
+ *
+ * @ingroup ScoreProfiling
+ *
+ * @brief Profiling Support API
+ */
+
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifndef _RTEMS_SCORE_PROFILING_H
+#define _RTEMS_SCORE_PROFILING_H
+
+#include <rtems/score/percpu.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @defgroup ScoreProfiling Profiling Support
+ *
+ * @ingroup Score
+ *
+ * @brief Profiling support.
+ *
+ * The profiling support records the time intervals thread dispatching is
+ * disabled, the thread dispatch latency and the interrupt processing time per
+ * CPU in histograms.  It is enabled with the --enable-profiling configure
+ * option.  Without this option all functions of this header file are empty
+ * and the compiler removes them.
+ *
+ * @{
+ */
+
+#if defined( RTEMS_PROFILING )
+/**
+ * @brief Returns the histogram bin of a sample.
+ *
+ * @param[in] ticks The sample in CPU counter ticks.
+ *
+ * @return The bin index, see PROFILING_HISTOGRAM_BINS.
+ */
+RTEMS_INLINE_ROUTINE uint32_t _Profiling_Histogram_bin(
+  CPU_Counter_ticks ticks
+)
+{
+  uint32_t bin = 0;
+
+  if ( ticks >= 0x10000 ) {
+    bin += 16;
+    ticks >>= 16;
+  }
+
+  if ( ticks >= 0x100 ) {
+    bin += 8;
+    ticks >>= 8;
+  }
+
+  if ( ticks >= 0x10 ) {
+    bin += 4;
+    ticks >>= 4;
+  }
+
+  if ( ticks >= 0x4 ) {
+    bin += 2;
+    ticks >>= 2;
+  }
+
+  if ( ticks >= 0x2 ) {
+    bin += 1;
+    ticks >>= 1;
+  }
+
+  return bin + (uint32_t) ticks;
+}
+
+/**
+ * @brief Adds a sample to a histogram.
+ *
+ * @param[in] histogram The histogram.
+ * @param[in] ticks The sample in CPU counter ticks.
+ */
+RTEMS_INLINE_ROUTINE void _Profiling_Histogram_update(
+  Profiling_Histogram *histogram,
+  CPU_Counter_ticks    ticks
+)
+{
+  if ( histogram->count == 0 || ticks < histogram->min ) {
+    histogram->min = ticks;
+  }
+
+  if ( ticks > histogram->max ) {
+    histogram->max = ticks;
+  }
+
+  ++histogram->count;
+  histogram->total += ticks;
+  ++histogram->bins[ _Profiling_Histogram_bin( ticks ) ];
+}
+#endif
+
+/**
+ * @brief Notifies the profiling support that the thread dispatch disable
+ * level was incremented.
+ *
+ * Must be called with interrupts disabled after the new thread dispatch
+ * disable level is stored.
+ *
+ * @param[in] cpu The current CPU.
+ * @param[in] previous_thread_dispatch_disable_level The thread dispatch
+ * disable level before the increment.
+ */
+RTEMS_INLINE_ROUTINE void _Profiling_Thread_dispatch_disable(
+  Per_CPU_Control *cpu,
+  uint32_t         previous_thread_dispatch_disable_level
+)
+{
+#if defined( RTEMS_PROFILING )
+  if ( previous_thread_dispatch_disable_level == 0 ) {
+    cpu->Stats.thread_dispatch_disabled_instant = _CPU_Counter_read();
+  }
+#else
+  (void) cpu;
+  (void) previous_thread_dispatch_disable_level;
+#endif
+}
+
+/**
+ * @brief Notifies the profiling support that the thread dispatch disable
+ * level is about to be decremented.
+ *
+ * Must be called with interrupts disabled before the new thread dispatch
+ * disable level is stored.
+ *
+ * @param[in] cpu The current CPU.
+ * @param[in] new_thread_dispatch_disable_level The thread dispatch disable
+ * level after the decrement.
+ */
+RTEMS_INLINE_ROUTINE void _Profiling_Thread_dispatch_enable(
+  Per_CPU_Control *cpu,
+  uint32_t         new_thread_dispatch_disable_level
+)
+{
+#if defined( RTEMS_PROFILING )
+  if ( new_thread_dispatch_disable_level == 0 ) {
+    Per_CPU_Stats *stats = &cpu->Stats;
+
+    _Profiling_Histogram_update(
+      &stats->thread_dispatch_disabled,
+      _CPU_Counter_difference(
+        _CPU_Counter_read(),
+        stats->thread_dispatch_disabled_instant
+      )
+    );
+  }
+#else
+  (void) cpu;
+  (void) new_thread_dispatch_disable_level;
+#endif
+}
+
+/**
+ * @brief Notifies the profiling support about the begin of a thread
+ * dispatch.
+ *
+ * @param[in] cpu The current CPU.
+ */
+RTEMS_INLINE_ROUTINE void _Profiling_Thread_dispatch_begin(
+  Per_CPU_Control *cpu
+)
+{
+#if defined( RTEMS_PROFILING )
+  cpu->Stats.thread_dispatch_instant = _CPU_Counter_read();
+#else
+  (void) cpu;
+#endif
+}
+
+/**
+ * @brief Notifies the profiling support that the heir thread of a thread
+ * dispatch executes.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param[in] cpu The current CPU.
+ */
+RTEMS_INLINE_ROUTINE void _Profiling_Thread_dispatch_end(
+  Per_CPU_Control *cpu
+)
+{
+#if defined( RTEMS_PROFILING )
+  Per_CPU_Stats *stats = &cpu->Stats;
+
+  _Profiling_Histogram_update(
+    &stats->thread_dispatch,
+    _CPU_Counter_difference(
+      _CPU_Counter_read(),
+      stats->thread_dispatch_instant
+    )
+  );
+#else
+  (void) cpu;
+#endif
+}
+
+/**
+ * @brief Returns the CPU counter value for the interrupt entry.
+ *
+ * @return The CPU counter value or zero if profiling is disabled.
+ */
+RTEMS_INLINE_ROUTINE CPU_Counter_ticks _Profiling_Interrupt_entry( void )
+{
+#if defined( RTEMS_PROFILING )
+  return _CPU_Counter_read();
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief Updates the interrupt profiling statistics at the interrupt exit.
+ *
+ * Only outer-most interrupts are accounted.  Interrupts are disabled during
+ * the update since nested interrupts may be enabled here.
+ *
+ * @param[in] cpu The current CPU.
+ * @param[in] interrupt_entry_instant The value returned by
+ * _Profiling_Interrupt_entry() at the interrupt entry.
+ */
+RTEMS_INLINE_ROUTINE void _Profiling_Interrupt_exit(
+  Per_CPU_Control   *cpu,
+  CPU_Counter_ticks  interrupt_entry_instant
+)
+{
+#if defined( RTEMS_PROFILING )
+  /*
+   * Ports which do not maintain the nest level during the interrupt dispatch
+   * leave it at zero.
+   */
+  if ( cpu->isr_nest_level <= 1 ) {
+    ISR_Level level;
+
+    _CPU_ISR_Disable( level );
+    _Profiling_Histogram_update(
+      &cpu->Stats.interrupt,
+      _CPU_Counter_difference( _CPU_Counter_read(), interrupt_entry_instant )
+    );
+    _CPU_ISR_Enable( level );
+  }
+#else
+  (void) cpu;
+  (void) interrupt_entry_instant;
+#endif
+}
+
+/**
+ * @brief Updates the interrupt latency profiling statistics.
+ *
+ * This function may be used by BSPs which know the CPU counter value of the
+ * interrupt request, e.g. a timer with a compare register.
+ *
+ * @param[in] cpu The current CPU.
+ * @param[in] interrupt_request_instant The CPU counter value of the
+ * interrupt request.
+ * @param[in] interrupt_entry_instant The CPU counter value of the interrupt
+ * entry.
+ */
+RTEMS_INLINE_ROUTINE void _Profiling_Interrupt_latency(
+  Per_CPU_Control   *cpu,
+  CPU_Counter_ticks  interrupt_request_instant,
+  CPU_Counter_ticks  interrupt_entry_instant
+)
+{
+#if defined( RTEMS_PROFILING )
+  ISR_Level level;
+
+  _CPU_ISR_Disable( level );
+  _Profiling_Histogram_update(
+    &cpu->Stats.interrupt_latency,
+    _CPU_Counter_difference(
+      interrupt_entry_instant,
+      interrupt_request_instant
+    )
+  );
+  _CPU_ISR_Enable( level );
+#else
+  (void) cpu;
+  (void) interrupt_request_instant;
+  (void) interrupt_entry_instant;
+#endif
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* _RTEMS_SCORE_PROFILING_H */
@@ -27,6 +27,11 @@
 #include <rtems/score/atomic.h>
 #include <rtems/score/isrlevel.h>
 
+#if defined( RTEMS_PROFILING )
+#include <rtems/score/chain.h>
+#include <rtems/score/lockstats.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -39,29 +44,122 @@ extern "C" {
  * @brief The SMP lock provides mutual exclusion for SMP systems at the lowest
  * level.
  *
- * The SMP lock is implemented as a ticket lock.  This provides fairness in
- * case of concurrent lock attempts.
+ * The SMP lock is implemented as a ticket lock by default.  This provides
+ * fairness in case of concurrent lock attempts.
+ *
+ * This SMP lock API uses a local context for acquire and release pairs.  In
+ * case RTEMS_SMP_MCS_LOCKS is defined (configure option
+ * --enable-smp-mcs-locks), then the SMP lock is implemented as a
+ * Mellor-Crummey and Scott (MCS) lock and the context is the queue node of
+ * the lock.  The MCS lock provides the same fairness as the ticket lock, but
+ * each waiting processor spins on its own context, so a lock hand over
+ * invalidates only the cache line of the next owner.  The ticket lock and the
+ * MCS lock are also available directly, so that individual locks may use a
+ * particular variant.
  *
- * This SMP lock API uses a local context for acquire and release pairs.  Such
- * a context may be used to implement for example the Mellor-Crummey and Scott
- * (MCS) locks in the future.
+ * In case the profiling support is enabled, then each SMP ticket lock and
+ * each SMP MCS lock records lock statistics.  The statistics of a lock
+ * registered with _SMP_lock_Stats_register() are visible via
+ * _SMP_lock_Stats_iterate().
  *
  * @{
  */
 
+#if defined( RTEMS_PROFILING )
+/**
+ * @brief SMP lock statistics.
+ */
+typedef struct {
+  /**
+   * @brief Node for the chain of registered SMP lock statistics.
+   */
+  Chain_Node Node;
+
+  /**
+   * @brief The name of a registered lock, otherwise NULL.
+   */
+  const char *name;
+
+  /**
+   * @brief The lock statistics.
+   */
+  Lock_Stats Stats;
+} SMP_lock_Stats;
+
+/**
+ * @brief SMP lock statistics initializer for static initialization.
+ */
+#define SMP_LOCK_STATS_INITIALIZER \
+  { { NULL, NULL }, NULL, LOCK_STATS_INITIALIZER }
+
+/**
+ * @brief Visitor for _SMP_lock_Stats_iterate().
+ *
+ * @param[in] arg The visitor argument.
+ * @param[in] name The name of the lock.
+ * @param[in] stats The lock statistics.
+ */
+typedef void ( *SMP_lock_Stats_visitor )(
+  void             *arg,
+  const char       *name,
+  const Lock_Stats *stats
+);
+
+/**
+ * @brief Registers SMP lock statistics.
+ *
+ * @param[in,out] stats The SMP lock statistics.
+ * @param[in] name The name of the lock.  The string must persist until the
+ * lock is destroyed.
+ */
+void _SMP_lock_Stats_register( SMP_lock_Stats *stats, const char *name );
+
+/**
+ * @brief Unregisters SMP lock statistics.
+ *
+ * Unregistered SMP lock statistics are ignored.
+ *
+ * @param[in,out] stats The SMP lock statistics.
+ */
+void _SMP_lock_Stats_unregister( SMP_lock_Stats *stats );
+
+/**
+ * @brief Visits the statistics of all registered SMP locks.
+ *
+ * The visitor is invoked with interrupts disabled and the registry lock
+ * acquired.  It should only copy the statistics.
+ *
+ * @param[in] visitor The visitor.
+ * @param[in] arg The visitor argument.
+ */
+void _SMP_lock_Stats_iterate( SMP_lock_Stats_visitor visitor, void *arg );
+#endif
+
 /**
  * @brief SMP ticket lock control.
  */
 typedef struct {
   Atomic_Uint next_ticket;
   Atomic_Uint now_serving;
+#if defined( RTEMS_PROFILING )
+  SMP_lock_Stats Stats;
+#endif
 } SMP_ticket_lock_Control;
 
 /**
  * @brief SMP ticket lock control initializer for static initialization.
  */
-#define SMP_TICKET_LOCK_INITIALIZER \
-  { ATOMIC_INITIALIZER_UINT( 0U ), ATOMIC_INITIALIZER_UINT( 0U ) }
+#if defined( RTEMS_PROFILING )
+  #define SMP_TICKET_LOCK_INITIALIZER \
+    { \
+      ATOMIC_INITIALIZER_UINT( 0U ), \
+      ATOMIC_INITIALIZER_UINT( 0U ), \
+      SMP_LOCK_STATS_INITIALIZER \
+    }
+#else
+  #define SMP_TICKET_LOCK_INITIALIZER \
+    { ATOMIC_INITIALIZER_UINT( 0U ), ATOMIC_INITIALIZER_UINT( 0U ) }
+#endif
 
 /**
  * @brief Initializes an SMP ticket lock.
@@ -74,6 +172,10 @@ static inline void _SMP_ticket_lock_Initialize( SMP_ticket_lock_Control *lock )
 {
   _Atomic_Init_uint( &lock->next_ticket, 0U );
   _Atomic_Init_uint( &lock->now_serving, 0U );
+#if defined( RTEMS_PROFILING )
+  lock->Stats.name = NULL;
+  _Lock_Stats_Initialize( &lock->Stats.Stats );
+#endif
 }
 
 /**
@@ -85,7 +187,11 @@ static inline void _SMP_ticket_lock_Initialize( SMP_ticket_lock_Control *lock )
  */
 static inline void _SMP_ticket_lock_Destroy( SMP_ticket_lock_Control *lock )
 {
+#if defined( RTEMS_PROFILING )
+  _SMP_lock_Stats_unregister( &lock->Stats );
+#else
   (void) lock;
+#endif
 }
 
 /**
@@ -101,12 +207,32 @@ static inline void _SMP_ticket_lock_Acquire( SMP_ticket_lock_Control *lock )
 {
   unsigned int my_ticket =
     _Atomic_Fetch_add_uint( &lock->next_ticket, 1U, ATOMIC_ORDER_RELAXED );
-  unsigned int now_serving;
+  unsigned int now_serving =
+    _Atomic_Load_uint( &lock->now_serving, ATOMIC_ORDER_ACQUIRE );
+#if defined( RTEMS_PROFILING )
+  CPU_Counter_ticks acquire_instant;
+
+  if ( now_serving != my_ticket ) {
+    CPU_Counter_ticks wait_instant = _CPU_Counter_read();
 
-  do {
+    do {
+      now_serving =
+        _Atomic_Load_uint( &lock->now_serving, ATOMIC_ORDER_ACQUIRE );
+    } while ( now_serving != my_ticket );
+
+    acquire_instant = _CPU_Counter_read();
+    _Lock_Stats_Contended( &lock->Stats.Stats, wait_instant, acquire_instant );
+  } else {
+    acquire_instant = _CPU_Counter_read();
+  }
+
+  _Lock_Stats_Acquired( &lock->Stats.Stats, acquire_instant );
+#else
+  while ( now_serving != my_ticket ) {
     now_serving =
       _Atomic_Load_uint( &lock->now_serving, ATOMIC_ORDER_ACQUIRE );
-  } while ( now_serving != my_ticket );
+  }
+#endif
 }
 
 /**
@@ -120,14 +246,205 @@ static inline void _SMP_ticket_lock_Release( SMP_ticket_lock_Control *lock )
     _Atomic_Load_uint( &lock->now_serving, ATOMIC_ORDER_RELAXED );
   unsigned int next_ticket = current_ticket + 1U;
 
+#if defined( RTEMS_PROFILING )
+  _Lock_Stats_Released( &lock->Stats.Stats );
+#endif
+
   _Atomic_Store_uint( &lock->now_serving, next_ticket, ATOMIC_ORDER_RELEASE );
 }
 
+/**
+ * @brief SMP MCS lock context.
+ *
+ * The context is the queue node of a processor which owns or waits for the
+ * SMP MCS lock.  It must not move in memory between the acquire and the
+ * release of the lock.
+ */
+typedef struct SMP_MCS_lock_Context {
+  /**
+   * @brief The context of the next processor in the lock queue.
+   */
+  Atomic_Pointer next;
+
+  /**
+   * @brief Non-zero while the lock is owned by a previous processor in the
+   * lock queue.
+   */
+  Atomic_Uint locked;
+} SMP_MCS_lock_Context;
+
+/**
+ * @brief SMP MCS lock control.
+ */
+typedef struct {
+  /**
+   * @brief The context of the last processor in the lock queue or NULL in
+   * case the lock is not owned.
+   */
+  Atomic_Pointer queue;
+#if defined( RTEMS_PROFILING )
+  SMP_lock_Stats Stats;
+#endif
+} SMP_MCS_lock_Control;
+
+/**
+ * @brief SMP MCS lock control initializer for static initialization.
+ */
+#if defined( RTEMS_PROFILING )
+  #define SMP_MCS_LOCK_INITIALIZER \
+    { ATOMIC_INITIALIZER_PTR( NULL ), SMP_LOCK_STATS_INITIALIZER }
+#else
+  #define SMP_MCS_LOCK_INITIALIZER { ATOMIC_INITIALIZER_PTR( NULL ) }
+#endif
+
+/**
+ * @brief Initializes an SMP MCS lock.
+ *
+ * Concurrent initialization leads to unpredictable results.
+ *
+ * @param[in,out] lock The SMP MCS lock control.
+ */
+static inline void _SMP_MCS_lock_Initialize( SMP_MCS_lock_Control *lock )
+{
+  _Atomic_Init_ptr( &lock->queue, NULL );
+#if defined( RTEMS_PROFILING )
+  lock->Stats.name = NULL;
+  _Lock_Stats_Initialize( &lock->Stats.Stats );
+#endif
+}
+
+/**
+ * @brief Destroys an SMP MCS lock.
+ *
+ * Concurrent destruction leads to unpredictable results.
+ *
+ * @param[in,out] lock The SMP MCS lock control.
+ */
+static inline void _SMP_MCS_lock_Destroy( SMP_MCS_lock_Control *lock )
+{
+#if defined( RTEMS_PROFILING )
+  _SMP_lock_Stats_unregister( &lock->Stats );
+#else
+  (void) lock;
+#endif
+}
+
+/**
+ * @brief Acquires an SMP MCS lock.
+ *
+ * This function will not disable interrupts.  The caller must ensure that the
+ * current thread of execution is not interrupted indefinite once it obtained
+ * the SMP MCS lock.
+ *
+ * @param[in,out] lock The SMP MCS lock control.
+ * @param[in,out] context The SMP MCS lock context for an acquire and release
+ * pair.
+ */
+static inline void _SMP_MCS_lock_Acquire(
+  SMP_MCS_lock_Control *lock,
+  SMP_MCS_lock_Context *context
+)
+{
+  SMP_MCS_lock_Context *previous;
+#if defined( RTEMS_PROFILING )
+  CPU_Counter_ticks acquire_instant;
+#endif
+
+  _Atomic_Store_ptr( &context->next, NULL, ATOMIC_ORDER_RELAXED );
+  _Atomic_Store_uint( &context->locked, 1U, ATOMIC_ORDER_RELAXED );
+
+  previous = (SMP_MCS_lock_Context *)
+    _Atomic_Exchange_ptr( &lock->queue, context, ATOMIC_ORDER_SEQ_CST );
+
+#if defined( RTEMS_PROFILING )
+  if ( previous != NULL ) {
+    CPU_Counter_ticks wait_instant = _CPU_Counter_read();
+
+    _Atomic_Store_ptr( &previous->next, context, ATOMIC_ORDER_RELEASE );
+
+    while (
+      _Atomic_Load_uint( &context->locked, ATOMIC_ORDER_ACQUIRE ) != 0U
+    ) {
+      /* Wait */
+    }
+
+    acquire_instant = _CPU_Counter_read();
+    _Lock_Stats_Contended( &lock->Stats.Stats, wait_instant, acquire_instant );
+  } else {
+    acquire_instant = _CPU_Counter_read();
+  }
+
+  _Lock_Stats_Acquired( &lock->Stats.Stats, acquire_instant );
+#else
+  if ( previous != NULL ) {
+    _Atomic_Store_ptr( &previous->next, context, ATOMIC_ORDER_RELEASE );
+
+    while (
+      _Atomic_Load_uint( &context->locked, ATOMIC_ORDER_ACQUIRE ) != 0U
+    ) {
+      /* Wait */
+    }
+  }
+#endif
+}
+
+/**
+ * @brief Releases an SMP MCS lock.
+ *
+ * @param[in,out] lock The SMP MCS lock control.
+ * @param[in,out] context The SMP MCS lock context for an acquire and release
+ * pair.
+ */
+static inline void _SMP_MCS_lock_Release(
+  SMP_MCS_lock_Control *lock,
+  SMP_MCS_lock_Context *context
+)
+{
+  SMP_MCS_lock_Context *next;
+
+#if defined( RTEMS_PROFILING )
+  _Lock_Stats_Released( &lock->Stats.Stats );
+#endif
+
+  next = (SMP_MCS_lock_Context *)
+    _Atomic_Load_ptr( &context->next, ATOMIC_ORDER_ACQUIRE );
+
+  if ( next == NULL ) {
+    void *expected = context;
+
+    if (
+      _Atomic_Compare_exchange_ptr(
+        &lock->queue,
+        &expected,
+        NULL,
+        ATOMIC_ORDER_RELEASE,
+        ATOMIC_ORDER_RELAXED
+      )
+    ) {
+      return;
+    }
+
+    /*
+     * A new processor enqueued itself, so wait until it is linked.
+     */
+    do {
+      next = (SMP_MCS_lock_Context *)
+        _Atomic_Load_ptr( &context->next, ATOMIC_ORDER_ACQUIRE );
+    } while ( next == NULL );
+  }
+
+  _Atomic_Store_uint( &next->locked, 0U, ATOMIC_ORDER_RELEASE );
+}
+
 /**
  * @brief SMP lock control.
  */
 typedef struct {
+#if defined( RTEMS_SMP_MCS_LOCKS )
+  SMP_MCS_lock_Control mcs_lock;
+#else
   SMP_ticket_lock_Control ticket_lock;
+#endif
 } SMP_lock_Control;
 
 /**
@@ -135,12 +452,19 @@ typedef struct {
  */
 typedef struct {
   ISR_Level isr_level;
+#if defined( RTEMS_SMP_MCS_LOCKS )
+  SMP_MCS_lock_Context mcs_context;
+#endif
 } SMP_lock_Context;
 
 /**
  * @brief SMP lock control initializer for static initialization.
  */
-#define SMP_LOCK_INITIALIZER { SMP_TICKET_LOCK_INITIALIZER }
+#if defined( RTEMS_SMP_MCS_LOCKS )
+  #define SMP_LOCK_INITIALIZER { SMP_MCS_LOCK_INITIALIZER }
+#else
+  #define SMP_LOCK_INITIALIZER { SMP_TICKET_LOCK_INITIALIZER }
+#endif
 
 /**
  * @brief Initializes an SMP lock.
@@ -151,7 +475,11 @@ typedef struct {
  */
 static inline void _SMP_lock_Initialize( SMP_lock_Control *lock )
 {
+#if defined( RTEMS_SMP_MCS_LOCKS )
+  _SMP_MCS_lock_Initialize( &lock->mcs_lock );
+#else
   _SMP_ticket_lock_Initialize( &lock->ticket_lock );
+#endif
 }
 
 /**
@@ -163,7 +491,11 @@ static inline void _SMP_lock_Initialize( SMP_lock_Control *lock )
  */
 static inline void _SMP_lock_Destroy( SMP_lock_Control *lock )
 {
+#if defined( RTEMS_SMP_MCS_LOCKS )
+  _SMP_MCS_lock_Destroy( &lock->mcs_lock );
+#else
   _SMP_ticket_lock_Destroy( &lock->ticket_lock );
+#endif
 }
 
 /**
@@ -182,8 +514,12 @@ static inline void _SMP_lock_Acquire(
   SMP_lock_Context *context
 )
 {
+#if defined( RTEMS_SMP_MCS_LOCKS )
+  _SMP_MCS_lock_Acquire( &lock->mcs_lock, &context->mcs_context );
+#else
   (void) context;
   _SMP_ticket_lock_Acquire( &lock->ticket_lock );
+#endif
 }
 
 /**
@@ -198,9 +534,31 @@ static inline void _SMP_lock_Release(
   SMP_lock_Context *context
 )
 {
+#if defined( RTEMS_SMP_MCS_LOCKS )
+  _SMP_MCS_lock_Release( &lock->mcs_lock, &context->mcs_context );
+#else
   (void) context;
   _SMP_ticket_lock_Release( &lock->ticket_lock );
+#endif
+}
+
+#if defined( RTEMS_PROFILING )
+/**
+ * @brief Returns the statistics of an SMP lock.
+ *
+ * @param[in] lock The SMP lock control.
+ *
+ * @return The SMP lock statistics, e.g. for _SMP_lock_Stats_register().
+ */
+static inline SMP_lock_Stats *_SMP_lock_Get_stats( SMP_lock_Control *lock )
+{
+#if defined( RTEMS_SMP_MCS_LOCKS )
+  return &lock->mcs_lock.Stats;
+#else
+  return &lock->ticket_lock.Stats;
+#endif
 }
+#endif
 
 /**
  * @brief Disables interrupts and acquires the SMP lock.
@@ -286,6 +286,10 @@ typedef struct {
   Chain_Control         Block2n;
   /** This field points to the thread queue on which this thread is blocked. */
   Thread_queue_Control *queue;
+#if defined(RTEMS_PROFILING)
+  /** This field is the CPU counter value at the begin of a lock wait. */
+  CPU_Counter_ticks     lock_wait_instant;
+#endif
 }   Thread_Wait_information;
 
 /**
@@ -15,6 +15,7 @@
 #define _RTEMS_SCORE_THREADDISPATCH_H
 
 #include <rtems/score/percpu.h>
+#include <rtems/score/profiling.h>
 #include <rtems/score/smplock.h>
 
 #ifdef __cplusplus
@@ -119,6 +120,15 @@ RTEMS_INLINE_ROUTINE void _Thread_Dispatch_initialization( void )
    */
   void _Giant_Drop( Per_CPU_Control *self_cpu );
 
+#if defined( RTEMS_PROFILING )
+  /**
+   * @brief Registers the giant lock statistics.
+   *
+   * @see _SMP_lock_Stats_register().
+   */
+  void _Giant_Register_stats( void );
+#endif
+
   /**
    *  @brief Increments the thread dispatch level.
    *
@@ -140,11 +150,23 @@ RTEMS_INLINE_ROUTINE void _Thread_Dispatch_initialization( void )
    */
   RTEMS_INLINE_ROUTINE uint32_t _Thread_Dispatch_increment_disable_level(void)
   {
-    uint32_t level = _Thread_Dispatch_disable_level;
+    uint32_t level;
 
+#if defined( RTEMS_PROFILING )
+    ISR_Level isr_level;
+
+    _ISR_Disable( isr_level );
+#endif
+
+    level = _Thread_Dispatch_disable_level;
     ++level;
     _Thread_Dispatch_disable_level = level;
 
+#if defined( RTEMS_PROFILING )
+    _Profiling_Thread_dispatch_disable( _Per_CPU_Get(), level - 1 );
+    _ISR_Enable( isr_level );
+#endif
+
     return level;
   }
 
@@ -155,11 +177,27 @@ RTEMS_INLINE_ROUTINE void _Thread_Dispatch_initialization( void )
    */
   RTEMS_INLINE_ROUTINE uint32_t _Thread_Dispatch_decrement_disable_level(void)
   {
-    uint32_t level = _Thread_Dispatch_disable_level;
+    uint32_t level;
+
+#if defined( RTEMS_PROFILING )
+    ISR_Level isr_level;
 
+    _ISR_Disable( isr_level );
+#endif
+
+    level = _Thread_Dispatch_disable_level;
     --level;
+
+#if defined( RTEMS_PROFILING )
+    _Profiling_Thread_dispatch_enable( _Per_CPU_Get(), level );
+#endif
+
     _Thread_Dispatch_disable_level = level;
 
+#if defined( RTEMS_PROFILING )
+    _ISR_Enable( isr_level );
+#endif
+
     return level;
   }
 #endif /* RTEMS_SMP */
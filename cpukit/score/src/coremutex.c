@@ -39,11 +39,13 @@ CORE_mutex_Status _CORE_mutex_Initialize(
   the_mutex->Attributes    = *the_mutex_attributes;
   the_mutex->lock          = initial_lock;
   the_mutex->blocked_count = 0;
+  _CORE_mutex_Stats_initialize( the_mutex );
 
   if ( initial_lock == CORE_MUTEX_LOCKED ) {
     the_mutex->nest_count = 1;
     the_mutex->holder     = executing;
     the_mutex->holder_id  = executing->Object.id;
+    _CORE_mutex_Stats_acquired( the_mutex );
     if ( _CORE_mutex_Is_inherit_priority( &the_mutex->Attributes ) ||
          _CORE_mutex_Is_priority_ceiling( &the_mutex->Attributes ) ) {
 
@@ -65,6 +65,7 @@ void _CORE_mutex_Seize_interrupt_blocking(
   }
 
   the_mutex->blocked_count++;
+  _CORE_mutex_Stats_wait( executing );
   _Thread_queue_Enqueue( &the_mutex->Wait_queue, executing, timeout );
 
   _Thread_Enable_dispatch();
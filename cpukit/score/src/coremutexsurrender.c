@@ -172,6 +172,7 @@ CORE_mutex_Status _CORE_mutex_Surrender(
       _Thread_Change_priority( holder, holder->real_priority, true );
     }
   }
+  _CORE_mutex_Stats_released( the_mutex );
   the_mutex->holder    = NULL;
   the_mutex->holder_id = 0;
 
@@ -197,6 +198,7 @@ CORE_mutex_Status _CORE_mutex_Surrender(
       the_mutex->holder     = the_thread;
       the_mutex->holder_id  = the_thread->Object.id;
       the_mutex->nest_count = 1;
+      _CORE_mutex_Stats_handover( the_mutex, the_thread );
 
       switch ( the_mutex->Attributes.discipline ) {
         case CORE_MUTEX_DISCIPLINES_FIFO:
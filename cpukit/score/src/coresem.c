@@ -30,6 +30,7 @@ void _CORE_semaphore_Initialize(
 
   the_semaphore->Attributes = *the_semaphore_attributes;
   the_semaphore->count      = initial_value;
+  _CORE_semaphore_Stats_initialize( the_semaphore );
 
   _Thread_queue_Initialize(
     &the_semaphore->Wait_queue,
@@ -40,6 +40,7 @@ void _CORE_semaphore_Seize(
   _ISR_Disable( level );
   if ( the_semaphore->count != 0 ) {
     the_semaphore->count -= 1;
+    _CORE_semaphore_Stats_acquired( the_semaphore );
     _ISR_Enable( level );
     return;
   }
@@ -62,6 +63,7 @@ void _CORE_semaphore_Seize(
   _Thread_queue_Enter_critical_section( &the_semaphore->Wait_queue );
   executing->Wait.queue = &the_semaphore->Wait_queue;
   executing->Wait.id    = id;
+  _CORE_semaphore_Stats_wait( executing );
   _ISR_Enable( level );
   _Thread_queue_Enqueue( &the_semaphore->Wait_queue, executing, timeout );
 }
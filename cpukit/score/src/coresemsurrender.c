@@ -39,7 +39,9 @@ CORE_semaphore_Status _CORE_semaphore_Surrender(
 #if defined(RTEMS_MULTIPROCESSING)
     if ( !_Objects_Is_local_id( the_thread->Object.id ) )
       (*api_semaphore_mp_support) ( the_thread, id );
+    else
 #endif
+      _CORE_semaphore_Stats_handover( the_semaphore, the_thread );
 
   } else {
     _ISR_Disable( level );
@@ -0,0 +1,185 @@
+/**
+ * @file
+ *
+ * @ingroup ScoreLockStats
+ *
+ * @brief Lock Statistics of Objects
+ */
+
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/score/lockstatsimpl.h>
+#include <rtems/score/chainimpl.h>
+#include <rtems/score/isrlevel.h>
+#include <rtems/score/threaddispatch.h>
+
+#if defined( RTEMS_PROFILING )
+
+/*
+ * The registry is filled during system initialization and is read-only
+ * afterwards.
+ */
+static Chain_Control _Lock_Stats_Objects_registry =
+  CHAIN_INITIALIZER_EMPTY( _Lock_Stats_Objects_registry );
+
+void _Lock_Stats_Register_objects( Lock_Stats_Objects *objects )
+{
+  _Chain_Append_unprotected( &_Lock_Stats_Objects_registry, &objects->Node );
+}
+
+static const Lock_Stats_Objects *_Lock_Stats_Find_objects(
+  const Objects_Information *information
+)
+{
+  const Chain_Node *node = _Chain_Immutable_first(
+    &_Lock_Stats_Objects_registry
+  );
+  const Chain_Node *tail = _Chain_Immutable_tail(
+    &_Lock_Stats_Objects_registry
+  );
+
+  while ( node != tail ) {
+    const Lock_Stats_Objects *objects = (const Lock_Stats_Objects *) node;
+
+    if ( objects->information == information ) {
+      return objects;
+    }
+
+    node = _Chain_Immutable_next( node );
+  }
+
+  return NULL;
+}
+
+/*
+ * Semaphores may be obtained and released in interrupt context, so copy the
+ * statistics with interrupts disabled.
+ */
+static void _Lock_Stats_Copy( Lock_Stats *copy, const Lock_Stats *stats )
+{
+  ISR_Level level;
+
+  _ISR_Disable( level );
+  *copy = *stats;
+  _ISR_Enable( level );
+}
+
+Objects_Locations _Lock_Stats_Get_object_stats(
+  Objects_Id  id,
+  Lock_Stats *stats
+)
+{
+  Objects_Information      *information;
+  const Lock_Stats_Objects *objects;
+  Objects_Control          *object;
+  Objects_Locations         location;
+  const Lock_Stats         *object_stats;
+
+  information = _Objects_Get_information_id( id );
+  if ( information == NULL ) {
+    return OBJECTS_ERROR;
+  }
+
+  objects = _Lock_Stats_Find_objects( information );
+  if ( objects == NULL ) {
+    return OBJECTS_ERROR;
+  }
+
+  object = _Objects_Get( information, id, &location );
+  switch ( location ) {
+
+    case OBJECTS_LOCAL:
+      object_stats = ( *objects->get )( object );
+      if ( object_stats != NULL ) {
+        _Lock_Stats_Copy( stats, object_stats );
+      } else {
+        location = OBJECTS_ERROR;
+      }
+      _Objects_Put( object );
+      break;
+
+#if defined( RTEMS_MULTIPROCESSING )
+    case OBJECTS_REMOTE:
+      _Thread_Dispatch();
+      break;
+#endif
+
+    case OBJECTS_ERROR:
+      break;
+  }
+
+  return location;
+}
+
+size_t _Lock_Stats_Get_objects_maximum( void )
+{
+  size_t            maximum = 0;
+  const Chain_Node *node;
+  const Chain_Node *tail;
+
+  _Thread_Disable_dispatch();
+
+  node = _Chain_Immutable_first( &_Lock_Stats_Objects_registry );
+  tail = _Chain_Immutable_tail( &_Lock_Stats_Objects_registry );
+
+  while ( node != tail ) {
+    const Lock_Stats_Objects *objects = (const Lock_Stats_Objects *) node;
+
+    maximum += objects->information->maximum;
+
+    node = _Chain_Immutable_next( node );
+  }
+
+  _Thread_Enable_dispatch();
+
+  return maximum;
+}
+
+void _Lock_Stats_Iterate_objects(
+  Lock_Stats_Object_visitor  visitor,
+  void                      *arg
+)
+{
+  const Chain_Node *node;
+  const Chain_Node *tail;
+
+  _Thread_Disable_dispatch();
+
+  node = _Chain_Immutable_first( &_Lock_Stats_Objects_registry );
+  tail = _Chain_Immutable_tail( &_Lock_Stats_Objects_registry );
+
+  while ( node != tail ) {
+    const Lock_Stats_Objects *objects = (const Lock_Stats_Objects *) node;
+    const Objects_Information *information = objects->information;
+    uint32_t index;
+
+    for ( index = 1; index <= information->maximum; ++index ) {
+      Objects_Control *object = information->local_table[ index ];
+
+      if ( object != NULL ) {
+        const Lock_Stats *object_stats = ( *objects->get )( object );
+
+        if ( object_stats != NULL ) {
+          Lock_Stats copy;
+
+          _Lock_Stats_Copy( &copy, object_stats );
+          ( *visitor )( arg, object->id, &copy );
+        }
+      }
+    }
+
+    node = _Chain_Immutable_next( node );
+  }
+
+  _Thread_Enable_dispatch();
+}
+
+#endif /* defined( RTEMS_PROFILING ) */
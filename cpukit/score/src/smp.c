@@ -33,8 +33,15 @@ void _SMP_Handler_initialize( void )
     Per_CPU_Control *per_cpu = _Per_CPU_Get_by_index( cpu );
 
     _SMP_ticket_lock_Initialize( &per_cpu->Lock );
+#if defined( RTEMS_PROFILING )
+    _SMP_lock_Stats_register( &per_cpu->Lock.Stats, "Per-CPU" );
+#endif
   }
 
+#if defined( RTEMS_PROFILING )
+  _Giant_Register_stats();
+#endif
+
   /*
    * Discover and initialize the secondary cores in an SMP system.
    */
@@ -0,0 +1,90 @@
+/**
+ * @file
+ *
+ * @ingroup ScoreSMPLock
+ *
+ * @brief SMP Lock Statistics Registry
+ */
+
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/score/smplock.h>
+#include <rtems/score/chainimpl.h>
+
+#if defined( RTEMS_PROFILING )
+
+/*
+ * The statistics of the registry lock itself are not registered.
+ */
+static SMP_ticket_lock_Control _SMP_lock_Stats_registry_lock =
+  SMP_TICKET_LOCK_INITIALIZER;
+
+static Chain_Control _SMP_lock_Stats_registry =
+  CHAIN_INITIALIZER_EMPTY( _SMP_lock_Stats_registry );
+
+void _SMP_lock_Stats_register( SMP_lock_Stats *stats, const char *name )
+{
+  ISR_Level level;
+
+  _ISR_Disable_without_giant( level );
+  _SMP_ticket_lock_Acquire( &_SMP_lock_Stats_registry_lock );
+
+  if ( stats->name == NULL ) {
+    _Chain_Append_unprotected( &_SMP_lock_Stats_registry, &stats->Node );
+  }
+
+  stats->name = name;
+
+  _SMP_ticket_lock_Release( &_SMP_lock_Stats_registry_lock );
+  _ISR_Enable_without_giant( level );
+}
+
+void _SMP_lock_Stats_unregister( SMP_lock_Stats *stats )
+{
+  ISR_Level level;
+
+  _ISR_Disable_without_giant( level );
+  _SMP_ticket_lock_Acquire( &_SMP_lock_Stats_registry_lock );
+
+  if ( stats->name != NULL ) {
+    _Chain_Extract_unprotected( &stats->Node );
+    stats->name = NULL;
+  }
+
+  _SMP_ticket_lock_Release( &_SMP_lock_Stats_registry_lock );
+  _ISR_Enable_without_giant( level );
+}
+
+void _SMP_lock_Stats_iterate( SMP_lock_Stats_visitor visitor, void *arg )
+{
+  ISR_Level         level;
+  const Chain_Node *node;
+  const Chain_Node *tail;
+
+  _ISR_Disable_without_giant( level );
+  _SMP_ticket_lock_Acquire( &_SMP_lock_Stats_registry_lock );
+
+  node = _Chain_Immutable_first( &_SMP_lock_Stats_registry );
+  tail = _Chain_Immutable_tail( &_SMP_lock_Stats_registry );
+
+  while ( node != tail ) {
+    const SMP_lock_Stats *stats = (const SMP_lock_Stats *) node;
+
+    ( *visitor )( arg, stats->name, &stats->Stats );
+
+    node = _Chain_Immutable_next( node );
+  }
+
+  _SMP_ticket_lock_Release( &_SMP_lock_Stats_registry_lock );
+  _ISR_Enable_without_giant( level );
+}
+
+#endif /* defined( RTEMS_PROFILING ) */
@@ -22,6 +22,7 @@
 #include <rtems/score/apiext.h>
 #include <rtems/score/assert.h>
 #include <rtems/score/isr.h>
+#include <rtems/score/profiling.h>
 #include <rtems/score/threadimpl.h>
 #include <rtems/score/todimpl.h>
 #include <rtems/score/userextimpl.h>
@@ -41,6 +42,8 @@ void _Thread_Dispatch( void )
   per_cpu = _Per_CPU_Get();
   _Assert( per_cpu->thread_dispatch_disable_level == 0 );
   per_cpu->thread_dispatch_disable_level = 1;
+  _Profiling_Thread_dispatch_disable( per_cpu, 0 );
+  _Profiling_Thread_dispatch_begin( per_cpu );
 
 #if defined( RTEMS_SMP )
   _ISR_Enable_without_giant( level );
@@ -168,7 +171,9 @@ void _Thread_Dispatch( void )
   }
 
 post_switch:
+  _Profiling_Thread_dispatch_end( per_cpu );
   _Assert( per_cpu->thread_dispatch_disable_level == 1 );
+  _Profiling_Thread_dispatch_enable( per_cpu, 0 );
   per_cpu->thread_dispatch_disable_level = 0;
 
   _Per_CPU_Release_and_ISR_enable( per_cpu, level );
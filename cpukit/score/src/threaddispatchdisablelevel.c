@@ -17,6 +17,7 @@
 
 #include <rtems/score/threaddispatch.h>
 #include <rtems/score/assert.h>
+#include <rtems/score/profiling.h>
 #include <rtems/score/sysstate.h>
 
 #define NO_OWNER_CPU 0xffffffffU
@@ -72,6 +73,13 @@ void _Giant_Drop( Per_CPU_Control *self_cpu )
   }
 }
 
+#if defined( RTEMS_PROFILING )
+void _Giant_Register_stats( void )
+{
+  _SMP_lock_Stats_register( _SMP_lock_Get_stats( &_Giant.lock ), "Giant" );
+}
+#endif
+
 uint32_t _Thread_Dispatch_increment_disable_level( void )
 {
   ISR_Level isr_level;
@@ -89,6 +97,7 @@ uint32_t _Thread_Dispatch_increment_disable_level( void )
   _Giant_Do_acquire( self_cpu );
 
   disable_level = self_cpu->thread_dispatch_disable_level;
+  _Profiling_Thread_dispatch_disable( self_cpu, disable_level );
   ++disable_level;
   self_cpu->thread_dispatch_disable_level = disable_level;
 
@@ -108,6 +117,7 @@ uint32_t _Thread_Dispatch_decrement_disable_level( void )
   self_cpu = _Per_CPU_Get();
   disable_level = self_cpu->thread_dispatch_disable_level;
   --disable_level;
+  _Profiling_Thread_dispatch_enable( self_cpu, disable_level );
   self_cpu->thread_dispatch_disable_level = disable_level;
 
   _Giant_Do_release( self_cpu );
@@ -286,6 +286,15 @@ to forward the packet to the network stack.   The arguments to @code{ether_input
 are a pointer to the interface data structure, a pointer to the ethernet
 header and a pointer to an mbuf containing the packet itself.
 
+A receive task which finds several packets per wake-up may instead link
+them by @code{m_nextpkt}, with the ethernet header left at the start of
+each packet and @code{m_pkthdr.rcvif} set, and pass the list to
+@code{ether_input_batch}.  The network daemon is then woken up once for
+the whole batch.  The function @code{rtems_bsdnet_defer_input} accepts
+the same list without the network semaphore being held, also from an
+interrupt handler.  The packets are queued on the current processor and
+passed to the protocols by the network daemon.
+
 
 
 
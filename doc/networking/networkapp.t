@@ -101,6 +101,8 @@ struct rtems_bsdnet_config @{
   unsigned long        tcp_tx_buf_size;
   /* TCP TX: 16 * 1024 bytes */
   unsigned long        tcp_rx_buf_size;
+  /* Default is 0, no limit */
+  unsigned long        network_input_budget;
 @};
 @end group
 @end example
@@ -229,6 +231,13 @@ This configuration parameter specifies the maximum amount of
 buffer memory which may be used for TCP sockets to receive
 into.  The default size is sixteen kilobytes.
 
+@item unsigned long network_input_budget
+This configuration parameter limits the number of received IP packets
+which the network daemon processes per wake-up.  Remaining packets are
+processed after the expired timeouts and after other network tasks had a
+chance to obtain the network semaphore.  The default value of zero
+means no limit.
+
 @end table
 
 In addition, the following fields in the @code{rtems_bsdnet_ifconfig}
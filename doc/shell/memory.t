@@ -530,7 +530,7 @@ extern rtems_shell_cmd_t rtems_shell_MMOVE_Command;
 @subheading SYNOPSYS:
 
 @example
-malloc [info|stats]
+malloc [info|stats|profile|mark|diff]
 @end example
 
 @subheading DESCRIPTION:
@@ -570,6 +570,13 @@ available includes the following information:
 @item Number of calls to @code{calloc}
 @end itemize
 
+When the subcommand @code{profile} is specified, the allocation sites
+of the Malloc Family Profiling are reported sorted by live bytes and
+by call rate.  The subcommand @code{mark} takes a snapshot of the
+allocation sites.  The subcommand @code{diff} reports the changes of
+the allocation sites since the last @code{mark}.  A site whose live
+bytes grow over several @code{diff} reports likely leaks memory.
+
 @subheading EXIT STATUS:
 
 This command returns 0 on success and non-zero if an error is encountered.
@@ -582,6 +589,12 @@ The @code{CONFIGURE_MALLOC_STATISTICS} @code{confdefs.h} constant
 must be defined when the application is configured for the full
 set of statistics information to be available.
 
+@findex CONFIGURE_MALLOC_PROFILING
+
+The @code{CONFIGURE_MALLOC_PROFILING} @code{confdefs.h} constant
+must be defined for the @code{profile}, @code{mark} and @code{diff}
+subcommands.
+
 @subheading EXAMPLES:
 
 The following is an example of how to use the @code{malloc} command.
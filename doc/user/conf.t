@@ -2399,6 +2399,104 @@ of routines.
 @subheading NOTES:
 None.
 
+@c
+@c === CONFIGURE_MALLOC_PROFILING ===
+@c
+@subsection Enable Malloc Family Profiling
+
+@findex CONFIGURE_MALLOC_PROFILING
+
+
+@table @b
+@item CONSTANT:
+@code{CONFIGURE_MALLOC_PROFILING}
+
+@item DATA TYPE:
+Boolean feature macro.
+
+@item RANGE:
+Defined or undefined.
+
+@item DEFAULT VALUE:
+This is not defined by default, and Malloc Profiling is disabled.
+
+@end table
+
+@subheading DESCRIPTION:
+This configuration parameter is defined when the application wishes to
+account the live allocations of the C Malloc Family of routines to the
+caller addresses of the allocation sites.  The
+@code{rtems_malloc_profiling_report()} routine lists the top allocation
+sites by live bytes and by call rate.  The
+@code{rtems_malloc_profiling_report_diff()} routine compares two
+snapshots taken with @code{rtems_malloc_profiling_take_snapshot()}.
+
+@subheading NOTES:
+The allocation and site tables are statically allocated.  Their sizes
+are defined by @code{CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS}
+and @code{CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES}.
+
+@c
+@c === CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS ===
+@c
+@subsection Specify Maximum Number of Profiled Allocations
+
+@findex CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS
+
+
+@table @b
+@item CONSTANT:
+@code{CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS}
+
+@item DATA TYPE:
+Unsigned integer (@code{uint32_t}).
+
+@item RANGE:
+Positive.
+
+@item DEFAULT VALUE:
+The default value is 1024.
+
+@end table
+
+@subheading DESCRIPTION:
+This configuration parameter is set to the maximum number of live
+allocations tracked by the Malloc Profiling.
+
+@subheading NOTES:
+Allocations which do not fit into the table are counted as untracked.
+
+@c
+@c === CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES ===
+@c
+@subsection Specify Maximum Number of Profiled Allocation Sites
+
+@findex CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES
+
+
+@table @b
+@item CONSTANT:
+@code{CONFIGURE_MALLOC_PROFILING_MAXIMUM_SITES}
+
+@item DATA TYPE:
+Unsigned integer (@code{uint32_t}).
+
+@item RANGE:
+1 to 65536.
+
+@item DEFAULT VALUE:
+The default value is 64.
+
+@end table
+
+@subheading DESCRIPTION:
+This configuration parameter is set to the maximum number of allocation
+sites of the Malloc Profiling.
+
+@subheading NOTES:
+One site is reserved for the allocations of sites which do not fit into
+the table.  This site is reported with a caller address of zero.
+
 @c
 @c === CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS ===
 @c
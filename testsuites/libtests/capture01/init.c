@@ -0,0 +1,333 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <rtems/capture.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define ROUNDS 500
+
+#define RECORDS 4096
+
+#define USER_EVENTS 16
+
+#define USER_ID 0x12345678
+
+#define WORKER_NAME rtems_build_name('W', 'O', 'R', 'K')
+
+typedef struct {
+  rtems_id master;
+  rtems_id worker;
+} test_context;
+
+typedef struct {
+  uint32_t index;
+  uint32_t magic;
+} user_args;
+
+static test_context test_instance;
+
+static void worker(rtems_task_argument arg)
+{
+  test_context *ctx = (test_context *) arg;
+
+  while (true) {
+    rtems_status_code sc;
+
+    sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_event_transient_send(ctx->master);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void ping_pong(test_context *ctx)
+{
+  int i;
+
+  for (i = 0; i < ROUNDS; ++i) {
+    rtems_status_code sc;
+
+    sc = rtems_event_transient_send(ctx->worker);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void test_switches(test_context *ctx)
+{
+  rtems_status_code sc;
+
+  sc = rtems_capture_control(false);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  ping_pong(ctx);
+
+  sc = rtems_capture_control(true);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  ping_pong(ctx);
+}
+
+static void test_user_events(void)
+{
+  rtems_status_code sc;
+  uint32_t i;
+
+  for (i = 0; i < USER_EVENTS; ++i) {
+    user_args args = { .index = i, .magic = ~i };
+
+    sc = rtems_capture_user_event(USER_ID, &args, sizeof(args));
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  sc = rtems_capture_user_event(USER_ID, NULL, 1024 * 1024);
+  rtems_test_assert(sc == RTEMS_INVALID_SIZE);
+}
+
+static void test_read(void)
+{
+  rtems_capture_time_t last = 0;
+  uint32_t switched_in = 0;
+  uint32_t switched_out = 0;
+  uint32_t user_events = 0;
+
+  while (true) {
+    rtems_status_code sc;
+    rtems_capture_record_t *rec;
+
+    sc = rtems_capture_read(0, 0, &rec);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    if (rec == NULL) {
+      sc = rtems_capture_release(NULL);
+      rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+      break;
+    }
+
+    rtems_test_assert(rec->time >= last);
+    last = rec->time;
+
+    if ((rec->events & RTEMS_CAPTURE_SWITCHED_IN_EVENT) != 0) {
+      rtems_test_assert(rtems_capture_record_payload_size(rec) == 0);
+      ++switched_in;
+    }
+
+    if ((rec->events & RTEMS_CAPTURE_SWITCHED_OUT_EVENT) != 0) {
+      rtems_test_assert(rtems_capture_record_payload_size(rec) == 0);
+      ++switched_out;
+    }
+
+    if ((rec->events & RTEMS_CAPTURE_USER_EVENT) != 0) {
+      const rtems_capture_user_record_t *user;
+      const user_args *args;
+
+      rtems_test_assert(
+        rtems_capture_record_payload_size(rec)
+          == sizeof(*user) + sizeof(*args)
+      );
+
+      user = rtems_capture_record_payload(rec);
+      args = (const user_args *) (user + 1);
+      rtems_test_assert(user->id == USER_ID);
+      rtems_test_assert(args->index == user_events);
+      rtems_test_assert(args->magic == ~user_events);
+      rtems_test_assert(rec->task != NULL);
+      rtems_test_assert(rec->task->id == rtems_task_self());
+      ++user_events;
+    }
+
+    sc = rtems_capture_release(rec);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  rtems_test_assert(switched_in >= 2 * ROUNDS);
+  rtems_test_assert(switched_out >= 2 * ROUNDS);
+  rtems_test_assert(user_events == USER_EVENTS);
+}
+
+static rtems_timer_service_routine user_event_from_isr(
+  rtems_id timer,
+  void *arg
+)
+{
+  user_args args = { .index = 0, .magic = 0 };
+  rtems_status_code sc;
+
+  sc = rtems_capture_user_event(USER_ID, &args, sizeof(args));
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void read_all(void)
+{
+  rtems_capture_record_t *rec;
+  rtems_status_code sc;
+
+  do {
+    sc = rtems_capture_read(0, 0, &rec);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_capture_release(rec);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  } while (rec != NULL);
+}
+
+static void test_blocking_read(void)
+{
+  rtems_capture_record_t *rec;
+  rtems_status_code sc;
+  rtems_interval start;
+  rtems_interval elapsed;
+  rtems_id timer;
+
+  /* A timeout below one clock tick waits one clock tick */
+  start = rtems_clock_get_ticks_since_boot();
+  sc = rtems_capture_read(1, 1, &rec);
+  elapsed = rtems_clock_get_ticks_since_boot() - start;
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(rec == NULL);
+  rtems_test_assert(elapsed >= 1);
+
+  sc = rtems_capture_release(rec);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_control(true);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  /* The reader wakes up when the record is written and not at the timeout */
+  sc = rtems_timer_create(rtems_build_name('U', 'S', 'E', 'R'), &timer);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_timer_fire_after(timer, 2, user_event_from_isr, NULL);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  start = rtems_clock_get_ticks_since_boot();
+  sc = rtems_capture_read(1, 10 * 1000 * 1000, &rec);
+  elapsed = rtems_clock_get_ticks_since_boot() - start;
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(rec != NULL);
+  rtems_test_assert(elapsed < RTEMS_MICROSECONDS_TO_TICKS(10 * 1000 * 1000));
+
+  sc = rtems_capture_release(rec);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_control(false);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  read_all();
+
+  /* The switch records do not wake the reader, it finds them by polling */
+  sc = rtems_capture_control(true);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_read(1, 0, &rec);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(rec != NULL);
+  rtems_test_assert(
+    (rec->events
+      & (RTEMS_CAPTURE_SWITCHED_IN_EVENT | RTEMS_CAPTURE_SWITCHED_OUT_EVENT))
+      != 0
+  );
+
+  sc = rtems_capture_release(rec);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_control(false);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  read_all();
+
+  sc = rtems_timer_delete(timer);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  rtems_status_code sc;
+
+  ctx->master = rtems_task_self();
+
+  sc = rtems_task_create(
+    WORKER_NAME,
+    1,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &ctx->worker
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(ctx->worker, worker, (rtems_task_argument) ctx);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_open(RECORDS, NULL);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_watch_global(true);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_set_trigger(
+    0,
+    0,
+    WORKER_NAME,
+    0,
+    rtems_capture_from_any,
+    rtems_capture_switch
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  test_switches(ctx);
+  test_user_events();
+
+  sc = rtems_capture_control(false);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  test_read();
+  test_blocking_read();
+
+  sc = rtems_task_delete(ctx->worker);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_close();
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST CAPTURE 1 ***");
+  test();
+  puts("*** END OF TEST CAPTURE 1 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+
+#define CONFIGURE_MAXIMUM_TIMERS 1
+
+#define CONFIGURE_MAXIMUM_USER_EXTENSIONS 1
+
+#define CONFIGURE_MEMORY_OVERHEAD 4
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,257 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/capture-trace.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define ROUNDS 50
+
+#define RECORDS 1024
+
+#define USER_EVENTS 8
+
+#define USER_ID 0xcafe
+
+#define PRIO_DRAIN 10
+
+#define WORKER_NAME rtems_build_name('W', 'O', 'R', 'K')
+
+typedef struct {
+  rtems_id master;
+  rtems_id worker;
+  uint32_t records;
+  uint32_t user_events;
+} test_context;
+
+static test_context test_instance;
+
+static const char trace[] = "/trace";
+
+static void worker(rtems_task_argument arg)
+{
+  test_context *ctx = (test_context *) arg;
+
+  while (true) {
+    rtems_status_code sc;
+
+    sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_event_transient_send(ctx->master);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void ping_pong(test_context *ctx)
+{
+  int i;
+
+  for (i = 0; i < ROUNDS; ++i) {
+    rtems_status_code sc;
+
+    sc = rtems_event_transient_send(ctx->worker);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void user_events(void)
+{
+  uint32_t i;
+
+  for (i = 0; i < USER_EVENTS; ++i) {
+    rtems_status_code sc;
+
+    sc = rtems_capture_user_event(USER_ID, &i, sizeof(i));
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void verify(test_context *ctx, int fd)
+{
+  rtems_capture_trace_header_t header;
+  uint32_t switches = 0;
+  uint32_t records = 0;
+  uint32_t users = 0;
+  uint64_t last = 0;
+  ssize_t n;
+  off_t off;
+
+  off = lseek(fd, 0, SEEK_SET);
+  rtems_test_assert(off == 0);
+
+  n = read(fd, &header, sizeof(header));
+  rtems_test_assert(n == (ssize_t) sizeof(header));
+  rtems_test_assert(header.magic == RTEMS_CAPTURE_TRACE_MAGIC);
+  rtems_test_assert(header.version == RTEMS_CAPTURE_TRACE_VERSION);
+  rtems_test_assert(header.header_size == sizeof(header));
+  rtems_test_assert(header.record_size == sizeof(rtems_capture_trace_record_t));
+
+  while (true) {
+    rtems_capture_trace_record_t rec;
+    uint32_t payload[2];
+
+    n = read(fd, &rec, sizeof(rec));
+    if (n == 0) {
+      break;
+    }
+
+    rtems_test_assert(n == (ssize_t) sizeof(rec));
+    rtems_test_assert(rec.size >= sizeof(rec));
+    rtems_test_assert(rec.size - sizeof(rec) <= sizeof(payload));
+    rtems_test_assert(rec.time >= last);
+    last = rec.time;
+
+    if (rec.size > sizeof(rec)) {
+      n = read(fd, &payload[0], rec.size - sizeof(rec));
+      rtems_test_assert(n == (ssize_t) (rec.size - sizeof(rec)));
+    }
+
+    if ((rec.events & RTEMS_CAPTURE_SWITCHED_IN_EVENT) != 0) {
+      rtems_test_assert(rec.size == sizeof(rec));
+      rtems_test_assert(rec.id != 0);
+      ++switches;
+    }
+
+    if ((rec.events & RTEMS_CAPTURE_USER_EVENT) != 0) {
+      rtems_test_assert(rec.size == sizeof(rec) + sizeof(payload));
+      rtems_test_assert(rec.id == ctx->master);
+      rtems_test_assert(rec.name == rtems_build_name('U', 'I', '1', ' '));
+      rtems_test_assert(payload[0] == USER_ID);
+      rtems_test_assert(payload[1] == users % USER_EVENTS);
+      ++users;
+    }
+
+    ++records;
+  }
+
+  rtems_test_assert(records == ctx->records);
+  rtems_test_assert(users == 2 * USER_EVENTS);
+  rtems_test_assert(switches >= 4 * ROUNDS);
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  rtems_status_code sc;
+  int fd;
+  int rv;
+
+  ctx->master = rtems_task_self();
+
+  sc = rtems_task_create(
+    WORKER_NAME,
+    1,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &ctx->worker
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(ctx->worker, worker, (rtems_task_argument) ctx);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_open(RECORDS, NULL);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_watch_global(true);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_watch_floor(PRIO_DRAIN - 1);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_set_trigger(
+    0,
+    0,
+    WORKER_NAME,
+    0,
+    rtems_capture_from_any,
+    rtems_capture_switch
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  fd = open(trace, O_RDWR | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  sc = rtems_capture_trace_start(fd, PRIO_DRAIN, 1000);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_trace_start(fd, PRIO_DRAIN, 1000);
+  rtems_test_assert(sc == RTEMS_RESOURCE_IN_USE);
+
+  sc = rtems_capture_control(true);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  ping_pong(ctx);
+  user_events();
+
+  /* Let the drain task write the records so far */
+  rtems_task_wake_after(2);
+
+  ping_pong(ctx);
+  user_events();
+
+  sc = rtems_capture_control(false);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_trace_stop(&ctx->records);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_trace_stop(NULL);
+  rtems_test_assert(sc == RTEMS_NOT_DEFINED);
+
+  verify(ctx, fd);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_task_delete(ctx->worker);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_capture_close();
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST CAPTURE 2 ***");
+  test();
+  puts("*** END OF TEST CAPTURE 2 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_MAXIMUM_USER_EXTENSIONS 1
+
+#define CONFIGURE_MEMORY_OVERHEAD 4
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
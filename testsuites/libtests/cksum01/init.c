@@ -0,0 +1,241 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The checksum routines are declared for the network stack only */
+#ifndef _KERNEL
+#define _KERNEL
+#endif
+
+#include <rtems/rtems_bsdnet.h>
+#include <sys/param.h>
+#include <sys/mbuf.h>
+#include <netinet/in.h>
+
+#include <rtems/counter.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define BUFFER_SIZE 1536
+
+#define SEGMENTS 4
+
+#define SAMPLES 1000
+
+static const int packet_sizes[] = { 20, 64, 576, 1500 };
+
+typedef struct {
+  struct mbuf m[SEGMENTS];
+  uint8_t src[BUFFER_SIZE + 8] __attribute__((aligned(8)));
+  uint8_t dst[BUFFER_SIZE + 8] __attribute__((aligned(8)));
+} test_context;
+
+static test_context test_instance;
+
+static int reference_cksum(const uint8_t *p, int len)
+{
+  uint32_t sum = 0;
+  int i;
+
+  for (i = 0; i + 1 < len; i += 2) {
+    uint16_t v;
+
+    memcpy(&v, &p[i], sizeof(v));
+    sum += v;
+  }
+
+  if ((len & 1) != 0) {
+    uint8_t b[2] = { p[len - 1], 0 };
+    uint16_t v;
+
+    memcpy(&v, &b[0], sizeof(v));
+    sum += v;
+  }
+
+  while ((sum >> 16) != 0) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+
+  return (int) (~sum & 0xffff);
+}
+
+static struct mbuf *init_chain(
+  test_context *ctx,
+  uint8_t *p,
+  int len,
+  int segments
+)
+{
+  int pos = 0;
+  int i;
+
+  for (i = 0; i < segments; ++i) {
+    struct mbuf *m = &ctx->m[i];
+    int end = i + 1 < segments ? pos + rand() % (len - pos + 1) : len;
+
+    memset(m, 0, sizeof(*m));
+    m->m_data = (caddr_t) &p[pos];
+    m->m_len = end - pos;
+    m->m_next = i + 1 < segments ? &ctx->m[i + 1] : NULL;
+    pos = end;
+  }
+
+  return &ctx->m[0];
+}
+
+static void test_checksums(test_context *ctx)
+{
+  int i;
+
+  srand(0);
+
+  for (i = 0; i < 10000; ++i) {
+    int len = rand() % (BUFFER_SIZE + 1);
+    int src_off = rand() % 8;
+    int dst_off = rand() % 8;
+    int segments = 1 + rand() % SEGMENTS;
+    uint8_t *p = &ctx->src[src_off];
+    struct mbuf *m;
+    int expected;
+    int j;
+    u_int sum;
+
+    for (j = 0; j < len; ++j) {
+      p[j] = (uint8_t) rand();
+    }
+
+    expected = reference_cksum(p, len);
+
+    m = init_chain(ctx, p, len, segments);
+    rtems_test_assert(in_cksum_generic(m, len) == expected);
+    rtems_test_assert(in_cksum(m, len) == expected);
+
+    sum = in_cksum_copy(p, &ctx->dst[dst_off], len, 0);
+    rtems_test_assert((int) (~sum & 0xffff) == expected);
+    rtems_test_assert(memcmp(p, &ctx->dst[dst_off], (size_t) len) == 0);
+
+    memset(&ctx->dst[0], 0, sizeof(ctx->dst));
+    sum = in_cksum_copydata(m, 0, len, &ctx->dst[dst_off]);
+    rtems_test_assert((int) (~sum & 0xffff) == expected);
+    rtems_test_assert(memcmp(p, &ctx->dst[dst_off], (size_t) len) == 0);
+  }
+}
+
+typedef int (*cksum_routine)(struct mbuf *, int);
+
+static uint64_t measure_cksum(test_context *ctx, cksum_routine cksum, int len)
+{
+  struct mbuf *m = init_chain(ctx, &ctx->src[0], len, 1);
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  int i;
+
+  a = rtems_counter_read();
+
+  for (i = 0; i < SAMPLES; ++i) {
+    (*cksum)(m, len);
+  }
+
+  b = rtems_counter_read();
+
+  return rtems_counter_ticks_to_nanoseconds(rtems_counter_difference(b, a));
+}
+
+static uint64_t measure_copy_then_cksum(test_context *ctx, int len)
+{
+  struct mbuf *m = init_chain(ctx, &ctx->dst[0], len, 1);
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  int i;
+
+  a = rtems_counter_read();
+
+  for (i = 0; i < SAMPLES; ++i) {
+    memcpy(&ctx->dst[0], &ctx->src[0], (size_t) len);
+    in_cksum(m, len);
+  }
+
+  b = rtems_counter_read();
+
+  return rtems_counter_ticks_to_nanoseconds(rtems_counter_difference(b, a));
+}
+
+static uint64_t measure_copy_cksum(test_context *ctx, int len)
+{
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  int i;
+
+  a = rtems_counter_read();
+
+  for (i = 0; i < SAMPLES; ++i) {
+    in_cksum_copy(&ctx->src[0], &ctx->dst[0], len, 0);
+  }
+
+  b = rtems_counter_read();
+
+  return rtems_counter_ticks_to_nanoseconds(rtems_counter_difference(b, a));
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  size_t i;
+
+  test_checksums(ctx);
+
+  printf("<CksumTest samples=\"%i\">\n", SAMPLES);
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(packet_sizes); ++i) {
+    int len = packet_sizes[i];
+
+    printf(
+      "  <Packet size=\"%i\">\n"
+      "    <CPUSpecific unit=\"ns\">%" PRIu64 "</CPUSpecific>\n"
+      "    <Generic unit=\"ns\">%" PRIu64 "</Generic>\n"
+      "    <CopyThenCksum unit=\"ns\">%" PRIu64 "</CopyThenCksum>\n"
+      "    <CopyCksum unit=\"ns\">%" PRIu64 "</CopyCksum>\n"
+      "  </Packet>\n",
+      len,
+      measure_cksum(ctx, in_cksum, len),
+      measure_cksum(ctx, in_cksum_generic, len),
+      measure_copy_then_cksum(ctx, len),
+      measure_copy_cksum(ctx, len)
+    );
+  }
+
+  printf("</CksumTest>\n");
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST CKSUM 1 ***");
+  test();
+  puts("*** END OF TEST CKSUM 1 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,144 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <rtems/cpuuse.h>
+
+#define MONITOR_PRIORITY 1
+
+#define INIT_PRIORITY 2
+
+static void busy_wait(rtems_interval ticks)
+{
+  rtems_interval start = rtems_clock_get_ticks_since_boot();
+
+  while (rtems_clock_get_ticks_since_boot() - start < ticks) {
+    /* Wait */
+  }
+}
+
+static int count_plugin(void *arg, const char *format, ...)
+{
+  uint32_t *calls = arg;
+
+  ++(*calls);
+
+  return 0;
+}
+
+static void test_not_started(void)
+{
+  rtems_cpu_load load;
+  rtems_status_code sc;
+  uint32_t calls = 0;
+
+  sc = rtems_cpu_load_monitor_stop();
+  rtems_test_assert(sc == RTEMS_INCORRECT_STATE);
+
+  sc = rtems_cpu_load_get_thread(RTEMS_SELF, &load);
+  rtems_test_assert(sc == RTEMS_INCORRECT_STATE);
+
+  sc = rtems_cpu_load_get_processor(0, &load);
+  rtems_test_assert(sc == RTEMS_INCORRECT_STATE);
+
+  rtems_cpu_load_top_with_plugin(
+    &calls,
+    count_plugin,
+    RTEMS_CPU_LOAD_WINDOW_1_SECOND,
+    0
+  );
+  rtems_test_assert(calls == 1);
+}
+
+static void test_started(void)
+{
+  rtems_interval ticks_per_second = rtems_clock_get_ticks_per_second();
+  rtems_cpu_load load;
+  rtems_status_code sc;
+  uint32_t calls = 0;
+
+  sc = rtems_cpu_load_monitor_start(MONITOR_PRIORITY);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_cpu_load_monitor_start(MONITOR_PRIORITY);
+  rtems_test_assert(sc == RTEMS_INCORRECT_STATE);
+
+  sc = rtems_cpu_load_get_thread(RTEMS_SELF, NULL);
+  rtems_test_assert(sc == RTEMS_INVALID_ADDRESS);
+
+  sc = rtems_cpu_load_get_thread(1, &load);
+  rtems_test_assert(sc == RTEMS_INVALID_ID);
+
+  sc = rtems_cpu_load_get_processor(0, NULL);
+  rtems_test_assert(sc == RTEMS_INVALID_ADDRESS);
+
+  sc = rtems_cpu_load_get_processor(rtems_smp_get_processor_count(), &load);
+  rtems_test_assert(sc == RTEMS_INVALID_NUMBER);
+
+  busy_wait(2 * ticks_per_second + ticks_per_second / 2);
+
+  sc = rtems_cpu_load_get_thread(RTEMS_SELF, &load);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(load.load[RTEMS_CPU_LOAD_WINDOW_1_SECOND] >= 500);
+  rtems_test_assert(load.load[RTEMS_CPU_LOAD_WINDOW_1_SECOND] <= 1000);
+
+  sc = rtems_cpu_load_get_processor(rtems_smp_get_current_processor(), &load);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(load.load[RTEMS_CPU_LOAD_WINDOW_1_SECOND] >= 500);
+
+  sc = rtems_task_wake_after(2 * ticks_per_second + ticks_per_second / 2);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_cpu_load_get_thread(RTEMS_SELF, &load);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(load.load[RTEMS_CPU_LOAD_WINDOW_1_SECOND] <= 100);
+  rtems_test_assert(
+    load.load[RTEMS_CPU_LOAD_WINDOW_10_SECONDS]
+      > load.load[RTEMS_CPU_LOAD_WINDOW_1_SECOND]
+  );
+
+  rtems_cpu_load_top_with_plugin(
+    &calls,
+    count_plugin,
+    RTEMS_CPU_LOAD_WINDOW_10_SECONDS,
+    1
+  );
+  rtems_test_assert(calls > 1);
+
+  sc = rtems_cpu_load_monitor_stop();
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  puts("\n\n*** TEST CPULOAD 1 ***");
+
+  test_not_started();
+  test_started();
+  test_not_started();
+
+  puts("*** END OF TEST CPULOAD 1 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+
+#define CONFIGURE_INIT_TASK_PRIORITY INIT_PRIORITY
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,307 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/counter.h>
+#include <rtems/jffs2.h>
+#include <rtems/libio.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define BLOCK_SIZE (8UL * 1024UL)
+
+#define FLASH_SIZE (32UL * BLOCK_SIZE)
+
+#define FILE_SIZE (16 * 1024)
+
+#define CHUNK_SIZE 1024
+
+#define WRITES 400
+
+#define GC_PRIO 10
+
+typedef struct {
+  rtems_jffs2_flash_control super;
+  unsigned char area[FLASH_SIZE];
+} flash_control;
+
+static flash_control *get_flash_control(rtems_jffs2_flash_control *super)
+{
+  return (flash_control *) super;
+}
+
+static int flash_read(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset,
+  unsigned char *buffer,
+  size_t size_of_buffer
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+
+  memcpy(buffer, chunk, size_of_buffer);
+
+  return 0;
+}
+
+static int flash_write(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset,
+  const unsigned char *buffer,
+  size_t size_of_buffer
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+  size_t i;
+
+  for (i = 0; i < size_of_buffer; ++i) {
+    chunk[i] &= buffer[i];
+  }
+
+  return 0;
+}
+
+static int flash_erase(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+
+  memset(chunk, 0xff, BLOCK_SIZE);
+
+  return 0;
+}
+
+static flash_control flash_instance = {
+  .super = {
+    .block_size = BLOCK_SIZE,
+    .flash_size = FLASH_SIZE,
+    .read = flash_read,
+    .write = flash_write,
+    .erase = flash_erase
+  }
+};
+
+static const char mnt[] = "/mnt";
+
+static const char file[] = "/mnt/log";
+
+static unsigned char buf[CHUNK_SIZE];
+
+static void do_mount(rtems_task_priority gc_prio)
+{
+  rtems_jffs2_mount_data mount_data;
+  int rv;
+
+  memset(&mount_data, 0, sizeof(mount_data));
+  mount_data.flash_control = &flash_instance.super;
+  mount_data.gc_task_priority = gc_prio;
+  mount_data.gc_task_stack_size = 8 * 1024;
+  mount_data.gc_free_blocks_threshold = 16;
+
+  memset(&flash_instance.area[0], 0xff, FLASH_SIZE);
+
+  rv = mount(
+    NULL,
+    mnt,
+    RTEMS_FILESYSTEM_TYPE_JFFS2,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    &mount_data
+  );
+  rtems_test_assert(rv == 0);
+}
+
+static void do_unmount(void)
+{
+  int rv;
+
+  rv = unmount(mnt);
+  rtems_test_assert(rv == 0);
+}
+
+static void log_writes(const char *name, rtems_jffs2_gc_info *info)
+{
+  uint64_t max = 0;
+  uint64_t sum = 0;
+  int fd;
+  int i;
+  int rv;
+
+  fd = open(file, O_RDWR | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  for (i = 0; i < WRITES; ++i) {
+    rtems_counter_ticks a;
+    rtems_counter_ticks b;
+    uint64_t d;
+    ssize_t n;
+    off_t off;
+
+    memset(&buf[0], i, sizeof(buf));
+
+    off = lseek(fd, (i * CHUNK_SIZE) % FILE_SIZE, SEEK_SET);
+    rtems_test_assert(off == (i * CHUNK_SIZE) % FILE_SIZE);
+
+    a = rtems_counter_read();
+    n = write(fd, &buf[0], sizeof(buf));
+    b = rtems_counter_read();
+    rtems_test_assert(n == (ssize_t) sizeof(buf));
+
+    d = rtems_counter_ticks_to_nanoseconds(rtems_counter_difference(b, a));
+    sum += d;
+    if (d > max) {
+      max = d;
+    }
+
+    /* Idle time for the background garbage collection */
+    rtems_task_wake_after(1);
+  }
+
+  rv = ioctl(fd, RTEMS_JFFS2_GET_GC_INFO, info);
+  rtems_test_assert(rv == 0);
+
+  errno = 0;
+  rv = ioctl(fd, RTEMS_JFFS2_GET_GC_INFO, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EFAULT);
+
+  errno = 0;
+  rv = ioctl(fd, FIONREAD, &rv);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOTTY);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  printf(
+    "  <%s>\n"
+    "    <WriteAvg unit=\"ns\">%" PRIu64 "</WriteAvg>\n"
+    "    <WriteMax unit=\"ns\">%" PRIu64 "</WriteMax>\n"
+    "    <BackgroundPasses>%" PRIu32 "</BackgroundPasses>\n"
+    "    <BackgroundTime unit=\"ns\">%" PRIu64 "</BackgroundTime>\n"
+    "    <ForegroundStalls>%" PRIu32 "</ForegroundStalls>\n"
+    "    <ForegroundStallTime unit=\"ns\">%" PRIu64 "</ForegroundStallTime>\n"
+    "    <ForegroundStallMax unit=\"ns\">%" PRIu64 "</ForegroundStallMax>\n"
+    "  </%s>\n",
+    name,
+    sum / WRITES,
+    max,
+    info->background_passes,
+    info->background_time,
+    info->foreground_stalls,
+    info->foreground_stall_time,
+    info->foreground_stall_max,
+    name
+  );
+}
+
+static void verify(void)
+{
+  unsigned char check[CHUNK_SIZE];
+  int fd;
+  int i;
+  int rv;
+
+  fd = open(file, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  for (i = 0; i < FILE_SIZE / CHUNK_SIZE; ++i) {
+    ssize_t n = read(fd, &check[0], sizeof(check));
+    int last = WRITES - FILE_SIZE / CHUNK_SIZE + i;
+
+    rtems_test_assert(n == (ssize_t) sizeof(check));
+    memset(&buf[0], last, sizeof(buf));
+    rtems_test_assert(memcmp(&check[0], &buf[0], sizeof(check)) == 0);
+  }
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void test(void)
+{
+  rtems_jffs2_gc_info fg;
+  rtems_jffs2_gc_info bg;
+  int rv;
+
+  rv = mkdir(mnt, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  printf(
+    "<JFFS2GCTest writes=\"%i\" chunk=\"%i\" file-size=\"%i\">\n",
+    WRITES,
+    CHUNK_SIZE,
+    FILE_SIZE
+  );
+
+  do_mount(0);
+  log_writes("ForegroundGC", &fg);
+  verify();
+  do_unmount();
+
+  rtems_test_assert(fg.background_passes == 0);
+  rtems_test_assert(fg.foreground_stalls > 0);
+
+  do_mount(GC_PRIO);
+  log_writes("BackgroundGC", &bg);
+  verify();
+  do_unmount();
+
+  rtems_test_assert(bg.background_passes > 0);
+  rtems_test_assert(bg.foreground_stalls < fg.foreground_stalls);
+
+  printf("</JFFS2GCTest>\n");
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST JFFS2GC 1 ***");
+  test();
+  puts("*** END OF TEST JFFS2GC 1 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_MICROSECONDS_PER_TICK 1000
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+#define CONFIGURE_FILESYSTEM_JFFS2
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+
+#define CONFIGURE_EXTRA_TASK_STACKS (8 * 1024)
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (32 * 1024)
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
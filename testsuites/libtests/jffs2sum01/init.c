@@ -0,0 +1,292 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/counter.h>
+#include <rtems/jffs2.h>
+#include <rtems/libio.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define BLOCK_SIZE (8UL * 1024UL)
+
+#define FLASH_SIZE (32UL * BLOCK_SIZE)
+
+#define FILES 12
+
+#define FILE_SIZE 4096
+
+typedef struct {
+  rtems_jffs2_flash_control super;
+  uint32_t reads;
+  uint32_t bytes_read;
+  unsigned char area[FLASH_SIZE];
+} flash_control;
+
+static flash_control *get_flash_control(rtems_jffs2_flash_control *super)
+{
+  return (flash_control *) super;
+}
+
+static int flash_read(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset,
+  unsigned char *buffer,
+  size_t size_of_buffer
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+
+  ++self->reads;
+  self->bytes_read += size_of_buffer;
+  memcpy(buffer, chunk, size_of_buffer);
+
+  return 0;
+}
+
+static int flash_write(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset,
+  const unsigned char *buffer,
+  size_t size_of_buffer
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+  size_t i;
+
+  for (i = 0; i < size_of_buffer; ++i) {
+    chunk[i] &= buffer[i];
+  }
+
+  return 0;
+}
+
+static int flash_erase(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+
+  memset(chunk, 0xff, BLOCK_SIZE);
+
+  return 0;
+}
+
+static flash_control flash_instance = {
+  .super = {
+    .block_size = BLOCK_SIZE,
+    .flash_size = FLASH_SIZE,
+    .read = flash_read,
+    .write = flash_write,
+    .erase = flash_erase
+  }
+};
+
+static const rtems_jffs2_mount_data mount_data = {
+  .flash_control = &flash_instance.super
+};
+
+static const char mnt[] = "/mnt";
+
+static unsigned char buf[FILE_SIZE];
+
+static void fill(int f)
+{
+  size_t i;
+
+  for (i = 0; i < FILE_SIZE; ++i) {
+    buf[i] = (unsigned char) (i * 7 + f);
+  }
+}
+
+static void make_path(char *path, size_t size, int f)
+{
+  snprintf(path, size, "%s/f%02i", mnt, f);
+}
+
+static void create_files(int first, int count)
+{
+  int f;
+
+  for (f = first; f < first + count; ++f) {
+    char path[32];
+    ssize_t n;
+    int fd;
+    int rv;
+
+    make_path(path, sizeof(path), f);
+    fill(f);
+
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, S_IRWXU);
+    rtems_test_assert(fd >= 0);
+
+    n = write(fd, &buf[0], FILE_SIZE);
+    rtems_test_assert(n == FILE_SIZE);
+
+    rv = close(fd);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+static void verify_files(int count)
+{
+  unsigned char check[64];
+  int f;
+
+  for (f = 0; f < count; ++f) {
+    char path[32];
+    size_t i;
+    int fd;
+    int rv;
+
+    make_path(path, sizeof(path), f);
+    fill(f);
+
+    fd = open(path, O_RDONLY);
+    rtems_test_assert(fd >= 0);
+
+    for (i = 0; i < FILE_SIZE; i += sizeof(check)) {
+      ssize_t n = read(fd, &check[0], sizeof(check));
+      rtems_test_assert(n == (ssize_t) sizeof(check));
+      rtems_test_assert(memcmp(&check[0], &buf[i], sizeof(check)) == 0);
+    }
+
+    rv = close(fd);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+static void do_mount(void)
+{
+  int rv;
+
+  rv = mount(
+    NULL,
+    mnt,
+    RTEMS_FILESYSTEM_TYPE_JFFS2,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    &mount_data
+  );
+  rtems_test_assert(rv == 0);
+}
+
+static void do_unmount(void)
+{
+  int rv;
+
+  rv = unmount(mnt);
+  rtems_test_assert(rv == 0);
+}
+
+static void measure_mount(int files)
+{
+  flash_control *self = &flash_instance;
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  uint64_t d;
+
+  self->reads = 0;
+  self->bytes_read = 0;
+
+  a = rtems_counter_read();
+  do_mount();
+  b = rtems_counter_read();
+
+  d = rtems_counter_ticks_to_nanoseconds(rtems_counter_difference(b, a));
+
+  printf(
+    "  <Mount files=\"%i\">\n"
+    "    <Time unit=\"ns\">%" PRIu64 "</Time>\n"
+    "    <Reads>%" PRIu32 "</Reads>\n"
+    "    <BytesRead>%" PRIu32 "</BytesRead>\n"
+    "  </Mount>\n",
+    files,
+    d,
+    self->reads,
+    self->bytes_read
+  );
+
+  /*
+   * With the erase block summaries the mount must not read the data of the
+   * files.
+   */
+  rtems_test_assert(self->bytes_read < (files * FILE_SIZE) / 2);
+}
+
+static void test(void)
+{
+  int rv;
+
+  memset(&flash_instance.area[0], 0xff, FLASH_SIZE);
+
+  rv = mkdir(mnt, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  printf(
+    "<JFFS2SummaryTest blocks=\"%lu\" block-size=\"%lu\">\n",
+    FLASH_SIZE / BLOCK_SIZE,
+    BLOCK_SIZE
+  );
+
+  do_mount();
+  create_files(0, FILES);
+  do_unmount();
+
+  measure_mount(FILES);
+  verify_files(FILES);
+  create_files(FILES, FILES);
+  do_unmount();
+
+  measure_mount(2 * FILES);
+  verify_files(2 * FILES);
+  do_unmount();
+
+  printf("</JFFS2SummaryTest>\n");
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST JFFS2SUM 1 ***");
+  test();
+  puts("*** END OF TEST JFFS2SUM 1 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+#define CONFIGURE_FILESYSTEM_JFFS2
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (32 * 1024)
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,325 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <rtems/malloc.h>
+
+#include <stdlib.h>
+
+#define MAXIMUM_ALLOCATIONS 64
+
+#define SITE_SIZE 100
+
+#define BLOCK_COUNT 10
+
+#define CALLER_RANGE 256
+
+static void *blocks[BLOCK_COUNT];
+
+static void *extra_blocks[MAXIMUM_ALLOCATIONS + 1];
+
+/*
+ * The assertions after the allocations prevent tail calls, so that the
+ * caller addresses are in these functions.
+ */
+
+static void *__attribute__((noinline)) alloc_malloc(size_t size)
+{
+  void *ptr = malloc(size);
+
+  rtems_test_assert(ptr != NULL);
+
+  return ptr;
+}
+
+static void *__attribute__((noinline)) alloc_calloc(size_t size)
+{
+  void *ptr = calloc(1, size);
+
+  rtems_test_assert(ptr != NULL);
+
+  return ptr;
+}
+
+static void *__attribute__((noinline)) alloc_realloc(void *ptr, size_t size)
+{
+  void *new_ptr = realloc(ptr, size);
+
+  rtems_test_assert(new_ptr == ptr);
+
+  return new_ptr;
+}
+
+static void *__attribute__((noinline)) alloc_memalign(size_t size)
+{
+  void *ptr;
+  int eno;
+
+  eno = posix_memalign(&ptr, 64, size);
+  rtems_test_assert(eno == 0);
+
+  return ptr;
+}
+
+/*
+ * The caller address of a site is somewhere in the allocating function.
+ */
+static const rtems_malloc_profiling_site *find_site(
+  const rtems_malloc_profiling_snapshot *snapshot,
+  const void *function
+)
+{
+  uintptr_t begin = (uintptr_t) function & ~(uintptr_t) 1;
+  uint32_t i;
+
+  for (i = 0; i < snapshot->site_count; ++i) {
+    uintptr_t caller = (uintptr_t) snapshot->sites[i].caller;
+
+    if (caller >= begin && caller < begin + CALLER_RANGE) {
+      return &snapshot->sites[i];
+    }
+  }
+
+  return NULL;
+}
+
+static rtems_malloc_profiling_snapshot *take_snapshot(void)
+{
+  rtems_malloc_profiling_snapshot *snapshot;
+  rtems_status_code sc;
+
+  sc = rtems_malloc_profiling_take_snapshot(&snapshot);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(snapshot != NULL);
+
+  return snapshot;
+}
+
+static void check_site(
+  const void *function,
+  uint32_t live_count,
+  uintptr_t live_bytes,
+  uint32_t calls
+)
+{
+  rtems_malloc_profiling_snapshot *snapshot = take_snapshot();
+  const rtems_malloc_profiling_site *site = find_site(snapshot, function);
+
+  rtems_test_assert(site != NULL);
+  rtems_test_assert(site->live_count == live_count);
+  rtems_test_assert(site->live_bytes == live_bytes);
+  rtems_test_assert(site->calls == calls);
+
+  rtems_malloc_profiling_free_snapshot(snapshot);
+}
+
+static int count_lines(void *arg, const char *fmt, ...)
+{
+  uint32_t *lines = arg;
+  const char *c;
+
+  for (c = fmt; *c != '\0'; ++c) {
+    if (*c == '\n') {
+      ++(*lines);
+    }
+  }
+
+  return 0;
+}
+
+static void test_invalid(void)
+{
+  rtems_status_code sc;
+
+  sc = rtems_malloc_profiling_take_snapshot(NULL);
+  rtems_test_assert(sc == RTEMS_INVALID_ADDRESS);
+}
+
+static void test_sites(void)
+{
+  rtems_malloc_profiling_snapshot *before;
+  rtems_malloc_profiling_snapshot *after;
+  const rtems_malloc_profiling_site *site;
+  uint32_t lines;
+  size_t i;
+
+  before = take_snapshot();
+  rtems_test_assert(find_site(before, alloc_malloc) == NULL);
+
+  for (i = 0; i < BLOCK_COUNT; ++i) {
+    blocks[i] = alloc_malloc(SITE_SIZE);
+  }
+
+  check_site(alloc_malloc, BLOCK_COUNT, BLOCK_COUNT * SITE_SIZE, BLOCK_COUNT);
+
+  for (i = 0; i < BLOCK_COUNT; i += 2) {
+    free(blocks[i]);
+    blocks[i] = NULL;
+  }
+
+  check_site(
+    alloc_malloc,
+    BLOCK_COUNT / 2,
+    (BLOCK_COUNT / 2) * SITE_SIZE,
+    BLOCK_COUNT
+  );
+
+  after = take_snapshot();
+  site = find_site(after, alloc_malloc);
+  rtems_test_assert(site != NULL);
+  rtems_test_assert(site->peak_bytes == BLOCK_COUNT * SITE_SIZE);
+  rtems_test_assert(site->size_classes == (UINT32_C(1) << 6));
+
+  lines = 0;
+  rtems_malloc_profiling_report_diff_with_plugin(
+    &lines,
+    count_lines,
+    before,
+    after,
+    0
+  );
+  rtems_test_assert(lines >= 3);
+
+  lines = 0;
+  rtems_malloc_profiling_report_diff_with_plugin(
+    &lines,
+    count_lines,
+    before,
+    after,
+    1
+  );
+  rtems_test_assert(lines == 3);
+
+  rtems_malloc_profiling_free_snapshot(before);
+  rtems_malloc_profiling_free_snapshot(after);
+
+  /* Shrink in place, this moves the block to the realloc() site */
+  blocks[1] = alloc_realloc(blocks[1], SITE_SIZE / 2);
+
+  check_site(
+    alloc_malloc,
+    BLOCK_COUNT / 2 - 1,
+    (BLOCK_COUNT / 2 - 1) * SITE_SIZE,
+    BLOCK_COUNT
+  );
+  check_site(alloc_realloc, 1, SITE_SIZE / 2, 1);
+
+  blocks[0] = alloc_calloc(SITE_SIZE);
+  check_site(alloc_calloc, 1, SITE_SIZE, 1);
+
+  blocks[2] = alloc_memalign(SITE_SIZE);
+  check_site(alloc_memalign, 1, SITE_SIZE, 1);
+
+  lines = 0;
+  rtems_malloc_profiling_report_with_plugin(&lines, count_lines, 0);
+  rtems_test_assert(lines >= 13);
+
+  lines = 0;
+  rtems_malloc_profiling_report_with_plugin(&lines, count_lines, 1);
+  rtems_test_assert(lines == 7);
+
+  for (i = 0; i < BLOCK_COUNT; ++i) {
+    free(blocks[i]);
+    blocks[i] = NULL;
+  }
+
+  check_site(alloc_malloc, 0, 0, BLOCK_COUNT);
+  check_site(alloc_realloc, 0, 0, 1);
+  check_site(alloc_calloc, 0, 0, 1);
+  check_site(alloc_memalign, 0, 0, 1);
+}
+
+static void test_untracked(void)
+{
+  rtems_malloc_profiling_snapshot *snapshot;
+  uint32_t untracked;
+  size_t i;
+
+  snapshot = take_snapshot();
+  untracked = snapshot->untracked;
+  rtems_malloc_profiling_free_snapshot(snapshot);
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(extra_blocks); ++i) {
+    extra_blocks[i] = alloc_malloc(16);
+  }
+
+  snapshot = take_snapshot();
+  rtems_test_assert(snapshot->untracked > untracked);
+  rtems_malloc_profiling_free_snapshot(snapshot);
+
+  /* Free in an order which moves entries of the probe sequences */
+  for (i = 1; i < RTEMS_ARRAY_SIZE(extra_blocks); i += 2) {
+    free(extra_blocks[i]);
+  }
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(extra_blocks); i += 2) {
+    free(extra_blocks[i]);
+  }
+
+  check_site(
+    alloc_malloc,
+    0,
+    0,
+    BLOCK_COUNT + RTEMS_ARRAY_SIZE(extra_blocks)
+  );
+
+  /* The table must be usable after the removals */
+  for (i = 0; i < BLOCK_COUNT; ++i) {
+    blocks[i] = alloc_malloc(SITE_SIZE);
+  }
+
+  check_site(
+    alloc_malloc,
+    BLOCK_COUNT,
+    BLOCK_COUNT * SITE_SIZE,
+    2 * BLOCK_COUNT + RTEMS_ARRAY_SIZE(extra_blocks)
+  );
+
+  for (i = 0; i < BLOCK_COUNT; ++i) {
+    free(blocks[i]);
+    blocks[i] = NULL;
+  }
+
+  check_site(
+    alloc_malloc,
+    0,
+    0,
+    2 * BLOCK_COUNT + RTEMS_ARRAY_SIZE(extra_blocks)
+  );
+}
+
+static void Init(rtems_task_argument arg)
+{
+  puts("\n\n*** TEST MALLOC 6 ***");
+
+  test_invalid();
+  test_sites();
+  test_untracked();
+
+  puts("*** END OF TEST MALLOC 6 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_MALLOC_PROFILING
+
+#define CONFIGURE_MALLOC_PROFILING_MAXIMUM_ALLOCATIONS MAXIMUM_ALLOCATIONS
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
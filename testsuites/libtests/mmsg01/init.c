@@ -0,0 +1,282 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/counter.h>
+#include <rtems/rtems_bsdnet.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+#define PORT 5000
+
+#define DATAGRAM_SIZE 64
+
+#define BATCH_SIZE 16
+
+#define BATCHES 256
+
+typedef struct {
+  int rx;
+  int tx;
+  struct sockaddr_in addr;
+  char tx_buf[BATCH_SIZE][DATAGRAM_SIZE];
+  char rx_buf[BATCH_SIZE][DATAGRAM_SIZE];
+  struct iovec tx_iov[BATCH_SIZE];
+  struct iovec rx_iov[BATCH_SIZE];
+  struct mmsghdr tx_msg[BATCH_SIZE];
+  struct mmsghdr rx_msg[BATCH_SIZE];
+} test_context;
+
+static test_context test_instance;
+
+static void open_sockets(test_context *ctx)
+{
+  int rv;
+  int size = 2 * BATCH_SIZE * 256;
+
+  ctx->addr.sin_len = sizeof(ctx->addr);
+  ctx->addr.sin_family = AF_INET;
+  ctx->addr.sin_port = htons(PORT);
+  ctx->addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  ctx->rx = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(ctx->rx >= 0);
+
+  rv = setsockopt(ctx->rx, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+  rtems_test_assert(rv == 0);
+
+  rv = bind(ctx->rx, (struct sockaddr *) &ctx->addr, sizeof(ctx->addr));
+  rtems_test_assert(rv == 0);
+
+  ctx->tx = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(ctx->tx >= 0);
+}
+
+static void init_messages(test_context *ctx)
+{
+  size_t i;
+
+  for (i = 0; i < BATCH_SIZE; ++i) {
+    struct msghdr *tx = &ctx->tx_msg[i].msg_hdr;
+    struct msghdr *rx = &ctx->rx_msg[i].msg_hdr;
+
+    memset(&ctx->tx_buf[i][0], (int) i, DATAGRAM_SIZE);
+
+    ctx->tx_iov[i].iov_base = &ctx->tx_buf[i][0];
+    ctx->tx_iov[i].iov_len = DATAGRAM_SIZE;
+    memset(tx, 0, sizeof(*tx));
+    tx->msg_name = &ctx->addr;
+    tx->msg_namelen = sizeof(ctx->addr);
+    tx->msg_iov = &ctx->tx_iov[i];
+    tx->msg_iovlen = 1;
+
+    ctx->rx_iov[i].iov_base = &ctx->rx_buf[i][0];
+    ctx->rx_iov[i].iov_len = DATAGRAM_SIZE;
+    memset(rx, 0, sizeof(*rx));
+    rx->msg_iov = &ctx->rx_iov[i];
+    rx->msg_iovlen = 1;
+  }
+}
+
+static void check_rx(test_context *ctx, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; ++i) {
+    rtems_test_assert(ctx->rx_msg[i].msg_len == DATAGRAM_SIZE);
+    rtems_test_assert(
+      memcmp(&ctx->rx_buf[i][0], &ctx->tx_buf[i][0], DATAGRAM_SIZE) == 0
+    );
+  }
+
+  memset(&ctx->rx_buf[0][0], 0xff, sizeof(ctx->rx_buf));
+}
+
+static void test_vector(test_context *ctx)
+{
+  ssize_t n;
+  struct timespec to = { .tv_sec = 0, .tv_nsec = 0 };
+
+  errno = 0;
+  n = recvmmsg(ctx->rx, &ctx->rx_msg[0], BATCH_SIZE, MSG_DONTWAIT, NULL);
+  rtems_test_assert(n == -1);
+  rtems_test_assert(errno == EWOULDBLOCK);
+
+  errno = 0;
+  n = sendmmsg(-1, &ctx->tx_msg[0], BATCH_SIZE, 0);
+  rtems_test_assert(n == -1);
+  rtems_test_assert(errno == EBADF);
+
+  n = sendmmsg(ctx->tx, &ctx->tx_msg[0], 0, 0);
+  rtems_test_assert(n == 0);
+
+  n = sendmmsg(ctx->tx, &ctx->tx_msg[0], BATCH_SIZE, 0);
+  rtems_test_assert(n == BATCH_SIZE);
+
+  n = recvmmsg(ctx->rx, &ctx->rx_msg[0], BATCH_SIZE, 0, NULL);
+  rtems_test_assert(n == BATCH_SIZE);
+  check_rx(ctx, BATCH_SIZE);
+
+  /* MSG_WAITFORONE must not block after the first datagram */
+  n = sendmmsg(ctx->tx, &ctx->tx_msg[0], BATCH_SIZE / 2, 0);
+  rtems_test_assert(n == BATCH_SIZE / 2);
+
+  n = recvmmsg(ctx->rx, &ctx->rx_msg[0], BATCH_SIZE, MSG_WAITFORONE, NULL);
+  rtems_test_assert(n == BATCH_SIZE / 2);
+  check_rx(ctx, BATCH_SIZE / 2);
+
+  /* An expired timeout ends the receive after the first datagram */
+  n = sendmmsg(ctx->tx, &ctx->tx_msg[0], 2, 0);
+  rtems_test_assert(n == 2);
+
+  n = recvmmsg(ctx->rx, &ctx->rx_msg[0], BATCH_SIZE, 0, &to);
+  rtems_test_assert(n == 1);
+
+  n = recvmmsg(ctx->rx, &ctx->rx_msg[1], BATCH_SIZE - 1, 0, &to);
+  rtems_test_assert(n == 1);
+  check_rx(ctx, 2);
+
+  to.tv_nsec = 1000000000;
+  errno = 0;
+  n = recvmmsg(ctx->rx, &ctx->rx_msg[0], BATCH_SIZE, 0, &to);
+  rtems_test_assert(n == -1);
+  rtems_test_assert(errno == EINVAL);
+}
+
+static rtems_counter_ticks measure_single(test_context *ctx)
+{
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  size_t i;
+  size_t j;
+
+  a = rtems_counter_read();
+
+  for (i = 0; i < BATCHES; ++i) {
+    for (j = 0; j < BATCH_SIZE; ++j) {
+      ssize_t n = sendto(
+        ctx->tx,
+        &ctx->tx_buf[j][0],
+        DATAGRAM_SIZE,
+        0,
+        (struct sockaddr *) &ctx->addr,
+        sizeof(ctx->addr)
+      );
+      rtems_test_assert(n == DATAGRAM_SIZE);
+    }
+
+    for (j = 0; j < BATCH_SIZE; ++j) {
+      ssize_t n = recv(ctx->rx, &ctx->rx_buf[j][0], DATAGRAM_SIZE, 0);
+      rtems_test_assert(n == DATAGRAM_SIZE);
+    }
+  }
+
+  b = rtems_counter_read();
+
+  return rtems_counter_difference(b, a);
+}
+
+static rtems_counter_ticks measure_vector(test_context *ctx)
+{
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  size_t i;
+
+  a = rtems_counter_read();
+
+  for (i = 0; i < BATCHES; ++i) {
+    ssize_t n;
+
+    n = sendmmsg(ctx->tx, &ctx->tx_msg[0], BATCH_SIZE, 0);
+    rtems_test_assert(n == BATCH_SIZE);
+
+    n = recvmmsg(ctx->rx, &ctx->rx_msg[0], BATCH_SIZE, 0, NULL);
+    rtems_test_assert(n == BATCH_SIZE);
+  }
+
+  b = rtems_counter_read();
+
+  return rtems_counter_difference(b, a);
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  rtems_counter_ticks single;
+  rtems_counter_ticks vector;
+  int rv;
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  open_sockets(ctx);
+  init_messages(ctx);
+  test_vector(ctx);
+
+  single = measure_single(ctx);
+  vector = measure_vector(ctx);
+
+  printf(
+    "<MmsgTest datagramSize=\"%i\" batchSize=\"%i\" batches=\"%i\">\n"
+    "  <Single unit=\"ns\">%" PRIu64 "</Single>\n"
+    "  <Vector unit=\"ns\">%" PRIu64 "</Vector>\n"
+    "</MmsgTest>\n",
+    DATAGRAM_SIZE,
+    BATCH_SIZE,
+    BATCHES,
+    rtems_counter_ticks_to_nanoseconds(single),
+    rtems_counter_ticks_to_nanoseconds(vector)
+  );
+
+  rv = close(ctx->tx);
+  rtems_test_assert(rv == 0);
+
+  rv = close(ctx->rx);
+  rtems_test_assert(rv == 0);
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST MMSG 1 ***");
+  test();
+  puts("*** END OF TEST MMSG 1 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_MICROSECONDS_PER_TICK 10000
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 6
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+#define CONFIGURE_MAXIMUM_SEMAPHORES 2
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,398 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+/* The test acts as an Ethernet driver */
+#ifndef _KERNEL
+#define _KERNEL
+#endif
+
+#include <rtems/rtems_bsdnet.h>
+#include <sys/param.h>
+#include <sys/mbuf.h>
+#include <sys/sockio.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <net/ethernet.h>
+#include <netinet/in_systm.h>
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define PORT 5002
+
+#define BATCH_SIZE 32
+
+#define INPUT_BUDGET 4
+
+#define LOCAL_ADDR "10.1.1.1"
+
+#define REMOTE_ADDR "10.1.1.2"
+
+typedef struct {
+  struct arpcom arpcom;
+  int rx;
+  uint32_t seq;
+  struct mbuf *batch;
+  rtems_id timer;
+  rtems_id master;
+} test_context;
+
+static test_context test_instance;
+
+static const u_char local_enaddr[ETHER_ADDR_LEN] =
+  { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+static const u_char remote_enaddr[ETHER_ADDR_LEN] =
+  { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+static void fake_init(void *arg)
+{
+  test_context *ctx = arg;
+
+  ctx->arpcom.ac_if.if_flags |= IFF_RUNNING;
+}
+
+static void fake_start(struct ifnet *ifp)
+{
+  struct mbuf *m;
+
+  /* Nothing is transmitted, for example gratuitous ARP requests */
+  while (true) {
+    IF_DEQUEUE(&ifp->if_snd, m);
+    if (m == NULL) {
+      break;
+    }
+
+    m_freem(m);
+  }
+}
+
+static int fake_ioctl(struct ifnet *ifp, ioctl_command_t command, caddr_t data)
+{
+  int error = 0;
+
+  switch (command) {
+    case SIOCGIFADDR:
+    case SIOCSIFADDR:
+      ether_ioctl(ifp, command, data);
+      break;
+    case SIOCSIFFLAGS:
+      if ((ifp->if_flags & IFF_UP) != 0) {
+        fake_init(ifp->if_softc);
+      } else {
+        ifp->if_flags &= ~IFF_RUNNING;
+      }
+      break;
+    default:
+      error = EINVAL;
+      break;
+  }
+
+  return error;
+}
+
+static int fake_attach(struct rtems_bsdnet_ifconfig *config, int attaching)
+{
+  test_context *ctx = &test_instance;
+  struct ifnet *ifp = &ctx->arpcom.ac_if;
+  char *unit_name;
+  int unit_number;
+
+  rtems_test_assert(attaching);
+
+  unit_number = rtems_bsdnet_parse_driver_name(config, &unit_name);
+  rtems_test_assert(unit_number >= 0);
+
+  memcpy(ctx->arpcom.ac_enaddr, local_enaddr, ETHER_ADDR_LEN);
+
+  ifp->if_softc = ctx;
+  ifp->if_unit = (short) unit_number;
+  ifp->if_name = unit_name;
+  ifp->if_mtu = ETHERMTU;
+  ifp->if_init = fake_init;
+  ifp->if_ioctl = fake_ioctl;
+  ifp->if_start = fake_start;
+  ifp->if_output = ether_output;
+  ifp->if_flags = IFF_BROADCAST | IFF_SIMPLEX;
+  ifp->if_snd.ifq_maxlen = ifqmaxlen;
+
+  if_attach(ifp);
+  ether_ifattach(ifp);
+
+  return 1;
+}
+
+static struct rtems_bsdnet_ifconfig fake_ifconfig = {
+  .name = "fake1",
+  .attach = fake_attach,
+  .ip_address = LOCAL_ADDR,
+  .ip_netmask = "255.255.255.0"
+};
+
+struct rtems_bsdnet_config rtems_bsdnet_config = {
+  .ifconfig = &fake_ifconfig,
+  .network_input_budget = INPUT_BUDGET
+};
+
+static u_short ip_header_cksum(const struct ip *ip)
+{
+  const u_short *p = (const u_short *) ip;
+  uint32_t sum = 0;
+  size_t i;
+
+  for (i = 0; i < sizeof(*ip) / sizeof(*p); ++i) {
+    sum += p[i];
+  }
+
+  while ((sum >> 16) != 0) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+
+  return (u_short) ~sum;
+}
+
+/*
+ * Returns a UDP datagram to PORT carrying a sequence number in an Ethernet
+ * frame as a driver would receive it.  The network semaphore must be held.
+ */
+static struct mbuf *new_frame(test_context *ctx)
+{
+  struct ether_header eh;
+  struct ip ip;
+  struct udphdr uh;
+  uint32_t seq;
+  struct mbuf *m;
+  char *p;
+
+  memset(&eh, 0, sizeof(eh));
+  memcpy(eh.ether_dhost, local_enaddr, ETHER_ADDR_LEN);
+  memcpy(eh.ether_shost, remote_enaddr, ETHER_ADDR_LEN);
+  eh.ether_type = htons(ETHERTYPE_IP);
+
+  memset(&ip, 0, sizeof(ip));
+  ip.ip_v = IPVERSION;
+  ip.ip_hl = sizeof(ip) >> 2;
+  ip.ip_len = htons(sizeof(ip) + sizeof(uh) + sizeof(seq));
+  ip.ip_ttl = 64;
+  ip.ip_p = IPPROTO_UDP;
+  ip.ip_src.s_addr = inet_addr(REMOTE_ADDR);
+  ip.ip_dst.s_addr = inet_addr(LOCAL_ADDR);
+  ip.ip_sum = ip_header_cksum(&ip);
+
+  /* A zero UDP checksum means no checksum */
+  memset(&uh, 0, sizeof(uh));
+  uh.uh_sport = htons(PORT);
+  uh.uh_dport = htons(PORT);
+  uh.uh_ulen = htons(sizeof(uh) + sizeof(seq));
+
+  seq = htonl(ctx->seq);
+  ++ctx->seq;
+
+  MGETHDR(m, M_WAIT, MT_DATA);
+  rtems_test_assert(m != NULL);
+
+  /* Keep the IP header aligned like drivers do */
+  m->m_data += 2;
+  p = mtod(m, char *);
+  memcpy(p, &eh, sizeof(eh));
+  p += sizeof(eh);
+  memcpy(p, &ip, sizeof(ip));
+  p += sizeof(ip);
+  memcpy(p, &uh, sizeof(uh));
+  p += sizeof(uh);
+  memcpy(p, &seq, sizeof(seq));
+  p += sizeof(seq);
+
+  m->m_len = p - mtod(m, char *);
+  m->m_pkthdr.len = m->m_len;
+  m->m_pkthdr.rcvif = &ctx->arpcom.ac_if;
+
+  return m;
+}
+
+static struct mbuf *new_batch(test_context *ctx)
+{
+  struct mbuf *head = NULL;
+  struct mbuf **next = &head;
+  int i;
+
+  rtems_bsdnet_semaphore_obtain();
+
+  for (i = 0; i < BATCH_SIZE; ++i) {
+    *next = new_frame(ctx);
+    next = &(*next)->m_nextpkt;
+  }
+
+  rtems_bsdnet_semaphore_release();
+
+  return head;
+}
+
+static void receive_batch(test_context *ctx)
+{
+  uint32_t first = ctx->seq - BATCH_SIZE;
+  int i;
+
+  for (i = 0; i < BATCH_SIZE; ++i) {
+    uint32_t seq;
+    ssize_t n;
+
+    n = recv(ctx->rx, &seq, sizeof(seq), 0);
+    rtems_test_assert(n == (ssize_t) sizeof(seq));
+    rtems_test_assert(ntohl(seq) == first + (uint32_t) i);
+  }
+}
+
+static void open_socket(test_context *ctx)
+{
+  struct sockaddr_in addr;
+  int size = 32 * 1024;
+  int rv;
+
+  ctx->rx = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(ctx->rx >= 0);
+
+  rv = setsockopt(ctx->rx, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+  rtems_test_assert(rv == 0);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+  rv = bind(ctx->rx, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+}
+
+static void test_batch_input(test_context *ctx)
+{
+  struct mbuf *batch = new_batch(ctx);
+
+  /* Driver running in the network daemon context */
+  rtems_bsdnet_semaphore_obtain();
+  ether_input_batch(batch);
+  rtems_bsdnet_semaphore_release();
+
+  receive_batch(ctx);
+}
+
+static void test_defer_input_from_task(test_context *ctx)
+{
+  struct mbuf *batch = new_batch(ctx);
+
+  rtems_bsdnet_defer_input(batch);
+  receive_batch(ctx);
+}
+
+static rtems_timer_service_routine defer_input_from_isr(
+  rtems_id timer,
+  void *arg
+)
+{
+  test_context *ctx = arg;
+  rtems_status_code sc;
+
+  rtems_test_assert(rtems_interrupt_is_in_progress());
+
+  rtems_bsdnet_defer_input(ctx->batch);
+  ctx->batch = NULL;
+
+  sc = rtems_event_transient_send(ctx->master);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void test_defer_input_from_isr(test_context *ctx)
+{
+  rtems_status_code sc;
+
+  ctx->batch = new_batch(ctx);
+
+  sc = rtems_timer_fire_after(ctx->timer, 1, defer_input_from_isr, ctx);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(ctx->batch == NULL);
+
+  receive_batch(ctx);
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  rtems_status_code sc;
+  int rv;
+
+  ctx->master = rtems_task_self();
+
+  sc = rtems_timer_create(rtems_build_name('D', 'F', 'E', 'R'), &ctx->timer);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  open_socket(ctx);
+
+  test_batch_input(ctx);
+  test_defer_input_from_task(ctx);
+  test_defer_input_from_isr(ctx);
+
+  /* Every received frame was counted by the interface */
+  rtems_test_assert(ctx->arpcom.ac_if.if_ibytes == 3 * BATCH_SIZE * (
+    sizeof(struct ether_header) + sizeof(struct ip) + sizeof(struct udphdr)
+      + sizeof(uint32_t)
+  ));
+
+  rv = close(ctx->rx);
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_timer_delete(ctx->timer);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST NETINPUT 1 ***");
+  test();
+  puts("*** END OF TEST NETINPUT 1 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_MICROSECONDS_PER_TICK 10000
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 5
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+#define CONFIGURE_MAXIMUM_SEMAPHORES 2
+#define CONFIGURE_MAXIMUM_TIMERS 1
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
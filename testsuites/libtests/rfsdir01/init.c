@@ -0,0 +1,291 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/counter.h>
+#include <rtems/libio.h>
+#include <rtems/ramdisk.h>
+#include <rtems/rtems-rfs-format.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define FILES 1000
+
+static const char rda[] = "/dev/rda";
+
+static const char mnt[] = "/mnt";
+
+static const char dir[] = "/mnt/dir";
+
+static char path[64];
+
+static const char *file_path(int i)
+{
+  snprintf(&path[0], sizeof(path), "%s/f%04x", dir, i);
+  return &path[0];
+}
+
+static uint64_t since(rtems_counter_ticks a)
+{
+  rtems_counter_ticks b = rtems_counter_read();
+
+  return rtems_counter_ticks_to_nanoseconds(rtems_counter_difference(b, a));
+}
+
+static void check_readdir(int expected)
+{
+  DIR *d;
+  struct dirent *de;
+  int n = 0;
+  int rv;
+
+  d = opendir(dir);
+  rtems_test_assert(d != NULL);
+
+  while ((de = readdir(d)) != NULL) {
+    if (strcmp(de->d_name, ".") != 0 && strcmp(de->d_name, "..") != 0) {
+      rtems_test_assert(de->d_name[0] == 'f');
+      ++n;
+    }
+  }
+
+  rv = closedir(d);
+  rtems_test_assert(rv == 0);
+
+  rtems_test_assert(n == expected);
+}
+
+static void format(bool dir_index)
+{
+  rtems_rfs_format_config config;
+  int rv;
+
+  memset(&config, 0, sizeof(config));
+  config.group_inodes = 2 * FILES;
+  config.dir_index = dir_index;
+
+  rv = rtems_rfs_format(rda, &config);
+  rtems_test_assert(rv == 0);
+}
+
+static void do_mount(void)
+{
+  int rv;
+
+  rv = mount(rda, mnt, RTEMS_FILESYSTEM_TYPE_RFS, RTEMS_FILESYSTEM_READ_WRITE, NULL);
+  rtems_test_assert(rv == 0);
+}
+
+static void do_unmount(void)
+{
+  int rv;
+
+  rv = unmount(mnt);
+  rtems_test_assert(rv == 0);
+}
+
+/*
+ * The directory entries must be found through the directory as it was
+ * written to the media and not only through state held by the mounted
+ * instance.
+ */
+static void test_remount(bool dir_index)
+{
+  struct stat st;
+  int rv;
+  int i;
+
+  format(dir_index);
+  do_mount();
+
+  rv = mkdir(dir, S_IRWXU);
+  rtems_test_assert(rv == 0);
+
+  for (i = 0; i < FILES; ++i) {
+    rv = mknod(file_path(i), S_IFREG | S_IRWXU, 0);
+    rtems_test_assert(rv == 0);
+  }
+
+  do_unmount();
+  do_mount();
+
+  check_readdir(FILES);
+
+  for (i = 0; i < FILES; ++i) {
+    rv = stat(file_path(i), &st);
+    rtems_test_assert(rv == 0);
+    rtems_test_assert(S_ISREG(st.st_mode));
+  }
+
+  for (i = FILES; i < 2 * FILES; ++i) {
+    errno = 0;
+    rv = stat(file_path(i), &st);
+    rtems_test_assert(rv == -1);
+    rtems_test_assert(errno == ENOENT);
+  }
+
+  for (i = 0; i < FILES; ++i) {
+    rv = unlink(file_path(i));
+    rtems_test_assert(rv == 0);
+  }
+
+  check_readdir(0);
+
+  do_unmount();
+  do_mount();
+
+  check_readdir(0);
+
+  rv = rmdir(dir);
+  rtems_test_assert(rv == 0);
+
+  do_unmount();
+}
+
+static void test_variant(const char *name, bool dir_index)
+{
+  rtems_counter_ticks a;
+  uint64_t create;
+  uint64_t lookup;
+  uint64_t miss;
+  uint64_t remove;
+  struct stat st;
+  int rv;
+  int i;
+
+  format(dir_index);
+  do_mount();
+
+  rv = mkdir(dir, S_IRWXU);
+  rtems_test_assert(rv == 0);
+
+  a = rtems_counter_read();
+  for (i = 0; i < FILES; ++i) {
+    rv = mknod(file_path(i), S_IFREG | S_IRWXU, 0);
+    rtems_test_assert(rv == 0);
+  }
+  create = since(a);
+
+  check_readdir(FILES);
+
+  a = rtems_counter_read();
+  for (i = 0; i < FILES; ++i) {
+    rv = stat(file_path(i), &st);
+    rtems_test_assert(rv == 0);
+    rtems_test_assert(S_ISREG(st.st_mode));
+  }
+  lookup = since(a);
+
+  a = rtems_counter_read();
+  for (i = FILES; i < 2 * FILES; ++i) {
+    errno = 0;
+    rv = stat(file_path(i), &st);
+    rtems_test_assert(rv == -1);
+    rtems_test_assert(errno == ENOENT);
+  }
+  miss = since(a);
+
+  a = rtems_counter_read();
+  for (i = 0; i < FILES; i += 2) {
+    rv = unlink(file_path(i));
+    rtems_test_assert(rv == 0);
+  }
+  remove = since(a);
+
+  check_readdir(FILES / 2);
+
+  for (i = 1; i < FILES; i += 2) {
+    rv = stat(file_path(i), &st);
+    rtems_test_assert(rv == 0);
+    rv = unlink(file_path(i));
+    rtems_test_assert(rv == 0);
+  }
+
+  rv = rmdir(dir);
+  rtems_test_assert(rv == 0);
+
+  do_unmount();
+
+  printf(
+    "  <%s>\n"
+    "    <Create unit=\"ns\">%" PRIu64 "</Create>\n"
+    "    <Lookup unit=\"ns\">%" PRIu64 "</Lookup>\n"
+    "    <LookupMiss unit=\"ns\">%" PRIu64 "</LookupMiss>\n"
+    "    <Remove unit=\"ns\">%" PRIu64 "</Remove>\n"
+    "  </%s>\n",
+    name,
+    create,
+    lookup,
+    miss,
+    remove,
+    name
+  );
+}
+
+static void test(void)
+{
+  int rv;
+
+  rv = mkdir(mnt, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  printf("<RFSDirTest files=\"%i\">\n", FILES);
+  test_variant("Linear", false);
+  test_variant("Indexed", true);
+  printf("</RFSDirTest>\n");
+
+  test_remount(false);
+  test_remount(true);
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST RFSDIR 1 ***");
+  test();
+  puts("*** END OF TEST RFSDIR 1 ***");
+
+  rtems_test_exit(0);
+}
+
+rtems_ramdisk_config rtems_ramdisk_configuration[] = {
+  { .block_size = 512, .block_num = 2048 }
+};
+
+size_t rtems_ramdisk_configuration_size = 1;
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_EXTRA_DRIVERS RAMDISK_DRIVER_TABLE_ENTRY
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 5
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+#define CONFIGURE_FILESYSTEM_RFS
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (16 * 1024)
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,333 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/libio_.h>
+#include <rtems/ramdisk.h>
+#include <rtems/rtems-rfs-format.h>
+#include <rtems/rfs/rtems-rfs-block.h>
+#include <rtems/rfs/rtems-rfs-inode.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define WRITERS 2
+
+#define CHUNK_SIZE 512
+
+#define CHUNKS 128
+
+#define PRIO_HIGH 2
+
+#define PRIO_LOW 3
+
+typedef struct {
+  rtems_id master;
+  rtems_id writer[WRITERS];
+  uint8_t buf[WRITERS][CHUNK_SIZE];
+  uint8_t check[CHUNK_SIZE];
+} test_context;
+
+static test_context test_instance;
+
+static const rtems_rfs_format_config rfs_block_map_config;
+
+static const rtems_rfs_format_config rfs_extents_config = {
+  .extents = true
+};
+
+static const char rda[] = "/dev/rda";
+
+static const char mnt[] = "/mnt";
+
+static const char *const files[WRITERS] = {
+  "/mnt/a",
+  "/mnt/b"
+};
+
+static void fill(test_context *ctx, int w)
+{
+  size_t i;
+
+  for (i = 0; i < CHUNK_SIZE; ++i) {
+    ctx->buf[w][i] = (uint8_t) (i * (w + 5) + w);
+  }
+}
+
+static void writer(rtems_task_argument arg)
+{
+  test_context *ctx = &test_instance;
+  int w = (int) arg;
+  rtems_status_code sc;
+  int fd;
+  int i;
+  int rv;
+
+  fd = open(files[w], O_WRONLY | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  for (i = 0; i < CHUNKS; ++i) {
+    ssize_t n = write(fd, &ctx->buf[w][0], CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+
+    if (i == CHUNKS / 2) {
+      rv = fsync(fd);
+      rtems_test_assert(rv == 0);
+    }
+
+    rtems_task_wake_after(RTEMS_YIELD_PROCESSOR);
+  }
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_event_transient_send(ctx->master);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_task_suspend(RTEMS_SELF);
+  rtems_test_assert(0);
+}
+
+static void start_writer(test_context *ctx, int w)
+{
+  rtems_status_code sc;
+
+  sc = rtems_task_create(
+    rtems_build_name('W', 'R', 'T', '0' + w),
+    PRIO_LOW,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &ctx->writer[w]
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(ctx->writer[w], writer, (rtems_task_argument) w);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void read_back(test_context *ctx, int w, int chunks)
+{
+  int fd;
+  int i;
+  int rv;
+
+  fd = open(files[w], O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  for (i = 0; i < chunks; ++i) {
+    ssize_t n = read(fd, &ctx->check[0], CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+    rtems_test_assert(memcmp(&ctx->check[0], &ctx->buf[w][0], CHUNK_SIZE) == 0);
+  }
+
+  rv = read(fd, &ctx->check[0], CHUNK_SIZE);
+  rtems_test_assert(rv == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+/*
+ * Count the runs of contiguous blocks in the block map of the file.  The
+ * delayed blocks are allocated as a run when they are flushed.  A run may be
+ * split once by a run of the other writer and the fsync() in the writer adds
+ * a flush.  An extent map holds exactly one extent per run.
+ */
+static void check_fragments(int w, bool extents, uint32_t delayed)
+{
+  rtems_rfs_file_system *fs;
+  rtems_rfs_inode_handle inode;
+  rtems_rfs_block_map map;
+  rtems_rfs_buffer_block last = 0;
+  struct stat st;
+  uint32_t i;
+  uint32_t n = 0;
+  int fd;
+  int rv;
+
+  rv = stat(files[w], &st);
+  rtems_test_assert(rv == 0);
+
+  fd = open(mnt, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  fs = rtems_libio_iop(fd)->pathinfo.mt_entry->fs_info;
+
+  rv = rtems_rfs_inode_open(fs, st.st_ino, &inode, true);
+  rtems_test_assert(rv == 0);
+
+  rtems_test_assert(
+    ((rtems_rfs_inode_get_flags(&inode) & RTEMS_RFS_INODE_FLAG_EXTENTS) != 0)
+      == extents
+  );
+
+  rv = rtems_rfs_block_map_open(fs, &inode, &map);
+  rtems_test_assert(rv == 0);
+
+  for (i = 0; i < rtems_rfs_block_map_count(&map); ++i) {
+    rtems_rfs_block_pos bpos;
+    rtems_rfs_buffer_block block;
+
+    rtems_rfs_block_set_bpos_zero(&bpos);
+    bpos.bno = i;
+
+    rv = rtems_rfs_block_map_find(fs, &map, &bpos, &block);
+    rtems_test_assert(rv == 0);
+
+    if (i == 0 || block != last + 1) {
+      ++n;
+    }
+
+    last = block;
+  }
+
+  rtems_test_assert(n > 0);
+
+  if (extents) {
+    rtems_test_assert(
+      rtems_rfs_inode_get_block(&inode, RTEMS_RFS_INODE_BLOCKS - 1) == n
+    );
+  }
+
+  if (delayed > 0) {
+    uint32_t runs = (rtems_rfs_block_map_count(&map) + delayed - 1) / delayed;
+
+    rtems_test_assert(n <= 2 * (runs + 1));
+  }
+
+  rv = rtems_rfs_block_map_close(fs, &map);
+  rtems_test_assert(rv == 0);
+
+  rv = rtems_rfs_inode_close(fs, &inode);
+  rtems_test_assert(rv == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void run(
+  test_context *ctx,
+  const rtems_rfs_format_config *config,
+  const char *options,
+  uint32_t delayed
+)
+{
+  rtems_status_code sc;
+  int rv;
+  int w;
+
+  rv = rtems_rfs_format(rda, config);
+  rtems_test_assert(rv == 0);
+
+  rv = mount(rda, mnt, RTEMS_FILESYSTEM_TYPE_RFS, RTEMS_FILESYSTEM_READ_WRITE, options);
+  rtems_test_assert(rv == 0);
+
+  for (w = 0; w < WRITERS; ++w) {
+    start_writer(ctx, w);
+  }
+
+  for (w = 0; w < WRITERS; ++w) {
+    sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  for (w = 0; w < WRITERS; ++w) {
+    sc = rtems_task_delete(ctx->writer[w]);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  for (w = 0; w < WRITERS; ++w) {
+    read_back(ctx, w, CHUNKS);
+    check_fragments(w, config->extents, delayed);
+
+    rv = truncate(files[w], (CHUNKS / 2) * CHUNK_SIZE);
+    rtems_test_assert(rv == 0);
+
+    read_back(ctx, w, CHUNKS / 2);
+    check_fragments(w, config->extents, 0);
+  }
+
+  for (w = 0; w < WRITERS; ++w) {
+    rv = unlink(files[w]);
+    rtems_test_assert(rv == 0);
+  }
+
+  rv = unmount(mnt);
+  rtems_test_assert(rv == 0);
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  rtems_status_code sc;
+  rtems_task_priority prio;
+  int rv;
+  int w;
+
+  ctx->master = rtems_task_self();
+
+  sc = rtems_task_set_priority(RTEMS_SELF, PRIO_HIGH, &prio);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  for (w = 0; w < WRITERS; ++w) {
+    fill(ctx, w);
+  }
+
+  rv = mkdir(mnt, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  run(ctx, &rfs_extents_config, NULL, RTEMS_RFS_FS_DELAYED_BLOCKS);
+  run(ctx, &rfs_extents_config, "delayed-blocks=0", 0);
+  run(ctx, &rfs_block_map_config, NULL, RTEMS_RFS_FS_DELAYED_BLOCKS);
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST RFSEXT 1 ***");
+  test();
+  puts("*** END OF TEST RFSEXT 1 ***");
+
+  rtems_test_exit(0);
+}
+
+rtems_ramdisk_config rtems_ramdisk_configuration[] = {
+  { .block_size = 512, .block_num = 4096 }
+};
+
+size_t rtems_ramdisk_configuration_size = 1;
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_EXTRA_DRIVERS RAMDISK_DRIVER_TABLE_ENTRY
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+#define CONFIGURE_FILESYSTEM_RFS
+
+#define CONFIGURE_MAXIMUM_TASKS (1 + WRITERS)
+
+#define CONFIGURE_EXTRA_TASK_STACKS (8 * 1024)
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (16 * 1024)
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,299 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/counter.h>
+#include <rtems/libio.h>
+#include <rtems/ramdisk.h>
+#include <rtems/rtems-rfs-format.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define DEPTH 16
+
+#define FILES 8
+
+#define SAMPLES 100
+
+static const rtems_rfs_format_config rfs_config;
+
+static const char rda[] = "/dev/rda";
+
+static const char mnt[] = "/mnt";
+
+static char path[DEPTH * 4 + 32];
+
+static void make_tree(void)
+{
+  size_t len;
+  int rv;
+  int i;
+
+  strcpy(&path[0], mnt);
+
+  for (i = 0; i < DEPTH; ++i) {
+    len = strlen(&path[0]);
+    snprintf(&path[len], sizeof(path) - len, "/d%x", i);
+    rv = mkdir(&path[0], S_IRWXU);
+    rtems_test_assert(rv == 0);
+  }
+
+  len = strlen(&path[0]);
+
+  for (i = 0; i < FILES; ++i) {
+    snprintf(&path[len], sizeof(path) - len, "/f%x", i);
+    rv = mknod(&path[0], S_IFREG | S_IRWXU, 0);
+    rtems_test_assert(rv == 0);
+  }
+
+  path[len] = '\0';
+}
+
+static void walk(size_t len, bool do_open)
+{
+  int i;
+
+  for (i = 0; i < FILES; ++i) {
+    struct stat st;
+    int rv;
+
+    snprintf(&path[len], sizeof(path) - len, "/f%x", i);
+
+    if (do_open) {
+      int fd = open(&path[0], O_RDONLY);
+      rtems_test_assert(fd >= 0);
+
+      rv = close(fd);
+      rtems_test_assert(rv == 0);
+    } else {
+      rv = stat(&path[0], &st);
+      rtems_test_assert(rv == 0);
+      rtems_test_assert(S_ISREG(st.st_mode));
+    }
+  }
+
+  path[len] = '\0';
+}
+
+static uint64_t measure(bool do_open)
+{
+  size_t len = strlen(&path[0]);
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  int i;
+
+  /* Warm up the caches */
+  walk(len, do_open);
+
+  a = rtems_counter_read();
+
+  for (i = 0; i < SAMPLES; ++i) {
+    walk(len, do_open);
+  }
+
+  b = rtems_counter_read();
+
+  return rtems_counter_ticks_to_nanoseconds(rtems_counter_difference(b, a));
+}
+
+static void do_mount(const char *options)
+{
+  int rv;
+
+  rv = mount(rda, mnt, RTEMS_FILESYSTEM_TYPE_RFS, RTEMS_FILESYSTEM_READ_WRITE, options);
+  rtems_test_assert(rv == 0);
+}
+
+static void do_unmount(void)
+{
+  int rv;
+
+  rv = unmount(mnt);
+  rtems_test_assert(rv == 0);
+}
+
+static void write_files(void)
+{
+  size_t len = strlen(&path[0]);
+  int i;
+
+  for (i = 0; i < FILES; ++i) {
+    char buf[32];
+    ssize_t n;
+    int fd;
+    int rv;
+
+    snprintf(&path[len], sizeof(path) - len, "/f%x", i);
+    snprintf(&buf[0], sizeof(buf), "%s", &path[0]);
+
+    fd = open(&path[0], O_WRONLY | O_TRUNC);
+    rtems_test_assert(fd >= 0);
+
+    n = write(fd, &buf[0], sizeof(buf));
+    rtems_test_assert(n == (ssize_t) sizeof(buf));
+
+    /* Modify the inode through the open file */
+    rv = fchmod(fd, S_IRUSR | S_IWUSR);
+    rtems_test_assert(rv == 0);
+
+    rv = fsync(fd);
+    rtems_test_assert(rv == 0);
+
+    rv = close(fd);
+    rtems_test_assert(rv == 0);
+  }
+
+  path[len] = '\0';
+
+  sync();
+}
+
+static void verify_files(void)
+{
+  size_t len = strlen(&path[0]);
+  int i;
+
+  for (i = 0; i < FILES; ++i) {
+    char expected[32];
+    char buf[32];
+    struct stat st;
+    ssize_t n;
+    int fd;
+    int rv;
+
+    snprintf(&path[len], sizeof(path) - len, "/f%x", i);
+    memset(&expected[0], 0, sizeof(expected));
+    snprintf(&expected[0], sizeof(expected), "%s", &path[0]);
+
+    rv = stat(&path[0], &st);
+    rtems_test_assert(rv == 0);
+    rtems_test_assert(st.st_size == (off_t) sizeof(buf));
+    rtems_test_assert(
+      (st.st_mode & ~S_IFMT) == (S_IRUSR | S_IWUSR)
+    );
+
+    fd = open(&path[0], O_RDONLY);
+    rtems_test_assert(fd >= 0);
+
+    n = read(fd, &buf[0], sizeof(buf));
+    rtems_test_assert(n == (ssize_t) sizeof(buf));
+    rtems_test_assert(memcmp(&buf[0], &expected[0], sizeof(buf)) == 0);
+
+    rv = close(fd);
+    rtems_test_assert(rv == 0);
+  }
+
+  path[len] = '\0';
+}
+
+/*
+ * Modified inodes must reach the media through the cache.  Write and sync
+ * the files, then verify them after a remount which starts with an empty
+ * cache.
+ */
+static void test_remount(const char *options)
+{
+  do_mount(options);
+  write_files();
+  do_unmount();
+
+  do_mount(options);
+  verify_files();
+  do_unmount();
+}
+
+static void test_variant(const char *name, const char *options)
+{
+  do_mount(options);
+
+  printf(
+    "  <%s>\n"
+    "    <Stat unit=\"ns\">%" PRIu64 "</Stat>\n"
+    "    <Open unit=\"ns\">%" PRIu64 "</Open>\n"
+    "  </%s>\n",
+    name,
+    measure(false),
+    measure(true),
+    name
+  );
+
+  do_unmount();
+}
+
+static void test(void)
+{
+  int rv;
+
+  rv = mkdir(mnt, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  rv = rtems_rfs_format(rda, &rfs_config);
+  rtems_test_assert(rv == 0);
+
+  do_mount(NULL);
+  make_tree();
+  do_unmount();
+
+  printf(
+    "<RFSInodeTest depth=\"%i\" files=\"%i\" samples=\"%i\">\n",
+    DEPTH,
+    FILES,
+    SAMPLES
+  );
+  test_variant("InodeCache", NULL);
+  test_variant("NoInodeCache", "no-inode-cache");
+  printf("</RFSInodeTest>\n");
+
+  test_remount(NULL);
+  test_remount("no-inode-cache");
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST RFSINODE 1 ***");
+  test();
+  puts("*** END OF TEST RFSINODE 1 ***");
+
+  rtems_test_exit(0);
+}
+
+rtems_ramdisk_config rtems_ramdisk_configuration[] = {
+  { .block_size = 512, .block_num = 1024 }
+};
+
+size_t rtems_ramdisk_configuration_size = 1;
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_EXTRA_DRIVERS RAMDISK_DRIVER_TABLE_ENTRY
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 5
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+#define CONFIGURE_FILESYSTEM_RFS
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (16 * 1024)
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,312 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/libio.h>
+#include <rtems/ramdisk.h>
+#include <rtems/rtems-rfs-format.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define WRITERS 2
+
+#define CHUNK_SIZE (32 * 1024)
+
+#define CHUNKS 8
+
+#define SAMPLES 100
+
+#define PRIO_HIGH 2
+
+#define PRIO_LOW 3
+
+typedef struct {
+  rtems_id master;
+  rtems_id writer[WRITERS];
+  volatile bool stop;
+  uint8_t buf[WRITERS][CHUNK_SIZE];
+  uint8_t check[CHUNK_SIZE];
+} test_context;
+
+static test_context test_instance;
+
+static const rtems_rfs_format_config rfs_config;
+
+static const char rda[] = "/dev/rda";
+
+static const char mnt[] = "/mnt";
+
+static const char *const files[WRITERS] = {
+  "/mnt/a",
+  "/mnt/b"
+};
+
+static const char probe[] = "/mnt/probe";
+
+static void fill(test_context *ctx, int w)
+{
+  size_t i;
+
+  for (i = 0; i < CHUNK_SIZE; ++i) {
+    ctx->buf[w][i] = (uint8_t) (i * (w + 3) + w);
+  }
+}
+
+static void write_chunks(test_context *ctx, int w, bool yield)
+{
+  int fd;
+  int i;
+  int rv;
+
+  fd = open(files[w], O_WRONLY | O_CREAT | O_TRUNC, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  for (i = 0; i < CHUNKS; ++i) {
+    ssize_t n = write(fd, &ctx->buf[w][0], CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+
+    if (yield) {
+      rtems_task_wake_after(RTEMS_YIELD_PROCESSOR);
+    }
+  }
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void verify(test_context *ctx, int w)
+{
+  struct stat st;
+  int fd;
+  int i;
+  int rv;
+
+  rv = stat(files[w], &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == CHUNKS * CHUNK_SIZE);
+
+  fd = open(files[w], O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  for (i = 0; i < CHUNKS; ++i) {
+    ssize_t n = read(fd, &ctx->check[0], CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+    rtems_test_assert(memcmp(&ctx->check[0], &ctx->buf[w][0], CHUNK_SIZE) == 0);
+  }
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void parallel_writer(rtems_task_argument arg)
+{
+  test_context *ctx = &test_instance;
+  int w = (int) arg;
+  rtems_status_code sc;
+
+  write_chunks(ctx, w, true);
+
+  sc = rtems_event_transient_send(ctx->master);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_task_suspend(RTEMS_SELF);
+  rtems_test_assert(0);
+}
+
+static void background_writer(rtems_task_argument arg)
+{
+  test_context *ctx = &test_instance;
+  int w = (int) arg;
+  rtems_status_code sc;
+
+  while (!ctx->stop) {
+    write_chunks(ctx, w, false);
+  }
+
+  sc = rtems_event_transient_send(ctx->master);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_task_suspend(RTEMS_SELF);
+  rtems_test_assert(0);
+}
+
+static void start_writer(
+  test_context *ctx,
+  int w,
+  rtems_task_entry entry,
+  rtems_task_priority prio
+)
+{
+  rtems_status_code sc;
+
+  sc = rtems_task_create(
+    rtems_build_name('W', 'R', 'T', '0' + w),
+    prio,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &ctx->writer[w]
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(ctx->writer[w], entry, (rtems_task_argument) w);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void delete_writer(test_context *ctx, int w)
+{
+  rtems_status_code sc;
+
+  sc = rtems_task_delete(ctx->writer[w]);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void test_parallel_writers(test_context *ctx)
+{
+  rtems_status_code sc;
+  int w;
+
+  for (w = 0; w < WRITERS; ++w) {
+    start_writer(ctx, w, parallel_writer, PRIO_LOW);
+  }
+
+  for (w = 0; w < WRITERS; ++w) {
+    sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  for (w = 0; w < WRITERS; ++w) {
+    delete_writer(ctx, w);
+    verify(ctx, w);
+  }
+}
+
+static void probe_files(void)
+{
+  int i;
+
+  for (i = 0; i < SAMPLES; ++i) {
+    struct stat st;
+    int fd;
+    int rv;
+
+    /* Give the background writer the chance to be in the middle of a write */
+    rtems_task_wake_after(1);
+
+    rv = stat(probe, &st);
+    rtems_test_assert(rv == 0);
+    rtems_test_assert(S_ISREG(st.st_mode));
+
+    fd = open(probe, O_RDONLY);
+    rtems_test_assert(fd >= 0);
+
+    rv = close(fd);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+static void test_probe(test_context *ctx)
+{
+  rtems_status_code sc;
+  int rv;
+
+  rv = mknod(probe, S_IFREG | S_IRWXU, 0);
+  rtems_test_assert(rv == 0);
+
+  probe_files();
+
+  ctx->stop = false;
+  start_writer(ctx, 0, background_writer, PRIO_LOW);
+
+  probe_files();
+
+  ctx->stop = true;
+  sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  delete_writer(ctx, 0);
+  verify(ctx, 0);
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  rtems_status_code sc;
+  rtems_task_priority prio;
+  int rv;
+  int w;
+
+  ctx->master = rtems_task_self();
+
+  sc = rtems_task_set_priority(RTEMS_SELF, PRIO_HIGH, &prio);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  for (w = 0; w < WRITERS; ++w) {
+    fill(ctx, w);
+  }
+
+  rv = mkdir(mnt, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  rv = rtems_rfs_format(rda, &rfs_config);
+  rtems_test_assert(rv == 0);
+
+  rv = mount(rda, mnt, RTEMS_FILESYSTEM_TYPE_RFS, RTEMS_FILESYSTEM_READ_WRITE, NULL);
+  rtems_test_assert(rv == 0);
+
+  test_parallel_writers(ctx);
+  test_probe(ctx);
+
+  rv = unmount(mnt);
+  rtems_test_assert(rv == 0);
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST RFSPAR 1 ***");
+  test();
+  puts("*** END OF TEST RFSPAR 1 ***");
+
+  rtems_test_exit(0);
+}
+
+rtems_ramdisk_config rtems_ramdisk_configuration[] = {
+  { .block_size = 512, .block_num = 4096 }
+};
+
+size_t rtems_ramdisk_configuration_size = 1;
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_EXTRA_DRIVERS RAMDISK_DRIVER_TABLE_ENTRY
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+#define CONFIGURE_FILESYSTEM_RFS
+
+#define CONFIGURE_MAXIMUM_TASKS (1 + WRITERS)
+
+#define CONFIGURE_EXTRA_TASK_STACKS (8 * 1024)
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (16 * 1024)
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
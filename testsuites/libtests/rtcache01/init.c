@@ -0,0 +1,205 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/socket.h>
+#include <net/route.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+/* The routing statistics are not exported to applications */
+extern struct rtstat rtstat;
+
+#define PORT 9
+
+#define DATAGRAM_SIZE 16
+
+#define NETWORKS 256
+
+#define FEW_DESTINATIONS 8
+
+#define PACKETS 4096
+
+typedef struct {
+  int s;
+  char buf[DATAGRAM_SIZE];
+} test_context;
+
+static test_context test_instance;
+
+static void init_addr(struct sockaddr_in *addr, uint32_t a)
+{
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_len = sizeof(*addr);
+  addr->sin_family = AF_INET;
+  addr->sin_port = htons(PORT);
+  addr->sin_addr.s_addr = htonl(a);
+}
+
+static uint32_t network(int i)
+{
+  return (UINT32_C(10) << 24) | ((uint32_t) i << 16);
+}
+
+static void add_route(int i)
+{
+  struct sockaddr_in dst;
+  struct sockaddr_in gw;
+  struct sockaddr_in mask;
+  int rv;
+
+  init_addr(&dst, network(i));
+  init_addr(&gw, INADDR_LOOPBACK);
+  init_addr(&mask, UINT32_C(0xffff0000));
+  dst.sin_port = 0;
+  gw.sin_port = 0;
+  mask.sin_port = 0;
+
+  rv = rtems_bsdnet_rtrequest(
+    RTM_ADD,
+    (struct sockaddr *) &dst,
+    (struct sockaddr *) &gw,
+    (struct sockaddr *) &mask,
+    RTF_UP | RTF_GATEWAY | RTF_STATIC,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+}
+
+static void send_to(test_context *ctx, int i)
+{
+  struct sockaddr_in addr;
+  ssize_t n;
+
+  init_addr(&addr, network(i) | 1);
+  n = sendto(
+    ctx->s,
+    &ctx->buf[0],
+    sizeof(ctx->buf),
+    0,
+    (struct sockaddr *) &addr,
+    sizeof(addr)
+  );
+  rtems_test_assert(n == (ssize_t) sizeof(ctx->buf));
+}
+
+static void test_cache(test_context *ctx)
+{
+  u_long hit;
+  u_long miss;
+
+  send_to(ctx, 0);
+  send_to(ctx, 1);
+
+  /* A known destination must hit */
+  hit = rtstat.rts_cachehit;
+  miss = rtstat.rts_cachemiss;
+  send_to(ctx, 0);
+  rtems_test_assert(rtstat.rts_cachehit > hit);
+  rtems_test_assert(rtstat.rts_cachemiss == miss);
+
+  /* A route change must flush the cache */
+  add_route(NETWORKS);
+  miss = rtstat.rts_cachemiss;
+  send_to(ctx, 1);
+  rtems_test_assert(rtstat.rts_cachemiss > miss);
+}
+
+static void test_destinations(
+  test_context *ctx,
+  int destinations,
+  u_long *hit,
+  u_long *miss
+)
+{
+  int i;
+
+  *hit = rtstat.rts_cachehit;
+  *miss = rtstat.rts_cachemiss;
+
+  for (i = 0; i < PACKETS; ++i) {
+    send_to(ctx, i % destinations);
+  }
+
+  *hit = rtstat.rts_cachehit - *hit;
+  *miss = rtstat.rts_cachemiss - *miss;
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  u_long hit;
+  u_long miss;
+  int rv;
+  int i;
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  for (i = 0; i < NETWORKS; ++i) {
+    add_route(i);
+  }
+
+  ctx->s = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(ctx->s >= 0);
+
+  test_cache(ctx);
+
+  /* The few destinations fit into the cache */
+  test_destinations(ctx, FEW_DESTINATIONS, &hit, &miss);
+  rtems_test_assert(hit > miss);
+
+  /* The many destinations evict each other */
+  test_destinations(ctx, NETWORKS, &hit, &miss);
+  rtems_test_assert(miss > hit);
+
+  rv = close(ctx->s);
+  rtems_test_assert(rv == 0);
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST RTCACHE 1 ***");
+  test();
+  puts("*** END OF TEST RTCACHE 1 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_MICROSECONDS_PER_TICK 10000
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+#define CONFIGURE_MAXIMUM_SEMAPHORES 2
+
+/* Let the network daemon drain the loopback queue after each send */
+#define CONFIGURE_INIT_TASK_PRIORITY 110
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
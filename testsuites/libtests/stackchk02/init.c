@@ -0,0 +1,280 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <string.h>
+
+#include <rtems/stackchk.h>
+
+#define WORKER_STACK_SIZE (4 * RTEMS_MINIMUM_STACK_SIZE)
+
+#define MAXIMUM_WAIT_TICKS 10000
+
+static rtems_id worker_id;
+
+static volatile size_t worker_use;
+
+static uint32_t warning_count;
+
+static uint32_t warning_threshold;
+
+static rtems_stack_checker_usage warning_usage;
+
+static void warning_handler(
+  const rtems_stack_checker_usage *usage,
+  uint32_t threshold
+)
+{
+  /* Ignore the warnings for the other threads */
+  if (usage->id != worker_id) {
+    return;
+  }
+
+  ++warning_count;
+  warning_threshold = threshold;
+  warning_usage = *usage;
+}
+
+static int count_plugin(void *arg, const char *format, ...)
+{
+  uint32_t *calls = arg;
+
+  ++(*calls);
+
+  return 0;
+}
+
+static void use_stack(size_t n)
+{
+  char buf[n];
+  volatile char *p = &buf[0];
+  size_t i;
+
+  for (i = 0; i < n; ++i) {
+    p[i] = (char) i;
+  }
+}
+
+static rtems_task worker_task(rtems_task_argument arg)
+{
+  (void) arg;
+
+  while (true) {
+    rtems_status_code sc;
+    rtems_event_set events;
+
+    sc = rtems_event_receive(
+      RTEMS_EVENT_0,
+      RTEMS_EVENT_ALL | RTEMS_WAIT,
+      RTEMS_NO_TIMEOUT,
+      &events
+    );
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    use_stack(worker_use);
+  }
+}
+
+/*
+ * Wait until the monitor completed a scan cycle which started after the
+ * call.
+ */
+static void wait_for_scan(rtems_id id, rtems_stack_checker_usage *usage)
+{
+  rtems_status_code sc;
+  uint32_t cycles;
+  uint32_t ticks = 0;
+
+  do {
+    sc = rtems_task_wake_after(1);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+    rtems_test_assert(++ticks < MAXIMUM_WAIT_TICKS);
+    sc = rtems_stack_checker_get_usage(id, usage);
+  } while (sc == RTEMS_INVALID_ID);
+
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  cycles = usage->scan_cycles;
+
+  do {
+    sc = rtems_task_wake_after(1);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+    rtems_test_assert(++ticks < MAXIMUM_WAIT_TICKS);
+    sc = rtems_stack_checker_get_usage(id, usage);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  } while (usage->scan_cycles < cycles + 2);
+
+  rtems_test_assert(usage->id == id);
+  rtems_test_assert(usage->used <= usage->size);
+}
+
+static void use_worker_stack(uint32_t size, uint32_t percent)
+{
+  rtems_status_code sc;
+
+  worker_use = ((size_t) size * percent) / 100;
+  sc = rtems_event_send(worker_id, RTEMS_EVENT_0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void test_invalid(void)
+{
+  rtems_stack_checker_monitor_config config;
+  rtems_stack_checker_usage usage;
+  rtems_status_code sc;
+
+  memset(&config, 0, sizeof(config));
+  config.priority = 2;
+  config.period = 1;
+  config.budget = 0;
+
+  sc = rtems_stack_checker_monitor_start(NULL);
+  rtems_test_assert(sc == RTEMS_INVALID_ADDRESS);
+
+  sc = rtems_stack_checker_monitor_start(&config);
+  rtems_test_assert(sc == RTEMS_INVALID_NUMBER);
+
+  config.period = 0;
+  config.budget = 1;
+  sc = rtems_stack_checker_monitor_start(&config);
+  rtems_test_assert(sc == RTEMS_INVALID_NUMBER);
+
+  sc = rtems_stack_checker_get_usage(RTEMS_SELF, NULL);
+  rtems_test_assert(sc == RTEMS_INVALID_ADDRESS);
+
+  sc = rtems_stack_checker_get_usage(RTEMS_SELF, &usage);
+  rtems_test_assert(sc == RTEMS_INCORRECT_STATE);
+
+  sc = rtems_stack_checker_monitor_stop();
+  rtems_test_assert(sc == RTEMS_INCORRECT_STATE);
+}
+
+static void test_monitor(void)
+{
+  rtems_stack_checker_monitor_config config;
+  rtems_stack_checker_usage usage;
+  rtems_status_code sc;
+  uint32_t used;
+  uint32_t calls = 0;
+  uint32_t i;
+
+  sc = rtems_task_create(
+    rtems_build_name('W', 'O', 'R', 'K'),
+    1,
+    WORKER_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &worker_id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(worker_id, worker_task, 0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  memset(&config, 0, sizeof(config));
+  config.priority = 2;
+  config.period = 1;
+  config.budget = 1024;
+  config.thresholds[0] = 50;
+  config.thresholds[1] = 75;
+  config.warning = warning_handler;
+
+  sc = rtems_stack_checker_monitor_start(&config);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_stack_checker_monitor_start(&config);
+  rtems_test_assert(sc == RTEMS_INCORRECT_STATE);
+
+  sc = rtems_stack_checker_get_usage(rtems_build_id(1, 1, 1, 0xffff), &usage);
+  rtems_test_assert(sc == RTEMS_INVALID_ID);
+
+  wait_for_scan(worker_id, &usage);
+  rtems_test_assert(usage.size >= WORKER_STACK_SIZE / 2);
+  rtems_test_assert(usage.used > 0);
+  rtems_test_assert(usage.used < usage.size / 2);
+  rtems_test_assert(usage.peak_count >= 1);
+  rtems_test_assert(warning_count == 0);
+  used = usage.used;
+
+  wait_for_scan(RTEMS_SELF, &usage);
+  rtems_test_assert(usage.id == rtems_task_self());
+
+  puts("worker uses 60 percent of its stack");
+  use_worker_stack(usage.size, 60);
+  wait_for_scan(worker_id, &usage);
+  rtems_test_assert(usage.used > used);
+  rtems_test_assert(usage.peaks[usage.peak_count - 1].used == usage.used);
+  rtems_test_assert(warning_count == 1);
+  rtems_test_assert(warning_threshold == 50);
+  rtems_test_assert(warning_usage.id == worker_id);
+  used = usage.used;
+
+  puts("worker uses 60 percent of its stack again");
+  use_worker_stack(usage.size, 60);
+  wait_for_scan(worker_id, &usage);
+  rtems_test_assert(usage.used == used);
+  rtems_test_assert(warning_count == 1);
+
+  puts("worker uses 85 percent of its stack");
+  use_worker_stack(usage.size, 85);
+  wait_for_scan(worker_id, &usage);
+  rtems_test_assert(usage.used > used);
+  rtems_test_assert(warning_count == 2);
+  rtems_test_assert(warning_threshold == 75);
+  rtems_test_assert(usage.peak_count >= 2);
+
+  for (i = 1; i < usage.peak_count; ++i) {
+    rtems_test_assert(usage.peaks[i - 1].used < usage.peaks[i].used);
+    rtems_test_assert(usage.peaks[i - 1].ticks <= usage.peaks[i].ticks);
+  }
+
+  /*
+   * Two header lines and three outputs for each of the Init, idle, worker and
+   * monitor threads.
+   */
+  rtems_stack_checker_report_usage_with_plugin(&calls, count_plugin);
+  rtems_test_assert(calls >= 2 + 3 * 4);
+
+  sc = rtems_stack_checker_monitor_stop();
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_stack_checker_get_usage(worker_id, &usage);
+  rtems_test_assert(sc == RTEMS_INCORRECT_STATE);
+
+  sc = rtems_task_delete(worker_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  puts("\n\n*** TEST STACK CHECKER 02 ***");
+
+  test_invalid();
+  test_monitor();
+
+  puts("*** END OF TEST STACK CHECKER 02 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_EXTRA_TASK_STACKS WORKER_STACK_SIZE
+
+#define CONFIGURE_STACK_CHECKER_ENABLED
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
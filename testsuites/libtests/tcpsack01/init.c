@@ -0,0 +1,226 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+#include "lossy.h"
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+#define PORT 5001
+
+#define MAXSEG 1024
+
+#define SEGMENTS 256
+
+#define BUFFER_SIZE (64 * 1024)
+
+typedef struct {
+  int listener;
+  int rx;
+  int tx;
+  struct sockaddr_in addr;
+  unsigned char buf[MAXSEG];
+} test_context;
+
+static test_context test_instance;
+
+static unsigned char pattern(size_t offset)
+{
+  return (unsigned char) (offset % 251);
+}
+
+static void open_connection(test_context *ctx)
+{
+  int rv;
+  int size = BUFFER_SIZE;
+  int maxseg = MAXSEG;
+
+  ctx->addr.sin_len = sizeof(ctx->addr);
+  ctx->addr.sin_family = AF_INET;
+  ctx->addr.sin_port = htons(PORT);
+  ctx->addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  ctx->listener = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(ctx->listener >= 0);
+
+  rv = setsockopt(ctx->listener, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+  rtems_test_assert(rv == 0);
+
+  rv = bind(
+    ctx->listener,
+    (struct sockaddr *) &ctx->addr,
+    sizeof(ctx->addr)
+  );
+  rtems_test_assert(rv == 0);
+
+  rv = listen(ctx->listener, 1);
+  rtems_test_assert(rv == 0);
+
+  ctx->tx = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(ctx->tx >= 0);
+
+  rv = setsockopt(ctx->tx, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+  rtems_test_assert(rv == 0);
+
+  /* The connect() completes through the listen queue of the listener */
+  rv = connect(ctx->tx, (struct sockaddr *) &ctx->addr, sizeof(ctx->addr));
+  rtems_test_assert(rv == 0);
+
+  rv = setsockopt(ctx->tx, IPPROTO_TCP, TCP_MAXSEG, &maxseg, sizeof(maxseg));
+  rtems_test_assert(rv == 0);
+
+  ctx->rx = accept(ctx->listener, NULL, NULL);
+  rtems_test_assert(ctx->rx >= 0);
+}
+
+static rtems_task sender_task(rtems_task_argument arg)
+{
+  test_context *ctx = (test_context *) arg;
+  unsigned char buf[MAXSEG];
+  size_t offset = 0;
+  int rv;
+
+  while (offset < SEGMENTS * MAXSEG) {
+    size_t i;
+    ssize_t n;
+
+    for (i = 0; i < sizeof(buf); ++i) {
+      buf[i] = pattern(offset + i);
+    }
+
+    n = write(ctx->tx, &buf[0], sizeof(buf));
+    rtems_test_assert(n == (ssize_t) sizeof(buf));
+
+    offset += (size_t) n;
+  }
+
+  rv = close(ctx->tx);
+  rtems_test_assert(rv == 0);
+
+  rtems_task_delete(RTEMS_SELF);
+  rtems_test_assert(0);
+}
+
+static void start_sender(test_context *ctx)
+{
+  rtems_status_code sc;
+  rtems_id id;
+
+  sc = rtems_task_create(
+    rtems_build_name('S', 'E', 'N', 'D'),
+    RTEMS_MINIMUM_PRIORITY + 2,
+    RTEMS_MINIMUM_STACK_SIZE + MAXSEG,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(id, sender_task, (rtems_task_argument) ctx);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void receive_and_verify(test_context *ctx)
+{
+  size_t offset = 0;
+  ssize_t n;
+
+  while ((n = read(ctx->rx, &ctx->buf[0], sizeof(ctx->buf))) > 0) {
+    ssize_t i;
+
+    for (i = 0; i < n; ++i) {
+      rtems_test_assert(ctx->buf[i] == pattern(offset + (size_t) i));
+    }
+
+    offset += (size_t) n;
+  }
+
+  rtems_test_assert(n == 0);
+  rtems_test_assert(offset == SEGMENTS * MAXSEG);
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  lossy_stats stats;
+  int rv;
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  lossy_install(PORT);
+  open_connection(ctx);
+  start_sender(ctx);
+  receive_and_verify(ctx);
+  lossy_remove(&stats);
+
+  /* No segment carries more than MAXSEG bytes of data */
+  rtems_test_assert(stats.segments >= SEGMENTS);
+  rtems_test_assert(stats.dropped == 3);
+  rtems_test_assert(stats.reordered == 1);
+  rtems_test_assert(!stats.held);
+
+  /* The receiver reported the holes and the sender saw the reports */
+  rtems_test_assert(stats.sack_send_blocks > 0);
+  rtems_test_assert(stats.sack_rcv_blocks > 0);
+
+  printf(
+    "lost %i, reordered %i\n",
+    stats.dropped,
+    stats.reordered
+  );
+
+  rv = close(ctx->rx);
+  rtems_test_assert(rv == 0);
+
+  rv = close(ctx->listener);
+  rtems_test_assert(rv == 0);
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST TCP SACK 1 ***");
+  test();
+  puts("*** END OF TEST TCP SACK 1 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_MICROSECONDS_PER_TICK 10000
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 7
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+#define CONFIGURE_MAXIMUM_SEMAPHORES 2
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,161 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+/* The loss injection hooks into the loopback interface of the stack */
+#ifndef _KERNEL
+#define _KERNEL
+#endif
+
+#include "lossy.h"
+
+#include <rtems/rtems_bsdnet.h>
+#include <sys/param.h>
+#include <sys/mbuf.h>
+#include <sys/socket.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <netinet/in_systm.h>
+#include <netinet/ip.h>
+#include <netinet/tcp.h>
+#include <netinet/tcp_seq.h>
+#include <netinet/tcp_timer.h>
+#include <netinet/tcp_var.h>
+
+typedef int (*if_output_handler)(
+  struct ifnet *,
+  struct mbuf *,
+  struct sockaddr *,
+  struct rtentry *
+);
+
+typedef struct {
+  if_output_handler lo_output;
+  u_short port;
+  struct sockaddr_in dst;
+  bool seen_data;
+  tcp_seq snd_max;
+  int new_segments;
+  int dropped;
+  int reordered;
+  struct mbuf *held;
+  struct tcpstat before;
+} lossy_context;
+
+static lossy_context lossy_instance;
+
+/*
+ * The first transmissions of these new data segments get lost.  The
+ * retransmissions pass.
+ */
+static bool is_lost(int segment)
+{
+  return segment == 40 || segment == 41 || segment == 80;
+}
+
+/* This new data segment overtakes its predecessor */
+#define REORDERED 120
+
+/*
+ * Output handler of the loopback interface which loses and reorders data
+ * segments sent to the port.  It runs with the network semaphore held.
+ */
+static int lossy_output(
+  struct ifnet *ifp,
+  struct mbuf *m,
+  struct sockaddr *dst,
+  struct rtentry *rt
+)
+{
+  lossy_context *ctx = &lossy_instance;
+  struct {
+    struct ip ip;
+    struct tcphdr th;
+  } hdr;
+  int hlen;
+  int len;
+  tcp_seq seq;
+  int rv;
+
+  if (
+    dst->sa_family != AF_INET
+      || m->m_pkthdr.len < (int) sizeof(hdr)
+  ) {
+    return (*ctx->lo_output)(ifp, m, dst, rt);
+  }
+
+  m_copydata(m, 0, sizeof(hdr), (caddr_t) &hdr);
+  if (hdr.ip.ip_p != IPPROTO_TCP || hdr.th.th_dport != ctx->port) {
+    return (*ctx->lo_output)(ifp, m, dst, rt);
+  }
+
+  hlen = (hdr.ip.ip_hl << 2) + (hdr.th.th_off << 2);
+  len = ntohs(hdr.ip.ip_len) - hlen;
+  seq = ntohl(hdr.th.th_seq);
+  if (len <= 0 || (ctx->seen_data && SEQ_LT(seq, ctx->snd_max))) {
+    /* No data or a retransmission */
+    return (*ctx->lo_output)(ifp, m, dst, rt);
+  }
+
+  ctx->seen_data = true;
+  ctx->snd_max = seq + len;
+  ++ctx->new_segments;
+
+  if (is_lost(ctx->new_segments)) {
+    ++ctx->dropped;
+    m_freem(m);
+    return 0;
+  }
+
+  if (ctx->new_segments == REORDERED) {
+    ctx->dst = *(struct sockaddr_in *) dst;
+    ctx->held = m;
+    return 0;
+  }
+
+  rv = (*ctx->lo_output)(ifp, m, dst, rt);
+
+  if (ctx->held != NULL) {
+    m = ctx->held;
+    ctx->held = NULL;
+    ++ctx->reordered;
+    (void) (*ctx->lo_output)(ifp, m, (struct sockaddr *) &ctx->dst, NULL);
+  }
+
+  return rv;
+}
+
+void lossy_install(uint16_t port)
+{
+  lossy_context *ctx = &lossy_instance;
+
+  rtems_bsdnet_semaphore_obtain();
+  ctx->port = htons(port);
+  ctx->before = tcpstat;
+  ctx->lo_output = loif[0].if_output;
+  loif[0].if_output = lossy_output;
+  rtems_bsdnet_semaphore_release();
+}
+
+void lossy_remove(lossy_stats *stats)
+{
+  lossy_context *ctx = &lossy_instance;
+
+  rtems_bsdnet_semaphore_obtain();
+  loif[0].if_output = ctx->lo_output;
+  stats->segments = ctx->new_segments;
+  stats->dropped = ctx->dropped;
+  stats->reordered = ctx->reordered;
+  stats->held = ctx->held != NULL;
+  stats->sack_send_blocks =
+    tcpstat.tcps_sack_send_blocks - ctx->before.tcps_sack_send_blocks;
+  stats->sack_rcv_blocks =
+    tcpstat.tcps_sack_rcv_blocks - ctx->before.tcps_sack_rcv_blocks;
+  rtems_bsdnet_semaphore_release();
+}
@@ -0,0 +1,41 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifndef LOSSY_H
+#define LOSSY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+typedef struct {
+  int segments;
+  int dropped;
+  int reordered;
+  int held;
+  unsigned long sack_send_blocks;
+  unsigned long sack_rcv_blocks;
+} lossy_stats;
+
+/*
+ * Installs an output handler in the loopback interface which loses and
+ * reorders data segments sent to the TCP port.
+ */
+void lossy_install(uint16_t port);
+
+/*
+ * Restores the loopback output handler and returns the statistics since the
+ * installation.
+ */
+void lossy_remove(lossy_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LOSSY_H */
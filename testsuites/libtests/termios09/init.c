@@ -0,0 +1,302 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <rtems/libio.h>
+#include <rtems/termiostypes.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define RAW_INPUT_SIZE 256
+
+#define RAW_OUTPUT_SIZE 512
+
+#define DATA_SIZE 1000
+
+#define DMA_DRIVER_TABLE_ENTRY \
+  { dma_initialize, dma_open, dma_close, dma_read, dma_write, dma_control }
+
+typedef struct {
+  void *tty;
+  rtems_id tx_timer;
+  size_t tx_pending;
+  size_t tx_count;
+  size_t tx_calls;
+  size_t tx_max;
+  char tx_buf[DATA_SIZE];
+  char data[DATA_SIZE];
+  char rx_buf[DATA_SIZE];
+} test_context;
+
+static test_context test_instance;
+
+static const char dev[] = "/dev/dma";
+
+static rtems_timer_service_routine tx_done(rtems_id timer, void *arg)
+{
+  test_context *ctx = arg;
+  size_t n = ctx->tx_pending;
+
+  ctx->tx_pending = 0;
+  rtems_termios_dequeue_characters(ctx->tty, (int) n);
+}
+
+static ssize_t dma_transmit(int minor, const char *buf, size_t len)
+{
+  test_context *ctx = &test_instance;
+
+  if (len > 0) {
+    rtems_status_code sc;
+
+    rtems_test_assert(ctx->tx_pending == 0);
+    rtems_test_assert(ctx->tx_count + len <= DATA_SIZE);
+
+    memcpy(&ctx->tx_buf[ctx->tx_count], buf, len);
+    ctx->tx_count += len;
+    ++ctx->tx_calls;
+    if (len > ctx->tx_max) {
+      ctx->tx_max = len;
+    }
+
+    /* Complete the transfer in the next clock tick interrupt */
+    ctx->tx_pending = len;
+    sc = rtems_timer_fire_after(ctx->tx_timer, 1, tx_done, ctx);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  return 0;
+}
+
+static const rtems_termios_callbacks dma_callbacks = {
+  .write = dma_transmit,
+  .outputUsesInterrupts = TERMIOS_IRQ_DRIVEN,
+  .rawInputBufferSize = RAW_INPUT_SIZE,
+  .rawOutputBufferSize = RAW_OUTPUT_SIZE
+};
+
+static rtems_device_driver dma_initialize(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  test_context *ctx = &test_instance;
+  rtems_status_code sc;
+
+  sc = rtems_io_register_name(dev, major, 0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_timer_create(rtems_build_name('D', 'M', 'A', ' '), &ctx->tx_timer);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  return RTEMS_SUCCESSFUL;
+}
+
+static rtems_device_driver dma_open(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  test_context *ctx = &test_instance;
+  rtems_libio_open_close_args_t *args = arg;
+  rtems_status_code sc;
+
+  sc = rtems_termios_open(major, minor, arg, &dma_callbacks);
+  if (sc == RTEMS_SUCCESSFUL) {
+    ctx->tty = args->iop->data1;
+  }
+
+  return sc;
+}
+
+static rtems_device_driver dma_close(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  return rtems_termios_close(arg);
+}
+
+static rtems_device_driver dma_read(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  return rtems_termios_read(arg);
+}
+
+static rtems_device_driver dma_write(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  return rtems_termios_write(arg);
+}
+
+static rtems_device_driver dma_control(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  return rtems_termios_ioctl(arg);
+}
+
+static void receive(test_context *ctx, const char *buf, size_t len)
+{
+  while (len > 0) {
+    char *space;
+    size_t size;
+
+    space = rtems_termios_raw_input_space(ctx->tty, &size);
+    rtems_test_assert(space != NULL);
+    rtems_test_assert(size > 0);
+
+    if (size > len) {
+      size = len;
+    }
+
+    memcpy(space, buf, size);
+    rtems_termios_commit_raw_characters(ctx->tty, size);
+
+    buf += size;
+    len -= size;
+  }
+}
+
+static void test_flow_control(test_context *ctx, int fd)
+{
+  struct termios term;
+  size_t size;
+  int rv;
+
+  rv = tcgetattr(fd, &term);
+  rtems_test_assert(rv == 0);
+
+  term.c_iflag |= IXON;
+  rv = tcsetattr(fd, TCSANOW, &term);
+  rtems_test_assert(rv == 0);
+
+  /* Received XON/XOFF characters must be filtered one at a time */
+  rtems_test_assert(rtems_termios_raw_input_space(ctx->tty, &size) == NULL);
+  rtems_test_assert(size == 0);
+
+  cfmakeraw(&term);
+  term.c_cc[VMIN] = 1;
+  term.c_cc[VTIME] = 0;
+  rv = tcsetattr(fd, TCSANOW, &term);
+  rtems_test_assert(rv == 0);
+
+  rtems_test_assert(rtems_termios_raw_input_space(ctx->tty, &size) != NULL);
+  rtems_test_assert(size == RAW_INPUT_SIZE - 1);
+}
+
+static void test_bulk_output(test_context *ctx, int fd)
+{
+  ssize_t n;
+  int rv;
+
+  n = write(fd, &ctx->data[0], DATA_SIZE);
+  rtems_test_assert(n == DATA_SIZE);
+
+  rv = tcdrain(fd);
+  rtems_test_assert(rv == 0);
+
+  rtems_test_assert(ctx->tx_count == DATA_SIZE);
+  rtems_test_assert(memcmp(&ctx->tx_buf[0], &ctx->data[0], DATA_SIZE) == 0);
+
+  /* Contiguous ranges of the raw output buffer are handed over at once */
+  rtems_test_assert(ctx->tx_max == RAW_OUTPUT_SIZE - 1);
+  rtems_test_assert(ctx->tx_calls <= 4);
+}
+
+static void test_bulk_input(test_context *ctx, int fd)
+{
+  size_t offset;
+  size_t chunk;
+  ssize_t n;
+
+  /* Fill and drain the raw input buffer several times so that it wraps */
+  chunk = RAW_INPUT_SIZE - 56;
+  for (offset = 0; offset + chunk <= DATA_SIZE; offset += chunk) {
+    memset(&ctx->rx_buf[0], 0, chunk);
+    receive(ctx, &ctx->data[offset], chunk);
+
+    n = read(fd, &ctx->rx_buf[0], chunk);
+    rtems_test_assert(n == (ssize_t) chunk);
+    rtems_test_assert(memcmp(&ctx->rx_buf[0], &ctx->data[offset], chunk) == 0);
+  }
+
+  /* A read returns the available characters once VMIN is satisfied */
+  receive(ctx, &ctx->data[0], 50);
+  n = read(fd, &ctx->rx_buf[0], DATA_SIZE);
+  rtems_test_assert(n == 50);
+  rtems_test_assert(memcmp(&ctx->rx_buf[0], &ctx->data[0], 50) == 0);
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+  size_t i;
+  int fd;
+  int rv;
+
+  for (i = 0; i < DATA_SIZE; ++i) {
+    ctx->data[i] = (char) (i * 7 + 3);
+  }
+
+  fd = open(dev, O_RDWR);
+  rtems_test_assert(fd >= 0);
+
+  test_flow_control(ctx, fd);
+  test_bulk_output(ctx, fd);
+  test_bulk_input(ctx, fd);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST TERMIOS 9 ***");
+  test();
+  puts("*** END OF TEST TERMIOS 9 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_EXTRA_DRIVERS DMA_DRIVER_TABLE_ENTRY
+
+#define CONFIGURE_NUMBER_OF_TERMIOS_PORTS 2
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_MAXIMUM_TIMERS 1
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
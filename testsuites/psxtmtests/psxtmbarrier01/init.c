@@ -35,7 +35,9 @@ static void benchmark_pthread_barrier_init(void)
   rtems_test_assert( status == 0 );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_barrier_init( &barrier,&attr, 1 );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -54,7 +56,9 @@ static void benchmark_pthread_barrier_destroy(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_barrier_destroy( &barrier );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -40,6 +40,7 @@ void *Low(
   sched_yield();
     /* let other threads run */
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -68,6 +69,7 @@ void *Middle(
   sched_yield();
     /* let other threads run */
 
+    time_sample_next();
     (void) pthread_barrier_wait( &barrier );
   
   /* should never return */
@@ -120,6 +122,7 @@ void *POSIX_Init(
    */
   benchmark_timer_initialize();
     /* blocking barrier call */
+    time_sample_begin();
     status = pthread_barrier_wait( &barrier );
   rtems_test_assert( status == 0 );
   return NULL;
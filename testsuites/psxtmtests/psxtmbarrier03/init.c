@@ -68,7 +68,9 @@ void *POSIX_Init(
    * unblocking operation.
    */
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_barrier_wait( &barrier );
+  time_sample_end();
   end_time = benchmark_timer_read();
   /*
    * Upon successful completion return value, the status should be
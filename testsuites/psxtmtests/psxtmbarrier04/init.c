@@ -35,6 +35,7 @@ void *Blocker(
 
 
   /* preempt first thread and stop time */
+  time_sample_end();
   end_time = benchmark_timer_read();
   put_time(
     "pthread_barrier_wait: releasing preempt",
@@ -76,6 +77,7 @@ void *POSIX_Init(
    * preempts this one due to having a higher priority
    */
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_barrier_wait( &barrier );
 
   /* avoid warning but should not be executed */
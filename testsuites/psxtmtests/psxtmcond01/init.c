@@ -32,7 +32,9 @@ void benchmark_create_cond_var(void)
   int  status;
 
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_cond_init(&mycondvar, NULL);
+  time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -51,7 +53,9 @@ void benchmark_destroy_cond_var(void)
   int  status;
 
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_cond_destroy(&mycondvar);
+  time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -28,9 +28,11 @@ void benchmark_signal(void)
   int  status;
 
   benchmark_timer_initialize();
+  time_sample_begin();
 
   status = pthread_cond_signal(&CondID);
 
+  time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
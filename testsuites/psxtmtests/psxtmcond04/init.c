@@ -46,6 +46,7 @@ void *Blocker(
   pthread_cond_wait(&CondID,&MutexID);
 
   /* Once signaled, this thread preempts POSIX_Init thread */
+  time_sample_end();
   end_time = benchmark_timer_read();
   put_time(
     "pthread_cond_signal: thread waiting preempt",
@@ -86,6 +87,7 @@ void *POSIX_Init(
 
   /* Other thread is blocked and waiting on condition to be signaled */
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_cond_signal(&CondID);
   rtems_test_assert ( status == 0 );
   return NULL;
@@ -28,7 +28,9 @@ void benchmark_broadcast(void)
   int  status;
 
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_cond_broadcast(&CondID);
+  time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -97,7 +97,9 @@ void *POSIX_Init(
   rtems_test_assert( status == 0 );
 
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_cond_broadcast(&CondID);
+  time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -41,6 +41,7 @@ void *Blocker(
   /* Unlock mutex, block, wait for CondID to be signaled */
   pthread_cond_wait(&CondID,&MutexID);
 
+  time_sample_end();
   end_time = benchmark_timer_read();
   put_time(
     "pthread_cond_broadcast: threads waiting, preempt",
@@ -104,6 +105,7 @@ void *POSIX_Init(
    * in other thread
    */
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_cond_broadcast(&CondID);
 
   /* Should never reach this point */
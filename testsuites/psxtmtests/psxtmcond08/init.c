@@ -50,6 +50,7 @@ void *Low(
 {
   long end_time;
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -75,6 +76,7 @@ void *Middle(
 
   rc = pthread_mutex_lock(&MutexID);
   rtems_test_assert( rc == 0 );
+  time_sample_next();
 
   /* block and switch to another task here */
 
@@ -152,6 +154,7 @@ void *POSIX_Init(
 
   /* start the timer and switch through all the other tasks */
   benchmark_timer_initialize();
+  time_sample_begin();
 
   rc = pthread_mutex_unlock(&MutexID);
   rtems_test_assert( rc == 0 );
@@ -28,7 +28,9 @@ static void benchmark_pthread_key_create(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_key_create(&Key, NULL);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -48,7 +50,9 @@ static void benchmark_pthread_key_delete(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_key_delete(Key);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -31,7 +31,9 @@ void benchmark_pthread_setspecific( void *value_p )
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_setspecific( Key, value_p );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -51,7 +53,9 @@ void benchmark_pthread_getspecific( void *expected )
   void *value_p;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     value_p = pthread_getspecific( Key );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( value_p == expected );
 
@@ -39,7 +39,9 @@ static void benchmark_mq_open(int printable)
   q_name= "queue";
 
   benchmark_timer_initialize();
+    time_sample_begin();
     queue = mq_open( q_name, O_CREAT | O_RDWR , 0x777, &attr );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( queue != (-1) );
 
@@ -62,7 +64,9 @@ static void benchmark_mq_open_second(int printable)
   attr.mq_msgsize = MQ_MSGSIZE;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     queue2 =mq_open( q_name, O_RDONLY | O_CREAT , 0x777, &attr);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( queue2 != (-1) );
 
@@ -83,7 +87,9 @@ static void benchmark_mq_close(int printable)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = mq_close(queue);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -103,7 +109,9 @@ static void benchmark_mq_close_second(int printable)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = mq_close(queue2);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -123,7 +131,9 @@ static void benchmark_mq_unlink(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = mq_unlink(q_name);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -146,7 +156,9 @@ static void benchmark_mq_notify(void)
   event.sigev_signo  = SIGUSR1;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = mq_notify( queue2, &event );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -166,7 +178,9 @@ static void benchmark_mq_send(void)
 
   status = 9;
   benchmark_timer_initialize();
+    time_sample_begin();
     status = mq_send( queue, (const char *)&status, MQ_MSGSIZE, 1 );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status != (-1) );
 
@@ -188,7 +202,9 @@ static void benchmark_mq_receive(void)
   priority = 1;       /*priority low*/
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = mq_receive( queue2, ( char *)message, MQ_MSGSIZE, &priority );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status != (-1) );
 
@@ -211,8 +227,10 @@ static void benchmark_mq_timedsend(void)
   timeout.tv_sec  = 0;
   timeout.tv_nsec = 1;
   benchmark_timer_initialize();
+    time_sample_begin();
     status = mq_timedsend(
 	     queue, (const char *)&status, MQ_MSGSIZE, 1, &timeout);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status != (-1) );
 
@@ -237,8 +255,10 @@ static void benchmark_mq_timedreceive(void)
   timeout.tv_sec  = 0;
   timeout.tv_nsec = 0;
   benchmark_timer_initialize();
+    time_sample_begin();
     status = mq_timedreceive(
 		  queue2, ( char *)message, MQ_MSGSIZE, &priority, &timeout);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status != (-1) );
 
@@ -28,7 +28,9 @@ static void test_mutex_create(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_mutex_init( &MutexId, NULL );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -47,7 +49,9 @@ static void test_mutex_destroy(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_mutex_destroy( &MutexId );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
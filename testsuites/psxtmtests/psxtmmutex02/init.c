@@ -40,6 +40,7 @@ void *Low(
   sched_yield();
     /* let other threads run */
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -70,6 +71,7 @@ void *Middle(
   sched_yield();
     /* let other threads run */
 
+  time_sample_next();
   status = pthread_mutex_lock( &MutexId );
   rtems_test_assert( !status );
 
@@ -110,6 +112,7 @@ void *POSIX_Init(
 
   /* start the timer and switch through all the other tasks */
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_mutex_lock( &MutexId );
   rtems_test_assert( !status );
 
@@ -33,7 +33,9 @@ void benchmark_mutex_lock_available(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_mutex_lock( &MutexId );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( !status );
 
@@ -52,7 +54,9 @@ void benchmark_mutex_unlock_no_threads_waiting(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_mutex_unlock( &MutexId );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( !status );
 
@@ -71,7 +75,9 @@ void benchmark_mutex_trylock_available(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_mutex_trylock( &MutexId );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( !status );
 
@@ -90,12 +96,14 @@ void benchmark_mutex_trylock_not_available(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_mutex_trylock( &MutexId );
     /* 
      * it has to return a negative value 
      * because it try to lock a not available mutex    
      * so the assert call is make with status instead !status 
      */
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status );
 
@@ -114,7 +122,9 @@ void benchmark_mutex_timedlock_available(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_mutex_timedlock( &MutexId, 0 );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( !status );
 
@@ -34,6 +34,7 @@ void *Low(
   benchmark_timer_t end_time;
 
     status = pthread_mutex_lock( &MutexId );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   rtems_test_assert( status == 0 );
@@ -59,6 +60,7 @@ void *Middle(
 
   status = pthread_mutex_lock( &MutexId );
   rtems_test_assert( status == 0 );
+  time_sample_next();
 
     /* thread switch occurs */
 
@@ -134,6 +136,7 @@ void *POSIX_Init(
    * Now start the timer which will be stopped in Low
    */
   benchmark_timer_initialize();
+  time_sample_begin();
 
     status = pthread_mutex_unlock( &MutexId );
     rtems_test_assert( status == 0 );
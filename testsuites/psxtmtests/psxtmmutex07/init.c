@@ -31,7 +31,9 @@ void test_mutex_setprioceiling(void)
   int  old_ceiling;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_mutex_setprioceiling( &MutexId, 5, &old_ceiling );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -51,7 +53,9 @@ void test_mutex_getprioceiling(void)
   int  current_ceiling;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_mutex_getprioceiling( &MutexId, &current_ceiling );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
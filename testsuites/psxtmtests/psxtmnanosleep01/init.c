@@ -31,7 +31,9 @@ void *POSIX_Init(
   puts( "\n\n*** POSIX TIME TEST PSXTMNANOSLEEP01 ***" );
 
   benchmark_timer_initialize();    
+    time_sample_begin();
     nanosleep( &sleepTime, (struct  timespec *) NULL );
+    time_sample_end();
   end_time = benchmark_timer_read();  
 
   put_time( "nanosleep: yield", end_time, 1, 0, 0 );
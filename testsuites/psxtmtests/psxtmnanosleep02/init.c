@@ -28,6 +28,7 @@ void *Low(
 {
   benchmark_timer_t end_time;
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -53,6 +54,7 @@ void *Middle(
   sleepTime.tv_sec = 0;
   sleepTime.tv_nsec = 1;
 
+  time_sample_next();
   nanosleep(&sleepTime, (struct  timespec *) NULL);
 
   return NULL;
@@ -85,6 +87,7 @@ void *POSIX_Init(
 
   /* start the timer and switch through all the other tasks */
   benchmark_timer_initialize();
+  time_sample_begin();
   /* calling nanosleep*/
   nanosleep(&sleepTime, &remainder);
 
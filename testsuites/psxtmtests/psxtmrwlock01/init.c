@@ -29,7 +29,9 @@ static void benchmark_pthread_rwlock_init(void)
 
   pthread_rwlockattr_init( &attr );
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_rwlock_init( &rwlock, &attr );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -49,7 +51,9 @@ static void benchmark_pthread_rwlock_rdlock(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_rwlock_rdlock(&rwlock);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -69,7 +73,9 @@ static void benchmark_pthread_rwlock_unlock(int print)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_rwlock_unlock(&rwlock);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
   if ( print == 1 ){
@@ -89,7 +95,9 @@ static void benchmark_pthread_rwlock_tryrdlock(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_rwlock_tryrdlock(&rwlock);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 || status == EBUSY );
   if (status == EBUSY) {
@@ -117,7 +125,9 @@ static void benchmark_pthread_rwlock_timedrdlock(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_rwlock_timedrdlock(&rwlock, 0);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -137,7 +147,9 @@ static void benchmark_pthread_rwlock_wrlock(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_rwlock_wrlock(&rwlock);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -157,7 +169,9 @@ static void benchmark_pthread_rwlock_trywrlock(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_rwlock_trywrlock(&rwlock);
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   rtems_test_assert( status == 0 || status == EBUSY );
@@ -186,7 +200,9 @@ static void benchmark_pthread_rwlock_timedwrlock(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_rwlock_timedwrlock(&rwlock,0);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -205,7 +221,9 @@ static void benchmark_pthread_rwlock_destroy(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = pthread_rwlock_destroy(&rwlock);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -41,6 +41,7 @@ void *Low(
   sched_yield();
     /* let other threads run */
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -70,6 +71,7 @@ void *Middle(
    */
   sched_yield();
     /* let other threads run */
+  time_sample_next();
 
   /* this timed read lock operation will be blocked
    * cause a write operation has the lock */
@@ -122,6 +124,7 @@ void *POSIX_Init(
 
   /* start the timer and switch through all the other tasks */
   benchmark_timer_initialize();
+  time_sample_begin();
 
   /*
    * Write lock operation, this could be any write lock
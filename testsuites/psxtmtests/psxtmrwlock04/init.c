@@ -40,6 +40,7 @@ void *Low(
   sched_yield();
     /* let other threads run */
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -69,6 +70,7 @@ void *Middle(
    */
   sched_yield();
     /* let other threads run */
+  time_sample_next();
 
   /* this write lock operation will be blocked 
    * cause another write operation has the lock */
@@ -113,6 +115,7 @@ void *POSIX_Init(
   
   /* start the timer and switch through all the other tasks */
   benchmark_timer_initialize();
+  time_sample_begin();
   /* write lock operation */
     status = pthread_rwlock_wrlock(&rwlock);
   rtems_test_assert( status == 0 );
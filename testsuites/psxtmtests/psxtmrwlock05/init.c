@@ -41,6 +41,7 @@ void *Low(
   sched_yield();
     /* let other threads run */
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -70,6 +71,7 @@ void *Middle(
    */
   sched_yield();
     /* let other threads run */
+  time_sample_next();
 
   /* This timed write lock operation will be blocked 
    * because the other write operation has the lock
@@ -123,6 +125,7 @@ void *POSIX_Init(
   
   /* start the timer and switch through all the other tasks */
   benchmark_timer_initialize();
+  time_sample_begin();
 
   /* write lock operation, this could be any write lock
    * I decided to use timedwrlock just to continue in the timed line  */
@@ -35,6 +35,7 @@ void *Low(
 
   /* write locking */
     status = pthread_rwlock_wrlock(&rwlock);
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   rtems_test_assert( status == 0 );
@@ -60,6 +61,7 @@ void *Middle(
 
   /* write locking */
   status =  pthread_rwlock_wrlock(&rwlock);
+  time_sample_next();
   rtems_test_assert( status == 0 );
 
     /* thread switch occurs */
@@ -141,6 +143,7 @@ void *POSIX_Init(
    * Release the lock.  Threads unblock and preempt.
    */
   benchmark_timer_initialize();
+  time_sample_begin();
 
     status = pthread_rwlock_unlock(&rwlock);
       /* thread switch occurs */
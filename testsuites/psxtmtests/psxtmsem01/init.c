@@ -34,7 +34,9 @@ static void benchmark_sem_init(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = sem_init( &sem1, 0, 1 );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -53,7 +55,9 @@ static void benchmark_sem_destroy(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = sem_destroy( &sem1 );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -71,7 +75,9 @@ static void benchmark_sem_open(bool report_time)
   benchmark_timer_t end_time;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     n_sem1 = sem_open( "sem1", O_CREAT, 0777, 1 );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   if ( report_time ) {
@@ -91,7 +97,9 @@ static void benchmark_sem_close(bool report_time)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = sem_close( n_sem1 );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -112,7 +120,9 @@ static void benchmark_sem_unlink(const char *message)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = sem_unlink( "sem1" );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -130,7 +140,9 @@ static void benchmark_sem_open_second(void)
   benchmark_timer_t end_time;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     n_sem2 = sem_open( "sem1", O_EXCL, 0777, 1 );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -148,7 +160,9 @@ static void benchmark_sem_close_second(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = sem_close( n_sem2 );
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
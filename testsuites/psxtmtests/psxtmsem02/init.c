@@ -32,7 +32,9 @@ static void benchmark_sem_getvalue(void)
   int  value;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = sem_getvalue(&sem1, &value);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -51,7 +53,9 @@ static void benchmark_sem_wait(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = sem_wait(&sem1);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -70,7 +74,9 @@ static void benchmark_sem_post(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = sem_post(&sem1);
+    time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -89,7 +95,9 @@ static void benchmark_sem_trywait_available(void)
   int  status;
 
   benchmark_timer_initialize();
+  time_sample_begin();
   status = sem_trywait(&sem1);
+  time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -108,7 +116,9 @@ static void benchmark_sem_trywait_not_available(void)
   int  status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     status = sem_trywait(&sem1);
+    time_sample_end();
   end_time = benchmark_timer_read();
   /*it must be non avalible, so status should be non zero*/
   rtems_test_assert( status != 0 );
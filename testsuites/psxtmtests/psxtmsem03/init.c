@@ -44,6 +44,7 @@ void *Low(
   sched_yield();
     /* let other threads run */
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -71,6 +72,7 @@ void *Middle(
    */
   sched_yield();
     /* let other threads run */
+  time_sample_next();
 
     (void) sem_wait( &sem1 );
     rtems_test_assert( FALSE );
@@ -111,6 +113,7 @@ void *POSIX_Init(
 
   /* start the timer and switch through all the other tasks */
   benchmark_timer_initialize();
+    time_sample_begin();
     status = sem_wait(&sem1);
   rtems_test_assert( status == 0 );
   return NULL;
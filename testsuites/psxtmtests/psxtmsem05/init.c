@@ -39,6 +39,7 @@ void *Low(
   benchmark_timer_t end_time;
 
     status = sem_wait(&sem1); /* semaphore blocks */
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   rtems_test_assert( status == 0 );
@@ -63,6 +64,7 @@ void *Middle(
   int status;
 
     status = sem_wait(&sem1); /* semaphore blocks */
+  time_sample_next();
   rtems_test_assert( status == 0 );
 
     /* thread switch occurs */
@@ -142,6 +144,7 @@ void *POSIX_Init(
    * Release the semaphore so threads unblock and preempt.
    */
   benchmark_timer_initialize();
+  time_sample_begin();
 
     status = sem_post( &sem1 );
       /* thread switch occurs */
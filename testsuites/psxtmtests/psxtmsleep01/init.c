@@ -29,7 +29,9 @@ void *POSIX_Init(
   puts( "\n\n*** POSIX TIME TEST PSXTMSLEEP01 ***" );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     sleep(0);
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
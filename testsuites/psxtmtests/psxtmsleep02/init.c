@@ -28,6 +28,7 @@ void *Low(
 {
   benchmark_timer_t end_time;
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -48,6 +49,7 @@ void *Middle(
   void *argument
 )
 {
+  time_sample_next();
   sleep(1);
   return NULL;
 }
@@ -72,6 +74,7 @@ void *POSIX_Init(
 
   /* start the timer and switch through all the other tasks */
   benchmark_timer_initialize();
+  time_sample_begin();
   sleep(1);
   return NULL;
 }
@@ -44,6 +44,7 @@ void benchmark_pthread_create(void)
 
   /* create second thread with max priority and get preempted on creation */
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_create(&thread_ID, &attr, thread, NULL);
 }
 
@@ -53,6 +54,7 @@ void *thread(
 {
   long end_time;
 
+  time_sample_end();
   end_time = benchmark_timer_read();
   put_time(
     "pthread_create: preempt",
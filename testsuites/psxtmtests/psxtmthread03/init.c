@@ -38,6 +38,7 @@ void *Low(
   sched_yield();
     /* let other threads run */
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -64,6 +65,7 @@ void *Middle(
    */
   sched_yield();
     /* let other threads run */
+  time_sample_next();
 
   pthread_exit( NULL );
   return NULL;
@@ -96,6 +98,7 @@ void *POSIX_Init(
 
   /* start the timer and switch through all the other tasks */
   benchmark_timer_initialize();
+  time_sample_begin();
   pthread_exit( NULL );
   return NULL;
 }
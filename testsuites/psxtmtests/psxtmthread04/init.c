@@ -30,7 +30,9 @@ void benchmark_pthread_getschedparam(void)
   struct sched_param param;
 
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_getschedparam( pthread_self(), &policy, &param );
+  time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -57,7 +59,9 @@ void benchmark_pthread_setschedparam(void)
   /* Arbitrary priority, no other threads to preempt us so it doesn't matter. */
   param.sched_priority = 5;
   benchmark_timer_initialize();
+  time_sample_begin();
   status = pthread_setschedparam( pthread_self(), policy, &param );
+  time_sample_end();
   end_time = benchmark_timer_read();
   rtems_test_assert( status == 0 );
 
@@ -44,6 +44,7 @@ void benchmark_pthread_setschedparam(void)
   param.sched_priority = sched_get_priority_min(policy);
 
   benchmark_timer_initialize();
+  time_sample_begin();
   //lower own priority to minimun, scheduler forces an involuntary context switch
   pthread_setschedparam(pthread_self(), policy, &param);
 }
@@ -55,6 +56,7 @@ void *test_thread(
   long end_time;
   sched_yield();
 
+  time_sample_end();
   end_time = benchmark_timer_read();
   put_time(
     "pthread_setschedparam: lower own priority preempt",
@@ -44,6 +44,7 @@ void benchmark_pthread_setschedparam(void)
   param.sched_priority = sched_get_priority_max(policy) - 1;
 
   benchmark_timer_initialize();
+  time_sample_begin();
   pthread_setschedparam(thread_ID, policy, &param);
 }
 
@@ -56,6 +57,7 @@ void *test_thread(
   /* switch to POSIX_Init */
   sched_yield();
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -27,7 +27,12 @@
 
 #define CPU_COUNT 32
 
-#define TEST_COUNT 5
+#define TEST_COUNT 7
+
+#define LOCK_VARIANT_COUNT 2
+
+/* Steps for 1, 2, 4, ..., CPU_COUNT processors */
+#define SCALING_STEP_COUNT 6
 
 typedef enum {
   INITIAL,
@@ -40,15 +45,23 @@ typedef struct {
   SMP_barrier_Control barrier;
   rtems_id timer_id;
   rtems_interval timeout;
+  rtems_interval scaling_timeout;
   unsigned long counter[TEST_COUNT];
   unsigned long test_counter[TEST_COUNT][CPU_COUNT];
+  unsigned long scaling_counter
+    [LOCK_VARIANT_COUNT][SCALING_STEP_COUNT][CPU_COUNT];
+  unsigned long scaling_global_counter[LOCK_VARIANT_COUNT][SCALING_STEP_COUNT];
   SMP_lock_Control lock;
+  SMP_ticket_lock_Control ticket_lock;
+  SMP_MCS_lock_Control mcs_lock;
 } global_context;
 
 static global_context context = {
   .state = ATOMIC_INITIALIZER_UINT(INITIAL),
   .barrier = SMP_BARRIER_CONTROL_INITIALIZER,
-  .lock = SMP_LOCK_INITIALIZER
+  .lock = SMP_LOCK_INITIALIZER,
+  .ticket_lock = SMP_TICKET_LOCK_INITIALIZER,
+  .mcs_lock = SMP_MCS_LOCK_INITIALIZER
 };
 
 static const char *test_names[TEST_COUNT] = {
@@ -56,7 +69,14 @@ static const char *test_names[TEST_COUNT] = {
   "aquire global lock with global counter",
   "aquire local lock with local counter",
   "aquire local lock with global counter",
-  "aquire global lock with busy section"
+  "aquire global lock with busy section",
+  "aquire global ticket lock with busy section",
+  "aquire global MCS lock with busy section"
+};
+
+static const char *lock_variant_names[LOCK_VARIANT_COUNT] = {
+  "ticket lock",
+  "MCS lock"
 };
 
 static void stop_test_timer(rtems_id timer_id, void *arg)
@@ -213,14 +233,162 @@ static void test_4_body(
   ctx->test_counter[test][cpu_self] = counter;
 }
 
+/*
+ * The global counter is incremented without atomic operations inside the
+ * critical section, so it equals the sum of the local counters only if the
+ * lock provides mutual exclusion.
+ */
+static unsigned long ticket_lock_loop(
+  global_context *ctx,
+  unsigned long *global_counter
+)
+{
+  unsigned long counter = 0;
+
+  while (assert_state(ctx, START_TEST)) {
+    _SMP_ticket_lock_Acquire(&ctx->ticket_lock);
+    busy_section();
+    ++(*global_counter);
+    _SMP_ticket_lock_Release(&ctx->ticket_lock);
+    ++counter;
+  }
+
+  return counter;
+}
+
+static unsigned long mcs_lock_loop(
+  global_context *ctx,
+  unsigned long *global_counter
+)
+{
+  unsigned long counter = 0;
+  SMP_MCS_lock_Context lock_context;
+
+  while (assert_state(ctx, START_TEST)) {
+    _SMP_MCS_lock_Acquire(&ctx->mcs_lock, &lock_context);
+    busy_section();
+    ++(*global_counter);
+    _SMP_MCS_lock_Release(&ctx->mcs_lock, &lock_context);
+    ++counter;
+  }
+
+  return counter;
+}
+
+static void test_5_body(
+  int test,
+  global_context *ctx,
+  SMP_barrier_State *bs,
+  unsigned int cpu_count,
+  unsigned int cpu_self
+)
+{
+  ctx->test_counter[test][cpu_self] =
+    ticket_lock_loop(ctx, &ctx->counter[test]);
+}
+
+static void test_6_body(
+  int test,
+  global_context *ctx,
+  SMP_barrier_State *bs,
+  unsigned int cpu_count,
+  unsigned int cpu_self
+)
+{
+  ctx->test_counter[test][cpu_self] =
+    mcs_lock_loop(ctx, &ctx->counter[test]);
+}
+
 static const test_body test_bodies[TEST_COUNT] = {
   test_0_body,
   test_1_body,
   test_2_body,
   test_3_body,
-  test_4_body
+  test_4_body,
+  test_5_body,
+  test_6_body
 };
 
+static unsigned int scaling_processor_count(
+  unsigned int cpu_count,
+  int step
+)
+{
+  unsigned int n = 1U << step;
+
+  return n < cpu_count ? n : cpu_count;
+}
+
+static int scaling_step_count(unsigned int cpu_count)
+{
+  int step = 0;
+
+  while (
+    step < SCALING_STEP_COUNT
+      && (step == 0 || scaling_processor_count(cpu_count, step - 1) < cpu_count)
+  ) {
+    ++step;
+  }
+
+  return step;
+}
+
+static void start_test(global_context *ctx, rtems_interval timeout)
+{
+  rtems_status_code sc = rtems_timer_fire_after(
+    ctx->timer_id,
+    timeout,
+    stop_test_timer,
+    ctx
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  _Atomic_Store_uint(&ctx->state, START_TEST, ATOMIC_ORDER_RELEASE);
+}
+
+/*
+ * Compare the lock variants with an increasing count of processors
+ * contending for the lock.  The other processors wait at the barrier.
+ */
+static void run_scaling_tests(
+  global_context *ctx,
+  SMP_barrier_State *bs,
+  unsigned int cpu_count,
+  unsigned int cpu_self,
+  bool master
+)
+{
+  int step_count = scaling_step_count(cpu_count);
+  int variant;
+  int step;
+
+  for (variant = 0; variant < LOCK_VARIANT_COUNT; ++variant) {
+    for (step = 0; step < step_count; ++step) {
+      unsigned long counter = 0;
+      unsigned long *global_counter =
+        &ctx->scaling_global_counter[variant][step];
+
+      _SMP_barrier_Wait(&ctx->barrier, bs, cpu_count);
+
+      if (master) {
+        start_test(ctx, ctx->scaling_timeout);
+      }
+
+      wait_for_state(ctx, START_TEST);
+
+      if (cpu_self < scaling_processor_count(cpu_count, step)) {
+        if (variant == 0) {
+          counter = ticket_lock_loop(ctx, global_counter);
+        } else {
+          counter = mcs_lock_loop(ctx, global_counter);
+        }
+      }
+
+      ctx->scaling_counter[variant][step][cpu_self] = counter;
+    }
+  }
+}
+
 static void run_tests(
   global_context *ctx,
   SMP_barrier_State *bs,
@@ -235,15 +403,7 @@ static void run_tests(
     _SMP_barrier_Wait(&ctx->barrier, bs, cpu_count);
 
     if (master) {
-      rtems_status_code sc = rtems_timer_fire_after(
-        ctx->timer_id,
-        ctx->timeout,
-        stop_test_timer,
-        ctx
-      );
-      rtems_test_assert(sc == RTEMS_SUCCESSFUL);
-
-      _Atomic_Store_uint(&ctx->state, START_TEST, ATOMIC_ORDER_RELEASE);
+      start_test(ctx, ctx->timeout);
     }
 
     wait_for_state(ctx, START_TEST);
@@ -251,6 +411,8 @@ static void run_tests(
     (*test_bodies[test])(test, ctx, bs, cpu_count, cpu_self);
   }
 
+  run_scaling_tests(ctx, bs, cpu_count, cpu_self, master);
+
   _SMP_barrier_Wait(&ctx->barrier, bs, cpu_count);
 }
 
@@ -268,6 +430,55 @@ static void task(rtems_task_argument arg)
   rtems_test_assert(sc == RTEMS_SUCCESSFUL);
 }
 
+/*
+ * The fairness is the minimum local counter in percent of the maximum local
+ * counter of the contending processors.
+ */
+static void print_scaling_results(global_context *ctx, uint32_t cpu_count)
+{
+  int step_count = scaling_step_count(cpu_count);
+  int variant;
+  int step;
+
+  for (variant = 0; variant < LOCK_VARIANT_COUNT; ++variant) {
+    printf("%s scaling with busy section\n", lock_variant_names[variant]);
+
+    for (step = 0; step < step_count; ++step) {
+      const unsigned long *counter = ctx->scaling_counter[variant][step];
+      unsigned int n = scaling_processor_count(cpu_count, step);
+      unsigned long sum = 0;
+      unsigned long min = counter[0];
+      unsigned long max = counter[0];
+      unsigned long fairness;
+      unsigned int cpu;
+
+      for (cpu = 0; cpu < n; ++cpu) {
+        sum += counter[cpu];
+
+        if (counter[cpu] < min) {
+          min = counter[cpu];
+        }
+
+        if (counter[cpu] > max) {
+          max = counter[cpu];
+        }
+      }
+
+      rtems_test_assert(ctx->scaling_global_counter[variant][step] == sum);
+
+      fairness = max > 0 ? (unsigned long) ((1000ULL * min) / max) : 0;
+
+      printf(
+        "\tprocessors %u, sum of local counter %lu, fairness %lu.%01lu%%\n",
+        n,
+        sum,
+        fairness / 10,
+        fairness % 10
+      );
+    }
+  }
+}
+
 static void test(void)
 {
   global_context *ctx = &context;
@@ -298,6 +509,7 @@ static void test(void)
   }
 
   ctx->timeout = 10 * rtems_clock_get_ticks_per_second();
+  ctx->scaling_timeout = rtems_clock_get_ticks_per_second();
 
   sc = rtems_timer_create(rtems_build_name('T', 'I', 'M', 'R'), &ctx->timer_id);
   rtems_test_assert(sc == RTEMS_SUCCESSFUL);
@@ -326,7 +538,18 @@ static void test(void)
       ctx->counter[test],
       sum
     );
+
+    /* These tests increment the global counter under the global lock */
+    if (
+      test_bodies[test] == test_1_body
+        || test_bodies[test] == test_5_body
+        || test_bodies[test] == test_6_body
+    ) {
+      rtems_test_assert(ctx->counter[test] == sum);
+    }
   }
+
+  print_scaling_results(ctx, cpu_count);
 }
 
 static void Init(rtems_task_argument arg)
@@ -0,0 +1,287 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/ioctl.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems.h>
+#include <rtems/counter.h>
+#include <rtems/pipe.h>
+
+/* forward declarations to avoid warnings */
+static rtems_task Init(rtems_task_argument argument);
+
+#define RECORDS 10000
+
+#define RECORD_SIZE 16
+
+#define PRIO_WORKER 2
+
+typedef struct {
+  uint32_t seq;
+  uint8_t payload[RECORD_SIZE - sizeof(uint32_t)];
+} record;
+
+typedef struct {
+  rtems_id master;
+  rtems_id producer;
+  rtems_id consumer;
+  int fds[2];
+} test_context;
+
+static test_context test_instance;
+
+static void producer_task(rtems_task_argument arg)
+{
+  test_context *ctx = (test_context *) arg;
+  record r;
+  uint32_t i;
+
+  memset(&r, 0xa5, sizeof(r));
+
+  for (i = 0; i < RECORDS; ++i) {
+    ssize_t n;
+
+    r.seq = i;
+    n = write(ctx->fds[1], &r, sizeof(r));
+    rtems_test_assert(n == (ssize_t) sizeof(r));
+  }
+
+  rtems_task_suspend(RTEMS_SELF);
+  rtems_test_assert(0);
+}
+
+static void consumer_task(rtems_task_argument arg)
+{
+  test_context *ctx = (test_context *) arg;
+  rtems_status_code sc;
+  record r;
+  uint32_t i;
+
+  for (i = 0; i < RECORDS; ++i) {
+    ssize_t n = read(ctx->fds[0], &r, sizeof(r));
+
+    rtems_test_assert(n == (ssize_t) sizeof(r));
+    rtems_test_assert(r.seq == i);
+  }
+
+  sc = rtems_event_transient_send(ctx->master);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_task_suspend(RTEMS_SELF);
+  rtems_test_assert(0);
+}
+
+static void start_task(
+  test_context *ctx,
+  rtems_id *id,
+  rtems_name name,
+  rtems_task_entry entry
+)
+{
+  rtems_status_code sc;
+
+  sc = rtems_task_create(
+    name,
+    PRIO_WORKER,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(*id, entry, (rtems_task_argument) ctx);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void delete_task(rtems_id id)
+{
+  rtems_status_code sc;
+
+  sc = rtems_task_delete(id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void open_pipe(test_context *ctx)
+{
+  int rv;
+
+  rv = pipe(ctx->fds);
+  rtems_test_assert(rv == 0);
+}
+
+static void close_pipe(test_context *ctx)
+{
+  int rv;
+
+  rv = close(ctx->fds[0]);
+  rtems_test_assert(rv == 0);
+
+  rv = close(ctx->fds[1]);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_buffer_size(test_context *ctx)
+{
+  unsigned int size;
+  char c;
+  ssize_t n;
+  int rv;
+
+  open_pipe(ctx);
+
+  rv = ioctl(ctx->fds[0], RTEMS_PIPE_GET_BUFFER_SIZE, &size);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(size == PIPE_BUF);
+
+  errno = 0;
+  rv = ioctl(ctx->fds[0], RTEMS_PIPE_GET_BUFFER_SIZE, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EFAULT);
+
+  /* Unknown commands do not access the buffer */
+  errno = 0;
+  rv = ioctl(ctx->fds[0], -1, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  size = 3 * PIPE_BUF;
+  errno = 0;
+  rv = ioctl(ctx->fds[0], RTEMS_PIPE_SET_BUFFER_SIZE, &size);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  size = PIPE_BUF / 2;
+  errno = 0;
+  rv = ioctl(ctx->fds[0], RTEMS_PIPE_SET_BUFFER_SIZE, &size);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  c = 'x';
+  n = write(ctx->fds[1], &c, sizeof(c));
+  rtems_test_assert(n == 1);
+
+  size = 2 * PIPE_BUF;
+  errno = 0;
+  rv = ioctl(ctx->fds[1], RTEMS_PIPE_SET_BUFFER_SIZE, &size);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EBUSY);
+
+  c = '\0';
+  n = read(ctx->fds[0], &c, sizeof(c));
+  rtems_test_assert(n == 1);
+  rtems_test_assert(c == 'x');
+
+  rv = ioctl(ctx->fds[1], RTEMS_PIPE_SET_BUFFER_SIZE, &size);
+  rtems_test_assert(rv == 0);
+
+  size = 0;
+  rv = ioctl(ctx->fds[0], RTEMS_PIPE_GET_BUFFER_SIZE, &size);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(size == 2 * PIPE_BUF);
+
+  close_pipe(ctx);
+}
+
+static void test_throughput(test_context *ctx, unsigned int size)
+{
+  rtems_counter_ticks a;
+  rtems_counter_ticks b;
+  rtems_status_code sc;
+  uint64_t d;
+  int rv;
+
+  open_pipe(ctx);
+
+  rv = ioctl(ctx->fds[1], RTEMS_PIPE_SET_BUFFER_SIZE, &size);
+  rtems_test_assert(rv == 0);
+
+  a = rtems_counter_read();
+
+  start_task(ctx, &ctx->consumer, rtems_build_name('C', 'O', 'N', 'S'),
+    consumer_task);
+  start_task(ctx, &ctx->producer, rtems_build_name('P', 'R', 'O', 'D'),
+    producer_task);
+
+  sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  b = rtems_counter_read();
+  d = rtems_counter_ticks_to_nanoseconds(rtems_counter_difference(b, a));
+
+  delete_task(ctx->producer);
+  delete_task(ctx->consumer);
+  close_pipe(ctx);
+
+  printf(
+    "  <Pipe buffer-size=\"%u\">\n"
+    "    <Time unit=\"ns\">%" PRIu64 "</Time>\n"
+    "    <Throughput unit=\"B/s\">%" PRIu64 "</Throughput>\n"
+    "  </Pipe>\n",
+    size,
+    d,
+    d > 0 ? ((uint64_t) RECORDS * RECORD_SIZE * 1000000000) / d : 0
+  );
+}
+
+static void test(void)
+{
+  test_context *ctx = &test_instance;
+
+  ctx->master = rtems_task_self();
+
+  test_buffer_size(ctx);
+
+  printf(
+    "<SPFIFO06 records=\"%i\" record-size=\"%i\">\n",
+    RECORDS,
+    RECORD_SIZE
+  );
+
+  test_throughput(ctx, PIPE_BUF);
+  test_throughput(ctx, 8 * PIPE_BUF);
+  test_throughput(ctx, 64 * PIPE_BUF);
+
+  printf("</SPFIFO06>\n");
+}
+
+static rtems_task Init(rtems_task_argument argument)
+{
+  puts("\n\n*** TEST SPFIFO 6 ***");
+  test();
+  puts("*** END OF TEST SPFIFO 6 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 6
+
+#define CONFIGURE_PIPES_ENABLED
+#define CONFIGURE_MAXIMUM_PIPES 1
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
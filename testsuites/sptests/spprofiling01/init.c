@@ -0,0 +1,187 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems.h>
+#include <rtems/profiling.h>
+
+#include "tmacros.h"
+
+#define DISPATCH_COUNT 10
+
+static rtems_id master_id;
+
+static void worker_task(rtems_task_argument arg)
+{
+  while (true) {
+    rtems_status_code sc;
+
+    sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_event_transient_send(master_id);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void do_thread_dispatches(void)
+{
+  rtems_status_code sc;
+  rtems_id worker_id;
+  int i;
+
+  master_id = rtems_task_self();
+
+  sc = rtems_task_create(
+    rtems_build_name('W', 'O', 'R', 'K'),
+    1,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &worker_id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(worker_id, worker_task, 0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  for (i = 0; i < DISPATCH_COUNT; ++i) {
+    sc = rtems_event_transient_send(worker_id);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+    sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  sc = rtems_task_delete(worker_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void test_not_configured(void)
+{
+  rtems_profiling_histogram histogram;
+  rtems_status_code sc;
+
+  sc = rtems_profiling_get_histogram(
+    0,
+    RTEMS_PROFILING_THREAD_DISPATCH,
+    &histogram
+  );
+  rtems_test_assert(sc == RTEMS_NOT_CONFIGURED);
+
+  rtems_profiling_reset();
+}
+
+static void test_histogram_sum(const rtems_profiling_histogram *histogram)
+{
+  uint32_t sum = 0;
+  uint32_t bin;
+
+  for (bin = 0; bin < RTEMS_PROFILING_HISTOGRAM_BINS; ++bin) {
+    sum += histogram->bins[bin];
+  }
+
+  rtems_test_assert(sum == histogram->count);
+  rtems_test_assert(histogram->min <= histogram->mean);
+  rtems_test_assert(histogram->mean <= histogram->max);
+}
+
+static void test_configured(void)
+{
+  uint32_t cpu_index = rtems_smp_get_current_processor();
+  rtems_profiling_histogram histogram;
+  rtems_status_code sc;
+  uint32_t bin;
+
+  sc = rtems_profiling_get_histogram(
+    0,
+    RTEMS_PROFILING_THREAD_DISPATCH,
+    NULL
+  );
+  rtems_test_assert(sc == RTEMS_INVALID_ADDRESS);
+
+  sc = rtems_profiling_get_histogram(
+    rtems_smp_get_processor_count(),
+    RTEMS_PROFILING_THREAD_DISPATCH,
+    &histogram
+  );
+  rtems_test_assert(sc == RTEMS_INVALID_NUMBER);
+
+  sc = rtems_profiling_get_histogram(
+    0,
+    (rtems_profiling_type) RTEMS_PROFILING_TYPE_COUNT,
+    &histogram
+  );
+  rtems_test_assert(sc == RTEMS_INVALID_NUMBER);
+
+  for (bin = 1; bin < RTEMS_PROFILING_HISTOGRAM_BINS; ++bin) {
+    rtems_test_assert(
+      rtems_profiling_bin_limit(bin - 1) <= rtems_profiling_bin_limit(bin)
+    );
+  }
+
+  rtems_profiling_reset();
+
+  sc = rtems_profiling_get_histogram(
+    cpu_index,
+    RTEMS_PROFILING_THREAD_DISPATCH,
+    &histogram
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(histogram.count == 0);
+
+  do_thread_dispatches();
+
+  sc = rtems_profiling_get_histogram(
+    cpu_index,
+    RTEMS_PROFILING_THREAD_DISPATCH,
+    &histogram
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(histogram.count >= 2 * DISPATCH_COUNT);
+  test_histogram_sum(&histogram);
+
+  sc = rtems_profiling_get_histogram(
+    cpu_index,
+    RTEMS_PROFILING_THREAD_DISPATCH_DISABLED,
+    &histogram
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(histogram.count >= 2 * DISPATCH_COUNT);
+  test_histogram_sum(&histogram);
+
+  rtems_profiling_report();
+}
+
+static void Init(rtems_task_argument arg)
+{
+  puts("\n\n*** TEST SPPROFILING 1 ***");
+
+  if (rtems_profiling_is_configured()) {
+    test_configured();
+  } else {
+    test_not_configured();
+    rtems_profiling_report();
+  }
+
+  puts("*** END OF TEST SPPROFILING 1 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,197 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems.h>
+#include <rtems/profiling.h>
+
+#include "tmacros.h"
+
+#define INIT_PRIORITY 2
+
+#define WORKER_PRIORITY 1
+
+static rtems_id mutex_id;
+
+static rtems_id counting_id;
+
+static rtems_id master_id;
+
+static void worker_task(rtems_task_argument arg)
+{
+  rtems_status_code sc;
+
+  /* The master holds the mutex, so this is a contended acquisition */
+  sc = rtems_semaphore_obtain(mutex_id, RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_semaphore_release(mutex_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  /* The counting semaphore has no units, so this is a contended acquisition */
+  sc = rtems_semaphore_obtain(counting_id, RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_event_transient_send(master_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_task_suspend(RTEMS_SELF);
+  rtems_test_assert(0);
+}
+
+static void test_lock_stats(
+  rtems_id id,
+  uint32_t usage_count,
+  uint32_t contention_count
+)
+{
+  rtems_profiling_lock_stats stats;
+  rtems_status_code sc;
+
+  sc = rtems_profiling_get_lock_stats(id, &stats);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(stats.usage_count == usage_count);
+  rtems_test_assert(stats.contention_count == contention_count);
+  rtems_test_assert(stats.max_wait_time <= stats.total_wait_time);
+  rtems_test_assert(stats.max_hold_time <= stats.total_hold_time);
+}
+
+static void test_configured(void)
+{
+  rtems_profiling_lock_stats stats;
+  rtems_status_code sc;
+  rtems_id worker_id;
+
+  sc = rtems_profiling_get_lock_stats(mutex_id, NULL);
+  rtems_test_assert(sc == RTEMS_INVALID_ADDRESS);
+
+  sc = rtems_profiling_get_lock_stats(0, &stats);
+  rtems_test_assert(sc == RTEMS_INVALID_ID);
+
+  sc = rtems_profiling_get_lock_stats(master_id, &stats);
+  rtems_test_assert(sc == RTEMS_INVALID_ID);
+
+  test_lock_stats(mutex_id, 0, 0);
+  test_lock_stats(counting_id, 0, 0);
+
+  sc = rtems_semaphore_obtain(mutex_id, RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  test_lock_stats(mutex_id, 1, 0);
+
+  sc = rtems_task_create(
+    rtems_build_name('W', 'O', 'R', 'K'),
+    WORKER_PRIORITY,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &worker_id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  /* The worker preempts us and blocks on the mutex */
+  sc = rtems_task_start(worker_id, worker_task, 0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  /* The worker obtains and releases the mutex and blocks on the semaphore */
+  sc = rtems_semaphore_release(mutex_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  test_lock_stats(mutex_id, 2, 1);
+  test_lock_stats(counting_id, 0, 0);
+
+  sc = rtems_semaphore_release(counting_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  test_lock_stats(counting_id, 1, 1);
+
+  sc = rtems_semaphore_release(counting_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_semaphore_obtain(counting_id, RTEMS_NO_WAIT, 0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  test_lock_stats(counting_id, 2, 1);
+
+  rtems_profiling_lock_report();
+
+  sc = rtems_task_delete(worker_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void test_not_configured(void)
+{
+  rtems_profiling_lock_stats stats;
+  rtems_status_code sc;
+
+  sc = rtems_profiling_get_lock_stats(mutex_id, &stats);
+  rtems_test_assert(sc == RTEMS_NOT_CONFIGURED);
+
+  rtems_profiling_lock_report();
+}
+
+static void Init(rtems_task_argument arg)
+{
+  rtems_status_code sc;
+
+  puts("\n\n*** TEST SPPROFILING 2 ***");
+
+  master_id = rtems_task_self();
+
+  sc = rtems_semaphore_create(
+    rtems_build_name('M', 'U', 'T', 'X'),
+    1,
+    RTEMS_BINARY_SEMAPHORE | RTEMS_PRIORITY | RTEMS_INHERIT_PRIORITY,
+    0,
+    &mutex_id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_semaphore_create(
+    rtems_build_name('C', 'N', 'T', 'S'),
+    0,
+    RTEMS_COUNTING_SEMAPHORE | RTEMS_PRIORITY,
+    0,
+    &counting_id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  if (rtems_profiling_is_configured()) {
+    test_configured();
+  } else {
+    test_not_configured();
+  }
+
+  sc = rtems_semaphore_delete(counting_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_semaphore_delete(mutex_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  puts("*** END OF TEST SPPROFILING 2 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+#define CONFIGURE_MAXIMUM_SEMAPHORES 2
+
+#define CONFIGURE_INIT_TASK_PRIORITY INIT_PRIORITY
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,155 @@
+/*
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems.h>
+
+#include "tmacros.h"
+
+#define PERIOD_LENGTH 2
+
+#define JOB_COUNT 3
+
+static void test_histogram_sum(const rtems_profiling_histogram *histogram)
+{
+  uint32_t sum = 0;
+  uint32_t bin;
+
+  for (bin = 0; bin < RTEMS_PROFILING_HISTOGRAM_BINS; ++bin) {
+    sum += histogram->bins[bin];
+  }
+
+  rtems_test_assert(sum == histogram->count);
+  rtems_test_assert(histogram->min <= histogram->mean);
+  rtems_test_assert(histogram->mean <= histogram->max);
+}
+
+static void test_histograms(
+  rtems_id period_id,
+  uint32_t response_count,
+  uint32_t jitter_count,
+  uint32_t deadline_miss_count
+)
+{
+  rtems_rate_monotonic_period_histograms histograms;
+  rtems_status_code sc;
+
+  sc = rtems_rate_monotonic_get_histograms(period_id, &histograms);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(histograms.response_time.count == response_count);
+  rtems_test_assert(histograms.release_jitter.count == jitter_count);
+  rtems_test_assert(histograms.deadline_miss_count == deadline_miss_count);
+  test_histogram_sum(&histograms.response_time);
+  test_histogram_sum(&histograms.release_jitter);
+}
+
+static void test_configured(rtems_id period_id)
+{
+  rtems_rate_monotonic_period_histograms histograms;
+  rtems_status_code sc;
+  int i;
+
+  sc = rtems_rate_monotonic_get_histograms(period_id, NULL);
+  rtems_test_assert(sc == RTEMS_INVALID_ADDRESS);
+
+  sc = rtems_rate_monotonic_get_histograms(0, &histograms);
+  rtems_test_assert(sc == RTEMS_INVALID_ID);
+
+  test_histograms(period_id, 0, 0, 0);
+
+  sc = rtems_rate_monotonic_period(period_id, PERIOD_LENGTH);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  for (i = 0; i < JOB_COUNT; ++i) {
+    sc = rtems_rate_monotonic_period(period_id, PERIOD_LENGTH);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  test_histograms(period_id, JOB_COUNT, JOB_COUNT, 0);
+
+  /* Overrun the current job */
+  sc = rtems_task_wake_after(2 * PERIOD_LENGTH + 1);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_rate_monotonic_period(period_id, PERIOD_LENGTH);
+  rtems_test_assert(sc == RTEMS_TIMEOUT);
+
+  test_histograms(period_id, JOB_COUNT + 1, JOB_COUNT, 1);
+
+  sc = rtems_rate_monotonic_get_histograms(period_id, &histograms);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  rtems_test_assert(
+    histograms.response_time.max >= histograms.response_time.mean
+  );
+#ifndef __RTEMS_USE_TICKS_FOR_STATISTICS__
+  rtems_test_assert(
+    histograms.deadline_misses[0].tv_sec != 0
+      || histograms.deadline_misses[0].tv_nsec != 0
+  );
+#else
+  rtems_test_assert(histograms.deadline_misses[0] != 0);
+#endif
+
+  rtems_rate_monotonic_report_histograms();
+
+  sc = rtems_rate_monotonic_reset_statistics(period_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  test_histograms(period_id, 0, 0, 0);
+}
+
+static void test_not_configured(rtems_id period_id)
+{
+  rtems_rate_monotonic_period_histograms histograms;
+  rtems_status_code sc;
+
+  sc = rtems_rate_monotonic_get_histograms(period_id, &histograms);
+  rtems_test_assert(sc == RTEMS_NOT_CONFIGURED);
+
+  rtems_rate_monotonic_report_histograms();
+}
+
+static void Init(rtems_task_argument arg)
+{
+  rtems_status_code sc;
+  rtems_id period_id;
+
+  puts("\n\n*** TEST SPPROFILING 3 ***");
+
+  sc = rtems_rate_monotonic_create(
+    rtems_build_name('P', 'E', 'R', 'D'),
+    &period_id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  if (rtems_profiling_is_configured()) {
+    test_configured(period_id);
+  } else {
+    test_not_configured(period_id);
+  }
+
+  sc = rtems_rate_monotonic_delete(period_id);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  puts("*** END OF TEST SPPROFILING 3 ***");
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+#define CONFIGURE_MAXIMUM_PERIODS 1
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
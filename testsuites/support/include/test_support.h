@@ -10,6 +10,9 @@
 #ifndef __TEST_SUPPORT_h
 #define __TEST_SUPPORT_h
 
+#include <stddef.h>
+#include <rtems/counter.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -60,6 +63,17 @@ void rtems_time_test_measure_operation(
   int                       overhead
 );
 
+/*
+ *  Print a machine-readable timing record with the minimum, median, 99th
+ *  percentile and maximum of the samples in CPU counter ticks.  The samples
+ *  are sorted in place.
+ */
+void rtems_time_test_put_samples(
+  const char          *description,
+  rtems_counter_ticks *samples,
+  size_t               count
+);
+
 /*********************************************************************/
 /*********************************************************************/
 /**************              TEST SUPPORT               **************/
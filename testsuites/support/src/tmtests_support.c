@@ -15,10 +15,185 @@
 
 #include <bsp.h>
 #include <rtems/timerdrv.h>
+#include <stdlib.h>
 #include "test_support.h"
 #include "timesys.h"
 #include "tmtests_empty_function.h"
 
+static int rtems_time_test_compare_samples(
+  const void *a,
+  const void *b
+)
+{
+  rtems_counter_ticks sa = *(const rtems_counter_ticks *) a;
+  rtems_counter_ticks sb = *(const rtems_counter_ticks *) b;
+
+  if ( sa < sb )
+    return -1;
+
+  return sa > sb ? 1 : 0;
+}
+
+void rtems_time_test_put_samples(
+  const char          *description,
+  rtems_counter_ticks *samples,
+  size_t               count
+)
+{
+  size_t p99;
+
+  if ( count == 0 )
+    return;
+
+  qsort( samples, count, sizeof( *samples ), rtems_time_test_compare_samples );
+
+  /* Nearest rank method */
+  p99 = ( 99 * count + 99 ) / 100 - 1;
+
+  printf(
+    "<TimingMeasurement name=\"%s\" unit=\"ns\" samples=\"%lu\""
+      " min=\"%" PRIu64 "\" median=\"%" PRIu64 "\" p99=\"%" PRIu64 "\""
+      " max=\"%" PRIu64 "\"/>\n",
+    description,
+    (unsigned long) count,
+    rtems_counter_ticks_to_nanoseconds( samples[ 0 ] ),
+    rtems_counter_ticks_to_nanoseconds( samples[ count / 2 ] ),
+    rtems_counter_ticks_to_nanoseconds( samples[ p99 ] ),
+    rtems_counter_ticks_to_nanoseconds( samples[ count - 1 ] )
+  );
+}
+
+#if TIMING_STATISTICS
+rtems_time_test_sample_set rtems_time_test_samples;
+
+void rtems_time_test_sample_begin( rtems_time_test_sample_set *set )
+{
+  set->start = rtems_counter_read();
+}
+
+static void rtems_time_test_sample_add(
+  rtems_time_test_sample_set *set,
+  rtems_counter_ticks         now
+)
+{
+  uint32_t i;
+
+  if ( set->skip > 0 ) {
+    --set->skip;
+    return;
+  }
+
+  if ( set->count == TIME_SAMPLES_MAXIMUM ) {
+    for ( i = 0 ; i < TIME_SAMPLES_MAXIMUM / 2 ; i++ )
+      set->samples[ i ] = set->samples[ 2 * i + 1 ];
+
+    set->count = TIME_SAMPLES_MAXIMUM / 2;
+    ++set->shift;
+  }
+
+  set->samples[ set->count ] = rtems_counter_difference( now, set->start );
+  ++set->count;
+  set->skip = ( 1U << set->shift ) - 1;
+}
+
+void rtems_time_test_sample_end( rtems_time_test_sample_set *set )
+{
+  rtems_time_test_sample_add( set, rtems_counter_read() );
+}
+
+void rtems_time_test_sample_next( rtems_time_test_sample_set *set )
+{
+  rtems_counter_ticks now = rtems_counter_read();
+
+  rtems_time_test_sample_add( set, now );
+  set->start = now;
+}
+
+void rtems_time_test_sample_use( rtems_time_test_sample_set *set )
+{
+  rtems_time_test_samples = *set;
+
+  set->count = 0;
+  set->shift = 0;
+  set->skip = 0;
+}
+
+/*
+ *  The minimum time of an empty sample is the overhead of the sampling.
+ */
+static rtems_counter_ticks rtems_time_test_sample_overhead(
+  rtems_time_test_sample_set *set
+)
+{
+  rtems_counter_ticks overhead = 0;
+  int                 i;
+
+  for ( i = 0 ; i < 16 ; i++ ) {
+    rtems_counter_ticks d;
+
+    rtems_time_test_sample_begin( set );
+    d = rtems_counter_difference( rtems_counter_read(), set->start );
+
+    if ( i == 0 || d < overhead )
+      overhead = d;
+  }
+
+  return overhead;
+}
+
+void rtems_time_test_put_sample_set(
+  const char                 *description,
+  rtems_time_test_sample_set *set
+)
+{
+  rtems_counter_ticks overhead;
+  uint32_t            i;
+
+  if ( set->count == 0 )
+    return;
+
+  overhead = rtems_time_test_sample_overhead( set );
+
+  for ( i = 0 ; i < set->count ; i++ ) {
+    rtems_counter_ticks d = set->samples[ i ];
+
+    set->samples[ i ] = d > overhead ? d - overhead : 0;
+  }
+
+  rtems_time_test_put_samples( description, set->samples, set->count );
+
+  set->count = 0;
+  set->shift = 0;
+  set->skip = 0;
+}
+
+/*
+ *  Sample each iteration with the CPU counter.  The minimum sample of the
+ *  empty operation is the overhead of the sampling and is subtracted from the
+ *  operation samples.  The sampling overhead is also included in the total
+ *  time reported by put_time().
+ */
+static void rtems_time_test_sample_operation(
+  rtems_counter_ticks      *samples,
+  rtems_time_test_method_t  operation,
+  void                     *argument,
+  int                       iterations,
+  rtems_counter_ticks       overhead
+)
+{
+  int i;
+
+  for (i=0 ; i<iterations ; i++ ) {
+    rtems_counter_ticks a = rtems_counter_read();
+    rtems_counter_ticks d;
+
+    (*operation)( i, argument );
+    d = rtems_counter_difference( rtems_counter_read(), a );
+    samples[ i ] = d > overhead ? d - overhead : 0;
+  }
+}
+#endif
+
 void rtems_time_test_measure_operation(
   const char               *description,
   rtems_time_test_method_t  operation,
@@ -27,9 +202,42 @@ void rtems_time_test_measure_operation(
   int                       overhead
 )
 {
-  int  i;
   uint32_t loop_overhead;
   uint32_t end_time;
+#if TIMING_STATISTICS
+  rtems_counter_ticks *samples;
+
+  samples = malloc( iterations * sizeof( *samples ) );
+  rtems_test_assert( samples != NULL );
+
+  benchmark_timer_initialize();
+    rtems_time_test_sample_operation(
+      samples,
+      benchmark_timer_empty_operation,
+      argument,
+      iterations,
+      0
+    );
+  loop_overhead = benchmark_timer_read();
+
+  qsort(
+    samples,
+    iterations,
+    sizeof( *samples ),
+    rtems_time_test_compare_samples
+  );
+
+  benchmark_timer_initialize();
+    rtems_time_test_sample_operation(
+      samples,
+      operation,
+      argument,
+      iterations,
+      samples[ 0 ]
+    );
+  end_time = benchmark_timer_read();
+#else
+  int  i;
 
   benchmark_timer_initialize();
     for (i=0 ; i<iterations ; i++ ) {
@@ -42,6 +250,7 @@ void rtems_time_test_measure_operation(
       (*operation)( i, argument );
     }
   end_time = benchmark_timer_read();
+#endif
 
   put_time(
     description,
@@ -50,4 +259,9 @@ void rtems_time_test_measure_operation(
     loop_overhead,
     overhead
   );
+
+#if TIMING_STATISTICS
+  rtems_time_test_put_samples( description, samples, iterations );
+  free( samples );
+#endif
 }
@@ -15,8 +15,12 @@
  *  http://www.rtems.com/license/LICENSE.
  */
 
+#ifndef __TIMESYS_h
+#define __TIMESYS_h
+
 #include <tmacros.h>
 #include <inttypes.h>
+#include <rtems/counter.h>
 
 /*
  *  This constant determines the maximum number of a resource
@@ -34,15 +38,143 @@
 #define OPERATION_COUNT 100
 #endif
 
+/*
+ *  This constant enables the machine-readable timing records.  Each
+ *  put_time() prints in addition to the human-readable line a record with
+ *  the mean time of an iteration in timer units.  The measured operations
+ *  are in addition sampled individually with the CPU counter, either by
+ *  rtems_time_test_measure_operation() or by the time_sample_begin(),
+ *  time_sample_end() and time_sample_next() markers around the operation.
+ *  The minimum, median, 99th percentile and maximum of the samples are
+ *  reported in nanoseconds by the next put_time().  The records have the
+ *  form
+ *
+ *  <TimingMeasurement name="..." unit="..." samples="..." .../>
+ *
+ *  and may be compared with the rtems-tmcompare host tool.
+ */
+
+#ifndef TIMING_STATISTICS
+#define TIMING_STATISTICS 0
+#endif
+
+#if TIMING_STATISTICS
+/*
+ *  A sample set holds at most this number of samples.  If it is full, every
+ *  second sample is dropped and from then on only every second operation is
+ *  sampled.
+ */
+#define TIME_SAMPLES_MAXIMUM OPERATION_COUNT
+
+typedef struct {
+  rtems_counter_ticks start;
+  uint32_t            count;
+  uint32_t            shift;
+  uint32_t            skip;
+  rtems_counter_ticks samples[ TIME_SAMPLES_MAXIMUM ];
+} rtems_time_test_sample_set;
+
+/*
+ *  The sample set used by the time_sample_*() markers and put_time().  Tests
+ *  which report a measurement not directly after it sample into a set of
+ *  their own with the time_sample_*_in() markers and select it for the
+ *  put_time() of the measurement with time_sample_use().
+ */
+extern rtems_time_test_sample_set rtems_time_test_samples;
+
+/*
+ *  Start a sample of the set.
+ */
+void rtems_time_test_sample_begin( rtems_time_test_sample_set *set );
+
+/*
+ *  End the running sample of the set and add it.
+ */
+void rtems_time_test_sample_end( rtems_time_test_sample_set *set );
+
+/*
+ *  End the running sample of the set, add it and start the next sample.
+ *  This is used if the operations follow each other in different tasks.
+ */
+void rtems_time_test_sample_next( rtems_time_test_sample_set *set );
+
+/*
+ *  Move the samples of the set to the set used by put_time() and empty the
+ *  set.
+ */
+void rtems_time_test_sample_use( rtems_time_test_sample_set *set );
+
+/*
+ *  Print the record of the samples of the set without the sampling overhead
+ *  and empty the set.  Nothing is printed if the set is empty.
+ */
+void rtems_time_test_put_sample_set(
+  const char                 *description,
+  rtems_time_test_sample_set *set
+);
+#endif
+
 /* functions */
 
-#define put_time( _message, _total_time, \
-                  _iterations, _loop_overhead, _overhead ) \
+#if TIMING_STATISTICS
+#define time_sample_begin_in( _set ) \
+    rtems_time_test_sample_begin( &(_set) )
+
+#define time_sample_end_in( _set ) \
+    rtems_time_test_sample_end( &(_set) )
+
+#define time_sample_next_in( _set ) \
+    rtems_time_test_sample_next( &(_set) )
+
+#define time_sample_use( _set ) \
+    rtems_time_test_sample_use( &(_set) )
+
+#define time_sample_begin() time_sample_begin_in( rtems_time_test_samples )
+
+#define time_sample_end() time_sample_end_in( rtems_time_test_samples )
+
+#define time_sample_next() time_sample_next_in( rtems_time_test_samples )
+
+#define put_time_record( _message, _iterations, _value ) \
+  do { \
     printf( \
-      "%s - %" PRId32 "\n", \
+      "<TimingMeasurement name=\"%s\" unit=\"timer\" samples=\"%" PRIu32 \
+        "\" mean=\"%" PRId32 "\"/>\n", \
       (_message), \
+      (uint32_t) (_iterations), \
+      (_value) \
+    ); \
+    rtems_time_test_put_sample_set( (_message), &rtems_time_test_samples ); \
+  } while (0)
+#else
+#define time_sample_begin_in( _set ) do { } while (0)
+
+#define time_sample_end_in( _set ) do { } while (0)
+
+#define time_sample_next_in( _set ) do { } while (0)
+
+#define time_sample_use( _set ) do { } while (0)
+
+#define time_sample_begin() do { } while (0)
+
+#define time_sample_end() do { } while (0)
+
+#define time_sample_next() do { } while (0)
+
+#define put_time_record( _message, _iterations, _value ) \
+    do { } while (0)
+#endif
+
+#define put_time( _message, _total_time, \
+                  _iterations, _loop_overhead, _overhead ) \
+  do { \
+    int32_t _put_time_value = (int32_t) ( \
       (((_total_time) - (_loop_overhead)) / (_iterations)) - (_overhead) \
-    )
+    ); \
+    \
+    printf( "%s - %" PRId32 "\n", (_message), _put_time_value ); \
+    put_time_record( (_message), (_iterations), _put_time_value ); \
+  } while (0)
 
 #if  defined(CONFIGURE_STACK_CHECKER_ENABLED) || defined(RTEMS_DEBUG)
 #define Print_Warning() \
@@ -63,4 +195,5 @@
 TEST_EXTERN volatile uint32_t   end_time;   /* ending time variable */
 TEST_EXTERN volatile uint32_t   overhead;   /* loop overhead variable */
 
+#endif
 /* end of include file */
@@ -18,6 +18,16 @@ rtems_task Test_task(
   rtems_task_argument argument
 );
 
+#if TIMING_STATISTICS
+/*
+ *  The loops of the operations are interleaved, so sample each operation
+ *  in a set of its own.
+ */
+static rtems_time_test_sample_set semaphore_obtain_samples;
+static rtems_time_test_sample_set semaphore_obtain_no_wait_samples;
+static rtems_time_test_sample_set semaphore_release_samples;
+#endif
+
 rtems_task Init(
   rtems_task_argument argument
 )
@@ -77,6 +87,7 @@ rtems_task Test_task(
   /* Time one invocation of rtems_semaphore_create */
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_semaphore_create(
       name,
       OPERATION_COUNT,
@@ -84,6 +95,7 @@ rtems_task Test_task(
       RTEMS_NO_PRIORITY,
       &smid
     );
+    time_sample_end();
   end_time = benchmark_timer_read();
   put_time(
     "rtems_semaphore_create: only case",
@@ -96,7 +108,9 @@ rtems_task Test_task(
   /* Time one invocation of rtems_semaphore_delete */
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_semaphore_delete( smid );
+    time_sample_end();
   end_time = benchmark_timer_read();
   put_time(
     "rtems_semaphore_delete: only case",
@@ -128,12 +142,15 @@ rtems_task Test_task(
     /* rtems_semaphore_obtain (available) */
 
     benchmark_timer_initialize();
-      for ( index = 1 ; index<=OPERATION_COUNT ; index++ )
+      for ( index = 1 ; index<=OPERATION_COUNT ; index++ ) {
+        time_sample_begin_in( semaphore_obtain_samples );
         (void) rtems_semaphore_obtain(
           smid,
           RTEMS_DEFAULT_OPTIONS,
           RTEMS_NO_TIMEOUT
         );
+        time_sample_end_in( semaphore_obtain_samples );
+      }
     end_time = benchmark_timer_read();
 
     semaphore_obtain_time += end_time;
@@ -141,26 +158,36 @@ rtems_task Test_task(
     /* rtems_semaphore_release */
 
     benchmark_timer_initialize();
-      for ( index = 1 ; index<=OPERATION_COUNT ; index++ )
+      for ( index = 1 ; index<=OPERATION_COUNT ; index++ ) {
+        time_sample_begin_in( semaphore_release_samples );
         (void) rtems_semaphore_release( smid );
+        time_sample_end_in( semaphore_release_samples );
+      }
     end_time = benchmark_timer_read();
 
     semaphore_release_time += end_time;
 
     /* semaphore obtain (RTEMS_NO_WAIT) */
     benchmark_timer_initialize();
-      for ( index = 1 ; index<=OPERATION_COUNT ; index++ )
+      for ( index = 1 ; index<=OPERATION_COUNT ; index++ ) {
+        time_sample_begin_in( semaphore_obtain_no_wait_samples );
         rtems_semaphore_obtain( smid, RTEMS_NO_WAIT, RTEMS_NO_TIMEOUT );
+        time_sample_end_in( semaphore_obtain_no_wait_samples );
+      }
     semaphore_obtain_no_wait_time += benchmark_timer_read();
 
     benchmark_timer_initialize();
-      for ( index = 1 ; index<=OPERATION_COUNT ; index++ )
+      for ( index = 1 ; index<=OPERATION_COUNT ; index++ ) {
+        time_sample_begin_in( semaphore_release_samples );
         rtems_semaphore_release( smid );
+        time_sample_end_in( semaphore_release_samples );
+      }
     end_time = benchmark_timer_read();
 
     semaphore_release_time += end_time;
   }
 
+  time_sample_use( semaphore_obtain_samples );
   put_time(
     "rtems_semaphore_obtain: available",
     semaphore_obtain_time,
@@ -169,6 +196,7 @@ rtems_task Test_task(
     CALLING_OVERHEAD_SEMAPHORE_OBTAIN
   );
 
+  time_sample_use( semaphore_obtain_no_wait_samples );
   put_time(
     "rtems_semaphore_obtain: not available NO_WAIT",
     semaphore_obtain_no_wait_time,
@@ -177,6 +205,7 @@ rtems_task Test_task(
     CALLING_OVERHEAD_SEMAPHORE_OBTAIN
   );
 
+  time_sample_use( semaphore_release_samples );
   put_time(
     "rtems_semaphore_release: no waiting tasks",
     semaphore_release_time,
@@ -121,6 +121,7 @@ rtems_task High_task(
 {
   /* start blocking rtems_semaphore_obtain time */
   benchmark_timer_initialize();
+  time_sample_begin();
 
   (void) rtems_semaphore_obtain(
     Semaphore_id,
@@ -133,6 +134,7 @@ rtems_task Middle_tasks(
   rtems_task_argument argument
 )
 {
+  time_sample_next();
   (void) rtems_semaphore_obtain(
     Semaphore_id,
     RTEMS_DEFAULT_OPTIONS,
@@ -144,6 +146,7 @@ rtems_task Low_task(
   rtems_task_argument argument
 )
 {
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -109,6 +109,7 @@ rtems_task test_init(
   directive_failed( status, "rtems_task_start of high task" );
 
   benchmark_timer_initialize();                          /* start the timer */
+  time_sample_begin();
   status = rtems_semaphore_release( Semaphore_id );
 }
 
@@ -121,6 +122,7 @@ rtems_task Middle_tasks(
     RTEMS_DEFAULT_OPTIONS,
     RTEMS_NO_TIMEOUT
   );
+  time_sample_next();
 
   (void) rtems_semaphore_release( Semaphore_id );
 }
@@ -135,6 +137,7 @@ rtems_task High_task(
     RTEMS_NO_TIMEOUT
   );
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
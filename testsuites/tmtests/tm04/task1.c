@@ -95,6 +95,7 @@ rtems_task Highest_task(
 
   if ( argument == 1 ) {
 
+    time_sample_end();
     end_time = benchmark_timer_read();
 
     put_time(
@@ -114,6 +115,7 @@ rtems_task Highest_task(
 
  } else if ( argument == 2 ) {
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
     put_time(
@@ -146,10 +148,12 @@ rtems_task High_task(
   rtems_task_priority old_priority;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_task_restart( Highest_id, 1 );
   /* preempted by Higher_task */
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_task_restart( Highest_id, 2 );
   /* preempted by Higher_task */
 
@@ -159,8 +163,11 @@ rtems_task High_task(
   overhead = benchmark_timer_read();
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       rtems_semaphore_release( Semaphore_id );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -179,7 +186,8 @@ rtems_task High_task(
   }
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
      rtems_task_create(
         name,
         10,
@@ -188,6 +196,8 @@ rtems_task High_task(
         RTEMS_DEFAULT_ATTRIBUTES,
         &Task_id[ index ]
       );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -199,8 +209,11 @@ rtems_task High_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       rtems_task_start( Task_id[ index ], Low_tasks, 0 );
+      time_sample_end();
+    }
 
   end_time = benchmark_timer_read();
 
@@ -236,8 +249,11 @@ rtems_task High_task(
   }
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_restart( Task_id[ index ], 0 );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -252,8 +268,11 @@ rtems_task High_task(
     (void) rtems_task_suspend( Task_id[ index ] );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_delete( Task_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -280,8 +299,11 @@ rtems_task High_task(
   }
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_restart( Task_id[ index ], 1 );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -302,8 +324,11 @@ rtems_task High_task(
   directive_failed( status, "rtems_task_wake_after" );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_restart( Task_id[ index ], 1 );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -319,8 +344,11 @@ rtems_task High_task(
   directive_failed( status, "rtems_task_wake_after" );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_delete( Task_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
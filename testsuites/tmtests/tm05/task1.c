@@ -89,9 +89,11 @@ rtems_task High_task(
 )
 {
   benchmark_timer_initialize();
+  time_sample_begin();
 
   (void) rtems_task_suspend( RTEMS_SELF );
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -110,7 +112,9 @@ rtems_task Middle_tasks(
   rtems_task_argument argument
 )
 {
+  time_sample_next();
   (void) rtems_task_suspend( RTEMS_SELF );
+  time_sample_next();
 
   Task_index++;
   (void) rtems_task_resume( Task_id[ Task_index ] );
@@ -121,6 +125,7 @@ rtems_task Low_task(
 )
 {
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -133,5 +138,6 @@ rtems_task Low_task(
 
   Task_index = 1;
   benchmark_timer_initialize();
+  time_sample_begin();
   (void) rtems_task_resume( Task_id[ Task_index ] );
 }
@@ -72,8 +72,11 @@ rtems_task Task_1(
   rtems_status_code status;
   uint32_t    index;
 
-  if ( Task_restarted == OPERATION_COUNT )
+  if ( Task_restarted == OPERATION_COUNT ) {
      benchmark_timer_initialize();
+     time_sample_begin();
+  } else
+     time_sample_next();
 
   Task_restarted--;
 
@@ -111,8 +114,11 @@ rtems_task Task_1(
   }
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_suspend( Task_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -124,8 +130,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_resume( Task_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -137,8 +146,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_delete( Task_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -86,6 +86,7 @@ rtems_task High_task(
 )
 {
   if ( argument != 0 ) {
+    time_sample_end();
     end_time = benchmark_timer_read();
 
     put_time(
@@ -108,9 +109,10 @@ rtems_task Middle_tasks(
 {
   task_index++;
 
-  if ( argument != 0 )
+  if ( argument != 0 ) {
+    time_sample_next();
     (void) rtems_task_restart( Task_id[ task_index ], 0xffffffff );
-  else
+  } else
     (void) rtems_task_suspend( RTEMS_SELF );
 }
 
@@ -121,5 +123,6 @@ rtems_task Low_task(
   task_index = 1;
 
   benchmark_timer_initialize();
+  time_sample_begin();
   (void) rtems_task_restart( Task_id[ task_index ], 0xffffffff );
 }
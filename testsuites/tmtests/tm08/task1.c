@@ -88,12 +88,15 @@ rtems_task test_task(
   overhead = benchmark_timer_read();
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_set_priority(
                Test_task_id,
                RTEMS_CURRENT_PRIORITY,
                &old_priority
              );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -105,12 +108,15 @@ rtems_task test_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_set_priority(
         Test_task_id,
         RTEMS_MAXIMUM_PRIORITY - 2u,
         &old_priority
       );
+      time_sample_end();
+    }
 
   end_time = benchmark_timer_read();
 
@@ -123,12 +129,15 @@ rtems_task test_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_mode(
         RTEMS_CURRENT_MODE,
         RTEMS_CURRENT_MODE,
         &old_mode
       );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -141,6 +150,7 @@ rtems_task test_task(
 
   benchmark_timer_initialize();
     for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_mode(
         RTEMS_INTERRUPT_LEVEL(1),
         RTEMS_INTERRUPT_MASK,
@@ -151,6 +161,7 @@ rtems_task test_task(
         RTEMS_INTERRUPT_MASK,
         &old_mode
       );
+      time_sample_end();
     }
   end_time = benchmark_timer_read();
 
@@ -163,7 +174,9 @@ rtems_task test_task(
   );
 
   benchmark_timer_initialize();                 /* must be one host */
+    time_sample_begin();
     (void) rtems_task_mode( RTEMS_NO_ASR, RTEMS_ASR_MASK, &old_mode );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -182,11 +195,15 @@ rtems_task test_task(
 
   /* preempted by test_task1 */
   benchmark_timer_initialize();
+    time_sample_begin();
     (void)  rtems_task_mode( RTEMS_PREEMPT, RTEMS_PREEMPT_MASK, &old_mode );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_set_note( Test_task_id, 8, 10 );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -198,8 +215,11 @@ rtems_task test_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_get_note( Test_task_id, 8, &old_note );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -213,8 +233,11 @@ rtems_task test_task(
   build_time( &time, 1, 1, 1988, 0, 0, 0, 0 );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_clock_set( &time );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -226,8 +249,11 @@ rtems_task test_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_clock_get_tod( &time );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -246,6 +272,7 @@ rtems_task test_task1(
   rtems_task_argument argument
 )
 {
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -21,6 +21,18 @@ rtems_task Test_task(
 );
 void queue_test(void);
 
+#if TIMING_STATISTICS
+/*
+ *  The loops of the operations are interleaved, so sample each operation
+ *  in a set of its own.
+ */
+static rtems_time_test_sample_set send_samples;
+static rtems_time_test_sample_set urgent_samples;
+static rtems_time_test_sample_set receive_samples;
+static rtems_time_test_sample_set empty_flush_samples;
+static rtems_time_test_sample_set flush_samples;
+#endif
+
 rtems_task Init(
   rtems_task_argument argument
 )
@@ -53,6 +65,7 @@ rtems_task Test_task (
 )
 {
   benchmark_timer_initialize();
+    time_sample_begin();
     rtems_message_queue_create(
       1,
       OPERATION_COUNT,
@@ -60,6 +73,7 @@ rtems_task Test_task (
       RTEMS_DEFAULT_ATTRIBUTES,
       &Queue_id
     );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -73,7 +87,9 @@ rtems_task Test_task (
   queue_test();
 
   benchmark_timer_initialize();
+    time_sample_begin();
     rtems_message_queue_delete( Queue_id );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -135,12 +151,16 @@ void queue_test(void)
     receive_loop_time += benchmark_timer_read();
 
     benchmark_timer_initialize();
-      for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+      for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+        time_sample_begin_in( send_samples );
         (void) rtems_message_queue_send( Queue_id, buffer, MESSAGE_SIZE );
+        time_sample_end_in( send_samples );
+      }
     send_time += benchmark_timer_read();
 
     benchmark_timer_initialize();
-      for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+      for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+        time_sample_begin_in( receive_samples );
         (void) rtems_message_queue_receive(
                  Queue_id,
                  (long (*)[4])buffer,
@@ -148,15 +168,21 @@ void queue_test(void)
                  RTEMS_DEFAULT_OPTIONS,
                  RTEMS_NO_TIMEOUT
                );
+        time_sample_end_in( receive_samples );
+      }
     receive_time += benchmark_timer_read();
 
     benchmark_timer_initialize();
-      for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+      for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+        time_sample_begin_in( urgent_samples );
         (void) rtems_message_queue_urgent( Queue_id, buffer, MESSAGE_SIZE );
+        time_sample_end_in( urgent_samples );
+      }
     urgent_time += benchmark_timer_read();
 
     benchmark_timer_initialize();
-      for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+      for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+        time_sample_begin_in( receive_samples );
         (void) rtems_message_queue_receive(
                  Queue_id,
                  (long (*)[4])buffer,
@@ -164,10 +190,14 @@ void queue_test(void)
                  RTEMS_DEFAULT_OPTIONS,
                  RTEMS_NO_TIMEOUT
                );
+        time_sample_end_in( receive_samples );
+      }
     receive_time += benchmark_timer_read();
 
     benchmark_timer_initialize();
+    time_sample_begin_in( empty_flush_samples );
       rtems_message_queue_flush( Queue_id, &empty_flush_count );
+    time_sample_end_in( empty_flush_samples );
     empty_flush_time += benchmark_timer_read();
 
     /* send one message to flush */
@@ -179,10 +209,13 @@ void queue_test(void)
     directive_failed( status, "rtems_message_queue_send" );
 
     benchmark_timer_initialize();
+    time_sample_begin_in( flush_samples );
       rtems_message_queue_flush( Queue_id, &flush_count );
+    time_sample_end_in( flush_samples );
     flush_time += benchmark_timer_read();
   }
 
+  time_sample_use( send_samples );
   put_time(
     "rtems_message_queue_send: no waiting tasks",
     send_time,
@@ -191,6 +224,7 @@ void queue_test(void)
     CALLING_OVERHEAD_MESSAGE_QUEUE_SEND
   );
 
+  time_sample_use( urgent_samples );
   put_time(
     "rtems_message_queue_urgent: no waiting tasks",
     urgent_time,
@@ -199,6 +233,7 @@ void queue_test(void)
     CALLING_OVERHEAD_MESSAGE_QUEUE_URGENT
   );
 
+  time_sample_use( receive_samples );
   put_time(
     "rtems_message_queue_receive: available",
     receive_time,
@@ -207,6 +242,7 @@ void queue_test(void)
     CALLING_OVERHEAD_MESSAGE_QUEUE_RECEIVE
   );
 
+  time_sample_use( empty_flush_samples );
   put_time(
     "rtems_message_queue_flush: no messages flushed",
     empty_flush_time,
@@ -215,6 +251,7 @@ void queue_test(void)
     CALLING_OVERHEAD_MESSAGE_QUEUE_FLUSH
   );
 
+  time_sample_use( flush_samples );
   put_time(
     "rtems_message_queue_flush: messages flushed",
     flush_time,
@@ -99,7 +99,8 @@ void test_init()
   overhead = benchmark_timer_read();
 
   benchmark_timer_initialize();
-    for ( index=1 ; index < operation_count ; index++ )
+    for ( index=1 ; index < operation_count ; index++ ) {
+      time_sample_begin();
       (void) rtems_message_queue_receive(
                Queue_id,
                (long (*)[4]) Buffer,
@@ -107,6 +108,8 @@ void test_init()
                RTEMS_NO_WAIT,
                RTEMS_NO_TIMEOUT
              );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -126,6 +129,7 @@ rtems_task High_task(
   size_t  size;
 
   benchmark_timer_initialize();
+  time_sample_begin();
      (void) rtems_message_queue_receive(
               Queue_id,
               (long (*)[4]) Buffer,
@@ -141,6 +145,7 @@ rtems_task Middle_tasks(
 {
   size_t  size;
 
+  time_sample_next();
   (void) rtems_message_queue_receive(
            Queue_id,
            (long (*)[4]) Buffer,
@@ -155,6 +160,7 @@ rtems_task Low_task(
   rtems_task_argument argument
 )
 {
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -111,6 +111,7 @@ rtems_task test_init(
   }
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_message_queue_send( Queue_id, Buffer, MESSAGE_SIZE );
 }
 
@@ -127,6 +128,7 @@ rtems_task Middle_tasks(
            RTEMS_DEFAULT_OPTIONS,
            RTEMS_NO_TIMEOUT
          );
+  time_sample_next();
 
   (void) rtems_message_queue_send( Queue_id, (long (*)[4]) Buffer, size );
 }
@@ -145,6 +147,7 @@ rtems_task High_task(
            RTEMS_NO_TIMEOUT
          );
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -112,6 +112,7 @@ rtems_task test_init(
   }
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_message_queue_urgent( Queue_id, Buffer, MESSAGE_SIZE );
 }
 
@@ -128,6 +129,7 @@ rtems_task Middle_tasks(
            RTEMS_DEFAULT_OPTIONS,
            RTEMS_NO_TIMEOUT
          );
+  time_sample_next();
 
   (void) rtems_message_queue_urgent( Queue_id, (long (*)[4]) Buffer, size );
 }
@@ -146,6 +148,7 @@ rtems_task High_task(
            RTEMS_NO_TIMEOUT
          );
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
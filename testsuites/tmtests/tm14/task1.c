@@ -118,8 +118,11 @@ rtems_task High_task(
   overhead = benchmark_timer_read();
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= operation_count ; index++ )
+    for ( index=1 ; index <= operation_count ; index++ ) {
+      time_sample_begin();
       (void) rtems_message_queue_urgent( Queue_id, Buffer, MESSAGE_SIZE );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -88,12 +88,14 @@ void test_init(void)
   benchmark_timer_initialize();
     for ( index=1 ; index <= OPERATION_COUNT ; index++ )
     {
+        time_sample_begin();
         (void) rtems_event_receive(
                  RTEMS_PENDING_EVENTS,
                  RTEMS_DEFAULT_OPTIONS,
                  RTEMS_NO_TIMEOUT,
                  &event_out
                );
+        time_sample_end();
     }
 
   end_time = benchmark_timer_read();
@@ -110,12 +112,14 @@ void test_init(void)
   benchmark_timer_initialize();
     for ( index=1 ; index <= OPERATION_COUNT ; index++ )
     {
+      time_sample_begin();
       (void) rtems_event_receive(
                RTEMS_ALL_EVENTS,
                RTEMS_NO_WAIT,
                RTEMS_NO_TIMEOUT,
                &event_out
              );
+      time_sample_end();
     }
   end_time = benchmark_timer_read();
 
@@ -135,6 +139,7 @@ rtems_task Low_task(
   uint32_t    index;
   rtems_event_set   event_out;
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -151,8 +156,11 @@ rtems_task Low_task(
   overhead = benchmark_timer_read();
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_event_send( RTEMS_SELF, RTEMS_EVENT_16 );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -164,12 +172,14 @@ rtems_task Low_task(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_event_receive(
              RTEMS_EVENT_16,
              RTEMS_DEFAULT_OPTIONS,
              RTEMS_NO_TIMEOUT,
              &event_out
            );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -181,8 +191,11 @@ rtems_task Low_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_event_send( Task_id[ index ], RTEMS_EVENT_16 );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -201,17 +214,19 @@ rtems_task High_tasks(
   rtems_task_argument argument
 )
 {
-  if ( time_set )
+  if ( time_set ) {
+    time_sample_next();
     (void) rtems_event_receive(
       RTEMS_EVENT_16,
       RTEMS_DEFAULT_OPTIONS,
       RTEMS_NO_TIMEOUT,
       &eventout
     );
-  else {
+  } else {
     time_set = true;
     /* start blocking rtems_event_receive time */
     benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_event_receive(
       RTEMS_EVENT_16,
       RTEMS_DEFAULT_OPTIONS,
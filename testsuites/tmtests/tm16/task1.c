@@ -99,6 +99,7 @@ rtems_task test_init(
   Task_count = 0;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_event_send( Task_id[ Task_count ], RTEMS_EVENT_16 );
   /* preempts task */
 }
@@ -115,6 +116,7 @@ rtems_task Middle_tasks(
            RTEMS_NO_TIMEOUT,
            &event_out
          );
+  time_sample_next();
 
   Task_count++;
 
@@ -137,6 +139,7 @@ rtems_task High_task(
             &event_out
           );
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -78,6 +78,7 @@ rtems_task First_task(
   rtems_task_priority previous_priority;
 
   benchmark_timer_initialize();
+  time_sample_begin();
 
   Task_priority--;
   Task_count++;
@@ -95,6 +96,7 @@ rtems_task Middle_tasks(
 {
   rtems_task_priority previous_priority;
 
+  time_sample_next();
   Task_priority--;
   Task_count++;
 
@@ -111,6 +113,7 @@ rtems_task Last_task(
 {
   int index;
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   benchmark_timer_initialize();
@@ -82,6 +82,7 @@ rtems_task First_task(
 )
 {
   benchmark_timer_initialize();
+  time_sample_begin();
 
   (void) rtems_task_delete( RTEMS_SELF );
 }
@@ -90,6 +91,7 @@ rtems_task Middle_tasks(
   rtems_task_argument argument
 )
 {
+  time_sample_next();
   (void) rtems_task_delete( RTEMS_SELF );
 }
 
@@ -97,6 +99,7 @@ rtems_task Last_task(
   rtems_task_argument argument
 )
 {
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
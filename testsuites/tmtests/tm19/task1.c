@@ -91,6 +91,7 @@ rtems_asr Process_asr_for_pass_1(
   rtems_signal_set signals
 )
 {
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -102,6 +103,7 @@ rtems_asr Process_asr_for_pass_1(
   );
 
   benchmark_timer_initialize();
+  time_sample_begin();
 }
 
 rtems_asr Process_asr_for_pass_2(
@@ -114,6 +116,7 @@ rtems_asr Process_asr_for_pass_2(
   directive_failed( status, "rtems_task_resume" );
 
   benchmark_timer_initialize();
+  time_sample_begin();
 }
 
 rtems_task Task_1(
@@ -123,7 +126,9 @@ rtems_task Task_1(
   rtems_status_code status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_signal_catch( Process_asr_for_pass_1, RTEMS_DEFAULT_MODES );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -135,7 +140,9 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     rtems_signal_send( Task_id[ 2 ], 1 );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -147,10 +154,12 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_signal_send( RTEMS_SELF, RTEMS_SIGNAL_1 );
 
   /* end time is done is RTEMS_ASR */
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -165,6 +174,7 @@ rtems_task Task_1(
   directive_failed( status, "rtems_signal_catch" );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_signal_send( RTEMS_SELF, RTEMS_SIGNAL_1 );
 }
 
@@ -198,6 +208,7 @@ rtems_task Task_3(
 {
   (void) rtems_task_suspend( RTEMS_SELF );
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
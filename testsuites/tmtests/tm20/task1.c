@@ -98,6 +98,7 @@ rtems_task Task_1(
   Partition_name = rtems_build_name( 'P', 'A', 'R', 'T' );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     rtems_partition_create(
       Partition_name,
       Partition_area,
@@ -106,6 +107,7 @@ rtems_task Task_1(
       RTEMS_DEFAULT_ATTRIBUTES,
       &Partition_id
     );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -119,6 +121,7 @@ rtems_task Task_1(
   Region_name = rtems_build_name( 'R', 'E', 'G', 'N' );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     rtems_region_create(
       Region_name,
       Region_area,
@@ -127,6 +130,7 @@ rtems_task Task_1(
       RTEMS_DEFAULT_ATTRIBUTES,
       &Region_id
     );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -138,7 +142,9 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_partition_get_buffer( Partition_id, &Buffer_address_1 );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -165,7 +171,9 @@ rtems_task Task_1(
   }
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_partition_get_buffer( Partition_id, &Buffer_address_2 );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -177,7 +185,9 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_partition_return_buffer( Partition_id, Buffer_address_1 );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -199,7 +209,9 @@ rtems_task Task_1(
   }
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_partition_delete( Partition_id );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -220,6 +232,7 @@ rtems_task Task_1(
   directive_failed( status, "region_get_segment" );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_region_get_segment(
       Region_id,
       400,
@@ -227,6 +240,7 @@ rtems_task Task_1(
       RTEMS_NO_TIMEOUT,
       &Buffer_address_3
     );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -238,6 +252,7 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_region_get_segment(
       Region_id,
       1700,
@@ -245,6 +260,7 @@ rtems_task Task_1(
       RTEMS_NO_TIMEOUT,
       &Buffer_address_4
     );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -259,7 +275,9 @@ rtems_task Task_1(
   directive_failed( status, "rtems_region_return_segment" );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_region_return_segment( Region_id, Buffer_address_2 );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -280,6 +298,7 @@ rtems_task Task_1(
   directive_failed( status, "rtems_region_get_segment" );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_region_get_segment(
       Region_id,
       1700,
@@ -290,6 +309,7 @@ rtems_task Task_1(
 
   /* execute Task_2 */
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -338,7 +358,9 @@ rtems_task Task_1(
   directive_failed( status, "rtems_region_return_segment" );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_region_delete( Region_id );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -355,8 +377,11 @@ rtems_task Task_1(
   overhead = benchmark_timer_read();
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_io_initialize( _STUB_major, 0, NULL );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -368,8 +393,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_io_open( _STUB_major, 0, NULL );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -381,8 +409,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_io_close( _STUB_major, 0, NULL );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -394,8 +425,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_io_read( _STUB_major, 0, NULL );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -407,8 +441,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_io_write( _STUB_major, 0, NULL );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -420,8 +457,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_io_control( _STUB_major, 0, NULL );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -442,6 +482,7 @@ rtems_task Task_2(
 {
   rtems_status_code status;
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -453,12 +494,15 @@ rtems_task Task_2(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_region_return_segment( Region_id, Buffer_address_1 );
 
   /* preempt back to Task_1 */
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_region_return_segment( Region_id, Buffer_address_1 );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -130,8 +130,11 @@ rtems_task Task_1(
   overhead = benchmark_timer_read();
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_ident( index, RTEMS_SEARCH_ALL_NODES, &id );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -143,8 +146,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_message_queue_ident( index, RTEMS_SEARCH_ALL_NODES, &id );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -156,8 +162,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_semaphore_ident( index, RTEMS_SEARCH_ALL_NODES, &id );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -169,8 +178,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_partition_ident( index, RTEMS_SEARCH_ALL_NODES, &id );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -182,8 +194,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_region_ident( index, &id );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -195,8 +210,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_port_ident( index, &id );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -208,8 +226,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_ident( index, &id );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -221,8 +242,11 @@ rtems_task Task_1(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_rate_monotonic_ident( index, &id );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -89,12 +89,14 @@ rtems_task High_task(
   rtems_status_code status;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_message_queue_broadcast(
              Queue_id,
              Buffer,
              MESSAGE_SIZE,
              &count
            );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -142,13 +144,16 @@ rtems_task Low_task(
   directive_failed( status, "message_queu_receive" );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_message_queue_broadcast(
                Queue_id,
                Buffer,
                MESSAGE_SIZE,
                &count
              );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -169,6 +174,7 @@ rtems_task Low_task(
 
   /* should go to Preempt_task here */
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -190,6 +196,7 @@ rtems_task Preempt_task(
   uint32_t    count;
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_message_queue_broadcast(
              Queue_id,
              Buffer,
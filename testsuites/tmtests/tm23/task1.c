@@ -107,8 +107,11 @@ rtems_task High_task(
   overhead = benchmark_timer_read();
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_create( index, &Timer_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -120,8 +123,11 @@ rtems_task High_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_fire_after( Timer_id[ index ], 500, null_delay, NULL );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -133,8 +139,11 @@ rtems_task High_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_fire_after( Timer_id[ index ], 500, null_delay, NULL );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -146,8 +155,11 @@ rtems_task High_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_cancel( Timer_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -160,8 +172,11 @@ rtems_task High_task(
 
   for ( benchmark_timer_initialize(), i=0 ; i<OPERATION_COUNT ; i++ )
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_cancel( Timer_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -174,8 +189,11 @@ rtems_task High_task(
 
   for ( benchmark_timer_initialize(), i=0 ; i<OPERATION_COUNT ; i++ )
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_reset( Timer_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -187,8 +205,11 @@ rtems_task High_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_reset( Timer_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -210,9 +231,12 @@ rtems_task High_task(
   time_of_day.year = 1989;
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_fire_when(
          Timer_id[ index ], &time_of_day, null_delay, NULL );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -224,9 +248,12 @@ rtems_task High_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_fire_when(
          Timer_id[ index ], &time_of_day, null_delay, NULL );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -238,8 +265,11 @@ rtems_task High_task(
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_delete( Timer_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -263,8 +293,11 @@ rtems_task High_task(
   }
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_timer_delete( Timer_id[ index ] );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -276,6 +309,7 @@ rtems_task High_task(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_task_wake_when( &time_of_day );
 }
 
@@ -283,6 +317,7 @@ rtems_task Middle_tasks(
   rtems_task_argument argument
 )
 {
+  time_sample_next();
   (void) rtems_task_wake_when( &time_of_day );
 }
 
@@ -290,6 +325,7 @@ rtems_task Low_task(
   rtems_task_argument argument
 )
 {
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -80,8 +80,11 @@ rtems_task High_task(
   overhead = benchmark_timer_read();
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_task_wake_after( RTEMS_YIELD_PROCESSOR );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -104,9 +107,11 @@ rtems_task Tasks(
 {
   Task_count++;
 
-  if ( Task_count == 1 )
+  if ( Task_count == 1 ) {
     benchmark_timer_initialize();
-  else if ( Task_count == OPERATION_COUNT ) {
+    time_sample_begin();
+  } else if ( Task_count == OPERATION_COUNT ) {
+    time_sample_end();
     end_time = benchmark_timer_read();
 
     put_time(
@@ -119,6 +124,7 @@ rtems_task Tasks(
 
   puts( "*** END OF TEST 24 ***" );
     rtems_test_exit( 0 );
-  }
+  } else
+    time_sample_next();
   (void) rtems_task_wake_after( RTEMS_YIELD_PROCESSOR );
 }
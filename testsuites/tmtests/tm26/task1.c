@@ -60,6 +60,32 @@ uint32_t   thread_get_time;
 uint32_t   semaphore_get_time;
 uint32_t   thread_get_invalid_time;
 
+#if TIMING_STATISTICS
+/*
+ *  Sample sets of the execution times.
+ */
+static rtems_time_test_sample_set isr_disable_samples;
+static rtems_time_test_sample_set isr_flash_samples;
+static rtems_time_test_sample_set isr_enable_samples;
+static rtems_time_test_sample_set thread_disable_dispatch_samples;
+static rtems_time_test_sample_set thread_enable_dispatch_samples;
+static rtems_time_test_sample_set thread_set_state_samples;
+static rtems_time_test_sample_set thread_dispatch_no_fp_samples;
+static rtems_time_test_sample_set context_switch_no_fp_samples;
+static rtems_time_test_sample_set context_switch_self_samples;
+static rtems_time_test_sample_set context_switch_another_task_samples;
+static rtems_time_test_sample_set context_switch_restore_1st_fp_samples;
+static rtems_time_test_sample_set context_switch_save_idle_restore_initted_samples;
+static rtems_time_test_sample_set context_switch_save_restore_idle_samples;
+static rtems_time_test_sample_set context_switch_save_restore_initted_samples;
+static rtems_time_test_sample_set thread_resume_samples;
+static rtems_time_test_sample_set thread_unblock_samples;
+static rtems_time_test_sample_set thread_ready_samples;
+static rtems_time_test_sample_set thread_get_samples;
+static rtems_time_test_sample_set semaphore_get_samples;
+static rtems_time_test_sample_set thread_get_invalid_samples;
+#endif
+
 rtems_task null_task(
   rtems_task_argument argument
 );
@@ -333,34 +359,47 @@ rtems_task High_task(
   _Thread_Disable_dispatch();
 
   benchmark_timer_initialize();
+  time_sample_begin_in( isr_disable_samples );
     rtems_interrupt_disable( level );
+  time_sample_end_in( isr_disable_samples );
   isr_disable_time = benchmark_timer_read();
 
   benchmark_timer_initialize();
+  time_sample_begin_in( isr_flash_samples );
     rtems_interrupt_flash( level );
+  time_sample_end_in( isr_flash_samples );
   isr_flash_time = benchmark_timer_read();
 
   benchmark_timer_initialize();
+  time_sample_begin_in( isr_enable_samples );
     rtems_interrupt_enable( level );
+  time_sample_end_in( isr_enable_samples );
   isr_enable_time = benchmark_timer_read();
 
   _Thread_Enable_dispatch();
 
   benchmark_timer_initialize();
+  time_sample_begin_in( thread_disable_dispatch_samples );
     _Thread_Disable_dispatch();
+  time_sample_end_in( thread_disable_dispatch_samples );
   thread_disable_dispatch_time = benchmark_timer_read();
 
   benchmark_timer_initialize();
+  time_sample_begin_in( thread_enable_dispatch_samples );
     _Thread_Enable_dispatch();
+  time_sample_end_in( thread_enable_dispatch_samples );
   thread_enable_dispatch_time = benchmark_timer_read();
 
   benchmark_timer_initialize();
+  time_sample_begin_in( thread_set_state_samples );
     thread_set_state( _Thread_Get_executing(), STATES_SUSPENDED );
+  time_sample_end_in( thread_set_state_samples );
   thread_set_state_time = benchmark_timer_read();
 
   set_thread_dispatch_necessary( true );
 
   benchmark_timer_initialize();
+  time_sample_begin_in( thread_dispatch_no_fp_samples );
     _Thread_Dispatch();           /* dispatches Middle_task */
 }
 
@@ -370,6 +409,7 @@ rtems_task Middle_task(
 {
   Chain_Control   *ready_queues;
 
+  time_sample_end_in( thread_dispatch_no_fp_samples );
   thread_dispatch_no_fp_time = benchmark_timer_read();
 
   thread_set_state( _Thread_Get_executing(), STATES_SUSPENDED );
@@ -388,12 +428,14 @@ rtems_task Middle_task(
   thread_disable_dispatch();
 
   benchmark_timer_initialize();
+  time_sample_begin_in( context_switch_no_fp_samples );
     _Context_Switch(
       &Middle_tcb->Registers,
       &_Thread_Get_executing()->Registers
     );
 
   benchmark_timer_initialize();
+  time_sample_begin_in( context_switch_another_task_samples );
     _Context_Switch(&Middle_tcb->Registers, &Low_tcb->Registers);
 }
 
@@ -406,6 +448,7 @@ rtems_task Low_task(
 
   ready_queues      = (Chain_Control *) _Scheduler.information;
 
+  time_sample_end_in( context_switch_no_fp_samples );
   context_switch_no_fp_time = benchmark_timer_read();
 
   executing    = _Thread_Get_executing();
@@ -413,12 +456,15 @@ rtems_task Low_task(
   Low_tcb = executing;
 
   benchmark_timer_initialize();
+  time_sample_begin_in( context_switch_self_samples );
     _Context_Switch( &executing->Registers, &executing->Registers );
 
+  time_sample_end_in( context_switch_self_samples );
   context_switch_self_time = benchmark_timer_read();
 
   _Context_Switch(&executing->Registers, &Middle_tcb->Registers);
 
+  time_sample_end_in( context_switch_another_task_samples );
   context_switch_another_task_time = benchmark_timer_read();
 
   set_thread_executing(
@@ -432,6 +478,7 @@ rtems_task Low_task(
   thread_disable_dispatch();
 
   benchmark_timer_initialize();
+  time_sample_begin_in( context_switch_restore_1st_fp_samples );
 #if (CPU_HARDWARE_FP == 1) || (CPU_SOFTWARE_FP == 1)
     _Context_Restore_fp( &_Thread_Get_executing()->fp_context );
 #endif
@@ -449,6 +496,7 @@ rtems_task Floating_point_task_1(
   Thread_Control  *executing;
   FP_DECLARE;
 
+  time_sample_end_in( context_switch_restore_1st_fp_samples );
   context_switch_restore_1st_fp_time = benchmark_timer_read();
 
   executing = _Thread_Get_executing();
@@ -465,6 +513,7 @@ rtems_task Floating_point_task_1(
   thread_disable_dispatch();
 
   benchmark_timer_initialize();
+  time_sample_begin_in( context_switch_save_restore_idle_samples );
 #if (CPU_HARDWARE_FP == 1) || (CPU_SOFTWARE_FP == 1)
     _Context_Save_fp( &executing->fp_context );
     _Context_Restore_fp( &_Thread_Get_executing()->fp_context );
@@ -475,6 +524,7 @@ rtems_task Floating_point_task_1(
     );
   /* switch to Floating_point_task_2 */
 
+  time_sample_end_in( context_switch_save_idle_restore_initted_samples );
   context_switch_save_idle_restore_initted_time = benchmark_timer_read();
 
   FP_LOAD( 1.0 );
@@ -487,6 +537,7 @@ rtems_task Floating_point_task_1(
   );
 
   benchmark_timer_initialize();
+  time_sample_begin_in( context_switch_save_restore_initted_samples );
 #if (CPU_HARDWARE_FP == 1) || (CPU_SOFTWARE_FP == 1)
     _Context_Save_fp( &executing->fp_context );
     _Context_Restore_fp( &_Thread_Get_executing()->fp_context );
@@ -506,6 +557,7 @@ rtems_task Floating_point_task_2(
   Thread_Control *executing;
   FP_DECLARE;
 
+  time_sample_end_in( context_switch_save_restore_idle_samples );
   context_switch_save_restore_idle_time = benchmark_timer_read();
 
   executing = _Thread_Get_executing();
@@ -518,6 +570,7 @@ rtems_task Floating_point_task_2(
   FP_LOAD( 1.0 );
 
   benchmark_timer_initialize();
+  time_sample_begin_in( context_switch_save_idle_restore_initted_samples );
 #if (CPU_HARDWARE_FP == 1) || (CPU_SOFTWARE_FP == 1)
     _Context_Save_fp( &executing->fp_context );
     _Context_Restore_fp( &_Thread_Get_executing()->fp_context );
@@ -528,6 +581,7 @@ rtems_task Floating_point_task_2(
     );
   /* switch to Floating_point_task_1 */
 
+  time_sample_end_in( context_switch_save_restore_initted_samples );
   context_switch_save_restore_initted_time = benchmark_timer_read();
 
   complete_test();
@@ -539,19 +593,25 @@ void complete_test( void )
   rtems_id          task_id;
 
   benchmark_timer_initialize();
+  time_sample_begin_in( thread_resume_samples );
     thread_resume( Middle_tcb );
+  time_sample_end_in( thread_resume_samples );
   thread_resume_time = benchmark_timer_read();
 
   thread_set_state( Middle_tcb, STATES_WAITING_FOR_MESSAGE );
 
   benchmark_timer_initialize();
+  time_sample_begin_in( thread_unblock_samples );
     thread_unblock( Middle_tcb );
+  time_sample_end_in( thread_unblock_samples );
   thread_unblock_time = benchmark_timer_read();
 
   thread_set_state( Middle_tcb, STATES_WAITING_FOR_MESSAGE );
 
   benchmark_timer_initialize();
+  time_sample_begin_in( thread_ready_samples );
     thread_ready( Middle_tcb );
+  time_sample_end_in( thread_ready_samples );
   thread_ready_time = benchmark_timer_read();
 
   benchmark_timer_initialize();
@@ -562,18 +622,27 @@ void complete_test( void )
   task_id = Middle_tcb->Object.id;
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin_in( thread_get_samples );
       (void) _Thread_Get( task_id, &location );
+      time_sample_end_in( thread_get_samples );
+    }
   thread_get_time = benchmark_timer_read();
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin_in( semaphore_get_samples );
       (void) _Semaphore_Get( Semaphore_id, &location );
+      time_sample_end_in( semaphore_get_samples );
+    }
   semaphore_get_time = benchmark_timer_read();
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin_in( thread_get_invalid_samples );
       (void) _Thread_Get( 0x3, &location );
+      time_sample_end_in( thread_get_invalid_samples );
+    }
   thread_get_invalid_time = benchmark_timer_read();
 
   /*
@@ -592,6 +661,7 @@ void complete_test( void )
    *  Now dump all the times
    */
 
+  time_sample_use( isr_disable_samples );
   put_time(
     "rtems interrupt: _ISR_Disable",
     isr_disable_time,
@@ -600,6 +670,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( isr_flash_samples );
   put_time(
     "rtems interrupt: _ISR_Flash",
     isr_flash_time,
@@ -608,6 +679,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( isr_enable_samples );
   put_time(
     "rtems interrupt: _ISR_Enable",
     isr_enable_time,
@@ -616,6 +688,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( thread_disable_dispatch_samples );
   put_time(
     "rtems internal: _Thread_Disable_dispatch",
     thread_disable_dispatch_time,
@@ -624,6 +697,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( thread_enable_dispatch_samples );
   put_time(
     "rtems internal: _Thread_Enable_dispatch",
     thread_enable_dispatch_time,
@@ -632,6 +706,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( thread_set_state_samples );
   put_time(
     "rtems internal: _Thread_Set_state",
     thread_set_state_time,
@@ -640,6 +715,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( thread_dispatch_no_fp_samples );
   put_time(
     "rtems internal: _Thread_Dispatch NO FP",
     thread_dispatch_no_fp_time,
@@ -648,6 +724,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( context_switch_no_fp_samples );
   put_time(
     "rtems internal: context switch: no floating point contexts",
     context_switch_no_fp_time,
@@ -656,6 +733,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( context_switch_self_samples );
   put_time(
     "rtems internal: context switch: self",
     context_switch_self_time,
@@ -664,6 +742,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( context_switch_another_task_samples );
   put_time(
     "rtems internal: context switch to another task",
     context_switch_another_task_time,
@@ -673,6 +752,7 @@ void complete_test( void )
   );
 
 #if (CPU_HARDWARE_FP == 1) || (CPU_SOFTWARE_FP == 1)
+  time_sample_use( context_switch_restore_1st_fp_samples );
   put_time(
     "rtems internal: fp context switch restore 1st FP task",
     context_switch_restore_1st_fp_time,
@@ -681,6 +761,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( context_switch_save_idle_restore_initted_samples );
   put_time(
     "rtems internal: fp context switch save idle and restore initialized",
     context_switch_save_idle_restore_initted_time,
@@ -689,6 +770,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( context_switch_save_restore_idle_samples );
   put_time(
     "rtems internal: fp context switch save idle, restore idle",
     context_switch_save_restore_idle_time,
@@ -697,6 +779,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( context_switch_save_restore_initted_samples );
   put_time(
     "rtems internal: fp context switch save initialized, restore initialized",
     context_switch_save_restore_initted_time,
@@ -714,6 +797,7 @@ void complete_test( void )
    );
 #endif
 
+  time_sample_use( thread_resume_samples );
   put_time(
     "rtems internal: _Thread_Resume",
     thread_resume_time,
@@ -722,6 +806,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( thread_unblock_samples );
   put_time(
     "rtems internal: _Thread_Unblock",
     thread_unblock_time,
@@ -730,6 +815,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( thread_ready_samples );
   put_time(
     "rtems internal: _Thread_Ready",
     thread_ready_time,
@@ -738,6 +824,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( thread_get_samples );
   put_time(
     "rtems internal: _Thread_Get",
     thread_get_time,
@@ -746,6 +833,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( semaphore_get_samples );
   put_time(
     "rtems internal: _Semaphore_Get",
     semaphore_get_time,
@@ -754,6 +842,7 @@ void complete_test( void )
     0
   );
 
+  time_sample_use( thread_get_invalid_samples );
   put_time(
     "rtems internal: _Thread_Get: invalid id",
     thread_get_invalid_time,
@@ -39,6 +39,14 @@ volatile uint32_t   Interrupt_return_time, Interrupt_return_nested_time;
 uint32_t   Interrupt_nest;
 uint32_t   timer_overhead;
 
+#if TIMING_STATISTICS
+/*
+ *  The interrupt entry is sampled in the set of the nest level at the entry.
+ */
+static rtems_time_test_sample_set Interrupt_enter_samples[ 3 ];
+static rtems_time_test_sample_set Interrupt_return_samples;
+#endif
+
 rtems_isr Isr_handler(
   rtems_vector_number vector
 );
@@ -115,14 +123,17 @@ rtems_task Task_1(
   Interrupt_occurred = 0;
 
   benchmark_timer_initialize();
+  time_sample_begin_in( Interrupt_enter_samples[ 0 ] );
   Cause_tm27_intr();
   /* goes to Isr_handler */
 
 #if (MUST_WAIT_FOR_INTERRUPT == 1)
   while ( Interrupt_occurred == 0 );
 #endif
+  time_sample_end_in( Interrupt_return_samples );
   Interrupt_return_time = benchmark_timer_read();
 
+  time_sample_use( Interrupt_enter_samples[ 0 ] );
   put_time(
     "rtems interrupt: entry overhead returns to interrupted task",
     Interrupt_enter_time,
@@ -131,6 +142,7 @@ rtems_task Task_1(
     timer_overhead
   );
 
+  time_sample_use( Interrupt_return_samples );
   put_time(
     "rtems interrupt: exit overhead returns to interrupted task",
     Interrupt_return_time,
@@ -149,6 +161,7 @@ rtems_task Task_1(
 
   Interrupt_occurred = 0;
   benchmark_timer_initialize();
+  time_sample_begin_in( Interrupt_enter_samples[ 1 ] );
   Cause_tm27_intr();
   /* goes to Isr_handler */
 
@@ -159,6 +172,7 @@ rtems_task Task_1(
 
   _Thread_Unnest_dispatch();
 
+  time_sample_use( Interrupt_enter_samples[ 2 ] );
   put_time(
     "rtems interrupt: entry overhead returns to nested interrupt",
     Interrupt_enter_nested_time,
@@ -167,6 +181,7 @@ rtems_task Task_1(
     0
   );
 
+  time_sample_use( Interrupt_return_samples );
   put_time(
     "rtems interrupt: exit overhead returns to nested interrupt",
     Interrupt_return_nested_time,
@@ -195,6 +210,7 @@ rtems_task Task_1(
 
   Interrupt_occurred = 0;
   benchmark_timer_initialize();
+  time_sample_begin_in( Interrupt_enter_samples[ Interrupt_nest ] );
   Cause_tm27_intr();
 
   /*
@@ -225,8 +241,10 @@ rtems_task Task_2(
 #if (MUST_WAIT_FOR_INTERRUPT == 1)
   while ( Interrupt_occurred == 0 );
 #endif
+  time_sample_end_in( Interrupt_return_samples );
   end_time = benchmark_timer_read();
 
+  time_sample_use( Interrupt_enter_samples[ Interrupt_nest ] );
   put_time(
     "rtems interrupt: entry overhead returns to preempting task",
     Interrupt_enter_time,
@@ -235,6 +253,7 @@ rtems_task Task_2(
     timer_overhead
   );
 
+  time_sample_use( Interrupt_return_samples );
   put_time(
     "rtems interrupt: exit overhead returns to preempting task",
     end_time,
@@ -279,6 +298,7 @@ rtems_isr Isr_handler(
 )
 {
   end_time = benchmark_timer_read();
+  time_sample_end_in( Interrupt_enter_samples[ Interrupt_nest ] );
 
   Interrupt_occurred = 1;
   Isr_handler_inner();
@@ -299,11 +319,13 @@ void Isr_handler_inner( void )
       Interrupt_occurred = 0;
       Lower_tm27_intr();
       benchmark_timer_initialize();
+      time_sample_begin_in( Interrupt_enter_samples[ 2 ] );
       Cause_tm27_intr();
       /* goes to a nested copy of Isr_handler */
 #if (MUST_WAIT_FOR_INTERRUPT == 1)
        while ( Interrupt_occurred == 0 );
 #endif
+      time_sample_end_in( Interrupt_return_samples );
       Interrupt_return_nested_time = benchmark_timer_read();
       break;
     case 2:
@@ -312,4 +334,5 @@ void Isr_handler_inner( void )
   }
 
   benchmark_timer_initialize();
+  time_sample_begin_in( Interrupt_return_samples );
 }
@@ -66,6 +66,7 @@ rtems_task Test_task (
   name = rtems_build_name( 'P', 'O', 'R', 'T' ),
 
   benchmark_timer_initialize();
+    time_sample_begin();
     rtems_port_create(
       name,
       Internal_area,
@@ -73,6 +74,7 @@ rtems_task Test_task (
       0xff,
       &Port_id
     );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -84,12 +86,15 @@ rtems_task Test_task (
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_port_external_to_internal(
                Port_id,
                &External_area[ 0xf ],
                &converted
              );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -101,12 +106,15 @@ rtems_task Test_task (
   );
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_port_internal_to_external(
                Port_id,
                &Internal_area[ 0xf ],
                &converted
              );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -118,7 +126,9 @@ rtems_task Test_task (
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     rtems_port_delete( Port_id );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -33,6 +33,7 @@ rtems_task Init(
   rtems_id          id;
   uint32_t    index;
   rtems_status_code status;
+  rtems_rate_monotonic_period_histograms histograms;
 
   Print_Warning();
 
@@ -41,7 +42,9 @@ rtems_task Init(
   Period_name = rtems_build_name( 'P', 'R', 'D', ' ' );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_rate_monotonic_create( Period_name, &id );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -53,7 +56,9 @@ rtems_task Init(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_rate_monotonic_period( id, 10 );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -65,7 +70,9 @@ rtems_task Init(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_rate_monotonic_period( id, RTEMS_PERIOD_STATUS );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -77,7 +84,23 @@ rtems_task Init(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
+    (void) rtems_rate_monotonic_get_histograms( id, &histograms );
+    time_sample_end();
+  end_time = benchmark_timer_read();
+
+  put_time(
+    "rtems_rate_monotonic_get_histograms: only case",
+    end_time,
+    1,
+    0,
+    0
+  );
+
+  benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_rate_monotonic_cancel( id );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -89,7 +112,9 @@ rtems_task Init(
   );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     (void) rtems_rate_monotonic_delete( id );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -107,7 +132,9 @@ rtems_task Init(
   directive_failed( status, "rtems_rate_monotonic_period" );
 
   benchmark_timer_initialize();
+    time_sample_begin();
     rtems_rate_monotonic_delete( id );
+    time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -177,8 +204,11 @@ rtems_task Tasks(
 
   Task_count++;
 
-  if ( Task_count == 1 )
+  if ( Task_count == 1 ) {
     benchmark_timer_initialize();
+    time_sample_begin();
+  } else
+    time_sample_next();
 
   (void) rtems_rate_monotonic_period( id, 100 );
 }
@@ -189,6 +219,7 @@ rtems_task Low_task(
 {
   uint32_t   index;
 
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   benchmark_timer_initialize();
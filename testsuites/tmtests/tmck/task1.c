@@ -74,6 +74,8 @@ rtems_task Task_1(
 rtems_test_pause();
 
   benchmark_timer_initialize();
+  time_sample_begin();
+  time_sample_end();
   end_time = benchmark_timer_read();
 
   put_time(
@@ -85,8 +87,11 @@ rtems_test_pause();
   );
 
   benchmark_timer_initialize();
-  for ( index = 1 ; index <= 1000 ; index++ )
+  for ( index = 1 ; index <= 1000 ; index++ ) {
+    time_sample_begin();
     (void) benchmark_timer_empty_function();
+    time_sample_end();
+  }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -98,8 +103,11 @@ rtems_test_pause();
   );
 
   benchmark_timer_initialize();
-  for ( index = 1 ; index <= 10000 ; index++ )
+  for ( index = 1 ; index <= 10000 ; index++ ) {
+    time_sample_begin();
     (void) benchmark_timer_empty_function();
+    time_sample_end();
+  }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -111,8 +119,11 @@ rtems_test_pause();
   );
 
   benchmark_timer_initialize();
-  for ( index = 1 ; index <= 50000 ; index++ )
+  for ( index = 1 ; index <= 50000 ; index++ ) {
+    time_sample_begin();
     (void) benchmark_timer_empty_function();
+    time_sample_end();
+  }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -124,8 +135,11 @@ rtems_test_pause();
   );
 
   benchmark_timer_initialize();
-  for ( index = 1 ; index <= 100000 ; index++ )
+  for ( index = 1 ; index <= 100000 ; index++ ) {
+    time_sample_begin();
     (void) benchmark_timer_empty_function();
+    time_sample_end();
+  }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -95,8 +95,11 @@ rtems_task Task_1(
 /* rtems_shutdown_executive */
 
   benchmark_timer_initialize();
-    for ( index=1 ; index <= OPERATION_COUNT ; index++ )
+    for ( index=1 ; index <= OPERATION_COUNT ; index++ ) {
+      time_sample_begin();
       (void) rtems_shutdown_executive( error );
+      time_sample_end();
+    }
   end_time = benchmark_timer_read();
 
   put_time(
@@ -110,7 +113,8 @@ rtems_task Task_1(
 /* rtems_task_create */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_create(
                name,
                in_priority,
@@ -119,6 +123,8 @@ rtems_task Task_1(
                RTEMS_DEFAULT_ATTRIBUTES,
                &id
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -132,8 +138,11 @@ rtems_task Task_1(
 /* rtems_task_ident */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_ident( name, RTEMS_SEARCH_ALL_NODES, id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -147,8 +156,11 @@ rtems_task Task_1(
 /* rtems_task_start */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_start( id, Task_1, 0 );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -162,8 +174,11 @@ rtems_task Task_1(
 /* rtems_task_restart */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_restart( id, 0 );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -177,8 +192,11 @@ rtems_task Task_1(
 /* rtems_task_delete */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_delete( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -192,8 +210,11 @@ rtems_task Task_1(
 /* rtems_task_suspend */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_suspend( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -207,8 +228,11 @@ rtems_task Task_1(
 /* rtems_task_resume */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_resume( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -222,8 +246,11 @@ rtems_task Task_1(
 /* rtems_task_set_priority */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_set_priority( id, in_priority, &out_priority );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -237,8 +264,11 @@ rtems_task Task_1(
 /* rtems_task_mode */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_mode( in_mode, mask, &out_mode );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -252,8 +282,11 @@ rtems_task Task_1(
 /* rtems_task_get_note */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_get_note( id, 1, note );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -267,8 +300,11 @@ rtems_task Task_1(
 /* rtems_task_set_note */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_set_note( id, 1, note );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -282,8 +318,11 @@ rtems_task Task_1(
 /* rtems_task_wake_when */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_wake_when( time );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -297,8 +336,11 @@ rtems_task Task_1(
 /* rtems_task_wake_after */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_task_wake_after( timeout );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -312,8 +354,11 @@ rtems_task Task_1(
 /* rtems_interrupt_catch */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_interrupt_catch( Isr_handler, 5, address_1 );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -327,8 +372,11 @@ rtems_task Task_1(
 /* rtems_clock_get */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_clock_get( options, time );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -342,8 +390,11 @@ rtems_task Task_1(
 /* rtems_clock_set */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_clock_set( time );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -357,8 +408,11 @@ rtems_task Task_1(
 /* rtems_clock_tick */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+           time_sample_begin();
            (void) rtems_clock_tick();
+           time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -374,8 +428,11 @@ rtems_test_pause();
 /* rtems_timer_create */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_timer_create( name, &id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -389,8 +446,11 @@ rtems_test_pause();
 /* rtems_timer_delete */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_timer_delete( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -404,8 +464,11 @@ rtems_test_pause();
 /* rtems_timer_ident */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_timer_ident( name, id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -419,13 +482,16 @@ rtems_test_pause();
 /* rtems_timer_fire_after */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_timer_fire_after(
                id,
                timeout,
                Timer_handler,
                NULL
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -439,13 +505,16 @@ rtems_test_pause();
 /* rtems_timer_fire_when */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_timer_fire_when(
                id,
                time,
                Timer_handler,
                NULL
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -459,8 +528,11 @@ rtems_test_pause();
 /* rtems_timer_reset */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_timer_reset( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -474,8 +546,11 @@ rtems_test_pause();
 /* rtems_timer_cancel */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_timer_cancel( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -489,7 +564,8 @@ rtems_test_pause();
 /* rtems_semaphore_create */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_semaphore_create(
                name,
                128,
@@ -497,6 +573,8 @@ rtems_test_pause();
                RTEMS_NO_PRIORITY,
                &id
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -510,8 +588,11 @@ rtems_test_pause();
 /* rtems_semaphore_delete */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_semaphore_delete( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -525,8 +606,11 @@ rtems_test_pause();
 /* rtems_semaphore_ident */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_semaphore_ident( name, RTEMS_SEARCH_ALL_NODES, id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -540,8 +624,11 @@ rtems_test_pause();
 /* rtems_semaphore_obtain */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_semaphore_obtain( id, RTEMS_DEFAULT_OPTIONS, timeout );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -555,8 +642,11 @@ rtems_test_pause();
 /* rtems_semaphore_release */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_semaphore_release( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -570,13 +660,16 @@ rtems_test_pause();
 /* rtems_message_queue_create */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_message_queue_create(
                name,
                128,
                RTEMS_DEFAULT_ATTRIBUTES,
                &id
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -590,12 +683,15 @@ rtems_test_pause();
 /* rtems_message_queue_ident */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_message_queue_ident(
               name,
               RTEMS_SEARCH_ALL_NODES,
               id
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -609,8 +705,11 @@ rtems_test_pause();
 /* rtems_message_queue_delete */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_message_queue_delete( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -624,8 +723,11 @@ rtems_test_pause();
 /* rtems_message_queue_send */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_message_queue_send( id, (long (*)[4])buffer );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -639,8 +741,11 @@ rtems_test_pause();
 /* rtems_message_queue_urgent */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_message_queue_urgent( id, (long (*)[4])buffer );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -654,12 +759,15 @@ rtems_test_pause();
 /* rtems_message_queue_broadcast */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_message_queue_broadcast(
                id,
                (long (*)[4])buffer,
                &count
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -673,13 +781,16 @@ rtems_test_pause();
 /* rtems_message_queue_receive */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_message_queue_receive(
                id,
                (long (*)[4])buffer,
                RTEMS_DEFAULT_OPTIONS,
                timeout
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -693,8 +804,11 @@ rtems_test_pause();
 /* rtems_message_queue_flush */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_message_queue_flush( id, &count );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -710,8 +824,11 @@ rtems_test_pause();
 /* rtems_event_send */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_event_send( id, events );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -725,13 +842,16 @@ rtems_test_pause();
 /* rtems_event_receive */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_event_receive(
                RTEMS_EVENT_16,
                RTEMS_DEFAULT_OPTIONS,
                timeout,
                &events
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -745,8 +865,11 @@ rtems_test_pause();
 /* rtems_signal_catch */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_signal_catch( Asr_handler, RTEMS_DEFAULT_MODES );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -760,8 +883,11 @@ rtems_test_pause();
 /* rtems_signal_send */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_signal_send( id, signals );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -775,7 +901,8 @@ rtems_test_pause();
 /* rtems_partition_create */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_partition_create(
                name,
                Memory_area,
@@ -784,6 +911,8 @@ rtems_test_pause();
                RTEMS_DEFAULT_ATTRIBUTES,
                &id
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -797,8 +926,11 @@ rtems_test_pause();
 /* rtems_partition_ident */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_partition_ident( name, RTEMS_SEARCH_ALL_NODES, id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -812,8 +944,11 @@ rtems_test_pause();
 /* rtems_partition_delete */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_partition_delete( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -827,8 +962,11 @@ rtems_test_pause();
 /* rtems_partition_get_buffer */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_partition_get_buffer( id, address_1 );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -842,8 +980,11 @@ rtems_test_pause();
 /* rtems_partition_return_buffer */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_partition_return_buffer( id, address_1 );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -857,7 +998,8 @@ rtems_test_pause();
 /* rtems_region_create */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_region_create(
                name,
                Memory_area,
@@ -866,6 +1008,8 @@ rtems_test_pause();
                RTEMS_DEFAULT_ATTRIBUTES,
                &id
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -879,8 +1023,11 @@ rtems_test_pause();
 /* rtems_region_ident */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_region_ident( name, id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -894,8 +1041,11 @@ rtems_test_pause();
 /* rtems_region_delete */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_region_delete( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -909,7 +1059,8 @@ rtems_test_pause();
 /* rtems_region_get_segment */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_region_get_segment(
                id,
                243,
@@ -917,6 +1068,8 @@ rtems_test_pause();
                timeout,
                &address_1
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -930,8 +1083,11 @@ rtems_test_pause();
 /* rtems_region_return_segment */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_region_return_segment( id, address_1 );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -945,7 +1101,8 @@ rtems_test_pause();
 /* rtems_port_create */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_port_create(
                name,
                Internal_port_area,
@@ -953,6 +1110,8 @@ rtems_test_pause();
                0xff,
                &id
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -966,8 +1125,11 @@ rtems_test_pause();
 /* rtems_port_ident */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_port_ident( name, id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -981,8 +1143,11 @@ rtems_test_pause();
 /* rtems_port_delete */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_port_delete( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -996,12 +1161,15 @@ rtems_test_pause();
 /* rtems_port_external_to_internal */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_port_external_to_internal(
                id,
                &External_port_area[ 7 ],
                address_1
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1015,12 +1183,15 @@ rtems_test_pause();
 /* rtems_port_internal_to_external */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_port_internal_to_external(
                id,
                &Internal_port_area[ 7 ],
                address_1
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1036,13 +1207,16 @@ rtems_test_pause();
 /* rtems_io_initialize */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_io_initialize(
                major,
                minor,
                address_1,
                &io_result
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1056,13 +1230,16 @@ rtems_test_pause();
 /* rtems_io_open */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_io_open(
                major,
                minor,
                address_1,
                &io_result
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1076,13 +1253,16 @@ rtems_test_pause();
 /* rtems_io_close */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_io_close(
                major,
                minor,
                address_1,
                &io_result
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1096,13 +1276,16 @@ rtems_test_pause();
 /* rtems_io_read */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_io_read(
                major,
                minor,
                address_1,
                &io_result
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1116,13 +1299,16 @@ rtems_test_pause();
 /* rtems_io_write */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_io_write(
                major,
                minor,
                address_1,
                &io_result
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1136,13 +1322,16 @@ rtems_test_pause();
 /* rtems_io_control */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_io_control(
                major,
                minor,
                address_1,
                &io_result
             );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1156,8 +1345,11 @@ rtems_test_pause();
 /* rtems_fatal_error_occurred */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_fatal_error_occurred( error );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1171,8 +1363,11 @@ rtems_test_pause();
 /* rtems_rate_monotonic_create */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_rate_monotonic_create( name, &id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1186,8 +1381,11 @@ rtems_test_pause();
 /* rtems_rate_monotonic_ident */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_rate_monotonic_ident( name, id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1201,8 +1399,11 @@ rtems_test_pause();
 /* rtems_rate_monotonic_delete */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_rate_monotonic_delete( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1216,8 +1417,11 @@ rtems_test_pause();
 /* rtems_rate_monotonic_cancel */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_rate_monotonic_cancel( id );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1231,8 +1435,11 @@ rtems_test_pause();
 /* rtems_rate_monotonic_period */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_rate_monotonic_period( id, timeout );
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
@@ -1246,8 +1453,11 @@ rtems_test_pause();
 /* rtems_multiprocessing_announce */
 
       benchmark_timer_initialize();
-         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ )
+         for ( index = 1 ; index <= OPERATION_COUNT ; index ++ ) {
+            time_sample_begin();
             (void) rtems_multiprocessing_announce();
+            time_sample_end();
+         }
       end_time = benchmark_timer_read();
 
       put_time(
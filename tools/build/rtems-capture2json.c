@@ -0,0 +1,337 @@
+/*
+ * rtems-capture2json.c
+ *
+ * Convert a binary trace stream of the RTEMS capture engine into the
+ * trace event format (JSON) of the Chrome and Perfetto trace viewers.
+ *
+ * The stream format is documented in cpukit/libmisc/capture/capture-trace.h.
+ * A task is shown as a thread.  The time between a switch in and a switch
+ * out of a task is shown as a slice.  All other events are shown as instant
+ * events of the task.
+ *
+ * syntax:  rtems-capture2json [-o <output_file>] <input_file>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TRACE_MAGIC 0x52544354U
+
+#define EVENT_START 16
+#define EVENT_END   29
+
+#define SWITCHED_OUT_EVENT 0x04000000U
+#define SWITCHED_IN_EVENT  0x08000000U
+#define USER_EVENT         0x20000000U
+
+#define MAX_PAYLOAD (64 * 1024)
+
+static const char *event_names[] = {
+  "CREATED_BY",
+  "CREATED",
+  "STARTED_BY",
+  "STARTED",
+  "RESTARTED_BY",
+  "RESTARTED",
+  "DELETED_BY",
+  "DELETED",
+  "BEGIN",
+  "EXITTED",
+  "SWITCHED_OUT",
+  "SWITCHED_IN",
+  "TIMESTAMP",
+  "USER"
+};
+
+typedef struct {
+  uint32_t id;
+  uint32_t name;
+  uint64_t time_in;
+  int      running;
+} task_state;
+
+static task_state *tasks;
+static size_t      task_count;
+static int         swap;
+static int         first_event = 1;
+
+static uint32_t get32( const unsigned char *p )
+{
+  uint32_t v;
+
+  memcpy( &v, p, sizeof( v ) );
+  if ( swap )
+    v = ((v & 0xffU) << 24) | ((v & 0xff00U) << 8) |
+      ((v >> 8) & 0xff00U) | (v >> 24);
+  return v;
+}
+
+static uint64_t get64( const unsigned char *p )
+{
+  unsigned char b[8];
+  uint64_t      v;
+  int           i;
+
+  for ( i = 0; i < 8; i++ )
+    b[i] = swap ? p[7 - i] : p[i];
+  memcpy( &v, b, sizeof( v ) );
+  return v;
+}
+
+static void print_name( FILE *out, uint32_t id, uint32_t name )
+{
+  int i;
+
+  for ( i = 3; i >= 0; i-- ) {
+    int c = (name >> (8 * i)) & 0xff;
+
+    if ( c < ' ' || c > '~' || c == '"' || c == '\\' )
+      c = (c == 0) ? ' ' : '.';
+    fputc( c, out );
+  }
+  fprintf( out, " (0x%08" PRIx32 ")", id );
+}
+
+static void begin_event( FILE *out )
+{
+  if ( !first_event )
+    fputs( ",\n", out );
+  first_event = 0;
+}
+
+static task_state *get_task( FILE *out, uint32_t id, uint32_t name )
+{
+  task_state *task;
+  size_t      i;
+
+  for ( i = 0; i < task_count; i++ ) {
+    if ( tasks[i].id == id )
+      return &tasks[i];
+  }
+
+  task = realloc( tasks, (task_count + 1) * sizeof( *tasks ) );
+  if ( !task ) {
+    fprintf( stderr, "out of memory\n" );
+    exit( 1 );
+  }
+  tasks = task;
+  task = &tasks[task_count++];
+  task->id = id;
+  task->name = name;
+  task->time_in = 0;
+  task->running = 0;
+
+  begin_event( out );
+  fprintf(
+    out,
+    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%" PRIu32
+      ",\"args\":{\"name\":\"",
+    id
+  );
+  print_name( out, id, name );
+  fputs( "\"}}", out );
+
+  return task;
+}
+
+static void print_time( FILE *out, uint64_t ns )
+{
+  /* The trace event format uses micro-seconds */
+  fprintf( out, "%" PRIu64 ".%03" PRIu64, ns / 1000, ns % 1000 );
+}
+
+static void process_record(
+  FILE                *out,
+  uint32_t             events,
+  uint32_t             id,
+  uint32_t             name,
+  uint64_t             time,
+  const unsigned char *payload,
+  size_t               payload_size
+)
+{
+  task_state *task = get_task( out, id, name );
+  int         e;
+
+  if ( events & SWITCHED_OUT_EVENT ) {
+    if ( task->running ) {
+      begin_event( out );
+      fprintf( out, "{\"name\":\"" );
+      print_name( out, id, name );
+      fprintf( out, "\",\"ph\":\"X\",\"pid\":0,\"tid\":%" PRIu32 ",\"ts\":", id );
+      print_time( out, task->time_in );
+      fputs( ",\"dur\":", out );
+      print_time( out, time - task->time_in );
+      fprintf(
+        out,
+        ",\"args\":{\"real_priority\":%" PRIu32
+          ",\"current_priority\":%" PRIu32 "}}",
+        events & 0xff,
+        (events >> 8) & 0xff
+      );
+    }
+    task->running = 0;
+  }
+
+  if ( events & SWITCHED_IN_EVENT ) {
+    task->running = 1;
+    task->time_in = time;
+  }
+
+  for ( e = EVENT_START; e <= EVENT_END; e++ ) {
+    uint32_t event = 1U << e;
+    size_t   i;
+
+    if ( !(events & event) ||
+         event == SWITCHED_OUT_EVENT || event == SWITCHED_IN_EVENT )
+      continue;
+
+    begin_event( out );
+    fprintf(
+      out,
+      "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":%" PRIu32
+        ",\"ts\":",
+      event_names[e - EVENT_START],
+      id
+    );
+    print_time( out, time );
+    fprintf(
+      out,
+      ",\"args\":{\"real_priority\":%" PRIu32
+        ",\"current_priority\":%" PRIu32,
+      events & 0xff,
+      (events >> 8) & 0xff
+    );
+
+    if ( event == USER_EVENT && payload_size >= 4 ) {
+      fprintf( out, ",\"id\":%" PRIu32 ",\"data\":\"", get32( payload ) );
+      for ( i = 4; i < payload_size; i++ )
+        fprintf( out, "%02x", payload[i] );
+      fputc( '"', out );
+    }
+
+    fputs( "}}", out );
+  }
+}
+
+static void usage( void )
+{
+  fprintf( stderr, "usage: rtems-capture2json [-o <output_file>] <input_file>\n" );
+  exit( 1 );
+}
+
+int main( int argc, char **argv )
+{
+  static unsigned char payload[MAX_PAYLOAD];
+  unsigned char        header[16];
+  unsigned char        record[64];
+  const char          *ofname = NULL;
+  FILE                *in;
+  FILE                *out = stdout;
+  uint32_t             header_size;
+  uint32_t             record_size;
+  unsigned long        records = 0;
+  int                  opt;
+
+  while ( (opt = getopt( argc, argv, "o:" )) != -1 ) {
+    switch ( opt ) {
+      case 'o':
+        ofname = optarg;
+        break;
+      default:
+        usage();
+    }
+  }
+
+  if ( optind + 1 != argc )
+    usage();
+
+  in = fopen( argv[optind], "rb" );
+  if ( !in ) {
+    perror( argv[optind] );
+    return 1;
+  }
+
+  if ( fread( header, sizeof( header ), 1, in ) != 1 ) {
+    fprintf( stderr, "%s: truncated header\n", argv[optind] );
+    return 1;
+  }
+
+  if ( get32( header ) != TRACE_MAGIC ) {
+    swap = 1;
+    if ( get32( header ) != TRACE_MAGIC ) {
+      fprintf( stderr, "%s: not a capture trace\n", argv[optind] );
+      return 1;
+    }
+  }
+
+  header_size = get32( header + 8 );
+  record_size = get32( header + 12 );
+
+  if ( header_size < sizeof( header ) || record_size < 24 ||
+       record_size > sizeof( record ) ) {
+    fprintf( stderr, "%s: unsupported trace format\n", argv[optind] );
+    return 1;
+  }
+
+  if ( fseek( in, header_size, SEEK_SET ) != 0 ) {
+    perror( argv[optind] );
+    return 1;
+  }
+
+  if ( ofname ) {
+    out = fopen( ofname, "w" );
+    if ( !out ) {
+      perror( ofname );
+      return 1;
+    }
+  }
+
+  fputs( "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", out );
+
+  while ( fread( record, record_size, 1, in ) == 1 ) {
+    uint32_t size = get32( record );
+    size_t   payload_size;
+
+    if ( size < record_size || size - record_size > sizeof( payload ) ) {
+      fprintf( stderr, "%s: bad record size %" PRIu32 "\n", argv[optind], size );
+      break;
+    }
+
+    payload_size = size - record_size;
+    if ( payload_size &&
+         fread( payload, payload_size, 1, in ) != 1 ) {
+      fprintf( stderr, "%s: truncated record\n", argv[optind] );
+      break;
+    }
+
+    process_record(
+      out,
+      get32( record + 4 ),
+      get32( record + 8 ),
+      get32( record + 12 ),
+      get64( record + 16 ),
+      payload,
+      payload_size
+    );
+    records++;
+  }
+
+  fputs( "\n]}\n", out );
+
+  if ( out != stdout )
+    fclose( out );
+  fclose( in );
+
+  fprintf( stderr, "%lu records converted\n", records );
+
+  return 0;
+}
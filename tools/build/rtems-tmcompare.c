@@ -0,0 +1,340 @@
+/*
+ * rtems-tmcompare.c
+ *
+ * Compare the machine-readable timing records of two timing test runs and
+ * flag regressions.
+ *
+ * The timing tests print the records if they are configured with
+ * TIMING_STATISTICS=1, see testsuites/tmtests/README.  The input files are
+ * the console logs of the test runs, for example from simulator runs.  Each
+ * record is identified by the test in which it occurs, its name and its
+ * unit.  The median of a record is compared if present, otherwise the mean.
+ * The 99th percentile is compared in addition if both records have one.
+ *
+ * A value is a regression if it increased by more than the threshold
+ * percentage and by more than the minimum difference.  The exit status is
+ * one if a regression was found, otherwise zero.
+ *
+ * syntax:  rtems-tmcompare [-t <threshold_percent>] [-m <min_difference>]
+ *            [-a] <baseline_file> <result_file>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.com/license/LICENSE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_LINE 1024
+#define MAX_TEXT 256
+
+typedef struct {
+  char   key[3 * MAX_TEXT + 16];
+  char   test[MAX_TEXT];
+  char   name[MAX_TEXT];
+  char   unit[MAX_TEXT];
+  double value;
+  double p99;
+  int    has_p99;
+  int    matched;
+} record;
+
+typedef struct {
+  record *records;
+  size_t  count;
+  size_t  capacity;
+} record_set;
+
+static double threshold = 5.0;
+static double min_difference = 0.0;
+static int    show_all;
+
+/*
+ * Copy the value of an attribute into the buffer.  Returns zero if the
+ * attribute is not present.
+ */
+static int get_attribute(
+  const char *line,
+  const char *attribute,
+  char       *buf,
+  size_t      size
+)
+{
+  char        pattern[64];
+  const char *begin;
+  const char *end;
+  size_t      n;
+
+  snprintf( pattern, sizeof( pattern ), " %s=\"", attribute );
+  begin = strstr( line, pattern );
+  if ( !begin )
+    return 0;
+
+  begin += strlen( pattern );
+  end = strchr( begin, '"' );
+  if ( !end )
+    return 0;
+
+  n = (size_t) ( end - begin );
+  if ( n >= size )
+    n = size - 1;
+
+  memcpy( buf, begin, n );
+  buf[n] = '\0';
+  return 1;
+}
+
+static int get_number( const char *line, const char *attribute, double *v )
+{
+  char  buf[64];
+  char *end;
+
+  if ( !get_attribute( line, attribute, buf, sizeof( buf ) ) )
+    return 0;
+
+  *v = strtod( buf, &end );
+  return end != buf;
+}
+
+static record *find_record( record_set *set, const char *key )
+{
+  size_t i;
+
+  for ( i = 0; i < set->count; i++ ) {
+    if ( strcmp( set->records[i].key, key ) == 0 )
+      return &set->records[i];
+  }
+
+  return NULL;
+}
+
+static record *add_record( record_set *set )
+{
+  if ( set->count == set->capacity ) {
+    size_t  capacity = set->capacity ? 2 * set->capacity : 256;
+    record *records = realloc( set->records, capacity * sizeof( *records ) );
+
+    if ( !records ) {
+      fprintf( stderr, "rtems-tmcompare: out of memory\n" );
+      exit( 2 );
+    }
+
+    set->records = records;
+    set->capacity = capacity;
+  }
+
+  return &set->records[ set->count++ ];
+}
+
+/*
+ * The test begin lines of the form "*** ... TEST ... ***" name the test of
+ * the following records.
+ */
+static void get_test( const char *line, char *test, size_t size )
+{
+  const char *begin = strstr( line, "*** " );
+  const char *end;
+  size_t      n;
+
+  if ( !begin || strstr( line, "*** END" ) || !strstr( line, "TEST" ) )
+    return;
+
+  begin += 4;
+  end = strstr( begin, " ***" );
+  if ( !end )
+    return;
+
+  n = (size_t) ( end - begin );
+  if ( n >= size )
+    n = size - 1;
+
+  memcpy( test, begin, n );
+  test[n] = '\0';
+}
+
+static void read_records( const char *fname, record_set *set )
+{
+  char  line[MAX_LINE];
+  char  test[MAX_TEXT] = "";
+  FILE *in = fopen( fname, "r" );
+
+  if ( !in ) {
+    perror( fname );
+    exit( 2 );
+  }
+
+  while ( fgets( line, sizeof( line ), in ) ) {
+    char    name[MAX_TEXT];
+    char    unit[MAX_TEXT];
+    char    key[3 * MAX_TEXT + 16];
+    record *r;
+    double  value;
+    int     occurrence = 1;
+
+    if ( !strstr( line, "<TimingMeasurement " ) ) {
+      get_test( line, test, sizeof( test ) );
+      continue;
+    }
+
+    if (
+      !get_attribute( line, "name", name, sizeof( name ) )
+        || !get_attribute( line, "unit", unit, sizeof( unit ) )
+        || ( !get_number( line, "median", &value )
+          && !get_number( line, "mean", &value ) )
+    ) {
+      fprintf( stderr, "%s: invalid record: %s", fname, line );
+      continue;
+    }
+
+    /*
+     * Some tests report the same name more than once, so count the
+     * occurrences.
+     */
+    do {
+      snprintf( key, sizeof( key ), "%s/%s/%s/%d", test, name, unit,
+        occurrence );
+      ++occurrence;
+    } while ( find_record( set, key ) );
+
+    r = add_record( set );
+    strcpy( r->key, key );
+    strcpy( r->test, test );
+    strcpy( r->name, name );
+    strcpy( r->unit, unit );
+    r->value = value;
+    r->has_p99 = get_number( line, "p99", &r->p99 );
+    r->matched = 0;
+  }
+
+  fclose( in );
+}
+
+/*
+ * Returns one if the value is a regression.
+ */
+static int compare_value(
+  const record *r,
+  const char   *what,
+  double        old_value,
+  double        new_value
+)
+{
+  double      difference = new_value - old_value;
+  double      change;
+  const char *status = "";
+  int         regression = 0;
+
+  if ( old_value != 0.0 )
+    change = 100.0 * difference / old_value;
+  else
+    change = difference > 0.0 ? 100.0 : ( difference < 0.0 ? -100.0 : 0.0 );
+
+  if ( difference > min_difference && change > threshold ) {
+    status = "REGRESSION";
+    regression = 1;
+  } else if ( -difference > min_difference && -change > threshold ) {
+    status = "IMPROVEMENT";
+  } else if ( !show_all ) {
+    return 0;
+  }
+
+  printf(
+    "%-11s %s: %s [%s] %s: %.0f -> %.0f (%+.1f%%)\n",
+    status,
+    r->test,
+    r->name,
+    r->unit,
+    what,
+    old_value,
+    new_value,
+    change
+  );
+
+  return regression;
+}
+
+static void usage( void )
+{
+  fprintf(
+    stderr,
+    "usage: rtems-tmcompare [-t <threshold_percent>] [-m <min_difference>]"
+      " [-a] <baseline_file> <result_file>\n"
+  );
+  exit( 2 );
+}
+
+int main( int argc, char **argv )
+{
+  record_set    baseline = { NULL, 0, 0 };
+  record_set    result = { NULL, 0, 0 };
+  unsigned long regressions = 0;
+  unsigned long missing = 0;
+  unsigned long added = 0;
+  size_t        i;
+  int           opt;
+
+  while ( (opt = getopt( argc, argv, "t:m:a" )) != -1 ) {
+    switch ( opt ) {
+      case 't':
+        threshold = strtod( optarg, NULL );
+        break;
+      case 'm':
+        min_difference = strtod( optarg, NULL );
+        break;
+      case 'a':
+        show_all = 1;
+        break;
+      default:
+        usage();
+    }
+  }
+
+  if ( optind + 2 != argc )
+    usage();
+
+  read_records( argv[optind], &baseline );
+  read_records( argv[optind + 1], &result );
+
+  for ( i = 0; i < result.count; i++ ) {
+    record *r = &result.records[i];
+    record *b = find_record( &baseline, r->key );
+
+    if ( !b ) {
+      printf( "%-11s %s: %s [%s]\n", "NEW", r->test, r->name, r->unit );
+      ++added;
+      continue;
+    }
+
+    b->matched = 1;
+    regressions += compare_value( r, "value", b->value, r->value );
+
+    if ( b->has_p99 && r->has_p99 )
+      regressions += compare_value( r, "p99", b->p99, r->p99 );
+  }
+
+  for ( i = 0; i < baseline.count; i++ ) {
+    record *b = &baseline.records[i];
+
+    if ( !b->matched ) {
+      printf( "%-11s %s: %s [%s]\n", "MISSING", b->test, b->name, b->unit );
+      ++missing;
+    }
+  }
+
+  fprintf(
+    stderr,
+    "%lu records compared, %lu regressions, %lu new, %lu missing\n",
+    (unsigned long) result.count - added,
+    regressions,
+    added,
+    missing
+  );
+
+  free( baseline.records );
+  free( result.records );
+
+  return regressions > 0 ? 1 : 0;
+}